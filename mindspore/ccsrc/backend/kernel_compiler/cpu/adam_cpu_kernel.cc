@@ -17,7 +17,6 @@
 
 #include <cmath>
 #include <thread>
-#include "backend/kernel_compiler/cpu/mkldnn/mkl_kernel_engine.h"
 #include "runtime/device/cpu/cpu_device_address.h"
 #include "utils/ms_utils.h"
 
@@ -26,14 +25,21 @@ namespace kernel {
 template <typename T>
 void AdamCPUKernel::LaunchAdam(T *var, T *m, T *v, float lr, float beta1, float beta2, float epsilon, const T *gradient,
                                size_t start, size_t end) {
-  for (size_t i = start; i < end; i++) {
-    m[i] += (gradient[i] - m[i]) * (1 - beta1);
-    v[i] += (gradient[i] * gradient[i] - v[i]) * (1 - beta2);
-    if (use_nesterov) {
-      var[i] -= lr * (m[i] * beta1 + (1 - beta1) * gradient[i]) / (std::sqrt(v[i]) + epsilon);
-    } else {
-      var[i] -= lr * m[i] / (std::sqrt(v[i]) + epsilon);
+  // keep the branch out of the loops so that they are vectorized
+  const T one_sub_beta1 = 1 - beta1;
+  const T one_sub_beta2 = 1 - beta2;
+  if (use_nesterov) {
+    for (size_t i = start; i < end; i++) {
+      m[i] += (gradient[i] - m[i]) * one_sub_beta1;
+      v[i] += (gradient[i] * gradient[i] - v[i]) * one_sub_beta2;
+      var[i] -= lr * (m[i] * beta1 + one_sub_beta1 * gradient[i]) / (std::sqrt(v[i]) + epsilon);
     }
+    return;
+  }
+  for (size_t i = start; i < end; i++) {
+    m[i] += (gradient[i] - m[i]) * one_sub_beta1;
+    v[i] += (gradient[i] * gradient[i] - v[i]) * one_sub_beta2;
+    var[i] -= lr * m[i] / (std::sqrt(v[i]) + epsilon);
   }
 }
 
@@ -34,6 +34,7 @@ class AdamCPUKernel : public CPUKernel {
 
   bool Launch(const std::vector<AddressPtr> &inputs, const std::vector<AddressPtr> &workspace,
               const std::vector<AddressPtr> &outputs) override;
+  void set_use_nesterov(bool nesterov) { use_nesterov = nesterov; }
 
  private:
   bool use_nesterov{false};
@@ -14,13 +14,64 @@
  * limitations under the License.
  */
 #include <cmath>
+#include <limits>
 #include <string>
-#include <thread>
 #include "backend/kernel_compiler/cpu/arithmetic_cpu_kernel.h"
 #include "runtime/device/cpu/cpu_device_address.h"
 
 namespace mindspore {
 namespace kernel {
+namespace {
+struct AddFunc {
+  template <typename T>
+  T operator()(const T &lhs, const T &rhs) const {
+    return lhs + rhs;
+  }
+};
+
+struct SubFunc {
+  template <typename T>
+  T operator()(const T &lhs, const T &rhs) const {
+    return lhs - rhs;
+  }
+};
+
+struct MulFunc {
+  template <typename T>
+  T operator()(const T &lhs, const T &rhs) const {
+    return lhs * rhs;
+  }
+};
+
+template <typename T>
+struct RealDivFunc {
+  T operator()(const T &dividend, const T &divisor) const {
+    if (divisor == 0) {
+      if (dividend == 0) {
+        return std::numeric_limits<T>::quiet_NaN();
+      }
+      if (std::numeric_limits<T>::has_infinity) {
+        return dividend > 0 ? std::numeric_limits<T>::infinity() : -std::numeric_limits<T>::infinity();
+      }
+      return dividend > 0 ? std::numeric_limits<T>::max() : std::numeric_limits<T>::min();
+    }
+    return dividend / divisor;
+  }
+};
+
+template <typename T>
+struct PowFunc {
+  T operator()(const T &x, const T &y) const {
+    return static_cast<T>(std::pow(static_cast<double>(x), static_cast<double>(y)));
+  }
+};
+
+template <typename T>
+struct LessFunc {
+  bool operator()(const T &lhs, const T &rhs) const { return lhs < rhs; }
+};
+}  // namespace
+
 template <typename T>
 void ArithmeticCPUKernel::AssignAdd(T *input1, const T *input2, T *out, size_t start, size_t end) {
   for (size_t i = start; i < end; i++) {
@@ -31,68 +82,32 @@ void ArithmeticCPUKernel::AssignAdd(T *input1, const T *input2, T *out, size_t s
 
 template <typename T>
 void ArithmeticCPUKernel::Add(const T *input1, const T *input2, T *out, size_t start, size_t end) {
-  for (size_t i = start; i < end; i++) {
-    out[i] = input1[i] + input2[i];
-  }
+  BroadcastBinary(broadcast_iterator_, input1, input2, out, start, end, AddFunc());
 }
 
 template <typename T>
 void ArithmeticCPUKernel::Sub(const T *input1, const T *input2, T *out, size_t start, size_t end) {
-  for (size_t i = start; i < end; i++) {
-    std::vector<size_t> idx;
-    GenIndex(i, &idx);
-    out[i] = input1[idx[0]] - input2[idx[1]];
-  }
+  BroadcastBinary(broadcast_iterator_, input1, input2, out, start, end, SubFunc());
 }
 
 template <typename T>
 void ArithmeticCPUKernel::Mul(const T *input1, const T *input2, T *out, size_t start, size_t end) {
-  for (size_t i = start; i < end; i++) {
-    out[i] = input1[i] * input2[i];
-  }
+  BroadcastBinary(broadcast_iterator_, input1, input2, out, start, end, MulFunc());
 }
 
 template <typename T>
 void ArithmeticCPUKernel::RealDiv(const T *input1, const T *input2, T *out, size_t start, size_t end) {
-  for (size_t i = start; i < end; i++) {
-    std::vector<size_t> idx;
-    GenIndex(i, &idx);
-    auto dividend = input1[idx[0]];
-    auto divisor = input2[idx[1]];
-    if (divisor == 0) {
-      if (dividend == 0) {
-        out[i] = std::numeric_limits<T>::quiet_NaN();
-        continue;
-      }
-      if (std::numeric_limits<T>::has_infinity) {
-        out[i] = dividend > 0 ? std::numeric_limits<T>::infinity() : -std::numeric_limits<T>::infinity();
-      } else {
-        out[i] = dividend > 0 ? std::numeric_limits<T>::max() : std::numeric_limits<T>::min();
-      }
-      continue;
-    }
-    out[i] = dividend / divisor;
-  }
+  BroadcastBinary(broadcast_iterator_, input1, input2, out, start, end, RealDivFunc<T>());
 }
 
 template <typename T>
 void ArithmeticCPUKernel::Pow(const T *input1, const T *input2, T *out, size_t start, size_t end) {
-  for (size_t i = start; i < end; i++) {
-    std::vector<size_t> idx;
-    GenIndex(i, &idx);
-    auto x = static_cast<double>(input1[idx[0]]);
-    auto y = static_cast<double>(input2[idx[1]]);
-    out[i] = static_cast<T>(std::pow(x, y));
-  }
+  BroadcastBinary(broadcast_iterator_, input1, input2, out, start, end, PowFunc<T>());
 }
 
 template <typename T>
 void ArithmeticCPUKernel::Less(const T *input1, const T *input2, bool *out, size_t start, size_t end) {
-  for (size_t i = start; i < end; i++) {
-    std::vector<size_t> idx;
-    GenIndex(i, &idx);
-    out[i] = input1[idx[0]] < input2[idx[1]];
-  }
+  BroadcastBinary(broadcast_iterator_, input1, input2, out, start, end, LessFunc<T>());
 }
 
 void ArithmeticCPUKernel::InitKernel(const CNodePtr &kernel_node) {
@@ -119,20 +134,7 @@ void ArithmeticCPUKernel::InitKernel(const CNodePtr &kernel_node) {
   input_shape0_ = AnfAlgo::GetPrevNodeOutputInferShape(kernel_node, 0);
   input_shape1_ = AnfAlgo::GetPrevNodeOutputInferShape(kernel_node, 1);
   output_shape_ = AnfAlgo::GetOutputInferShape(kernel_node, 0);
-  if (output_shape_.size() == 0) {
-    output_shape_.insert(output_shape_.begin(), 1);
-  }
-  size_t l = input_shape0_.size();
-  for (size_t i = 0; i < output_shape_.size() - l; ++i) {
-    input_shape0_.insert(input_shape0_.begin(), 1);
-  }
-  l = input_shape1_.size();
-  for (size_t i = 0; i < output_shape_.size() - l; ++i) {
-    input_shape1_.insert(input_shape1_.begin(), 1);
-  }
-  CPUKernelUtils::GetElementNumEveryDim(input_shape0_, &input_element_num0_);
-  CPUKernelUtils::GetElementNumEveryDim(input_shape1_, &input_element_num1_);
-  CPUKernelUtils::GetElementNumEveryDim(output_shape_, &output_element_num_);
+  broadcast_iterator_ = BroadcastIterator({input_shape0_, input_shape1_}, output_shape_);
   dtype_ = AnfAlgo::GetPrevNodeOutputInferDataType(kernel_node, 0);
   if (dtype_ != AnfAlgo::GetPrevNodeOutputInferDataType(kernel_node, 1)) {
     MS_LOG(EXCEPTION) << "Input0 and input1 must has the same data type";
@@ -154,67 +156,13 @@ bool ArithmeticCPUKernel::Launch(const std::vector<kernel::AddressPtr> &inputs,
   return true;
 }
 
-void ArithmeticCPUKernel::GenIndex(size_t num, std::vector<size_t> *idx) {
-  std::vector<size_t> tmp;
-  for (size_t i = 0; i < output_shape_.size() - 1; ++i) {
-    if (output_element_num_[i] > num) {
-      tmp.push_back(0);
-    } else {
-      tmp.push_back(num / output_element_num_[i]);
-      num %= output_element_num_[i];
-    }
-  }
-  tmp.push_back(num);
-  size_t idx0 = 0;
-  size_t idx1 = 0;
-  for (size_t k = 0; k < tmp.size() - 1; ++k) {
-    if (input_shape0_[k] > 1) {
-      idx0 += tmp[k] * input_element_num0_[k];
-    }
-    if (input_shape1_[k] > 1) {
-      idx1 += tmp[k] * input_element_num1_[k];
-    }
-  }
-  if (input_shape0_[tmp.size() - 1] > 1) {
-    idx0 += tmp[tmp.size() - 1];
-  }
-  if (input_shape1_[tmp.size() - 1] > 1) {
-    idx1 += tmp[tmp.size() - 1];
-  }
-  idx->push_back(idx0);
-  idx->push_back(idx1);
-}
-
 template <typename T>
 void ArithmeticCPUKernel::LaunchLess(const std::vector<AddressPtr> &inputs, const std::vector<AddressPtr> &outputs) {
   T *input1 = reinterpret_cast<T *>(inputs[0]->addr);
   T *input2 = reinterpret_cast<T *>(inputs[1]->addr);
   bool *output = reinterpret_cast<bool *>(outputs[0]->addr);
-
-  size_t lens = outputs[0]->size > 0 ? static_cast<size_t>(outputs[0]->size / sizeof(bool)) : 1;
-  auto max_thread_num = std::thread::hardware_concurrency();
-  size_t thread_num = lens < 128 * max_thread_num ? std::ceil(lens / 128.0) : max_thread_num;
-  MS_LOG(INFO) << "Lens=" << lens << "; use thread_num=" << thread_num << "; max_thread_num: " << max_thread_num;
-  std::vector<std::thread> threads;
-  if (thread_num < 1) {
-    MS_LOG(ERROR) << "Invalid value: thread_num " << thread_num;
-    return;
-  }
-  threads.reserve(thread_num);
-  size_t start = 0;
-  size_t once_compute_size = (lens + thread_num - 1) / thread_num;
-  if (once_compute_size < 1) {
-    MS_LOG(ERROR) << "Invalid value: once_compute_size " << once_compute_size;
-    return;
-  }
-  while (start < lens) {
-    size_t end = (start + once_compute_size) > lens ? lens : (start + once_compute_size);
-    threads.emplace_back(std::thread(&ArithmeticCPUKernel::Less<T>, this, input1, input2, output, start, end));
-    start += once_compute_size;
-  }
-  for (size_t i = 0; i < threads.size(); ++i) {
-    threads[i].join();
-  }
+  auto task = [this, input1, input2, output](size_t start, size_t end) { Less<T>(input1, input2, output, start, end); };
+  CPUKernelUtils::ParallelFor(task, broadcast_iterator_.output_num());
 }
 
 template <typename T>
@@ -226,45 +174,24 @@ void ArithmeticCPUKernel::LaunchKernel(const std::vector<AddressPtr> &inputs, co
   T *input1 = reinterpret_cast<T *>(inputs[0]->addr);
   T *input2 = reinterpret_cast<T *>(inputs[1]->addr);
   T *output = reinterpret_cast<T *>(outputs[0]->addr);
-
-  size_t lens = outputs[0]->size > 0 ? static_cast<size_t>(outputs[0]->size / sizeof(T)) : 1;
-  auto max_thread_num = std::thread::hardware_concurrency();
-  size_t thread_num = lens < 128 * max_thread_num ? std::ceil(lens / 128.0) : max_thread_num;
-  MS_LOG(INFO) << "Lens=" << lens << "; use thread_num=" << thread_num << "; max_thread_num: " << max_thread_num;
-  std::vector<std::thread> threads;
-  if (thread_num < 1) {
-    MS_LOG(ERROR) << "Invalid value: thread_num " << thread_num;
-    return;
-  }
-  threads.reserve(thread_num);
-  size_t start = 0;
-  size_t once_compute_size = (lens + thread_num - 1) / thread_num;
-  if (once_compute_size < 1) {
-    MS_LOG(ERROR) << "Invalid value: once_compute_size " << once_compute_size;
-    return;
-  }
-  while (start < lens) {
-    size_t end = (start + once_compute_size) > lens ? lens : (start + once_compute_size);
+  auto task = [this, input1, input2, output](size_t start, size_t end) {
     if (operate_type_ == ADD) {
-      threads.emplace_back(std::thread(&ArithmeticCPUKernel::Add<T>, this, input1, input2, output, start, end));
+      Add<T>(input1, input2, output, start, end);
     } else if (operate_type_ == SUB) {
-      threads.emplace_back(std::thread(&ArithmeticCPUKernel::Sub<T>, this, input1, input2, output, start, end));
+      Sub<T>(input1, input2, output, start, end);
     } else if (operate_type_ == MUL) {
-      threads.emplace_back(std::thread(&ArithmeticCPUKernel::Mul<T>, this, input1, input2, output, start, end));
+      Mul<T>(input1, input2, output, start, end);
     } else if (operate_type_ == REALDIV) {
-      threads.emplace_back(std::thread(&ArithmeticCPUKernel::RealDiv<T>, this, input1, input2, output, start, end));
+      RealDiv<T>(input1, input2, output, start, end);
     } else if (operate_type_ == POW) {
-      threads.emplace_back(std::thread(&ArithmeticCPUKernel::Pow<T>, this, input1, input2, output, start, end));
+      Pow<T>(input1, input2, output, start, end);
     } else if (operate_type_ == ASSIGNADD) {
-      threads.emplace_back(std::thread(&ArithmeticCPUKernel::AssignAdd<T>, this, input1, input2, output, start, end));
+      AssignAdd<T>(input1, input2, output, start, end);
     } else {
       MS_LOG(EXCEPTION) << "Not support " << operate_type_;
     }
-    start += once_compute_size;
-  }
-  for (size_t i = 0; i < threads.size(); ++i) {
-    threads[i].join();
-  }
+  };
+  CPUKernelUtils::ParallelFor(task, broadcast_iterator_.output_num());
 }
 }  // namespace kernel
 }  // namespace mindspore
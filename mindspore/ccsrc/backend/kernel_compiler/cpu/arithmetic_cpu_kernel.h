@@ -17,6 +17,7 @@
 #define MINDSPORE_CCSRC_BACKEND_KERNEL_COMPILER_CPU_ARITHMETIC_CPU_KERNEL_H_
 #include <memory>
 #include <vector>
+#include "backend/kernel_compiler/cpu/broadcast_iterator.h"
 #include "backend/kernel_compiler/cpu/cpu_kernel.h"
 #include "backend/kernel_compiler/cpu/cpu_kernel_factory.h"
 
@@ -37,7 +38,6 @@ class ArithmeticCPUKernel : public CPUKernel {
   void LaunchKernel(const std::vector<AddressPtr> &inputs, const std::vector<AddressPtr> &outputs);
 
  private:
-  void GenIndex(size_t num, std::vector<size_t> *tmp);
   template <typename T>
   void Sub(const T *input1, const T *input2, T *out, size_t start, size_t end);
   template <typename T>
@@ -54,10 +54,8 @@ class ArithmeticCPUKernel : public CPUKernel {
   void Less(const T *input1, const T *input2, bool *out, size_t start, size_t end);
   std::vector<size_t> input_shape0_;
   std::vector<size_t> input_shape1_;
-  std::vector<size_t> input_element_num0_;
-  std::vector<size_t> input_element_num1_;
   std::vector<size_t> output_shape_;
-  std::vector<size_t> output_element_num_;
+  BroadcastIterator broadcast_iterator_;
   OperateType operate_type_{ADD};
   TypeId dtype_{kTypeUnknown};
 };
@@ -0,0 +1,83 @@
+/**
+ * Copyright 2020 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "backend/kernel_compiler/cpu/broadcast_iterator.h"
+#include "utils/log_adapter.h"
+
+namespace mindspore {
+namespace kernel {
+BroadcastIterator::BroadcastIterator(const std::vector<std::vector<size_t>> &input_shapes,
+                                     const std::vector<size_t> &output_shape)
+    : input_num_(input_shapes.size()) {
+  if (input_num_ == 0 || input_num_ > kBroadcastMaxInputNum) {
+    MS_LOG(EXCEPTION) << "Broadcast support 1 to " << kBroadcastMaxInputNum << " inputs, but got " << input_num_;
+  }
+  size_t rank = output_shape.size();
+  // the input shapes aligned to the output shape and their contiguous strides
+  std::vector<std::vector<size_t>> aligned_shapes;
+  std::vector<std::vector<size_t>> aligned_strides;
+  for (const auto &shape : input_shapes) {
+    if (shape.size() > rank) {
+      MS_LOG(EXCEPTION) << "The input rank " << shape.size() << " is greater than the output rank " << rank;
+    }
+    std::vector<size_t> aligned(rank - shape.size(), 1);
+    aligned.insert(aligned.end(), shape.begin(), shape.end());
+    std::vector<size_t> strides(rank, 1);
+    for (size_t dim = rank; dim > 1; --dim) {
+      strides[dim - 2] = strides[dim - 1] * aligned[dim - 1];
+    }
+    aligned_shapes.emplace_back(std::move(aligned));
+    aligned_strides.emplace_back(std::move(strides));
+  }
+  strides_.resize(input_num_);
+  std::vector<bool> last_broadcast;
+  for (size_t dim = 0; dim < rank; ++dim) {
+    output_num_ *= output_shape[dim];
+    if (output_shape[dim] == 1) {
+      continue;
+    }
+    std::vector<bool> broadcast(input_num_, false);
+    for (size_t i = 0; i < input_num_; ++i) {
+      auto input_dim = aligned_shapes[i][dim];
+      if (input_dim != output_shape[dim] && input_dim != 1) {
+        MS_LOG(EXCEPTION) << "The input " << i << " of dim " << input_dim << " can not be broadcast to "
+                          << output_shape[dim] << " at axis " << dim;
+      }
+      broadcast[i] = input_dim == 1;
+    }
+    if (!dims_.empty() && broadcast == last_broadcast) {
+      // merge into the previous dim, whose strides are those of its inner part
+      dims_.back() *= output_shape[dim];
+      for (size_t i = 0; i < input_num_; ++i) {
+        strides_[i].back() = broadcast[i] ? 0 : aligned_strides[i][dim];
+      }
+      continue;
+    }
+    dims_.push_back(output_shape[dim]);
+    for (size_t i = 0; i < input_num_; ++i) {
+      strides_[i].push_back(broadcast[i] ? 0 : aligned_strides[i][dim]);
+    }
+    last_broadcast = std::move(broadcast);
+  }
+  if (dims_.empty()) {
+    // a single element
+    dims_.push_back(1);
+    for (size_t i = 0; i < input_num_; ++i) {
+      strides_[i].push_back(0);
+    }
+  }
+}
+}  // namespace kernel
+}  // namespace mindspore
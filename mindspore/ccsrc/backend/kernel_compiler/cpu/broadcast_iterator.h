@@ -0,0 +1,225 @@
+/**
+ * Copyright 2020 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef MINDSPORE_CCSRC_BACKEND_KERNEL_COMPILER_CPU_BROADCAST_ITERATOR_H_
+#define MINDSPORE_CCSRC_BACKEND_KERNEL_COMPILER_CPU_BROADCAST_ITERATOR_H_
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <cstring>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace mindspore {
+namespace kernel {
+constexpr size_t kBroadcastMaxInputNum = 3;
+
+// four floats computed by one instruction, the compilers lower the operators of the type to SSE or NEON
+using Float4 = float __attribute__((vector_size(16)));
+using Int4 = int32_t __attribute__((vector_size(16)));
+constexpr size_t kFloat4Size = 4;
+
+inline Float4 LoadFloat4(const float *ptr) {
+  Float4 value;
+  (void)memcpy(&value, ptr, sizeof(Float4));
+  return value;
+}
+
+inline void StoreFloat4(float *ptr, const Float4 &value) { (void)memcpy(ptr, &value, sizeof(Float4)); }
+
+inline Float4 DupFloat4(float value) { return Float4{value, value, value, value}; }
+
+inline Float4 MaxFloat4(const Float4 &lhs, const Float4 &rhs) {
+  Int4 mask = lhs > rhs;
+  return reinterpret_cast<Float4>((mask & reinterpret_cast<Int4>(lhs)) | (~mask & reinterpret_cast<Int4>(rhs)));
+}
+
+// the elementwise functions callable with Float4 are run four floats at a time
+template <typename Func, typename = void>
+struct IsFloat4Binary : std::false_type {};
+template <typename Func>
+struct IsFloat4Binary<Func, decltype(void(std::declval<const Func &>()(Float4{}, Float4{})))> : std::true_type {};
+
+template <typename Func, typename = void>
+struct IsFloat4Unary : std::false_type {};
+template <typename Func>
+struct IsFloat4Unary<Func, decltype(void(std::declval<const Func &>()(Float4{})))> : std::true_type {};
+
+// BroadcastIterator walks the output of an elementwise op as runs of elements contiguous in the output. The adjacent
+// dims broadcast the same way by every input are merged, so an input is either contiguous (stride 1) or repeated
+// (stride 0) along a run, and the runs are as long as the shapes allow: a scalar or a row broadcast is one run per
+// row or for the whole output, a column broadcast repeats one element of the column along each run.
+class BroadcastIterator {
+ public:
+  BroadcastIterator() = default;
+  BroadcastIterator(const std::vector<std::vector<size_t>> &input_shapes, const std::vector<size_t> &output_shape);
+  ~BroadcastIterator() = default;
+
+  size_t output_num() const { return output_num_; }
+  size_t input_num() const { return input_num_; }
+  // 1 if the input is contiguous along the runs, 0 if one element is repeated
+  size_t run_stride(size_t input) const { return strides_[input].back(); }
+
+  // call run(input_offsets, output_offset, len) for the runs covering the output elements [start, end)
+  template <typename Run>
+  void ForEachRun(size_t start, size_t end, const Run &run) const {
+    if (start >= end) {
+      return;
+    }
+    size_t rank = dims_.size();
+    std::vector<size_t> index(rank, 0);
+    std::array<size_t, kBroadcastMaxInputNum> offsets{};
+    size_t remain = start;
+    for (size_t dim = rank; dim > 0; --dim) {
+      index[dim - 1] = remain % dims_[dim - 1];
+      remain /= dims_[dim - 1];
+      for (size_t i = 0; i < input_num_; ++i) {
+        offsets[i] += index[dim - 1] * strides_[i][dim - 1];
+      }
+    }
+    size_t pos = start;
+    while (true) {
+      size_t len = std::min(dims_[rank - 1] - index[rank - 1], end - pos);
+      run(offsets.data(), pos, len);
+      pos += len;
+      if (pos >= end) {
+        return;
+      }
+      // the run ends at the end of the inner dim, carry to the outer dims
+      index[rank - 1] += len;
+      for (size_t i = 0; i < input_num_; ++i) {
+        offsets[i] += len * strides_[i][rank - 1];
+      }
+      for (size_t dim = rank - 1; dim > 0 && index[dim] == dims_[dim]; --dim) {
+        index[dim] = 0;
+        ++index[dim - 1];
+        for (size_t i = 0; i < input_num_; ++i) {
+          offsets[i] = offsets[i] - dims_[dim] * strides_[i][dim] + strides_[i][dim - 1];
+        }
+      }
+    }
+  }
+
+ private:
+  size_t input_num_{0};
+  size_t output_num_{1};
+  // the merged dims of the output
+  std::vector<size_t> dims_;
+  // the strides of every input along the merged dims, 0 on the broadcast ones
+  std::vector<std::vector<size_t>> strides_;
+};
+
+// out[k] = func(in[k]) for a contiguous run
+template <typename T, typename S, typename Func>
+void UnaryRun(const T *in, S *out, size_t len, const Func &func) {
+  size_t k = 0;
+  if constexpr (std::is_same<T, float>::value && std::is_same<S, float>::value && IsFloat4Unary<Func>::value) {
+    for (; k + kFloat4Size <= len; k += kFloat4Size) {
+      StoreFloat4(out + k, func(LoadFloat4(in + k)));
+    }
+  }
+  for (; k < len; ++k) {
+    out[k] = func(in[k]);
+  }
+}
+
+// out[k] = func(lhs[k * lhs_stride], rhs[k * rhs_stride]) for a run, the strides being 0 or 1
+template <typename T, typename S, typename Func>
+void BinaryRun(const T *lhs, size_t lhs_stride, const T *rhs, size_t rhs_stride, S *out, size_t len,
+               const Func &func) {
+  size_t k = 0;
+  if constexpr (std::is_same<T, float>::value && std::is_same<S, float>::value && IsFloat4Binary<Func>::value) {
+    if (lhs_stride == 1 && rhs_stride == 1) {
+      for (; k + kFloat4Size <= len; k += kFloat4Size) {
+        StoreFloat4(out + k, func(LoadFloat4(lhs + k), LoadFloat4(rhs + k)));
+      }
+    } else if (lhs_stride == 1) {
+      Float4 rhs4 = DupFloat4(rhs[0]);
+      for (; k + kFloat4Size <= len; k += kFloat4Size) {
+        StoreFloat4(out + k, func(LoadFloat4(lhs + k), rhs4));
+      }
+    } else if (rhs_stride == 1) {
+      Float4 lhs4 = DupFloat4(lhs[0]);
+      for (; k + kFloat4Size <= len; k += kFloat4Size) {
+        StoreFloat4(out + k, func(lhs4, LoadFloat4(rhs + k)));
+      }
+    }
+  }
+  if (lhs_stride == 1 && rhs_stride == 1) {
+    for (; k < len; ++k) {
+      out[k] = func(lhs[k], rhs[k]);
+    }
+  } else if (lhs_stride == 1) {
+    const T rhs0 = rhs[0];
+    for (; k < len; ++k) {
+      out[k] = func(lhs[k], rhs0);
+    }
+  } else if (rhs_stride == 1) {
+    const T lhs0 = lhs[0];
+    for (; k < len; ++k) {
+      out[k] = func(lhs0, rhs[k]);
+    }
+  } else {
+    std::fill(out + k, out + len, func(lhs[0], rhs[0]));
+  }
+}
+
+// out = func(in) for the elements [start, end) of inputs and outputs of the same shape
+template <typename T, typename S, typename Func>
+void ElementwiseUnary(const T *in, S *out, size_t start, size_t end, const Func &func) {
+  if (start < end) {
+    UnaryRun(in + start, out + start, end - start, func);
+  }
+}
+
+// out = func(lhs, rhs) for the output elements [start, end), the inputs are broadcast by the iterator
+template <typename T, typename S, typename Func>
+void BroadcastBinary(const BroadcastIterator &iter, const T *lhs, const T *rhs, S *out, size_t start, size_t end,
+                     const Func &func) {
+  size_t lhs_stride = iter.run_stride(0);
+  size_t rhs_stride = iter.run_stride(1);
+  iter.ForEachRun(start, end, [&](const size_t *offsets, size_t out_offset, size_t len) {
+    BinaryRun(lhs + offsets[0], lhs_stride, rhs + offsets[1], rhs_stride, out + out_offset, len, func);
+  });
+}
+
+// out = func(in0, in1, in2) for the output elements [start, end), the inputs are broadcast by the iterator
+template <typename T0, typename T1, typename T2, typename S, typename Func>
+void BroadcastTernary(const BroadcastIterator &iter, const T0 *in0, const T1 *in1, const T2 *in2, S *out, size_t start,
+                      size_t end, const Func &func) {
+  size_t stride0 = iter.run_stride(0);
+  size_t stride1 = iter.run_stride(1);
+  size_t stride2 = iter.run_stride(2);
+  iter.ForEachRun(start, end, [&](const size_t *offsets, size_t out_offset, size_t len) {
+    const T0 *x = in0 + offsets[0];
+    const T1 *y = in1 + offsets[1];
+    const T2 *z = in2 + offsets[2];
+    S *o = out + out_offset;
+    if (stride0 == 1 && stride1 == 1 && stride2 == 1) {
+      for (size_t k = 0; k < len; ++k) {
+        o[k] = func(x[k], y[k], z[k]);
+      }
+      return;
+    }
+    for (size_t k = 0; k < len; ++k) {
+      o[k] = func(x[k * stride0], y[k * stride1], z[k * stride2]);
+    }
+  });
+}
+}  // namespace kernel
+}  // namespace mindspore
+
+#endif  // MINDSPORE_CCSRC_BACKEND_KERNEL_COMPILER_CPU_BROADCAST_ITERATOR_H_
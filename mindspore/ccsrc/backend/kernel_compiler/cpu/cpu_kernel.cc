@@ -14,9 +14,15 @@
  * limitations under the License.
  */
 #include "backend/kernel_compiler/cpu/cpu_kernel.h"
+#include "common/thread_pool.h"
 
 namespace mindspore {
 namespace kernel {
+namespace {
+// a slice smaller than this costs more to dispatch to a thread than to compute
+constexpr size_t kMinParallelSliceSize = 16384;
+}  // namespace
+
 void CPUKernel::InitInputOutputSize(const CNodePtr &kernel_node) {
   MS_EXCEPTION_IF_NULL(kernel_node);
   size_t input_num = AnfAlgo::GetInputTensorNum(kernel_node);
@@ -79,5 +85,24 @@ void CPUKernelUtils::GetElementNumEveryDim(const std::vector<size_t> &shape, std
   }
   std::reverse(element_num->begin(), element_num->end());
 }
+
+void CPUKernelUtils::ParallelFor(const CTask &task, size_t count) {
+  size_t thread_num = std::min(static_cast<size_t>(kDefaultMaxThreadNum),
+                               (count + kMinParallelSliceSize - 1) / kMinParallelSliceSize);
+  if (thread_num <= 1) {
+    task(0, count);
+    return;
+  }
+  std::vector<Task> tasks;
+  size_t once_compute_size = (count + thread_num - 1) / thread_num;
+  for (size_t start = 0; start < count; start += once_compute_size) {
+    size_t end = std::min(start + once_compute_size, count);
+    tasks.emplace_back([&task, start, end]() -> int {
+      task(start, end);
+      return SUCCESS;
+    });
+  }
+  (void)ThreadPool::GetInstance()->LaunchMultipleTask(tasks);
+}
 }  // namespace kernel
 }  // namespace mindspore
@@ -95,12 +95,16 @@ class CPUKernel : public kernel::KernelMod {
   std::vector<size_t> workspace_size_list_;
 };
 
+using CTask = std::function<void(size_t, size_t)>;
+
 class CPUKernelUtils {
  public:
   static void ExpandDimsTo4(std::vector<size_t> *shape);
   static size_t CalcOffset(const std::vector<size_t> &shape, size_t dim0, size_t dim1, size_t dim2, size_t dim3);
   static size_t GetElementNumOnAxis(const std::vector<size_t> &shape, int axis);
   static void GetElementNumEveryDim(const std::vector<size_t> &shape, std::vector<size_t> *element_num);
+  // run task(start, end) on the common thread pool for the slices of [0, count), or inline if count is small
+  static void ParallelFor(const CTask &task, size_t count);
 };
 }  // namespace kernel
 }  // namespace mindspore
@@ -18,8 +18,19 @@
 
 namespace mindspore {
 namespace kernel {
+namespace {
+template <typename T>
+struct EqualFunc {
+  bool operator()(const T &lhs, const T &rhs) const { return lhs == rhs; }
+};
+}  // namespace
+
 void EqualCPUKernel::InitKernel(const CNodePtr &kernel_node) {
   CheckParam(kernel_node);
+  auto input_shape0 = AnfAlgo::GetPrevNodeOutputInferShape(kernel_node, 0);
+  auto input_shape1 = AnfAlgo::GetPrevNodeOutputInferShape(kernel_node, 1);
+  auto output_shape = AnfAlgo::GetOutputInferShape(kernel_node, 0);
+  broadcast_iterator_ = BroadcastIterator({input_shape0, input_shape1}, output_shape);
 
   dtype_ = AnfAlgo::GetPrevNodeOutputInferDataType(kernel_node, 0);
   if (dtype_ != AnfAlgo::GetPrevNodeOutputInferDataType(kernel_node, 1)) {
@@ -65,14 +76,10 @@ void EqualCPUKernel::LaunchKernel(const std::vector<AddressPtr> &inputs, const s
   T *left = reinterpret_cast<T *>(inputs[0]->addr);
   T *right = reinterpret_cast<T *>(inputs[1]->addr);
   bool *output = reinterpret_cast<bool *>(outputs[0]->addr);
-  size_t elem_num = inputs[0]->size / sizeof(T);
-  for (size_t i = 0; i < elem_num; i++) {
-    if (left[i] == right[i]) {
-      output[i] = true;
-    } else {
-      output[i] = false;
-    }
-  }
+  auto task = [this, left, right, output](size_t start, size_t end) {
+    BroadcastBinary(broadcast_iterator_, left, right, output, start, end, EqualFunc<T>());
+  };
+  CPUKernelUtils::ParallelFor(task, broadcast_iterator_.output_num());
 }
 
 void EqualCPUKernel::CheckParam(const CNodePtr &kernel_node) {
@@ -84,16 +91,6 @@ void EqualCPUKernel::CheckParam(const CNodePtr &kernel_node) {
   if (output_num != 1) {
     MS_LOG(EXCEPTION) << "Output number is " << output_num << ", but EqualCPUKernel needs 1 output.";
   }
-  auto input_shape0 = AnfAlgo::GetPrevNodeOutputInferShape(kernel_node, 0);
-  auto input_shape1 = AnfAlgo::GetPrevNodeOutputInferShape(kernel_node, 1);
-  if (input_shape0.size() != input_shape1.size()) {
-    MS_LOG(EXCEPTION) << "Input0 and Input1 must have the same shape";
-  }
-  for (size_t i = 0; i < input_shape0.size(); ++i) {
-    if (input_shape0[i] != input_shape1[i]) {
-      MS_LOG(EXCEPTION) << "Input0 and Input1 must have the same shape";
-    }
-  }
 }
 }  // namespace kernel
 }  // namespace mindspore
@@ -17,6 +17,7 @@
 #define MINDSPORE_CCSRC_BACKEND_KERNEL_COMPILER_CPU_EQUAL_CPU_KERNEL_H_
 #include <vector>
 #include <memory>
+#include "backend/kernel_compiler/cpu/broadcast_iterator.h"
 #include "backend/kernel_compiler/cpu/cpu_kernel.h"
 #include "backend/kernel_compiler/cpu/cpu_kernel_factory.h"
 
@@ -37,6 +38,7 @@ class EqualCPUKernel : public CPUKernel {
  private:
   void CheckParam(const CNodePtr &kernel_node);
   TypeId dtype_{kTypeUnknown};
+  BroadcastIterator broadcast_iterator_;
 };
 
 MS_REG_CPU_KERNEL(
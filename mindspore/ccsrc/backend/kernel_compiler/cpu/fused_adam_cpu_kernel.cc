@@ -0,0 +1,88 @@
+/**
+ * Copyright 2020 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "backend/kernel_compiler/cpu/fused_adam_cpu_kernel.h"
+#include <cmath>
+#include <functional>
+#include <numeric>
+#include "runtime/device/cpu/cpu_device_address.h"
+#include "utils/utils.h"
+
+namespace mindspore {
+namespace kernel {
+namespace {
+constexpr size_t kFusedAdamInputNum = 10;
+constexpr size_t kFusedAdamWeightDecayInputNum = 11;
+// the inputs: beta1, one_sub_beta1, beta2, one_sub_beta2, eps, lr, param, m, v, gradient, [weight_decay]
+constexpr size_t kParamIndex = 6;
+}  // namespace
+
+void FusedAdamCPUKernel::InitKernel(const CNodePtr &kernel_node) {
+  MS_EXCEPTION_IF_NULL(kernel_node);
+  weight_decay_ = AnfAlgo::GetCNodeName(kernel_node) == kFusedAdamWeightDecayName;
+  size_t expect_input_num = weight_decay_ ? kFusedAdamWeightDecayInputNum : kFusedAdamInputNum;
+  size_t input_num = AnfAlgo::GetInputTensorNum(kernel_node);
+  if (input_num != expect_input_num) {
+    MS_LOG(EXCEPTION) << "Input number is " << input_num << ", but " << AnfAlgo::GetCNodeName(kernel_node)
+                      << " needs " << expect_input_num << " inputs.";
+  }
+  auto shape = AnfAlgo::GetPrevNodeOutputInferShape(kernel_node, kParamIndex);
+  elem_num_ = std::accumulate(shape.begin(), shape.end(), size_t(1), std::multiplies<size_t>());
+}
+
+bool FusedAdamCPUKernel::Launch(const std::vector<kernel::AddressPtr> &inputs,
+                                const std::vector<kernel::AddressPtr> & /*workspace*/,
+                                const std::vector<kernel::AddressPtr> &outputs) {
+  size_t expect_input_num = weight_decay_ ? kFusedAdamWeightDecayInputNum : kFusedAdamInputNum;
+  if (inputs.size() != expect_input_num || outputs.empty()) {
+    MS_LOG(EXCEPTION) << "Input number is " << inputs.size() << ", but the fused adam needs " << expect_input_num
+                      << " inputs.";
+  }
+  for (size_t i = kParamIndex; i < kParamIndex + 4; ++i) {
+    if (inputs[i]->size != elem_num_ * sizeof(float)) {
+      MS_LOG(EXCEPTION) << "Error input data size!";
+    }
+  }
+  float beta1 = reinterpret_cast<float *>(inputs[0]->addr)[0];
+  float one_sub_beta1 = reinterpret_cast<float *>(inputs[1]->addr)[0];
+  float beta2 = reinterpret_cast<float *>(inputs[2]->addr)[0];
+  float one_sub_beta2 = reinterpret_cast<float *>(inputs[3]->addr)[0];
+  float epsilon = reinterpret_cast<float *>(inputs[4]->addr)[0];
+  float lr = reinterpret_cast<float *>(inputs[5]->addr)[0];
+  auto param = reinterpret_cast<float *>(inputs[6]->addr);
+  auto m = reinterpret_cast<float *>(inputs[7]->addr);
+  auto v = reinterpret_cast<float *>(inputs[8]->addr);
+  auto gradient = reinterpret_cast<float *>(inputs[9]->addr);
+  float weight_decay = weight_decay_ ? reinterpret_cast<float *>(inputs[10]->addr)[0] : 0.0f;
+  auto output = reinterpret_cast<float *>(outputs[0]->addr);
+  auto task = [&](size_t start, size_t end) {
+    for (size_t i = start; i < end; ++i) {
+      float next_m = beta1 * m[i] + one_sub_beta1 * gradient[i];
+      float next_v = beta2 * v[i] + one_sub_beta2 * gradient[i] * gradient[i];
+      float update = next_m / (std::sqrt(next_v) + epsilon);
+      if (weight_decay_) {
+        update += weight_decay * param[i];
+      }
+      param[i] -= lr * update;
+      m[i] = next_m;
+      v[i] = next_v;
+      output[i] = param[i];
+    }
+  };
+  CPUKernelUtils::ParallelFor(task, elem_num_);
+  return true;
+}
+}  // namespace kernel
+}  // namespace mindspore
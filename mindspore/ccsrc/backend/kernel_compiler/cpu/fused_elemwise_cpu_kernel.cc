@@ -0,0 +1,180 @@
+/**
+ * Copyright 2020 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "backend/kernel_compiler/cpu/fused_elemwise_cpu_kernel.h"
+#include <algorithm>
+#include <cmath>
+#include <functional>
+#include <map>
+#include <numeric>
+#include <string>
+#include "backend/kernel_compiler/cpu/broadcast_iterator.h"
+#include "runtime/device/cpu/cpu_device_address.h"
+#include "utils/utils.h"
+
+namespace mindspore {
+namespace kernel {
+namespace {
+// the floats of a tile of every op, 4KB each
+constexpr size_t kFusedTileSize = 1024;
+constexpr size_t kFusedOpInputNum = 2;
+
+const std::map<std::string, FusedElemwiseOpType> kFusedOpTypes = {
+  {kTensorAddOpName, FUSED_ADD}, {kSubOpName, FUSED_SUB},       {kMulOpName, FUSED_MUL},
+  {kRealDivOpName, FUSED_DIV},   {kMaximumOpName, FUSED_MAX},   {kReluOpName, FUSED_RELU},
+  {kNegOpName, FUSED_NEG},       {kSquareOpName, FUSED_SQUARE}, {kSqrtOpName, FUSED_SQRT},
+  {kExpOpName, FUSED_EXP}};
+
+size_t ElementNum(const std::vector<size_t> &shape) {
+  return std::accumulate(shape.begin(), shape.end(), size_t(1), std::multiplies<size_t>());
+}
+
+struct MaxFunc {
+  float operator()(float lhs, float rhs) const { return lhs > rhs ? lhs : rhs; }
+  Float4 operator()(const Float4 &lhs, const Float4 &rhs) const { return MaxFloat4(lhs, rhs); }
+};
+
+struct ReluFunc {
+  float operator()(float in) const { return in > 0 ? in : 0; }
+  Float4 operator()(const Float4 &in) const { return MaxFloat4(in, DupFloat4(0)); }
+};
+
+bool IsUnary(FusedElemwiseOpType type) { return type >= FUSED_RELU; }
+
+void RunOp(FusedElemwiseOpType type, const float *lhs, size_t lhs_stride, const float *rhs, size_t rhs_stride,
+           float *out, size_t len) {
+  switch (type) {
+    case FUSED_ADD:
+      BinaryRun(lhs, lhs_stride, rhs, rhs_stride, out, len, [](const auto &x, const auto &y) { return x + y; });
+      break;
+    case FUSED_SUB:
+      BinaryRun(lhs, lhs_stride, rhs, rhs_stride, out, len, [](const auto &x, const auto &y) { return x - y; });
+      break;
+    case FUSED_MUL:
+      BinaryRun(lhs, lhs_stride, rhs, rhs_stride, out, len, [](const auto &x, const auto &y) { return x * y; });
+      break;
+    case FUSED_DIV:
+      BinaryRun(lhs, lhs_stride, rhs, rhs_stride, out, len, [](const auto &x, const auto &y) { return x / y; });
+      break;
+    case FUSED_MAX:
+      BinaryRun(lhs, lhs_stride, rhs, rhs_stride, out, len, MaxFunc());
+      break;
+    case FUSED_RELU:
+      UnaryRun(lhs, out, len, ReluFunc());
+      break;
+    case FUSED_NEG:
+      UnaryRun(lhs, out, len, [](const auto &x) { return -x; });
+      break;
+    case FUSED_SQUARE:
+      UnaryRun(lhs, out, len, [](const auto &x) { return x * x; });
+      break;
+    case FUSED_SQRT:
+      UnaryRun(lhs, out, len, [](float x) { return std::sqrt(x); });
+      break;
+    case FUSED_EXP:
+      UnaryRun(lhs, out, len, [](float x) { return std::exp(x); });
+      break;
+    default:
+      MS_LOG(EXCEPTION) << "Unsupported fused elementwise op " << type;
+  }
+}
+}  // namespace
+
+void FusedElemwiseCPUKernel::InitKernel(const CNodePtr &kernel_node) {
+  MS_EXCEPTION_IF_NULL(kernel_node);
+  auto op_names = AnfAlgo::GetNodeAttr<std::vector<std::string>>(kernel_node, kAttrFusedOps);
+  op_inputs_ = AnfAlgo::GetNodeAttr<std::vector<int64_t>>(kernel_node, kAttrFusedOpInputs);
+  if (op_names.empty() || op_inputs_.size() != op_names.size() * kFusedOpInputNum) {
+    MS_LOG(EXCEPTION) << "The fused elementwise op has " << op_names.size() << " ops but " << op_inputs_.size()
+                      << " operands";
+  }
+  size_t input_num = AnfAlgo::GetInputTensorNum(kernel_node);
+  for (size_t k = 0; k < op_names.size(); ++k) {
+    auto iter = kFusedOpTypes.find(op_names[k]);
+    if (iter == kFusedOpTypes.end()) {
+      MS_LOG(EXCEPTION) << "Unsupported fused elementwise op " << op_names[k];
+    }
+    ops_.push_back(iter->second);
+    size_t operand_num = IsUnary(iter->second) ? 1 : kFusedOpInputNum;
+    for (size_t i = 0; i < operand_num; ++i) {
+      auto operand = op_inputs_[k * kFusedOpInputNum + i];
+      // an op reads the inputs or the ops before it
+      if (operand >= SizeToLong(input_num) || operand < -SizeToLong(k)) {
+        MS_LOG(EXCEPTION) << "The operand " << operand << " of the fused op " << k << " is out of range";
+      }
+    }
+  }
+  auto output_shape = AnfAlgo::GetOutputInferShape(kernel_node, 0);
+  output_num_ = ElementNum(output_shape);
+  for (size_t i = 0; i < input_num; ++i) {
+    size_t num = ElementNum(AnfAlgo::GetPrevNodeOutputInferShape(kernel_node, i));
+    if (num != output_num_ && num != 1) {
+      MS_LOG(EXCEPTION) << "The input " << i << " of " << num << " elements can not be broadcast to the output of "
+                        << output_num_ << " elements";
+    }
+    input_broadcast_.push_back(num == 1);
+  }
+}
+
+const float *FusedElemwiseCPUKernel::GetOperand(int64_t operand, const std::vector<const float *> &inputs,
+                                                const float *buffer, size_t pos, size_t *stride) const {
+  if (operand < 0) {
+    *stride = 1;
+    return buffer + LongToSize(-operand - 1) * kFusedTileSize;
+  }
+  auto index = LongToSize(operand);
+  if (input_broadcast_[index]) {
+    *stride = 0;
+    return inputs[index];
+  }
+  *stride = 1;
+  return inputs[index] + pos;
+}
+
+void FusedElemwiseCPUKernel::RunTile(const std::vector<const float *> &inputs, float *output, float *buffer,
+                                     size_t pos, size_t len) const {
+  for (size_t k = 0; k < ops_.size(); ++k) {
+    size_t lhs_stride = 0;
+    size_t rhs_stride = 0;
+    auto lhs = GetOperand(op_inputs_[k * kFusedOpInputNum], inputs, buffer, pos, &lhs_stride);
+    auto rhs = GetOperand(op_inputs_[k * kFusedOpInputNum + 1], inputs, buffer, pos, &rhs_stride);
+    // the last op writes the output
+    float *out = k + 1 == ops_.size() ? output + pos : buffer + k * kFusedTileSize;
+    RunOp(ops_[k], lhs, lhs_stride, rhs, rhs_stride, out, len);
+  }
+}
+
+bool FusedElemwiseCPUKernel::Launch(const std::vector<kernel::AddressPtr> &inputs,
+                                    const std::vector<kernel::AddressPtr> & /*workspace*/,
+                                    const std::vector<kernel::AddressPtr> &outputs) {
+  if (inputs.size() != input_broadcast_.size() || outputs.empty()) {
+    MS_LOG(EXCEPTION) << "The fused elementwise op needs " << input_broadcast_.size() << " inputs, but got "
+                      << inputs.size();
+  }
+  std::vector<const float *> input_addrs;
+  (void)std::transform(inputs.begin(), inputs.end(), std::back_inserter(input_addrs),
+                       [](const AddressPtr &input) { return reinterpret_cast<const float *>(input->addr); });
+  auto output = reinterpret_cast<float *>(outputs[0]->addr);
+  auto task = [this, &input_addrs, output](size_t start, size_t end) {
+    std::vector<float> buffer(ops_.size() * kFusedTileSize);
+    for (size_t pos = start; pos < end; pos += kFusedTileSize) {
+      RunTile(input_addrs, output, buffer.data(), pos, std::min(kFusedTileSize, end - pos));
+    }
+  };
+  CPUKernelUtils::ParallelFor(task, output_num_);
+  return true;
+}
+}  // namespace kernel
+}  // namespace mindspore
@@ -0,0 +1,70 @@
+/**
+ * Copyright 2020 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef MINDSPORE_CCSRC_BACKEND_KERNEL_COMPILER_CPU_FUSED_ELEMWISE_CPU_KERNEL_H_
+#define MINDSPORE_CCSRC_BACKEND_KERNEL_COMPILER_CPU_FUSED_ELEMWISE_CPU_KERNEL_H_
+
+#include <memory>
+#include <vector>
+#include "backend/kernel_compiler/cpu/cpu_kernel.h"
+#include "backend/kernel_compiler/cpu/cpu_kernel_factory.h"
+
+namespace mindspore {
+namespace kernel {
+enum FusedElemwiseOpType {
+  FUSED_ADD = 0,
+  FUSED_SUB,
+  FUSED_MUL,
+  FUSED_DIV,
+  FUSED_MAX,
+  // the unary ops
+  FUSED_RELU,
+  FUSED_NEG,
+  FUSED_SQUARE,
+  FUSED_SQRT,
+  FUSED_EXP
+};
+
+// FusedElemwiseCPUKernel runs the program of elementwise ops built by the cpu elementwise fusion pass. The output is
+// computed tile by tile, the intermediate results of a tile stay in a small buffer in the cache instead of tensors.
+class FusedElemwiseCPUKernel : public CPUKernel {
+ public:
+  FusedElemwiseCPUKernel() = default;
+  ~FusedElemwiseCPUKernel() override = default;
+
+  void InitKernel(const CNodePtr &kernel_node) override;
+
+  bool Launch(const std::vector<AddressPtr> &inputs, const std::vector<AddressPtr> &workspace,
+              const std::vector<AddressPtr> &outputs) override;
+
+ private:
+  const float *GetOperand(int64_t operand, const std::vector<const float *> &inputs, const float *buffer, size_t pos,
+                          size_t *stride) const;
+  void RunTile(const std::vector<const float *> &inputs, float *output, float *buffer, size_t pos, size_t len) const;
+  std::vector<FusedElemwiseOpType> ops_;
+  // two operands per op, i >= 0 for the input i and -(k + 1) for the output of the op k
+  std::vector<int64_t> op_inputs_;
+  // the inputs of one element, broadcast to the output
+  std::vector<bool> input_broadcast_;
+  size_t output_num_{0};
+};
+
+MS_REG_CPU_KERNEL(FusedElemwise,
+                  KernelAttr().SetAllSameAttr(true).AddInputAttr(kNumberTypeFloat32).AddOutputAttr(kNumberTypeFloat32),
+                  FusedElemwiseCPUKernel);
+}  // namespace kernel
+}  // namespace mindspore
+
+#endif  // MINDSPORE_CCSRC_BACKEND_KERNEL_COMPILER_CPU_FUSED_ELEMWISE_CPU_KERNEL_H_
@@ -17,6 +17,7 @@
 #define MINDSPORE_CCSRC_BACKEND_KERNEL_COMPILER_CPU_MAXIMUM_CPU_KERNEL_H_
 
 #include <vector>
+#include "backend/kernel_compiler/cpu/broadcast_iterator.h"
 #include "backend/kernel_compiler/cpu/cpu_kernel.h"
 #include "backend/kernel_compiler/cpu/cpu_kernel_factory.h"
 
@@ -34,43 +35,7 @@ class MaximumCPUKernel : public CPUKernel {
               const std::vector<AddressPtr> &outputs) override;
 
  private:
-  bool IsBroadcast();
-
-  size_t Index(const size_t &index, const size_t &dim);
-
-  void InitTensorBroadcastShape();
-
-  void InitInputTensorAndScalar(size_t max_input_shape_size);
-
-  void InitInputTensors(TypeId input_x_dtype, TypeId input_y_dtype);
-
-  // Broadcast Arithmetic
-  void BroadcastArithKernel(const size_t l0, const size_t l1, const size_t l2, const size_t l3, const size_t l4,
-                            const size_t l5, const size_t l6, const size_t r0, const size_t r1, const size_t r2,
-                            const size_t r3, const size_t r4, const size_t r5, const size_t r6, const size_t d0,
-                            const size_t d1, const size_t d2, const size_t d3, const size_t d4, const size_t d5,
-                            const size_t d6, const T *input_x, const T *input_y, T *output);
-
-  T MaximumFunc(const T &lhs, const T &rhs) { return lhs > rhs ? lhs : rhs; }
-
-  void BroadcastArithOneScalarOneTensor(const T *input_x, const T *input_y, T *output);
-
-  void BroadcastArithTensors(const T *input_x, const T *input_y, T *output);
-
-  void BroadcastArith(const T *input_x, const T *input_y, T *output);
-
- private:
-  bool need_broadcast_{false};
-  size_t input_x_num_{1};
-  size_t input_y_num_{1};
-  size_t output_num_{1};
-  std::vector<size_t> input_x_shape_;
-  std::vector<size_t> input_y_shape_;
-  std::vector<size_t> output_shape_;
-  std::vector<size_t> broadcast_input_x_shape_;
-  std::vector<size_t> broadcast_input_y_shape_;
-  std::vector<size_t> broadcast_output_shape_;
-  const size_t max_dims{7};
+  BroadcastIterator broadcast_iterator_;
 };
 
 MS_REG_CPU_KERNEL_T(
@@ -17,6 +17,7 @@
 #include <string>
 #include <algorithm>
 #include "utils/ms_utils.h"
+#include "utils/utils.h"
 #include "backend/kernel_compiler/cpu/mkldnn/mkl_kernel_engine.h"
 #include "runtime/device/cpu/cpu_device_address.h"
 
@@ -75,25 +76,40 @@ void Conv2dCPUKernel::InitKernel(const CNodePtr &kernel_node) {
   }
   dnnl::memory::dims padding_l{int_padding_l[0], int_padding_l[1]};
   dnnl::memory::dims padding_r{int_padding_r[0], int_padding_r[1]};
+  // the bias and the activation fused by the cpu fusion passes run in the convolution
+  with_bias_ = AnfAlgo::GetCNodeName(kernel_node) == kFusedConv2DBiasAddName;
+  dnnl::memory::desc bias_desc = GetDefaultMemDesc({dst_shape[1]});
+  auto prop_kind = dnnl::prop_kind::forward_training;
+  auto algorithm = dnnl::algorithm::convolution_auto;
   dnnl::convolution_forward::desc desc =
-    dnnl::convolution_forward::desc(dnnl::prop_kind::forward_training, dnnl::algorithm::convolution_auto, src_desc,
-                                    weights_desc, dst_desc, strides, dilates, padding_l, padding_r);
+    with_bias_ ? dnnl::convolution_forward::desc(prop_kind, algorithm, src_desc, weights_desc, bias_desc, dst_desc,
+                                                 strides, dilates, padding_l, padding_r)
+               : dnnl::convolution_forward::desc(prop_kind, algorithm, src_desc, weights_desc, dst_desc, strides,
+                                                 dilates, padding_l, padding_r);
 
-  auto prim_desc = dnnl::convolution_forward::primitive_desc(desc, MKLKernelEngine::Get().engine());
+  auto prim_desc =
+    dnnl::convolution_forward::primitive_desc(desc, GetPostOpAttr(kernel_node), MKLKernelEngine::Get().engine());
   primitive_ = std::make_shared<dnnl::convolution_forward>(prim_desc);
   AddArgument(DNNL_ARG_SRC, src_desc);
   AddArgument(DNNL_ARG_WEIGHTS, weights_desc);
+  if (with_bias_) {
+    AddArgument(DNNL_ARG_BIAS, bias_desc);
+  }
   AddArgument(DNNL_ARG_DST, dst_desc);
 }
 
 bool Conv2dCPUKernel::Launch(const std::vector<kernel::AddressPtr> &inputs,
                              const std::vector<kernel::AddressPtr> & /*workspace*/,
                              const std::vector<kernel::AddressPtr> &outputs) {
-  if (inputs.size() < 2 || outputs.empty()) {
+  size_t input_num = with_bias_ ? 3 : 2;
+  if (inputs.size() < input_num || outputs.empty()) {
     MS_LOG(EXCEPTION) << "error input output size!";
   }
   SetArgumentHandle(DNNL_ARG_SRC, inputs[0]->addr);
   SetArgumentHandle(DNNL_ARG_WEIGHTS, inputs[1]->addr);
+  if (with_bias_) {
+    SetArgumentHandle(DNNL_ARG_BIAS, inputs[2]->addr);
+  }
   SetArgumentHandle(DNNL_ARG_DST, outputs[0]->addr);
   ExecutePrimitive();
   return true;
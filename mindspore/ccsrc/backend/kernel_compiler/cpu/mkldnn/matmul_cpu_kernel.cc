@@ -17,6 +17,7 @@
 #include <utility>
 #include "backend/kernel_compiler/cpu/mkldnn/mkl_kernel_engine.h"
 #include "utils/ms_utils.h"
+#include "utils/utils.h"
 #include "runtime/device/cpu/cpu_device_address.h"
 
 namespace mindspore {
@@ -44,6 +45,24 @@ void MatMulCPUKernel::InitKernel(const CNodePtr &kernel_node) {
     trans_b_ = TRANSPOSE_YES;
   }
   dim_n_ = static_cast<dnnl_dim_t>(dst_shape[1]);
+  // the bias and the activation fused by the cpu fusion passes run in a onednn matmul primitive
+  with_bias_ = AnfAlgo::GetCNodeName(kernel_node) == kFusedMatMulBiasAddName;
+  if (!with_bias_) {
+    return;
+  }
+  auto src_tag = trans_a ? dnnl::memory::format_tag::ba : dnnl::memory::format_tag::ab;
+  auto weights_tag = trans_b ? dnnl::memory::format_tag::ba : dnnl::memory::format_tag::ab;
+  dnnl::memory::desc src_desc = formatted_md({dim_m_, dim_k_}, src_tag);
+  dnnl::memory::desc weights_desc = formatted_md({dim_k_, dim_n_}, weights_tag);
+  dnnl::memory::desc bias_desc = formatted_md({1, dim_n_}, dnnl::memory::format_tag::ab);
+  dnnl::memory::desc dst_desc = formatted_md({dim_m_, dim_n_}, dnnl::memory::format_tag::ab);
+  dnnl::matmul::desc desc(src_desc, weights_desc, bias_desc, dst_desc);
+  auto prim_desc = dnnl::matmul::primitive_desc(desc, GetPostOpAttr(kernel_node), MKLKernelEngine::Get().engine());
+  primitive_ = std::make_shared<dnnl::matmul>(prim_desc);
+  AddArgument(DNNL_ARG_SRC, src_desc);
+  AddArgument(DNNL_ARG_WEIGHTS, weights_desc);
+  AddArgument(DNNL_ARG_BIAS, bias_desc);
+  AddArgument(DNNL_ARG_DST, dst_desc);
 }
 
 bool MatMulCPUKernel::Launch(const std::vector<kernel::AddressPtr> &inputs,
@@ -52,6 +71,17 @@ bool MatMulCPUKernel::Launch(const std::vector<kernel::AddressPtr> &inputs,
   if (inputs.size() < 2 || outputs.empty()) {
     MS_LOG(EXCEPTION) << "matmul error input output size!";
   }
+  if (with_bias_) {
+    if (inputs.size() < 3) {
+      MS_LOG(EXCEPTION) << "matmul with bias error input size!";
+    }
+    SetArgumentHandle(DNNL_ARG_SRC, inputs[0]->addr);
+    SetArgumentHandle(DNNL_ARG_WEIGHTS, inputs[1]->addr);
+    SetArgumentHandle(DNNL_ARG_BIAS, inputs[2]->addr);
+    SetArgumentHandle(DNNL_ARG_DST, outputs[0]->addr);
+    ExecutePrimitive();
+    return true;
+  }
   dnnl_dim_t lda = dim_m_;
   if (trans_a_ == TRANSPOSE_NO) {
     lda = dim_k_;
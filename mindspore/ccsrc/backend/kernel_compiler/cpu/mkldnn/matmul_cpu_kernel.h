@@ -38,12 +38,20 @@ class MatMulCPUKernel : public MKLCPUKernel {
   dnnl_dim_t dim_m_{0};
   dnnl_dim_t dim_n_{0};
   dnnl_dim_t dim_k_{0};
+  bool with_bias_{false};
 };
 
 MS_REG_CPU_KERNEL(
   MatMul,
   KernelAttr().AddInputAttr(kNumberTypeFloat32).AddInputAttr(kNumberTypeFloat32).AddOutputAttr(kNumberTypeFloat32),
   MatMulCPUKernel);
+MS_REG_CPU_KERNEL(FusedMatMulBiasAdd,
+                  KernelAttr()
+                    .AddInputAttr(kNumberTypeFloat32)
+                    .AddInputAttr(kNumberTypeFloat32)
+                    .AddInputAttr(kNumberTypeFloat32)
+                    .AddOutputAttr(kNumberTypeFloat32),
+                  MatMulCPUKernel);
 }  // namespace kernel
 }  // namespace mindspore
 
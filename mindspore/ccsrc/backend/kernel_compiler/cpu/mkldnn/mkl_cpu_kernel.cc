@@ -18,6 +18,7 @@
 #include <string>
 #include <algorithm>
 #include "utils/ms_utils.h"
+#include "utils/utils.h"
 #include "backend/kernel_compiler/cpu/mkldnn/mkl_kernel_engine.h"
 
 namespace mindspore {
@@ -139,6 +140,22 @@ dnnl::memory::desc MKLCPUKernel::GetDefaultMemDesc(const std::vector<size_t> &sh
   return mem_desc;
 }
 
+dnnl::primitive_attr MKLCPUKernel::GetPostOpAttr(const CNodePtr &kernel_node) const {
+  MS_EXCEPTION_IF_NULL(kernel_node);
+  dnnl::primitive_attr attr;
+  if (!AnfAlgo::HasNodeAttr(kAttrActivation, kernel_node)) {
+    return attr;
+  }
+  auto activation = AnfAlgo::GetNodeAttr<std::string>(kernel_node, kAttrActivation);
+  if (activation != kReluOpName) {
+    MS_LOG(EXCEPTION) << "Unsupported post op activation " << activation;
+  }
+  dnnl::post_ops ops;
+  ops.append_eltwise(1.0f, dnnl::algorithm::eltwise_relu, 0.0f, 0.0f);
+  attr.set_post_ops(ops);
+  return attr;
+}
+
 void MKLCPUKernel::AddArgument(int arg_key, const dnnl::memory::desc &mem_desc, bool alloc) {
   arguments_[arg_key] = MKLKernelEngine::Get().CreateMemory(mem_desc, alloc);
 }
@@ -41,6 +41,8 @@ class MKLCPUKernel : public CPUKernel {
   void SetArgumentHandle(int arg_key, void *ptr);
   dnnl::memory::format_tag GetDefaultFormatTag(const dnnl::memory::dims &dims) const;
   dnnl::memory::desc GetDefaultMemDesc(const std::vector<size_t> &shape);
+  // the post ops of the activation attr set by the cpu fusion passes, empty if there is none
+  dnnl::primitive_attr GetPostOpAttr(const CNodePtr &kernel_node) const;
   void ExecutePrimitive();
   std::unordered_map<int, dnnl::memory> arguments_;
   std::shared_ptr<dnnl::primitive> primitive_{nullptr};
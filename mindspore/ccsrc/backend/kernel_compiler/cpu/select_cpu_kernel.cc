@@ -29,11 +29,11 @@ void SelectCPUKernel<T>::InitKernel(const CNodePtr &kernel_node) {
   if (output_num != 1) {
     MS_LOG(EXCEPTION) << "Output number is " << output_num << ", but SelectCpuKernel needs 1 output.";
   }
-  auto shape = AnfAlgo::GetPrevNodeOutputInferShape(kernel_node, 0);
-  for (size_t x : shape) {
-    element_num_ *= x;
-  }
-  return;
+  auto cond_shape = AnfAlgo::GetPrevNodeOutputInferShape(kernel_node, 0);
+  auto x_shape = AnfAlgo::GetPrevNodeOutputInferShape(kernel_node, 1);
+  auto y_shape = AnfAlgo::GetPrevNodeOutputInferShape(kernel_node, 2);
+  auto output_shape = AnfAlgo::GetOutputInferShape(kernel_node, 0);
+  broadcast_iterator_ = BroadcastIterator({cond_shape, x_shape, y_shape}, output_shape);
 }
 
 template <typename T>
@@ -43,9 +43,11 @@ bool SelectCPUKernel<T>::Launch(const std::vector<AddressPtr> &inputs, const std
   auto input_x = reinterpret_cast<T *>(inputs[1]->addr);
   auto input_y = reinterpret_cast<T *>(inputs[2]->addr);
   auto output = reinterpret_cast<T *>(outputs[0]->addr);
-  for (size_t pos = 0; pos < element_num_; pos++) {
-    output[pos] = input_cond[pos] ? input_x[pos] : input_y[pos];
-  }
+  auto task = [this, input_cond, input_x, input_y, output](size_t start, size_t end) {
+    BroadcastTernary(broadcast_iterator_, input_cond, input_x, input_y, output, start, end,
+                     [](bool cond, const T &x, const T &y) { return cond ? x : y; });
+  };
+  CPUKernelUtils::ParallelFor(task, broadcast_iterator_.output_num());
   return true;
 }
 
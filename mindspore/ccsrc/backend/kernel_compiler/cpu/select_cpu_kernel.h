@@ -17,6 +17,7 @@
 #define MINDSPORE_CCSRC_BACKEND_KERNEL_COMPILER_CPU_SELECT_CPU_KERNEL_H_
 
 #include <vector>
+#include "backend/kernel_compiler/cpu/broadcast_iterator.h"
 #include "backend/kernel_compiler/cpu/cpu_kernel.h"
 #include "backend/kernel_compiler/cpu/cpu_kernel_factory.h"
 
@@ -34,7 +35,7 @@ class SelectCPUKernel : public CPUKernel {
   void InitKernel(const CNodePtr &kernel_node) override;
 
  private:
-  size_t element_num_{1};
+  BroadcastIterator broadcast_iterator_;
 };
 
 MS_REG_CPU_KERNEL_T(Select,
@@ -0,0 +1,107 @@
+/**
+ * Copyright 2020 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "backend/optimizer/cpu/bias_add_fusion.h"
+#include <memory>
+#include <string>
+#include <vector>
+#include "backend/optimizer/common/helper.h"
+#include "backend/session/anf_runtime_algorithm.h"
+#include "utils/utils.h"
+
+namespace mindspore {
+namespace opt {
+namespace {
+// op(x, w) followed by BiasAdd(op, b) -> fused_op_name(x, w, b) with the attrs of op
+AnfNodePtr CreateBiasAddFusedNode(const FuncGraphPtr &graph, const AnfNodePtr &bias_add, const AnfNodePtr &op,
+                                  const std::string &fused_op_name, const std::vector<AnfNodePtr> &op_inputs) {
+  MS_EXCEPTION_IF_NULL(graph);
+  MS_EXCEPTION_IF_NULL(bias_add);
+  if (op == nullptr || !op->isa<CNode>()) {
+    MS_LOG(EXCEPTION) << "Get the CNode fused with " << bias_add->DebugString() << " failed!";
+  }
+  // the output of op is computed anyway if others use it, fusing would compute it twice
+  if (IsUsedByOthers(graph, op) || AnfAlgo::GetOutputInferDataType(bias_add, 0) != kNumberTypeFloat32) {
+    return nullptr;
+  }
+  std::vector<AnfNodePtr> inputs = {NewValueNode(std::make_shared<Primitive>(fused_op_name))};
+  inputs.insert(inputs.end(), op_inputs.begin(), op_inputs.end());
+  auto new_node = graph->NewCNode(inputs);
+  MS_EXCEPTION_IF_NULL(new_node);
+  new_node->set_scope(bias_add->scope());
+  new_node->set_abstract(bias_add->abstract());
+  AnfAlgo::CopyNodeAttrs(op, new_node);
+  return new_node;
+}
+}  // namespace
+
+const BaseRef CpuMatMulBiasAddFusion::DefinePattern() const {
+  VectorRef matmul({matmul_var_, x0_, x1_});
+  return VectorRef({prim::kPrimBiasAdd, matmul, x2_});
+}
+
+const AnfNodePtr CpuMatMulBiasAddFusion::Process(const FuncGraphPtr &graph, const AnfNodePtr &node,
+                                                 const EquivPtr &equiv) const {
+  MS_EXCEPTION_IF_NULL(equiv);
+  std::vector<AnfNodePtr> inputs = {GetAnfNodeByVar(equiv, x0_), GetAnfNodeByVar(equiv, x1_),
+                                    GetAnfNodeByVar(equiv, x2_)};
+  return CreateBiasAddFusedNode(graph, node, GetAnfNodeByVar(equiv, matmul_var_), kFusedMatMulBiasAddName, inputs);
+}
+
+const BaseRef CpuConv2DBiasAddFusion::DefinePattern() const {
+  VectorRef conv({conv_var_, x0_, x1_});
+  return VectorRef({prim::kPrimBiasAdd, conv, x2_});
+}
+
+const AnfNodePtr CpuConv2DBiasAddFusion::Process(const FuncGraphPtr &graph, const AnfNodePtr &node,
+                                                 const EquivPtr &equiv) const {
+  MS_EXCEPTION_IF_NULL(equiv);
+  std::vector<AnfNodePtr> inputs = {GetAnfNodeByVar(equiv, x0_), GetAnfNodeByVar(equiv, x1_),
+                                    GetAnfNodeByVar(equiv, x2_)};
+  return CreateBiasAddFusedNode(graph, node, GetAnfNodeByVar(equiv, conv_var_), kFusedConv2DBiasAddName, inputs);
+}
+
+const BaseRef CpuReluPostOpFusion::DefinePattern() const { return VectorRef({prim::kPrimRelu, x_}); }
+
+const AnfNodePtr CpuReluPostOpFusion::Process(const FuncGraphPtr &graph, const AnfNodePtr &node,
+                                              const EquivPtr &equiv) const {
+  MS_EXCEPTION_IF_NULL(graph);
+  MS_EXCEPTION_IF_NULL(node);
+  MS_EXCEPTION_IF_NULL(equiv);
+  auto input = GetAnfNodeByVar(equiv, x_);
+  MS_EXCEPTION_IF_NULL(input);
+  if (!input->isa<CNode>()) {
+    return nullptr;
+  }
+  auto op_name = AnfAlgo::GetCNodeName(input);
+  if (op_name != kFusedMatMulBiasAddName && op_name != kFusedConv2DBiasAddName) {
+    return nullptr;
+  }
+  auto input_cnode = input->cast<CNodePtr>();
+  if (AnfAlgo::HasNodeAttr(kAttrActivation, input_cnode) || IsUsedByOthers(graph, input)) {
+    return nullptr;
+  }
+  auto inputs = input_cnode->inputs();
+  inputs[0] = NewValueNode(std::make_shared<Primitive>(op_name));
+  auto new_node = graph->NewCNode(inputs);
+  MS_EXCEPTION_IF_NULL(new_node);
+  new_node->set_scope(node->scope());
+  new_node->set_abstract(node->abstract());
+  AnfAlgo::CopyNodeAttrs(input, new_node);
+  AnfAlgo::SetNodeAttr(kAttrActivation, MakeValue(std::string(kReluOpName)), new_node);
+  return new_node;
+}
+}  // namespace opt
+}  // namespace mindspore
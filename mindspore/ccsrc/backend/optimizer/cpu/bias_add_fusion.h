@@ -0,0 +1,81 @@
+/**
+ * Copyright 2020 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef MINDSPORE_CCSRC_BACKEND_OPTIMIZER_CPU_BIAS_ADD_FUSION_H_
+#define MINDSPORE_CCSRC_BACKEND_OPTIMIZER_CPU_BIAS_ADD_FUSION_H_
+
+#include <memory>
+#include "backend/optimizer/common/optimizer.h"
+
+namespace mindspore {
+namespace opt {
+// BiasAdd(MatMul(x, w), b) -> FusedMatMulBiasAdd(x, w, b), run by one onednn matmul with bias
+class CpuMatMulBiasAddFusion : public PatternProcessPass {
+ public:
+  explicit CpuMatMulBiasAddFusion(bool multigraph = true)
+      : PatternProcessPass("cpu_matmul_biasadd_fusion", multigraph) {
+    x0_ = std::make_shared<Var>();
+    x1_ = std::make_shared<Var>();
+    x2_ = std::make_shared<Var>();
+    matmul_var_ = std::make_shared<Var>(std::make_shared<Primitive>(prim::kPrimMatMul->name()));
+  }
+  ~CpuMatMulBiasAddFusion() override = default;
+  const BaseRef DefinePattern() const override;
+  const AnfNodePtr Process(const FuncGraphPtr &, const AnfNodePtr &, const EquivPtr &) const override;
+
+ private:
+  VarPtr x0_;
+  VarPtr x1_;
+  VarPtr x2_;
+  VarPtr matmul_var_;
+};
+
+// BiasAdd(Conv2D(x, w), b) -> FusedConv2DBiasAdd(x, w, b), run by one onednn convolution with bias
+class CpuConv2DBiasAddFusion : public PatternProcessPass {
+ public:
+  explicit CpuConv2DBiasAddFusion(bool multigraph = true)
+      : PatternProcessPass("cpu_conv2d_biasadd_fusion", multigraph) {
+    x0_ = std::make_shared<Var>();
+    x1_ = std::make_shared<Var>();
+    x2_ = std::make_shared<Var>();
+    conv_var_ = std::make_shared<Var>(std::make_shared<Primitive>(prim::kPrimConv2D->name()));
+  }
+  ~CpuConv2DBiasAddFusion() override = default;
+  const BaseRef DefinePattern() const override;
+  const AnfNodePtr Process(const FuncGraphPtr &, const AnfNodePtr &, const EquivPtr &) const override;
+
+ private:
+  VarPtr x0_;
+  VarPtr x1_;
+  VarPtr x2_;
+  VarPtr conv_var_;
+};
+
+// ReLU(FusedMatMulBiasAdd/FusedConv2DBiasAdd) -> the fused op with a relu post op, the activation attr is set
+class CpuReluPostOpFusion : public PatternProcessPass {
+ public:
+  explicit CpuReluPostOpFusion(bool multigraph = true) : PatternProcessPass("cpu_relu_post_op_fusion", multigraph) {
+    x_ = std::make_shared<Var>();
+  }
+  ~CpuReluPostOpFusion() override = default;
+  const BaseRef DefinePattern() const override;
+  const AnfNodePtr Process(const FuncGraphPtr &, const AnfNodePtr &, const EquivPtr &) const override;
+
+ private:
+  VarPtr x_;
+};
+}  // namespace opt
+}  // namespace mindspore
+#endif  // MINDSPORE_CCSRC_BACKEND_OPTIMIZER_CPU_BIAS_ADD_FUSION_H_
@@ -0,0 +1,136 @@
+/**
+ * Copyright 2020 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "backend/optimizer/cpu/elemwise_fusion.h"
+#include <algorithm>
+#include <functional>
+#include <memory>
+#include <numeric>
+#include <set>
+#include <string>
+#include <unordered_set>
+#include <vector>
+#include "backend/session/anf_runtime_algorithm.h"
+#include "ir/manager.h"
+#include "utils/convert_utils_base.h"
+#include "utils/utils.h"
+
+namespace mindspore {
+namespace opt {
+namespace {
+const std::set<std::string> kFusibleOps = {kTensorAddOpName, kSubOpName, kMulOpName, kRealDivOpName, kMaximumOpName,
+                                           kReluOpName, kNegOpName, kSquareOpName, kSqrtOpName, kExpOpName};
+
+struct FusedProgram {
+  std::vector<std::string> op_names;
+  std::vector<int64_t> op_inputs;
+  std::vector<AnfNodePtr> inputs;
+  std::vector<AnfNodePtr> ops;
+};
+
+size_t ElementNum(const std::vector<size_t> &shape) {
+  return std::accumulate(shape.begin(), shape.end(), size_t(1), std::multiplies<size_t>());
+}
+
+bool IsFusible(const AnfNodePtr &node) {
+  MS_EXCEPTION_IF_NULL(node);
+  if (!node->isa<CNode>() || kFusibleOps.count(AnfAlgo::GetCNodeName(node)) == 0) {
+    return false;
+  }
+  if (AnfAlgo::IsDynamicShape(node) || AnfAlgo::GetOutputTensorNum(node) != 1 ||
+      AnfAlgo::GetOutputInferDataType(node, 0) != kNumberTypeFloat32) {
+    return false;
+  }
+  auto shape = AnfAlgo::GetOutputInferShape(node, 0);
+  size_t input_num = AnfAlgo::GetInputTensorNum(node);
+  if (input_num == 0 || input_num > 2) {
+    return false;
+  }
+  for (size_t i = 0; i < input_num; ++i) {
+    if (AnfAlgo::GetPrevNodeOutputInferDataType(node, i) != kNumberTypeFloat32) {
+      return false;
+    }
+    auto input_shape = AnfAlgo::GetPrevNodeOutputInferShape(node, i);
+    if (input_shape != shape && ElementNum(input_shape) != 1) {
+      return false;
+    }
+  }
+  return true;
+}
+
+// the node is the only user of the input, control and attached edges included
+bool IsOnlyUser(const FuncGraphManagerPtr &manager, const AnfNodePtr &input, const AnfNodePtr &node) {
+  auto iter = manager->node_users().find(input);
+  return iter != manager->node_users().end() && iter->second.size() == 1 && iter->second.front().first == node;
+}
+
+// append the ops of the tree rooted at the node to the program in post order, returns the operand of the node
+int64_t EmitOps(const FuncGraphManagerPtr &manager, const CNodePtr &node, const std::vector<size_t> &shape,
+                FusedProgram *program) {
+  std::vector<int64_t> operands(2, 0);
+  size_t input_num = AnfAlgo::GetInputTensorNum(node);
+  for (size_t i = 0; i < input_num; ++i) {
+    auto input = node->input(i + 1);
+    if (IsFusible(input) && IsOnlyUser(manager, input, node) && AnfAlgo::GetOutputInferShape(input, 0) == shape) {
+      operands[i] = EmitOps(manager, input->cast<CNodePtr>(), shape, program);
+      continue;
+    }
+    auto pos = std::find(program->inputs.begin(), program->inputs.end(), input);
+    operands[i] = pos - program->inputs.begin();
+    if (pos == program->inputs.end()) {
+      program->inputs.push_back(input);
+    }
+  }
+  program->op_names.push_back(AnfAlgo::GetCNodeName(node));
+  program->op_inputs.insert(program->op_inputs.end(), operands.begin(), operands.end());
+  program->ops.push_back(node);
+  return -SizeToLong(program->op_names.size());
+}
+}  // namespace
+
+bool CpuElemwiseFusion::Run(const FuncGraphPtr &graph) {
+  MS_EXCEPTION_IF_NULL(graph);
+  auto manager = graph->manager();
+  MS_EXCEPTION_IF_NULL(manager);
+  // from the outputs to the inputs, so a tree is fused from its root
+  auto todos = TopoSort(graph->get_return());
+  std::unordered_set<AnfNodePtr> fused;
+  bool changed = false;
+  for (auto iter = todos.rbegin(); iter != todos.rend(); ++iter) {
+    auto root = *iter;
+    if (fused.count(root) != 0 || !IsFusible(root)) {
+      continue;
+    }
+    FusedProgram program;
+    (void)EmitOps(manager, root->cast<CNodePtr>(), AnfAlgo::GetOutputInferShape(root, 0), &program);
+    if (program.ops.size() < 2) {
+      continue;
+    }
+    std::vector<AnfNodePtr> inputs = {NewValueNode(std::make_shared<Primitive>(kFusedElemwiseName))};
+    inputs.insert(inputs.end(), program.inputs.begin(), program.inputs.end());
+    auto fused_node = graph->NewCNode(inputs);
+    MS_EXCEPTION_IF_NULL(fused_node);
+    fused_node->set_scope(root->scope());
+    fused_node->set_abstract(root->abstract());
+    AnfAlgo::SetNodeAttr(kAttrFusedOps, MakeValue(program.op_names), fused_node);
+    AnfAlgo::SetNodeAttr(kAttrFusedOpInputs, MakeValue(program.op_inputs), fused_node);
+    fused.insert(program.ops.begin(), program.ops.end());
+    (void)manager->Replace(root, fused_node);
+    changed = true;
+  }
+  return changed;
+}
+}  // namespace opt
+}  // namespace mindspore
@@ -0,0 +1,35 @@
+/**
+ * Copyright 2020 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef MINDSPORE_CCSRC_BACKEND_OPTIMIZER_CPU_ELEMWISE_FUSION_H_
+#define MINDSPORE_CCSRC_BACKEND_OPTIMIZER_CPU_ELEMWISE_FUSION_H_
+
+#include "backend/optimizer/common/pass.h"
+
+namespace mindspore {
+namespace opt {
+// CpuElemwiseFusion replaces the trees of float32 elementwise ops of one shape, whose inner ops are used by the tree
+// only, by one FusedElemwise op. The ops are kept as a program in the attrs of the fused op: kAttrFusedOps holds the
+// op names in the order they run, kAttrFusedOpInputs two operands per op, i >= 0 being the input i of the fused op
+// and -(k + 1) the output of the op k. The inputs of the fused op have the shape of its output or one element.
+class CpuElemwiseFusion : public Pass {
+ public:
+  CpuElemwiseFusion() : Pass("cpu_elemwise_fusion") {}
+  ~CpuElemwiseFusion() override = default;
+  bool Run(const FuncGraphPtr &graph) override;
+};
+}  // namespace opt
+}  // namespace mindspore
+#endif  // MINDSPORE_CCSRC_BACKEND_OPTIMIZER_CPU_ELEMWISE_FUSION_H_
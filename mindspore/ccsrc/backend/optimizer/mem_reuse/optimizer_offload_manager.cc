@@ -0,0 +1,273 @@
+/**
+ * Copyright 2020 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "backend/optimizer/mem_reuse/optimizer_offload_manager.h"
+
+#include <cstdlib>
+#include <cstring>
+#include "runtime/device/convert_tensor_utils.h"
+#include "utils/log_adapter.h"
+
+namespace mindspore {
+namespace device {
+namespace memswap {
+OptimizerOffloadManager::OptimizerOffloadManager(const MemCopyManagerPtr &mem_copy_manager)
+    : mem_copy_manager_(mem_copy_manager) {
+  worker_ = std::thread(&OptimizerOffloadManager::Run, this);
+}
+
+OptimizerOffloadManager::~OptimizerOffloadManager() {
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    stop_ = true;
+  }
+  task_cond_.notify_all();
+  if (worker_.joinable()) {
+    worker_.join();
+  }
+  ClearParameters();
+}
+
+HostAddress OptimizerOffloadManager::AllocHostMem(size_t size) {
+  HostAddress host_addr{nullptr, size};
+  // the pinned memory lets the device copy the gradients asynchronously, while the cpu backend has no device memory
+  if (mem_copy_manager_ != nullptr) {
+    if (!mem_copy_manager_->AllocHostPinnedMem(size, &host_addr.addr)) {
+      MS_LOG(EXCEPTION) << "Alloc " << size << " bytes pinned host memory for optimizer offload failed";
+    }
+  } else {
+    host_addr.addr = malloc(size);
+  }
+  if (host_addr.addr == nullptr) {
+    MS_LOG(EXCEPTION) << "Alloc " << size << " bytes host memory for optimizer offload failed";
+  }
+  return host_addr;
+}
+
+void OptimizerOffloadManager::FreeHostMem(HostAddress *host_addr) {
+  MS_EXCEPTION_IF_NULL(host_addr);
+  if (host_addr->addr == nullptr) {
+    return;
+  }
+  if (mem_copy_manager_ != nullptr) {
+    mem_copy_manager_->FreeHostPinnedMem(host_addr->addr);
+  } else {
+    free(host_addr->addr);
+  }
+  host_addr->addr = nullptr;
+  host_addr->size = 0;
+}
+
+size_t OptimizerOffloadManager::AddParameter(const std::string &name, void *device_weight, const void *host_weight,
+                                             size_t elem_num, TypeId weight_type, bool use_nesterov) {
+  MS_EXCEPTION_IF_NULL(host_weight);
+  if (weight_type != kNumberTypeFloat32 && weight_type != kNumberTypeFloat16) {
+    MS_LOG(EXCEPTION) << "The optimizer offload only supports float32 and float16 weight, but the weight of " << name
+                      << " is " << TypeIdLabel(weight_type);
+  }
+  auto parameter = std::make_shared<OffloadParameter>();
+  parameter->name_ = name;
+  parameter->elem_num_ = elem_num;
+  parameter->weight_type_ = weight_type;
+  parameter->use_nesterov_ = use_nesterov;
+  parameter->device_weight_ = device_weight;
+  size_t fp32_size = elem_num * sizeof(float);
+  parameter->master_weight_ = AllocHostMem(fp32_size);
+  parameter->m_ = AllocHostMem(fp32_size);
+  parameter->v_ = AllocHostMem(fp32_size);
+  parameter->hyper_params_ = AllocHostMem(kOffloadHyperParamNum * sizeof(float));
+  (void)memset(parameter->m_.addr, 0, fp32_size);
+  (void)memset(parameter->v_.addr, 0, fp32_size);
+  if (weight_type == kNumberTypeFloat32) {
+    (void)memcpy(parameter->master_weight_.addr, host_weight, fp32_size);
+    // the fp32 weight is uploaded from the master weight directly
+    parameter->grad_ = AllocHostMem(fp32_size);
+    parameter->weight_ = parameter->master_weight_;
+    parameter->device_m_ = parameter->m_;
+    parameter->device_v_ = parameter->v_;
+  } else {
+    size_t fp16_size = elem_num * sizeof(float16);
+    HalfToFloat(parameter->master_weight_.addr, host_weight, elem_num);
+    parameter->grad_ = AllocHostMem(fp16_size);
+    parameter->weight_ = AllocHostMem(fp16_size);
+    parameter->fp32_grad_ = AllocHostMem(fp32_size);
+    parameter->device_m_ = AllocHostMem(fp16_size);
+    parameter->device_v_ = AllocHostMem(fp16_size);
+    (void)memcpy(parameter->weight_.addr, host_weight, fp16_size);
+    (void)memset(parameter->device_m_.addr, 0, fp16_size);
+    (void)memset(parameter->device_v_.addr, 0, fp16_size);
+  }
+  std::lock_guard<std::mutex> lock(mutex_);
+  parameters_.push_back(parameter);
+  return parameters_.size() - 1;
+}
+
+const OffloadParameterPtr &OptimizerOffloadManager::parameter(size_t index) const {
+  if (index >= parameters_.size()) {
+    MS_LOG(EXCEPTION) << "The offload parameter index " << index << " is out of range " << parameters_.size();
+  }
+  return parameters_[index];
+}
+
+void OptimizerOffloadManager::PushUpdate(size_t index, const OffloadReadyFunc &ready) {
+  (void)parameter(index);
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    tasks_.emplace(index, ready);
+    ++running_num_;
+  }
+  task_cond_.notify_one();
+}
+
+void OptimizerOffloadManager::Run() {
+  while (true) {
+    OffloadReadyFunc ready;
+    OffloadParameterPtr parameter;
+    {
+      std::unique_lock<std::mutex> lock(mutex_);
+      task_cond_.wait(lock, [this] { return stop_ || !tasks_.empty(); });
+      if (tasks_.empty()) {
+        return;
+      }
+      parameter = parameters_[tasks_.front().first];
+      ready = tasks_.front().second;
+      tasks_.pop();
+    }
+    bool ret = (ready == nullptr || ready()) && Update(parameter);
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      failed_ = failed_ || !ret;
+      --running_num_;
+    }
+    finish_cond_.notify_all();
+  }
+}
+
+bool OptimizerOffloadManager::Update(const OffloadParameterPtr &parameter) {
+  MS_EXCEPTION_IF_NULL(parameter);
+  auto grad = parameter->grad_;
+  if (parameter->weight_type_ == kNumberTypeFloat16) {
+    HalfToFloat(parameter->fp32_grad_.addr, grad.addr, parameter->elem_num_);
+    grad = parameter->fp32_grad_;
+  }
+  auto make_address = [](void *addr, size_t size) {
+    auto address = std::make_shared<kernel::Address>();
+    address->addr = addr;
+    address->size = size;
+    return address;
+  };
+  size_t fp32_size = parameter->elem_num_ * sizeof(float);
+  auto master_weight = make_address(parameter->master_weight_.addr, fp32_size);
+  auto m = make_address(parameter->m_.addr, fp32_size);
+  auto v = make_address(parameter->v_.addr, fp32_size);
+  std::vector<kernel::AddressPtr> inputs = {master_weight, m, v};
+  float hyper_params[kOffloadHyperParamNum];
+  if (parameter->weight_type_ == kNumberTypeFloat16) {
+    HalfToFloat(hyper_params, parameter->hyper_params_.addr, kOffloadHyperParamNum);
+  } else {
+    (void)memcpy(hyper_params, parameter->hyper_params_.addr, sizeof(hyper_params));
+  }
+  for (size_t i = 0; i < kOffloadHyperParamNum; ++i) {
+    inputs.push_back(make_address(hyper_params + i, sizeof(float)));
+  }
+  inputs.push_back(make_address(grad.addr, fp32_size));
+  std::vector<kernel::AddressPtr> outputs = {master_weight, m, v};
+  adam_.set_use_nesterov(parameter->use_nesterov_);
+  try {
+    if (!adam_.Launch(inputs, {}, outputs)) {
+      MS_LOG(ERROR) << "The host Adam of parameter " << parameter->name_ << " failed";
+      return false;
+    }
+  } catch (std::exception &e) {
+    MS_LOG(ERROR) << "The host Adam of parameter " << parameter->name_ << " failed: " << e.what();
+    return false;
+  }
+  if (parameter->weight_type_ == kNumberTypeFloat16) {
+    FloatToHalf(parameter->weight_.addr, parameter->master_weight_.addr, parameter->elem_num_);
+    FloatToHalf(parameter->device_m_.addr, parameter->m_.addr, parameter->elem_num_);
+    FloatToHalf(parameter->device_v_.addr, parameter->v_.addr, parameter->elem_num_);
+  }
+  parameter->updated_ = true;
+  return true;
+}
+
+bool OptimizerOffloadManager::WaitStep(const OffloadUploadFunc &upload) {
+  {
+    std::unique_lock<std::mutex> lock(mutex_);
+    finish_cond_.wait(lock, [this] { return running_num_ == 0; });
+    if (failed_) {
+      failed_ = false;
+      return false;
+    }
+  }
+  for (auto &parameter : parameters_) {
+    if (!parameter->updated_) {
+      continue;
+    }
+    parameter->updated_ = false;
+    if (upload == nullptr || parameter->device_weight_ == nullptr) {
+      continue;
+    }
+    if (!upload(parameter->device_weight_, parameter->weight_.addr, parameter->weight_.size)) {
+      MS_LOG(ERROR) << "Upload the weight of parameter " << parameter->name_ << " failed";
+      return false;
+    }
+  }
+  return true;
+}
+
+void OptimizerOffloadManager::ReloadStates(size_t index) {
+  auto parameter = this->parameter(index);
+  if (parameter->weight_type_ != kNumberTypeFloat16) {
+    // the states of weight_type alias the fp32 ones
+    return;
+  }
+  std::lock_guard<std::mutex> lock(mutex_);
+  auto reload = [&parameter](const HostAddress &state, const HostAddress &half_state) {
+    auto fp32_data = static_cast<float *>(state.addr);
+    auto fp16_data = static_cast<const float16 *>(half_state.addr);
+    for (size_t i = 0; i < parameter->elem_num_; ++i) {
+      float value = half_to_float(fp16_data[i]);
+      if (half_to_float(float16(fp32_data[i])) != value) {
+        fp32_data[i] = value;
+      }
+    }
+  };
+  reload(parameter->master_weight_, parameter->weight_);
+  reload(parameter->m_, parameter->device_m_);
+  reload(parameter->v_, parameter->device_v_);
+}
+
+void OptimizerOffloadManager::ClearParameters() {
+  std::lock_guard<std::mutex> lock(mutex_);
+  for (auto &parameter : parameters_) {
+    if (parameter->weight_type_ == kNumberTypeFloat16) {
+      FreeHostMem(&parameter->weight_);
+      FreeHostMem(&parameter->device_m_);
+      FreeHostMem(&parameter->device_v_);
+    }
+    FreeHostMem(&parameter->master_weight_);
+    FreeHostMem(&parameter->m_);
+    FreeHostMem(&parameter->v_);
+    FreeHostMem(&parameter->grad_);
+    FreeHostMem(&parameter->fp32_grad_);
+    FreeHostMem(&parameter->hyper_params_);
+  }
+  parameters_.clear();
+}
+}  // namespace memswap
+}  // namespace device
+}  // namespace mindspore
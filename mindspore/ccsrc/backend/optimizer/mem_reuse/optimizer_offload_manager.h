@@ -0,0 +1,115 @@
+/**
+ * Copyright 2020 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef MINDSPORE_CCSRC_BACKEND_OPTIMIZER_MEM_REUSE_OPTIMIZER_OFFLOAD_MANAGER_H_
+#define MINDSPORE_CCSRC_BACKEND_OPTIMIZER_MEM_REUSE_OPTIMIZER_OFFLOAD_MANAGER_H_
+
+#include <condition_variable>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <queue>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+#include "backend/kernel_compiler/cpu/adam_cpu_kernel.h"
+#include "backend/optimizer/mem_reuse/mem_copy_manager.h"
+
+namespace mindspore {
+namespace device {
+namespace memswap {
+// beta1_power, beta2_power, lr, beta1, beta2 and epsilon, the scalar inputs of Adam
+constexpr size_t kOffloadHyperParamNum = 6;
+
+// A parameter updated by Adam on the host. The moments and the fp32 master weight live in the host memory, and the
+// device only keeps the weight of weight_type_ used by forward and backward.
+struct OffloadParameter {
+  std::string name_;
+  size_t elem_num_{0};
+  TypeId weight_type_{kNumberTypeFloat32};
+  bool use_nesterov_{false};
+  void *device_weight_{nullptr};
+  HostAddress master_weight_{nullptr, 0};
+  HostAddress m_{nullptr, 0};
+  HostAddress v_{nullptr, 0};
+  // the gradient and the weight of weight_type_ copied from and to the device
+  HostAddress grad_{nullptr, 0};
+  HostAddress weight_{nullptr, 0};
+  // the moments of weight_type_ which the device addresses of the moments point to, so the checkpoints read them
+  HostAddress device_m_{nullptr, 0};
+  HostAddress device_v_{nullptr, 0};
+  // the fp32 gradient converted from the fp16 one
+  HostAddress fp32_grad_{nullptr, 0};
+  // the scalar inputs of Adam of weight_type_ copied from the device
+  HostAddress hyper_params_{nullptr, 0};
+  bool updated_{false};
+};
+using OffloadParameterPtr = std::shared_ptr<OffloadParameter>;
+// wait until the gradient and the hyper params copied to the host are ready
+using OffloadReadyFunc = std::function<bool()>;
+using OffloadUploadFunc = std::function<bool(void *device_weight, const void *host_weight, size_t size)>;
+
+// Keep the Adam states in the host memory and update them on CPU, as ZeRO-offload. The runtime copies each gradient to
+// the host when it is produced in backward and pushes its update, so the copies and the updates run on the worker
+// while backward goes on. The updated weights are uploaded at the end of the step, after backward stops reading them.
+class OptimizerOffloadManager {
+ public:
+  explicit OptimizerOffloadManager(const MemCopyManagerPtr &mem_copy_manager);
+  OptimizerOffloadManager(const OptimizerOffloadManager &) = delete;
+  OptimizerOffloadManager &operator=(const OptimizerOffloadManager &) = delete;
+  ~OptimizerOffloadManager();
+
+  // host_weight is the initial weight of weight_type, which is float32 or float16, and the moments start from zero.
+  // The weight and the moments of weight_type alias the fp32 ones for the float32 weight.
+  size_t AddParameter(const std::string &name, void *device_weight, const void *host_weight, size_t elem_num,
+                      TypeId weight_type, bool use_nesterov = false);
+  const OffloadParameterPtr &parameter(size_t index) const;
+  size_t parameter_num() const { return parameters_.size(); }
+
+  void PushUpdate(size_t index, const OffloadReadyFunc &ready);
+  // wait for the updates pushed in the step and upload the updated weights
+  bool WaitStep(const OffloadUploadFunc &upload);
+  // reload the fp32 states from weight_ and the moments of weight_type rewritten outside the steps, such as by
+  // load_param_into_net, the elements equal to their rounded fp32 states keep the fp32 ones
+  void ReloadStates(size_t index);
+  void ClearParameters();
+
+ private:
+  void Run();
+  bool Update(const OffloadParameterPtr &parameter);
+  HostAddress AllocHostMem(size_t size);
+  void FreeHostMem(HostAddress *host_addr);
+
+  MemCopyManagerPtr mem_copy_manager_;
+  // only used by the worker, which sets use_nesterov of the parameter before each update
+  kernel::AdamCPUKernel adam_;
+  std::vector<OffloadParameterPtr> parameters_;
+  std::thread worker_;
+  std::mutex mutex_;
+  std::condition_variable task_cond_;
+  std::condition_variable finish_cond_;
+  std::queue<std::pair<size_t, OffloadReadyFunc>> tasks_;
+  size_t running_num_{0};
+  bool failed_{false};
+  bool stop_{false};
+};
+using OptimizerOffloadManagerPtr = std::shared_ptr<OptimizerOffloadManager>;
+}  // namespace memswap
+}  // namespace device
+}  // namespace mindspore
+
+#endif  // MINDSPORE_CCSRC_BACKEND_OPTIMIZER_MEM_REUSE_OPTIMIZER_OFFLOAD_MANAGER_H_
@@ -16,6 +16,8 @@
 #include "backend/optimizer/pass/communication_op_fusion.h"
 
 #include <vector>
+#include <functional>
+#include <numeric>
 #include <set>
 #include <memory>
 #include <unordered_map>
@@ -25,6 +27,7 @@
 #include "runtime/device/kernel_info.h"
 #include "backend/session/anf_runtime_algorithm.h"
 #include "backend/kernel_compiler/kernel_build_info.h"
+#include "backend/optimizer/pass/communication_op_profile.h"
 #include "frontend/parallel/context.h"
 
 namespace mindspore {
@@ -124,6 +127,12 @@ bool CheckSegments(size_t segments, size_t communication_op_node_size, const std
   }
   return true;
 }
+
+float GetOutputBytes(const AnfNodePtr &node) {
+  auto shape = AnfAlgo::GetOutputInferShape(node, 0);
+  size_t element_num = std::accumulate(shape.begin(), shape.end(), static_cast<size_t>(1), std::multiplies<size_t>());
+  return static_cast<float>(element_num * GetTypeByte(TypeIdToType(AnfAlgo::GetOutputInferDataType(node, 0))));
+}
 }  // namespace
 
 bool CommunicationOpFusion::GetSplitSegments(const CommunicationOpInfo &communication_op_info, size_t *segment_num,
@@ -137,7 +146,12 @@ bool CommunicationOpFusion::GetSplitSegments(const CommunicationOpInfo &communic
   MS_EXCEPTION_IF_NULL(parallel_context);
   std::vector<uint32_t> split_indices;
   if (!parallel_context->enable_parallel_optimizer()) {
-    split_indices = parallel_context->GetAllReduceFusionSplitIndices(group);
+    // the indices profiled on the network are used before the ones set for the group
+    split_indices = parallel_context->GetAllReduceFusionSplitIndices(
+      CommunicationOpProfile::NetworkGroupKey(group, communication_op_info.input_grad_size));
+    if (split_indices.empty()) {
+      split_indices = parallel_context->GetAllReduceFusionSplitIndices(group);
+    }
   }
 
   size_t segments = 0;
@@ -168,6 +182,32 @@ bool CommunicationOpFusion::GetSplitSegments(const CommunicationOpInfo &communic
   return CheckSegments(segments, communication_op_node_size, segment_index);
 }
 
+// Profile the times the gradients are ready in the first steps, the segments chosen by the profile are set as the
+// split indices of the group scoped to the network, unless the group of the network has been profiled.
+bool CommunicationOpFusion::RegisterProfile(const std::string &group, const CommunicationOpInfo &communication_op_info,
+                                            bool split, const std::vector<size_t> &segment_index) const {
+  auto parallel_context = parallel::ParallelContext::GetInstance();
+  MS_EXCEPTION_IF_NULL(parallel_context);
+  auto profile_steps = parallel_context->all_reduce_fusion_profile_steps();
+  auto &profile = CommunicationOpProfile::GetInstance();
+  if (op_name_ != kAllReduceOpName || profile_steps <= 0 || profile.IsProfiled(group)) {
+    return false;
+  }
+  const auto &nodes = communication_op_info.communication_op_nodes;
+  std::vector<size_t> profiled_segment_index = segment_index;
+  if (!split) {
+    // each op is a segment if the group is not fused
+    profiled_segment_index.clear();
+    for (size_t i = 0; i < nodes.size(); ++i) {
+      profiled_segment_index.push_back(i);
+      profile.RegisterCommunicationOp(nodes[i], group, i);
+    }
+  }
+  profile.RegisterGroup(group, communication_op_info.input_grad_size, profiled_segment_index,
+                        LongToSize(profile_steps));
+  return true;
+}
+
 AnfNodePtr CommunicationOpFusion::CreateFusedCommunicationOp(const FuncGraphPtr &func_graph,
                                                              const CommunicationOpInfo &communication_op_info,
                                                              size_t start_index, size_t end_index) const {
@@ -221,7 +261,8 @@ AnfNodePtr CommunicationOpFusion::CreateFusedCommunicationOp(const FuncGraphPtr
 }
 
 bool CommunicationOpFusion::DoFusion(const FuncGraphPtr &func_graph, const CommunicationOpInfo &communication_op_info,
-                                     size_t segment_num, const std::vector<size_t> &segment_index) const {
+                                     size_t segment_num, const std::vector<size_t> &segment_index,
+                                     const std::string &profile_group) const {
   MS_EXCEPTION_IF_NULL(func_graph);
   auto manager = func_graph->manager();
   MS_EXCEPTION_IF_NULL(manager);
@@ -230,6 +271,10 @@ bool CommunicationOpFusion::DoFusion(const FuncGraphPtr &func_graph, const Commu
   for (size_t segment_idx = 0; segment_idx < segment_num; ++segment_idx) {
     size_t end_index = segment_index.at(segment_idx);
     if (end_index - start_index < 1) {
+      if (!profile_group.empty()) {
+        CommunicationOpProfile::GetInstance().RegisterCommunicationOp(
+          communication_op_info.communication_op_nodes.at(start_index), profile_group, start_index);
+      }
       start_index = end_index + 1;
       continue;
     }
@@ -238,6 +283,9 @@ bool CommunicationOpFusion::DoFusion(const FuncGraphPtr &func_graph, const Commu
     AnfNodePtr new_communication_op =
       CreateFusedCommunicationOp(func_graph, communication_op_info, start_index, end_index);
     AnfAlgo::SetGraphId(graph_id, new_communication_op.get());
+    if (!profile_group.empty()) {
+      CommunicationOpProfile::GetInstance().RegisterCommunicationOp(new_communication_op, profile_group, start_index);
+    }
     // replace old communication op with new communication op
     for (auto idx = start_index; idx <= end_index; ++idx) {
       std::vector<AnfNodePtr> tuple_getitem_input;
@@ -268,7 +316,6 @@ bool CommunicationOpFusion::DoFusion(const FuncGraphPtr &func_graph, const Commu
 
 bool CommunicationOpFusion::Run(const FuncGraphPtr &func_graph) {
   MS_EXCEPTION_IF_NULL(func_graph);
-  const float input_grad_size_num = 0.0;
   const float input_grad_time_num = 0.0;
   // divide candidate fusion groups with same (group,op,fusion) attrs, fusion==0 means not fusion
   std::unordered_map<std::string, CommunicationOpInfo> candidate_groups;
@@ -284,7 +331,7 @@ bool CommunicationOpFusion::Run(const FuncGraphPtr &func_graph) {
         candidate_groups[key] = communication_op_info;
       }
       candidate_groups[key].communication_op_nodes.push_back(node->cast<CNodePtr>());
-      candidate_groups[key].input_grad_size.push_back(input_grad_size_num);
+      candidate_groups[key].input_grad_size.push_back(GetOutputBytes(node));
       candidate_groups[key].input_grad_time.push_back(input_grad_time_num);
     }
   }
@@ -305,8 +352,11 @@ bool CommunicationOpFusion::Run(const FuncGraphPtr &func_graph) {
     }
     size_t segment_num = 0;
     std::vector<size_t> segment_index;
-    if (GetSplitSegments(it.second, &segment_num, &segment_index, it.first)) {
-      if (DoFusion(func_graph, it.second, segment_num, segment_index)) {
+    bool split = GetSplitSegments(it.second, &segment_num, &segment_index, it.first);
+    auto profile_group = CommunicationOpProfile::NetworkGroupKey(it.first, it.second.input_grad_size);
+    bool profiled = RegisterProfile(profile_group, it.second, split, segment_index);
+    if (split) {
+      if (DoFusion(func_graph, it.second, segment_num, segment_index, profiled ? profile_group : "")) {
         changed = true;
       }
     }
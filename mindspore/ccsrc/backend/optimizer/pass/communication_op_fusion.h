@@ -41,12 +41,14 @@ class CommunicationOpFusion : public Pass {
 
  private:
   bool DoFusion(const FuncGraphPtr &func_graph, const CommunicationOpInfo &communication_op_info, size_t segment_num,
-                const std::vector<size_t> &segment_index) const;
+                const std::vector<size_t> &segment_index, const std::string &profile_group = "") const;
   AnfNodePtr CreateFusedCommunicationOp(const FuncGraphPtr &func_graph,
                                         const CommunicationOpInfo &communication_op_info, size_t start_index,
                                         size_t end_index) const;
   bool GetSplitSegments(const CommunicationOpInfo &communication_op_info, size_t *segment_num,
                         std::vector<size_t> *segment_index, const std::string &group) const;
+  bool RegisterProfile(const std::string &group, const CommunicationOpInfo &communication_op_info, bool split,
+                       const std::vector<size_t> &segment_index) const;
   std::string op_name_;
   size_t groups_ = 1;
 };
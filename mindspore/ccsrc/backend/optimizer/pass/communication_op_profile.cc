@@ -0,0 +1,331 @@
+/**
+ * Copyright 2020 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "backend/optimizer/pass/communication_op_profile.h"
+
+#include <algorithm>
+#include <cmath>
+#include <iterator>
+#include <limits>
+#include <numeric>
+
+#include "frontend/parallel/context.h"
+#include "utils/log_adapter.h"
+
+namespace mindspore {
+namespace opt {
+namespace {
+// the relative difference of the finish times regarded as equal, where the fewer segments are chosen
+constexpr double kFinishTimeTolerance = 1e-9;
+
+struct SegmentCost {
+  double ready_time;
+  double bytes;
+};
+
+std::vector<SegmentCost> GetSegmentCosts(const std::vector<float> &grad_time, const std::vector<float> &grad_size,
+                                         const std::vector<size_t> &segment_index) {
+  std::vector<SegmentCost> segments;
+  size_t start_index = 0;
+  for (auto end_index : segment_index) {
+    SegmentCost segment{0.0, 0.0};
+    for (size_t i = start_index; i <= end_index && i < grad_time.size(); ++i) {
+      segment.ready_time = std::max(segment.ready_time, static_cast<double>(grad_time[i]));
+      segment.bytes += grad_size[i];
+    }
+    segments.push_back(segment);
+    start_index = end_index + 1;
+  }
+  return segments;
+}
+}  // namespace
+
+std::vector<size_t> SplitByBackwardTime(const std::vector<float> &grad_time, const std::vector<float> &grad_size,
+                                        double latency, double time_per_byte) {
+  if (grad_time.size() != grad_size.size()) {
+    MS_LOG(EXCEPTION) << "The size of grad_time " << grad_time.size() << " and grad_size " << grad_size.size()
+                      << " should be the same";
+  }
+  size_t op_num = grad_time.size();
+  if (op_num == 0) {
+    return {};
+  }
+  // the gradients are produced in the reverse order of the parameters in backward, so the segments are chosen from
+  // the op whose input is ready first
+  bool reverse = grad_time.front() > grad_time.back();
+  auto op_index = [op_num, reverse](size_t k) { return reverse ? op_num - 1 - k : k; };
+
+  // finish[j] is the earliest time the first j ops are communicated, and cut[j] is the start of the last segment
+  std::vector<double> finish(op_num + 1, std::numeric_limits<double>::max());
+  std::vector<size_t> segment_num(op_num + 1, 0);
+  std::vector<size_t> cut(op_num + 1, 0);
+  finish[0] = 0.0;
+  for (size_t j = 1; j <= op_num; ++j) {
+    double ready_time = 0.0;
+    double bytes = 0.0;
+    for (size_t i = j; i > 0; --i) {
+      ready_time = std::max(ready_time, static_cast<double>(grad_time[op_index(i - 1)]));
+      bytes += grad_size[op_index(i - 1)];
+      double time = std::max(finish[i - 1], ready_time) + latency + time_per_byte * bytes;
+      double tolerance = kFinishTimeTolerance * std::max(std::abs(time), 1.0);
+      if (time < finish[j] - tolerance ||
+          (time <= finish[j] + tolerance && segment_num[i - 1] + 1 < segment_num[j])) {
+        finish[j] = time;
+        segment_num[j] = segment_num[i - 1] + 1;
+        cut[j] = i - 1;
+      }
+    }
+  }
+
+  std::vector<size_t> segment_index;
+  for (size_t j = op_num; j > 0; j = cut[j]) {
+    // the segment is the ops from cut[j] to j - 1 in the order of the ready times
+    segment_index.push_back(reverse ? op_num - 1 - cut[j] : j - 1);
+  }
+  std::sort(segment_index.begin(), segment_index.end());
+  return segment_index;
+}
+
+double SimulateSegments(const std::vector<float> &grad_time, const std::vector<float> &grad_size,
+                        const std::vector<size_t> &segment_index, double latency, double time_per_byte) {
+  auto segments = GetSegmentCosts(grad_time, grad_size, segment_index);
+  std::stable_sort(segments.begin(), segments.end(),
+                   [](const SegmentCost &a, const SegmentCost &b) { return a.ready_time < b.ready_time; });
+  double finish = 0.0;
+  for (auto &segment : segments) {
+    finish = std::max(finish, segment.ready_time) + latency + time_per_byte * segment.bytes;
+  }
+  return finish;
+}
+
+CommunicationOpProfile &CommunicationOpProfile::GetInstance() {
+  static CommunicationOpProfile instance;
+  return instance;
+}
+
+std::string CommunicationOpProfile::NetworkGroupKey(const std::string &group, const std::vector<float> &grad_size) {
+  double bytes = std::accumulate(grad_size.begin(), grad_size.end(), 0.0);
+  return group + "_" + std::to_string(grad_size.size()) + "_" + std::to_string(static_cast<size_t>(bytes));
+}
+
+void CommunicationOpProfile::SetProfileReducer(const ProfileReducer &reducer) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  reducer_ = reducer;
+}
+
+void CommunicationOpProfile::RegisterGroup(const std::string &group, const std::vector<float> &grad_size,
+                                           const std::vector<size_t> &segment_index, size_t profile_steps) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  auto &profile = groups_[group];
+  profile = GroupProfile();
+  profile.grad_size = grad_size;
+  profile.segment_index = segment_index;
+  profile.grad_time_sum.resize(grad_size.size(), 0.0);
+  profile.grad_time_num.resize(grad_size.size(), 0);
+  profile.profile_steps = profile_steps;
+  MS_LOG(INFO) << "Profile the " << grad_size.size() << " communication ops of " << group << " in " << profile_steps
+               << " steps";
+}
+
+void CommunicationOpProfile::RegisterCommunicationOp(const AnfNodePtr &node, const std::string &group,
+                                                     size_t start_index) {
+  MS_EXCEPTION_IF_NULL(node);
+  std::lock_guard<std::mutex> lock(mutex_);
+  communication_ops_[node] = std::make_pair(group, start_index);
+}
+
+bool CommunicationOpProfile::IsProfiled(const std::string &group) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  return groups_.find(group) != groups_.end();
+}
+
+bool CommunicationOpProfile::recording() {
+  std::lock_guard<std::mutex> lock(mutex_);
+  return std::any_of(groups_.begin(), groups_.end(), [](const std::pair<const std::string, GroupProfile> &item) {
+    return !item.second.finished;
+  });
+}
+
+bool CommunicationOpProfile::FindCommunicationOp(const AnfNodePtr &node, std::string *group, size_t *start_index) {
+  MS_EXCEPTION_IF_NULL(group);
+  MS_EXCEPTION_IF_NULL(start_index);
+  std::lock_guard<std::mutex> lock(mutex_);
+  auto iter = communication_ops_.find(node);
+  if (iter == communication_ops_.end()) {
+    return false;
+  }
+  *group = iter->second.first;
+  *start_index = iter->second.second;
+  return true;
+}
+
+void CommunicationOpProfile::RecordGradReady(const std::string &group, size_t index, double ready_time) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  auto iter = groups_.find(group);
+  if (iter == groups_.end() || iter->second.finished || index >= iter->second.grad_time_sum.size()) {
+    return;
+  }
+  iter->second.grad_time_sum[index] += ready_time;
+  ++iter->second.grad_time_num[index];
+}
+
+void CommunicationOpProfile::RecordCommunication(double bytes, double cost_time) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  communication_samples_.emplace_back(bytes, cost_time);
+}
+
+void CommunicationOpProfile::EndStep() {
+  std::lock_guard<std::mutex> lock(mutex_);
+  for (auto &item : groups_) {
+    auto &profile = item.second;
+    if (profile.finished || profile.grad_time_num.empty()) {
+      continue;
+    }
+    // only the groups recorded in the step are counted
+    size_t recorded = *std::max_element(profile.grad_time_num.begin(), profile.grad_time_num.end());
+    if (recorded <= profile.step) {
+      continue;
+    }
+    profile.step = recorded;
+    if (profile.step >= profile.profile_steps) {
+      FinishGroup(item.first, &profile);
+    }
+  }
+}
+
+void CommunicationOpProfile::FinishGroup(const std::string &group, GroupProfile *profile) {
+  MS_EXCEPTION_IF_NULL(profile);
+  profile->finished = true;
+  for (auto iter = communication_ops_.begin(); iter != communication_ops_.end();) {
+    iter = iter->second.first == group ? communication_ops_.erase(iter) : std::next(iter);
+  }
+  std::vector<float> grad_time;
+  for (size_t i = 0; i < profile->grad_time_sum.size(); ++i) {
+    if (profile->grad_time_num[i] == 0) {
+      MS_LOG(WARNING) << "The input of the communication op " << i << " of " << group
+                      << " is not profiled, the split indices are not changed";
+      return;
+    }
+    grad_time.push_back(static_cast<float>(profile->grad_time_sum[i] / profile->grad_time_num[i]));
+  }
+  double latency = kDefaultCommunicationLatency;
+  double time_per_byte = kDefaultCommunicationTimePerByte;
+  FitCommunicationCostLocked(&latency, &time_per_byte);
+  if (reducer_) {
+    // the ranks profile different times, while the communication ops of them must be fused into the same segments
+    std::vector<float> ranks_profile = grad_time;
+    ranks_profile.push_back(static_cast<float>(latency));
+    ranks_profile.push_back(static_cast<float>(time_per_byte));
+    reducer_(&ranks_profile);
+    if (ranks_profile.size() != grad_time.size() + 2) {
+      MS_LOG(EXCEPTION) << "The size of the reduced profile " << ranks_profile.size() << " should be "
+                        << grad_time.size() + 2;
+    }
+    std::copy(ranks_profile.begin(), ranks_profile.begin() + grad_time.size(), grad_time.begin());
+    latency = ranks_profile[grad_time.size()];
+    time_per_byte = ranks_profile[grad_time.size() + 1];
+  }
+  auto segment_index = SplitByBackwardTime(grad_time, profile->grad_size, latency, time_per_byte);
+  double profiled_finish = SimulateSegments(grad_time, profile->grad_size, segment_index, latency, time_per_byte);
+  double origin_finish =
+    SimulateSegments(grad_time, profile->grad_size, profile->segment_index, latency, time_per_byte);
+
+  // the split indices are the end indices of the segments but the last, and the first one should be positive
+  for (size_t i = 0; i + 1 < segment_index.size(); ++i) {
+    if (segment_index[i] > 0) {
+      profile->split_indices.push_back(SizeToUint(segment_index[i]));
+    }
+  }
+  MS_LOG(INFO) << "The " << grad_time.size() << " communication ops of " << group << " are split into "
+               << profile->split_indices.size() + 1 << " segments by the backward time, whose communication finishes "
+               << profiled_finish << " us after the step begins, while the " << profile->segment_index.size()
+               << " segments finish at " << origin_finish << " us. The latency is " << latency
+               << " us and the time per byte is " << time_per_byte << " us. The split indices are "
+               << profile->split_indices;
+  if (!profile->split_indices.empty()) {
+    parallel::ParallelContext::GetInstance()->SetAllReduceFusionSplitIndices(profile->split_indices, group);
+  }
+}
+
+void CommunicationOpProfile::Clear() {
+  std::lock_guard<std::mutex> lock(mutex_);
+  groups_.clear();
+  communication_ops_.clear();
+  communication_samples_.clear();
+}
+
+std::vector<float> CommunicationOpProfile::grad_time(const std::string &group) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  std::vector<float> grad_time;
+  auto iter = groups_.find(group);
+  if (iter == groups_.end()) {
+    return grad_time;
+  }
+  auto &profile = iter->second;
+  for (size_t i = 0; i < profile.grad_time_sum.size(); ++i) {
+    grad_time.push_back(
+      profile.grad_time_num[i] == 0 ? 0.0f : static_cast<float>(profile.grad_time_sum[i] / profile.grad_time_num[i]));
+  }
+  return grad_time;
+}
+
+std::vector<uint32_t> CommunicationOpProfile::split_indices(const std::string &group) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  auto iter = groups_.find(group);
+  return iter == groups_.end() ? std::vector<uint32_t>() : iter->second.split_indices;
+}
+
+void CommunicationOpProfile::FitCommunicationCost(double *latency, double *time_per_byte) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  FitCommunicationCostLocked(latency, time_per_byte);
+}
+
+// Fit the samples as latency + time_per_byte * bytes by the least squares. The default latency is used if the samples
+// have a single size, or the fitted line is not increasing.
+void CommunicationOpProfile::FitCommunicationCostLocked(double *latency, double *time_per_byte) const {
+  MS_EXCEPTION_IF_NULL(latency);
+  MS_EXCEPTION_IF_NULL(time_per_byte);
+  *latency = kDefaultCommunicationLatency;
+  *time_per_byte = kDefaultCommunicationTimePerByte;
+  if (communication_samples_.empty()) {
+    return;
+  }
+  double n = static_cast<double>(communication_samples_.size());
+  double sum_bytes = 0.0;
+  double sum_time = 0.0;
+  for (auto &sample : communication_samples_) {
+    sum_bytes += sample.first;
+    sum_time += sample.second;
+  }
+  double mean_bytes = sum_bytes / n;
+  double mean_time = sum_time / n;
+  double covariance = 0.0;
+  double variance = 0.0;
+  for (auto &sample : communication_samples_) {
+    covariance += (sample.first - mean_bytes) * (sample.second - mean_time);
+    variance += (sample.first - mean_bytes) * (sample.first - mean_bytes);
+  }
+  if (variance > 0 && covariance > 0) {
+    *time_per_byte = covariance / variance;
+    *latency = std::max(mean_time - *time_per_byte * mean_bytes, 0.0);
+    return;
+  }
+  double exceeded_time = std::max(sum_time - n * kDefaultCommunicationLatency, 0.0);
+  if (sum_bytes > 0 && exceeded_time > 0) {
+    *time_per_byte = exceeded_time / sum_bytes;
+  }
+}
+}  // namespace opt
+}  // namespace mindspore
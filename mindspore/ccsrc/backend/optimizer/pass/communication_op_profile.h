@@ -0,0 +1,99 @@
+/**
+ * Copyright 2020 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef MINDSPORE_CCSRC_BACKEND_OPTIMIZER_PASS_COMMUNICATION_OP_PROFILE_H_
+#define MINDSPORE_CCSRC_BACKEND_OPTIMIZER_PASS_COMMUNICATION_OP_PROFILE_H_
+#include <functional>
+#include <map>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "ir/anf.h"
+
+namespace mindspore {
+namespace opt {
+// the cost of a communication op used if the profile can not fit it, in us and us per byte
+constexpr double kDefaultCommunicationLatency = 30.0;
+constexpr double kDefaultCommunicationTimePerByte = 1e-4;
+
+// Choose the segments of the communication ops, whose inputs are ready at grad_time and have grad_size bytes, to
+// finish the last communication as early as possible. A segment starts when all its inputs are ready and the previous
+// communication finishes, and costs latency + time_per_byte * bytes. Return the end index of each segment.
+std::vector<size_t> SplitByBackwardTime(const std::vector<float> &grad_time, const std::vector<float> &grad_size,
+                                        double latency, double time_per_byte);
+// the time the last communication of the segments finishes
+double SimulateSegments(const std::vector<float> &grad_time, const std::vector<float> &grad_size,
+                        const std::vector<size_t> &segment_index, double latency, double time_per_byte);
+
+// Record the times the inputs of the communication ops are ready in the first steps, with the costs of the
+// communication ops. The communication ops are profiled by the group key of CommunicationOpFusion, and the segments
+// chosen by the profile are set as the split indices of the group, which are used when the graph is compiled again.
+class CommunicationOpProfile {
+ public:
+  // average the profile of all the ranks in place, so that the ranks choose the same segments
+  using ProfileReducer = std::function<void(std::vector<float> *)>;
+  static CommunicationOpProfile &GetInstance();
+  void SetProfileReducer(const ProfileReducer &reducer);
+  // the group scoped to the network by the number and the bytes of its communication ops, so that the split indices
+  // profiled on a network are never used to split the group of another one
+  static std::string NetworkGroupKey(const std::string &group, const std::vector<float> &grad_size);
+
+  // the communication ops of the group with their input bytes, and the segments they are fused into
+  void RegisterGroup(const std::string &group, const std::vector<float> &grad_size,
+                     const std::vector<size_t> &segment_index, size_t profile_steps);
+  // the node communicates the inputs of the ops from start_index of the group
+  void RegisterCommunicationOp(const AnfNodePtr &node, const std::string &group, size_t start_index);
+  bool IsProfiled(const std::string &group);
+  bool recording();
+  bool FindCommunicationOp(const AnfNodePtr &node, std::string *group, size_t *start_index);
+
+  // the times are in us from the beginning of the step
+  void RecordGradReady(const std::string &group, size_t index, double ready_time);
+  void RecordCommunication(double bytes, double cost_time);
+  // finish the profile of the groups after their profile steps, and set their split indices
+  void EndStep();
+  void Clear();
+
+  std::vector<float> grad_time(const std::string &group);
+  std::vector<uint32_t> split_indices(const std::string &group);
+  void FitCommunicationCost(double *latency, double *time_per_byte);
+
+ private:
+  struct GroupProfile {
+    std::vector<float> grad_size;
+    std::vector<size_t> segment_index;
+    std::vector<double> grad_time_sum;
+    std::vector<size_t> grad_time_num;
+    size_t profile_steps = 0;
+    size_t step = 0;
+    bool finished = false;
+    std::vector<uint32_t> split_indices;
+  };
+  CommunicationOpProfile() = default;
+  void FinishGroup(const std::string &group, GroupProfile *profile);
+  void FitCommunicationCostLocked(double *latency, double *time_per_byte) const;
+
+  std::mutex mutex_;
+  std::map<std::string, GroupProfile> groups_;
+  std::unordered_map<AnfNodePtr, std::pair<std::string, size_t>> communication_ops_;
+  std::vector<std::pair<double, double>> communication_samples_;
+  ProfileReducer reducer_;
+};
+}  // namespace opt
+}  // namespace mindspore
+#endif  // MINDSPORE_CCSRC_BACKEND_OPTIMIZER_PASS_COMMUNICATION_OP_PROFILE_H_
@@ -0,0 +1,164 @@
+/**
+ * Copyright 2020 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+// Replays the somas_solver_input_<graph_id>.ir files dumped by the solver when save_graphs is set, and reports the
+// memory of the conflicts and the time of the heuristics run one after another and in parallel.
+// Usage: somas_solver_perf <somas_solver_input file>...
+
+#ifdef USE_GLOG
+#include <glog/logging.h>
+#endif
+#include <algorithm>
+#include <chrono>
+#include <fstream>
+#include <iostream>
+#include <memory>
+#include <sstream>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "backend/optimizer/somas/somas_solver_pre.h"
+
+namespace mindspore {
+namespace somas {
+namespace {
+struct SolverInput {
+  std::vector<SomasSolverTensorDesc> tensors;
+  std::vector<std::pair<size_t, size_t>> conflicts;
+  std::vector<std::vector<size_t>> continuous;
+  size_t max_index = 0;
+};
+
+bool LoadSolverInput(const std::string &file_name, SolverInput *input) {
+  std::ifstream ifs(file_name);
+  if (!ifs.is_open()) {
+    std::cerr << "Open " << file_name << " failed." << std::endl;
+    return false;
+  }
+  std::string line;
+  while (std::getline(ifs, line)) {
+    std::istringstream iss(line);
+    std::string kind;
+    iss >> kind;
+    if (kind == "T") {
+      size_t index = 0;
+      size_t size = 0;
+      bool lifelong = false;
+      iss >> index >> size >> lifelong;
+      input->tensors.emplace_back(index, size, 0, lifelong);
+      input->max_index = std::max(input->max_index, index);
+    } else if (kind == "C") {
+      size_t index1 = 0;
+      size_t index2 = 0;
+      iss >> index1 >> index2;
+      input->conflicts.emplace_back(index1, index2);
+      input->max_index = std::max(input->max_index, std::max(index1, index2));
+    } else if (kind == "S") {
+      std::vector<size_t> continuous;
+      size_t index = 0;
+      while (iss >> index) {
+        continuous.push_back(index);
+      }
+      input->continuous.push_back(continuous);
+    }
+  }
+  return !input->tensors.empty();
+}
+
+// the solver links and moves the tensors, every run starts from fresh ones
+std::unordered_map<size_t, SomasSolverTensorDescPtr> CreateTensors(const SolverInput &input) {
+  std::unordered_map<size_t, SomasSolverTensorDescPtr> tensors;
+  for (auto &tensor : input.tensors) {
+    tensors[tensor.index_] =
+      std::make_shared<SomasSolverTensorDesc>(tensor.index_, tensor.size_, tensor.offset_, tensor.lifelong_);
+  }
+  return tensors;
+}
+
+double ElapsedMs(const std::chrono::steady_clock::time_point &start) {
+  return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+}
+
+int Run(const std::string &file_name) {
+  SolverInput input;
+  if (!LoadSolverInput(file_name, &input)) {
+    std::cerr << "No tensor found in " << file_name << "." << std::endl;
+    return 1;
+  }
+  auto start = std::chrono::steady_clock::now();
+  size_t count = input.max_index + 1;
+  auto conflicts = std::make_shared<ConflictMatrix>(count, DynamicBitSet(count));
+  for (auto &conflict : input.conflicts) {
+    (*conflicts)[conflict.first].SetBitTrue(conflict.second);
+  }
+  double build_time = ElapsedMs(start);
+  std::cout << file_name << ": " << input.tensors.size() << " tensors, " << input.conflicts.size() << " conflicts, "
+            << input.continuous.size() << " continuous lists" << std::endl;
+  std::cout << "conflict matrix: " << count * (*conflicts)[0].MemorySize() << " bytes as bits, "
+            << count * count * sizeof(int) << " bytes as int, built in " << build_time << " ms" << std::endl;
+
+  // every heuristic alone, as the solver ran them one after another
+  double sequential_time = 0;
+  size_t sequential_best = SIZE_MAX;
+  for (size_t algorithm = 0; algorithm < kNumAlgorithmTypes; algorithm++) {
+    for (size_t sorting = 0; sorting < kNumSortingTypes; sorting++) {
+      for (size_t fitting = 0; fitting < kNumFittingTypes; fitting++) {
+        auto tensors = CreateTensors(input);
+        SomasSolverPre solver;
+        start = std::chrono::steady_clock::now();
+        if (solver.Solving(0, &tensors, conflicts, input.continuous, false, false, static_cast<SortingType>(sorting),
+                           static_cast<FittingType>(fitting), static_cast<AlgorithmType>(algorithm)) != SUCCESS) {
+          return 1;
+        }
+        sequential_time += ElapsedMs(start);
+        sequential_best = std::min(sequential_best, solver.GetMaxOffset());
+      }
+    }
+  }
+  std::cout << "sequential heuristics: " << sequential_best << " bytes in " << sequential_time << " ms" << std::endl;
+
+  auto tensors = CreateTensors(input);
+  SomasSolverPre solver;
+  start = std::chrono::steady_clock::now();
+  if (solver.Solving(0, &tensors, conflicts, input.continuous, false) != SUCCESS) {
+    return 1;
+  }
+  double parallel_time = ElapsedMs(start);
+  std::cout << "parallel heuristics: " << solver.GetMaxOffset() << " bytes in " << parallel_time << " ms"
+            << std::endl;
+  return 0;
+}
+}  // namespace
+}  // namespace somas
+}  // namespace mindspore
+
+int main(int argc, char **argv) {
+#ifdef USE_GLOG
+  FLAGS_logtostderr = true;
+  google::InitGoogleLogging(argv[0]);
+#endif
+  if (argc < 2) {
+    std::cerr << "Usage: " << argv[0] << " <somas_solver_input file>..." << std::endl;
+    return 1;
+  }
+  int ret = 0;
+  for (int i = 1; i < argc; ++i) {
+    ret |= mindspore::somas::Run(argv[i]);
+  }
+  return ret;
+}
@@ -623,11 +623,11 @@ void Somas::ComputeConflictPairs() {
   PreprocessingConflicts();
   MS_LOG(INFO) << "End Preprocessing Conflicts";
 
-  MS_LOG(INFO) << "Start Array Initialization";
-  cannot_reuse_ =
-    std::make_shared<Array>(tensors_list_.back()->GetId() + 1,
-                            tensors_list_.back()->GetId() + 1);  // array size is (max_id + 1) x (max_id + 1)
-  MS_LOG(INFO) << "End Array Initialization";
+  MS_LOG(INFO) << "Start Conflict Matrix Initialization";
+  // matrix size is (max_id + 1) x (max_id + 1), every pair conflicts until reuse is allowed
+  size_t count = tensors_list_.back()->GetId() + 1;
+  cannot_reuse_ = std::make_shared<ConflictMatrix>(count, DynamicBitSet(count, true));
+  MS_LOG(INFO) << "End Conflict Matrix Initialization, " << count * (*cannot_reuse_)[0].MemorySize() << " bytes";
 
   MS_LOG(INFO) << "Start Conflict Computing";
 
@@ -655,8 +655,8 @@ void Somas::ComputeConflictPairs() {
             if (tensor->IsSemiLifelongStart()) continue;
             if (tensor->IsRefOverlap()) continue;
 
-            (*cannot_reuse_)(ancestor_tensor->GetId(), tensor->GetId()) = 0;
-            (*cannot_reuse_)(tensor->GetId(), ancestor_tensor->GetId()) = 0;
+            (*cannot_reuse_)[ancestor_tensor->GetId()].SetBitFalse(tensor->GetId());
+            (*cannot_reuse_)[tensor->GetId()].SetBitFalse(ancestor_tensor->GetId());
             count_reuse++;
           }
         } else {
@@ -669,8 +669,8 @@ void Somas::ComputeConflictPairs() {
               if (tensor->IsSemiLifelongStart()) continue;
               if (tensor->IsRefOverlap()) continue;
 
-              (*cannot_reuse_)(ancestor_tensor->GetId(), tensor->GetId()) = 0;
-              (*cannot_reuse_)(tensor->GetId(), ancestor_tensor->GetId()) = 0;
+              (*cannot_reuse_)[ancestor_tensor->GetId()].SetBitFalse(tensor->GetId());
+              (*cannot_reuse_)[tensor->GetId()].SetBitFalse(ancestor_tensor->GetId());
               count_reuse++;
             }
           }
@@ -702,8 +702,8 @@ void Somas::ComputeConflictPairs() {
             size_t max_ancestor_order = tensor->GetSourceNode()->anc_stream_max_order_[ancestor_stream->GetId()];
 
             if (ancestor_tensor->lifetime_.end_ <= max_ancestor_order) {
-              (*cannot_reuse_)(ancestor_tensor->GetId(), tensor->GetId()) = 0;
-              (*cannot_reuse_)(tensor->GetId(), ancestor_tensor->GetId()) = 0;
+              (*cannot_reuse_)[ancestor_tensor->GetId()].SetBitFalse(tensor->GetId());
+              (*cannot_reuse_)[tensor->GetId()].SetBitFalse(ancestor_tensor->GetId());
               count_reuse++;
             }
           }
@@ -722,8 +722,8 @@ void Somas::ComputeConflictPairs() {
             if (tensor->IsRefOverlap()) continue;
 
             if (ValidSubset(dest_streams, ancestors_and_self, ancestor_tensor, tensor)) {
-              (*cannot_reuse_)(ancestor_tensor->GetId(), tensor->GetId()) = 0;
-              (*cannot_reuse_)(tensor->GetId(), ancestor_tensor->GetId()) = 0;
+              (*cannot_reuse_)[ancestor_tensor->GetId()].SetBitFalse(tensor->GetId());
+              (*cannot_reuse_)[tensor->GetId()].SetBitFalse(ancestor_tensor->GetId());
               count_reuse++;
             }
           }
@@ -767,8 +767,8 @@ void Somas::ComputeConflictPairs() {
             continue;
 
           // If arrived here, allow reuse
-          (*cannot_reuse_)(tensor2->GetId(), tensor1->GetId()) = 0;
-          (*cannot_reuse_)(tensor1->GetId(), tensor2->GetId()) = 0;
+          (*cannot_reuse_)[tensor2->GetId()].SetBitFalse(tensor1->GetId());
+          (*cannot_reuse_)[tensor1->GetId()].SetBitFalse(tensor2->GetId());
           count_reuse++;
         }
       }
@@ -794,17 +794,12 @@ bool Somas::Assign(const session::KernelGraph *graph) {
                                                   [this](size_t tid) { return tensors_map_[tid]->contiguous_; });
     // Keep all constraints for first tensor in list
     size_t tid_0 = ref_node_list[0];
+    auto &conflicts_0 = (*cannot_reuse_)[tid_0];
+    for (size_t tid : ref_node_list) {
+      conflicts_0.Union((*cannot_reuse_)[tid]);
+    }
     for (SomasTensorPtr tensor : tensors_list_) {
-      if ((*cannot_reuse_)(tid_0, tensor->GetId()) == 1) {
-        continue;
-      }
-      for (size_t tid : ref_node_list) {
-        if ((*cannot_reuse_)(tid, tensor->GetId()) == 1) {
-          (*cannot_reuse_)(tid_0, tensor->GetId()) = 1;
-          (*cannot_reuse_)(tensor->GetId(), tid_0) = 1;
-          break;
-        }
-      }
+      (*cannot_reuse_)[tensor->GetId()].SetBit(tid_0, conflicts_0.IsBitTrue(tensor->GetId()));
     }
     // Set rest to size 0, so that solver ignores them (if not contiguous)
     for (size_t i = 1; i < ref_node_list.size(); ++i) {
@@ -917,12 +912,12 @@ bool Somas::Assign(const session::KernelGraph *graph) {
   // Ref Overlap Preprocessing
   MS_LOG(INFO) << "Start Solving Preprocessing for Ref Overlap";
   // In ConflictComputing(), by use of ref_overlap_ flag, each tensor in a ref_overlap_list has all entries 1 in
-  // cannot_reuse_ array Here, we allow reuse only among tensors in same list
+  // cannot_reuse_ matrix Here, we allow reuse only among tensors in same list
   for (auto ref_overlap_list : ref_overlap_constraints_) {
     for (size_t tid_1 : ref_overlap_list) {
       for (size_t tid_2 : ref_overlap_list) {
-        (*cannot_reuse_)(tid_1, tid_2) = 0;
-        (*cannot_reuse_)(tid_2, tid_1) = 0;
+        (*cannot_reuse_)[tid_1].SetBitFalse(tid_2);
+        (*cannot_reuse_)[tid_2].SetBitFalse(tid_1);
       }
     }
   }
@@ -930,13 +925,7 @@ bool Somas::Assign(const session::KernelGraph *graph) {
 
   // Compute number of constraints for each tensor
   for (auto tensor1 : tensors_list_) {
-    size_t count_constraints = 0;
-    for (auto tensor2 : tensors_list_) {
-      if ((*cannot_reuse_)(tensor1->GetId(), tensor2->GetId()) == 1) {
-        count_constraints++;
-      }
-    }
-    tensor1->num_constraints_ = count_constraints;
+    tensor1->num_constraints_ = (*cannot_reuse_)[tensor1->GetId()].CountOnesNum();
   }
 
   // Preprocessing contiguous gaps
@@ -959,10 +948,12 @@ bool Somas::Assign(const session::KernelGraph *graph) {
     size_t back_neighbour_id = contiguous_list[contiguous_list.size() - 2];
     for (SomasTensorPtr tensor : tensors_list_) {
       MS_EXCEPTION_IF_NULL(tensor);
-      (*cannot_reuse_)(tensor->GetId(), front_gap_id) = (*cannot_reuse_)(tensor->GetId(), front_neighbour_id);
-      (*cannot_reuse_)(front_gap_id, tensor->GetId()) = (*cannot_reuse_)(front_neighbour_id, tensor->GetId());
-      (*cannot_reuse_)(tensor->GetId(), back_gap_id) = (*cannot_reuse_)(tensor->GetId(), back_neighbour_id);
-      (*cannot_reuse_)(back_gap_id, tensor->GetId()) = (*cannot_reuse_)(back_neighbour_id, tensor->GetId());
+      size_t tid = tensor->GetId();
+      auto &conflicts = (*cannot_reuse_)[tid];
+      conflicts.SetBit(front_gap_id, conflicts.IsBitTrue(front_neighbour_id));
+      (*cannot_reuse_)[front_gap_id].SetBit(tid, (*cannot_reuse_)[front_neighbour_id].IsBitTrue(tid));
+      conflicts.SetBit(back_gap_id, conflicts.IsBitTrue(back_neighbour_id));
+      (*cannot_reuse_)[back_gap_id].SetBit(tid, (*cannot_reuse_)[back_neighbour_id].IsBitTrue(tid));
     }
     SomasTensorPtr front_neighbour = tensors_map_[front_neighbour_id];
     SomasTensorPtr back_neighbour = tensors_map_[back_neighbour_id];
@@ -996,7 +987,8 @@ bool Somas::Assign(const session::KernelGraph *graph) {
 
   somas_solver_ = std::make_shared<SomasSolverPre>();
   auto status =
-    somas_solver_->Solving(graph, &solver_tensor_desc_list_, cannot_reuse_, contiguous_tensors_list_removed_ref, false);
+    somas_solver_->Solving(graph->graph_id(), &solver_tensor_desc_list_, cannot_reuse_,
+                           contiguous_tensors_list_removed_ref, false);
   MS_LOG(INFO) << "End Solving";
   if (status != SUCCESS) {
     GenStatisticInfo();
@@ -20,12 +20,14 @@
 #include <ctime>
 #include <memory>
 #include <string>
+#include <thread>
 #include <unordered_map>
 #include <vector>
 
 #include "backend/optimizer/somas/somas_solver_alg.h"
 #include "backend/optimizer/somas/somas_solver_core.h"
 #include "backend/optimizer/somas/somas_solver_pre.h"
+#include "common/thread_pool.h"
 
 using std::sort;
 using std::unordered_map;
@@ -33,72 +35,114 @@ using std::vector;
 
 namespace mindspore {
 namespace somas {
+namespace {
+// each combination of heuristics solves its own copy of the tensors, the copies only share the conflicts
+std::unordered_map<size_t, SomasSolverTensorDescPtr> CopyTensors(
+  const std::unordered_map<size_t, SomasSolverTensorDescPtr> &tensors) {
+  std::unordered_map<size_t, SomasSolverTensorDescPtr> copies;
+  for (auto &tensor : tensors) {
+    copies[tensor.first] = std::make_shared<SomasSolverTensorDesc>(*tensor.second);
+  }
+  for (auto &copy : copies) {
+    if (copy.second->left_ != nullptr) {
+      copy.second->left_ = copies[copy.second->left_->index_];
+    }
+    if (copy.second->right_ != nullptr) {
+      copy.second->right_ = copies[copy.second->right_->index_];
+    }
+  }
+  return copies;
+}
+}  // namespace
+
 Status SomasSolverCore::MemoryAllocationSolver() {
   auto start = std::chrono::system_clock::now();
   Status retval = SUCCESS;
-  size_t best = SIZE_MAX;
-  size_t best_timing = SIZE_MAX;
-  if (all_) {  // loop over all heuristics
-    FittingType best_branching = kBest;
-    SortingType best_sorting = kGreaterSizeSmallerIndex;
-    AlgorithmType best_algorithm = kManyObjects;
-    uint32_t best_sol = 0;
-    size_t worst = 0;
-    BuildBlocks();
-    Clean();
-    MS_LOG(INFO) << "time\tSol#\tResult\t\t\t\tAlgorithm\tSorting Strategy\tOffset Strategy";
+  if (all_) {  // run all heuristics in parallel and keep the best
+    vector<std::shared_ptr<SomasSolverCore>> solvers;
     for (size_t algorithm = 0; algorithm < kNumAlgorithmTypes; algorithm++) {
-      algorithm_ = static_cast<AlgorithmType>(algorithm);
       for (size_t sort_strategy = 0; sort_strategy < kNumSortingTypes; sort_strategy++) {
-        sort_strategy_ = static_cast<SortingType>(sort_strategy);
-        SortTensors();
         for (size_t branching_strategy = 0; branching_strategy < kNumFittingTypes; branching_strategy++) {
-          branching_strategy_ = static_cast<FittingType>(branching_strategy);
-          Clean();
-          MS_LOG(DEBUG) << "Timing Start " << tensors_.size() << " Tensors";
-          start = std::chrono::system_clock::now();
-          upperbound_ = FindSolutions();
-          MS_LOG(DEBUG)
-            << "\nElapsed time of upper bound testing: "
-            << std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::system_clock::now() - start).count()
-            << " ms";
-          start = std::chrono::system_clock::now();
-
-          if (upperbound_ > worst) {
-            worst = upperbound_;
-          }
-          if (upperbound_ < best || upperbound_ == best) {
-            best = upperbound_;
-            best_algorithm = algorithm_;
-            best_branching = branching_strategy_;
-            best_sorting = sort_strategy_;
-            best_sol = sol_count_;
-            best_timing = timing_;
-          }
-          Verify();
-          sol_count_++;
+          auto solver = std::make_shared<SomasSolverCore>(CopyTensors(tensors_), constraints_);
+          solver->SetAlgorithmStrategy(static_cast<AlgorithmType>(algorithm));
+          solver->SetSortingStrategy(static_cast<SortingType>(sort_strategy));
+          solver->SetFittingStrategy(static_cast<FittingType>(branching_strategy));
+          solver->SetAllStrategies(false);
+          solver->VerifySolution(verify_);
+          solver->sol_count_ = solvers.size();
+          solvers.emplace_back(solver);
         }
       }
     }
+    // one task per core at most, the threads of the pool spin while waiting and a single core is better left alone
+    size_t thread_num = std::min(solvers.size(), std::min(static_cast<size_t>(std::thread::hardware_concurrency()),
+                                                          static_cast<size_t>(kDefaultMaxThreadNum)));
+    MS_LOG(INFO) << "Solving " << tensors_.size() << " tensors with " << solvers.size() << " heuristics in "
+                 << std::max(thread_num, static_cast<size_t>(1)) << " threads";
+    if (thread_num <= 1) {
+      for (auto &solver : solvers) {
+        (void)solver->MemoryAllocationSolver();
+      }
+    } else {
+      vector<Task> tasks;
+      for (size_t i = 0; i < thread_num; i++) {
+        tasks.emplace_back([i, thread_num, &solvers]() {
+          for (size_t j = i; j < solvers.size(); j += thread_num) {
+            (void)solvers[j]->MemoryAllocationSolver();
+          }
+          return mindspore::SUCCESS;
+        });
+      }
+      if (!ThreadPool::GetInstance()->LaunchMultipleTask(tasks)) {
+        MS_LOG(WARNING) << "Some heuristics of the solver failed";
+      }
+    }
+
+    std::shared_ptr<SomasSolverCore> best_solver = nullptr;
+    size_t best = SIZE_MAX;
+    size_t worst = 0;
+    const double giga = 1024. * 1024. * 1024.;
+    MS_LOG(INFO) << "time\tSol#\tResult\t\t\t\tAlgorithm\tSorting Strategy\tOffset Strategy";
+    for (auto &solver : solvers) {
+      size_t result = solver->upperbound_;
+      MS_LOG(INFO) << solver->timing_ << " ms\t" << solver->sol_count_ + 1 << "/" << solvers.size() << "\t" << result
+                   << " Bytes (" << result / giga << " GB)\t" << algorithm_type_[solver->algorithm_].c_str() << "\t"
+                   << sorting_[solver->sort_strategy_].c_str() << "\t"
+                   << branching_[solver->branching_strategy_].c_str();
+      worst = std::max(worst, result);
+      if (result <= best) {
+        best = result;
+        best_solver = solver;
+      }
+    }
+    MS_EXCEPTION_IF_NULL(best_solver);
+    for (auto &tensor : tensors_) {
+      tensor.second->offset_ = best_solver->tensors_[tensor.first]->offset_;
+    }
     upperbound_ = best;
+    lifelongmemory_ = best_solver->lifelongmemory_;
+    timing_ = best_solver->timing_;
+    algorithm_ = best_solver->algorithm_;
+    best_sort_ = best_solver->sort_strategy_;
+    best_branching_ = best_solver->branching_strategy_;
+    best_sol_ = best_solver->sol_count_;
+    sol_count_ = solvers.size();
+
     auto end = std::chrono::system_clock::now();
     size_t total_time = std::chrono::duration_cast<std::chrono::milliseconds>((end - start)).count();
-    const double giga = 1024. * 1024. * 1024.;
     const double cent = 100.;
     MS_LOG(INFO) << "SOMAS SOLVER RESUME:";
-    MS_LOG(INFO) << "Best Solution:[" << 1 + best_sol << "/" << sol_count_ << "] ";
+    MS_LOG(INFO) << "Best Solution:[" << 1 + best_sol_ << "/" << sol_count_ << "] ";
     MS_LOG(INFO) << "Best result:" << best << " Bytes " << (best) / (giga) << " GB ("
                  << (best - lifelongmemory_) / (giga) << " GB + " << lifelongmemory_ / (giga)
                  << " GB from lifelong tensors)";
 
-    MS_LOG(INFO) << "Best timing:" << best_timing << " ms";
-    MS_LOG(INFO) << "Best algorithm: " << algorithm_type_[best_algorithm].c_str();
-    MS_LOG(INFO) << "Best sorting strategy: " << sorting_[best_sorting].c_str();
-    MS_LOG(INFO) << "Best offset strategy: " << branching_[best_branching].c_str();
+    MS_LOG(INFO) << "Best timing:" << timing_ << " ms";
+    MS_LOG(INFO) << "Best algorithm: " << algorithm_type_[algorithm_].c_str();
+    MS_LOG(INFO) << "Best sorting strategy: " << sorting_[best_sort_].c_str();
+    MS_LOG(INFO) << "Best offset strategy: " << branching_[best_branching_].c_str();
     MS_LOG(INFO) << "Time elapsed: " << total_time << " ms";
     MS_LOG(INFO) << "Spread:" << static_cast<double>((worst - best) / static_cast<double>(best * cent)) << " %%";
-    best_sol_ = best_sol;
-    SetBestSolution();
   } else {
     MS_LOG(INFO) << "Algorithm strategy: " << algorithm_type_[algorithm_].c_str();
     MS_LOG(INFO) << "Sorting strategy: " << sorting_[sort_strategy_].c_str();
@@ -169,16 +213,14 @@ bool SomasSolverCore::Verify(const size_t &upperbound) {
       t2 = t2_.second;
       if (t1->index_ == t2->index_) continue;
       bool blifelong = (t1->lifelong_ || t2->lifelong_) && (t1->index_ != t2->index_);
-      const size_t continuous = 2;
-      const size_t conflict = 1;
-      if ((*constraints_)(t1->index_, t2->index_) == continuous) {  // continuous constraint
+      if (t1->left_ == t2) {  // continuous constraint
         // t1 must be continous to t2
         bool bcontinuous = t1->offset_ == (t2->offset_ + t2->size_);
         if (!bcontinuous) {
           MS_LOG(WARNING) << "Continuous constraint violation in tensors " << t1->index_ << " and" << t2->index_;
           retval = false;
         }
-      } else if (blifelong || (*constraints_)(t1->index_, t2->index_) == conflict) {  // conflict constraint
+      } else if (blifelong || (*constraints_)[t1->index_].IsBitTrue(t2->index_)) {  // conflict constraint
         size_t t1_ub = t1->offset_ + t1->size_;
         size_t t2_ub = t2->offset_ + t2->size_;
         bool b_overlap_lb = ((t2->offset_ >= t1->offset_) && (t2->offset_ < t1_ub));
@@ -14,6 +14,7 @@
  * limitations under the License.
 */
 
+#include <climits>
 #include <cstdio>
 #include <fstream>
 #include <memory>
@@ -22,12 +23,13 @@
 
 #include "backend/optimizer/somas/somas_solver_core.h"
 #include "backend/optimizer/somas/somas_solver_pre.h"
+#include "utils/ms_context.h"
+#include "utils/utils.h"
 
 namespace mindspore {
 namespace somas {
-Status SomasSolverPre::Solving(const session::KernelGraph *graph,
-                               std::unordered_map<size_t, SomasSolverTensorDescPtr> *ptensors,
-                               std::shared_ptr<Array> pConstraints, const vector<vector<size_t>> &continuous_v,
+Status SomasSolverPre::Solving(size_t graph_id, std::unordered_map<size_t, SomasSolverTensorDescPtr> *ptensors,
+                               const ConflictMatrixPtr &pConstraints, const vector<vector<size_t>> &continuous_v,
                                bool bVerifySolution, bool ball, SortingType sorting, FittingType fitting,
                                AlgorithmType algorithm) {
   Status retval = SUCCESS;
@@ -39,8 +41,8 @@ Status SomasSolverPre::Solving(const session::KernelGraph *graph,
                        [](const std::pair<size_t, SomasSolverTensorDescPtr> &a,
                           const std::pair<size_t, SomasSolverTensorDescPtr> &b) { return a.first < b.first; });
     size_t maxIndex = max->first;
-    if (maxIndex > pConstraints->Rows() - 1) {
-      MS_LOG(WARNING) << "ERROR: MaxIndex invalid, MaxIndex " << maxIndex << ", Rows " << pConstraints->Rows();
+    if (maxIndex > pConstraints->size() - 1) {
+      MS_LOG(WARNING) << "ERROR: MaxIndex invalid, MaxIndex " << maxIndex << ", Rows " << pConstraints->size();
       return FAILED;
     }
     MS_LOG(INFO) << "Filling in constraints matrix..";
@@ -60,8 +62,6 @@ Status SomasSolverPre::Solving(const session::KernelGraph *graph,
           return FAILED;
         }
 
-        const size_t continuous = 2;
-        (*pConstraints)(index2, index1) = continuous;
         if (tensors[index1]->right_)
           MS_LOG(WARNING) << "Warning:tensor " << index1
                           << " already has a right tensor (id: " << tensors[index1]->right_->index_;
@@ -93,7 +93,7 @@ Status SomasSolverPre::Solving(const session::KernelGraph *graph,
     MS_EXCEPTION_IF_NULL(context_ptr);
     bool save_graphs = context_ptr->get_param<bool>(MS_CTX_SAVE_GRAPHS_FLAG);
     if (save_graphs) {
-      Log(graph, tensors, pConstraints, continuous_v);
+      Log(graph_id, tensors, pConstraints, continuous_v);
     }
   } catch (const std::exception &e) {
     MS_LOG(EXCEPTION) << "SomasSolver::Solving FAILED: " << e.what();
@@ -102,15 +102,14 @@ Status SomasSolverPre::Solving(const session::KernelGraph *graph,
   return retval;
 }
 
-void SomasSolverPre::Log(const session::KernelGraph *graph,
-                         const unordered_map<size_t, SomasSolverTensorDescPtr> &tensors,
-                         const std::shared_ptr<Array> &pConstraints, const vector<vector<size_t>> &continuous_v) {
+void SomasSolverPre::Log(size_t graph_id, const unordered_map<size_t, SomasSolverTensorDescPtr> &tensors,
+                         const ConflictMatrixPtr &pConstraints, const vector<vector<size_t>> &continuous_v) {
   MS_LOG(INFO) << "SomasSolver::Log Writing somas-input.txt..";
 
   auto context_ptr = MsContext::GetInstance();
   MS_EXCEPTION_IF_NULL(context_ptr);
   auto save_graphs_path = context_ptr->get_param<std::string>(MS_CTX_SAVE_GRAPHS_PATH);
-  std::string filename = save_graphs_path + "/" + "somas_solver_input_" + std::to_string(graph->graph_id()) + ".ir";
+  std::string filename = save_graphs_path + "/" + "somas_solver_input_" + std::to_string(graph_id) + ".ir";
   if (filename.size() > PATH_MAX) {
     MS_LOG(ERROR) << "File path " << filename << " is too long.";
     return;
@@ -143,7 +142,7 @@ void SomasSolverPre::Log(const session::KernelGraph *graph,
     for (auto &t2 : tensors) {
       size_t idx1 = t1.first;
       size_t idx2 = t2.first;
-      if ((idx1 != idx2) && (*pConstraints)(idx1, idx2) == 1) {
+      if ((idx1 != idx2) && (*pConstraints)[idx1].IsBitTrue(idx2)) {
         ofs_1 << "C " << idx1 << " " << idx2 << std::endl;
       }
     }
@@ -159,7 +158,7 @@ void SomasSolverPre::Log(const session::KernelGraph *graph,
 
   MS_LOG(INFO) << "SomasSolver::Log Writing somas-output.txt..";
   std::string out_filename =
-    save_graphs_path + "/" + "somas_solver_output_" + std::to_string(graph->graph_id()) + ".ir";
+    save_graphs_path + "/" + "somas_solver_output_" + std::to_string(graph_id) + ".ir";
   if (out_filename.size() > PATH_MAX) {
     MS_LOG(ERROR) << "File path " << out_filename << " is too long.";
     return;
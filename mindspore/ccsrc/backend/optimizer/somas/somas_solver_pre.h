@@ -20,6 +20,7 @@
 #include <algorithm>
 #include <cassert>
 #include <cstddef>
+#include <cstdint>
 #include <cstring>
 #include <iostream>
 #include <map>
@@ -27,7 +28,7 @@
 #include <stack>
 #include <unordered_map>
 #include <vector>
-#include "backend/session/kernel_graph.h"
+#include "utils/log_adapter.h"
 
 using std::unordered_map;
 using std::vector;
@@ -57,37 +58,59 @@ enum FittingType {
   kNumFittingTypes
 };
 
-class Array {
+// A row of the conflict matrix of the solver, one bit per tensor. The dense matrix of int takes 32 times the
+// memory, which reaches gigabytes for graphs of hundreds of thousands of tensors.
+class DynamicBitSet {
  public:
-  Array(const size_t &rows, const size_t &cols) : rows_(rows), cols_(cols) {
-    conflicts_array_ = std::make_unique<int[]>(rows * cols);
-    for (uint32_t i = 0; i < rows * cols; i++) {
-      conflicts_array_[i] = 1;
+  explicit DynamicBitSet(size_t count, bool value = false)
+      : bit_size_(count), bit_((count + kBitWidth - 1) / kBitWidth, value ? ~uint64_t(0) : 0) {
+    ClearTail();
+  }
+  ~DynamicBitSet() = default;
+
+  void SetBitTrue(size_t index) { bit_[index / kBitWidth] |= uint64_t(1) << (index % kBitWidth); }
+  void SetBitFalse(size_t index) { bit_[index / kBitWidth] &= ~(uint64_t(1) << (index % kBitWidth)); }
+  void SetBit(size_t index, bool value) {
+    if (value) {
+      SetBitTrue(index);
+    } else {
+      SetBitFalse(index);
     }
   }
-
-  Array(const Array &array) : rows_(array.rows_), cols_(array.cols_) {
-    conflicts_array_ = std::make_unique<int[]>(array.rows_ * array.cols_);
-    for (uint32_t i = 0; i < array.rows_ * array.cols_; i++) {
-      conflicts_array_[i] = array.conflicts_array_[i];
+  bool IsBitTrue(size_t index) const {
+    assert(index < bit_size_);
+    return (bit_[index / kBitWidth] >> (index % kBitWidth)) & 1;
+  }
+  size_t CountOnesNum() const {
+    size_t count = 0;
+    for (auto word : bit_) {
+      count += static_cast<size_t>(__builtin_popcountll(word));
     }
+    return count;
   }
-
-  Array &operator=(const Array &array) { return *this; }
-
-  int &operator()(const size_t &i, const size_t &j) {
-    assert((i * cols_ + j) < (rows_ * cols_));
-    return conflicts_array_[i * cols_ + j];
+  void Union(const DynamicBitSet &other) {
+    assert(other.bit_size_ == bit_size_);
+    for (size_t i = 0; i < bit_.size(); i++) {
+      bit_[i] |= other.bit_[i];
+    }
   }
-
-  const size_t &Rows() { return rows_; }
-  const size_t &Cols() { return cols_; }
+  size_t Size() const { return bit_size_; }
+  size_t MemorySize() const { return bit_.size() * sizeof(uint64_t); }
 
  private:
-  const size_t rows_;
-  const size_t cols_;
-  std::unique_ptr<int[]> conflicts_array_;
+  static constexpr size_t kBitWidth = 64;
+  void ClearTail() {
+    if (bit_size_ % kBitWidth != 0) {
+      bit_.back() &= (uint64_t(1) << (bit_size_ % kBitWidth)) - 1;
+    }
+  }
+
+  size_t bit_size_;
+  std::vector<uint64_t> bit_;
 };
+// row i holds the tensors which can not share memory with tensor i
+using ConflictMatrix = std::vector<DynamicBitSet>;
+using ConflictMatrixPtr = std::shared_ptr<ConflictMatrix>;
 
 struct SomasSolverTensorDesc {
   size_t index_;
@@ -139,15 +162,16 @@ class SomasSolverPre {
 
   size_t GetMaxOffset() { return max_offset_; }
 
-  Status Solving(const session::KernelGraph *graph, std::unordered_map<size_t, SomasSolverTensorDescPtr> *tensors,
-                 std::shared_ptr<Array> pConstraints, const vector<vector<size_t>> &continuous_v,
+  // the solver only sees tensors and conflicts, the graph id names the files dumped when save_graphs is set
+  Status Solving(size_t graph_id, std::unordered_map<size_t, SomasSolverTensorDescPtr> *tensors,
+                 const ConflictMatrixPtr &pConstraints, const vector<vector<size_t>> &continuous_v,
                  bool bVerifySolution,  // true -> Check continuous and non overlapping constraints solution
                  bool ball = true,      // true -> run full set of heuristics, false -> run single heuristic specified
                  SortingType sorting = kGreaterSizeSmallerIndex, FittingType fitting = kBest,
                  AlgorithmType algorithm = kManyObjects);
 
-  void Log(const session::KernelGraph *graph, const unordered_map<size_t, SomasSolverTensorDescPtr> &tensors,
-           const std::shared_ptr<Array> &pConstraints_v, const vector<vector<size_t>> &continuous_v);
+  void Log(size_t graph_id, const unordered_map<size_t, SomasSolverTensorDescPtr> &tensors,
+           const ConflictMatrixPtr &pConstraints_v, const vector<vector<size_t>> &continuous_v);
 
  private:
   size_t max_offset_;
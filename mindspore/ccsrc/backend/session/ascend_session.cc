@@ -391,15 +391,14 @@ GraphInfo GetSingleOpGraphInfo(const PrimitivePtr &prim, const std::vector<tenso
   // get input tensor info
   for (const auto &tensor : input_tensors) {
     MS_EXCEPTION_IF_NULL(tensor);
-    auto tensor_shape = tensor->shape();
-    (void)std::for_each(tensor_shape.begin(), tensor_shape.end(),
-                        [&](const auto &dim) { (void)graph_info.append(std::to_string(dim) + "_"); });
-    (void)graph_info.append(std::to_string(tensor->data_type()) + "_");
-    if (tensor->device_address() != nullptr) {
-      const auto type_id = std::dynamic_pointer_cast<device::DeviceAddress>(tensor->device_address())->type_id();
-      (void)graph_info.append(std::to_string(type_id) + "_");
-      const auto format = std::dynamic_pointer_cast<device::DeviceAddress>(tensor->device_address())->format();
-      (void)graph_info.append(format + "_");
+    for (const auto &dim : tensor->shape()) {
+      (void)graph_info.append(std::to_string(dim)).append(1, '_');
+    }
+    (void)graph_info.append(std::to_string(tensor->data_type())).append(1, '_');
+    auto device_address = std::dynamic_pointer_cast<device::DeviceAddress>(tensor->device_address());
+    if (device_address != nullptr) {
+      (void)graph_info.append(std::to_string(device_address->type_id())).append(1, '_');
+      (void)graph_info.append(device_address->format()).append(1, '_');
     }
   }
   // get attr info
@@ -670,8 +669,8 @@ void AscendSession::RunOpHardwareOptimize(const std::shared_ptr<session::KernelG
   MS_LOG(INFO) << "Finish";
 }
 
-bool AscendSession::GraphCacheExist(const GraphInfo &graph_info) const {
-  return run_op_graphs_.find(graph_info) != run_op_graphs_.end();
+bool AscendSession::GraphCacheExist(const GraphInfo &graph_info) {
+  return run_op_graphs_.Get(graph_info) != nullptr;
 }
 
 void AscendSession::BuildOpImpl(const OpRunInfo &op_run_info, const GraphInfo &graph_info,
@@ -696,7 +695,7 @@ void AscendSession::BuildOpImpl(const OpRunInfo &op_run_info, const GraphInfo &g
   // build kernel
   RunOpAdjustKernel(graph);
   BuildKernel(graph);
-  run_op_graphs_[graph_info] = graph;
+  CacheOpGraph(op_run_info, graph_info, input_tensors, tensors_mask, graph);
   MS_LOG(INFO) << "Build op " << op_run_info.op_name << " finish !";
 }
 
@@ -708,7 +707,7 @@ void AscendSession::RunOpImpl(const GraphInfo &graph_info, OpRunInfo *op_run_inf
   BuildOpImpl(*op_run_info, graph_info, *input_tensors, tensors_mask);
   EraseValueNodeTensor(tensors_mask, input_tensors);
   // Run op
-  auto graph = run_op_graphs_[graph_info];
+  auto graph = run_op_graphs_.Peek(graph_info);
   MS_EXCEPTION_IF_NULL(graph);
   MS_LOG(INFO) << "Run op " << op_run_info->op_name << " start!";
   // malloc mem
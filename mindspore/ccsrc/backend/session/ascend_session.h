@@ -100,7 +100,7 @@ class AscendSession : public SessionBasic {
   // get graph order type vector by graph id
   const std::vector<GraphType> &GetGraphOrderType(GraphId final_graph_id) const;
   // check if graph cache exist
-  bool GraphCacheExist(const GraphInfo &graph_info) const;
+  bool GraphCacheExist(const GraphInfo &graph_info);
   // sync intial tensors' data to device
   void SyncInitialTenosrToDevice();
   void SetFinalGraphSummaryFlag(const std::shared_ptr<KernelGraph> &kernel_graph);
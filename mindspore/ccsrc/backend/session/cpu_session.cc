@@ -28,6 +28,10 @@
 #include "backend/optimizer/common/optimizer.h"
 #include "backend/optimizer/common/pass_manager.h"
 #include "backend/optimizer/pass/replace_node_by_proxy.h"
+#include "backend/optimizer/cpu/bias_add_fusion.h"
+#include "backend/optimizer/cpu/elemwise_fusion.h"
+#include "backend/optimizer/gpu/adam_fusion.h"
+#include "backend/optimizer/gpu/adam_weight_decay_fusion.h"
 #if (ENABLE_CPU && (ENABLE_D || ENABLE_GPU))
 #include "ps/util.h"
 #endif
@@ -53,6 +57,22 @@ ParameterPtr CPUSession::CreateNewParameterFromParameter(const AnfNodePtr &anf,
 }
 
 void CPUSession::Optimize(const std::shared_ptr<KernelGraph> &kernel_graph) {
+  MS_EXCEPTION_IF_NULL(kernel_graph);
+  auto optimizer = std::make_shared<opt::GraphOptimizer>();
+  auto pm = std::make_shared<opt::PassManager>("cpu_fusion_pm");
+  // the optimizer updates first, their chains are elementwise ops too
+  pm->AddPass(std::make_shared<opt::AdamWeightDecayFusion>());
+  pm->AddPass(std::make_shared<opt::AdamFusion>());
+  pm->AddPass(std::make_shared<opt::CpuMatMulBiasAddFusion>());
+  pm->AddPass(std::make_shared<opt::CpuConv2DBiasAddFusion>());
+  pm->AddPass(std::make_shared<opt::CpuReluPostOpFusion>());
+  pm->AddPass(std::make_shared<opt::CpuElemwiseFusion>());
+  optimizer->AddPassManager(pm);
+  (void)optimizer->Optimize(kernel_graph);
+  kernel_graph->SetExecOrderByDefault();
+}
+
+void CPUSession::HardwareOptimize(const std::shared_ptr<KernelGraph> &kernel_graph) {
   auto optimizer = std::make_shared<opt::GraphOptimizer>();
   auto pm = std::make_shared<opt::PassManager>();
   std::string pass_name = "replace_node_by_proxy";
@@ -69,13 +89,19 @@ GraphId CPUSession::CompileGraphImpl(const AnfNodePtrList &lst, const AnfNodePtr
   MS_EXCEPTION_IF_NULL(graph);
   UpdateGraphDynamicShapeAttr(NOT_NULL(graph));
   graph->UpdateGraphDynamicAttr();
+  auto context_ptr = MsContext::GetInstance();
+  MS_EXCEPTION_IF_NULL(context_ptr);
+  if (context_ptr->get_param<bool>(MS_CTX_ENABLE_CPU_FUSION) && !graph->is_dynamic_shape()) {
+    MS_LOG(INFO) << "Optimize graph";
+    Optimize(graph);
+  }
   MS_LOG(INFO) << "Set kernel info";
   SetKernelInfo(graph.get());
 #if (ENABLE_CPU && (ENABLE_D || ENABLE_GPU))
   if (ps::Util::IsParamServerMode()) {
     AssignParamKey(graph);
     if (ps::Util::IsRoleOfWorker()) {
-      Optimize(graph);
+      HardwareOptimize(graph);
     }
   }
 #endif
@@ -145,7 +171,7 @@ void CPUSession::BuildOpImpl(const OpRunInfo &op_run_info, const GraphInfo &grap
                              const std::vector<tensor::TensorPtr> &input_tensors,
                              const std::vector<int64_t> &tensors_mask) {
   // Check if the graph cache exists.
-  if (run_op_graphs_.find(graph_info) != run_op_graphs_.end()) {
+  if (run_op_graphs_.Get(graph_info) != nullptr) {
     return;
   }
   // Prepare the graph
@@ -153,7 +179,7 @@ void CPUSession::BuildOpImpl(const OpRunInfo &op_run_info, const GraphInfo &grap
   MS_EXCEPTION_IF_NULL(kernel_graph);
   SetKernelInfo(kernel_graph.get());
   BuildKernel(kernel_graph.get());
-  run_op_graphs_[graph_info] = kernel_graph;
+  CacheOpGraph(op_run_info, graph_info, input_tensors, tensors_mask, kernel_graph);
 }
 
 void CPUSession::SetOutputFlags(const VectorRef &base_ref, std::vector<tensor::TensorPtr> *outputs_tensors) {
@@ -178,7 +204,7 @@ void CPUSession::RunOpImpl(const GraphInfo &graph_info, OpRunInfo *op_run_info,
   BuildOpImpl(*op_run_info, graph_info, *input_tensors, tensors_mask);
   EraseValueNodeTensor(tensors_mask, input_tensors);
 
-  auto kernel_graph = run_op_graphs_[graph_info];
+  auto kernel_graph = run_op_graphs_.Peek(graph_info);
   MS_EXCEPTION_IF_NULL(kernel_graph);
 
   runtime_.AssignKernelAddress(kernel_graph.get());
@@ -202,6 +228,13 @@ void CPUSession::RunOpImpl(const GraphInfo &graph_info, OpRunInfo *op_run_info,
   MS_LOG(INFO) << "Run Op end";
 }
 
+void CPUSession::ReleaseOpGraph(const KernelGraphPtr &graph) {
+  MS_EXCEPTION_IF_NULL(graph);
+  // the single op graphs run on runtime_ of the session, which the runtime manager does not know
+  runtime_.ClearGraphRuntimeResource(graph->graph_id(), graph->inputs(), graph->graph_value_nodes(),
+                                     graph->execution_order());
+}
+
 void CPUSession::SetKernelInfo(const KernelGraph *kernel_graph) {
   MS_EXCEPTION_IF_NULL(kernel_graph);
   auto &kernel_nodes = kernel_graph->execution_order();
@@ -72,6 +72,17 @@ void NotifyOutputTensors(const VectorRef *outputs) {
   }
 }
 
+void FlattenOutputTensors(const VectorRef &outputs, std::vector<tensor::TensorPtr> *output_tensors) {
+  MS_EXCEPTION_IF_NULL(output_tensors);
+  for (auto &item : outputs) {
+    if (utils::isa<VectorRefPtr>(item)) {
+      FlattenOutputTensors(utils::cast<VectorRef>(item), output_tensors);
+    } else if (utils::isa<tensor::TensorPtr>(item)) {
+      output_tensors->emplace_back(utils::cast<tensor::TensorPtr>(item));
+    }
+  }
+}
+
 bool TensorInVector(const VectorRef *outputs) {
   MS_EXCEPTION_IF_NULL(outputs);
   for (auto item : *outputs) {
@@ -130,7 +141,49 @@ void RunGraphTask::Run() {
 
 void RunOpTask::Run() {
   MS_EXCEPTION_IF_NULL(session_);
-  session_->RunOpImpl(graph_info_, op_run_info_, input_tensors_, &outputs_, tensors_mask_);
+  // the flag is only written by the executor thread, which runs the synchronous and the asynchronous ops
+  auto ms_context = MsContext::GetInstance();
+  MS_EXCEPTION_IF_NULL(ms_context);
+  ms_context->set_param<bool>(MS_CTX_ENABLE_PYNATIVE_INFER, true);
+  try {
+    session_->RunOpImpl(graph_info_, op_run_info_, input_tensors_, &outputs_, tensors_mask_);
+  } catch (const std::exception &e) {
+    ms_context->set_param<bool>(MS_CTX_ENABLE_PYNATIVE_INFER, false);
+    throw;
+  }
+  ms_context->set_param<bool>(MS_CTX_ENABLE_PYNATIVE_INFER, false);
+}
+
+void RunOpAsyncTask::Run() {
+  MS_EXCEPTION_IF_NULL(session_);
+  auto ms_context = MsContext::GetInstance();
+  MS_EXCEPTION_IF_NULL(ms_context);
+  ms_context->set_param<bool>(MS_CTX_ENABLE_PYNATIVE_INFER, true);
+  try {
+    VectorRef outputs;
+    session_->RunOpImpl(graph_info_func_(input_tensors_), &op_run_info_, &input_tensors_, &outputs, tensors_mask_);
+    std::vector<tensor::TensorPtr> computed_tensors;
+    FlattenOutputTensors(outputs, &computed_tensors);
+    if (computed_tensors.size() != output_tensors_.size()) {
+      MS_LOG(EXCEPTION) << "Op " << op_run_info_.op_name << " has " << computed_tensors.size()
+                        << " outputs, but its inferred outputs are " << output_tensors_.size();
+    }
+    for (size_t i = 0; i < output_tensors_.size(); ++i) {
+      MS_EXCEPTION_IF_NULL(computed_tensors[i]);
+      output_tensors_[i]->SetComputedValue(*computed_tensors[i]);
+    }
+  } catch (const std::exception &e) {
+    MsException::GetInstance().SetException();
+  }
+  ms_context->set_param<bool>(MS_CTX_ENABLE_PYNATIVE_INFER, false);
+  for (auto &tensor : output_tensors_) {
+    tensor->SetNeedWait(false);
+  }
+}
+
+void BuildOpsTask::Run() {
+  MS_EXCEPTION_IF_NULL(session_);
+  session_->WarmUpOpGraphsImpl(op_trace_);
 }
 
 void RunOpsInGraphTask::Run() {
@@ -185,7 +238,7 @@ void Executor::WorkerLoop() {
       std::unique_lock<std::mutex> lock(task_mutex_);
       done_tasks_.emplace_back(task);
     }
-    if (task->type_ != kRunGraph || task->sync_run_) {
+    if ((task->type_ != kRunGraph && task->type_ != kRunOpAsync) || task->sync_run_) {
       sync_cond_var_.notify_all();
     }
   }
@@ -340,6 +393,15 @@ void Executor::RunGraphAsync(const SessionPtr &session, const GraphId &graph_id,
   task_cond_var_.notify_all();
 }
 
+void Executor::BuildOps(const SessionPtr &session, const OpTrace &op_trace) {
+  MS_EXCEPTION_IF_NULL(session);
+  auto task = std::make_shared<BuildOpsTask>();
+  task->session_ = session;
+  task->op_trace_ = op_trace;
+  mindspore::ScopedLongRunning long_running;
+  SyncRunTask(task);
+}
+
 void Executor::RunOp(const SessionPtr &session, OpRunInfo *op_run_info, const GraphInfo &graph_info,
                      std::vector<tensor::TensorPtr> *input_tensors, VectorRef *outputs,
                      const std::vector<int64_t> &tensors_mask) {
@@ -359,6 +421,36 @@ void Executor::RunOp(const SessionPtr &session, OpRunInfo *op_run_info, const Gr
   *outputs = task->outputs_;
 }
 
+void Executor::RunOpAsync(const SessionPtr &session, const OpRunInfo &op_run_info, const GraphInfoFunc &graph_info_func,
+                          const std::vector<tensor::TensorPtr> &input_tensors, const std::vector<int64_t> &tensors_mask,
+                          const std::vector<tensor::TensorPtr> &output_tensors) {
+  MS_EXCEPTION_IF_NULL(session);
+  auto task = std::make_shared<RunOpAsyncTask>();
+  task->session_ = session;
+  task->op_run_info_ = op_run_info;
+  task->graph_info_func_ = graph_info_func;
+  task->input_tensors_ = input_tensors;
+  task->tensors_mask_ = tensors_mask;
+  task->output_tensors_ = output_tensors;
+  // the outputs of the ops dispatched before are ready when the task runs, only the graphs waiting for their inputs
+  // may run after it
+  for (auto &tensor : input_tensors) {
+    if (tensor->NeedWait() && tensor->IsGraphOutput()) {
+      mindspore::ScopedLongRunning long_running;
+      tensor->Wait();
+    }
+  }
+  MsException::GetInstance().CheckException();
+  for (auto &tensor : output_tensors) {
+    tensor->SetFuture();
+    tensor->SetNeedWait(true);
+  }
+  std::unique_lock<std::mutex> lock(task_mutex_);
+  ready_tasks_.push(task);
+  done_tasks_.clear();
+  task_cond_var_.notify_all();
+}
+
 void Executor::RunOpsInGraph(const SessionPtr &session, const GraphId &graph_id,
                              const std::vector<tensor::TensorPtr> &inputs, VectorRef *outputs) {
   MS_EXCEPTION_IF_NULL(session);
@@ -371,6 +463,12 @@ void Executor::RunOpsInGraph(const SessionPtr &session, const GraphId &graph_id,
   *outputs = task->outputs_;
 }
 
+void Executor::Sync() {
+  auto task = std::make_shared<SyncTask>();
+  mindspore::ScopedLongRunning long_running;
+  SyncRunTask(task);
+}
+
 bool Executor::CreateCommGroup(const std::string &group_name, std::vector<uint32_t> ranks) {
   auto task = std::make_shared<CreateCommGroupTask>();
   task->group_name_ = group_name;
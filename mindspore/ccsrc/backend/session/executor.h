@@ -45,6 +45,8 @@ enum TaskType {
   kBuildOp,
   kRunGraph,
   kRunOp,
+  kRunOpAsync,
+  kSync,
   kCreateCommGroup,
   kDestroyCommGroup,
   kRunOpsInGraph
@@ -100,6 +102,14 @@ class RunGraphTask : public Task {
   std::map<tensor::TensorPtr, session::KernelWithIndex> tensor_to_node_;
 };
 
+class BuildOpsTask : public Task {
+ public:
+  BuildOpsTask() { type_ = kBuildOp; }
+  ~BuildOpsTask() override = default;
+  void Run() override;
+  OpTrace op_trace_;
+};
+
 class RunOpsInGraphTask : public Task {
  public:
   RunOpsInGraphTask() { type_ = kRunOpsInGraph; }
@@ -122,6 +132,25 @@ class RunOpTask : public Task {
   std::vector<int64_t> tensors_mask_;
 };
 
+class RunOpAsyncTask : public Task {
+ public:
+  RunOpAsyncTask() { type_ = kRunOpAsync; }
+  ~RunOpAsyncTask() override = default;
+  void Run() override;
+  OpRunInfo op_run_info_;
+  GraphInfoFunc graph_info_func_;
+  std::vector<tensor::TensorPtr> input_tensors_;
+  std::vector<int64_t> tensors_mask_;
+  // created from the inferred outputs of the op when it is dispatched, they take the computed outputs
+  std::vector<tensor::TensorPtr> output_tensors_;
+};
+
+class SyncTask : public Task {
+ public:
+  SyncTask() { type_ = kSync; }
+  ~SyncTask() override = default;
+};
+
 class CreateCommGroupTask : public Task {
  public:
   CreateCommGroupTask() { type_ = kCreateCommGroup; }
@@ -160,11 +189,17 @@ class Executor {
                 VectorRef *outputs);
   void RunGraphAsync(const SessionPtr &session, const GraphId &graph_id, const std::vector<tensor::TensorPtr> &inputs,
                      VectorRef *outputs);
+  void BuildOps(const SessionPtr &session, const OpTrace &op_trace);
   void RunOp(const SessionPtr &session, OpRunInfo *op_run_info, const GraphInfo &graph_info,
              std::vector<tensor::TensorPtr> *input_tensors, VectorRef *outputs,
              const std::vector<int64_t> &tensors_mask);
+  void RunOpAsync(const SessionPtr &session, const OpRunInfo &op_run_info, const GraphInfoFunc &graph_info_func,
+                  const std::vector<tensor::TensorPtr> &input_tensors, const std::vector<int64_t> &tensors_mask,
+                  const std::vector<tensor::TensorPtr> &output_tensors);
   void RunOpsInGraph(const SessionPtr &session, const GraphId &graph_id, const std::vector<tensor::TensorPtr> &inputs,
                      VectorRef *outputs);
+  // wait until the tasks dispatched before are done
+  void Sync();
   void OnRunGraphFinished();
   bool CreateCommGroup(const std::string &group_name, std::vector<uint32_t> ranks);
   bool DestroyCommGroup(const std::string &group_name);
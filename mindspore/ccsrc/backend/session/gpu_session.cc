@@ -229,6 +229,12 @@ void GPUSession::LoadInputData(const std::shared_ptr<KernelGraph> &kernel_graph,
   if (inputs.size() != input_nodes.size()) {
     MS_LOG(EXCEPTION) << "Tensor input:" << inputs.size() << " is not equal graph inputs:" << input_nodes.size();
   }
+  // the optimizer states offloaded to the host are reloaded when their parameters are rewritten
+  device::gpu::GPUKernelRuntime *offload_runtime = nullptr;
+  if (ms_context->get_param<bool>(MS_CTX_ENABLE_OPTIMIZER_OFFLOAD)) {
+    offload_runtime = dynamic_cast<device::gpu::GPUKernelRuntime *>(
+      device::KernelRuntimeManager::Instance().GetSingleKernelRuntime(kGPUDevice, device_id_));
+  }
   for (size_t i = 0; i < inputs.size(); ++i) {
     auto tensor = inputs[i];
     MS_EXCEPTION_IF_NULL(tensor);
@@ -263,6 +269,9 @@ void GPUSession::LoadInputData(const std::shared_ptr<KernelGraph> &kernel_graph,
                                               tensor->data_c())) {
           MS_LOG(EXCEPTION) << "SyncHostToDevice failed.";
         }
+        if (offload_runtime != nullptr) {
+          offload_runtime->ReloadOffloadStates(input_node);
+        }
       }
     }
     tensor->set_sync_status(kNoNeedSync);
@@ -388,7 +397,7 @@ void GPUSession::BuildOpImpl(const OpRunInfo &op_run_info, const GraphInfo &grap
                              const std::vector<tensor::TensorPtr> &input_tensors,
                              const std::vector<int64_t> &tensors_mask) {
   // Check if the graph cache exists.
-  if (run_op_graphs_.find(graph_info) != run_op_graphs_.end()) {
+  if (run_op_graphs_.Get(graph_info) != nullptr) {
     return;
   }
   // Prepare the graph
@@ -400,7 +409,7 @@ void GPUSession::BuildOpImpl(const OpRunInfo &op_run_info, const GraphInfo &grap
   // Hide NopOp from execution graph
   opt::HideNopNode(kernel_graph.get());
   BuildKernel(kernel_graph);
-  run_op_graphs_[graph_info] = kernel_graph;
+  CacheOpGraph(op_run_info, graph_info, input_tensors, tensors_mask, kernel_graph);
 }
 
 void GPUSession::RunOpImpl(const GraphInfo &graph_info, OpRunInfo *op_run_info,
@@ -411,7 +420,7 @@ void GPUSession::RunOpImpl(const GraphInfo &graph_info, OpRunInfo *op_run_info,
   BuildOpImpl(*op_run_info, graph_info, *input_tensors, tensors_mask);
   EraseValueNodeTensor(tensors_mask, input_tensors);
   // run op
-  auto kernel_graph = run_op_graphs_[graph_info];
+  auto kernel_graph = run_op_graphs_.Peek(graph_info);
   MS_EXCEPTION_IF_NULL(kernel_graph);
   // Remove NopOp from execution graph
   opt::RemoveNopNode(kernel_graph.get());
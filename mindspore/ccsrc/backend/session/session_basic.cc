@@ -1650,6 +1650,87 @@ void SessionBasic::RunOp(OpRunInfo *op_run_info, const GraphInfo &graph_info,
   executor_->RunOp(shared_from_this(), op_run_info, graph_info, input_tensors, outputs, tensors_mask);
 }
 
+void SessionBasic::RunOpAsync(const OpRunInfo &op_run_info, const GraphInfoFunc &graph_info_func,
+                              const std::vector<tensor::TensorPtr> &input_tensors,
+                              const std::vector<int64_t> &tensors_mask,
+                              const std::vector<tensor::TensorPtr> &output_tensors) {
+  MS_EXCEPTION_IF_NULL(executor_);
+  executor_->RunOpAsync(shared_from_this(), op_run_info, graph_info_func, input_tensors, tensors_mask, output_tensors);
+}
+
+void SessionBasic::SyncRunOps() {
+  MS_EXCEPTION_IF_NULL(executor_);
+  executor_->Sync();
+}
+
+void SessionBasic::StartOpTrace() {
+  SyncRunOps();
+  op_trace_.clear();
+  record_op_trace_ = true;
+}
+
+OpTrace SessionBasic::StopOpTrace() {
+  SyncRunOps();
+  record_op_trace_ = false;
+  OpTrace op_trace;
+  op_trace.swap(op_trace_);
+  MS_LOG(INFO) << "Recorded " << op_trace.size() << " ops, " << run_op_graphs_.StatisticsInfo();
+  return op_trace;
+}
+
+void SessionBasic::WarmUpOpGraphs(const OpTrace &op_trace) {
+  MS_EXCEPTION_IF_NULL(executor_);
+  executor_->BuildOps(shared_from_this(), op_trace);
+}
+
+void SessionBasic::WarmUpOpGraphsImpl(const OpTrace &op_trace) {
+  size_t build_num = 0;
+  for (const auto &record : op_trace) {
+    if (run_op_graphs_.Peek(record.graph_info) != nullptr) {
+      continue;
+    }
+    BuildOpImpl(record.op_run_info, record.graph_info, record.input_tensors, record.tensors_mask);
+    ++build_num;
+  }
+  MS_LOG(INFO) << "Warm up " << build_num << " of " << op_trace.size() << " ops, " << run_op_graphs_.StatisticsInfo();
+}
+
+void SessionBasic::CacheOpGraph(const OpRunInfo &op_run_info, const GraphInfo &graph_info,
+                                const std::vector<tensor::TensorPtr> &input_tensors,
+                                const std::vector<int64_t> &tensors_mask, const KernelGraphPtr &graph) {
+  auto ms_context = MsContext::GetInstance();
+  MS_EXCEPTION_IF_NULL(ms_context);
+  run_op_graphs_.set_capacity(ms_context->get_param<uint32_t>(MS_CTX_OP_GRAPH_CACHE_CAPACITY));
+  run_op_graphs_.Insert(graph_info, graph);
+  if (!record_op_trace_) {
+    return;
+  }
+  if (input_tensors.size() != tensors_mask.size()) {
+    MS_LOG(EXCEPTION) << "Input tensors size " << input_tensors.size() << " should be equal to tensors mask size "
+                      << tensors_mask.size();
+  }
+  OpTraceRecord record{op_run_info, graph_info, {}, tensors_mask};
+  for (size_t i = 0; i < input_tensors.size(); ++i) {
+    const auto &tensor = input_tensors[i];
+    MS_EXCEPTION_IF_NULL(tensor);
+    if (tensors_mask[i] == kValueNodeTensorMask) {
+      record.input_tensors.push_back(tensor);
+      continue;
+    }
+    // the recorded tensor holds no device memory, so only the ops whose graphs do not depend on the device format
+    // of their inputs are built the same from it
+    auto device_address = std::dynamic_pointer_cast<device::DeviceAddress>(tensor->device_address());
+    if (device_address != nullptr &&
+        (device_address->format() != kOpFormat_DEFAULT || device_address->type_id() != tensor->data_type())) {
+      MS_LOG(INFO) << "Op " << op_run_info.op_name << " is not recorded, its input " << i << " is of format "
+                   << device_address->format() << " on device";
+      return;
+    }
+    record.input_tensors.push_back(std::make_shared<tensor::Tensor>(tensor->data_type(), tensor->shape()));
+  }
+  op_trace_.push_back(record);
+}
+
 void SessionBasic::RunOpsInGraph(const GraphId &graph_id, const std::vector<tensor::TensorPtr> &inputs,
                                  VectorRef *outputs) {
   MS_EXCEPTION_IF_NULL(executor_);
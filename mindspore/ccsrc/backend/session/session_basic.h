@@ -23,8 +23,10 @@
 #include <memory>
 #include <map>
 #include <set>
+#include <functional>
 #include "backend/session/session_context.h"
 #include "backend/session/kernel_graph.h"
+#include "backend/session/single_op_graph_cache.h"
 #include "backend/session/anf_runtime_algorithm.h"
 #include "ir/anf.h"
 #include "ir/tensor.h"
@@ -43,6 +45,8 @@ namespace session {
 void ClearPythonParasMap();
 using CallBackFunc = uint32_t (*)(uint32_t graph_id,
                                   const std::map<std::string, mindspore::tensor::TensorPtr> &params_list);
+// the key of the cached graph of an op, computed when the op runs as its inputs may be produced by the ops before it
+using GraphInfoFunc = std::function<GraphInfo(const std::vector<tensor::TensorPtr> &)>;
 using AnyList = std::vector<Any>;
 using AnyListPtr = std::shared_ptr<AnyList>;
 
@@ -56,13 +60,24 @@ struct OpRunInfo {
   size_t next_input_index = 0;
 };
 using OpRunInfoPtr = std::shared_ptr<OpRunInfo>;
+// an op whose graph is built while the op trace is recorded, the input tensors other than the value node ones keep
+// only the shape and the type
+struct OpTraceRecord {
+  OpRunInfo op_run_info;
+  GraphInfo graph_info;
+  std::vector<tensor::TensorPtr> input_tensors;
+  std::vector<int64_t> tensors_mask;
+};
+using OpTrace = std::vector<OpTraceRecord>;
 class Executor;
 class SessionBasic : public std::enable_shared_from_this<SessionBasic> {
  public:
-  SessionBasic() : context_(nullptr), summary_callback_(nullptr), device_id_(0) {
+  SessionBasic()
+      : run_op_graphs_(OP_GRAPH_CACHE_CAPACITY_DEFAULT), context_(nullptr), summary_callback_(nullptr), device_id_(0) {
 #if !defined(_WIN32) && !defined(_WIN64)
     debugger_ = nullptr;
 #endif
+    run_op_graphs_.set_release_callback([this](const KernelGraphPtr &graph) { ReleaseOpGraph(graph); });
   }
 
   virtual void Init(uint32_t device_id) { device_id_ = device_id; }
@@ -77,7 +92,18 @@ class SessionBasic : public std::enable_shared_from_this<SessionBasic> {
   void RunGraphAsync(const GraphId &graph_id, const std::vector<tensor::TensorPtr> &inputs, VectorRef *outputs);
   void RunOp(OpRunInfo *, const GraphInfo &, std::vector<tensor::TensorPtr> *input_tensors, VectorRef *outputs,
              const std::vector<int64_t> &tensors_mask);
+  // dispatch the op to the executor thread, the output tensors are ready when their wait is done
+  void RunOpAsync(const OpRunInfo &op_run_info, const GraphInfoFunc &graph_info_func,
+                  const std::vector<tensor::TensorPtr> &input_tensors, const std::vector<int64_t> &tensors_mask,
+                  const std::vector<tensor::TensorPtr> &output_tensors);
   void RunOpsInGraph(const GraphId &graph_id, const std::vector<tensor::TensorPtr> &inputs, VectorRef *outputs);
+  void SyncRunOps();
+  // record the ops whose graphs are built from now on, until the trace is stopped
+  void StartOpTrace();
+  OpTrace StopOpTrace();
+  // build the graphs of the ops in the trace which are not cached, so that running them later does not build them
+  void WarmUpOpGraphs(const OpTrace &op_trace);
+  const SingleOpGraphCache &op_graph_cache() const { return run_op_graphs_; }
 
   virtual void RegisterSummaryCallBackFunc(const CallBackFunc &callback);
 
@@ -136,7 +162,9 @@ class SessionBasic : public std::enable_shared_from_this<SessionBasic> {
   friend class BuildGraphTask;
   friend class RunGraphTask;
   friend class RunOpTask;
+  friend class RunOpAsyncTask;
   friend class RunOpsInGraphTask;
+  friend class BuildOpsTask;
   virtual bool IsSupportSummary() { return true; }
   virtual void CreateOutputTensors(const GraphId &graph_id, const std::vector<tensor::TensorPtr> &input_tensors,
                                    VectorRef *outputs,
@@ -155,8 +183,16 @@ class SessionBasic : public std::enable_shared_from_this<SessionBasic> {
   virtual void RunOpImpl(const GraphInfo &graph_info, OpRunInfo *op_run_info,
                          std::vector<tensor::TensorPtr> *input_tensors, VectorRef *outputs,
                          const std::vector<int64_t> &tensors_mask) {}
+  // the kernel graph releases its resources of the runtime manager when destroyed, the sessions owning a runtime
+  // release the resources of the single op graphs evicted from the cache here
+  virtual void ReleaseOpGraph(const KernelGraphPtr &graph) {}
   virtual void RunOpsInGraphImpl(const GraphId &graph_id, const std::vector<tensor::TensorPtr> &inputs,
                                  VectorRef *outputs) {}
+  void WarmUpOpGraphsImpl(const OpTrace &op_trace);
+  // cache the graph built for an op, recording the op if the op trace is on
+  void CacheOpGraph(const OpRunInfo &op_run_info, const GraphInfo &graph_info,
+                    const std::vector<tensor::TensorPtr> &input_tensors, const std::vector<int64_t> &tensors_mask,
+                    const KernelGraphPtr &graph);
   void RunInfer(NotNull<FuncGraphPtr> func_graph, const std::vector<tensor::TensorPtr> &inputs);
 
   virtual void SetSummaryNodes(KernelGraph *graph);
@@ -190,7 +226,9 @@ class SessionBasic : public std::enable_shared_from_this<SessionBasic> {
   void UpdateAllGraphDynamicShapeAttr(const std::vector<KernelGraphPtr> &all_graphs);
 
   std::unordered_map<GraphId, std::shared_ptr<KernelGraph>> graphs_;
-  std::unordered_map<GraphInfo, std::shared_ptr<KernelGraph>> run_op_graphs_;
+  SingleOpGraphCache run_op_graphs_;
+  bool record_op_trace_{false};
+  OpTrace op_trace_;
   std::unordered_map<FuncGraphPtr, KernelGraphPtr> front_backend_graph_map_;
   std::shared_ptr<Context> context_;
   CallBackFunc summary_callback_;
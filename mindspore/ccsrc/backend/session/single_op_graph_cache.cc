@@ -0,0 +1,105 @@
+/**
+ * Copyright 2020 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "backend/session/single_op_graph_cache.h"
+#include <algorithm>
+#include <sstream>
+#include <utility>
+#include "utils/log_adapter.h"
+
+namespace mindspore {
+namespace session {
+SingleOpGraphCache::SingleOpGraphCache(size_t capacity) : capacity_(std::max(capacity, static_cast<size_t>(1))) {}
+
+KernelGraphPtr SingleOpGraphCache::Get(const GraphInfo &graph_info) {
+  auto iter = graphs_.find(graph_info);
+  if (iter == graphs_.end()) {
+    ++miss_num_;
+    return nullptr;
+  }
+  ++hit_num_;
+  auto &entry = iter->second;
+  use_list_.splice(use_list_.begin(), use_list_, entry.use_iter);
+  return entry.graph;
+}
+
+KernelGraphPtr SingleOpGraphCache::Peek(const GraphInfo &graph_info) const {
+  auto iter = graphs_.find(graph_info);
+  return iter == graphs_.end() ? nullptr : iter->second.graph;
+}
+
+void SingleOpGraphCache::Insert(const GraphInfo &graph_info, const KernelGraphPtr &graph) {
+  MS_EXCEPTION_IF_NULL(graph);
+  auto iter = graphs_.find(graph_info);
+  if (iter != graphs_.end()) {
+    if (iter->second.graph != graph) {
+      Release(iter->second.graph);
+    }
+    iter->second.graph = graph;
+    use_list_.splice(use_list_.begin(), use_list_, iter->second.use_iter);
+    return;
+  }
+  // make room first, so that the inserted graph is never the one evicted
+  while (graphs_.size() >= capacity_) {
+    Evict();
+  }
+  iter = graphs_.emplace(graph_info, CacheEntry{graph, use_list_.end()}).first;
+  use_list_.push_front(&iter->first);
+  iter->second.use_iter = use_list_.begin();
+}
+
+void SingleOpGraphCache::Evict() {
+  if (use_list_.empty()) {
+    return;
+  }
+  auto iter = graphs_.find(*use_list_.back());
+  use_list_.pop_back();
+  MS_LOG(DEBUG) << "Evict the single op graph of " << iter->first;
+  auto graph = iter->second.graph;
+  (void)graphs_.erase(iter);
+  Release(graph);
+  ++eviction_num_;
+}
+
+void SingleOpGraphCache::Clear() {
+  auto graphs = std::move(graphs_);
+  graphs_.clear();
+  use_list_.clear();
+  for (auto &item : graphs) {
+    Release(item.second.graph);
+  }
+}
+
+void SingleOpGraphCache::Release(const KernelGraphPtr &graph) const {
+  if (release_callback_ != nullptr && graph != nullptr) {
+    release_callback_(graph);
+  }
+}
+
+void SingleOpGraphCache::set_capacity(size_t capacity) {
+  capacity_ = std::max(capacity, static_cast<size_t>(1));
+  while (graphs_.size() > capacity_) {
+    Evict();
+  }
+}
+
+std::string SingleOpGraphCache::StatisticsInfo() const {
+  std::ostringstream buffer;
+  buffer << "single op graph cache size " << graphs_.size() << "/" << capacity_ << ", hit " << hit_num_ << ", miss "
+         << miss_num_ << ", eviction " << eviction_num_;
+  return buffer.str();
+}
+}  // namespace session
+}  // namespace mindspore
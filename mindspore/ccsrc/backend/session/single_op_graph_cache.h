@@ -0,0 +1,75 @@
+/**
+ * Copyright 2020 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef MINDSPORE_CCSRC_BACKEND_SESSION_SINGLE_OP_GRAPH_CACHE_H_
+#define MINDSPORE_CCSRC_BACKEND_SESSION_SINGLE_OP_GRAPH_CACHE_H_
+
+#include <functional>
+#include <list>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include "backend/session/kernel_graph.h"
+
+namespace mindspore {
+using GraphInfo = std::string;
+namespace session {
+// SingleOpGraphCache keeps the graphs built for the ops of pynative mode by their graph info. It holds at most
+// capacity graphs, the least recently used one is released when a graph is inserted into a full cache.
+class SingleOpGraphCache {
+ public:
+  // release the runtime resources of a graph dropped from the cache
+  using ReleaseCallback = std::function<void(const KernelGraphPtr &graph)>;
+  explicit SingleOpGraphCache(size_t capacity);
+  ~SingleOpGraphCache() = default;
+
+  // the graph cached for graph_info, nullptr on a miss. A hit makes the graph the most recently used one.
+  KernelGraphPtr Get(const GraphInfo &graph_info);
+  // unlike Get, it is not counted and does not change the order of eviction
+  KernelGraphPtr Peek(const GraphInfo &graph_info) const;
+  void Insert(const GraphInfo &graph_info, const KernelGraphPtr &graph);
+  void Clear();
+
+  void set_capacity(size_t capacity);
+  void set_release_callback(const ReleaseCallback &callback) { release_callback_ = callback; }
+  size_t capacity() const { return capacity_; }
+  size_t size() const { return graphs_.size(); }
+  size_t hit_num() const { return hit_num_; }
+  size_t miss_num() const { return miss_num_; }
+  size_t eviction_num() const { return eviction_num_; }
+  std::string StatisticsInfo() const;
+
+ private:
+  // the keys of graphs_ from the most recently used to the least, the keys of an unordered_map do not move
+  using UseList = std::list<const GraphInfo *>;
+  struct CacheEntry {
+    KernelGraphPtr graph;
+    UseList::iterator use_iter;
+  };
+  void Evict();
+  void Release(const KernelGraphPtr &graph) const;
+
+  size_t capacity_;
+  ReleaseCallback release_callback_{nullptr};
+  std::unordered_map<GraphInfo, CacheEntry> graphs_;
+  UseList use_list_;
+  size_t hit_num_{0};
+  size_t miss_num_{0};
+  size_t eviction_num_{0};
+};
+}  // namespace session
+}  // namespace mindspore
+
+#endif  // MINDSPORE_CCSRC_BACKEND_SESSION_SINGLE_OP_GRAPH_CACHE_H_
@@ -17,40 +17,12 @@
 #include "common/thread_pool.h"
 #include <algorithm>
 #include "utils/log_adapter.h"
-#include "utils/convert_utils_base.h"
 
 namespace mindspore {
 #ifdef ENABLE_D
 const int kDeviceNum = 8;
 #endif
 
-bool Queue::Enqueue(Task *task) {
-  const int tail_index = tail_.load(std::memory_order_relaxed);
-  // queue full
-  auto next = (tail_index + 1) % 2;
-  if (next == head_.load(std::memory_order_acquire)) {
-    return false;
-  }
-  buffer_[tail_index] = task;
-  tail_.store(next, std::memory_order_release);
-  ++task_size_;
-  return true;
-}
-
-bool Queue::Dequeue(Task **out) {
-  if (task_size_ == 0) {
-    return false;
-  }
-  // queue empty
-  const int head_index = head_.load(std::memory_order_relaxed);
-  if (head_index == tail_.load(std::memory_order_acquire)) {
-    return false;
-  }
-  *out = buffer_[head_index];
-  head_.store((head_index + 1) % 2, std::memory_order_release);
-  return true;
-}
-
 ThreadPool::ThreadPool() {
 #ifdef ENABLE_D
   auto cpu_core_num = std::thread::hardware_concurrency();
@@ -68,67 +40,64 @@ bool ThreadPool::SetThreadPool(int config_thread_num) {
   if (config_thread_num > cur_thread_nums_) {
     AddNewThread(config_thread_num - cur_thread_nums_);
   }
-  MS_LOG(DEBUG) << "cur_thread_nums_=" << cur_thread_nums_ << ", cur_thread_run_nums_=" << cur_thread_run_nums_;
+  MS_LOG(DEBUG) << "cur_thread_nums_=" << cur_thread_nums_;
   return true;
 }
 
 void ThreadPool::AddNewThread(int add_num) {
-  for (int i = cur_thread_nums_, j = 0; j < add_num; ++i, ++j) {
-    auto active = new std::atomic_bool{true};
-    auto queue = std::make_shared<Queue>();
-    std::thread thread([this, i, active, queue]() {
-      Task *task = nullptr;
-      while (!exit_run_) {
-        while (*active) {
-          if (queue->Dequeue(&task)) {
-            auto ret = (*task)();
-            if (ret != SUCCESS) {
-              error_info_.emplace_back(std::make_pair(i, std::make_pair(false, ret)));
-            }
-            queue->task_size_--;
+  for (int j = 0; j < add_num; ++j) {
+    std::thread thread([this]() {
+      while (true) {
+        TaskBatchPtr batch;
+        {
+          std::unique_lock<std::mutex> queue_lock(queue_mtx_);
+          queue_ready_.wait(queue_lock, [this] { return exit_run_ || !batch_queue_.empty(); });
+          if (exit_run_) {
+            return;
+          }
+          batch = batch_queue_.front();
+        }
+        if (!RunTask(batch)) {
+          // all tasks of the batch are claimed, the batch leaves the queue
+          std::lock_guard<std::mutex> queue_lock(queue_mtx_);
+          if (!batch_queue_.empty() && batch_queue_.front() == batch) {
+            batch_queue_.pop_front();
           }
-          std::this_thread::yield();
         }
-        std::unique_lock<std::mutex> queue_lock(thread_mtx_);
-        queue_ready_.wait(queue_lock, [active, this] { return exit_run_ || *active; });
       }
     });
     thread_list_.emplace_back(std::move(thread));
-    activate_list_.emplace_back(active);
-    queue_list_.emplace_back(queue);
   }
   cur_thread_nums_ += add_num;
-  cur_thread_run_nums_ += add_num;
   MS_LOG(INFO) << "add " << add_num << " thread";
 }
 
-void ThreadPool::AddRunThread(int num) {
-  MS_LOG(DEBUG) << "num=" << num << ", cur_thread_run_nums_=" << cur_thread_run_nums_;
-  int active_nums = num - cur_thread_run_nums_;
-  if (active_nums <= 0 || static_cast<int>(activate_list_.size()) < active_nums) {
-    return;
-  }
-  for (int i = cur_thread_run_nums_ - 1, j = 0; j < active_nums; ++i, ++j) {
-    *activate_list_[i] = true;
+bool ThreadPool::RunTask(const TaskBatchPtr &batch) {
+  auto task_id = batch->next++;
+  if (task_id >= batch->task_num) {
+    return false;
   }
-  std::lock_guard<std::mutex> queueLock(thread_mtx_);
-  queue_ready_.notify_all();
-  cur_thread_run_nums_ = num;
-}
-
-void ThreadPool::SubRunThread(int num) {
-  MS_LOG(DEBUG) << "sub num=" << num << ", cur_thread_run_nums_=" << cur_thread_run_nums_;
-  int deactive_nums = cur_thread_run_nums_ - num;
-  if (deactive_nums <= 0) {
-    return;
+  try {
+    auto ret = (*batch->tasks)[task_id]();
+    if (ret != SUCCESS) {
+      MS_LOG(ERROR) << "task " << task_id << " failed, error code is " << ret;
+      batch->failed = true;
+    }
+  } catch (const std::exception &e) {
+    MS_LOG(ERROR) << "task " << task_id << " failed: " << e.what();
+    batch->failed = true;
   }
-  for (int i = num, j = 0; j < deactive_nums; ++i, ++j) {
-    *activate_list_[i] = false;
+  if (++batch->finished == batch->task_num) {
+    std::lock_guard<std::mutex> queue_lock(queue_mtx_);
+    batch_finished_.notify_all();
   }
-  cur_thread_run_nums_ = num;
+  return true;
 }
 
 bool ThreadPool::LaunchMultipleTask(const std::vector<Task> &tasks) {
+  if (tasks.empty()) {
+    return true;
+  }
   int thread_num = tasks.size();
   if (thread_num > max_thread_num_) {
     thread_num = max_thread_num_;
@@ -136,45 +105,25 @@ bool ThreadPool::LaunchMultipleTask(const std::vector<Task> &tasks) {
   if (!SetThreadPool(thread_num)) {
     return false;
   }
-  error_info_.clear();
-  bool succ_flag;
-  for (int task_id = 0, queue_index = 0; task_id < SizeToInt(tasks.size()); ++task_id) {
-    do {
-      succ_flag = true;
-      if (!queue_list_[queue_index]->Enqueue(const_cast<Task *>(&tasks[task_id]))) {
-        std::this_thread::yield();
-        succ_flag = false;
-      }
-    } while (!succ_flag);
-    queue_index++;
-    if (queue_index >= cur_thread_run_nums_) {
-      queue_index = queue_index - cur_thread_run_nums_;
-    }
+  auto batch = std::make_shared<TaskBatch>(&tasks);
+  if (tasks.size() > 1) {
+    std::lock_guard<std::mutex> queue_lock(queue_mtx_);
+    batch_queue_.push_back(batch);
+    queue_ready_.notify_all();
   }
-  succ_flag = false;
-  while (!succ_flag) {
-    std::this_thread::yield();
-    succ_flag = true;
-    for (int i = 0; i < cur_thread_run_nums_; ++i) {
-      if (queue_list_[i]->task_size_ != 0) {
-        succ_flag = false;
-        break;
-      }
-    }
+  // the caller runs the tasks of its own batch as well, so nested launches from inside a task never starve
+  while (RunTask(batch)) {
   }
-  MS_LOG(INFO) << "Finish " << tasks.size() << " task successful";
-  return CheckResult();
-}
-
-bool ThreadPool::CheckResult() {
-  bool succ_flag = true;
-  for (auto result : error_info_) {
-    if (result.second.first) {
-      MS_LOG(ERROR) << "task " << result.first << " failed, error code is " << result.second.second;
-      succ_flag = false;
+  {
+    std::unique_lock<std::mutex> queue_lock(queue_mtx_);
+    auto iter = std::find(batch_queue_.begin(), batch_queue_.end(), batch);
+    if (iter != batch_queue_.end()) {
+      (void)batch_queue_.erase(iter);
     }
+    batch_finished_.wait(queue_lock, [&batch] { return batch->finished == batch->task_num; });
   }
-  return succ_flag;
+  MS_LOG(INFO) << "Finish " << tasks.size() << " task, " << (batch->failed ? "failed" : "successful");
+  return !batch->failed;
 }
 
 ThreadPool *ThreadPool::GetInstance() {
@@ -183,17 +132,15 @@ ThreadPool *ThreadPool::GetInstance() {
 }
 
 ThreadPool::~ThreadPool() {
-  cur_thread_run_nums_ = static_cast<int>(thread_list_.size());
-  exit_run_ = true;
-  SubRunThread(0);
+  {
+    std::lock_guard<std::mutex> queue_lock(queue_mtx_);
+    exit_run_ = true;
+  }
   queue_ready_.notify_all();
   for (auto &it : thread_list_) {
     if (it.joinable()) {
       it.join();
     }
   }
-  for (const auto &it : activate_list_) {
-    delete it;
-  }
 }
 }  // namespace mindspore
@@ -21,7 +21,7 @@
 #include <condition_variable>
 #include <thread>
 #include <vector>
-#include <queue>
+#include <deque>
 #include <string>
 #include <atomic>
 #include <memory>
@@ -36,19 +36,19 @@ const int kDefaultMaxThreadNum = 8;
 enum Status { FAIL = -1, SUCCESS = 0 };
 using Task = std::function<int()>;
 
-class Queue {
- public:
-  Queue() = default;
-  ~Queue() = default;
-  bool Enqueue(Task *task);
-  bool Dequeue(Task **out);
-  std::atomic_int task_size_ = {0};
-
- private:
-  std::atomic_int head_ = {0};
-  std::atomic_int tail_ = {0};
-  Task *buffer_[2]{};
+// The tasks of one LaunchMultipleTask call. Every caller owns its batch, so callers launching at the same time (the
+// kernels of the inter-op executor, the solvers of somas, ...) share the workers without waiting for each other.
+struct TaskBatch {
+  explicit TaskBatch(const std::vector<Task> *batch_tasks) : tasks(batch_tasks), task_num(batch_tasks->size()) {}
+  // only dereferenced for a claimed task, the caller keeps the tasks alive until all claimed tasks finish
+  const std::vector<Task> *tasks;
+  size_t task_num;
+  // the next task to claim, by a worker or by the caller
+  std::atomic_size_t next{0};
+  std::atomic_size_t finished{0};
+  std::atomic_bool failed{false};
 };
+using TaskBatchPtr = std::shared_ptr<TaskBatch>;
 
 class ThreadPool {
  public:
@@ -57,29 +57,27 @@ class ThreadPool {
   ThreadPool &operator=(const ThreadPool &) = delete;
 
   static ThreadPool *GetInstance();
-  // Use the tasks' size of threads to execute these tasks, one thread execute one task.
+  // Execute the tasks on the workers and the calling thread, and return after all of them finish.
   bool LaunchMultipleTask(const std::vector<Task> &tasks);
 
  private:
   ThreadPool();
   bool SetThreadPool(int config_thread_num);
   void AddNewThread(int add_num);
-  void AddRunThread(int num);
-  void SubRunThread(int num);
-  bool CheckResult();
+  // claim and run one task of the batch, return false if all its tasks are claimed
+  bool RunTask(const TaskBatchPtr &batch);
 
   int cur_thread_nums_{0};
-  int cur_thread_run_nums_{0};
   int core_thread_num_{kCoreThreadNum};
   int max_thread_num_{kDefaultMaxThreadNum};
   std::mutex pool_mtx_;
-  std::mutex thread_mtx_;
+  std::mutex queue_mtx_;
   std::condition_variable queue_ready_;
-  std::atomic_bool exit_run_ = {false};
-  std::vector<std::atomic_bool *> activate_list_{};
+  std::condition_variable batch_finished_;
+  bool exit_run_{false};
+  // the batches with unclaimed tasks, in launch order
+  std::deque<TaskBatchPtr> batch_queue_{};
   std::vector<std::thread> thread_list_{};
-  std::vector<std::shared_ptr<Queue>> queue_list_{};
-  std::vector<std::pair<int, std::pair<bool, int>>> error_info_{};
 };
 }  // namespace mindspore
 
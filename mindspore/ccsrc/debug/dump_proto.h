@@ -25,7 +25,7 @@ std::string GetFuncGraphProtoString(const FuncGraphPtr &func_graph);
 
 std::string GetOnnxProtoString(const FuncGraphPtr &func_graph);
 
-std::string GetBinaryProtoString(const FuncGraphPtr &func_graph);
+std::string GetBinaryProtoString(const FuncGraphPtr &func_graph, bool export_param_data = true);
 
 void DumpIRProto(const FuncGraphPtr &func_graph, const std::string &suffix);
 }  // namespace mindspore
@@ -562,10 +562,17 @@ void ClearTraceStack() {
   cnode_debug_stack.clear();
 }
 
+static thread_local bool trace_provider_enabled = true;
+
+void SetTraceProviderEnabledInThread(bool enabled) { trace_provider_enabled = enabled; }
+
 // Register trace provider to LogWriter.
 struct TraceProviderRegister {
   TraceProviderRegister() {
     LogWriter::set_trace_provider([](std::ostringstream &oss) {
+      if (!trace_provider_enabled) {
+        return;
+      }
       TraceGraphEval();
       GetEvalStackInfo(oss);
     });
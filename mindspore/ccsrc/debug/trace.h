@@ -43,6 +43,9 @@ std::vector<abstract::AnfNodeConfigPtr> &GetCNodeDebugStack();
 std::stack<std::pair<abstract::EvaluatorPtr, abstract::AnfNodeConfigPtr>> &GetCurrenGraphEvalStack();
 std::string GetAbstractStr(const abstract::AbstractBasePtr &abs);
 void ClearTraceStack();
+// the analysis stacks belong to the thread running the analysis, the errors raised by the helper threads inferring
+// nodes in parallel should not dump them, so the trace provider can be turned off for the current thread
+void SetTraceProviderEnabledInThread(bool enabled);
 }  // namespace trace
 }  // namespace mindspore
 
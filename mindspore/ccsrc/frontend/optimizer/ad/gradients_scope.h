@@ -0,0 +1,36 @@
+/**
+ * Copyright 2020 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef MINDSPORE_CCSRC_FRONTEND_OPTIMIZER_AD_GRADIENTS_SCOPE_H_
+#define MINDSPORE_CCSRC_FRONTEND_OPTIMIZER_AD_GRADIENTS_SCOPE_H_
+
+#include "ir/anf.h"
+#include "utils/log_adapter.h"
+
+namespace mindspore {
+namespace ad {
+// the prefix of the scope of the bprop graphs
+constexpr char kGradientsScope[] = "Gradients";
+
+// the nodes of the bprop graphs are put in the scope starting with "Gradients" by kprim
+inline bool IsInGradientsScope(const AnfNodePtr &node) {
+  MS_EXCEPTION_IF_NULL(node);
+  return node->scope() != nullptr && node->scope()->name().find(kGradientsScope) == 0;
+}
+}  // namespace ad
+}  // namespace mindspore
+
+#endif  // MINDSPORE_CCSRC_FRONTEND_OPTIMIZER_AD_GRADIENTS_SCOPE_H_
@@ -27,6 +27,7 @@
 #include "pipeline/jit/resource.h"
 #include "pipeline/jit/parse/parse.h"
 #include "frontend/optimizer/ad/dfunctor.h"
+#include "frontend/optimizer/ad/gradients_scope.h"
 #include "frontend/operator/ops.h"
 #include "frontend/operator/composite/composite.h"
 #include "utils/symbolic.h"
@@ -43,7 +44,7 @@ KPrim g_k_prims;
 FuncGraphPtr KPrim::GetBprop(const PrimitivePtr &prim) {
   // Set a child scope named "grad'PrimitiveName'" for the bprop function,
   // and add "Gradients" to the front.
-  static const std::string gradients_scope = "Gradients/";
+  static const std::string gradients_scope = std::string(kGradientsScope) + "/";
   static const std::string grad_op_child_scope_prefix = "/grad";
   MS_EXCEPTION_IF_NULL(prim);
   auto scope = std::make_shared<Scope>(gradients_scope + ScopeManager::GetInstance().GetCurrentScope()->name() +
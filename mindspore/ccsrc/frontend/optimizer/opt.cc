@@ -32,7 +32,9 @@ namespace opt {
 SubstitutionPtr MakeSubstitution(const OptimizerCallerPtr &transform, const std::string &name, const PrimitivePtr &prim,
                                  const RenormAction &renorm_action) {
   auto fn = [prim](const AnfNodePtr &node) -> bool { return IsPrimitiveCNode(node, prim); };
-  return std::make_shared<Substitution>(transform, name, fn, renorm_action);
+  auto substitution = std::make_shared<Substitution>(transform, name, fn, renorm_action);
+  substitution->root_prim_names_.push_back(prim->name());
+  return substitution;
 }
 
 SubstitutionPtr MakeSubstitution(const OptimizerCallerPtr &transform, const std::string &name,
@@ -59,7 +61,11 @@ SubstitutionPtr MakeSubstitution(const OptimizerCallerPtr &transform, const std:
     return false;
   };
 
-  return std::make_shared<Substitution>(transform, name, fn, renorm_action);
+  auto substitution = std::make_shared<Substitution>(transform, name, fn, renorm_action);
+  for (auto &prim : prims) {
+    substitution->root_prim_names_.push_back(prim->name());
+  }
+  return substitution;
 }
 
 SubstitutionPtr MakeSubstitution(const OptimizerCallerPtr &transform, const std::string &name,
@@ -90,6 +96,45 @@ AnfNodePtr Substitution::operator()(const OptimizerPtr &optimizer, const AnfNode
   return result;
 }
 
+SubstitutionList::SubstitutionList(const std::vector<SubstitutionPtr> &patterns, bool is_once)
+    : list_(patterns), is_once_(is_once) {
+  for (size_t i = 0; i < list_.size(); i++) {
+    MS_EXCEPTION_IF_NULL(list_[i]);
+    if (list_[i]->root_prim_names_.empty()) {
+      generic_candidates_.push_back(i);
+      continue;
+    }
+    for (auto &prim_name : list_[i]->root_prim_names_) {
+      prim_candidates_[prim_name].push_back(i);
+    }
+  }
+  // the substitutions matching any node are tried on the bucketed nodes as well, still in the order of the list
+  for (auto &bucket : prim_candidates_) {
+    auto &candidates = bucket.second;
+    candidates.erase(std::unique(candidates.begin(), candidates.end()), candidates.end());
+    std::vector<size_t> merged;
+    (void)std::merge(candidates.begin(), candidates.end(), generic_candidates_.begin(), generic_candidates_.end(),
+                     std::back_inserter(merged));
+    candidates.swap(merged);
+  }
+}
+
+const std::vector<size_t> &SubstitutionList::GetCandidates(const AnfNodePtr &node) const {
+  auto cnode = node->cast<CNodePtr>();
+  if (cnode == nullptr || cnode->inputs().empty()) {
+    return generic_candidates_;
+  }
+  auto prim = GetValueNode<PrimitivePtr>(cnode->input(0));
+  if (prim == nullptr) {
+    return generic_candidates_;
+  }
+  auto iter = prim_candidates_.find(prim->name());
+  if (iter == prim_candidates_.end()) {
+    return generic_candidates_;
+  }
+  return iter->second;
+}
+
 static bool isTraversable(const AnfNodePtr &node) {
   if (node == nullptr) {
     return false;
@@ -180,6 +225,89 @@ bool SubstitutionList::ApplyTransform(const OptimizerPtr &optimizer, const AnfNo
   return changes;
 }
 
+bool SubstitutionList::ApplySubstitutionsToIR(const OptimizerPtr &optimizer, const AnfNodePtr &root_node,
+                                              std::vector<bool> *changed_substitutions) const {
+#ifdef ENABLE_PROFILE
+  double start = GetTime();
+#endif
+  FuncGraphManagerPtr manager = optimizer->manager();
+  auto seen = NewSeenGeneration();
+  // 1024 is for the initial capacity of deque
+  std::deque<AnfNodePtr> todo(1024);
+  todo.clear();
+  todo.push_back(root_node);
+  bool changes = false;
+
+  auto &all_nodes = manager->all_nodes();
+  while (!todo.empty()) {
+    AnfNodePtr node = todo.front();
+    todo.pop_front();
+
+    if (node == nullptr || node->seen_ == seen || !isTraversable(node) || !all_nodes.contains(node)) {
+      continue;
+    }
+    node->seen_ = seen;
+
+    // the first substitution replacing the node wins, the new node is visited again with its own candidates
+    bool change = false;
+    for (auto index : GetCandidates(node)) {
+      auto &substitution = list_[index];
+      if (!substitution->predicate_(node)) {
+        continue;
+      }
+      TraceGuard trace_guard(std::make_shared<TraceOpt>(node->debug_info()));
+      auto ret = (*substitution)(optimizer, node);
+      if (ret == nullptr || ret == node) {
+        continue;
+      }
+      change = true;
+      changes = true;
+      (*changed_substitutions)[index] = true;
+#ifdef ENABLE_PROFILE
+      double t = GetTime();
+#endif
+      (void)manager->Replace(node, ret);
+#ifdef ENABLE_PROFILE
+      MsProfile::StatTime("replace." + substitution->name_, GetTime() - t);
+#endif
+      node = ret;
+      break;
+    }
+
+    if (change) {
+      todo.push_front(node);
+      auto &node_users = manager->node_users();
+      auto users_iter = node_users.find(node);
+      if (users_iter != node_users.end()) {
+        for (auto &use : users_iter->second) {
+          auto use_node = use.first;
+          if (use_node == nullptr) {
+            continue;
+          }
+          todo.push_back(use_node);
+          if (use_node->seen_ == seen) {
+            use_node->seen_--;
+          }
+        }
+      }
+      continue;
+    }
+
+    if (IsValueNode<FuncGraph>(node)) {
+      todo.push_back(GetValueNode<FuncGraphPtr>(node)->output());
+    }
+    if (node->isa<CNode>()) {
+      auto &inputs = node->cast<CNodePtr>()->inputs();
+      (void)std::copy(inputs.begin(), inputs.end(), std::back_inserter(todo));
+    }
+  }
+
+#ifdef ENABLE_PROFILE
+  MsProfile::StatTime("opt.transform." + optimizer->name(), GetTime() - start);
+#endif
+  return changes;
+}
+
 bool SubstitutionList::operator()(const FuncGraphPtr &func_graph, const OptimizerPtr &optimizer) const {
   MS_EXCEPTION_IF_NULL(optimizer);
   MS_EXCEPTION_IF_NULL(func_graph);
@@ -195,15 +323,30 @@ bool SubstitutionList::operator()(const FuncGraphPtr &func_graph, const Optimize
     }
   }
 
-  bool loop = false;
   bool changes = false;
 
-  do {
-    loop = false;
+  // a list run to a fixpoint is applied by sweeps visiting each node once instead of one graph traversal per
+  // substitution, the substitutions are still tried on a node in the order of the list
+  if (!is_once_) {
+    size_t sweeps = 0;
+    bool loop = false;
+    do {
+      std::vector<bool> changed_substitutions(list_.size(), false);
+      loop = ApplySubstitutionsToIR(optimizer, func_graph->output(), &changed_substitutions);
+      changes = changes || loop;
+      sweeps++;
+      if (optimizer->is_on_debug_) {
+        for (size_t i = 0; i < list_.size(); i++) {
+          status[list_[i]->name_ + std::to_string(i)].push_back(changed_substitutions[i]);
+          space = std::max(list_[i]->name_.size(), space);
+        }
+      }
+    } while (loop);
+    MS_LOG(DEBUG) << "Pass " << optimizer->name() << " reached a fixpoint after " << sweeps << " sweeps.";
+  } else {
     for (size_t i = 0; i < list_.size(); i++) {
       auto change = ApplyTransform(optimizer, func_graph->output(), list_[i]);
       changes = changes || change;
-      loop = loop || change;
 
       // record the status of each transform
       if (optimizer->is_on_debug_) {
@@ -211,11 +354,7 @@ bool SubstitutionList::operator()(const FuncGraphPtr &func_graph, const Optimize
         space = std::max(list_[i]->name_.size(), space);
       }
     }
-
-    if (is_once_) {
-      break;
-    }
-  } while (loop);
+  }
 
   // display the status of each transform
   if (optimizer->is_on_debug_) {
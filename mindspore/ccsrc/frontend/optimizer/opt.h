@@ -19,6 +19,7 @@
 
 #include <memory>
 #include <string>
+#include <unordered_map>
 #include <vector>
 
 #include "ir/anf.h"
@@ -42,6 +43,8 @@ class Substitution {
   PredicateFuncType predicate_{nullptr};
   // an enum to mark this Substitution relation to renormalize pass
   RenormAction renorm_action_;
+  // names of the primitives the predicate matches at the root node, empty if the predicate is not about them
+  std::vector<std::string> root_prim_names_;
   Substitution(const OptimizerCallerPtr &transform, const std::string &name, const PredicateFuncType &predicate,
                const RenormAction &renorm_action)
       : transform_(transform), name_(name), predicate_(predicate), renorm_action_(renorm_action) {}
@@ -61,15 +64,22 @@ SubstitutionPtr MakeSubstitution(const OptimizerCallerPtr &transform, const std:
 
 class SubstitutionList {
  public:
-  explicit SubstitutionList(const std::vector<SubstitutionPtr> &patterns, bool is_once = false)
-      : list_(patterns), is_once_(is_once) {}
+  explicit SubstitutionList(const std::vector<SubstitutionPtr> &patterns, bool is_once = false);
   ~SubstitutionList() = default;
 
   bool operator()(const FuncGraphPtr &func_graph, const OptimizerPtr &optimizer) const;
 
  private:
   bool ApplyTransform(const OptimizerPtr &optimizer, const AnfNodePtr &node, const SubstitutionPtr &transform) const;
+  // one sweep of all substitutions over the graph, a node is only tried with the substitutions of its root primitive
+  // and those matching any node; the users of a replaced node are visited again
+  bool ApplySubstitutionsToIR(const OptimizerPtr &optimizer, const AnfNodePtr &root_node,
+                              std::vector<bool> *changed_substitutions) const;
+  const std::vector<size_t> &GetCandidates(const AnfNodePtr &node) const;
   std::vector<SubstitutionPtr> list_;
+  // indexes of list_ by root primitive name, and of the substitutions which are not bucketed, in list order
+  std::unordered_map<std::string, std::vector<size_t>> prim_candidates_;
+  std::vector<size_t> generic_candidates_;
   // a flag to mark this list of Substitution can only be executed only once
   bool is_once_;
 };
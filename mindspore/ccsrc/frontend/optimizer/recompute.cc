@@ -0,0 +1,315 @@
+/**
+ * Copyright 2020 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "frontend/optimizer/recompute.h"
+
+#include <algorithm>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+#include "abstract/utils.h"
+#include "base/core_ops.h"
+#include "frontend/optimizer/ad/gradients_scope.h"
+#include "ir/func_graph.h"
+#include "ir/graph_utils.h"
+#include "ir/manager.h"
+#include "utils/flags.h"
+#include "utils/ms_context.h"
+#include "utils/utils.h"
+
+namespace mindspore {
+namespace opt {
+namespace {
+constexpr float kGBToByte = 1024 * 1024 * 1024;
+
+// the ops cheap to compute again, selected when the activations exceed the memory budget
+const std::unordered_set<std::string> kAutoRecomputeOps = {
+  "ReLU", "ReLU6", "Gelu", "Sigmoid", "Tanh", "Cast", "Neg", "Square", "Sqrt", "Exp", "TensorAdd", "Sub", "Mul",
+  "RealDiv", "BiasAdd", "Reshape", "Squeeze", "ExpandDims", "Transpose"};
+
+using NodeSet = std::unordered_set<AnfNodePtr>;
+
+bool IsBpropNode(const AnfNodePtr &node) { return ad::IsInGradientsScope(node) && node->isa<CNode>(); }
+
+bool IsForwardNode(const AnfNodePtr &node) { return node->isa<CNode>() && !IsBpropNode(node); }
+
+bool HasTrueAttr(const PrimitivePtr &prim, const std::string &name) {
+  auto value = prim->GetAttr(name);
+  return value != nullptr && value->isa<BoolImm>() && GetValue<bool>(value);
+}
+
+// the random ops give other outputs and the ops with side effect can not run twice
+bool CanRecompute(const AnfNodePtr &node) {
+  static const std::vector<PrimitivePtr> kNotComputedOps = {prim::kPrimDepend, prim::kPrimControlDepend,
+                                                            prim::kPrimMakeTuple, prim::kPrimTupleGetItem,
+                                                            prim::kPrimReturn};
+  auto prim = GetCNodePrimitive(node);
+  if (prim == nullptr || std::any_of(kNotComputedOps.begin(), kNotComputedOps.end(),
+                                     [&node](const PrimitivePtr &op) { return IsPrimitiveCNode(node, op); })) {
+    return false;
+  }
+  return !HasTrueAttr(prim, GRAPH_FLAG_RANDOM_EFFECT) && !HasTrueAttr(prim, GRAPH_FLAG_SIDE_EFFECT);
+}
+
+size_t TensorBytes(const AbstractBasePtr &abs) {
+  if (abs == nullptr) {
+    return 0;
+  }
+  if (abs->isa<abstract::AbstractTuple>()) {
+    size_t bytes = 0;
+    for (const auto &element : abs->cast<abstract::AbstractTuplePtr>()->elements()) {
+      bytes += TensorBytes(element);
+    }
+    return bytes;
+  }
+  auto tensor = abs->cast<abstract::AbstractTensorPtr>();
+  if (tensor == nullptr || tensor->element() == nullptr || tensor->shape() == nullptr) {
+    return 0;
+  }
+  size_t bytes = abstract::TypeIdSize(tensor->element()->BuildType()->type_id());
+  for (auto dim : tensor->shape()->shape()) {
+    // unknown until run
+    if (dim < 0) {
+      return 0;
+    }
+    bytes *= LongToSize(dim);
+  }
+  return bytes;
+}
+
+// the forward outputs used by the backward nodes or by the recomputed nodes, kept from the forward pass
+NodeSet KeptActivations(const FuncGraphManagerPtr &manager, const std::vector<AnfNodePtr> &forward_nodes,
+                        const NodeSet &recomputed) {
+  auto &node_users = manager->node_users();
+  NodeSet kept;
+  for (const auto &node : forward_nodes) {
+    if (recomputed.count(node) > 0) {
+      auto &inputs = node->cast<CNodePtr>()->inputs();
+      for (size_t i = 1; i < inputs.size(); ++i) {
+        if (IsForwardNode(inputs[i]) && recomputed.count(inputs[i]) == 0) {
+          (void)kept.insert(inputs[i]);
+        }
+      }
+      continue;
+    }
+    auto iter = node_users.find(node);
+    if (iter == node_users.end()) {
+      continue;
+    }
+    if (std::any_of(iter->second.begin(), iter->second.end(),
+                    [](const auto &user) { return IsBpropNode(user.first); })) {
+      (void)kept.insert(node);
+    }
+  }
+  return kept;
+}
+
+size_t TotalBytes(const NodeSet &nodes) {
+  size_t bytes = 0;
+  for (const auto &node : nodes) {
+    bytes += TensorBytes(node->abstract());
+  }
+  return bytes;
+}
+
+// recompute the kept cheap ops, the largest first, until the kept activations fit in the budget
+void SelectByBudget(const FuncGraphManagerPtr &manager, const std::vector<AnfNodePtr> &forward_nodes,
+                    size_t budget, NodeSet *recomputed) {
+  auto kept = KeptActivations(manager, forward_nodes, *recomputed);
+  size_t total = TotalBytes(kept);
+  if (total <= budget) {
+    return;
+  }
+  std::vector<AnfNodePtr> candidates;
+  for (const auto &node : forward_nodes) {
+    auto prim = GetCNodePrimitive(node);
+    if (kept.count(node) > 0 && CanRecompute(node) && kAutoRecomputeOps.count(prim->name()) > 0 &&
+        node->abstract() != nullptr && node->abstract()->isa<abstract::AbstractTensor>()) {
+      candidates.push_back(node);
+    }
+  }
+  std::stable_sort(candidates.begin(), candidates.end(), [](const AnfNodePtr &lhs, const AnfNodePtr &rhs) {
+    return TensorBytes(lhs->abstract()) > TensorBytes(rhs->abstract());
+  });
+  for (const auto &node : candidates) {
+    if (total <= budget) {
+      break;
+    }
+    // the inputs of the node are kept instead of its output
+    std::vector<AnfNodePtr> new_kept;
+    size_t added = 0;
+    auto &inputs = node->cast<CNodePtr>()->inputs();
+    for (size_t i = 1; i < inputs.size(); ++i) {
+      if (IsForwardNode(inputs[i]) && recomputed->count(inputs[i]) == 0 && kept.count(inputs[i]) == 0 &&
+          std::find(new_kept.begin(), new_kept.end(), inputs[i]) == new_kept.end()) {
+        new_kept.push_back(inputs[i]);
+        added += TensorBytes(inputs[i]->abstract());
+      }
+    }
+    size_t removed = TensorBytes(node->abstract());
+    if (added >= removed) {
+      continue;
+    }
+    (void)recomputed->insert(node);
+    (void)kept.erase(node);
+    kept.insert(new_kept.begin(), new_kept.end());
+    total = total - removed + added;
+  }
+}
+
+AnfNodePtr DuplicateNode(const AnfNodePtr &node, const AnfNodePtr &attach, const NodeSet &recomputed,
+                         std::unordered_map<AnfNodePtr, AnfNodePtr> *duplicated) {
+  MS_EXCEPTION_IF_NULL(attach);
+  auto iter = duplicated->find(node);
+  if (iter != duplicated->end()) {
+    return iter->second;
+  }
+  auto cnode = node->cast<CNodePtr>();
+  MS_EXCEPTION_IF_NULL(cnode);
+  auto graph = cnode->func_graph();
+  MS_EXCEPTION_IF_NULL(graph);
+  std::vector<AnfNodePtr> inputs{cnode->input(0)};
+  for (size_t i = 1; i < cnode->size(); ++i) {
+    auto input = cnode->input(i);
+    if (recomputed.count(input) > 0 && input->func_graph() == graph) {
+      inputs.push_back(DuplicateNode(input, attach, recomputed, duplicated));
+    } else if (!input->isa<ValueNode>()) {
+      // computed again only when the gradients reach the backward node, not along with the forward pass
+      auto depend = graph->NewCNode({NewValueNode(prim::kPrimDepend), input, attach});
+      depend->set_abstract(input->abstract());
+      inputs.push_back(depend);
+    } else {
+      inputs.push_back(input);
+    }
+  }
+  auto new_node = graph->NewCNode(inputs);
+  new_node->set_abstract(cnode->abstract());
+  new_node->set_scope(cnode->scope());
+  (*duplicated)[node] = new_node;
+  return new_node;
+}
+
+// the gradients flowing into the backward node
+AnfNodePtr GetGradientsOf(const CNodePtr &node) {
+  std::vector<AnfNodePtr> grads{NewValueNode(prim::kPrimMakeTuple)};
+  AbstractBasePtrList grads_abs;
+  for (size_t i = 1; i < node->size(); ++i) {
+    if (IsBpropNode(node->input(i))) {
+      grads.push_back(node->input(i));
+      grads_abs.push_back(node->input(i)->abstract());
+    }
+  }
+  if (grads.size() == 1) {
+    return nullptr;
+  }
+  if (grads.size() == 2) {
+    return grads[1];
+  }
+  auto make_tuple = node->func_graph()->NewCNode(grads);
+  make_tuple->set_abstract(std::make_shared<abstract::AbstractTuple>(grads_abs));
+  return make_tuple;
+}
+}  // namespace
+
+bool InsertRecomputedNodes(const FuncGraphPtr &graph) {
+  MS_EXCEPTION_IF_NULL(graph);
+  auto manager = graph->manager();
+  MS_EXCEPTION_IF_NULL(manager);
+  std::vector<AnfNodePtr> forward_nodes;
+  std::vector<CNodePtr> bprop_nodes;
+  NodeSet recomputed;
+  for (const auto &fg : manager->func_graphs()) {
+    MS_EXCEPTION_IF_NULL(fg);
+    for (const auto &node : TopoSort(fg->get_return())) {
+      if (!node->isa<CNode>() || node->func_graph() != fg) {
+        continue;
+      }
+      if (IsBpropNode(node)) {
+        bprop_nodes.push_back(node->cast<CNodePtr>());
+        continue;
+      }
+      forward_nodes.push_back(node);
+      auto prim = GetCNodePrimitive(node);
+      if (prim != nullptr && HasTrueAttr(prim, kAttrRecompute)) {
+        if (CanRecompute(node)) {
+          (void)recomputed.insert(node);
+        } else {
+          MS_LOG(INFO) << "Node " << node->DebugString() << " can not be recomputed.";
+        }
+      }
+    }
+  }
+  if (bprop_nodes.empty()) {
+    return false;
+  }
+  size_t kept_bytes = TotalBytes(KeptActivations(manager, forward_nodes, {}));
+  MS_LOG(INFO) << "The forward activations kept for the backward graph are estimated to be " << kept_bytes
+               << " bytes.";
+  auto context = MsContext::GetInstance();
+  MS_EXCEPTION_IF_NULL(context);
+  float budget = context->get_param<float>(MS_CTX_RECOMPUTE_MEMORY_BUDGET);
+  if (budget > 0) {
+    SelectByBudget(manager, forward_nodes, static_cast<size_t>(budget * kGBToByte), &recomputed);
+  }
+  if (recomputed.empty()) {
+    return false;
+  }
+  // the tuple items of the recomputed nodes are taken from the duplicated ones
+  for (const auto &node : forward_nodes) {
+    if (IsPrimitiveCNode(node, prim::kPrimTupleGetItem) && recomputed.count(node->cast<CNodePtr>()->input(1)) > 0) {
+      (void)recomputed.insert(node);
+    }
+  }
+  size_t recomputed_kept_bytes = TotalBytes(KeptActivations(manager, forward_nodes, recomputed));
+
+  // a duplicated node waits for the gradients of the first backward node using it in topological order, the later
+  // ones may use it as well. A backward node without gradient inputs has nothing to wait for, a duplicate of it would
+  // be merged back into the forward node by cse, so it keeps the forward node unless an earlier one duplicated it.
+  std::unordered_map<AnfNodePtr, AnfNodePtr> duplicated;
+  for (const auto &node : bprop_nodes) {
+    AnfNodePtr attach = nullptr;
+    bool attach_found = false;
+    for (size_t i = 1; i < node->size(); ++i) {
+      auto input = node->input(i);
+      if (recomputed.count(input) == 0 || input->func_graph() != node->func_graph()) {
+        continue;
+      }
+      if (!attach_found) {
+        attach = GetGradientsOf(node);
+        attach_found = true;
+      }
+      if (attach == nullptr) {
+        auto iter = duplicated.find(input);
+        if (iter != duplicated.end()) {
+          manager->SetEdge(node, SizeToInt(i), iter->second);
+        } else {
+          MS_LOG(INFO) << "Node " << node->DebugString() << " has no gradient inputs, it keeps the forward node "
+                       << input->DebugString();
+        }
+        continue;
+      }
+      manager->SetEdge(node, SizeToInt(i), DuplicateNode(input, attach, recomputed, &duplicated));
+    }
+  }
+  MS_LOG(INFO) << "Recompute " << duplicated.size() << " nodes in the backward graph, the forward activations kept "
+               << "for it are estimated to go from " << kept_bytes << " to " << recomputed_kept_bytes << " bytes.";
+  return !duplicated.empty();
+}
+}  // namespace opt
+}  // namespace mindspore
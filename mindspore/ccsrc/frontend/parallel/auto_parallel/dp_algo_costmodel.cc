@@ -16,19 +16,68 @@
 
 #include "frontend/parallel/auto_parallel/dp_algo_costmodel.h"
 
+#include <algorithm>
+#include <chrono>
+#include <exception>
 #include <memory>
+#include <thread>
 #include <utility>
 #include <vector>
+#include "common/thread_pool.h"
 
 namespace mindspore {
 namespace parallel {
-Status GetStrategy(const CostGraphPtr &graph) {
-  MS_LOG(INFO) << "Searching strategies begins.";
+namespace {
+int64_t ElapsedUs(const std::chrono::steady_clock::time_point &start) {
+  return std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - start).count();
+}
+
+// Shrink the components, at most one thread per core: the threads of the pool spin while waiting.
+std::vector<std::vector<EliminationPtr>> EliminateComponents(const std::vector<CostGraphPtr> &components) {
+  std::vector<std::vector<EliminationPtr>> eliminations(components.size());
+  size_t thread_num = std::min(components.size(), std::min(static_cast<size_t>(std::thread::hardware_concurrency()),
+                                                           static_cast<size_t>(kDefaultMaxThreadNum)));
+  MS_LOG(INFO) << "Eliminating " << components.size() << " components in "
+               << std::max(thread_num, static_cast<size_t>(1)) << " threads.";
+  if (thread_num <= 1) {
+    for (size_t i = 0; i < components.size(); ++i) {
+      eliminations[i] = EliminateGraph(components[i]);
+    }
+    return eliminations;
+  }
+  // the exceptions are rethrown in the calling thread
+  std::vector<std::exception_ptr> errors(thread_num);
+  std::vector<Task> tasks;
+  for (size_t i = 0; i < thread_num; ++i) {
+    tasks.emplace_back([i, thread_num, &components, &eliminations, &errors]() {
+      try {
+        for (size_t j = i; j < components.size(); j += thread_num) {
+          eliminations[j] = EliminateGraph(components[j]);
+        }
+      } catch (...) {
+        errors[i] = std::current_exception();
+      }
+      return static_cast<int>(mindspore::SUCCESS);
+    });
+  }
+  if (!ThreadPool::GetInstance()->LaunchMultipleTask(tasks)) {
+    MS_LOG(EXCEPTION) << "Eliminating the components failed.";
+  }
+  for (auto &error : errors) {
+    if (error != nullptr) {
+      std::rethrow_exception(error);
+    }
+  }
+  return eliminations;
+}
+}  // namespace
+
+std::vector<EliminationPtr> EliminateGraph(const CostGraphPtr &graph) {
   MS_EXCEPTION_IF_NULL(graph);
   std::vector<EliminationPtr> eliminations;
   bool flag = true;
 
-  // Phase 1: Shrink the CostGraph using 6 operations, and record them in the order.
+  // Shrink the CostGraph using 6 operations, and record them in the order.
   // Note: the checking and applying of the 6 operations MUST in current order.
   while (flag) {
     flag = false;
@@ -115,19 +164,41 @@ Status GetStrategy(const CostGraphPtr &graph) {
     }
   }
 
+  return eliminations;
+}
+
+Status GetStrategy(const CostGraphPtr &graph) {
+  MS_LOG(INFO) << "Searching strategies begins.";
+  MS_EXCEPTION_IF_NULL(graph);
+
+  // Phase 1: Shrink each connected component of the CostGraph.
+  auto start = std::chrono::steady_clock::now();
+  auto components = graph->ConstructIndependentComponents();
+  auto eliminations = EliminateComponents(components);
+  auto phase1_time = ElapsedUs(start);
+
   // Phase 2: Search the cost_list in the final graph, and determine the optimal one
+  start = std::chrono::steady_clock::now();
   if (graph->SearchStrategy() != SUCCESS) {
     MS_LOG(ERROR) << "Searching strategy for the final failed.";
     return FAILED;
   }
+  auto phase2_time = ElapsedUs(start);
 
   // Phase 3: Recover the original CostGraph, the determine strategy for each operator
-  if (RecoverStrategy(eliminations) == SUCCESS) {
-    MS_LOG(INFO) << "Searching strategies ends.";
-    return SUCCESS;
-  } else {
-    MS_LOG(EXCEPTION) << "Searching strategies failed.";
+  start = std::chrono::steady_clock::now();
+  size_t elimination_num = 0;
+  for (auto &component_eliminations : eliminations) {
+    elimination_num += component_eliminations.size();
+    if (RecoverStrategy(component_eliminations) != SUCCESS) {
+      MS_LOG(EXCEPTION) << "Searching strategies failed.";
+    }
   }
+  auto phase3_time = ElapsedUs(start);
+  MS_LOG(INFO) << "Searching strategies ends. Eliminating " << components.size() << " components with "
+               << elimination_num << " eliminations costs " << phase1_time << " us, searching the final graph costs "
+               << phase2_time << " us, recovering the strategies costs " << phase3_time << " us.";
+  return SUCCESS;
 }
 
 Status RecoverStrategy(std::vector<EliminationPtr> eliminations) {
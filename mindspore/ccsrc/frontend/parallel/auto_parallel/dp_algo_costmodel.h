@@ -33,6 +33,7 @@ namespace parallel {
 //       Using for operations: Operator Elimination, Edge Elimination, Merge Elimination, and Contract Elimination,
 //       each connected component in the CostGraph can be shrunk in to the final graph: u --> v. See the
 //       interpretation of 6 operations in costmodel.h.
+//       The connected components are independent, they are shrunk in parallel.
 // Phase 2: Search the cost_list in the final graph, and determine the optimal one
 //       Create the cost_list for the final graph, and choose the optimal one: one the minimum quantity
 //       COST_MODEL_ALPHA * computation_cost + COST_MODEL_BETA * communication_cost
@@ -165,6 +166,9 @@ using StarEliminationPtr = std::shared_ptr<StarElimination>;
 // Phase 1 and Phase 2
 Status GetStrategy(const CostGraphPtr &graph);
 
+// Phase 1 on a graph, the returned eliminations are in the order of being applied
+std::vector<EliminationPtr> EliminateGraph(const CostGraphPtr &graph);
+
 // Phase 3
 Status RecoverStrategy(std::vector<EliminationPtr> eliminations);
 }  // namespace parallel
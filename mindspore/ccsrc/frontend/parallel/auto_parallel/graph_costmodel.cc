@@ -294,6 +294,42 @@ void CostGraph::DFS(const OperatorInfoPtr &current_op, std::map<OperatorInfoPtr,
 }
 
 // Create final cost list for the graph: u --> v
+std::vector<std::shared_ptr<CostGraph>> CostGraph::ConstructIndependentComponents() {
+  std::map<OperatorInfoPtr, bool> visited;
+  for (auto &op : ops_) {
+    MS_EXCEPTION_IF_NULL(op);
+    if (op->is_alive()) {
+      visited[op] = false;
+    }
+  }
+  std::map<OperatorInfoPtr, size_t> component_index;
+  std::vector<std::shared_ptr<CostGraph>> components;
+  for (auto &op : ops_) {
+    if (!op->is_alive() || visited[op]) {
+      continue;
+    }
+    auto dfs_component = std::make_shared<CostGraph>();
+    DFS(op, &visited, dfs_component);
+    for (auto &member : dfs_component->GetOperators()) {
+      component_index[member] = components.size();
+    }
+    auto new_component = std::make_shared<CostGraph>();
+    new_component->SetDeviceMemoryAndCostParameter();
+    components.push_back(new_component);
+  }
+  for (auto &op : ops_) {
+    if (!op->is_alive()) {
+      continue;
+    }
+    auto &component = components[component_index[op]];
+    component->AddOperator(op);
+    for (auto &edge : op->GetAliveSuccEdges()) {
+      component->AddEdge(op, edge->next_operator(), edge);
+    }
+  }
+  return components;
+}
+
 CostPtrList CostGraph::CreateFinalCostList(const OperatorInfoPtr &u, const std::shared_ptr<Edge> &e,
                                            const OperatorInfoPtr &v) {
   MS_EXCEPTION_IF_NULL(u);
@@ -83,6 +83,9 @@ class CostGraph {
   std::vector<std::shared_ptr<CostGraph>> ConstructConnectedComponents(std::vector<OperatorInfoPtr>);
   void DFS(const OperatorInfoPtr &current_op, std::map<OperatorInfoPtr, bool> *visited,
            const std::shared_ptr<CostGraph> &component);
+  // Split the alive operators into connected components, which keep the order of the operators in this graph. The
+  // eliminations applied to a component alone are then the same as the ones applied to it in this graph.
+  std::vector<std::shared_ptr<CostGraph>> ConstructIndependentComponents();
 
   CostPtrList CreateFinalCostList(const OperatorInfoPtr &u, const EdgePtr &e, const OperatorInfoPtr &v);
   CostPtrList CreateFinalSingleCostList(const OperatorInfoPtr &u);
@@ -18,6 +18,7 @@
 
 #include <algorithm>
 #include <random>
+#include <typeinfo>
 #include "frontend/parallel/device_matrix.h"
 #include "frontend/parallel/tensor_layout/tensor_redistribution.h"
 
@@ -79,6 +80,95 @@ double OperatorCost::GetMemoryCostForInference(const std::vector<TensorInfo> &,
   return result;
 }
 
+namespace {
+void AppendShapeToCostKey(const Shape &shape, OperatorCostKey *key) {
+  key->push_back(SizeToLong(shape.size()));
+  (void)key->insert(key->end(), shape.begin(), shape.end());
+}
+
+void AppendTensorToCostKey(const TensorInfo &tensor, OperatorCostKey *key) {
+  auto layout = tensor.tensor_layout();
+  AppendShapeToCostKey(tensor.shape(), key);
+  AppendShapeToCostKey(tensor.slice_shape(), key);
+  AppendShapeToCostKey(tensor.reduce_dim(), key);
+  AppendShapeToCostKey(layout.device_arrangement().array(), key);
+  AppendShapeToCostKey(layout.tensor_map().array(), key);
+  AppendShapeToCostKey(layout.tensor_shape().array(), key);
+}
+}  // namespace
+
+OperatorCostKey OperatorCost::GetCostKey(const std::vector<TensorInfo> &inputs, const std::vector<TensorInfo> &outputs,
+                                         int64_t stage_id) const {
+  OperatorCostKey key = {static_cast<int64_t>(typeid(*this).hash_code()), inputs_related_ ? 1 : 0, stage_id};
+  AppendAttrsToCostKey(&key);
+  key.push_back(SizeToLong(inputs.size()));
+  for (size_t i = 0; i < inputs.size(); ++i) {
+    key.push_back((i < is_parameter_.size() && is_parameter_[i]) ? 1 : 0);
+    key.push_back(i < inputs_type_lengths_.size() ? SizeToLong(inputs_type_lengths_[i]) : 0);
+    AppendTensorToCostKey(inputs[i], &key);
+  }
+  key.push_back(SizeToLong(outputs.size()));
+  for (size_t i = 0; i < outputs.size(); ++i) {
+    key.push_back(i < outputs_type_lengths_.size() ? SizeToLong(outputs_type_lengths_[i]) : 0);
+    AppendTensorToCostKey(outputs[i], &key);
+  }
+  return key;
+}
+
+OperatorCostCache &OperatorCostCache::GetInstance() {
+  static OperatorCostCache instance;
+  return instance;
+}
+
+StrategyCostValue OperatorCostCache::GetCost(const OperatorCostPtr &op_cost, const std::vector<TensorInfo> &inputs,
+                                             const std::vector<TensorInfo> &outputs, int64_t stage_id) {
+  MS_EXCEPTION_IF_NULL(op_cost);
+  auto key = op_cost->GetCostKey(inputs, outputs, stage_id);
+  StrategyCostValue value;
+  bool found = false;
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto iter = costs_.find(key);
+    if (iter != costs_.end()) {
+      ++hit_count_;
+      value = iter->second;
+      found = true;
+    }
+  }
+  if (!found) {
+    value.forward_computation_cost = op_cost->GetForwardComputationCost(inputs, outputs, stage_id);
+    value.communication_cost = op_cost->GetCommCost(inputs, outputs, stage_id);
+    value.forward_communication_cost = op_cost->GetForwardCommCost(inputs, outputs, stage_id);
+    std::lock_guard<std::mutex> lock(mutex_);
+    ++miss_count_;
+    (void)costs_.emplace(std::move(key), value);
+  }
+  value.forward_computation_cost *= op_cost->computation_scale();
+  return value;
+}
+
+void OperatorCostCache::Clear() {
+  std::lock_guard<std::mutex> lock(mutex_);
+  costs_.clear();
+  hit_count_ = 0;
+  miss_count_ = 0;
+}
+
+size_t OperatorCostCache::size() {
+  std::lock_guard<std::mutex> lock(mutex_);
+  return costs_.size();
+}
+
+size_t OperatorCostCache::hit_count() {
+  std::lock_guard<std::mutex> lock(mutex_);
+  return hit_count_;
+}
+
+size_t OperatorCostCache::miss_count() {
+  std::lock_guard<std::mutex> lock(mutex_);
+  return miss_count_;
+}
+
 // return the per device communication cost in the forward phase.
 double MatMulCost::GetForwardCommCost(const std::vector<TensorInfo> &inputs, const std::vector<TensorInfo> &outputs,
                                       int64_t) const {
@@ -17,7 +17,9 @@
 #ifndef PARALLEL_AUTO_PARALLEL_OPERATOR_COSTMODEL_H_
 #define PARALLEL_AUTO_PARALLEL_OPERATOR_COSTMODEL_H_
 
+#include <map>
 #include <memory>
+#include <mutex>
 #include <vector>
 #include "frontend/parallel/device_manager.h"
 #include "frontend/parallel/tensor_layout/tensor_info.h"
@@ -34,6 +36,7 @@ namespace parallel {
 
 class OperatorCost;
 using OperatorCostPtr = std::shared_ptr<OperatorCost>;
+using OperatorCostKey = std::vector<int64_t>;
 
 template <typename T>
 double ListProduct(std::vector<T> vec) {
@@ -95,8 +98,18 @@ class OperatorCost {
   virtual double GetMemoryCost(const std::vector<TensorInfo> &inputs, const std::vector<TensorInfo> &outputs) const;
   // per device memory cost in a inference phase
   double GetMemoryCostForInference(const std::vector<TensorInfo> &, const std::vector<TensorInfo> &) const;
+  // The communication and computation costs are the same under equal keys, which cover the type of this cost, the
+  // attributes the costs depend on, and the shapes and layouts of the tensors (and so the strategy).
+  OperatorCostKey GetCostKey(const std::vector<TensorInfo> &inputs, const std::vector<TensorInfo> &outputs,
+                             int64_t stage_id) const;
+  // The factor fitted by the cost model calibration for the computation costs of this operator, which are bytes
+  // weighted by the time per byte of this operator type relative to the other types. 1.0 if not calibrated.
+  void set_computation_scale(double scale) { computation_scale_ = scale; }
+  double computation_scale() const { return computation_scale_; }
 
  protected:
+  // append the attributes of a derived cost which its communication and computation costs depend on
+  virtual void AppendAttrsToCostKey(OperatorCostKey *) const {}
   // For each input in 'inputs_', a bool variable is true if the corresponding one is a parameter or a output of
   // pre-operator that has parameters as input.
   std::vector<bool> is_parameter_involve_;
@@ -112,6 +125,7 @@ class OperatorCost {
   // Whether the output is critical, which means that this output is included in calculating peak memory cost
   // in the inference phase.
   int64_t is_outputs_critical_ = -1;
+  double computation_scale_ = 1.0;
 };
 
 using OperatorCostPtr = std::shared_ptr<OperatorCost>;
@@ -502,6 +516,7 @@ class ReduceMethodCost : public OperatorCost {
   void set_cross_batch(bool cb) { cross_batch_ = cb; }
 
  protected:
+  void AppendAttrsToCostKey(OperatorCostKey *key) const override { key->push_back(cross_batch_ ? 1 : 0); }
   bool cross_batch_ = false;
 };
 using ReduceMethodCostPtr = std::shared_ptr<ReduceMethodCost>;
@@ -770,11 +785,45 @@ class GatherV2PCost : public OperatorCost {
   void set_strategy(const Shape &strategy) { strategy_ = strategy; }
 
  protected:
+  void AppendAttrsToCostKey(OperatorCostKey *key) const override {
+    key->push_back(axis_);
+    key->push_back(SizeToLong(strategy_.size()));
+    (void)key->insert(key->end(), strategy_.begin(), strategy_.end());
+  }
   int64_t axis_;
   Shape strategy_;
 };
 
 using GatherV2PCostPtr = std::shared_ptr<GatherV2PCost>;
+
+// The costs used by the strategy-cost of an operator.
+struct StrategyCostValue {
+  double forward_computation_cost = 0.0;
+  double communication_cost = 0.0;
+  double forward_communication_cost = 0.0;
+};
+
+// The operators of the same type and shapes share the costs under the same strategy, e.g. the layers of a network, so
+// the costs are computed once for each cost key while searching the strategies of a graph. The cached computation
+// costs are not calibrated, the computation scale of the operator is applied on each lookup.
+class OperatorCostCache {
+ public:
+  static OperatorCostCache &GetInstance();
+  StrategyCostValue GetCost(const OperatorCostPtr &op_cost, const std::vector<TensorInfo> &inputs,
+                            const std::vector<TensorInfo> &outputs, int64_t stage_id);
+  // The costs depend on the devices and the cost model parameters, the cache is cleared for each graph.
+  void Clear();
+  size_t size();
+  size_t hit_count();
+  size_t miss_count();
+
+ private:
+  OperatorCostCache() = default;
+  std::mutex mutex_;
+  std::map<OperatorCostKey, StrategyCostValue> costs_;
+  size_t hit_count_ = 0;
+  size_t miss_count_ = 0;
+};
 }  // namespace parallel
 }  // namespace mindspore
 #endif  // PARALLEL_AUTO_PARALLEL_OPERATOR_COSTMODEL_H_
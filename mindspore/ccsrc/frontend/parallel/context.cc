@@ -62,6 +62,7 @@ void ParallelContext::Reset() {
   enable_parallel_optimizer_ = false;
   all_reduce_fusion_split_indices_.clear();
   all_reduce_fusion_split_sizes_.clear();
+  all_reduce_fusion_profile_steps_ = 0;
   strategy_search_mode_ = DYNAMIC_PROGRAMMING;
   pipeline_stage_split_num_ = 1;
 }
@@ -94,6 +94,11 @@ class ParallelContext {
     enable_all_reduce_fusion_ = enable_all_reduce_fusion;
   }
   bool enable_all_reduce_fusion() const { return enable_all_reduce_fusion_; }
+  // the steps profiling the backward time to split the fused allreduce, 0 means the fusion is not profiled
+  void set_all_reduce_fusion_profile_steps(int64_t all_reduce_fusion_profile_steps) {
+    all_reduce_fusion_profile_steps_ = all_reduce_fusion_profile_steps;
+  }
+  int64_t all_reduce_fusion_profile_steps() const { return all_reduce_fusion_profile_steps_; }
 
   void set_strategy_ckpt_load_file(const std::string &strategy_ckpt_load_file);
   std::string strategy_ckpt_load_file() const { return strategy_ckpt_load_file_; }
@@ -126,6 +131,7 @@ class ParallelContext {
   bool enable_all_reduce_fusion_;
   std::map<std::string, std::vector<uint32_t>> all_reduce_fusion_split_indices_;
   std::map<std::string, std::vector<uint32_t>> all_reduce_fusion_split_sizes_;
+  int64_t all_reduce_fusion_profile_steps_;
   std::string strategy_ckpt_load_file_;
   std::string strategy_ckpt_save_file_;
   bool enable_parallel_optimizer_;
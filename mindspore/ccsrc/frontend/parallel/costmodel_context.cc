@@ -16,9 +16,14 @@
 
 #include "frontend/parallel/costmodel_context.h"
 
+#include <algorithm>
+#include <fstream>
+#include <iterator>
 #include <memory>
+#include <vector>
 
 #include "frontend/parallel/allreduce_fusion/allreduce_fusion.h"
+#include "nlohmann/json.hpp"
 #include "utils/ms_context.h"
 
 namespace mindspore {
@@ -43,6 +48,10 @@ void CostModelContext::ResetCostModel() {
   costmodel_alpha_ = DEFAULT_COST_MODEL_ALPHA;
   costmodel_beta_ = DEFAULT_COST_MODEL_BETA_ASCEND;
   costmodel_gamma_ = DEFAULT_COST_MODEL_GAMMA;
+  costmodel_calibration_file_.clear();
+  computation_scales_.clear();
+  uncalibrated_beta_ = costmodel_beta_;
+  beta_calibrated_ = false;
   costmodel_communi_threshold_ = DEFAULT_COST_MODEL_COMMUNI_THRESHOLD;
   costmodel_communi_const_ = DEFAULT_COST_MODEL_COMMUNI_CONST;
   costmodel_communi_bias_ = DEFAULT_COST_MODEL_COMMUNI_BIAS;
@@ -72,7 +81,7 @@ void CostModelContext::ResetAlgoParameters() {
 
 void CostModelContext::set_costmodel_context_for_device(const std::string &device_target) {
   if (device_target == kGPUDevice) {
-    costmodel_beta_ = DEFAULT_COST_MODEL_BETA_GPU;
+    set_costmodel_beta(DEFAULT_COST_MODEL_BETA_GPU);
   }
 }
 
@@ -84,10 +93,84 @@ void CostModelContext::set_device_memory_capacity(double dm_capacity) { device_m
 
 void CostModelContext::set_costmodel_alpha(double cm_alpha) { costmodel_alpha_ = cm_alpha; }
 
-void CostModelContext::set_costmodel_beta(double cm_beta) { costmodel_beta_ = cm_beta; }
+void CostModelContext::set_costmodel_beta(double cm_beta) {
+  costmodel_beta_ = cm_beta;
+  // a beta set explicitly is kept when the calibration is cleared
+  beta_calibrated_ = false;
+}
 
 void CostModelContext::set_costmodel_gamma(double cm_gamma) { costmodel_gamma_ = cm_gamma; }
 
+void CostModelContext::set_costmodel_calibration_file(const std::string &calibration_file) {
+  if (calibration_file.empty()) {
+    ClearCalibration();
+    return;
+  }
+  std::ifstream json_file(calibration_file);
+  if (!json_file.is_open()) {
+    MS_LOG(EXCEPTION) << "Open the cost model calibration file " << calibration_file << " failed.";
+  }
+  nlohmann::json calibration;
+  try {
+    json_file >> calibration;
+  } catch (nlohmann::json::parse_error &e) {
+    MS_LOG(EXCEPTION) << "Parse the cost model calibration file " << calibration_file << " failed, error: " << e.what();
+  }
+  auto computation = calibration.find("computation");
+  if (computation == calibration.end() || !computation->is_object() || computation->empty()) {
+    MS_LOG(EXCEPTION) << "The cost model calibration file " << calibration_file
+                      << " has no coefficient of the computation costs.";
+  }
+  std::map<std::string, double> coefficients;
+  for (auto iter = computation->begin(); iter != computation->end(); ++iter) {
+    if (!iter.value().is_number() || iter.value().get<double>() <= 0) {
+      MS_LOG(EXCEPTION) << "The computation coefficient of " << iter.key() << " in the cost model calibration file "
+                        << calibration_file << " should be a positive number, but got " << iter.value();
+    }
+    coefficients[iter.key()] = iter.value().get<double>();
+  }
+  // the computation costs of the calibrated operators keep the magnitude of the uncalibrated ones
+  std::vector<double> sorted_coefficients;
+  (void)std::transform(coefficients.begin(), coefficients.end(), std::back_inserter(sorted_coefficients),
+                       [](const std::pair<const std::string, double> &item) { return item.second; });
+  std::sort(sorted_coefficients.begin(), sorted_coefficients.end());
+  double reference = sorted_coefficients[sorted_coefficients.size() / 2];
+
+  auto communication = calibration.find("communication");
+  if (communication != calibration.end() && (!communication->is_number() || communication->get<double>() <= 0)) {
+    MS_LOG(EXCEPTION) << "The communication coefficient in the cost model calibration file " << calibration_file
+                      << " should be a positive number, but got " << *communication;
+  }
+  // nothing calibrated by the file loaded before is kept
+  ClearCalibration();
+  if (communication != calibration.end()) {
+    uncalibrated_beta_ = costmodel_beta_;
+    costmodel_beta_ = costmodel_alpha_ * communication->get<double>() / reference;
+    beta_calibrated_ = true;
+  }
+  for (auto &coefficient : coefficients) {
+    computation_scales_[coefficient.first] = coefficient.second / reference;
+    MS_LOG(INFO) << "The computation scale of " << coefficient.first << " is " << coefficient.second / reference;
+  }
+  costmodel_calibration_file_ = calibration_file;
+  MS_LOG(INFO) << "Loaded the cost model calibration file " << calibration_file << ", costmodel_beta is "
+               << costmodel_beta_;
+}
+
+void CostModelContext::ClearCalibration() {
+  if (beta_calibrated_) {
+    costmodel_beta_ = uncalibrated_beta_;
+    beta_calibrated_ = false;
+  }
+  costmodel_calibration_file_.clear();
+  computation_scales_.clear();
+}
+
+double CostModelContext::computation_scale(const std::string &op_type) const {
+  auto iter = computation_scales_.find(op_type);
+  return iter == computation_scales_.end() ? 1.0 : iter->second;
+}
+
 void CostModelContext::set_costmodel_simplify_cal(bool cm_simplify) { costmodel_simplify_cal_ = cm_simplify; }
 
 void CostModelContext::set_costmodel_communi_threshold(double cm_communi_th) {
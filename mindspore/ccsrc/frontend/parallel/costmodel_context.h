@@ -17,6 +17,7 @@
 #ifndef MINDSPORE_CCSRC_FRONTEND_PARALLEL_COSTMODEL_CONTEXT_H_
 #define MINDSPORE_CCSRC_FRONTEND_PARALLEL_COSTMODEL_CONTEXT_H_
 
+#include <map>
 #include <memory>
 #include <string>
 #include <vector>
@@ -76,6 +77,15 @@ class CostModelContext {
   void set_costmodel_gamma(double);
   double costmodel_gamma() const { return costmodel_gamma_; }
 
+  // COST_MODEL_CALIBRATION_FILE
+  // The file records the fitted time per byte of the computation costs of each operator type and of the
+  // communication costs, as {"computation": {"MatMul": 2.1e-4, ...}, "communication": 1.5e-3}. Loading it sets the
+  // computation scales of the operator types, relative to the median of their coefficients, and 'costmodel_beta'.
+  void set_costmodel_calibration_file(const std::string &);
+  std::string costmodel_calibration_file() const { return costmodel_calibration_file_; }
+  // 1.0 if the operator type is not in the calibration file
+  double computation_scale(const std::string &op_type) const;
+
   // COST_MODEL_SIMPLIFY_CALCULATION
   void set_costmodel_simplify_cal(bool);
   bool costmodel_simplify_cal() const { return costmodel_simplify_cal_; }
@@ -155,6 +165,8 @@ class CostModelContext {
 
  private:
   CostModelContext();
+  // restore the costs set by the calibration file to the uncalibrated ones
+  void ClearCalibration();
   static std::shared_ptr<CostModelContext> cm_context_inst_;
 
   // DEVICE_MEMORY_CAPACITY
@@ -169,6 +181,13 @@ class CostModelContext {
   // COST_MODEL_GAMMA
   double costmodel_gamma_;
 
+  // COST_MODEL_CALIBRATION_FILE
+  std::string costmodel_calibration_file_;
+  std::map<std::string, double> computation_scales_;
+  // the beta before the calibration file set it, restored when the calibration is cleared
+  double uncalibrated_beta_;
+  bool beta_calibrated_;
+
   // COST_MODEL_SIMPLIFY_CALCULATION
   bool costmodel_simplify_cal_;
 
@@ -625,12 +625,11 @@ Status MatMulBase::SetCostUnderStrategy(const mindspore::parallel::StrategyPtr &
   int64_t stage_id = strategy->GetInputStage();
   // Here, we use the origin outputs_, because we only use the slice size of the output tensor.
   // It does not matter whether the output tensor is transposed or not.
-  double computation_cost =
-    operator_cost()->GetForwardComputationCost(relica_inputs_tensor_vector, outputs_tensor_info_, stage_id);
-  double communication_cost = operator_cost()->GetCommCost(relica_inputs_tensor_vector, outputs_tensor_info_, stage_id);
-  std::shared_ptr<Cost> result = std::make_shared<Cost>(computation_cost, communication_cost);
-  result->communication_without_parameter_ =
-    operator_cost()->GetForwardCommCost(relica_inputs_tensor_vector, outputs_tensor_info_, stage_id);
+  auto costs = OperatorCostCache::GetInstance().GetCost(operator_cost(), relica_inputs_tensor_vector,
+                                                        outputs_tensor_info_, stage_id);
+  double communication_cost = costs.communication_cost;
+  std::shared_ptr<Cost> result = std::make_shared<Cost>(costs.forward_computation_cost, communication_cost);
+  result->communication_without_parameter_ = costs.forward_communication_cost;
   result->communication_with_partial_para_ =
     result->communication_without_parameter_ +
     COST_MODEL_GAMMA * (communication_cost - result->communication_without_parameter_);
@@ -1091,12 +1091,11 @@ Status OperatorInfo::SetCostUnderStrategyBase(const StrategyPtr &strategy) {
     return FAILED;
   }
   int64_t stage_id = strategy->GetInputStage();
-  double computation_cost =
-    operator_cost()->GetForwardComputationCost(inputs_tensor_info_, outputs_tensor_info_, stage_id);
-  double communication_cost = operator_cost()->GetCommCost(inputs_tensor_info_, outputs_tensor_info_, stage_id);
-  std::shared_ptr<Cost> result = std::make_shared<Cost>(computation_cost, communication_cost);
-  result->communication_without_parameter_ =
-    operator_cost()->GetForwardCommCost(inputs_tensor_info_, outputs_tensor_info_, stage_id);
+  auto costs =
+    OperatorCostCache::GetInstance().GetCost(operator_cost(), inputs_tensor_info_, outputs_tensor_info_, stage_id);
+  double communication_cost = costs.communication_cost;
+  std::shared_ptr<Cost> result = std::make_shared<Cost>(costs.forward_computation_cost, communication_cost);
+  result->communication_without_parameter_ = costs.forward_communication_cost;
   result->communication_with_partial_para_ =
     result->communication_without_parameter_ +
     COST_MODEL_GAMMA * (communication_cost - result->communication_without_parameter_);
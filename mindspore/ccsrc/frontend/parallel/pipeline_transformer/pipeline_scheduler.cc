@@ -0,0 +1,314 @@
+/**
+ * Copyright 2020 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "frontend/parallel/pipeline_transformer/pipeline_scheduler.h"
+
+#include <algorithm>
+#include <set>
+#include <sstream>
+#include <unordered_map>
+#include <unordered_set>
+#include <utility>
+#include "base/core_ops.h"
+#include "frontend/optimizer/ad/gradients_scope.h"
+#include "frontend/parallel/ops_info/ops_utils.h"
+#include "ir/graph_utils.h"
+#include "ir/manager.h"
+#include "utils/convert_utils_base.h"
+#include "utils/log_adapter.h"
+
+namespace mindspore {
+namespace parallel {
+namespace {
+// the forward or backward of a micro batch, which starts from the entries and finishes at the exits
+struct MicroBatchSegment {
+  std::vector<CNodePtr> nodes;
+  std::vector<CNodePtr> entries;
+  std::vector<AnfNodePtr> exits;
+};
+
+void FindEntriesAndExits(const FuncGraphManagerPtr &manager, MicroBatchSegment *segment) {
+  std::unordered_set<AnfNodePtr> node_set(segment->nodes.begin(), segment->nodes.end());
+  auto &node_users = manager->node_users();
+  for (auto &node : segment->nodes) {
+    auto &inputs = node->inputs();
+    if (std::none_of(inputs.begin() + 1, inputs.end(),
+                     [&node_set](const AnfNodePtr &input) { return node_set.count(input) > 0; })) {
+      segment->entries.push_back(node);
+    }
+    auto &users = node_users[node];
+    if (std::none_of(users.begin(), users.end(), [&node_set](const std::pair<AnfNodePtr, int> &user) {
+          return node_set.count(user.first) > 0;
+        })) {
+      segment->exits.push_back(node);
+    }
+  }
+}
+
+// the entries of the next segment wait for the exits of the previous one
+void WaitForSegment(const FuncGraphManagerPtr &manager, const MicroBatchSegment &prev, const MicroBatchSegment &next) {
+  auto graph = next.nodes.front()->func_graph();
+  AnfNodePtr exits = prev.exits.front();
+  if (prev.exits.size() > 1) {
+    std::vector<AnfNodePtr> make_tuple_inputs{NewValueNode(prim::kPrimMakeTuple)};
+    AbstractBasePtrList exits_abs;
+    for (auto &exit : prev.exits) {
+      make_tuple_inputs.push_back(exit);
+      exits_abs.push_back(exit->abstract());
+    }
+    exits = graph->NewCNode(make_tuple_inputs);
+    exits->set_abstract(std::make_shared<abstract::AbstractTuple>(exits_abs));
+  }
+  for (auto &entry : next.entries) {
+    if (entry->size() < 2) {
+      continue;
+    }
+    auto input = entry->input(1);
+    auto depend = graph->NewCNode({NewValueNode(prim::kPrimDepend), input, exits});
+    depend->set_abstract(input->abstract());
+    depend->set_scope(entry->scope());
+    manager->SetEdge(entry, 1, depend);
+  }
+}
+}  // namespace
+
+Status PipelineScheduler::Init() const {
+  if (stage_num_ <= 0 || micro_num_ <= 0 || chunk_num_ <= 0) {
+    MS_LOG(ERROR) << "Invalid pipeline schedule of " << stage_num_ << " stages, " << micro_num_ << " micro batches and "
+                  << chunk_num_ << " chunks";
+    return FAILED;
+  }
+  // the interleaved schedule runs the micro batches of a chunk in the groups of stage_num
+  if (chunk_num_ > 1 && micro_num_ % stage_num_ != 0) {
+    MS_LOG(ERROR) << "The micro batch num " << micro_num_ << " must be divisible by the stage num " << stage_num_
+                  << " when the stages are split into " << chunk_num_ << " chunks";
+    return FAILED;
+  }
+  return SUCCESS;
+}
+
+// The index-th forward or backward of a stage. The forward runs stage_num micro batches on a chunk before the next
+// chunk, while the backward runs the chunks in the reverse order.
+PipelineOp PipelineScheduler::GetOp(PipelineOpType type, int64_t index) const {
+  int64_t chunk = (index / stage_num_) % chunk_num_;
+  if (type == PIPELINE_BACKWARD) {
+    chunk = chunk_num_ - 1 - chunk;
+  }
+  int64_t micro = (index / (stage_num_ * chunk_num_)) * stage_num_ + index % stage_num_;
+  return {type, micro, chunk};
+}
+
+std::vector<PipelineOp> PipelineScheduler::Schedule(int64_t stage, PipelineScheduleType type) const {
+  std::vector<PipelineOp> ops;
+  int64_t op_num = micro_num_ * chunk_num_;
+  if (type == PIPELINE_GPIPE) {
+    for (int64_t i = 0; i < op_num; ++i) {
+      ops.push_back(GetOp(PIPELINE_FORWARD, i));
+    }
+    for (int64_t i = 0; i < op_num; ++i) {
+      ops.push_back(GetOp(PIPELINE_BACKWARD, i));
+    }
+    return ops;
+  }
+  // the earlier stages run more forward before the first backward comes back from the last stage
+  int64_t warmup = stage_num_ - stage - 1;
+  if (chunk_num_ > 1) {
+    warmup = warmup * 2 + (chunk_num_ - 1) * stage_num_;
+  }
+  warmup = std::min(warmup, op_num);
+  for (int64_t i = 0; i < warmup; ++i) {
+    ops.push_back(GetOp(PIPELINE_FORWARD, i));
+  }
+  for (int64_t i = 0; i < op_num - warmup; ++i) {
+    ops.push_back(GetOp(PIPELINE_FORWARD, warmup + i));
+    ops.push_back(GetOp(PIPELINE_BACKWARD, i));
+  }
+  for (int64_t i = op_num - warmup; i < op_num; ++i) {
+    ops.push_back(GetOp(PIPELINE_BACKWARD, i));
+  }
+  return ops;
+}
+
+Status PipelineScheduler::Simulate(PipelineScheduleType type, const PipelineCost &cost, PipelineReport *report) const {
+  MS_EXCEPTION_IF_NULL(report);
+  if (Init() != SUCCESS) {
+    return FAILED;
+  }
+  int64_t virtual_stage_num = stage_num_ * chunk_num_;
+  size_t end_num = LongToSize(micro_num_ * virtual_stage_num);
+  // the end time of the forward and backward of each micro batch on each virtual stage, or -1 if not run yet
+  std::vector<double> forward_end(end_num, -1.0);
+  std::vector<double> backward_end(end_num, -1.0);
+  auto end_index = [virtual_stage_num](int64_t micro, int64_t virtual_stage) {
+    return LongToSize(micro * virtual_stage_num + virtual_stage);
+  };
+
+  std::vector<std::vector<PipelineOp>> schedules;
+  for (int64_t stage = 0; stage < stage_num_; ++stage) {
+    schedules.push_back(Schedule(stage, type));
+  }
+  std::vector<size_t> next_op(LongToSize(stage_num_), 0);
+  std::vector<double> idle_time(LongToSize(stage_num_), 0.0);
+  std::vector<double> live_activation(LongToSize(stage_num_), 0.0);
+  report->stages.assign(LongToSize(stage_num_), PipelineStageReport());
+  double chunk_activation = cost.activation_size / chunk_num_;
+
+  bool progress = true;
+  while (progress) {
+    progress = false;
+    for (int64_t stage = 0; stage < stage_num_; ++stage) {
+      auto &stage_report = report->stages[LongToSize(stage)];
+      auto &ops = schedules[LongToSize(stage)];
+      auto &next = next_op[LongToSize(stage)];
+      for (; next < ops.size(); ++next) {
+        auto &op = ops[next];
+        int64_t virtual_stage = op.chunk * stage_num_ + stage;
+        double ready_time = 0.0;
+        if (op.type == PIPELINE_FORWARD && virtual_stage > 0) {
+          ready_time = forward_end[end_index(op.micro, virtual_stage - 1)];
+        } else if (op.type == PIPELINE_BACKWARD) {
+          // the last virtual stage starts the backward from its own forward
+          bool last = virtual_stage == virtual_stage_num - 1;
+          ready_time = last ? forward_end[end_index(op.micro, virtual_stage)]
+                            : backward_end[end_index(op.micro, virtual_stage + 1)];
+        }
+        if (ready_time < 0) {
+          break;
+        }
+        bool from_other_stage = op.type == PIPELINE_FORWARD ? virtual_stage > 0 : virtual_stage < virtual_stage_num - 1;
+        if (from_other_stage && stage_num_ > 1) {
+          ready_time += cost.p2p_time;
+        }
+        double start = std::max(idle_time[LongToSize(stage)], ready_time);
+        double duration = (op.type == PIPELINE_FORWARD ? cost.forward_time : cost.backward_time) / chunk_num_;
+        double end = start + duration;
+        idle_time[LongToSize(stage)] = end;
+        stage_report.busy_time += duration;
+        auto &live = live_activation[LongToSize(stage)];
+        // the activations of the forward are kept until its backward ends
+        if (op.type == PIPELINE_FORWARD) {
+          forward_end[end_index(op.micro, virtual_stage)] = end;
+          live += chunk_activation;
+          stage_report.peak_activation_size = std::max(stage_report.peak_activation_size, live);
+        } else {
+          backward_end[end_index(op.micro, virtual_stage)] = end;
+          live -= chunk_activation;
+        }
+        progress = true;
+      }
+    }
+  }
+  for (int64_t stage = 0; stage < stage_num_; ++stage) {
+    if (next_op[LongToSize(stage)] != schedules[LongToSize(stage)].size()) {
+      MS_LOG(ERROR) << "The pipeline schedule of stage " << stage << " is blocked at the op "
+                    << next_op[LongToSize(stage)] << ": " << ToString(schedules[LongToSize(stage)]);
+      return FAILED;
+    }
+  }
+
+  report->total_time = *std::max_element(idle_time.begin(), idle_time.end());
+  report->bubble_fraction = 0.0;
+  for (auto &stage_report : report->stages) {
+    stage_report.bubble_fraction = report->total_time > 0 ? 1.0 - stage_report.busy_time / report->total_time : 0.0;
+    report->bubble_fraction += stage_report.bubble_fraction / stage_num_;
+  }
+  return SUCCESS;
+}
+
+std::string PipelineScheduler::ToString(const std::vector<PipelineOp> &ops) {
+  std::ostringstream buffer;
+  for (size_t i = 0; i < ops.size(); ++i) {
+    buffer << (i == 0 ? "" : " ") << (ops[i].type == PIPELINE_FORWARD ? "F" : "B") << ops[i].micro;
+    if (ops[i].chunk > 0) {
+      buffer << "." << ops[i].chunk;
+    }
+  }
+  return buffer.str();
+}
+
+bool EnforceMicroBatchSchedule(const FuncGraphPtr &graph, int64_t stage, int64_t stage_num) {
+  MS_EXCEPTION_IF_NULL(graph);
+  auto manager = graph->manager();
+  MS_EXCEPTION_IF_NULL(manager);
+  // the micro batches each node depends on
+  std::unordered_map<AnfNodePtr, std::set<int64_t>> node_micros;
+  std::set<int64_t> micro_set;
+  auto nodes = TopoSort(graph->get_return());
+  for (auto &node : nodes) {
+    auto cnode = node->cast<CNodePtr>();
+    if (cnode == nullptr || cnode->func_graph() != graph) {
+      continue;
+    }
+    auto &micros = node_micros[node];
+    auto prim = GetValueNode<PrimitivePtr>(cnode->input(0));
+    if (prim != nullptr && prim->HasAttr(MICRO)) {
+      auto micro = GetValue<int64_t>(prim->GetAttr(MICRO));
+      micros.insert(micro);
+      micro_set.insert(micro);
+      continue;
+    }
+    for (auto &input : cnode->inputs()) {
+      auto iter = node_micros.find(input);
+      if (iter != node_micros.end()) {
+        micros.insert(iter->second.begin(), iter->second.end());
+      }
+    }
+  }
+  if (micro_set.size() <= 1) {
+    return false;
+  }
+  int64_t micro_num = SizeToLong(micro_set.size());
+  if (*micro_set.begin() != 0 || *micro_set.rbegin() != micro_num - 1) {
+    MS_LOG(EXCEPTION) << "The micro batches should be numbered from 0 to " << micro_num - 1 << ", but got "
+                      << *micro_set.begin() << " to " << *micro_set.rbegin();
+  }
+
+  // the forward of micro batch m is the segment m, and the backward is the segment micro_num + m
+  std::vector<MicroBatchSegment> segments(LongToSize(2 * micro_num));
+  auto segment_index = [micro_num](PipelineOpType type, int64_t micro) {
+    return LongToSize(type == PIPELINE_FORWARD ? micro : micro_num + micro);
+  };
+  for (auto &node : nodes) {
+    auto iter = node_micros.find(node);
+    if (iter == node_micros.end() || iter->second.size() != 1) {
+      continue;
+    }
+    auto type = ad::IsInGradientsScope(node) ? PIPELINE_BACKWARD : PIPELINE_FORWARD;
+    segments[segment_index(type, *iter->second.begin())].nodes.push_back(node->cast<CNodePtr>());
+  }
+  for (auto &segment : segments) {
+    if (segment.nodes.empty()) {
+      MS_LOG(INFO) << "The forward or backward of some micro batch is not found, the schedule is not enforced";
+      return false;
+    }
+    FindEntriesAndExits(manager, &segment);
+  }
+
+  PipelineScheduler scheduler(stage_num, micro_num);
+  if (scheduler.Init() != SUCCESS || stage < 0 || stage >= stage_num) {
+    MS_LOG(EXCEPTION) << "Invalid pipeline schedule of stage " << stage << " in " << stage_num << " stages";
+  }
+  auto ops = scheduler.Schedule(stage, PIPELINE_1F1B);
+  for (size_t i = 1; i < ops.size(); ++i) {
+    WaitForSegment(manager, segments[segment_index(ops[i - 1].type, ops[i - 1].micro)],
+                   segments[segment_index(ops[i].type, ops[i].micro)]);
+  }
+  MS_LOG(INFO) << "Stage " << stage << " runs the " << micro_num
+               << " micro batches in the order: " << PipelineScheduler::ToString(ops);
+  return true;
+}
+}  // namespace parallel
+}  // namespace mindspore
@@ -0,0 +1,101 @@
+/**
+ * Copyright 2020 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef MINDSPORE_CCSRC_FRONTEND_PARALLEL_PIPELINE_TRANSFORMER_PIPELINE_SCHEDULER_H_
+#define MINDSPORE_CCSRC_FRONTEND_PARALLEL_PIPELINE_TRANSFORMER_PIPELINE_SCHEDULER_H_
+
+#include <string>
+#include <vector>
+#include "ir/func_graph.h"
+#include "frontend/parallel/status.h"
+
+namespace mindspore {
+namespace parallel {
+enum PipelineScheduleType {
+  // all the forward of the micro batches, then all the backward
+  PIPELINE_GPIPE = 0,
+  // one forward one backward after the warmup forward
+  PIPELINE_1F1B,
+};
+
+enum PipelineOpType {
+  PIPELINE_FORWARD = 0,
+  PIPELINE_BACKWARD,
+};
+
+// a forward or backward of a micro batch on a chunk of the layers of a stage
+struct PipelineOp {
+  PipelineOpType type;
+  int64_t micro;
+  int64_t chunk;
+  bool operator==(const PipelineOp &other) const {
+    return type == other.type && micro == other.micro && chunk == other.chunk;
+  }
+};
+
+// the time of the forward and backward of a micro batch on all the layers of a stage, the time of the send/receive
+// between the stages, and the size of the activations of a micro batch on all the layers of a stage
+struct PipelineCost {
+  double forward_time = 1.0;
+  double backward_time = 2.0;
+  double p2p_time = 0.0;
+  double activation_size = 1.0;
+};
+
+struct PipelineStageReport {
+  double busy_time = 0.0;
+  double bubble_fraction = 0.0;
+  double peak_activation_size = 0.0;
+};
+
+struct PipelineReport {
+  double total_time = 0.0;
+  double bubble_fraction = 0.0;
+  std::vector<PipelineStageReport> stages;
+};
+
+// Schedule the micro batches of the stages. With chunk_num > 1, the layers of each stage are split into the chunks,
+// and chunk c of stage s is the virtual stage c * stage_num + s, as the interleaved schedule.
+class PipelineScheduler {
+ public:
+  PipelineScheduler(int64_t stage_num, int64_t micro_num, int64_t chunk_num = 1)
+      : stage_num_(stage_num), micro_num_(micro_num), chunk_num_(chunk_num) {}
+  ~PipelineScheduler() = default;
+  Status Init() const;
+  // the ops executed by the stage in order
+  std::vector<PipelineOp> Schedule(int64_t stage, PipelineScheduleType type) const;
+  // simulate the schedules of all the stages, where an op starts when its stage is idle and the op it depends on
+  // finishes and is sent to the stage
+  Status Simulate(PipelineScheduleType type, const PipelineCost &cost, PipelineReport *report) const;
+  static std::string ToString(const std::vector<PipelineOp> &ops);
+
+ private:
+  PipelineOp GetOp(PipelineOpType type, int64_t index) const;
+
+  int64_t stage_num_;
+  int64_t micro_num_;
+  int64_t chunk_num_;
+};
+
+// Enforce the one forward one backward schedule of the micro batches on the graph of the stage after automatic
+// differentiation. The nodes of a micro batch only depend on the slices of the inputs marked by its micro attr, and
+// they are the backward of the micro batch if they are in the scope of the gradients. Depend edges make each forward
+// or backward of the schedule wait for the previous one. Return false if the graph is not split into micro batches.
+bool EnforceMicroBatchSchedule(const FuncGraphPtr &graph, int64_t stage, int64_t stage_num);
+}  // namespace parallel
+}  // namespace mindspore
+
+#endif  // MINDSPORE_CCSRC_FRONTEND_PARALLEL_PIPELINE_TRANSFORMER_PIPELINE_SCHEDULER_H_
@@ -22,6 +22,7 @@
 #include <algorithm>
 #include <memory>
 #include "frontend/parallel/pipeline_transformer/pipeline_transformer.h"
+#include "frontend/parallel/pipeline_transformer/pipeline_scheduler.h"
 #include "frontend/parallel/auto_parallel/graph_costmodel.h"
 #include "frontend/parallel/ops_info/ops_utils.h"
 #include "frontend/parallel/group_manager.h"
@@ -562,5 +563,57 @@ void PipelineTransformer::ElimParameter() {
   root_->set_hyper_param_count(root_->hyper_param_count() - del_num);
   manager_->SetParameters(root_, parameter_list);
 }
+
+// The micro batches split by PipelineCell are marked by the micro attr of the slices of the inputs. Report the one
+// forward one backward schedule of the stage, where the stages overlap on different micro batches, and a stage keeps
+// the activations of at most stage_num - stage micro batches. The schedule is enforced by EnforceMicroBatchSchedule
+// after automatic differentiation.
+void PipelineTransformer::ScheduleMicroBatches() {
+  std::set<int64_t> micro_set;
+  for (auto &node : manager_->all_nodes()) {
+    auto cnode = node->cast<CNodePtr>();
+    if (cnode == nullptr) {
+      continue;
+    }
+    auto prim = GetValueNode<PrimitivePtr>(cnode->input(0));
+    if (prim == nullptr || !prim->HasAttr(MICRO)) {
+      continue;
+    }
+    micro_set.insert(GetValue<int64_t>(prim->GetAttr(MICRO)));
+  }
+  if (micro_set.size() <= 1) {
+    return;
+  }
+  // The receives of a stage take no inputs of the micro batch. They wait for the first input of their graph, which is
+  // the slice of the micro batch once the graph is inlined for each micro batch.
+  for (auto &node : manager_->all_nodes()) {
+    auto cnode = node->cast<CNodePtr>();
+    if (!IsPrimitiveCNode(cnode, prim::kPrimReceive) || cnode->func_graph() == root_ ||
+        cnode->func_graph()->parameters().empty()) {
+      continue;
+    }
+    auto input = cnode->input(1);
+    auto depend = cnode->func_graph()->NewCNode(
+      {NewValueNode(prim::kPrimDepend), input, cnode->func_graph()->parameters().front()});
+    depend->set_abstract(input->abstract());
+    manager_->SetEdge(cnode, 1, depend);
+  }
+  MS_EXCEPTION_IF_NULL(g_device_manager);
+  int64_t stage_num = g_device_manager->stage_num();
+  PipelineScheduler scheduler(stage_num, SizeToLong(micro_set.size()));
+  PipelineReport report;
+  PipelineReport gpipe_report;
+  if (scheduler.Simulate(PIPELINE_1F1B, PipelineCost(), &report) != SUCCESS ||
+      scheduler.Simulate(PIPELINE_GPIPE, PipelineCost(), &gpipe_report) != SUCCESS) {
+    MS_LOG(EXCEPTION) << "Schedule the " << micro_set.size() << " micro batches of " << stage_num << " stages failed.";
+  }
+  auto &stage_report = report.stages[LongToSize(stage_)];
+  MS_LOG(INFO) << "Stage " << stage_ << " runs the " << micro_set.size()
+               << " micro batches as: " << PipelineScheduler::ToString(scheduler.Schedule(stage_, PIPELINE_1F1B))
+               << ". The bubble fraction is " << stage_report.bubble_fraction << ", and the activations of at most "
+               << stage_report.peak_activation_size << " micro batches are kept, while "
+               << gpipe_report.stages[LongToSize(stage_)].peak_activation_size
+               << " are kept if all the forward run before the backward.";
+}
 }  // namespace parallel
 }  // namespace mindspore
@@ -55,6 +55,7 @@ class PipelineTransformer {
   void CoverSensShape();
   void ElimGraphStage();
   void ElimParameter();
+  void ScheduleMicroBatches();
 
  private:
   std::pair<bool, int> IsSharedNode(const AnfNodePtr &node, const AnfNodeIndexSet &node_users);
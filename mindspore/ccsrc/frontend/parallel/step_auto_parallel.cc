@@ -43,6 +43,7 @@
 #include "frontend/parallel/ops_info/tmp_identity_info.h"
 #include "frontend/parallel/step_parallel.h"
 #include "frontend/parallel/strategy_checkpoint/parallel_strategy_checkpoint.h"
+#include "frontend/parallel/tensor_layout/redistribution_planner.h"
 #include "ir/anf.h"
 #include "ir/param_info.h"
 #include "ir/tensor.h"
@@ -220,6 +221,8 @@ bool IsOperatorsInTwoSeparateLoops(const CNodePtr &a_cnode, const CNodePtr &b_cn
 void InitCostGraph() {
   entire_costgraph = std::make_shared<CostGraph>();
   entire_costgraph->SetDeviceMemoryAndCostParameter();
+  OperatorCostCache::GetInstance().Clear();
+  RedistributionPlanner::GetInstance().Clear();
 }
 
 OperatorInfoPtr CreateTheOperatorInfo(const PrimitivePtr &prim, const CNodePtr &cnode, StrategyMap *stra_map) {
@@ -250,6 +253,8 @@ OperatorInfoPtr CreateTheOperatorInfo(const PrimitivePtr &prim, const CNodePtr &
     MS_LOG(ERROR) << "Setting the lengths of inputs and outputs failed for operator: " << operator_info->name();
     return nullptr;
   }
+  operator_info->operator_cost()->set_computation_scale(
+    CostModelContext::GetInstance()->computation_scale(prim->name()));
   if (operator_info->set_outputs_type(outputs_type) != SUCCESS) {
     MS_LOG(ERROR) << "Setting the types of outputs failed for operator: " << operator_info->name();
     return nullptr;
@@ -825,6 +830,17 @@ void ReshapeCostCompute(const std::vector<AnfNodePtr> &all_nodes) {
   }
 }
 
+// Return the time in us since 'last_time', which is then updated to now.
+static uint64_t TakeStepTime(struct timeval *last_time) {
+  MS_EXCEPTION_IF_NULL(last_time);
+  struct timeval now;
+  (void)gettimeofday(&now, nullptr);
+  uint64_t time = kUSecondInSecond * static_cast<uint64_t>(now.tv_sec - last_time->tv_sec);
+  time += static_cast<uint64_t>(now.tv_usec - last_time->tv_usec);
+  *last_time = now;
+  return time;
+}
+
 Status ParallelStrategySearch(const std::vector<AnfNodePtr> &all_nodes, const FuncGraphPtr &root) {
   // There are 4 meta-steps to determine the parallelization strategy for the ANF graph.
   // Step 1: Traverse the ANF graph, and create NODEs for costgraph:
@@ -850,6 +866,8 @@ Status ParallelStrategySearch(const std::vector<AnfNodePtr> &all_nodes, const Fu
   //
   // OUTPUT: the determined strategy for each operator.
 
+  struct timeval step_time;
+  (void)gettimeofday(&step_time, nullptr);
   InitCostGraph();
   // Step 1
   if (CostModelContext::GetInstance()->is_multi_subgraphs()) {
@@ -867,12 +885,15 @@ Status ParallelStrategySearch(const std::vector<AnfNodePtr> &all_nodes, const Fu
       MS_LOG(EXCEPTION) << "Constructing nodes for cost graph failed.";
     }
   }
+  auto nodes_time = TakeStepTime(&step_time);
   // Step 1.1
   ReshapeCostCompute(all_nodes);
+  auto reshape_time = TakeStepTime(&step_time);
   // Step 2
   ConstructCostGraphEdges(all_nodes);
   MS_LOG(INFO) << "Constructing edges for cost graph succeeded. There are " << entire_costgraph->GetOperators().size()
                << " operators, and " << entire_costgraph->GetNumEdges() << " edges.";
+  auto edges_time = TakeStepTime(&step_time);
 
   // Step 3: Augment the costgraph.
   AugmentCostGraph(all_nodes);
@@ -886,6 +907,7 @@ Status ParallelStrategySearch(const std::vector<AnfNodePtr> &all_nodes, const Fu
   if (entire_costgraph->CalculateMemoryCost() != SUCCESS) {
     MS_LOG(EXCEPTION) << "Calculating memory cost failed.";
   }
+  auto augment_time = TakeStepTime(&step_time);
 
   // Step 4: run DP algorithm on the costgraph.
   if (GetStrategy(entire_costgraph) != SUCCESS) {
@@ -893,6 +915,16 @@ Status ParallelStrategySearch(const std::vector<AnfNodePtr> &all_nodes, const Fu
     return FAILED;
   }
   MS_LOG(INFO) << "Searching strategy succeeded.";
+  auto search_time = TakeStepTime(&step_time);
+  auto &cost_cache = OperatorCostCache::GetInstance();
+  MS_LOG(INFO) << "Strategy search time: creating the nodes " << nodes_time << " us, the reshape costs " << reshape_time
+               << " us, the edges " << edges_time << " us, augmenting the graph and its memory " << augment_time
+               << " us, the DP algorithm " << search_time << " us. The costs of " << cost_cache.hit_count() << " of "
+               << (cost_cache.hit_count() + cost_cache.miss_count()) << " strategies are reused from "
+               << cost_cache.size() << " computed ones. The plans of "
+               << RedistributionPlanner::GetInstance().improved_plan_num() << " of "
+               << RedistributionPlanner::GetInstance().plan_num()
+               << " redistributions are cheaper than the greedy ones.";
 
   if (entire_costgraph->InitSelectedStrategy() == SUCCESS) {
     MS_LOG(INFO) << "Init selected strategy succeeded.";
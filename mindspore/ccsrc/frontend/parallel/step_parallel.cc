@@ -39,6 +39,7 @@
 #include "frontend/parallel/node_check.h"
 #include "frontend/parallel/ops_info/matmul_info.h"
 #include "frontend/parallel/strategy_checkpoint/parallel_strategy_checkpoint.h"
+#include "frontend/parallel/tensor_layout/redistribution_planner.h"
 #include "ir/param_info.h"
 #include "ir/tensor.h"
 #include "utils/comm_manager.h"
@@ -364,6 +365,10 @@ void Redistribution(const std::pair<AnfNodePtr, int64_t> &node_pair, const Opera
   }
   MS_LOG(DEBUG) << "Redistribution size " << redistribution_oplist_ptr->first.size();
   if (!redistribution_oplist_ptr->first.empty()) {
+    auto type_lengths = ExtractInputTypeLengthByNode(next_node);
+    size_t type_length = LongToSize(index - 1) < type_lengths.size() ? type_lengths[LongToSize(index - 1)] : 0;
+    RedistributionPlanner::GetInstance().RecordInsertion(tensor_redistribution.collective_num(),
+                                                         tensor_redistribution.received_size() * type_length);
     // insert node before next node
     InsertRedistribution(redistribution_oplist_ptr, next_node, func_graph, node_pair.second, pre_node);
   }
@@ -3060,6 +3065,14 @@ bool StepParallel(const FuncGraphPtr &root, const opt::OptimizerPtr &optimizer)
   (void)gettimeofday(&start_time, nullptr);
 
   MS_LOG(INFO) << "Now entering step parallel";
+  auto &planner = RedistributionPlanner::GetInstance();
+  // the auto parallel search has cleared the plans for this compile already, the plans of the other modes are cleared
+  // here, so that the cache does not grow across the compiles or keep the plans of the former cost model parameters
+  if (parallel_mode != AUTO_PARALLEL) {
+    planner.Clear();
+  }
+  auto collective_num_before = planner.inserted_collective_num();
+  auto received_bytes_before = planner.inserted_received_bytes();
   DumpGraph(root, std::string(STEP_PARALLEL_BEGIN));
 
   pipeline::ResourceBasePtr res = optimizer->resource();
@@ -3128,6 +3141,12 @@ bool StepParallel(const FuncGraphPtr &root, const opt::OptimizerPtr &optimizer)
   uint64_t time = kUSecondInSecond * static_cast<uint64_t>(end_time.tv_sec - start_time.tv_sec);
   time += static_cast<uint64_t>(end_time.tv_usec - start_time.tv_usec);
 
+  MS_LOG(INFO) << "The tensor redistributions insert " << planner.inserted_collective_num() - collective_num_before
+               << " collectives, in which each device receives "
+               << planner.inserted_received_bytes() - received_bytes_before << " bytes. The plans of "
+               << planner.improved_plan_num() << " of " << planner.plan_num()
+               << " redistributions are cheaper than the greedy ones, saving " << planner.saved_cost()
+               << " in the cost model.";
   MS_LOG(INFO) << "Now leaving step parallel, used time: " << time << " us";
   return changes;
 }
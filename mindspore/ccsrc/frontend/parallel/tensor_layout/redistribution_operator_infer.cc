@@ -94,6 +94,37 @@ Status RedistributionOperatorInfer::InferRedistributionOperator() {
   return Status::SUCCESS;
 }
 
+Status RedistributionOperatorInfer::InferRedistributionOperator(const std::vector<OperatorR> &planned_operators) {
+  for (auto &op : planned_operators) {
+    const Args &args = op.second;
+    if (op.first != PERMUTE_BY_AXIS || is_cost_model_) {
+      if (InsertOperator(op.first, args) == Status::FAILED) {
+        return Status::FAILED;
+      }
+      continue;
+    }
+    if (args.size() < 5) {
+      MS_LOG(ERROR) << "args size should not be less than 5!";
+      return Status::FAILED;
+    }
+    // the same as InferPermuteByAxis out of the cost model
+    int64_t index = args[1];
+    int64_t cat_dim = args[2];
+    int64_t out_dim = args[3];
+    int64_t dev_num = args[4];
+    if (InsertOperator(CONCAT_BY_AXIS, {cat_dim, out_dim, dev_num}) == Status::FAILED) {
+      MS_LOG(ERROR) << "Insert ConcatByAxis Error!";
+      return Status::FAILED;
+    }
+    if (InsertOperator(SPLIT_BY_AXIS, {dev_num, index, out_dim}) == Status::FAILED) {
+      MS_LOG(ERROR) << "Insert SplitByAxis Error!";
+      return Status::FAILED;
+    }
+  }
+  map_.clear();
+  return Status::SUCCESS;
+}
+
 Status RedistributionOperatorInfer::InferSplitByAxis() {
   for (auto iter = map_.begin(); iter != map_.end();) {
     uint64_t index = iter->first;
@@ -48,6 +48,8 @@ class RedistributionOperatorInfer {
   OperatorVector operator_vector() const { return operator_vector_; }
   OutPutInfoVector output_info_vector() const { return output_info_vector_; }
   Status InferRedistributionOperator();
+  // insert the operators of a plan in the cost model, where PermuteByAxis is expanded out of the cost model
+  Status InferRedistributionOperator(const std::vector<OperatorR> &planned_operators);
 
  private:
   Status InferSplitByAxis();
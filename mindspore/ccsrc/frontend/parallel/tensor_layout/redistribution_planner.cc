@@ -0,0 +1,289 @@
+/**
+ * Copyright 2020 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "frontend/parallel/tensor_layout/redistribution_planner.h"
+
+#include <algorithm>
+#include <functional>
+#include <queue>
+#include <string>
+#include <utility>
+
+#include "frontend/parallel/costmodel_context.h"
+#include "frontend/parallel/tensor_layout/tensor_redistribution.h"
+
+namespace mindspore {
+namespace parallel {
+namespace {
+// The tensor maps are the states of the search, the operators transfer a tensor map into another one.
+class PlanSearch {
+ public:
+  PlanSearch(const TensorLayout &from, const Map &to_tensor_map)
+      : dev_mat_(from.device_arrangement().array()),
+        tensor_shape_(from.tensor_shape().array()),
+        from_map_(from.tensor_map().array()),
+        to_map_(to_tensor_map.array()),
+        alpha_(CostModelContext::GetInstance()->costmodel_alpha()),
+        beta_(CostModelContext::GetInstance()->costmodel_beta()) {}
+  ~PlanSearch() = default;
+
+  Status Search(RedistributionPlan *plan) const;
+  Status Evaluate(RedistributionPlan *plan) const;
+
+ private:
+  int64_t DevNum(int64_t dev_dim) const { return dev_mat_[dev_mat_.size() - 1 - LongToSize(dev_dim)]; }
+  double SliceSize(const Shape &tensor_map) const;
+  std::vector<OperatorR> NextOperators(const Shape &tensor_map) const;
+  Status Apply(const OperatorR &op, Shape *tensor_map, double *cost) const;
+
+  Shape dev_mat_;
+  Shape tensor_shape_;
+  Shape from_map_;
+  Shape to_map_;
+  double alpha_;
+  double beta_;
+};
+
+double PlanSearch::SliceSize(const Shape &tensor_map) const {
+  double size = 1.0;
+  for (size_t i = 0; i < tensor_map.size(); ++i) {
+    size *= static_cast<double>(tensor_shape_[i]) / (tensor_map[i] == MAP_NONE ? 1 : DevNum(tensor_map[i]));
+  }
+  return size;
+}
+
+// The operators inserted by the greedy inference, for the dimensions not split as the target: a split dimension is
+// concatenated, and an unsplit one is split, or permuted with the dimension split by the target device dimension.
+std::vector<OperatorR> PlanSearch::NextOperators(const Shape &tensor_map) const {
+  std::vector<OperatorR> next_ops;
+  for (size_t index = 0; index < tensor_map.size(); ++index) {
+    int64_t in_dim = tensor_map[index];
+    int64_t out_dim = to_map_[index];
+    if (in_dim == out_dim) {
+      continue;
+    }
+    if (in_dim != MAP_NONE) {
+      next_ops.emplace_back(CONCAT_BY_AXIS, Args{SizeToLong(index), in_dim, DevNum(in_dim)});
+      continue;
+    }
+    auto cat_iter = std::find(tensor_map.begin(), tensor_map.end(), out_dim);
+    if (cat_iter == tensor_map.end()) {
+      next_ops.emplace_back(SPLIT_BY_AXIS, Args{DevNum(out_dim), SizeToLong(index), out_dim});
+    } else {
+      int64_t cat_dim = cat_iter - tensor_map.begin();
+      next_ops.emplace_back(PERMUTE_BY_AXIS,
+                            Args{DevNum(out_dim), SizeToLong(index), cat_dim, out_dim, DevNum(out_dim)});
+    }
+  }
+  return next_ops;
+}
+
+// Update the tensor map by the operator, and add its cost as in TensorRedistribution::ComputeCost
+Status PlanSearch::Apply(const OperatorR &op, Shape *tensor_map, double *cost) const {
+  const Args &args = op.second;
+  double input_size = SliceSize(*tensor_map);
+  double computation = input_size;
+  double communication = 0.0;
+  if (op.first == SPLIT_BY_AXIS && args.size() >= 3) {
+    (*tensor_map)[LongToSize(args[1])] = args[2];
+  } else if (op.first == CONCAT_BY_AXIS && args.size() >= 3) {
+    communication = input_size * (args[2] + 1.0) * ALLGATHER_REDUCESCATTER_SCALE_FACTOR;
+    if (args[0] != 0) {
+      computation += 2.0 * input_size * args[2];
+    }
+    (*tensor_map)[LongToSize(args[0])] = MAP_NONE;
+  } else if (op.first == PERMUTE_BY_AXIS && args.size() >= 5) {
+    communication = 2.0 * input_size * ALLTOALL_SCALE_FACTOR;
+    if (args[2] != 0) {
+      computation += 2.0 * input_size * args[4];
+    }
+    (*tensor_map)[LongToSize(args[2])] = MAP_NONE;
+    (*tensor_map)[LongToSize(args[1])] = args[3];
+  } else {
+    MS_LOG(ERROR) << "Invalid redistribution operator " << op.first << " with " << args.size() << " args";
+    return Status::FAILED;
+  }
+  *cost += alpha_ * computation + beta_ * communication;
+  return Status::SUCCESS;
+}
+
+Status PlanSearch::Evaluate(RedistributionPlan *plan) const {
+  Shape tensor_map = from_map_;
+  plan->cost = 0.0;
+  plan->collective_num = 0;
+  for (auto &op : plan->operators) {
+    if (Apply(op, &tensor_map, &plan->cost) != Status::SUCCESS) {
+      return Status::FAILED;
+    }
+    if (op.first != SPLIT_BY_AXIS) {
+      ++plan->collective_num;
+    }
+  }
+  return tensor_map == to_map_ ? Status::SUCCESS : Status::FAILED;
+}
+
+// Dijkstra's algorithm over the tensor maps. A dimension is only split as the source, the target or not, so there are
+// at most 3^n tensor maps for n dimensions.
+Status PlanSearch::Search(RedistributionPlan *plan) const {
+  using QueueItem = std::pair<double, Shape>;
+  std::priority_queue<QueueItem, std::vector<QueueItem>, std::greater<QueueItem>> queue;
+  std::map<Shape, double> costs;
+  std::map<Shape, std::pair<Shape, OperatorR>> prev;
+  costs[from_map_] = 0.0;
+  queue.emplace(0.0, from_map_);
+  size_t visited_num = 0;
+  while (!queue.empty()) {
+    auto cost = queue.top().first;
+    auto tensor_map = queue.top().second;
+    queue.pop();
+    if (cost > costs[tensor_map]) {
+      continue;
+    }
+    if (tensor_map == to_map_) {
+      plan->operators.clear();
+      for (auto iter = prev.find(tensor_map); iter != prev.end(); iter = prev.find(iter->second.first)) {
+        plan->operators.push_back(iter->second.second);
+      }
+      std::reverse(plan->operators.begin(), plan->operators.end());
+      return Evaluate(plan);
+    }
+    if (++visited_num > MAX_REDISTRIBUTION_PLAN_STATES) {
+      MS_LOG(INFO) << "Searching the redistribution plan visits more than " << MAX_REDISTRIBUTION_PLAN_STATES
+                   << " tensor maps";
+      return Status::FAILED;
+    }
+    for (auto &op : NextOperators(tensor_map)) {
+      Shape next_map = tensor_map;
+      double next_cost = cost;
+      if (Apply(op, &next_map, &next_cost) != Status::SUCCESS) {
+        return Status::FAILED;
+      }
+      auto iter = costs.find(next_map);
+      if (iter == costs.end() || next_cost < iter->second) {
+        costs[next_map] = next_cost;
+        prev[next_map] = std::make_pair(tensor_map, op);
+        queue.emplace(next_cost, next_map);
+      }
+    }
+  }
+  return Status::FAILED;
+}
+
+std::vector<int64_t> PlanKey(const TensorLayout &from, const Map &to_tensor_map) {
+  std::vector<int64_t> key;
+  for (auto &shape : {from.device_arrangement().array(), from.tensor_shape().array(), from.tensor_map().array(),
+                      to_tensor_map.array()}) {
+    key.push_back(SizeToLong(shape.size()));
+    (void)key.insert(key.end(), shape.begin(), shape.end());
+  }
+  return key;
+}
+}  // namespace
+
+RedistributionPlanner &RedistributionPlanner::GetInstance() {
+  static RedistributionPlanner instance;
+  return instance;
+}
+
+Status RedistributionPlanner::GetPlan(const TensorLayout &from, const Map &to_tensor_map, RedistributionPlan *plan) {
+  MS_EXCEPTION_IF_NULL(plan);
+  auto key = PlanKey(from, to_tensor_map);
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto iter = plans_.find(key);
+    if (iter != plans_.end()) {
+      *plan = iter->second;
+      return Status::SUCCESS;
+    }
+  }
+
+  RedistributionOperatorInfer greedy_infer(false);
+  RedistributionPlan greedy_plan;
+  PlanSearch search(from, to_tensor_map);
+  bool greedy_valid = greedy_infer.Init(from, to_tensor_map, {}, true) == Status::SUCCESS &&
+                      greedy_infer.InferRedistributionOperator() == Status::SUCCESS;
+  if (greedy_valid) {
+    for (auto &op_cost : greedy_infer.operator_list()) {
+      greedy_plan.operators.push_back(op_cost.first);
+    }
+    greedy_valid = search.Evaluate(&greedy_plan) == Status::SUCCESS;
+  }
+  RedistributionPlan searched_plan;
+  bool searched_valid = search.Search(&searched_plan) == Status::SUCCESS;
+  if (!greedy_valid && !searched_valid) {
+    MS_LOG(ERROR) << "Infer the redistribution of " << from.ToString() << " to the tensor map "
+                  << to_tensor_map.ToString() << " failed";
+    return Status::FAILED;
+  }
+  // the searched plan is used only if it is cheaper, the equally costed greedy one is kept
+  bool improved = searched_valid && (!greedy_valid || searched_plan.cost < greedy_plan.cost * (1.0 - 1e-9));
+  *plan = improved ? searched_plan : greedy_plan;
+  if (improved && greedy_valid) {
+    MS_LOG(INFO) << "The redistribution plan of " << from.ToString() << " to the tensor map "
+                 << to_tensor_map.ToString() << " has " << searched_plan.collective_num << " collectives and costs "
+                 << searched_plan.cost << ", while the greedy one has " << greedy_plan.collective_num
+                 << " collectives and costs " << greedy_plan.cost;
+  }
+
+  std::lock_guard<std::mutex> lock(mutex_);
+  if (plans_.emplace(std::move(key), *plan).second && improved && greedy_valid) {
+    ++improved_plan_num_;
+    saved_cost_ += greedy_plan.cost - searched_plan.cost;
+  }
+  return Status::SUCCESS;
+}
+
+void RedistributionPlanner::Clear() {
+  std::lock_guard<std::mutex> lock(mutex_);
+  plans_.clear();
+  improved_plan_num_ = 0;
+  saved_cost_ = 0.0;
+  inserted_collective_num_ = 0;
+  inserted_received_bytes_ = 0.0;
+}
+
+size_t RedistributionPlanner::plan_num() {
+  std::lock_guard<std::mutex> lock(mutex_);
+  return plans_.size();
+}
+
+size_t RedistributionPlanner::improved_plan_num() {
+  std::lock_guard<std::mutex> lock(mutex_);
+  return improved_plan_num_;
+}
+
+double RedistributionPlanner::saved_cost() {
+  std::lock_guard<std::mutex> lock(mutex_);
+  return saved_cost_;
+}
+
+void RedistributionPlanner::RecordInsertion(int64_t collective_num, double received_bytes) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  inserted_collective_num_ += collective_num;
+  inserted_received_bytes_ += received_bytes;
+}
+
+int64_t RedistributionPlanner::inserted_collective_num() {
+  std::lock_guard<std::mutex> lock(mutex_);
+  return inserted_collective_num_;
+}
+
+double RedistributionPlanner::inserted_received_bytes() {
+  std::lock_guard<std::mutex> lock(mutex_);
+  return inserted_received_bytes_;
+}
+}  // namespace parallel
+}  // namespace mindspore
@@ -0,0 +1,74 @@
+/**
+ * Copyright 2020 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef MINDSPORE_CCSRC_FRONTEND_PARALLEL_TENSOR_LAYOUT_REDISTRIBUTION_PLANNER_H_
+#define MINDSPORE_CCSRC_FRONTEND_PARALLEL_TENSOR_LAYOUT_REDISTRIBUTION_PLANNER_H_
+
+#include <cstdint>
+#include <map>
+#include <mutex>
+#include <vector>
+
+#include "frontend/parallel/status.h"
+#include "frontend/parallel/tensor_layout/redistribution_operator_infer.h"
+#include "frontend/parallel/tensor_layout/tensor_layout.h"
+
+namespace mindspore {
+namespace parallel {
+// the maximum number of tensor maps visited in searching a plan, beyond which the greedy plan is used
+constexpr size_t MAX_REDISTRIBUTION_PLAN_STATES = 4096;
+
+// The SplitByAxis, ConcatByAxis and PermuteByAxis operators transferring a tensor map into another one, with the args
+// of the cost model. The PermuteByAxis operators are expanded when the operators are constructed out of the cost model.
+struct RedistributionPlan {
+  std::vector<OperatorR> operators;
+  // alpha * computation + beta * communication of the operators, in the number of elements
+  double cost = 0.0;
+  int64_t collective_num = 0;
+};
+
+// The greedy inference in RedistributionOperatorInfer splits the tensor first, then permutes and concatenates it, and
+// breaks a loop of permutations by concatenating the first dimension. The planner searches the cheapest sequence of
+// the operators from the tensor map to the other under the cost model, and keeps the greedy sequence unless the
+// searched one is cheaper. The plans are cached by the device arrangement, the tensor shape and the tensor maps.
+class RedistributionPlanner {
+ public:
+  static RedistributionPlanner &GetInstance();
+  Status GetPlan(const TensorLayout &from, const Map &to_tensor_map, RedistributionPlan *plan);
+  // The plans depend on the cost model parameters, the cache is cleared for each graph.
+  void Clear();
+
+  // statistics of the plans, and of the collectives inserted into the graph by the tensor redistributions
+  size_t plan_num();
+  size_t improved_plan_num();
+  double saved_cost();
+  void RecordInsertion(int64_t collective_num, double received_bytes);
+  int64_t inserted_collective_num();
+  double inserted_received_bytes();
+
+ private:
+  RedistributionPlanner() = default;
+  std::mutex mutex_;
+  std::map<std::vector<int64_t>, RedistributionPlan> plans_;
+  size_t improved_plan_num_ = 0;
+  double saved_cost_ = 0.0;
+  int64_t inserted_collective_num_ = 0;
+  double inserted_received_bytes_ = 0.0;
+};
+}  // namespace parallel
+}  // namespace mindspore
+
+#endif  // MINDSPORE_CCSRC_FRONTEND_PARALLEL_TENSOR_LAYOUT_REDISTRIBUTION_PLANNER_H_
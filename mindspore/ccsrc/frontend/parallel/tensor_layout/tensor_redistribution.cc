@@ -15,10 +15,12 @@
  */
 
 #include "frontend/parallel/tensor_layout/tensor_redistribution.h"
+#include <algorithm>
 #include <functional>
 #include <numeric>
 #include "utils/ms_utils.h"
 #include "frontend/parallel/status.h"
+#include "frontend/parallel/tensor_layout/redistribution_planner.h"
 #include "frontend/parallel/tensor_layout/shape_util.h"
 
 namespace mindspore {
@@ -181,7 +183,9 @@ Status TensorRedistribution::InferRedistribution(const TensorLayout &from_layout
     MS_LOG(ERROR) << "Init operatorInfer failed";
     return Status::FAILED;
   }
-  if (operator_infer.InferRedistributionOperator() != Status::SUCCESS) {
+  RedistributionPlan plan;
+  if (RedistributionPlanner::GetInstance().GetPlan(from_layout, to_layout.tensor_map(), &plan) != Status::SUCCESS ||
+      operator_infer.InferRedistributionOperator(plan.operators) != Status::SUCCESS) {
     MS_LOG(ERROR) << "Infer redistribution failed";
     return Status::FAILED;
   } else {
@@ -198,6 +202,29 @@ Status TensorRedistribution::InferRedistribution(const TensorLayout &from_layout
   return Status::SUCCESS;
 }
 
+int64_t TensorRedistribution::collective_num() const {
+  return std::count_if(operator_list_.begin(), operator_list_.end(), [](const OperatorC &op_cost) {
+    return op_cost.first.first == CONCAT_BY_AXIS || op_cost.first.first == PERMUTE_BY_AXIS;
+  });
+}
+
+double TensorRedistribution::received_size() const {
+  double size = 0.0;
+  for (auto &op_cost : operator_list_) {
+    const Args &args = op_cost.first.second;
+    double input_size = std::accumulate(op_cost.second.begin(), op_cost.second.end(), static_cast<double>(1.0),
+                                        std::multiplies<double>());
+    if (op_cost.first.first == CONCAT_BY_AXIS && args.size() >= 3) {
+      // AllGather receives the slices of the other devices
+      size += input_size * (args[2] - 1);
+    } else if (op_cost.first.first == PERMUTE_BY_AXIS && args.size() >= 5) {
+      // AlltoAll exchanges all but one of the pieces of the slice
+      size += input_size * (args[4] - 1) / args[4];
+    }
+  }
+  return size;
+}
+
 Status TensorRedistribution::ComputeCost() {
   RedistributionOpListPtr redistribution_oplist_ptr = InferTensorRedistributionOperatorList(true);
   if (redistribution_oplist_ptr == nullptr) {
@@ -57,6 +57,9 @@ class TensorRedistribution {
   double forward_comm_cost() const { return forward_comm_cost_; }
   double backward_comm_cost() const { return backward_comm_cost_; }
   double memory_cost() const { return memory_cost_; }
+  // the collectives of the inferred operators, and the elements each device receives in them
+  int64_t collective_num() const;
+  double received_size() const;
 
  private:
   Status InferReshape(const TensorLayout &from_layout, const TensorLayout &to_layout,
@@ -0,0 +1,402 @@
+/**
+ * Copyright 2020 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "pipeline/jit/compile_cache.h"
+
+#include <unistd.h>
+#include <cstdio>
+#include <fstream>
+#include <iomanip>
+#include <map>
+#include <queue>
+#include <sstream>
+#include <vector>
+
+#include "ir/tensor.h"
+#include "ir/manager.h"
+#include "ir/graph_utils.h"
+#include "ir/param_info.h"
+#include "utils/ms_context.h"
+#include "utils/profile.h"
+#include "utils/log_adapter.h"
+#include "pipeline/jit/base.h"
+#include "frontend/parallel/context.h"
+#include "debug/dump_proto.h"
+#include "load_mindir/load_model.h"
+#if (ENABLE_CPU && (ENABLE_D || ENABLE_GPU))
+#include "ps/util.h"
+#endif
+
+namespace mindspore {
+namespace pipeline {
+namespace {
+constexpr uint64_t kFnvOffsetBasis = 14695981039346656037ULL;
+constexpr uint64_t kFnvPrime = 1099511628211ULL;
+constexpr uint8_t kFieldSeparator = 0xff;
+constexpr char kMindIRSuffix[] = ".mindir";
+constexpr char kMetaSuffix[] = ".meta";
+
+// 64 bits FNV-1a hash of a sequence of fields
+class KeyHasher {
+ public:
+  void Update(const void *data, size_t size) {
+    auto bytes = static_cast<const uint8_t *>(data);
+    for (size_t i = 0; i < size; ++i) {
+      hash_ = (hash_ ^ bytes[i]) * kFnvPrime;
+    }
+    hash_ = (hash_ ^ kFieldSeparator) * kFnvPrime;
+  }
+  void Update(const std::string &field) { Update(field.data(), field.size()); }
+  uint64_t hash() const { return hash_; }
+
+ private:
+  uint64_t hash_{kFnvOffsetBasis};
+};
+
+std::string FrameworkVersion() {
+  static std::string version;
+  if (version.empty()) {
+    try {
+      version = py::cast<std::string>(py::module::import("mindspore.version").attr("__version__"));
+    } catch (const std::exception &e) {
+      MS_LOG(WARNING) << "Get the version of mindspore failed: " << e.what();
+      version = "unknown";
+    }
+  }
+  return version;
+}
+
+std::string ShapeText(const ShapeVector &shape) {
+  std::ostringstream oss;
+  oss << "(";
+  for (auto dim : shape) {
+    oss << dim << ",";
+  }
+  oss << ")";
+  return oss.str();
+}
+
+// the weights are identified by their name, type and shape, their data is the one of the live network when loading
+std::string ParameterText(const ParameterPtr &param) {
+  if (!param->has_default()) {
+    return "input";
+  }
+  std::ostringstream oss;
+  oss << "weight " << param->name();
+  auto meta_tensor = param->default_param()->cast<tensor::MetaTensorPtr>();
+  if (meta_tensor != nullptr) {
+    oss << " " << TypeIdLabel(meta_tensor->data_type()) << ShapeText(meta_tensor->shape());
+    if (meta_tensor->param_info() != nullptr) {
+      oss << " requires_grad:" << meta_tensor->param_info()->requires_grad();
+    }
+  }
+  return oss.str();
+}
+
+// the structural hash of the graphs reachable from the root, nodes are numbered in the topological order of their
+// graph and graphs in the order they are first used, so the key does not depend on the addresses or the debug names
+uint64_t GraphStructureHash(const FuncGraphPtr &root) {
+  KeyHasher hasher;
+  std::unordered_map<FuncGraphPtr, size_t> graph_ids;
+  std::unordered_map<AnfNodePtr, size_t> node_ids;
+  std::queue<FuncGraphPtr> graphs;
+  auto graph_id = [&graph_ids, &graphs](const FuncGraphPtr &fg) {
+    auto iter = graph_ids.find(fg);
+    if (iter != graph_ids.end()) {
+      return iter->second;
+    }
+    size_t id = graph_ids.size();
+    graph_ids[fg] = id;
+    graphs.push(fg);
+    return id;
+  };
+  (void)graph_id(root);
+  while (!graphs.empty()) {
+    auto fg = graphs.front();
+    graphs.pop();
+    std::ostringstream graph_text;
+    graph_text << "graph " << graph_ids[fg] << " vararg:" << fg->has_vararg() << " kwarg:" << fg->has_kwarg()
+               << " kwonlyargs:" << fg->kwonlyargs_count() << " hyper_params:" << fg->hyper_param_count();
+    std::map<std::string, std::string> attrs;
+    for (auto &attr : fg->attrs()) {
+      attrs[attr.first] = attr.second == nullptr ? "null" : attr.second->ToString();
+    }
+    for (auto &attr : attrs) {
+      graph_text << " " << attr.first << ":" << attr.second;
+    }
+    hasher.Update(graph_text.str());
+    for (auto &param : fg->parameters()) {
+      size_t id = node_ids.size();
+      node_ids[param] = id;
+      hasher.Update(ParameterText(param->cast<ParameterPtr>()));
+    }
+    for (auto &node : TopoSort(fg->get_return())) {
+      if (node_ids.count(node) != 0) {
+        continue;
+      }
+      std::ostringstream node_text;
+      if (node->isa<CNode>()) {
+        node_text << "cnode";
+        for (auto &input : node->cast<CNodePtr>()->inputs()) {
+          node_text << " " << node_ids[input];
+        }
+      } else if (node->isa<Parameter>()) {
+        // free variable of a graph which is not visited yet
+        node_text << "free " << ParameterText(node->cast<ParameterPtr>());
+      } else if (IsValueNode<FuncGraph>(node)) {
+        node_text << "graph " << graph_id(GetValueNode<FuncGraphPtr>(node));
+      } else if (IsValueNode<Primitive>(node)) {
+        auto prim = GetValueNode<PrimitivePtr>(node);
+        node_text << "prim " << prim->name() << prim->GetAttrsText();
+      } else if (IsValueNode<tensor::Tensor>(node)) {
+        // the text of a tensor elides the middle of large data
+        auto tensor = GetValueNode<tensor::TensorPtr>(node);
+        node_text << "tensor " << TypeIdLabel(tensor->data_type()) << ShapeText(tensor->shape());
+        hasher.Update(tensor->data_c(), tensor->Size());
+      } else if (node->isa<ValueNode>()) {
+        auto value = GetValueNode(node);
+        node_text << "value " << (value == nullptr ? "null" : value->ToString());
+      }
+      size_t id = node_ids.size();
+      node_ids[node] = id;
+      hasher.Update(node_text.str());
+    }
+  }
+  return hasher.hash();
+}
+
+std::string ContextText() {
+  auto context = MsContext::GetInstance();
+  MS_EXCEPTION_IF_NULL(context);
+  auto parallel_context = parallel::ParallelContext::GetInstance();
+  MS_EXCEPTION_IF_NULL(parallel_context);
+  std::ostringstream oss;
+  oss << "device_target:" << context->get_param<std::string>(MS_CTX_DEVICE_TARGET)
+      << " enable_graph_kernel:" << context->get_param<bool>(MS_CTX_ENABLE_GRAPH_KERNEL)
+      << " enable_sparse:" << context->get_param<bool>(MS_CTX_ENABLE_SPARSE)
+      << " enable_auto_mixed_precision:" << context->get_param<bool>(MS_CTX_ENABLE_AUTO_MIXED_PRECISION)
+      << " enable_reduce_precision:" << context->get_param<bool>(MS_CTX_ENABLE_REDUCE_PRECISION)
+      << " recompute_memory_budget:" << context->get_param<float>(MS_CTX_RECOMPUTE_MEMORY_BUDGET)
+      << " parallel_mode:" << parallel_context->parallel_mode() << " device_num:" << parallel_context->device_num();
+  return oss.str();
+}
+
+bool WriteFile(const std::string &file_name, const std::string &content) {
+  // write a temporary file first, so that other processes sharing the cache never read a partial file
+  std::string tmp_file = file_name + ".tmp" + std::to_string(getpid());
+  std::ofstream ofs(tmp_file, std::ios::out | std::ios::binary | std::ios::trunc);
+  if (!ofs.is_open()) {
+    MS_LOG(WARNING) << "Open file '" << tmp_file << "' failed!";
+    return false;
+  }
+  ofs << content;
+  ofs.close();
+  if (!ofs.good() || std::rename(tmp_file.c_str(), file_name.c_str()) != 0) {
+    MS_LOG(WARNING) << "Write file '" << file_name << "' failed!";
+    (void)std::remove(tmp_file.c_str());
+    return false;
+  }
+  return true;
+}
+}  // namespace
+
+CompileCacheManager &CompileCacheManager::GetInstance() {
+  static CompileCacheManager instance;
+  return instance;
+}
+
+bool CompileCacheManager::Enabled(const std::string &phase, bool use_vm) const {
+  auto context = MsContext::GetInstance();
+  MS_EXCEPTION_IF_NULL(context);
+  if (context->get_param<std::string>(MS_CTX_COMPILE_CACHE_PATH).empty()) {
+    return false;
+  }
+  if (!use_vm || context->get_param<int>(MS_CTX_EXECUTION_MODE) != kGraphMode || context->backend_policy() == "ge" ||
+      GetPhasePrefix(phase).rfind("export", 0) != std::string::npos) {
+    return false;
+  }
+#if (ENABLE_CPU && (ENABLE_D || ENABLE_GPU))
+  if (ps::Util::IsParamServerMode()) {
+    return false;
+  }
+#endif
+  // the graphs of the other modes depend on the strategies and the rank of the device
+  auto parallel_mode = parallel::ParallelContext::GetInstance()->parallel_mode();
+  if (parallel_mode != parallel::STAND_ALONE && parallel_mode != parallel::DATA_PARALLEL) {
+    MS_LOG(INFO) << "Compile cache is not supported in parallel mode " << parallel_mode;
+    return false;
+  }
+  return true;
+}
+
+std::string CompileCacheManager::GenerateKey(const FuncGraphPtr &resolved_graph,
+                                             const abstract::AbstractBasePtrList &args_spec) {
+  MS_EXCEPTION_IF_NULL(resolved_graph);
+  std::ostringstream header;
+  header << "version:" << FrameworkVersion() << " " << ContextText() << " args:";
+  for (auto &arg : args_spec) {
+    MS_EXCEPTION_IF_NULL(arg);
+    header << " " << arg->ToString();
+  }
+  uint64_t hash = GraphStructureHash(resolved_graph) ^ (std::hash<std::string>()(header.str()) * kFnvPrime);
+  std::ostringstream key;
+  key << std::hex << std::setw(16) << std::setfill('0') << hash;
+  headers_[key.str()] = header.str();
+  MS_LOG(INFO) << "Compile cache key of graph " << resolved_graph->ToString() << " is " << key.str();
+  return key.str();
+}
+
+std::string CompileCacheManager::CacheFile(const std::string &key, const std::string &suffix) const {
+  auto cache_path = MsContext::GetInstance()->get_param<std::string>(MS_CTX_COMPILE_CACHE_PATH);
+  return cache_path + "/" + key + suffix;
+}
+
+FuncGraphPtr CompileCacheManager::Load(const std::string &key, const FuncGraphPtr &resolved_graph) {
+  MS_EXCEPTION_IF_NULL(resolved_graph);
+  double start = GetTime();
+  // the meta file holds the number of weights, their names in the order of the cached graph and then the header
+  std::ifstream meta_file(CacheFile(key, kMetaSuffix));
+  if (!meta_file.is_open()) {
+    MS_LOG(INFO) << "Compile cache miss, key " << key;
+    ++miss_num_;
+    return nullptr;
+  }
+  size_t weight_num = 0;
+  meta_file >> weight_num;
+  meta_file.ignore();
+  std::vector<std::string> weight_names(weight_num);
+  for (auto &name : weight_names) {
+    std::getline(meta_file, name);
+  }
+  std::stringstream header;
+  header << meta_file.rdbuf();
+  if (header.str() != headers_[key]) {
+    MS_LOG(WARNING) << "Compile cache key " << key << " collides with another graph, ignore the cache.";
+    ++miss_num_;
+    return nullptr;
+  }
+
+  FuncGraphPtr graph = nullptr;
+  try {
+    graph = LoadMindIR(CacheFile(key, kMindIRSuffix));
+  } catch (const std::exception &e) {
+    MS_LOG(WARNING) << "Load compile cache " << CacheFile(key, kMindIRSuffix) << " failed: " << e.what();
+    graph = nullptr;
+  }
+  if (graph == nullptr) {
+    ++miss_num_;
+    return nullptr;
+  }
+
+  // the loaded graph holds the weights first, restore the order of the compiled graph whose inputs are first, and
+  // make the weights share the tensors of the network
+  std::unordered_map<std::string, ParameterPtr> live_weights;
+  for (auto &node : resolved_graph->parameters()) {
+    auto param = node->cast<ParameterPtr>();
+    if (param != nullptr && param->has_default()) {
+      live_weights[param->name()] = param;
+    }
+  }
+  std::vector<AnfNodePtr> inputs;
+  std::vector<AnfNodePtr> weights;
+  for (auto &node : graph->parameters()) {
+    auto param = node->cast<ParameterPtr>();
+    MS_EXCEPTION_IF_NULL(param);
+    if (!param->has_default()) {
+      inputs.push_back(param);
+      continue;
+    }
+    auto iter = weights.size() < weight_names.size() ? live_weights.find(weight_names[weights.size()])
+                                                     : live_weights.end();
+    if (iter == live_weights.end()) {
+      MS_LOG(WARNING) << "The weights of compile cache " << key << " do not match the network, ignore the cache.";
+      ++miss_num_;
+      return nullptr;
+    }
+    param->set_name(iter->second->name());
+    param->set_default_param(iter->second->default_param());
+    weights.push_back(param);
+  }
+  if (weights.size() != weight_names.size()) {
+    MS_LOG(WARNING) << "The weights of compile cache " << key << " do not match the network, ignore the cache.";
+    ++miss_num_;
+    return nullptr;
+  }
+  inputs.insert(inputs.end(), weights.begin(), weights.end());
+  graph->set_parameters(inputs);
+
+  double load_time = GetTime() - start;
+  ++hit_num_;
+  load_time_ += load_time;
+  MS_LOG(INFO) << "Compile cache hit, key " << key << ", load time " << load_time << "s";
+  return graph;
+}
+
+void CompileCacheManager::Save(const std::string &key, const FuncGraphPtr &optimized_graph) {
+  MS_EXCEPTION_IF_NULL(optimized_graph);
+  auto manager = optimized_graph->manager();
+  if (manager != nullptr && manager->func_graphs().size() != 1) {
+    MS_LOG(INFO) << "Graph " << optimized_graph->ToString() << " calls " << (manager->func_graphs().size() - 1)
+                 << " sub graphs after optimization, it is not cached.";
+    ++skip_num_;
+    return;
+  }
+  std::string proto;
+  try {
+    // the weights are bound to the parameters of the network on load, their data is not cached
+    proto = GetBinaryProtoString(optimized_graph, false);
+  } catch (const std::exception &e) {
+    MS_LOG(WARNING) << "Export graph " << optimized_graph->ToString() << " to compile cache failed: " << e.what();
+  }
+  if (proto.empty()) {
+    ++skip_num_;
+    return;
+  }
+
+  std::ostringstream meta;
+  std::vector<std::string> weight_names;
+  for (auto &node : optimized_graph->parameters()) {
+    auto param = node->cast<ParameterPtr>();
+    if (param != nullptr && param->has_default()) {
+      weight_names.push_back(param->name());
+    }
+  }
+  meta << weight_names.size() << "\n";
+  for (auto &name : weight_names) {
+    meta << name << "\n";
+  }
+  meta << headers_[key];
+  // the meta file is written last, a cache entry exists only when it does
+  if (!WriteFile(CacheFile(key, kMindIRSuffix), proto) || !WriteFile(CacheFile(key, kMetaSuffix), meta.str())) {
+    ++skip_num_;
+    return;
+  }
+  ++save_num_;
+  MS_LOG(INFO) << "Save graph " << optimized_graph->ToString() << " to compile cache, key " << key;
+}
+
+py::dict CompileCacheManager::GetMetrics() const {
+  py::dict metrics;
+  metrics["hit"] = hit_num_;
+  metrics["miss"] = miss_num_;
+  metrics["save"] = save_num_;
+  metrics["skip"] = skip_num_;
+  metrics["load_time"] = load_time_;
+  metrics["compile_time"] = compile_time_;
+  return metrics;
+}
+}  // namespace pipeline
+}  // namespace mindspore
@@ -0,0 +1,72 @@
+/**
+ * Copyright 2020 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef MINDSPORE_CCSRC_PIPELINE_JIT_COMPILE_CACHE_H_
+#define MINDSPORE_CCSRC_PIPELINE_JIT_COMPILE_CACHE_H_
+
+#include <string>
+#include <unordered_map>
+#include "pybind11/pybind11.h"
+#include "ir/func_graph.h"
+#include "abstract/abstract_value.h"
+
+namespace py = pybind11;
+
+namespace mindspore {
+namespace pipeline {
+// CompileCacheManager keeps the graphs produced by the frontend passes on disk, in the directory given by
+// context.set_context(compile_cache_path=...). A graph is found again by a key made of the structure of the resolved
+// network, the input args_spec, the context options which change the compilation and the framework version, so that
+// a later process compiling the same network skips type inference and the frontend passes.
+class CompileCacheManager {
+ public:
+  ~CompileCacheManager() = default;
+  CompileCacheManager(const CompileCacheManager &) = delete;
+  CompileCacheManager &operator=(const CompileCacheManager &) = delete;
+
+  static CompileCacheManager &GetInstance();
+
+  bool Enabled(const std::string &phase, bool use_vm) const;
+
+  // the key of a resolved graph, empty if it can not be cached
+  std::string GenerateKey(const FuncGraphPtr &resolved_graph, const abstract::AbstractBasePtrList &args_spec);
+
+  // the optimized graph cached for the key, whose weights are rebound to those of the resolved graph, nullptr on a miss
+  FuncGraphPtr Load(const std::string &key, const FuncGraphPtr &resolved_graph);
+
+  void Save(const std::string &key, const FuncGraphPtr &optimized_graph);
+
+  void RecordCompileTime(double compile_time) { compile_time_ += compile_time; }
+
+  py::dict GetMetrics() const;
+
+ private:
+  CompileCacheManager() = default;
+  std::string CacheFile(const std::string &key, const std::string &suffix) const;
+
+  // header of the meta file of a key, checked on loading against hash collisions
+  std::unordered_map<std::string, std::string> headers_;
+  size_t hit_num_{0};
+  size_t miss_num_{0};
+  size_t save_num_{0};
+  size_t skip_num_{0};
+  double load_time_{0};
+  double compile_time_{0};
+};
+}  // namespace pipeline
+}  // namespace mindspore
+
+#endif  // MINDSPORE_CCSRC_PIPELINE_JIT_COMPILE_CACHE_H_
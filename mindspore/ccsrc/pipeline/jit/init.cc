@@ -18,6 +18,9 @@
 #include "backend/kernel_compiler/oplib/oplib.h"
 #include "backend/kernel_compiler/oplib/oploader.h"
 #include "pipeline/jit/pipeline.h"
+#include "pipeline/jit/compile_cache.h"
+#include "pipeline/jit/resolved_graph_cache.h"
+#include "ir/ir_arena.h"
 #include "frontend/operator/composite/composite.h"
 #include "pipeline/pynative/pynative_execute.h"
 #include "utils/symbolic.h"
@@ -28,6 +31,7 @@
 #include "utils/mpi/mpi_config.h"
 #include "frontend/parallel/context.h"
 #include "frontend/parallel/costmodel_context.h"
+#include "backend/optimizer/pass/communication_op_profile.h"
 #ifdef ENABLE_GPU_COLLECTIVE
 #include "runtime/device/gpu/distribution/collective_init.h"
 #else
@@ -108,6 +112,26 @@ PYBIND11_MODULE(_c_expression, m) {
   (void)m.def("init_backend", &mindspore::pipeline::InitBackend, "Init Backend.");
 
   (void)m.def("export_graph", &mindspore::pipeline::ExportGraph, "Export Graph.");
+  (void)m.def(
+    "get_compile_cache_metrics",
+    []() { return mindspore::pipeline::CompileCacheManager::GetInstance().GetMetrics(); },
+    "Get the hit, miss and time metrics of the compile cache.");
+  (void)m.def(
+    "get_incremental_compile_metrics",
+    []() { return mindspore::pipeline::ResolvedGraphCache::GetInstance().GetMetrics(); },
+    "Get the size, hit, miss and saved time metrics of the incremental compile.");
+  (void)m.def(
+    "get_ir_arena_metrics",
+    []() {
+      auto stats = mindspore::IrArena::statistics();
+      py::dict metrics;
+      metrics["allocation"] = stats.allocation_num;
+      metrics["chunk"] = stats.chunk_num;
+      metrics["large_allocation"] = stats.large_allocation_num;
+      metrics["bytes"] = stats.allocated_bytes;
+      return metrics;
+    },
+    "Get the allocation, chunk, large allocation and bytes metrics of the ir arenas.");
 
   (void)py::class_<mindspore::MpiConfig, std::shared_ptr<mindspore::MpiConfig>>(m, "MpiConfig")
     .def_static("get_instance", &mindspore::MpiConfig::GetInstance, "Get mpi config instance.")
@@ -144,6 +168,10 @@ PYBIND11_MODULE(_c_expression, m) {
          "Set enable/disable all reduce fusion.")
     .def("get_enable_all_reduce_fusion", &ParallelContext::enable_all_reduce_fusion,
          "Get enable/disable all reduce fusion.")
+    .def("set_all_reduce_fusion_profile_steps", &ParallelContext::set_all_reduce_fusion_profile_steps,
+         "Set the steps profiling the backward time to split the all reduce fusion.")
+    .def("get_all_reduce_fusion_profile_steps", &ParallelContext::all_reduce_fusion_profile_steps,
+         "Get the steps profiling the backward time to split the all reduce fusion.")
     .def("get_parameter_broadcast", &ParallelContext::parameter_broadcast, "Get parameter broadcast.")
     .def("get_parameter_broadcast_is_set", &ParallelContext::parameter_broadcast_is_set,
          "Get parameter broadcast is set.")
@@ -163,7 +191,14 @@ PYBIND11_MODULE(_c_expression, m) {
          "Set enable/disable parallel optimizer.")
     .def("get_enable_parallel_optimizer", &ParallelContext::enable_parallel_optimizer,
          "Get enable/disable parallel optimizer.")
-    .def("reset", &ParallelContext::Reset, "Reset auto parallel context.");
+    .def(
+      "reset",
+      [](ParallelContext &parallel_context) {
+        parallel_context.Reset();
+        // the split indices profiled before are cleared with the context, so are the groups profiling them
+        mindspore::opt::CommunicationOpProfile::GetInstance().Clear();
+      },
+      "Reset auto parallel context.");
 
   (void)py::class_<CostModelContext, std::shared_ptr<CostModelContext>>(m, "CostModelContext")
     .def_static("get_instance", &CostModelContext::GetInstance, "Get cost_model context instance.")
@@ -182,6 +217,10 @@ PYBIND11_MODULE(_c_expression, m) {
          "Set the parameter cost_model_gamma of the DP algorithm")
     .def("get_costmodel_gamma", &CostModelContext::costmodel_gamma,
          "Get the parameter cost_model_gamma of the DP algorithm.")
+    .def("set_costmodel_calibration_file", &CostModelContext::set_costmodel_calibration_file,
+         "Set the calibration file of the cost model, which sets the computation scales and cost_model_beta.")
+    .def("get_costmodel_calibration_file", &CostModelContext::costmodel_calibration_file,
+         "Get the calibration file of the cost model.")
     .def("set_costmodel_communi_threshold", &CostModelContext::set_costmodel_communi_threshold,
          "Set the parameter cost_model_communi_threshold of the DP algorithm.")
     .def("get_costmodel_communi_threshold", &CostModelContext::costmodel_communi_threshold,
@@ -34,6 +34,7 @@
 #include "frontend/optimizer/irpass.h"
 #include "frontend/optimizer/control_depend.h"
 #include "frontend/optimizer/graph_transform.h"
+#include "frontend/optimizer/recompute.h"
 #include "frontend/parallel/step_parallel.h"
 #include "frontend/parallel/step_auto_parallel.h"
 #include "frontend/parallel/allreduce_fusion/step_allreduce_fusion.h"
@@ -366,6 +367,13 @@ bool AddControlDependPass(const ResourcePtr &res) {
   return true;
 }
 
+bool RecomputePass(const ResourcePtr &res) {
+  FuncGraphPtr func_graph = res->func_graph();
+  MS_EXCEPTION_IF_NULL(func_graph);
+  (void)opt::InsertRecomputedNodes(func_graph);
+  return true;
+}
+
 bool MergeDupGraphPass(const ResourcePtr &res) {
   FuncGraphPtr func_graph = res->func_graph();
   MS_EXCEPTION_IF_NULL(func_graph);
@@ -421,6 +429,8 @@ bool TransformTopGraphPass(const ResourcePtr &res) {
 
 bool PipelineSplitPass(const ResourcePtr &res) { return PipelineSplit(res); }
 
+bool PipelineSchedulePass(const ResourcePtr &res) { return PipelineSchedule(res); }
+
 bool ValidatePass(const ResourcePtr &res) {
   MS_EXCEPTION_IF_NULL(res->func_graph());
   FuncGraphPtr func_graph = res->func_graph();
@@ -450,6 +460,8 @@ bool PynativeOptPass(const ResourcePtr &res) {
 std::vector<PassItem> kVmPasses = {{"simplify_data_structures", SimplifyDataStructuresPass},
                                    {"opt_a", OptPassAGroup},
                                    {"clean_after_opta", CleanAfterOptAPass},
+                                   {"pipeline_schedule", PipelineSchedulePass},
+                                   {"recompute", RecomputePass},
                                    {"opt_b", OptPassBGroup},
                                    {"cconv", CconvPass},
                                    {"opt_after_cconv", OptPassAfterCconvGroup},
@@ -462,6 +474,8 @@ std::vector<PassItem> kVmPasses = {{"simplify_data_structures", SimplifyDataStru
 std::vector<PassItem> kGePasses = {{"simplify_data_structures", SimplifyDataStructuresPass},
                                    {"opt_a", OptPassAGroup},
                                    {"clean_after_opta", CleanAfterOptAPass},
+                                   {"pipeline_schedule", PipelineSchedulePass},
+                                   {"recompute", RecomputePass},
                                    {"opt_b", OptPassBGroup},
                                    {"add_control_depend", AddControlDependPass},
                                    {"opt_control", ControlGroup},
@@ -26,7 +26,11 @@
 #include <iomanip>
 
 #include "ir/param_info.h"
+#include "ir/ir_arena.h"
 #include "pipeline/jit/pass.h"
+#include "pipeline/jit/compile_cache.h"
+#include "pipeline/jit/resolved_graph_cache.h"
+#include "pipeline/jit/parse/parse.h"
 #include "pipeline/jit/parse/data_converter.h"
 #include "frontend/optimizer/ad/dfunctor.h"
 #include "debug/anf_ir_dump.h"
@@ -48,6 +52,7 @@
 #include "pybind_api/pybind_patch.h"
 #include "utils/shape_utils.h"
 #include "utils/info.h"
+#include "utils/profile.h"
 #if (ENABLE_CPU && (ENABLE_D || ENABLE_GPU))
 #include "ps/common.h"
 #include "ps/util.h"
@@ -271,6 +276,7 @@ py::dict ExecutorPy::GetAllreduceFusion(const std::string &phase) {
 }
 
 void ExecutorPy::DelNetRes(const std::string &id) {
+  ResolvedGraphCache::GetInstance().Erase(id);
 #ifdef ENABLE_GE
   FinalizeBackend();
 #else
@@ -303,6 +309,7 @@ void ExecutorPy::DelNetRes(const std::string &id) {
 void ExecutorPy::ClearRes() {
   MS_LOG(INFO) << "Clean executor resource!";
   Resource::ClearPrimitivePyPythonObj();
+  ResolvedGraphCache::GetInstance().Clear();
   executor_ = nullptr;
 }
 
@@ -450,6 +457,80 @@ std::vector<ActionItem> GetPipline(const ResourcePtr &resource, const std::strin
   return GePipeline();
 }
 
+// Runs the actions through the compile cache: the graph is resolved first to compute its key, then either the cached
+// optimized graph goes straight to the actions after 'validate', or the remaining actions run and their result is
+// saved.
+void RunPipelineWithCompileCache(const ResourcePtr &resource, const std::vector<ActionItem> &actions) {
+  MS_EXCEPTION_IF_NULL(resource);
+  auto is_action = [](const std::string &name) {
+    return [name](const ActionItem &item) { return item.first == name; };
+  };
+  auto resolve_iter = std::find_if(actions.begin(), actions.end(), is_action("symbol_resolve"));
+  auto validate_iter = std::find_if(actions.begin(), actions.end(), is_action("validate"));
+  if (resolve_iter == actions.end() || validate_iter == actions.end() || resolve_iter > validate_iter) {
+    Pipeline(resource, actions).Run();
+    return;
+  }
+  Pipeline(resource, std::vector<ActionItem>(actions.begin(), resolve_iter + 1)).Run();
+
+  auto &compile_cache = CompileCacheManager::GetInstance();
+  auto key = compile_cache.GenerateKey(resource->func_graph(), resource->args_spec());
+  auto cached_graph = compile_cache.Load(key, resource->func_graph());
+  if (cached_graph != nullptr) {
+    auto manager = resource->manager();
+    MS_EXCEPTION_IF_NULL(manager);
+    manager->AddFuncGraph(cached_graph, true);
+    manager->KeepRoots({cached_graph});
+    resource->set_func_graph(cached_graph);
+    Pipeline(resource, std::vector<ActionItem>(validate_iter + 1, actions.end())).Run();
+    return;
+  }
+
+  double start = GetTime();
+  std::vector<ActionItem> compile_actions(resolve_iter + 1, validate_iter + 1);
+  compile_actions.emplace_back("compile_cache_save", [key, start](const ResourcePtr &res) {
+    auto &compile_cache = CompileCacheManager::GetInstance();
+    compile_cache.RecordCompileTime(GetTime() - start);
+    compile_cache.Save(key, res->func_graph());
+    return true;
+  });
+  compile_actions.insert(compile_actions.end(), validate_iter + 1, actions.end());
+  Pipeline(resource, compile_actions).Run();
+}
+
+// Runs the actions from the type inference on a copy of the graph resolved by an earlier compilation of the same
+// network with other inputs, or runs all the actions and keeps the graph as it is before the type inference.
+void RunPipelineIncrementally(const ResourcePtr &resource, const std::vector<ActionItem> &actions,
+                              const std::string &key) {
+  MS_EXCEPTION_IF_NULL(resource);
+  auto specialize_iter = std::find_if(actions.begin(), actions.end(),
+                                      [](const ActionItem &item) { return item.first == "abstract_specialize"; });
+  if (specialize_iter == actions.end()) {
+    Pipeline(resource, actions).Run();
+    return;
+  }
+  auto resolved_graph = ResolvedGraphCache::GetInstance().Load(key);
+  if (resolved_graph != nullptr) {
+    parse::Parser::InitParserEnvironment(resource->input());
+    parse::Parser::UpdateTopFuncGraph(resolved_graph);
+    auto manager = resource->manager();
+    MS_EXCEPTION_IF_NULL(manager);
+    manager->AddFuncGraph(resolved_graph, true);
+    resource->set_func_graph(resolved_graph);
+    Pipeline(resource, std::vector<ActionItem>(specialize_iter, actions.end())).Run();
+    return;
+  }
+
+  double start = GetTime();
+  std::vector<ActionItem> resolve_actions(actions.begin(), specialize_iter);
+  resolve_actions.emplace_back("resolved_graph_save", [key, start](const ResourcePtr &res) {
+    ResolvedGraphCache::GetInstance().Save(key, res->func_graph(), GetTime() - start);
+    return true;
+  });
+  resolve_actions.insert(resolve_actions.end(), specialize_iter, actions.end());
+  Pipeline(resource, resolve_actions).Run();
+}
+
 bool ExecutorPy::CompileInner(const py::object &obj, const py::tuple &args, const py::object &phase, bool use_vm) {
   MS_LOG(DEBUG) << "Start ExecutorPy compile!";
   if ((!py::isinstance<py::str>(phase))) {
@@ -493,7 +574,21 @@ bool ExecutorPy::CompileInner(const py::object &obj, const py::tuple &args, cons
   executor_info->arg_list_size = size;
   executor_info->resource = resource;
   info_[phase_s] = executor_info;
-  pip->Run();
+  std::string resolved_graph_key;
+  if (ResolvedGraphCache::GetInstance().Enabled(phase_s, use_vm)) {
+    resolved_graph_key = ResolvedGraphCache::GenerateKey(phase_s, obj);
+  }
+  {
+    // the nodes created by the pipeline are allocated from the arena of the resource if it has one
+    IrArenaScope arena_scope(resource->ir_arena());
+    if (CompileCacheManager::GetInstance().Enabled(phase_s, use_vm)) {
+      RunPipelineWithCompileCache(resource, p_actions);
+    } else if (!resolved_graph_key.empty()) {
+      RunPipelineIncrementally(resource, p_actions, resolved_graph_key);
+    } else {
+      pip->Run();
+    }
+  }
 
   // save the run graph func to MsPipeLine
   SaveCompiledGraph(phase_s);
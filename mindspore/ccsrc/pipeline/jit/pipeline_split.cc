@@ -21,6 +21,7 @@
 #include "utils/comm_manager.h"
 #include "frontend/parallel/context.h"
 #include "frontend/parallel/pipeline_transformer/pipeline_transformer.h"
+#include "frontend/parallel/pipeline_transformer/pipeline_scheduler.h"
 #include "frontend/parallel/step_parallel.h"
 
 namespace mindspore {
@@ -103,6 +104,24 @@ bool PipelineSplit(const ResourcePtr &res) {
   // step6: Elim Graph stages and no used parameter
   transformer->ElimGraphStage();
   transformer->ElimParameter();
+  // step7: Schedule the micro batches
+  transformer->ScheduleMicroBatches();
+  return true;
+}
+
+// The backward of the micro batches is generated by automatic differentiation, after which the forward and backward
+// of the micro batches are ordered by the schedule of the stage
+bool PipelineSchedule(const ResourcePtr &res) {
+  auto parallel_mode = parallel::ParallelContext::GetInstance()->parallel_mode();
+  if (parallel_mode != parallel::SEMI_AUTO_PARALLEL && parallel_mode != parallel::AUTO_PARALLEL) {
+    return true;
+  }
+  auto stage_num = parallel::ParallelContext::GetInstance()->pipeline_stage_split_num();
+  if (stage_num <= 1) {
+    return true;
+  }
+  auto stage = InferStage(GetRank(), stage_num, parallel::ParallelContext::GetInstance()->device_num());
+  (void)parallel::EnforceMicroBatchSchedule(res->func_graph(), stage, stage_num);
   return true;
 }
 }  // namespace pipeline
@@ -22,6 +22,7 @@
 namespace mindspore {
 namespace pipeline {
 bool PipelineSplit(const ResourcePtr &res);
+bool PipelineSchedule(const ResourcePtr &res);
 }  // namespace pipeline
 }  // namespace mindspore
 
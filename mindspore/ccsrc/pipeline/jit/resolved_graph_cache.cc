@@ -0,0 +1,129 @@
+/**
+ * Copyright 2020 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "pipeline/jit/resolved_graph_cache.h"
+
+#include <cctype>
+
+#include "ir/cell.h"
+#include "ir/func_graph_cloner.h"
+#include "utils/ms_context.h"
+#include "utils/log_adapter.h"
+#include "pipeline/jit/base.h"
+#include "pipeline/jit/parse/parse_base.h"
+#include "frontend/parallel/context.h"
+#if (ENABLE_CPU && (ENABLE_D || ENABLE_GPU))
+#include "ps/util.h"
+#endif
+
+namespace mindspore {
+namespace pipeline {
+ResolvedGraphCache &ResolvedGraphCache::GetInstance() {
+  static ResolvedGraphCache instance;
+  return instance;
+}
+
+bool ResolvedGraphCache::Enabled(const std::string &phase, bool use_vm) const {
+  auto context = MsContext::GetInstance();
+  MS_EXCEPTION_IF_NULL(context);
+  if (!context->get_param<bool>(MS_CTX_ENABLE_INCREMENTAL_COMPILE)) {
+    return false;
+  }
+  if (!use_vm || context->get_param<int>(MS_CTX_EXECUTION_MODE) != kGraphMode || context->backend_policy() == "ge" ||
+      GetPhasePrefix(phase).rfind("export", 0) != std::string::npos) {
+    return false;
+  }
+#if (ENABLE_CPU && (ENABLE_D || ENABLE_GPU))
+  if (ps::Util::IsParamServerMode()) {
+    return false;
+  }
+#endif
+  auto parallel_mode = parallel::ParallelContext::GetInstance()->parallel_mode();
+  if (parallel_mode != parallel::STAND_ALONE && parallel_mode != parallel::DATA_PARALLEL) {
+    MS_LOG(INFO) << "Incremental compile is not supported in parallel mode " << parallel_mode;
+    return false;
+  }
+  return true;
+}
+
+std::string ResolvedGraphCache::GenerateKey(const std::string &phase, const py::object &obj) {
+  // a function may be redefined with the same name, only the cells are identified by their phases
+  if (!py::isinstance<Cell>(obj)) {
+    return "";
+  }
+  // the phase of a compilation is the key of its inputs followed by the phase of the network, which ends with the id
+  // of the network, so the key keeps the network id as its last component
+  size_t pos = 0;
+  while (pos < phase.size() && std::isdigit(static_cast<unsigned char>(phase[pos]))) {
+    ++pos;
+  }
+  std::string key = phase.substr(pos);
+  if (py::hasattr(obj, parse::PYTHON_EXTERN_PARSE_METHOD)) {
+    auto parse_method = py::getattr(obj, parse::PYTHON_EXTERN_PARSE_METHOD);
+    if (py::isinstance<py::str>(parse_method)) {
+      key = py::cast<std::string>(parse_method) + "." + key;
+    }
+  }
+  return key;
+}
+
+bool ResolvedGraphCache::IsKeyOfNetwork(const std::string &key, const std::string &network_id) {
+  auto pos = key.rfind('.');
+  auto id_pos = pos == std::string::npos ? 0 : pos + 1;
+  return key.compare(id_pos, std::string::npos, network_id) == 0;
+}
+
+FuncGraphPtr ResolvedGraphCache::Load(const std::string &key) {
+  auto iter = graphs_.find(key);
+  if (iter == graphs_.end()) {
+    ++miss_num_;
+    return nullptr;
+  }
+  ++hit_num_;
+  saved_time_ += iter->second.resolve_time;
+  MS_LOG(INFO) << "Reuse the resolved graph of " << key << " for the new inputs.";
+  return BasicClone(iter->second.graph);
+}
+
+void ResolvedGraphCache::Save(const std::string &key, const FuncGraphPtr &resolved_graph, double resolve_time) {
+  MS_EXCEPTION_IF_NULL(resolved_graph);
+  // the graph given to the resource is changed by the actions after, keep a copy of it
+  graphs_[key] = {BasicClone(resolved_graph), resolve_time};
+}
+
+void ResolvedGraphCache::Erase(const std::string &network_id) {
+  if (network_id.empty()) {
+    return;
+  }
+  for (auto iter = graphs_.begin(); iter != graphs_.end();) {
+    if (IsKeyOfNetwork(iter->first, network_id)) {
+      iter = graphs_.erase(iter);
+    } else {
+      ++iter;
+    }
+  }
+}
+
+py::dict ResolvedGraphCache::GetMetrics() const {
+  py::dict metrics;
+  metrics["size"] = graphs_.size();
+  metrics["hit"] = hit_num_;
+  metrics["miss"] = miss_num_;
+  metrics["saved_time"] = saved_time_;
+  return metrics;
+}
+}  // namespace pipeline
+}  // namespace mindspore
@@ -0,0 +1,76 @@
+/**
+ * Copyright 2020 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef MINDSPORE_CCSRC_PIPELINE_JIT_RESOLVED_GRAPH_CACHE_H_
+#define MINDSPORE_CCSRC_PIPELINE_JIT_RESOLVED_GRAPH_CACHE_H_
+
+#include <string>
+#include <unordered_map>
+#include "pybind11/pybind11.h"
+#include "ir/func_graph.h"
+
+namespace py = pybind11;
+
+namespace mindspore {
+namespace pipeline {
+// ResolvedGraphCache keeps the graph of a network as it is before type inference, that is after parsing, resolving
+// and the passes which do not depend on the inputs, when context.set_context(enable_incremental_compile=True). A
+// later compilation of the same network with inputs of other shapes or types starts from a copy of it, so only the
+// specialization for the new inputs and the actions after it are run again.
+class ResolvedGraphCache {
+ public:
+  ~ResolvedGraphCache() = default;
+  ResolvedGraphCache(const ResolvedGraphCache &) = delete;
+  ResolvedGraphCache &operator=(const ResolvedGraphCache &) = delete;
+
+  static ResolvedGraphCache &GetInstance();
+
+  bool Enabled(const std::string &phase, bool use_vm) const;
+
+  // the key shared by all the compilations of the method of a network, empty if the object is not a cell
+  static std::string GenerateKey(const std::string &phase, const py::object &obj);
+
+  // a copy of the graph cached for the key, nullptr on a miss
+  FuncGraphPtr Load(const std::string &key);
+
+  void Save(const std::string &key, const FuncGraphPtr &resolved_graph, double resolve_time);
+
+  // drop the graphs of the network whose keys end with the id
+  void Erase(const std::string &network_id);
+
+  void Clear() { graphs_.clear(); }
+
+  py::dict GetMetrics() const;
+
+ private:
+  struct CacheEntry {
+    FuncGraphPtr graph;
+    // the time spent to get the graph, saved by each hit
+    double resolve_time;
+  };
+
+  ResolvedGraphCache() = default;
+  static bool IsKeyOfNetwork(const std::string &key, const std::string &network_id);
+
+  std::unordered_map<std::string, CacheEntry> graphs_;
+  size_t hit_num_{0};
+  size_t miss_num_{0};
+  double saved_time_{0};
+};
+}  // namespace pipeline
+}  // namespace mindspore
+
+#endif  // MINDSPORE_CCSRC_PIPELINE_JIT_RESOLVED_GRAPH_CACHE_H_
@@ -17,6 +17,7 @@
  */
 
 #include "pipeline/jit/resource.h"
+#include "utils/ms_context.h"
 #include "pipeline/jit/static_analysis/static_analysis.h"
 #include "debug/trace.h"
 #include "ir/dtype.h"
@@ -212,7 +213,11 @@ BuiltInTypeMap &GetAttrMap() {
 Resource::Resource(const py::object &obj)
     : engine_(std::make_shared<abstract::AnalysisEngine>(abstract::GetPrimEvaluatorConstructors(), manager_)),
       input_(obj),
-      is_cleaned_(false) {}
+      is_cleaned_(false) {
+  if (MsContext::GetInstance()->get_param<bool>(MS_CTX_ENABLE_IR_ARENA)) {
+    ir_arena_ = std::make_shared<IrArena>();
+  }
+}
 
 Resource::~Resource() {
   MS_LOG(DEBUG) << "Resource clear";
@@ -323,6 +328,8 @@ void Resource::Clean() {
   parse::Parser::CleanParserResource();
   parse::CleanDataClassToClassMap();
   trace::ClearTraceStack();
+  // the nodes kept by the compiled graphs release their chunks when they are destroyed
+  ir_arena_ = nullptr;
   is_cleaned_ = true;
 }
 }  // namespace pipeline
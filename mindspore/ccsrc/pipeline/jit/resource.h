@@ -29,6 +29,7 @@
 #include "utils/any.h"
 #include "utils/profile.h"
 #include "ir/manager.h"
+#include "ir/ir_arena.h"
 
 #include "pipeline/jit/resource_base.h"
 #include "pipeline/jit/static_analysis/prim.h"
@@ -80,6 +81,8 @@ class Resource : public ResourceBase {
   }
   bool gpu_loopsink_flag() { return gpu_loopsink_flag_; }
   int64_t gpu_loopsink_size() { return gpu_loopsink_size_; }
+  // the arena of the nodes created while compiling, nullptr if they are allocated from the heap
+  IrArena *ir_arena() const { return ir_arena_.get(); }
   static void RecordPrimitivePy(PrimitivePy *prim);
   static void ErasePrimitivePy(PrimitivePy *prim);
   static void ClearPrimitivePyPythonObj();
@@ -96,6 +99,7 @@ class Resource : public ResourceBase {
   bool is_cleaned_;
   bool gpu_loopsink_flag_{false};
   int64_t gpu_loopsink_size_{1};
+  IrArenaPtr ir_arena_{nullptr};
   static std::unordered_map<PrimitivePy *, bool> py_objs_;
 };
 
@@ -23,6 +23,7 @@
 #include "ir/func_graph_cloner.h"
 #include "abstract/utils.h"
 #include "debug/trace.h"
+#include "pipeline/jit/static_analysis/parallel_infer.h"
 #include "utils/ms_context.h"
 
 namespace mindspore {
@@ -103,13 +104,24 @@ EvalResultPtr BaseFuncGraphEvaluator::Eval(AnalysisEnginePtr engine, const Abstr
     }
     return FOLLOW;
   });
-  for (const auto &node : all_nodes) {
+  std::shared_ptr<ParallelPrimInfer> parallel_infer = nullptr;
+  if (ParallelPrimInfer::Enabled()) {
+    parallel_infer = std::make_shared<ParallelPrimInfer>(engine, graph_context_, all_nodes);
+  }
+  for (size_t i = 0; i < all_nodes.size(); ++i) {
+    const auto &node = all_nodes[i];
+    if (parallel_infer != nullptr) {
+      parallel_infer->InferReadyNodes();
+    }
     AnfNodeConfigPtr node_conf = engine->MakeConfig(node, graph_context_);
     MS_LOG(DEBUG) << "Analysis node begin, func graph: " << fg.get() << fg->ToString()
                   << ", node_conf: " << node_conf->ToString();
     ret_base = engine->GetEvaluatedValue(node_conf)->abstract();
     MS_LOG(DEBUG) << "Analysis node end, func graph: " << fg.get() << fg->ToString()
                   << ", node_conf: " << node_conf->ToString() << ", abstract: " << ret_base->ToString();
+    if (parallel_infer != nullptr) {
+      parallel_infer->SetEvaluated(i);
+    }
   }
   engine->DecreaseFunctionCallDepth();
 
@@ -0,0 +1,204 @@
+/**
+ * Copyright 2020 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "pipeline/jit/static_analysis/parallel_infer.h"
+
+#include <algorithm>
+#include <exception>
+#include <unordered_map>
+#include <unordered_set>
+
+#include "common/thread_pool.h"
+#include "debug/trace.h"
+#include "utils/ms_context.h"
+
+namespace mindspore {
+namespace abstract {
+namespace {
+// fewer ready nodes do not pay for waking up the thread pool
+constexpr size_t kMinParallelInferNodes = 4;
+}  // namespace
+
+ParallelPrimInfer::ParallelPrimInfer(const AnalysisEnginePtr &engine, const AnalysisContextPtr &context,
+                                     const AnfNodePtrList &nodes)
+    : engine_(engine), context_(context), nodes_(nodes) {
+  MS_EXCEPTION_IF_NULL(engine_);
+  std::unordered_map<AnfNodePtr, size_t> node_indexes;
+  for (size_t i = 0; i < nodes_.size(); ++i) {
+    node_indexes[nodes_[i]] = i;
+  }
+  users_.resize(nodes_.size());
+  pending_inputs_.assign(nodes_.size(), 0);
+  evaluated_.assign(nodes_.size(), false);
+  for (size_t i = 0; i < nodes_.size(); ++i) {
+    auto cnode = nodes_[i]->cast<CNodePtr>();
+    if (cnode == nullptr) {
+      continue;
+    }
+    for (const auto &input : cnode->inputs()) {
+      auto iter = node_indexes.find(input);
+      // the parameters are evaluated before any node of the graph
+      if (iter == node_indexes.end() || !input->isa<CNode>()) {
+        continue;
+      }
+      users_[iter->second].push_back(i);
+      ++pending_inputs_[i];
+    }
+  }
+  for (size_t i = 0; i < nodes_.size(); ++i) {
+    if (pending_inputs_[i] == 0 && MayInfer(i)) {
+      ready_nodes_.push_back(i);
+    }
+  }
+}
+
+bool ParallelPrimInfer::Enabled() {
+  auto context = MsContext::GetInstance();
+  MS_EXCEPTION_IF_NULL(context);
+  return context->get_param<bool>(MS_CTX_ENABLE_PARALLEL_INFER);
+}
+
+bool ParallelPrimInfer::MayInfer(size_t index) const {
+  auto cnode = nodes_[index]->cast<CNodePtr>();
+  return cnode != nullptr && !cnode->inputs().empty() && IsValueNode<Primitive>(cnode->input(0));
+}
+
+void ParallelPrimInfer::SetEvaluated(size_t index) {
+  if (evaluated_[index]) {
+    return;
+  }
+  evaluated_[index] = true;
+  for (auto user : users_[index]) {
+    if (--pending_inputs_[user] == 0 && !evaluated_[user] && MayInfer(user)) {
+      ready_nodes_.push_back(user);
+    }
+  }
+}
+
+bool ParallelPrimInfer::PrepareTask(size_t index, InferTask *task) {
+  MS_EXCEPTION_IF_NULL(task);
+  auto cnode = nodes_[index]->cast<CNodePtr>();
+  MS_EXCEPTION_IF_NULL(cnode);
+  auto conf = engine_->MakeConfig(cnode, context_);
+  if (engine_->cache().GetValue(conf) != nullptr) {
+    return false;
+  }
+  // the primitive value node is evaluated the same way as in order
+  auto func = engine_->MakeConfig(cnode->input(0), context_)->GetEvaluatedValue()->abstract();
+  auto prim_func = dyn_cast<PrimitiveAbstractClosure>(func);
+  if (prim_func == nullptr) {
+    return false;
+  }
+  auto evaluator = dyn_cast<StandardPrimEvaluator>(engine_->GetEvaluatorFor(prim_func));
+  if (evaluator == nullptr) {
+    return false;
+  }
+  // the infer functions of the frontend call back into the engine or into python
+  auto prim = evaluator->prim();
+  if (prim->prim_type() == kPrimTypePyInferCheck || !IsInWhiteList(prim)) {
+    return false;
+  }
+  AbstractBasePtrList args_spec_list;
+  const auto &inputs = cnode->inputs();
+  for (size_t i = 1; i < inputs.size(); ++i) {
+    auto input_conf = engine_->MakeConfig(inputs[i], context_);
+    auto result = engine_->cache().GetValue(input_conf);
+    if (result == nullptr) {
+      // the free variables are evaluated by their own graphs
+      if (!inputs[i]->isa<ValueNode>() || IsValueNode<FuncGraph>(inputs[i]) || IsValueNode<MetaFuncGraph>(inputs[i]) ||
+          IsValueNode<Primitive>(inputs[i])) {
+        return false;
+      }
+      result = input_conf->GetEvaluatedValue();
+    }
+    MS_EXCEPTION_IF_NULL(result);
+    args_spec_list.push_back(result->abstract());
+  }
+  task->index = index;
+  task->conf = conf;
+  task->evaluator = evaluator;
+  task->args_spec_list = std::move(args_spec_list);
+  return true;
+}
+
+void ParallelPrimInfer::RunTasks(std::vector<InferTask> *tasks) {
+  MS_EXCEPTION_IF_NULL(tasks);
+  size_t thread_num = std::min(tasks->size(), static_cast<size_t>(kDefaultMaxThreadNum));
+  std::vector<Task> thread_tasks;
+  for (size_t thread_id = 0; thread_id < thread_num; ++thread_id) {
+    thread_tasks.emplace_back([this, tasks, thread_id, thread_num]() {
+      trace::SetTraceProviderEnabledInThread(false);
+      for (size_t i = thread_id; i < tasks->size(); i += thread_num) {
+        auto &task = (*tasks)[i];
+        try {
+          auto result = task.evaluator->EvalPrim(engine_, task.args_spec_list);
+          if (result != nullptr && result->abstract() != nullptr) {
+            engine_->cache().set_value(task.conf, result);
+            task.done = true;
+          }
+        } catch (const std::exception &e) {
+          MS_LOG(DEBUG) << "Infer node " << task.conf->node()->DebugString()
+                        << " in parallel failed, leave it to the evaluation in order: " << e.what();
+        } catch (...) {
+          MS_LOG(DEBUG) << "Infer node " << task.conf->node()->DebugString()
+                        << " in parallel failed, leave it to the evaluation in order.";
+        }
+      }
+      trace::SetTraceProviderEnabledInThread(true);
+      return SUCCESS;
+    });
+  }
+  if (!ThreadPool::GetInstance()->LaunchMultipleTask(thread_tasks)) {
+    MS_LOG(WARNING) << "Launch the parallel infer tasks failed, the nodes are left to the evaluation in order.";
+  }
+}
+
+void ParallelPrimInfer::InferReadyNodes() {
+  (void)ready_nodes_.erase(
+    std::remove_if(ready_nodes_.begin(), ready_nodes_.end(), [this](size_t index) { return evaluated_[index]; }),
+    ready_nodes_.end());
+  if (ready_nodes_.size() < kMinParallelInferNodes) {
+    return;
+  }
+  std::vector<InferTask> tasks;
+  std::vector<size_t> deferred_nodes;
+  std::unordered_set<Primitive *> prims;
+  for (auto index : ready_nodes_) {
+    InferTask task;
+    if (!PrepareTask(index, &task)) {
+      continue;
+    }
+    // the evaluator records the attributes added to its primitive while inferring, so one node a primitive at a time
+    if (!prims.insert(task.evaluator->prim().get()).second) {
+      deferred_nodes.push_back(index);
+      continue;
+    }
+    tasks.push_back(std::move(task));
+  }
+  ready_nodes_.swap(deferred_nodes);
+  if (tasks.size() < kMinParallelInferNodes) {
+    return;
+  }
+  MS_LOG(DEBUG) << "Infer " << tasks.size() << " nodes in parallel, context: " << context_->ToString();
+  RunTasks(&tasks);
+  for (const auto &task : tasks) {
+    if (task.done) {
+      SetEvaluated(task.index);
+    }
+  }
+}
+}  // namespace abstract
+}  // namespace mindspore
@@ -0,0 +1,68 @@
+/**
+ * Copyright 2020 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef MINDSPORE_CCSRC_PIPELINE_JIT_STATIC_ANALYSIS_PARALLEL_INFER_H_
+#define MINDSPORE_CCSRC_PIPELINE_JIT_STATIC_ANALYSIS_PARALLEL_INFER_H_
+
+#include <vector>
+#include "pipeline/jit/static_analysis/static_analysis.h"
+#include "pipeline/jit/static_analysis/prim.h"
+
+namespace mindspore {
+namespace abstract {
+// ParallelPrimInfer infers the nodes of a func graph calling primitives with c++ infer functions on the thread pool,
+// ahead of the evaluation of the nodes in topological order. The nodes whose inputs inside the graph are all evaluated
+// are inferred together and their results are put into the analysis cache, where the evaluation in order finds them.
+// The nodes which can not be inferred so, and those whose infer fails, are left to the evaluation in order, which also
+// reports their errors.
+class ParallelPrimInfer {
+ public:
+  ParallelPrimInfer(const AnalysisEnginePtr &engine, const AnalysisContextPtr &context, const AnfNodePtrList &nodes);
+  ~ParallelPrimInfer() = default;
+
+  static bool Enabled();
+  // infer the ready nodes if there are enough of them, called before evaluating a node in order
+  void InferReadyNodes();
+  // called when nodes[index] is evaluated
+  void SetEvaluated(size_t index);
+
+ private:
+  struct InferTask {
+    size_t index{0};
+    AnfNodeConfigPtr conf{nullptr};
+    StandardPrimEvaluatorPtr evaluator{nullptr};
+    AbstractBasePtrList args_spec_list;
+    bool done{false};
+  };
+
+  bool MayInfer(size_t index) const;
+  bool PrepareTask(size_t index, InferTask *task);
+  void RunTasks(std::vector<InferTask> *tasks);
+
+  AnalysisEnginePtr engine_;
+  AnalysisContextPtr context_;
+  const AnfNodePtrList &nodes_;
+  // the indexes of the users of each node inside the graph
+  std::vector<std::vector<size_t>> users_;
+  // the number of the inputs of each node inside the graph which are not evaluated yet
+  std::vector<size_t> pending_inputs_;
+  std::vector<bool> evaluated_;
+  std::vector<size_t> ready_nodes_;
+};
+}  // namespace abstract
+}  // namespace mindspore
+
+#endif  // MINDSPORE_CCSRC_PIPELINE_JIT_STATIC_ANALYSIS_PARALLEL_INFER_H_
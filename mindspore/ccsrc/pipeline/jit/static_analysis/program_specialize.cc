@@ -165,6 +165,10 @@ AnfNodePtr FuncGraphSpecializer::GetReplicatedNode(const AnfNodePtr &node) {
   if (iter != specializer->repl_node_->end()) {
     return iter->second;
   }
+  // the nodes of the graph are cloned on their first use, the inputs are set when the node is processed
+  if (node->isa<CNode>() && fg == specializer->func_graph_ && fg->nodes().contains(node)) {
+    return specializer->cloner_->CloneDisconnected(node);
+  }
   return node;
 }
 
@@ -245,6 +249,8 @@ void FuncGraphSpecializer::ProcessNode(const AnfNodePtr &node) {
     auto c_new = new_node->cast<CNodePtr>();
     auto new_inputs = c_new->inputs();
     auto old_inputs = c_old->inputs();
+    // the node cloned on demand has no inputs yet
+    new_inputs.resize(old_inputs.size());
     for (size_t i = 0; i < old_inputs.size(); ++i) {
       auto node_input = old_inputs[i];
       AnfNodeConfigPtr iconf = MakeConfig(node_input);
@@ -54,11 +54,26 @@ AbstractBasePtr IntermediateJoin(const AbstractBasePtr &arg1, const AbstractBase
   return nullptr;
 }
 
+AnalysisCache::Shard &AnalysisCache::GetShard(const AnfNodeConfigPtr &conf) {
+  return shards_[AnfNodeConfigHasher{}(conf) % kShardNum];
+}
+
+void AnalysisCache::Clear() {
+  for (auto &shard : shards_) {
+    std::lock_guard<std::mutex> lock(shard.lock);
+    shard.cache.clear();
+  }
+}
+
 void AnalysisCache::set_value(const AnfNodeConfigPtr &conf, const EvalResultPtr &result) {
   MS_LOG(DEBUG) << "AnalysisCache set for NodeConfig: " << conf->node()->DebugString()
                 << ", Context: " << conf->context()->ToString() << ", Value: " << result->abstract()->ToString()
                 << ", Pointer: " << result->abstract().get();
-  cache_[conf] = result;
+  auto &shard = GetShard(conf);
+  {
+    std::lock_guard<std::mutex> lock(shard.lock);
+    shard.cache[conf] = result;
+  }
 
   // Set intermediate abstract value.
   if (IsIntermediateAbstract(result->abstract())) {
@@ -77,8 +92,10 @@ void AnalysisCache::set_value(const AnfNodeConfigPtr &conf, const EvalResultPtr
 }
 
 EvalResultPtr AnalysisCache::GetValue(const AnfNodeConfigPtr &conf) {
-  auto value = cache_.find(conf);
-  if (value == cache_.end()) {
+  auto &shard = GetShard(conf);
+  std::lock_guard<std::mutex> lock(shard.lock);
+  auto value = shard.cache.find(conf);
+  if (value == shard.cache.end()) {
     return nullptr;
   }
   return value->second;
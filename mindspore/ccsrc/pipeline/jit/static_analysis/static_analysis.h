@@ -19,8 +19,10 @@
 #ifndef MINDSPORE_CCSRC_PIPELINE_JIT_STATIC_ANALYSIS_STATIC_ANALYSIS_H_
 #define MINDSPORE_CCSRC_PIPELINE_JIT_STATIC_ANALYSIS_STATIC_ANALYSIS_H_
 
+#include <array>
 #include <list>
 #include <memory>
+#include <mutex>
 #include <string>
 #include <unordered_map>
 #include <vector>
@@ -152,17 +154,25 @@ class VirtualConfig : public Config {
   AbstractBasePtr abstract_;
 };
 
-// AnalysisCache
+// AnalysisCache is split into shards by the hash of the config, each shard has its own lock, so that the nodes
+// inferred in parallel read their inputs and save their results without waiting for each other.
 class AnalysisCache {
  public:
   AnalysisCache() = default;
   ~AnalysisCache() = default;
-  void Clear() { cache_.clear(); }
+  void Clear();
   void set_value(const AnfNodeConfigPtr &conf, const EvalResultPtr &arg);
   EvalResultPtr GetValue(const AnfNodeConfigPtr &conf);
 
  private:
-  std::unordered_map<AnfNodeConfigPtr, EvalResultPtr, AnfNodeConfigHasher, AnfNodeConfigEqual> cache_;
+  static constexpr size_t kShardNum = 16;
+  struct Shard {
+    std::mutex lock;
+    std::unordered_map<AnfNodeConfigPtr, EvalResultPtr, AnfNodeConfigHasher, AnfNodeConfigEqual> cache;
+  };
+  Shard &GetShard(const AnfNodeConfigPtr &conf);
+
+  std::array<Shard, kShardNum> shards_;
 };
 
 using PrimEvaluatorMap = std::unordered_map<PrimitivePtr, EvaluatorPtr, PrimitiveHasher, PrimitiveEqual>;
@@ -185,7 +195,7 @@ struct PartialAppHasher {
 class AnalysisEngine : public std::enable_shared_from_this<AnalysisEngine> {
  public:
   AnalysisEngine(const PrimEvaluatorMap &prim_evaluator_map, const FuncGraphManagerPtr &func_graph_manager)
-      : cache_(AnalysisCache()), prim_constructors_(prim_evaluator_map), func_graph_manager_(func_graph_manager) {
+      : prim_constructors_(prim_evaluator_map), func_graph_manager_(func_graph_manager) {
     function_call_depth_ = 0;
     forward_count_ = 0;
   }
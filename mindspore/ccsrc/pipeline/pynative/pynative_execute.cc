@@ -70,6 +70,7 @@ const std::set<std::string> vm_operators = {"make_ref", "HookBackward", "InsertG
 
 namespace mindspore::pynative {
 static std::shared_ptr<session::SessionBasic> session = nullptr;
+static session::OpTrace recorded_op_trace;
 PynativeExecutorPtr PynativeExecutor::executor_ = nullptr;
 std::mutex PynativeExecutor::instance_lock_;
 int64_t PynativeExecutor::graph_id_ = 0;
@@ -254,32 +255,39 @@ void PynativeInfer(const PrimitivePyPtr &prim, const py::list &py_args, OpExecIn
   MS_LOG(DEBUG) << "Prim " << prim->name() << " infer result " << op_exec_info->abstract->ToString();
 }
 
-std::string GetSingleOpGraphInfo(const OpExecInfoPtr &op_exec_info,
-                                 const std::vector<tensor::TensorPtr> &input_tensors) {
-  MS_EXCEPTION_IF_NULL(op_exec_info);
+// it is computed for every op run, so the pieces are appended in place instead of concatenating temporary strings
+std::string GetInputTensorsInfo(const std::vector<tensor::TensorPtr> &input_tensors) {
+  const size_t kTensorInfoReserveSize = 32;
   std::string graph_info;
-  // get input tensor info
+  graph_info.reserve(input_tensors.size() * kTensorInfoReserveSize);
   for (const auto &tensor : input_tensors) {
     MS_EXCEPTION_IF_NULL(tensor);
-    auto tensor_shape = tensor->shape();
-    (void)std::for_each(tensor_shape.begin(), tensor_shape.end(),
-                        [&](const auto &dim) { (void)graph_info.append(std::to_string(dim) + "_"); });
-    (void)graph_info.append(std::to_string(tensor->data_type()) + "_");
-    if (tensor->device_address() != nullptr) {
-      (void)graph_info.append(
-        std::to_string(std::dynamic_pointer_cast<device::DeviceAddress>(tensor->device_address())->type_id()) + "_");
-      (void)graph_info.append(std::dynamic_pointer_cast<device::DeviceAddress>(tensor->device_address())->format() +
-                              "_");
+    for (const auto &dim : tensor->shape()) {
+      (void)graph_info.append(std::to_string(dim)).append(1, '_');
+    }
+    (void)graph_info.append(std::to_string(tensor->data_type())).append(1, '_');
+    auto device_address = std::dynamic_pointer_cast<device::DeviceAddress>(tensor->device_address());
+    if (device_address != nullptr) {
+      (void)graph_info.append(std::to_string(device_address->type_id())).append(1, '_');
+      (void)graph_info.append(device_address->format()).append(1, '_');
     }
   }
+  return graph_info;
+}
+
+std::string GetSingleOpInfo(const OpExecInfoPtr &op_exec_info) {
+  MS_EXCEPTION_IF_NULL(op_exec_info);
+  std::string graph_info;
   // get prim and abstract info
-  (void)graph_info.append(op_exec_info->prim_id + "_");
+  (void)graph_info.append(op_exec_info->prim_id).append(1, '_');
   // get attr info
   const auto &op_prim = op_exec_info->py_primitive;
   MS_EXCEPTION_IF_NULL(op_prim);
+  // the attrs are kept as text, the hash of a generic value covers only part of it and would mix up the graphs
   const auto &attr_map = op_prim->evaluate_added_attrs();
-  (void)std::for_each(attr_map.begin(), attr_map.end(),
-                      [&](const auto &element) { (void)graph_info.append(element.second->ToString() + "_"); });
+  for (const auto &element : attr_map) {
+    (void)graph_info.append(element.second->ToString()).append(1, '_');
+  }
 
   // Add output information(shape, type id) of the operator to graph_info to solve the problem of cache missing
   // caused by operators like DropoutGenMask whose output is related to values of input when input shapes are
@@ -296,6 +304,36 @@ std::string GetSingleOpGraphInfo(const OpExecInfoPtr &op_exec_info,
   return graph_info;
 }
 
+std::string GetSingleOpGraphInfo(const OpExecInfoPtr &op_exec_info,
+                                 const std::vector<tensor::TensorPtr> &input_tensors) {
+  return GetInputTensorsInfo(input_tensors) + GetSingleOpInfo(op_exec_info);
+}
+
+// the outputs of an op dispatched asynchronously are created from its inferred abstract, only the ops whose outputs
+// are tensors of static shapes are dispatched so
+bool CreateFutureOutputs(const AbstractBasePtr &abstract, std::vector<tensor::TensorPtr> *output_tensors) {
+  MS_EXCEPTION_IF_NULL(abstract);
+  MS_EXCEPTION_IF_NULL(output_tensors);
+  AbstractBasePtrList elements = {abstract};
+  if (abstract->isa<abstract::AbstractTuple>()) {
+    elements = abstract->cast<abstract::AbstractTuplePtr>()->elements();
+  }
+  for (const auto &element : elements) {
+    if (element == nullptr || !element->isa<abstract::AbstractTensor>() || element->isa<abstract::AbstractRef>()) {
+      return false;
+    }
+    auto shape = element->BuildShape()->cast<abstract::ShapePtr>();
+    if (shape == nullptr ||
+        std::any_of(shape->shape().begin(), shape->shape().end(), [](int64_t dim) { return dim < 0; })) {
+      return false;
+    }
+    auto element_type = element->cast<abstract::AbstractTensorPtr>()->element()->BuildType();
+    MS_EXCEPTION_IF_NULL(element_type);
+    output_tensors->emplace_back(std::make_shared<tensor::Tensor>(element_type->type_id(), shape->shape()));
+  }
+  return !output_tensors->empty();
+}
+
 py::object RunOpInVM(const OpExecInfoPtr &op_exec_info, PynativeStatusCode *status) {
   MS_LOG(INFO) << "RunOpInVM start";
 
@@ -563,7 +601,22 @@ py::tuple ConvertArgs(const py::tuple &args) {
   return res;
 }
 
-void ClearPyNativeSession() { session = nullptr; }
+void ClearPyNativeSession() {
+  session = nullptr;
+  recorded_op_trace.clear();
+}
+
+void InitPyNativeSession() {
+  if (session != nullptr) {
+    return;
+  }
+  auto ms_context = MsContext::GetInstance();
+  MS_EXCEPTION_IF_NULL(ms_context);
+  std::string device_target = ms_context->get_param<std::string>(MS_CTX_DEVICE_TARGET);
+  session = session::SessionFactory::Get().Create(device_target);
+  MS_EXCEPTION_IF_NULL(session);
+  session->Init(ms_context->get_param<uint32_t>(MS_CTX_DEVICE_ID));
+}
 
 PynativeExecutor::~PynativeExecutor() { ClearRes(); }
 
@@ -1284,6 +1337,17 @@ MsBackendPolicy PynativeExecutor::InitEnv(const OpExecInfoPtr &op_exec_info) {
   return backend_policy;
 }
 
+bool PynativeExecutor::IsRunOpAsync(const OpExecInfoPtr &op_exec_info,
+                                    std::vector<tensor::TensorPtr> *output_tensors) const {
+  MS_EXCEPTION_IF_NULL(op_exec_info);
+  // the grad graph reads the device addresses of the outputs as soon as the op returns
+  if (!MsContext::GetInstance()->get_param<bool>(MS_CTX_ENABLE_PYNATIVE_ASYNC) || grad_flag_ ||
+      op_exec_info->is_dynamic_shape || op_exec_info->is_mixed_precision_cast) {
+    return false;
+  }
+  return CreateFutureOutputs(op_exec_info->abstract, output_tensors);
+}
+
 py::object PynativeExecutor::RunOpWithBackendPolicy(MsBackendPolicy backend_policy, const OpExecInfoPtr &op_exec_info,
                                                     PynativeStatusCode *const status) {
   MS_EXCEPTION_IF_NULL(status);
@@ -1325,21 +1389,15 @@ py::object PynativeExecutor::RunOpInMs(const OpExecInfoPtr &op_exec_info, Pynati
   MS_EXCEPTION_IF_NULL(op_exec_info);
   MS_EXCEPTION_IF_NULL(status);
   MS_LOG(INFO) << "Start run op [" << op_exec_info->op_name << "] with backend policy ms";
-  auto ms_context = MsContext::GetInstance();
-  ms_context->set_param<bool>(MS_CTX_ENABLE_PYNATIVE_INFER, true);
+  std::vector<tensor::TensorPtr> output_tensors;
+  // the executor thread sets the pynative infer flag while running the op
+  bool run_async = IsRunOpAsync(op_exec_info, &output_tensors);
 
-  if (session == nullptr) {
-    std::string device_target = ms_context->get_param<std::string>(MS_CTX_DEVICE_TARGET);
-    session = session::SessionFactory::Get().Create(device_target);
-    MS_EXCEPTION_IF_NULL(session);
-    session->Init(ms_context->get_param<uint32_t>(MS_CTX_DEVICE_ID));
-  }
+  InitPyNativeSession();
 
   std::vector<tensor::TensorPtr> input_tensors;
   std::vector<int64_t> tensors_mask;
   ConstructInputTensor(op_exec_info, &tensors_mask, &input_tensors);
-  // get graph info for checking it whether existing in the cache
-  std::string graph_info = GetSingleOpGraphInfo(op_exec_info, input_tensors);
   session::OpRunInfo op_run_info = {op_exec_info->op_name,
                                     op_exec_info->py_primitive,
                                     op_exec_info->abstract,
@@ -1347,13 +1405,32 @@ py::object PynativeExecutor::RunOpInMs(const OpExecInfoPtr &op_exec_info, Pynati
                                     op_exec_info->is_mixed_precision_cast,
                                     op_exec_info->next_op_name,
                                     op_exec_info->next_input_index};
+  if (run_async) {
+    // the next dispatch of the same primitive converts its const inputs to attrs again while the executor thread still
+    // reads the attrs of this op, so the task runs with a copy of the primitive
+    op_run_info.primitive = std::make_shared<Primitive>(*op_exec_info->py_primitive);
+    // the device formats of the inputs are known once the ops producing them are done
+    auto op_info = GetSingleOpInfo(op_exec_info);
+    session->RunOpAsync(
+      op_run_info,
+      [op_info](const std::vector<tensor::TensorPtr> &inputs) { return GetInputTensorsInfo(inputs) + op_info; },
+      input_tensors, tensors_mask, output_tensors);
+    py::tuple result(output_tensors.size());
+    for (size_t i = 0; i < output_tensors.size(); ++i) {
+      result[i] = output_tensors[i];
+    }
+    *status = PYNATIVE_SUCCESS;
+    MS_LOG(INFO) << "End dispatch op [" << op_exec_info->op_name << "] with backend policy ms";
+    return std::move(result);
+  }
+  // get graph info for checking it whether existing in the cache
+  std::string graph_info = GetSingleOpGraphInfo(op_exec_info, input_tensors);
   VectorRef outputs;
   session->RunOp(&op_run_info, graph_info, &input_tensors, &outputs, tensors_mask);
   if (op_exec_info->is_dynamic_shape) {
     op_exec_info->abstract = op_run_info.abstract;
   }
   auto result = BaseRefToPyData(outputs);
-  ms_context->set_param<bool>(MS_CTX_ENABLE_PYNATIVE_INFER, false);
   *status = PYNATIVE_SUCCESS;
   MS_LOG(INFO) << "End run op [" << op_exec_info->op_name << "] with backend policy ms";
   return result;
@@ -2055,11 +2132,6 @@ void PynativeExecutor::Clear(const std::string &flag) {
     MapClear<std::unordered_map<std::string, std::pair<std::string, std::string>>>(&cell_sw_map_, flag);
     MapClear<std::unordered_map<std::string, std::pair<FuncGraphPtr, FuncGraphPtr>>>(&df_builder_map_, flag);
 
-    // Maybe exit in the pynative runing op, so need reset pynative flag.
-    auto ms_context = MsContext::GetInstance();
-    if (ms_context != nullptr) {
-      ms_context->set_param<bool>(MS_CTX_ENABLE_PYNATIVE_INFER, false);
-    }
     ConfigManager::GetInstance().ResetIterNum();
     if (top_graph_cells_.find(flag) != top_graph_cells_.end()) {
       Clean();
@@ -2117,9 +2189,41 @@ void PynativeExecutor::Sync() {
   if (session == nullptr) {
     MS_EXCEPTION(NotExistsError) << "No session has been created!";
   }
+  session->SyncRunOps();
   session->SyncStream();
 }
 
+void PynativeExecutor::StartOpTrace() {
+  InitPyNativeSession();
+  session->StartOpTrace();
+}
+
+size_t PynativeExecutor::StopOpTrace() {
+  if (session == nullptr) {
+    MS_EXCEPTION(NotExistsError) << "No session has been created!";
+  }
+  recorded_op_trace = session->StopOpTrace();
+  return recorded_op_trace.size();
+}
+
+void PynativeExecutor::WarmUpOpGraphCache() {
+  InitPyNativeSession();
+  session->WarmUpOpGraphs(recorded_op_trace);
+}
+
+py::dict PynativeExecutor::GetOpGraphCacheInfo() {
+  InitPyNativeSession();
+  session->SyncRunOps();
+  const auto &cache = session->op_graph_cache();
+  py::dict info;
+  info["size"] = cache.size();
+  info["capacity"] = cache.capacity();
+  info["hit"] = cache.hit_num();
+  info["miss"] = cache.miss_num();
+  info["eviction"] = cache.eviction_num();
+  return info;
+}
+
 REGISTER_PYBIND_DEFINE(PynativeExecutor_, ([](const py::module *m) {
                          (void)py::class_<PynativeExecutor, std::shared_ptr<PynativeExecutor>>(*m, "PynativeExecutor_")
                            .def_static("get_instance", &PynativeExecutor::GetInstance, "PynativeExecutor get_instance.")
@@ -2129,6 +2233,12 @@ REGISTER_PYBIND_DEFINE(PynativeExecutor_, ([](const py::module *m) {
                            .def("grad_net", &PynativeExecutor::GradNet, "pynative grad graph.")
                            .def("clear", &PynativeExecutor::Clear, "pynative clear status.")
                            .def("sync", &PynativeExecutor::Sync, "pynative sync stream.")
+                           .def("start_op_trace", &PynativeExecutor::StartOpTrace, "pynative start recording ops.")
+                           .def("stop_op_trace", &PynativeExecutor::StopOpTrace, "pynative stop recording ops.")
+                           .def("warm_up_op_graph_cache", &PynativeExecutor::WarmUpOpGraphCache,
+                                "pynative build the graphs of the recorded ops.")
+                           .def("op_graph_cache_info", &PynativeExecutor::GetOpGraphCacheInfo,
+                                "pynative get the statistics of the op graph cache.")
                            .def("__call__", &PynativeExecutor::Run, py::arg("args"), py::arg("phase") = py::str(""),
                                 "Executor run function.")
                            .def("set_grad_flag", &PynativeExecutor::set_grad_flag, py::arg("flag") = py::bool_(false),
@@ -98,6 +98,12 @@ class PynativeExecutor : public std::enable_shared_from_this<PynativeExecutor> {
   void ClearRes();
   // Sync stream
   void Sync();
+  // record the ops whose graphs are built between start and stop, the graphs of the last recorded ops are built again
+  // by warm up if they are released by the op graph cache
+  void StartOpTrace();
+  size_t StopOpTrace();
+  void WarmUpOpGraphCache();
+  py::dict GetOpGraphCacheInfo();
 
  private:
   PynativeExecutor() = default;
@@ -125,6 +131,7 @@ class PynativeExecutor : public std::enable_shared_from_this<PynativeExecutor> {
   py::tuple RunOpWithInitBackendPolicy(const OpExecInfoPtr &op_exec_info);
   void RunParameterAutoMixPrecisionCast(const OpExecInfoPtr &op_exec_info);
   py::object RunOpInMs(const OpExecInfoPtr &op_exec_info, PynativeStatusCode *status);
+  bool IsRunOpAsync(const OpExecInfoPtr &op_exec_info, std::vector<tensor::TensorPtr> *output_tensors) const;
   py::object RunOpWithBackendPolicy(MsBackendPolicy backend_policy, const OpExecInfoPtr &op_exec_info,
                                     PynativeStatusCode *const status);
   AnfNodePtr GetObjNode(const py::object &obj, const std::string &obj_id);
@@ -461,7 +461,14 @@ REGISTER_PYBIND_DEFINE(Tensor, ([](const py::module *m) {
                                   mindspore.int32
                               )mydelimiter")
                            .def("set_cast_dtype", &Tensor::set_cast_dtype, py::arg("dtype") = nullptr)
-                           .def("data_sync", &Tensor::data_sync)
+                           .def("data_sync",
+                                [](const Tensor &tensor, bool need_wait) {
+                                  if (need_wait && tensor.NeedWait()) {
+                                    py::gil_scoped_release gil_release;
+                                    tensor.Wait();
+                                  }
+                                  tensor.data_sync(false);
+                                })
                            .def("__str__", &Tensor::ToString)
                            .def("__repr__", &Tensor::ToStringRepr)
                            .def(py::pickle(
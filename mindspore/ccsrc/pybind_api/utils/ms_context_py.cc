@@ -80,12 +80,20 @@ REGISTER_PYBIND_DEFINE(MsContextPy, ([](const py::module *m) {
                            .value("enable_graph_kernel", MsCtxParam::MS_CTX_ENABLE_GRAPH_KERNEL)
                            .value("enable_reduce_precision", MsCtxParam::MS_CTX_ENABLE_REDUCE_PRECISION)
                            .value("enable_sparse", MsCtxParam::MS_CTX_ENABLE_SPARSE)
+                           .value("enable_pynative_async", MsCtxParam::MS_CTX_ENABLE_PYNATIVE_ASYNC)
+                           .value("enable_parallel_infer", MsCtxParam::MS_CTX_ENABLE_PARALLEL_INFER)
+                           .value("enable_incremental_compile", MsCtxParam::MS_CTX_ENABLE_INCREMENTAL_COMPILE)
+                           .value("enable_ir_arena", MsCtxParam::MS_CTX_ENABLE_IR_ARENA)
+                           .value("enable_cpu_fusion", MsCtxParam::MS_CTX_ENABLE_CPU_FUSION)
+                           .value("enable_optimizer_offload", MsCtxParam::MS_CTX_ENABLE_OPTIMIZER_OFFLOAD)
                            .value("precompile_only", MsCtxParam::MS_CTX_PRECOMPILE_ONLY)
                            .value("enable_profiling", MsCtxParam::MS_CTX_ENABLE_PROFILING)
                            .value("save_graphs", MsCtxParam::MS_CTX_SAVE_GRAPHS_FLAG)
                            .value("max_device_memory", MsCtxParam::MS_CTX_MAX_DEVICE_MEMORY)
+                           .value("recompute_memory_budget", MsCtxParam::MS_CTX_RECOMPUTE_MEMORY_BUDGET)
                            .value("mode", MsCtxParam::MS_CTX_EXECUTION_MODE)
                            .value("device_target", MsCtxParam::MS_CTX_DEVICE_TARGET)
+                           .value("compile_cache_path", MsCtxParam::MS_CTX_COMPILE_CACHE_PATH)
                            .value("_graph_memory_max_size", MsCtxParam::MS_CTX_GRAPH_MEMORY_MAX_SIZE)
                            .value("print_file_path", MsCtxParam::MS_CTX_PRINT_FILE_PATH)
                            .value("profiling_options", MsCtxParam::MS_CTX_PROFILING_OPTIONS)
@@ -93,7 +101,9 @@ REGISTER_PYBIND_DEFINE(MsContextPy, ([](const py::module *m) {
                            .value("save_graphs_path", MsCtxParam::MS_CTX_SAVE_GRAPHS_PATH)
                            .value("variable_memory_max_size", MsCtxParam::MS_CTX_VARIABLE_MEMORY_MAX_SIZE)
                            .value("device_id", MsCtxParam::MS_CTX_DEVICE_ID)
-                           .value("max_call_depth", MsCtxParam::MS_CTX_MAX_CALL_DEPTH);
+                           .value("max_call_depth", MsCtxParam::MS_CTX_MAX_CALL_DEPTH)
+                           .value("cpu_inter_op_parallel_num", MsCtxParam::MS_CTX_CPU_INTER_OP_PARALLEL_NUM)
+                           .value("op_graph_cache_capacity", MsCtxParam::MS_CTX_OP_GRAPH_CACHE_CAPACITY);
 
                          (void)py::class_<mindspore::MsContext, std::shared_ptr<mindspore::MsContext>>(*m, "MSContext")
                            .def_static("get_instance", &mindspore::MsContext::GetInstance, "Get ms context instance.")
@@ -0,0 +1,142 @@
+/**
+ * Copyright 2020 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "runtime/device/cpu/cpu_dataflow_executor.h"
+#include "utils/log_adapter.h"
+
+namespace mindspore {
+namespace device {
+namespace cpu {
+CPUDataflowExecutor &CPUDataflowExecutor::GetInstance() {
+  static CPUDataflowExecutor instance;
+  return instance;
+}
+
+CPUDataflowExecutor::~CPUDataflowExecutor() {
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    exit_ = true;
+  }
+  cond_.notify_all();
+  for (auto &worker : workers_) {
+    if (worker.joinable()) {
+      worker.join();
+    }
+  }
+}
+
+void CPUDataflowExecutor::AddWorkers(size_t thread_num) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  while (workers_.size() < thread_num) {
+    workers_.emplace_back(&CPUDataflowExecutor::WorkerLoop, this);
+  }
+}
+
+void CPUDataflowExecutor::WorkerLoop() {
+  while (true) {
+    ReadyKernel ready_kernel;
+    {
+      std::unique_lock<std::mutex> lock(mutex_);
+      cond_.wait(lock, [this] { return exit_ || !ready_queue_.empty(); });
+      if (ready_queue_.empty()) {
+        return;
+      }
+      ready_kernel = ready_queue_.front();
+      ready_queue_.pop_front();
+    }
+    Execute(ready_kernel);
+  }
+}
+
+void CPUDataflowExecutor::Execute(const ReadyKernel &ready_kernel) {
+  auto state = ready_kernel.first;
+  auto kernel = ready_kernel.second;
+  // after a failure the kernels left are only counted down, so that the run still terminates
+  if (!state->failed) {
+    try {
+      state->launch(kernel);
+    } catch (...) {
+      std::lock_guard<std::mutex> lock(mutex_);
+      if (!state->failed.exchange(true)) {
+        state->error = std::current_exception();
+      }
+    }
+  }
+  std::vector<size_t> ready_successors;
+  for (auto successor : state->graph.successors[kernel]) {
+    if (--state->pending[successor] == 0) {
+      ready_successors.push_back(successor);
+    }
+  }
+  bool done = false;
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    for (auto successor : ready_successors) {
+      ready_queue_.emplace_back(state, successor);
+    }
+    // the state belongs to the thread waiting in Run, it must not be touched once the last kernel is counted
+    done = --state->remaining == 0;
+  }
+  if (!ready_successors.empty() || done) {
+    cond_.notify_all();
+  }
+}
+
+void CPUDataflowExecutor::Run(const DataflowGraph &graph, size_t thread_num,
+                              const std::function<void(size_t)> &launch) {
+  size_t kernel_num = graph.dep_counts.size();
+  if (graph.successors.size() != kernel_num) {
+    MS_LOG(EXCEPTION) << "The dataflow graph has " << graph.successors.size() << " successor lists for " << kernel_num
+                      << " kernels";
+  }
+  if (kernel_num == 0) {
+    return;
+  }
+  if (thread_num > 1) {
+    AddWorkers(thread_num - 1);
+  }
+  RunState state(graph, launch);
+  state.remaining = kernel_num;
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    for (size_t i = 0; i < kernel_num; ++i) {
+      state.pending[i] = graph.dep_counts[i];
+      if (graph.dep_counts[i] == 0) {
+        ready_queue_.emplace_back(&state, i);
+      }
+    }
+  }
+  cond_.notify_all();
+
+  std::unique_lock<std::mutex> lock(mutex_);
+  while (state.remaining != 0) {
+    if (ready_queue_.empty()) {
+      cond_.wait(lock, [this, &state] { return state.remaining == 0 || !ready_queue_.empty(); });
+      continue;
+    }
+    auto ready_kernel = ready_queue_.front();
+    ready_queue_.pop_front();
+    lock.unlock();
+    Execute(ready_kernel);
+    lock.lock();
+  }
+  lock.unlock();
+  if (state.error != nullptr) {
+    std::rethrow_exception(state.error);
+  }
+}
+}  // namespace cpu
+}  // namespace device
+}  // namespace mindspore
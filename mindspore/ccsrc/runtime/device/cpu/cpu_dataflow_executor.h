@@ -0,0 +1,83 @@
+/**
+ * Copyright 2020 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef MINDSPORE_CCSRC_RUNTIME_DEVICE_CPU_CPU_DATAFLOW_EXECUTOR_H_
+#define MINDSPORE_CCSRC_RUNTIME_DEVICE_CPU_CPU_DATAFLOW_EXECUTOR_H_
+
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <utility>
+#include <vector>
+
+namespace mindspore {
+namespace device {
+namespace cpu {
+// the dependencies of the kernels of a graph, kernel i may start when all of its dep_counts[i] predecessors are done
+struct DataflowGraph {
+  std::vector<std::vector<size_t>> successors;
+  std::vector<size_t> dep_counts;
+};
+
+// CPUDataflowExecutor launches the ready kernels of a graph on a thread pool shared by all cpu kernel runtimes of the
+// process. The calling thread executes kernels as well until its graph is done.
+class CPUDataflowExecutor {
+ public:
+  ~CPUDataflowExecutor();
+  CPUDataflowExecutor(const CPUDataflowExecutor &) = delete;
+  CPUDataflowExecutor &operator=(const CPUDataflowExecutor &) = delete;
+
+  static CPUDataflowExecutor &GetInstance();
+
+  // launch(i) runs kernel i. The pool grows to thread_num threads including the caller, it is not shrunk for runs
+  // asking for fewer threads. The first exception thrown by a launch stops dispatching the kernels which are not
+  // started yet and is rethrown here once the running ones are done.
+  void Run(const DataflowGraph &graph, size_t thread_num, const std::function<void(size_t)> &launch);
+
+ private:
+  struct RunState {
+    RunState(const DataflowGraph &dataflow_graph, const std::function<void(size_t)> &launch_func)
+        : graph(dataflow_graph), launch(launch_func), pending(dataflow_graph.dep_counts.size()) {}
+    const DataflowGraph &graph;
+    const std::function<void(size_t)> &launch;
+    std::vector<std::atomic<size_t>> pending;
+    size_t remaining{0};
+    std::atomic_bool failed{false};
+    std::exception_ptr error{nullptr};
+  };
+  using ReadyKernel = std::pair<RunState *, size_t>;
+
+  CPUDataflowExecutor() = default;
+  void AddWorkers(size_t thread_num);
+  void WorkerLoop();
+  void Execute(const ReadyKernel &ready_kernel);
+
+  std::mutex mutex_;
+  // signaled when kernels become ready and when a graph is done
+  std::condition_variable cond_;
+  std::deque<ReadyKernel> ready_queue_;
+  std::vector<std::thread> workers_;
+  bool exit_{false};
+};
+}  // namespace cpu
+}  // namespace device
+}  // namespace mindspore
+
+#endif  // MINDSPORE_CCSRC_RUNTIME_DEVICE_CPU_CPU_DATAFLOW_EXECUTOR_H_
@@ -22,6 +22,8 @@
 #include <algorithm>
 #include <functional>
 #include <exception>
+#include <set>
+#include <unordered_map>
 #include "backend/kernel_compiler/kernel.h"
 #include "runtime/device/cpu/cpu_device_address.h"
 #include "utils/ms_context.h"
@@ -31,18 +33,40 @@
 #include "utils/shape_utils.h"
 #include "utils/profile.h"
 #include "utils/trace_base.h"
+#include "ir/graph_utils.h"
+#include "base/core_ops.h"
 
 namespace mindspore {
 namespace device {
 namespace cpu {
 const size_t INIT_NODE_REF = 1;
+const size_t kControlDependInputNum = 3;
 void CPUKernelRuntime::AssignKernelAddress(session::KernelGraph *kernel_graph) {
+  // new device addresses are created below, a launch plan holding the old ones is stale
+  MS_EXCEPTION_IF_NULL(kernel_graph);
+  (void)launch_plans_.erase(kernel_graph->graph_id());
   AssignValueNodeAddress(kernel_graph);
   AssignInputNodeAddress(kernel_graph);
   AssignKernelOutputAddress(kernel_graph);
   resource_manager_.AssignMemory(kernel_graph);
 }
 
+void CPUKernelRuntime::SyncValueNodeDeviceAddr(session::KernelGraph *graph) {
+  // value nodes are bound to the device addresses of their tensors again
+  MS_EXCEPTION_IF_NULL(graph);
+  (void)launch_plans_.erase(graph->graph_id());
+  KernelRuntime::SyncValueNodeDeviceAddr(graph);
+}
+
+void CPUKernelRuntime::ClearGraphRuntimeResource(uint32_t graph_id, const std::vector<AnfNodePtr> &inputs,
+                                                 const std::unordered_set<ValueNodePtr> &value_nodes,
+                                                 const std::vector<CNodePtr> &execution_order) {
+  // the launch plan holds the kernels and device addresses of the graph
+  (void)launch_plans_.erase(graph_id);
+  resource_manager_.ClearMemPlan(graph_id);
+  KernelRuntime::ClearGraphRuntimeResource(graph_id, inputs, value_nodes, execution_order);
+}
+
 void CPUKernelRuntime::AssignValueNodeAddress(session::KernelGraph *kernel_graph) {
   MS_EXCEPTION_IF_NULL(kernel_graph);
   for (auto &item_node : kernel_graph->graph_value_nodes()) {
@@ -338,8 +362,287 @@ void CPUKernelRuntime::DecreaseSummaryRefCount(const session::NamedSummaryOutput
   resource_manager_.DecreaseSummaryRefCount(summary_outputs);
 }
 
+void CPUKernelRuntime::LaunchKernel(const CNodePtr &kernel, kernel::KernelMod *kernel_mod,
+                                    const std::vector<kernel::AddressPtr> &kernel_inputs,
+                                    const std::vector<kernel::AddressPtr> &kernel_workspaces,
+                                    const std::vector<kernel::AddressPtr> &kernel_outputs) {
+  bool ret = true;
+  try {
+    ret = kernel_mod->Launch(kernel_inputs, kernel_workspaces, kernel_outputs, 0);
+  } catch (std::exception &e) {
+    MS_LOG(EXCEPTION) << e.what() << "\nTrace:" << trace::DumpSourceLines(kernel);
+  }
+  if (!ret) {
+    MS_LOG(EXCEPTION) << "Launch kernel failed. Trace:" << trace::DumpSourceLines(kernel);
+  }
+}
+
+bool CPUKernelRuntime::IsLaunchPlanValid(const session::KernelGraph *kernel_graph, const LaunchPlan &plan) const {
+  auto &kernels = kernel_graph->execution_order();
+  if (kernels.size() != plan.items.size()) {
+    return false;
+  }
+  for (size_t i = 0; i < kernels.size(); ++i) {
+    if (kernels[i] != plan.items[i].kernel) {
+      return false;
+    }
+  }
+  return true;
+}
+
+void CPUKernelRuntime::CompileLaunchPlan(const session::KernelGraph *kernel_graph, LaunchPlan *plan) {
+  MS_EXCEPTION_IF_NULL(plan);
+  plan->items.clear();
+  plan->dataflow_built = false;
+  auto &kernels = kernel_graph->execution_order();
+  plan->items.reserve(kernels.size());
+  auto new_address_list = [](size_t size) {
+    std::vector<kernel::AddressPtr> addr_list(size);
+    for (auto &addr : addr_list) {
+      addr = std::make_shared<kernel::Address>();
+    }
+    return addr_list;
+  };
+  for (const auto &kernel : kernels) {
+    LaunchItem item;
+    item.kernel = kernel;
+    item.kernel_mod = AnfAlgo::GetKernelMod(kernel);
+    MS_EXCEPTION_IF_NULL(item.kernel_mod);
+    size_t input_num = AnfAlgo::GetInputTensorNum(kernel);
+    for (size_t i = 0; i < input_num; ++i) {
+      auto device_address = AnfAlgo::GetPrevNodeMutableOutputAddr(kernel, i);
+      MS_EXCEPTION_IF_NULL(device_address);
+      item.input_slots.push_back(device_address);
+    }
+    size_t output_num = AnfAlgo::GetOutputTensorNum(kernel);
+    for (size_t i = 0; i < output_num; ++i) {
+      auto device_address = AnfAlgo::GetMutableOutputAddr(kernel, i);
+      MS_EXCEPTION_IF_NULL(device_address);
+      item.output_slots.push_back(device_address);
+    }
+    for (size_t i = 0; i < item.kernel_mod->GetWorkspaceSizeList().size(); ++i) {
+      auto device_address = AnfAlgo::GetWorkspaceAddr(kernel, i);
+      MS_EXCEPTION_IF_NULL(device_address);
+      item.workspace_slots.push_back(device_address);
+    }
+    item.inputs = new_address_list(item.input_slots.size());
+    item.outputs = new_address_list(item.output_slots.size());
+    item.workspaces = new_address_list(item.workspace_slots.size());
+    plan->items.push_back(std::move(item));
+  }
+  plan->compiled = true;
+  MS_LOG(INFO) << "Compile launch plan of graph " << kernel_graph->graph_id() << " with " << plan->items.size()
+               << " kernels";
+}
+
+void CPUKernelRuntime::RefreshRuntimeAddress(const std::vector<DeviceAddressPtr> &slots,
+                                             std::vector<kernel::AddressPtr> *addr_list) {
+  // the device addresses of a graph are fixed, but their memory may be rebound to input tensors or released by the
+  // dynamic malloc between steps
+  for (size_t i = 0; i < slots.size(); ++i) {
+    auto address = slots[i].get();
+    if (address->ptr_ == nullptr) {
+      address->ptr_ = resource_manager_.MemMalloc(address->size_);
+    }
+    MS_EXCEPTION_IF_NULL(address->ptr_);
+    (*addr_list)[i]->addr = address->ptr_;
+    (*addr_list)[i]->size = address->size_;
+  }
+}
+
+void CPUKernelRuntime::RunLaunchPlan(LaunchPlan *plan) {
+  MS_EXCEPTION_IF_NULL(plan);
+  for (const auto &item : plan->items) {
+    resource_manager_.IncreaseAddressRefCount(item.input_slots);
+    resource_manager_.IncreaseAddressRefCount(item.workspace_slots);
+  }
+  for (auto &item : plan->items) {
+#ifdef ENABLE_PROFILE
+    double start_time = GetTime();
+#endif
+    RefreshRuntimeAddress(item.input_slots, &item.inputs);
+    RefreshRuntimeAddress(item.output_slots, &item.outputs);
+    RefreshRuntimeAddress(item.workspace_slots, &item.workspaces);
+    LaunchKernel(item.kernel, item.kernel_mod, item.inputs, item.workspaces, item.outputs);
+    resource_manager_.DecreaseAddressRefCount(item.input_slots);
+    resource_manager_.DecreaseAddressRefCount(item.workspace_slots);
+#ifdef ENABLE_PROFILE
+    double cost_time = GetTime() - start_time;
+    MS_LOG(INFO) << "cpu kernel: " << item.kernel->fullname_with_scope() << "  costs " << cost_time * 1e6 << " us";
+#endif
+  }
+}
+
+void CPUKernelRuntime::BuildDataflowGraph(const session::KernelGraph *kernel_graph, LaunchPlan *plan) {
+  MS_EXCEPTION_IF_NULL(plan);
+  size_t kernel_num = plan->items.size();
+  std::unordered_map<AnfNodePtr, size_t> kernel_index;
+  for (size_t i = 0; i < kernel_num; ++i) {
+    kernel_index[plan->items[i].kernel] = i;
+  }
+  // an edge only points forward in the execution order, which is a valid order of the graph already
+  std::vector<std::set<size_t>> predecessors(kernel_num);
+  auto add_edge = [&predecessors](size_t from, size_t to) {
+    if (from < to) {
+      (void)predecessors[to].insert(from);
+    }
+  };
+  // the kernels a node depends on through the nodes which are not launched, such as Depend, MakeTuple or TupleGetItem
+  auto collect_kernels = [&kernel_index](const AnfNodePtr &node) {
+    std::vector<size_t> kernels;
+    std::vector<AnfNodePtr> todo = {node};
+    std::set<AnfNodePtr> visited;
+    while (!todo.empty()) {
+      auto cur = todo.back();
+      todo.pop_back();
+      if (cur == nullptr || !visited.insert(cur).second) {
+        continue;
+      }
+      auto iter = kernel_index.find(cur);
+      if (iter != kernel_index.end()) {
+        kernels.push_back(iter->second);
+        continue;
+      }
+      auto cnode = cur->cast<CNodePtr>();
+      if (cnode == nullptr) {
+        continue;
+      }
+      for (size_t i = 1; i < cnode->inputs().size(); ++i) {
+        todo.push_back(cnode->input(i));
+      }
+    }
+    return kernels;
+  };
+  for (size_t i = 0; i < kernel_num; ++i) {
+    auto &kernel = plan->items[i].kernel;
+    for (size_t j = 1; j < kernel->inputs().size(); ++j) {
+      for (auto pre : collect_kernels(kernel->input(j))) {
+        add_edge(pre, i);
+      }
+    }
+  }
+  for (const auto &node : TopoSort(kernel_graph->get_return())) {
+    if (!IsPrimitiveCNode(node, prim::kPrimControlDepend)) {
+      continue;
+    }
+    auto cnode = node->cast<CNodePtr>();
+    MS_EXCEPTION_IF_NULL(cnode);
+    if (cnode->inputs().size() < kControlDependInputNum) {
+      continue;
+    }
+    auto prior_kernels = collect_kernels(cnode->input(kControlDependPriorIndex));
+    for (auto behind : collect_kernels(cnode->input(kControlDependBehindIndex))) {
+      for (auto prior : prior_kernels) {
+        add_edge(prior, behind);
+      }
+    }
+  }
+  // parameters and ref outputs may be updated in place, all accesses to them keep the execution order, and so do the
+  // kernels with side effects out of the graph
+  std::unordered_map<DeviceAddress *, size_t> last_access;
+  auto add_access = [&last_access, &add_edge](DeviceAddress *address, size_t kernel) {
+    auto iter = last_access.find(address);
+    if (iter != last_access.end()) {
+      add_edge(iter->second, kernel);
+    }
+    last_access[address] = kernel;
+  };
+  const std::set<std::string> side_effect_kernels = {kPushOpName, kPullOpName, prim::kPrimPrint->name()};
+  size_t last_side_effect = kernel_num;
+  for (size_t i = 0; i < kernel_num; ++i) {
+    auto &item = plan->items[i];
+    for (size_t j = 0; j < item.input_slots.size(); ++j) {
+      auto input_node = AnfAlgo::GetPrevNodeOutput(item.kernel, j).first;
+      if (input_node != nullptr && input_node->isa<Parameter>()) {
+        add_access(item.input_slots[j].get(), i);
+      }
+    }
+    for (size_t j = 0; j < item.output_slots.size(); ++j) {
+      session::AnfWithOutIndex out_pair(item.kernel, j);
+      if (kernel_graph->IsInRefOutputMap(out_pair)) {
+        auto origin_pair = kernel_graph->GetRefCorrespondOutput(out_pair);
+        add_access(AnfAlgo::GetMutableOutputAddr(origin_pair.first, origin_pair.second).get(), i);
+        add_access(item.output_slots[j].get(), i);
+      }
+    }
+    if (side_effect_kernels.count(AnfAlgo::GetCNodeName(item.kernel)) != 0) {
+      if (last_side_effect != kernel_num) {
+        add_edge(last_side_effect, i);
+      }
+      last_side_effect = i;
+    }
+  }
+
+  plan->dataflow.successors.assign(kernel_num, {});
+  plan->dataflow.dep_counts.assign(kernel_num, 0);
+  size_t edge_num = 0;
+  for (size_t i = 0; i < kernel_num; ++i) {
+    plan->dataflow.dep_counts[i] = predecessors[i].size();
+    for (auto pre : predecessors[i]) {
+      plan->dataflow.successors[pre].push_back(i);
+    }
+    edge_num += predecessors[i].size();
+  }
+  plan->dataflow_built = true;
+  MS_LOG(INFO) << "Build dataflow graph of graph " << kernel_graph->graph_id() << " with " << kernel_num
+               << " kernels and " << edge_num << " edges";
+}
+
+void CPUKernelRuntime::RunLaunchPlanParallel(const session::KernelGraph *kernel_graph, LaunchPlan *plan,
+                                             size_t thread_num) {
+  MS_EXCEPTION_IF_NULL(plan);
+  if (!plan->dataflow_built) {
+    BuildDataflowGraph(kernel_graph, plan);
+  }
+  // memory is resolved before dispatching, the static memory plan gives every address its own memory when the
+  // inter-op parallelism is set
+  for (auto &item : plan->items) {
+    RefreshRuntimeAddress(item.input_slots, &item.inputs);
+    RefreshRuntimeAddress(item.output_slots, &item.outputs);
+    RefreshRuntimeAddress(item.workspace_slots, &item.workspaces);
+  }
+  CPUDataflowExecutor::GetInstance().Run(plan->dataflow, thread_num, [this, plan](size_t index) {
+    auto &item = plan->items[index];
+#ifdef ENABLE_PROFILE
+    double start_time = GetTime();
+#endif
+    LaunchKernel(item.kernel, item.kernel_mod, item.inputs, item.workspaces, item.outputs);
+#ifdef ENABLE_PROFILE
+    double cost_time = GetTime() - start_time;
+    MS_LOG(INFO) << "cpu kernel: " << item.kernel->fullname_with_scope() << "  costs " << cost_time * 1e6 << " us";
+#endif
+  });
+}
+
 bool CPUKernelRuntime::Run(session::KernelGraph *kernel_graph, bool is_task_sink) {
   MS_EXCEPTION_IF_NULL(kernel_graph);
+  // kernels of a dynamic shape graph infer their shapes and resize on every step, they are not planned
+  if (!kernel_graph->is_dynamic_shape()) {
+    auto iter = launch_plans_.find(kernel_graph->graph_id());
+    if (iter == launch_plans_.end()) {
+      launch_plans_[kernel_graph->graph_id()] = LaunchPlan();
+    } else {
+      auto &plan = iter->second;
+      if (!plan.compiled || !IsLaunchPlanValid(kernel_graph, plan)) {
+        CompileLaunchPlan(kernel_graph, &plan);
+      }
+      auto context_ptr = MsContext::GetInstance();
+      MS_EXCEPTION_IF_NULL(context_ptr);
+      auto thread_num = context_ptr->get_param<uint32_t>(MS_CTX_CPU_INTER_OP_PARALLEL_NUM);
+      // kernels may only overlap when they do not share memory, which the dynamic malloc and a memory plan reusing
+      // memory do not guarantee
+      bool mem_shared = resource_manager_.dynamic_malloc() || resource_manager_.mem_reused(kernel_graph->graph_id());
+      if (thread_num > 1 && !mem_shared) {
+        RunLaunchPlanParallel(kernel_graph, &plan, thread_num);
+      } else {
+        RunLaunchPlan(&plan);
+      }
+      return true;
+    }
+  } else {
+    (void)launch_plans_.erase(kernel_graph->graph_id());
+  }
+
   resource_manager_.IncreaseAddressRefCount(kernel_graph);
 
   auto kernels = kernel_graph->execution_order();
@@ -372,15 +675,7 @@ bool CPUKernelRuntime::Run(session::KernelGraph *kernel_graph, bool is_task_sink
       MS_EXCEPTION_IF_NULL(device_address);
       AddRuntimeAddress(device_address, &kernel_workspaces);
     }
-    bool ret = true;
-    try {
-      ret = kernel_mod->Launch(kernel_inputs, kernel_workspaces, kernel_outputs, 0);
-    } catch (std::exception &e) {
-      MS_LOG(EXCEPTION) << e.what() << "\nTrace:" << trace::DumpSourceLines(kernel);
-    }
-    if (!ret) {
-      MS_LOG(EXCEPTION) << "Launch kernel failed. Trace:" << trace::DumpSourceLines(kernel);
-    }
+    LaunchKernel(kernel, kernel_mod, kernel_inputs, kernel_workspaces, kernel_outputs);
     resource_manager_.DecreaseAddressRefCount(kernel);
 #ifdef ENABLE_PROFILE
     double cost_time = GetTime() - start_time;
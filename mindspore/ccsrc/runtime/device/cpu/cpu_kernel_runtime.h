@@ -21,10 +21,12 @@
 #include <string>
 #include <map>
 #include <set>
+#include <unordered_set>
 #include "runtime/device/kernel_runtime.h"
 #include "backend/session/kernel_graph.h"
 #include "backend/session/session_basic.h"
 #include "runtime/device/cpu/cpu_resource_manager.h"
+#include "runtime/device/cpu/cpu_dataflow_executor.h"
 #include "backend/session/anf_runtime_algorithm.h"
 #include "utils/any.h"
 namespace mindspore {
@@ -44,8 +46,12 @@ class CPUKernelRuntime : public KernelRuntime {
                        VectorRef *outputs);
   void IncreaseSummaryRefCount(const session::NamedSummaryOutputs &summary_outputs);
   void DecreaseSummaryRefCount(const session::NamedSummaryOutputs &summary_outputs);
+  void SyncValueNodeDeviceAddr(session::KernelGraph *graph) override;
   bool GenDynamicKernel(const session::KernelGraph *graph) override { return true; }
   bool RunDynamicKernelAsync(const session::KernelGraph *graph) override { return true; }
+  void ClearGraphRuntimeResource(uint32_t graph_id, const std::vector<AnfNodePtr> &inputs,
+                                 const std::unordered_set<ValueNodePtr> &value_nodes,
+                                 const std::vector<CNodePtr> &execution_order) override;
 
  protected:
   bool SyncStream() override { return true; };
@@ -63,9 +69,42 @@ class CPUKernelRuntime : public KernelRuntime {
   void AssignInputNodeAddress(const session::KernelGraph *kernel_graph);
   void AssignKernelOutputAddress(const session::KernelGraph *kernel_graph);
   void AddRuntimeAddress(DeviceAddress *address, std::vector<kernel::AddressPtr> *input_list);
+  // a launch plan caches what Run resolves for every kernel of a static shape graph: the kernel mod, the device
+  // addresses of its inputs, outputs and workspaces and the address lists handed to Launch, so that later steps only
+  // refresh the memory pointers of the address lists.
+  struct LaunchItem {
+    CNodePtr kernel;
+    kernel::KernelMod *kernel_mod{nullptr};
+    std::vector<DeviceAddressPtr> input_slots;
+    std::vector<DeviceAddressPtr> output_slots;
+    std::vector<DeviceAddressPtr> workspace_slots;
+    std::vector<kernel::AddressPtr> inputs;
+    std::vector<kernel::AddressPtr> outputs;
+    std::vector<kernel::AddressPtr> workspaces;
+  };
+  struct LaunchPlan {
+    // the plan is compiled on the second run of a graph, graphs which are run once do not pay for it
+    bool compiled{false};
+    std::vector<LaunchItem> items;
+    // kernel dependencies for the inter-op parallel executor, built on the first parallel run
+    bool dataflow_built{false};
+    DataflowGraph dataflow;
+  };
+  bool IsLaunchPlanValid(const session::KernelGraph *kernel_graph, const LaunchPlan &plan) const;
+  void CompileLaunchPlan(const session::KernelGraph *kernel_graph, LaunchPlan *plan);
+  void RefreshRuntimeAddress(const std::vector<DeviceAddressPtr> &slots, std::vector<kernel::AddressPtr> *addr_list);
+  void RunLaunchPlan(LaunchPlan *plan);
+  void BuildDataflowGraph(const session::KernelGraph *kernel_graph, LaunchPlan *plan);
+  void RunLaunchPlanParallel(const session::KernelGraph *kernel_graph, LaunchPlan *plan, size_t thread_num);
+  void LaunchKernel(const CNodePtr &kernel, kernel::KernelMod *kernel_mod,
+                    const std::vector<kernel::AddressPtr> &kernel_inputs,
+                    const std::vector<kernel::AddressPtr> &kernel_workspaces,
+                    const std::vector<kernel::AddressPtr> &kernel_outputs);
   CPUResourceManager resource_manager_;
   std::set<DeviceAddressPtr> bound_addresses_;
   std::map<AnfNodePtr, tensor::TensorPtr> input_param_tensor_map_;
+  // graph id -> launch plan, a graph address may be reused by a new graph once the old one is destroyed
+  std::map<uint32_t, LaunchPlan> launch_plans_;
 };
 }  // namespace cpu
 }  // namespace device
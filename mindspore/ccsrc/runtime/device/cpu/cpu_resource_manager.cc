@@ -168,6 +168,30 @@ void CPUResourceManager::DecreaseAddressRefCount(const AnfNodePtr &kernel) {
     }
   }
 }
+
+void CPUResourceManager::IncreaseAddressRefCount(const std::vector<DeviceAddressPtr> &addresses) {
+  if (!dynamic_malloc_) {
+    return;
+  }
+  for (const auto &address : addresses) {
+    MS_EXCEPTION_IF_NULL(address);
+    address->ref_count_++;
+  }
+}
+
+void CPUResourceManager::DecreaseAddressRefCount(const std::vector<DeviceAddressPtr> &addresses) {
+  if (!dynamic_malloc_) {
+    return;
+  }
+  for (const auto &address : addresses) {
+    MS_EXCEPTION_IF_NULL(address);
+    address->ref_count_--;
+    if (address->ref_count_ == 0 && address->ptr_ != nullptr) {
+      MemFree(address->ptr_);
+      address->ptr_ = nullptr;
+    }
+  }
+}
 }  // namespace cpu
 }  // namespace device
 }  // namespace mindspore
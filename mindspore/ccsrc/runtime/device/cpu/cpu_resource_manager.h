@@ -33,8 +33,13 @@ class CPUResourceManager {
   void AssignMemory(const session::KernelGraph *graph);
   void IncreaseAddressRefCount(const session::KernelGraph *graph);
   void DecreaseAddressRefCount(const AnfNodePtr &kernel);
+  void IncreaseAddressRefCount(const std::vector<DeviceAddressPtr> &addresses);
+  void DecreaseAddressRefCount(const std::vector<DeviceAddressPtr> &addresses);
   void *MemMalloc(size_t mem_size);
   void MemFree(void *ptr);
+  bool dynamic_malloc() const { return dynamic_malloc_; }
+  bool mem_reused(uint32_t graph_id) const { return mem_plan_.mem_reused(graph_id); }
+  void ClearMemPlan(uint32_t graph_id) { mem_plan_.ClearGraph(graph_id); }
   void IncreaseSummaryRefCount(const session::NamedSummaryOutputs &summary_outputs);
   void DecreaseSummaryRefCount(const session::NamedSummaryOutputs &summary_outputs);
 
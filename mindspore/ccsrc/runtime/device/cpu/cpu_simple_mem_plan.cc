@@ -14,16 +14,40 @@
  * limitations under the License.
  */
 #include "runtime/device/cpu/cpu_simple_mem_plan.h"
+#include <memory>
+#include <unordered_map>
+#include "backend/optimizer/somas/somas_solver_pre.h"
 #include "backend/session/anf_runtime_algorithm.h"
+#include "utils/ms_context.h"
 
 namespace mindspore {
 namespace device {
 namespace cpu {
-size_t CPUSimpleMemPlan::MemPlan(const session::KernelGraph *graph) {
-  MS_EXCEPTION_IF_NULL(graph);
-  size_t total_mem_size = 32;
+namespace {
+const size_t kMemAlignSize = 64;
+size_t GetAlignSize(size_t size) { return (size + kMemAlignSize - 1) / kMemAlignSize * kMemAlignSize; }
+}  // namespace
+
+void CPUSimpleMemPlan::CollectMemBlocks(const session::KernelGraph *graph) {
+  blocks_.clear();
+  std::unordered_map<DeviceAddress *, size_t> block_index;
+  auto use_address = [this, &block_index](const DeviceAddressPtr &address, size_t step) {
+    MS_EXCEPTION_IF_NULL(address);
+    if (address->ptr_ != nullptr) {
+      return;
+    }
+    auto iter = block_index.find(address.get());
+    if (iter == block_index.end()) {
+      block_index[address.get()] = blocks_.size();
+      blocks_.push_back({address, step, step, 0});
+    } else {
+      blocks_[iter->second].end = step;
+    }
+  };
+
   auto kernels = graph->execution_order();
-  for (const auto &kernel : kernels) {
+  for (size_t step = 0; step < kernels.size(); ++step) {
+    auto &kernel = kernels[step];
     MS_EXCEPTION_IF_NULL(kernel);
     size_t input_num = AnfAlgo::GetInputTensorNum(kernel);
     for (size_t i = 0; i < input_num; ++i) {
@@ -32,79 +56,106 @@ size_t CPUSimpleMemPlan::MemPlan(const session::KernelGraph *graph) {
       if (kernel_with_index.first->isa<Parameter>()) {
         continue;
       }
-      auto address = AnfAlgo::GetOutputAddr(kernel_with_index.first, kernel_with_index.second, true);
-      MS_EXCEPTION_IF_NULL(address);
-      if (address->ptr_ == nullptr) {
-        total_mem_size += address->size_;
-      }
+      use_address(AnfAlgo::GetMutableOutputAddr(kernel_with_index.first, kernel_with_index.second, true), step);
     }
 
     size_t output_num = AnfAlgo::GetOutputTensorNum(kernel);
     for (size_t i = 0; i < output_num; ++i) {
-      auto address = AnfAlgo::GetOutputAddr(kernel, i);
-      MS_EXCEPTION_IF_NULL(address);
-      if (address->ptr_ == nullptr) {
-        total_mem_size += address->size_;
-      }
+      use_address(AnfAlgo::GetMutableOutputAddr(kernel, i), step);
     }
 
     auto kernel_mod = AnfAlgo::GetKernelMod(kernel);
     MS_EXCEPTION_IF_NULL(kernel_mod);
     for (size_t i = 0; i < kernel_mod->GetWorkspaceSizeList().size(); ++i) {
-      auto address = AnfAlgo::GetWorkspaceAddr(kernel, i);
-      MS_EXCEPTION_IF_NULL(address);
-      if (address->ptr_ == nullptr) {
-        total_mem_size += address->size_;
-      }
+      use_address(AnfAlgo::GetMutableWorkspaceAddr(kernel, i), step);
     }
   }
 
-  return total_mem_size;
+  // the outputs of the graph and of the summary nodes are read after the last kernel
+  auto keep_alive = [&block_index, &kernels, this](const AnfNodePtr &node, size_t index) {
+    auto item_with_index = AnfAlgo::VisitKernelWithReturnType(node, index, true);
+    MS_EXCEPTION_IF_NULL(item_with_index.first);
+    if (!item_with_index.first->isa<CNode>() || !AnfAlgo::IsRealKernel(item_with_index.first)) {
+      return;
+    }
+    auto address = AnfAlgo::GetMutableOutputAddr(item_with_index.first, item_with_index.second, true);
+    auto iter = block_index.find(address.get());
+    if (iter != block_index.end()) {
+      blocks_[iter->second].end = kernels.size();
+    }
+  };
+  for (const auto &node : AnfAlgo::GetAllOutput(graph->output(), {prim::kPrimTupleGetItem})) {
+    keep_alive(node, 0);
+  }
+  for (const auto &summary : graph->summary_nodes()) {
+    keep_alive(summary.second.first, IntToSize(summary.second.second));
+  }
 }
 
-void CPUSimpleMemPlan::MemAssign(const session::KernelGraph *graph, uint8_t *base_ptr) {
-  MS_EXCEPTION_IF_NULL(graph);
-  MS_EXCEPTION_IF_NULL(base_ptr);
-  uint8_t *mem_ptr = base_ptr;
-  auto kernels = graph->execution_order();
-  for (const auto &kernel : kernels) {
-    MS_EXCEPTION_IF_NULL(kernel);
-    size_t input_num = AnfAlgo::GetInputTensorNum(kernel);
-    for (size_t i = 0; i < input_num; ++i) {
-      auto kernel_with_index = AnfAlgo::GetPrevNodeOutput(kernel, i);
-      MS_EXCEPTION_IF_NULL(kernel_with_index.first);
-      if (kernel_with_index.first->isa<Parameter>()) {
-        continue;
-      }
-      auto address = AnfAlgo::GetMutableOutputAddr(kernel_with_index.first, kernel_with_index.second, true);
-      MS_EXCEPTION_IF_NULL(address);
-      if (address->ptr_ == nullptr) {
-        address->ptr_ = mem_ptr;
-        mem_ptr = mem_ptr + address->size_;
-      }
+size_t CPUSimpleMemPlan::PlanMemReuse(const session::KernelGraph *graph) {
+  std::unordered_map<size_t, somas::SomasSolverTensorDescPtr> tensors;
+  for (size_t i = 0; i < blocks_.size(); ++i) {
+    tensors[i] = std::make_shared<somas::SomasSolverTensorDesc>(i, GetAlignSize(blocks_[i].address->size_), 0, false);
+  }
+  // the blocks are collected by their first step, so a block only conflicts with the next blocks starting before its
+  // last step
+  auto conflicts = std::make_shared<somas::ConflictMatrix>(blocks_.size(), somas::DynamicBitSet(blocks_.size()));
+  for (size_t i = 0; i < blocks_.size(); ++i) {
+    for (size_t j = i + 1; j < blocks_.size() && blocks_[j].start <= blocks_[i].end; ++j) {
+      (*conflicts)[i].SetBitTrue(j);
+      (*conflicts)[j].SetBitTrue(i);
     }
+  }
 
-    size_t output_num = AnfAlgo::GetOutputTensorNum(kernel);
-    for (size_t i = 0; i < output_num; ++i) {
-      auto address = AnfAlgo::GetMutableOutputAddr(kernel, i);
-      MS_EXCEPTION_IF_NULL(address);
-      if (address->ptr_ == nullptr) {
-        address->ptr_ = mem_ptr;
-        mem_ptr = mem_ptr + address->size_;
-      }
-    }
+  somas::SomasSolverPre solver;
+  if (solver.Solving(graph->graph_id(), &tensors, conflicts, {}, false) != somas::SUCCESS) {
+    MS_LOG(EXCEPTION) << "Plan the memory of graph " << graph->graph_id() << " failed.";
+  }
+  for (size_t i = 0; i < blocks_.size(); ++i) {
+    blocks_[i].offset = tensors[i]->offset_;
+  }
+  return solver.GetMaxOffset();
+}
 
-    auto kernel_mod = AnfAlgo::GetKernelMod(kernel);
-    MS_EXCEPTION_IF_NULL(kernel_mod);
-    for (size_t i = 0; i < kernel_mod->GetWorkspaceSizeList().size(); ++i) {
-      auto address = AnfAlgo::GetWorkspaceAddr(kernel, i);
-      MS_EXCEPTION_IF_NULL(address);
-      if (address->ptr_ == nullptr) {
-        address->ptr_ = mem_ptr;
-        mem_ptr = mem_ptr + address->size_;
-      }
-    }
+size_t CPUSimpleMemPlan::MemPlan(const session::KernelGraph *graph) {
+  MS_EXCEPTION_IF_NULL(graph);
+  CollectMemBlocks(graph);
+  planned_graph_ = graph;
+
+  size_t blocks_size = 0;
+  for (auto &block : blocks_) {
+    block.offset = blocks_size;
+    blocks_size += block.address->size_;
+  }
+  auto context_ptr = MsContext::GetInstance();
+  MS_EXCEPTION_IF_NULL(context_ptr);
+  // kernels launched in parallel overlap in time, every address keeps its own memory then
+  bool mem_reused = context_ptr->get_param<bool>(MS_CTX_ENABLE_MEM_REUSE) &&
+                    context_ptr->get_param<uint32_t>(MS_CTX_CPU_INTER_OP_PARALLEL_NUM) <= 1 && !blocks_.empty();
+  if (mem_reused) {
+    (void)reused_graphs_.insert(graph->graph_id());
+    size_t reused_size = PlanMemReuse(graph);
+    MS_LOG(INFO) << "Graph " << graph->graph_id() << " reuses memory for " << blocks_.size() << " addresses, "
+                 << reused_size << " bytes instead of " << blocks_size << " bytes";
+    blocks_size = reused_size;
+  } else {
+    (void)reused_graphs_.erase(graph->graph_id());
+  }
+  size_t total_mem_size = 32;
+  return total_mem_size + blocks_size;
+}
+
+void CPUSimpleMemPlan::MemAssign(const session::KernelGraph *graph, uint8_t *base_ptr) {
+  MS_EXCEPTION_IF_NULL(graph);
+  MS_EXCEPTION_IF_NULL(base_ptr);
+  if (graph != planned_graph_) {
+    MS_LOG(EXCEPTION) << "The memory of graph " << graph->graph_id() << " is not planned.";
+  }
+  for (auto &block : blocks_) {
+    block.address->ptr_ = base_ptr + block.offset;
   }
+  blocks_.clear();
+  planned_graph_ = nullptr;
 }
 }  // namespace cpu
 }  // namespace device
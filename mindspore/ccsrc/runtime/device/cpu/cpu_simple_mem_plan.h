@@ -16,6 +16,7 @@
 #ifndef MINDSPORE_CCSRC_RUNTIME_DEVICE_CPU_CPU_SIMPLE_MEM_PLAN_H_
 #define MINDSPORE_CCSRC_RUNTIME_DEVICE_CPU_CPU_SIMPLE_MEM_PLAN_H_
 
+#include <unordered_set>
 #include <vector>
 #include "backend/session/kernel_graph.h"
 #include "runtime/device/device_address.h"
@@ -30,6 +31,24 @@ class CPUSimpleMemPlan {
 
   size_t MemPlan(const session::KernelGraph *graph);
   void MemAssign(const session::KernelGraph *graph, uint8_t *base_ptr);
+  // whether the addresses of the graph share memory, its kernels must not be launched in parallel then
+  bool mem_reused(uint32_t graph_id) const { return reused_graphs_.count(graph_id) > 0; }
+  void ClearGraph(uint32_t graph_id) { (void)reused_graphs_.erase(graph_id); }
+
+ private:
+  struct MemBlock {
+    DeviceAddressPtr address;
+    // the steps of the execution order from the kernel writing the address to the last one reading it
+    size_t start;
+    size_t end;
+    size_t offset;
+  };
+  void CollectMemBlocks(const session::KernelGraph *graph);
+  size_t PlanMemReuse(const session::KernelGraph *graph);
+
+  const session::KernelGraph *planned_graph_{nullptr};
+  std::vector<MemBlock> blocks_;
+  std::unordered_set<uint32_t> reused_graphs_;
 };
 }  // namespace cpu
 }  // namespace device
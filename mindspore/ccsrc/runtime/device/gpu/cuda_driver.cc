@@ -188,6 +188,15 @@ bool CudaDriver::RecordEvent(DeviceEvent event, DeviceStream stream) {
   return true;
 }
 
+bool CudaDriver::StreamWaitEvent(DeviceStream stream, const DeviceEvent &event) {
+  auto ret = cudaStreamWaitEvent((cudaStream_t)stream, (cudaEvent_t)event, 0);
+  if (ret != cudaSuccess) {
+    MS_LOG(ERROR) << "cudaStreamWaitEvent failed, ret[" << static_cast<int>(ret) << "], " << cudaGetErrorString(ret);
+    return false;
+  }
+  return true;
+}
+
 bool CudaDriver::SyncEvent(const DeviceEvent &event) {
   auto ret = cudaEventSynchronize((cudaEvent_t)event);
   if (ret != cudaSuccess) {
@@ -55,6 +55,7 @@ class CudaDriver {
   static bool CreateEvent(DeviceEvent *event, unsigned int flag = cudaEventDefault);
   static bool DestroyEvent(const DeviceEvent &event);
   static bool RecordEvent(DeviceEvent event, DeviceStream stream = 0);
+  static bool StreamWaitEvent(DeviceStream stream, const DeviceEvent &event);
   static bool SyncEvent(const DeviceEvent &event);
   static bool QueryEvent(const DeviceEvent &event);
   static bool ElapsedTime(float *cost_time, const DeviceEvent &start, const DeviceEvent &end);
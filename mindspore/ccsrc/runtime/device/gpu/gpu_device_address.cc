@@ -17,6 +17,7 @@
 #include "runtime/device/gpu/gpu_device_address.h"
 #include <vector>
 #include <memory>
+#include "securec/include/securec.h"
 #include "runtime/device/gpu/gpu_device_manager.h"
 #include "utils/log_adapter.h"
 #include "runtime/device/gpu/gpu_memory_allocator.h"
@@ -36,6 +37,9 @@ bool GPUDeviceAddress::SyncDeviceToHost(const ShapeVector &, size_t size, TypeId
   if (!need_sync) {
     return true;
   }
+  if (host_ptr_ != nullptr) {
+    return memcpy_s(host_ptr, size, host_ptr_, size) == EOK;
+  }
   auto &stream = GPUDeviceManager::GetInstance().default_stream();
   MS_EXCEPTION_IF_NULL(stream);
   auto ret = GPUDeviceManager::GetInstance().SyncStream(stream);
@@ -56,6 +60,9 @@ bool GPUDeviceAddress::SyncHostToDevice(const ShapeVector &, size_t size, TypeId
   if (!need_sync) {
     return true;
   }
+  if (host_ptr_ != nullptr) {
+    return memcpy_s(host_ptr_, size_, host_ptr, size) == EOK;
+  }
   auto &stream = GPUDeviceManager::GetInstance().default_stream();
   MS_EXCEPTION_IF_NULL(stream);
   if (size != size_) {
@@ -41,6 +41,8 @@ class GPUDeviceAddress : public DeviceAddress {
   void set_status(DeviceAddressStatus status) { status_ = status; }
   DeviceAddressStatus status() const { return status_; }
   DeviceAddressType DeviceType() const override { return DeviceAddressType::kGPU; }
+  // the data lives in the host memory instead of ptr_, such as the optimizer states offloaded to the host
+  void set_host_ptr(void *host_ptr) { host_ptr_ = host_ptr; }
 
 #ifdef ENABLE_DEBUGGER
   bool LoadMemToHost(const std::string &tensor_name, int execution_order, const std::string &host_fmt,
@@ -48,6 +50,7 @@ class GPUDeviceAddress : public DeviceAddress {
 #endif
  private:
   DeviceAddressStatus status_{DeviceAddressStatus::kInDevice};
+  void *host_ptr_{nullptr};
 };
 }  // namespace gpu
 }  // namespace device
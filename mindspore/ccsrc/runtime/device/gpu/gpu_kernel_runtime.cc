@@ -22,6 +22,7 @@
 #include "runtime/device/gpu/gpu_device_manager.h"
 #include "runtime/device/gpu/gpu_memory_allocator.h"
 #include "runtime/device/gpu/distribution/collective_init.h"
+#include "runtime/device/gpu/distribution/collective_common.h"
 #include "utils/convert_utils.h"
 #include "utils/ms_context.h"
 #include "runtime/device/kernel_runtime_manager.h"
@@ -37,6 +38,8 @@
 #include "utils/shape_utils.h"
 #include "debug/data_dump/dump_json_parser.h"
 #include "backend/kernel_compiler/gpu/gpu_kernel.h"
+#include "backend/optimizer/pass/communication_op_profile.h"
+#include "utils/profile.h"
 #ifdef ENABLE_DEBUGGER
 #include "debug/debug_services.h"
 #endif
@@ -46,10 +49,26 @@ namespace device {
 namespace gpu {
 using mindspore::device::memswap::MemSwapInfoSet;
 using mindspore::device::memswap::MemSwapManager;
+using mindspore::device::memswap::OptimizerOffloadManager;
 using mindspore::device::memswap::SwapKind;
 static const size_t PARAMETER_OUTPUT_INDEX = 0;
+static const size_t kAdamWeightIndex = 0;
+static const size_t kAdamMIndex = 1;
+static const size_t kAdamVIndex = 2;
+static const size_t kAdamBeta1PowerIndex = 3;
+static const size_t kAdamGradIndex = 9;
 bool GPUKernelRuntime::SyncStream() { return GPUDeviceManager::GetInstance().SyncStream(stream_); }
 
+void *GPUKernelRuntime::KernelStream(const AnfNodePtr &kernel) const {
+  MS_EXCEPTION_IF_NULL(kernel);
+  // the AllReduce kernels run on the communication stream assigned to them, when there are more than one of them
+  auto cnode = kernel->cast<CNodePtr>();
+  if (cnode != nullptr && AnfAlgo::HasNodeAttr(kAttrStreamId, cnode)) {
+    return reinterpret_cast<void *>(AnfAlgo::GetNodeAttr<uintptr_t>(cnode, kAttrStreamId));
+  }
+  return stream_;
+}
+
 bool GPUKernelRuntime::Init() {
   auto context_ptr = MsContext::GetInstance();
   MS_EXCEPTION_IF_NULL(context_ptr);
@@ -75,6 +94,8 @@ bool GPUKernelRuntime::Init() {
       reinterpret_cast<InitNCCLComm>(dlsym(const_cast<void *>(collective_handle_), "InitNCCLComm"));
     MS_EXCEPTION_IF_NULL(init_nccl_comm_funcptr);
     (*init_nccl_comm_funcptr)();
+    opt::CommunicationOpProfile::GetInstance().SetProfileReducer(
+      [this](std::vector<float> *profile) { ReduceCommunicationOpProfile(profile); });
   }
   device_init_ = true;
   SetDebugger();
@@ -82,6 +103,8 @@ bool GPUKernelRuntime::Init() {
 }
 
 namespace {
+using AllReduceFunc = ncclResult_t (*)(const void *, void *, size_t, ncclDataType_t, ncclRedOp_t, cudaStream_t,
+                                       const std::string &);
 
 std::vector<int> CheckRealOutput(const std::string &node_name, const size_t &output_size) {
   // define a vector containing real output number
@@ -228,6 +251,14 @@ void GPUKernelRuntime::ReleaseDeviceRes() {
     }
   }
 
+  opt::CommunicationOpProfile::GetInstance().SetProfileReducer(nullptr);
+  // free the pinned host memory of the offloaded optimizer states before the device is released, after the
+  // addresses of the moments stop syncing with it
+  for (auto &address : offload_moment_addresses_) {
+    address->set_host_ptr(nullptr);
+  }
+  offload_moment_addresses_.clear();
+  optimizer_offload_manager_ = nullptr;
   GPUDeviceManager::GetInstance().ReleaseDevice();
   if (mem_manager_ != nullptr) {
     mem_manager_->FreeDeviceMemory();
@@ -604,6 +635,22 @@ bool GPUKernelRuntime::LaunchKernelDynamic(const session::KernelGraph *graph, bo
     profiler_inst->SetStepTraceOpName(profiling_trace);
   }
 
+  // the kernels are synced one by one in the steps profiling the communication ops
+  auto &communication_profile = opt::CommunicationOpProfile::GetInstance();
+  bool record_communication = !mock && !profiling && communication_profile.recording();
+  std::unordered_map<AnfNodePtr, double> kernel_end_time;
+  double step_begin = 0;
+  if (record_communication) {
+    CHECK_OP_RET_WITH_EXCEPT(SyncStream(), "SyncStream failed.");
+    step_begin = GetTime();
+  }
+  auto context_ptr = MsContext::GetInstance();
+  MS_EXCEPTION_IF_NULL(context_ptr);
+  if (!mock && context_ptr->get_param<bool>(MS_CTX_ENABLE_OPTIMIZER_OFFLOAD) &&
+      context_ptr->get_param<int>(MS_CTX_EXECUTION_MODE) != kPynativeMode) {
+    InitOptimizerOffload(graph);
+  }
+
   for (const auto &kernel : kernels) {
     auto kernel_mod = AnfAlgo::GetKernelMod(kernel);
     MS_EXCEPTION_IF_NULL(kernel_mod);
@@ -637,12 +684,18 @@ bool GPUKernelRuntime::LaunchKernelDynamic(const session::KernelGraph *graph, bo
       return false;
     }
     if (!mock) {
-      if (!profiling) {
+      if (LaunchOffloadOptimizer(kernel, kernel_inputs)) {
+        MS_LOG(DEBUG) << "The host runs the offloaded optimizer " << kernel->fullname_with_scope();
+      } else if (!profiling) {
         if (profiler_inst->GetEnableFlag()) {
           profiler_inst->OpDataProducerBegin(kernel->fullname_with_scope(), stream_);
         }
+        double launch_begin = record_communication ? GetTime() : 0;
         CHECK_OP_RET_WITH_EXCEPT(kernel_mod->Launch(kernel_inputs, kernel_workspaces, kernel_outputs, stream_),
                                  "Launch kernel failed.");
+        if (record_communication) {
+          RecordCommunicationOpProfile(kernel, kernel_inputs, step_begin, launch_begin, &kernel_end_time);
+        }
         if (profiler_inst->GetEnableFlag()) {
           profiler_inst->OpDataProducerEnd();
           if (profiler_inst->GetSyncEnableFlag()) {
@@ -652,6 +705,7 @@ bool GPUKernelRuntime::LaunchKernelDynamic(const session::KernelGraph *graph, bo
       } else {
         LaunchKernelWithTimeProfiling(kernel, kernel_inputs, kernel_workspaces, kernel_outputs);
       }
+      CopyOffloadGradients(kernel);
 
       if (gpu_kernel && dynamic_kernel && dynamic_kernel->is_dynamic_shape()) {
         gpu_kernel->PostExecute();
@@ -674,11 +728,13 @@ bool GPUKernelRuntime::LaunchKernelDynamic(const session::KernelGraph *graph, bo
   if (!mock) {
     // collect weights and bias for dump mode
     debugger_->LoadParametersAndConst();
-    auto context_ptr = MsContext::GetInstance();
-    MS_EXCEPTION_IF_NULL(context_ptr);
     if (context_ptr->get_param<int>(MS_CTX_EXECUTION_MODE) != kPynativeMode) {
       CHECK_OP_RET_WITH_EXCEPT(SyncStream(), "SyncStream failed.");
     }
+    CHECK_OP_RET_WITH_EXCEPT(WaitOffloadOptimizer(), "Wait for the offloaded optimizer failed.");
+    if (record_communication) {
+      communication_profile.EndStep();
+    }
   }
   ClearSwapInfo(mock);
   return true;
@@ -744,6 +800,232 @@ void GPUKernelRuntime::LaunchKernelWithTimeProfiling(const AnfNodePtr &kernel, c
   CHECK_OP_RET_WITH_EXCEPT(CudaDriver::DestroyEvent(end), "Failed to destroy event.");
 }
 
+void GPUKernelRuntime::RecordCommunicationOpProfile(const AnfNodePtr &kernel, const AddressPtrList &inputs,
+                                                    double step_begin, double launch_begin,
+                                                    std::unordered_map<AnfNodePtr, double> *kernel_end_time) {
+  MS_EXCEPTION_IF_NULL(kernel_end_time);
+  const double kUSecondInSecond = 1000000;
+  CHECK_OP_RET_WITH_EXCEPT(GPUDeviceManager::GetInstance().SyncStream(KernelStream(kernel)), "SyncStream failed.");
+  double end_time = GetTime();
+  (*kernel_end_time)[kernel] = (end_time - step_begin) * kUSecondInSecond;
+
+  auto &communication_profile = opt::CommunicationOpProfile::GetInstance();
+  std::string group;
+  size_t start_index = 0;
+  if (!communication_profile.FindCommunicationOp(kernel, &group, &start_index)) {
+    return;
+  }
+  double bytes = 0;
+  for (size_t i = 0; i < inputs.size(); ++i) {
+    MS_EXCEPTION_IF_NULL(inputs[i]);
+    bytes += inputs[i]->size;
+    // the input is ready when the kernel producing it ends, or before the step if it is not produced in the step
+    auto producer = AnfAlgo::GetPrevNodeOutput(kernel, i).first;
+    auto iter = kernel_end_time->find(producer);
+    communication_profile.RecordGradReady(group, start_index + i, iter == kernel_end_time->end() ? 0 : iter->second);
+  }
+  communication_profile.RecordCommunication(bytes, (end_time - launch_begin) * kUSecondInSecond);
+}
+
+void GPUKernelRuntime::ReduceCommunicationOpProfile(std::vector<float> *profile) {
+  MS_EXCEPTION_IF_NULL(profile);
+  const void *collective_handle = CollectiveInitializer::instance().collective_handle();
+  MS_EXCEPTION_IF_NULL(collective_handle);
+  auto all_reduce_funcptr = reinterpret_cast<AllReduceFunc>(dlsym(const_cast<void *>(collective_handle), "AllReduce"));
+  MS_EXCEPTION_IF_NULL(all_reduce_funcptr);
+  auto group_size_funcptr =
+    reinterpret_cast<GetGroupSizeFunc>(dlsym(const_cast<void *>(collective_handle), "GetGroupSize"));
+  MS_EXCEPTION_IF_NULL(group_size_funcptr);
+  int rank_size = (*group_size_funcptr)(NCCL_WORLD_GROUP);
+  if (rank_size <= 1 || profile->empty()) {
+    return;
+  }
+  size_t size = profile->size() * sizeof(float);
+  auto device_ptr = mem_manager_->MallocMemFromMemPool(size);
+  MS_EXCEPTION_IF_NULL(device_ptr);
+  CHECK_OP_RET_WITH_EXCEPT(CudaDriver::CopyHostMemToDevice(device_ptr, profile->data(), size),
+                           "Copy the communication op profile to device failed.");
+  CHECK_OP_RET_WITH_EXCEPT((*all_reduce_funcptr)(device_ptr, device_ptr, profile->size(), ncclFloat, ncclSum,
+                                                 reinterpret_cast<cudaStream_t>(stream_), NCCL_WORLD_GROUP) ==
+                             ncclSuccess,
+                           "AllReduce the communication op profile failed.");
+  CHECK_OP_RET_WITH_EXCEPT(SyncStream(), "SyncStream failed.");
+  CHECK_OP_RET_WITH_EXCEPT(CudaDriver::CopyDeviceMemToHost(profile->data(), device_ptr, size),
+                           "Copy the communication op profile to host failed.");
+  mem_manager_->FreeMemFromMemPool(device_ptr);
+  std::transform(profile->begin(), profile->end(), profile->begin(),
+                 [rank_size](float value) { return value / rank_size; });
+}
+
+void GPUKernelRuntime::InitOptimizerOffload(const session::KernelGraph *graph) {
+  MS_EXCEPTION_IF_NULL(graph);
+  if (!offload_graph_ids_.insert(graph->graph_id()).second) {
+    return;
+  }
+  if (optimizer_offload_manager_ == nullptr) {
+    optimizer_offload_manager_ = std::make_shared<OptimizerOffloadManager>(std::make_shared<GPUMemCopyManager>());
+  }
+  auto context_ptr = MsContext::GetInstance();
+  MS_EXCEPTION_IF_NULL(context_ptr);
+  bool dynamic_mem_pool = context_ptr->get_param<bool>(MS_CTX_ENABLE_DYNAMIC_MEM_POOL);
+  // the master weights start from the weights on the device
+  CHECK_OP_RET_WITH_EXCEPT(SyncStream(), "SyncStream failed.");
+  auto &kernels = graph->execution_order();
+  std::unordered_set<AnfNodePtr> launched_kernels;
+  for (const auto &kernel : kernels) {
+    launched_kernels.insert(kernel);
+    if (AnfAlgo::GetCNodeName(kernel) != kApplyAdamOpName) {
+      continue;
+    }
+    auto weight = AnfAlgo::GetPrevNodeOutput(kernel, kAdamWeightIndex).first;
+    auto m = AnfAlgo::GetPrevNodeOutput(kernel, kAdamMIndex).first;
+    auto v = AnfAlgo::GetPrevNodeOutput(kernel, kAdamVIndex).first;
+    auto weight_type = AnfAlgo::GetInputDeviceDataType(kernel, kAdamWeightIndex);
+    if (!weight->isa<Parameter>() || !m->isa<Parameter>() || !v->isa<Parameter>() ||
+        (weight_type != kNumberTypeFloat32 && weight_type != kNumberTypeFloat16)) {
+      continue;
+    }
+    auto weight_address = AnfAlgo::GetPrevNodeMutableOutputAddr(kernel, kAdamWeightIndex);
+    MS_EXCEPTION_IF_NULL(weight_address);
+    size_t size = weight_address->GetSize();
+    std::vector<uint8_t> host_weight(size);
+    CHECK_OP_RET_WITH_EXCEPT(CudaDriver::CopyDeviceMemToHost(host_weight.data(), weight_address->ptr_, size),
+                             "Copy the weight of the offloaded optimizer to host failed.");
+    size_t elem_num = size / GetTypeByte(TypeIdToType(weight_type));
+    auto use_nesterov = AnfAlgo::GetNodeAttr<bool>(kernel, "use_nesterov");
+    auto index = optimizer_offload_manager_->AddParameter(weight->fullname_with_scope(), weight_address->ptr_,
+                                                          host_weight.data(), elem_num, weight_type, use_nesterov);
+    offload_parameter_index_[kernel] = index;
+    // the moments start from the device, then their device memory is released and the addresses sync with the host
+    // moments instead, so the checkpoints and load_param_into_net read and write the host ones
+    auto &parameter = optimizer_offload_manager_->parameter(index);
+    std::vector<std::pair<size_t, HostAddress>> moments = {{kAdamMIndex, parameter->device_m_},
+                                                           {kAdamVIndex, parameter->device_v_}};
+    for (auto &moment : moments) {
+      auto address =
+        std::dynamic_pointer_cast<GPUDeviceAddress>(AnfAlgo::GetPrevNodeMutableOutputAddr(kernel, moment.first));
+      MS_EXCEPTION_IF_NULL(address);
+      if (address->GetSize() != moment.second.size) {
+        MS_LOG(EXCEPTION) << "The size of the moment " << address->GetSize() << " of the offloaded parameter "
+                          << parameter->name_ << " is not equal to the host one " << moment.second.size;
+      }
+      CHECK_OP_RET_WITH_EXCEPT(CudaDriver::CopyDeviceMemToHost(moment.second.addr, address->ptr_, address->size_),
+                               "Copy the moment of the offloaded optimizer to host failed.");
+      if (address->from_mem_pool_ && dynamic_mem_pool) {
+        mem_manager_->FreeMemFromMemPool(address);
+      }
+      address->from_mem_pool_ = false;
+      address->ptr_ = nullptr;
+      address->set_host_ptr(moment.second.addr);
+      offload_moment_addresses_.push_back(address);
+    }
+    optimizer_offload_manager_->ReloadStates(index);
+    offload_state_index_[weight] = index;
+    offload_state_index_[m] = index;
+    offload_state_index_[v] = index;
+    // the gradient is copied to the host in backward when it is produced by a kernel of the graph
+    auto grad_kernel = AnfAlgo::GetPrevNodeOutput(kernel, kAdamGradIndex).first;
+    if (launched_kernels.count(grad_kernel) != 0) {
+      offload_grad_users_[grad_kernel].push_back(kernel);
+    }
+  }
+  MS_LOG(INFO) << "The states of Adam of " << offload_parameter_index_.size()
+               << " parameters are offloaded to the host for graph " << graph->graph_id();
+}
+
+void GPUKernelRuntime::CopyOffloadGradients(const AnfNodePtr &kernel) {
+  auto iter = offload_grad_users_.find(kernel);
+  if (iter == offload_grad_users_.end()) {
+    return;
+  }
+  // the gradient is copied on the stream of the kernel producing it, which is the communication stream of AllReduce
+  auto stream = KernelStream(kernel);
+  for (const auto &adam : iter->second) {
+    auto &parameter = optimizer_offload_manager_->parameter(offload_parameter_index_[adam]);
+    auto grad_address = GetPrevNodeMutableOutputAddr(adam, kAdamGradIndex, true);
+    MS_EXCEPTION_IF_NULL(grad_address);
+    CHECK_OP_RET_WITH_EXCEPT(
+      CudaDriver::CopyDeviceMemToHostAsync(parameter->grad_.addr, grad_address->ptr_, parameter->grad_.size, stream),
+      "Copy the gradient of the offloaded optimizer to host failed.");
+    DeviceEvent event = nullptr;
+    if (stream != stream_) {
+      CHECK_OP_RET_WITH_EXCEPT(CudaDriver::CreateEvent(&event, cudaEventDisableTiming), "Create event failed.");
+      CHECK_OP_RET_WITH_EXCEPT(CudaDriver::RecordEvent(event, stream), "Record event failed.");
+    }
+    offload_grad_copied_[adam] = event;
+  }
+}
+
+bool GPUKernelRuntime::LaunchOffloadOptimizer(const AnfNodePtr &kernel, const AddressPtrList &inputs) {
+  auto iter = offload_parameter_index_.find(kernel);
+  if (iter == offload_parameter_index_.end()) {
+    return false;
+  }
+  auto &parameter = optimizer_offload_manager_->parameter(iter->second);
+  auto copied_iter = offload_grad_copied_.find(kernel);
+  if (copied_iter == offload_grad_copied_.end()) {
+    CHECK_OP_RET_WITH_EXCEPT(CudaDriver::CopyDeviceMemToHostAsync(parameter->grad_.addr,
+                                                                  inputs[kAdamGradIndex]->addr,
+                                                                  parameter->grad_.size, stream_),
+                             "Copy the gradient of the offloaded optimizer to host failed.");
+  } else {
+    // the gradient may be reused after Adam, so the kernels after it wait for the copy on the communication stream,
+    // and the event recorded below covers the copy
+    auto grad_event = copied_iter->second;
+    offload_grad_copied_.erase(copied_iter);
+    if (grad_event != nullptr) {
+      CHECK_OP_RET_WITH_EXCEPT(CudaDriver::StreamWaitEvent(stream_, grad_event), "Stream wait event failed.");
+      CHECK_OP_RET_WITH_EXCEPT(CudaDriver::DestroyEvent(grad_event), "Destroy event failed.");
+    }
+  }
+  // the scalar inputs may be updated in the step, so they are copied where Adam runs
+  auto hyper_params = static_cast<uint8_t *>(parameter->hyper_params_.addr);
+  for (size_t i = 0; i < memswap::kOffloadHyperParamNum; ++i) {
+    auto &input = inputs[kAdamBeta1PowerIndex + i];
+    CHECK_OP_RET_WITH_EXCEPT(
+      CudaDriver::CopyDeviceMemToHostAsync(hyper_params + i * input->size, input->addr, input->size, stream_),
+      "Copy the hyper params of the offloaded optimizer to host failed.");
+  }
+  DeviceEvent event = nullptr;
+  CHECK_OP_RET_WITH_EXCEPT(CudaDriver::CreateEvent(&event, cudaEventDisableTiming), "Create event failed.");
+  CHECK_OP_RET_WITH_EXCEPT(CudaDriver::RecordEvent(event, stream_), "Record event failed.");
+  // the update runs on the worker of the manager while the kernels after it go on
+  auto device_id = device_id_;
+  optimizer_offload_manager_->PushUpdate(iter->second, [event, device_id]() {
+    bool ret = CudaDriver::set_current_device(UintToInt(device_id)) && CudaDriver::SyncEvent(event);
+    return CudaDriver::DestroyEvent(event) && ret;
+  });
+  return true;
+}
+
+bool GPUKernelRuntime::WaitOffloadOptimizer() {
+  if (optimizer_offload_manager_ == nullptr) {
+    return true;
+  }
+  // the weights are read by the kernels of the step until it ends
+  return optimizer_offload_manager_->WaitStep([](void *device_weight, const void *host_weight, size_t size) {
+    return CudaDriver::CopyHostMemToDevice(device_weight, host_weight, size);
+  });
+}
+
+void GPUKernelRuntime::ReloadOffloadStates(const AnfNodePtr &parameter) {
+  auto iter = offload_state_index_.find(parameter);
+  if (iter == offload_state_index_.end()) {
+    return;
+  }
+  // the moments are written to the host directly, while the weight is copied back from the device
+  auto &offload_parameter = optimizer_offload_manager_->parameter(iter->second);
+  auto address = AnfAlgo::GetMutableOutputAddr(parameter, 0);
+  MS_EXCEPTION_IF_NULL(address);
+  if (address->ptr_ == offload_parameter->device_weight_) {
+    auto &weight = offload_parameter->weight_;
+    CHECK_OP_RET_WITH_EXCEPT(CudaDriver::CopyDeviceMemToHost(weight.addr, address->ptr_, weight.size),
+                             "Copy the weight of the offloaded optimizer to host failed.");
+  }
+  optimizer_offload_manager_->ReloadStates(iter->second);
+  MS_LOG(INFO) << "Reload the offloaded optimizer states of parameter " << offload_parameter->name_;
+}
+
 bool GPUKernelRuntime::AddMemorySwapTask(const AnfNodePtr &kernel, bool mock, bool profiling) {
   MS_EXCEPTION_IF_NULL(mem_swap_manager_);
   const MemSwapInfoSet &mem_swap_info_set = mem_swap_manager_->QueryKernelMemSwapInfo(kernel);
@@ -923,7 +1205,10 @@ bool GPUKernelRuntime::AllocKernelInputDynamicRes(const mindspore::AnfNodePtr &k
 
     MS_EXCEPTION_IF_NULL(device_address);
     UpdateHostSwapInQueue(device_address, mock);
-    MS_EXCEPTION_IF_NULL(device_address->ptr_);
+    // the moments of the offloaded optimizer have no device memory
+    if (offload_parameter_index_.count(kernel) == 0) {
+      MS_EXCEPTION_IF_NULL(device_address->ptr_);
+    }
     kernel::AddressPtr input = std::make_shared<kernel::Address>();
     MS_EXCEPTION_IF_NULL(input);
     input->addr = device_address->ptr_;
@@ -28,12 +28,15 @@
 #include "backend/session/anf_runtime_algorithm.h"
 #include "runtime/device/kernel_runtime.h"
 #include "runtime/device/kernel_runtime_manager.h"
+#include "runtime/device/gpu/gpu_device_address.h"
 #include "backend/optimizer/mem_reuse/mem_swap_manager.h"
+#include "backend/optimizer/mem_reuse/optimizer_offload_manager.h"
 
 namespace mindspore {
 namespace device {
 namespace gpu {
 using mindspore::device::memswap::MemSwapManagerPtr;
+using mindspore::device::memswap::OptimizerOffloadManagerPtr;
 class GPUKernelRuntime : public KernelRuntime {
  public:
   GPUKernelRuntime() = default;
@@ -45,6 +48,8 @@ class GPUKernelRuntime : public KernelRuntime {
                                  const std::vector<CNodePtr> &execution_order) override;
   void AssignMemory(session::KernelGraph *graph) override;
   bool Run(session::KernelGraph *graph, bool is_task_sink) override;
+  // reload the offloaded optimizer states of the parameter after its device memory is rewritten by the session
+  void ReloadOffloadStates(const AnfNodePtr &parameter);
   bool GenDynamicKernel(const session::KernelGraph *graph) override { return true; }
   bool RunDynamicKernelAsync(const session::KernelGraph *graph) override { return true; }
 
@@ -76,6 +81,12 @@ class GPUKernelRuntime : public KernelRuntime {
   bool RunOpLaunchKernelDynamic(const session::KernelGraph *graph);
   void LaunchKernelWithTimeProfiling(const AnfNodePtr &kernel, const AddressPtrList &inputs,
                                      const AddressPtrList &workspace, const AddressPtrList &outputs);
+  // the stream the kernel is launched on
+  void *KernelStream(const AnfNodePtr &kernel) const;
+  // sync the kernel to record its end time, and the times the inputs of the profiled communication ops are ready
+  void RecordCommunicationOpProfile(const AnfNodePtr &kernel, const AddressPtrList &inputs, double step_begin,
+                                    double launch_begin, std::unordered_map<AnfNodePtr, double> *kernel_end_time);
+  void ReduceCommunicationOpProfile(std::vector<float> *profile);
   bool AttemptMallocMem(const DeviceAddressPtr &device_address, size_t size, bool mock);
   bool AllocKernelDynamicRes(const mindspore::kernel::KernelMod &kernel_mod, const mindspore::AnfNodePtr &kernel,
                              AddressPtrList *kernel_inputs, AddressPtrList *kernel_workspaces,
@@ -99,6 +110,11 @@ class GPUKernelRuntime : public KernelRuntime {
   void UpdateHostSwapOutQueue(bool mock);
   void ClearSwapInfo(bool mock);
   void AllocInplaceNodeMemory(const session::KernelGraph *graph);
+  // run the Adam kernels on the host with the states kept in the host memory
+  void InitOptimizerOffload(const session::KernelGraph *graph);
+  void CopyOffloadGradients(const AnfNodePtr &kernel);
+  bool LaunchOffloadOptimizer(const AnfNodePtr &kernel, const AddressPtrList &inputs);
+  bool WaitOffloadOptimizer();
   bool IsDistributedTraining(const session::KernelGraph *graph);
 
   DeviceAddressPtr GetPrevNodeMutableOutputAddr(const AnfNodePtr &node, size_t i, bool visit_nop_node);
@@ -115,6 +131,19 @@ class GPUKernelRuntime : public KernelRuntime {
   MemReuseUtilPtr mem_reuse_util_{nullptr};
   MemSwapManagerPtr mem_swap_manager_{nullptr};
 
+  OptimizerOffloadManagerPtr optimizer_offload_manager_{nullptr};
+  std::unordered_set<uint32_t> offload_graph_ids_;
+  // key: Adam kernel, value: the index of its parameter in the optimizer offload manager
+  std::unordered_map<AnfNodePtr, size_t> offload_parameter_index_;
+  // key: the weight or the moment of an offloaded Adam, value: the index of its parameter in the manager
+  std::unordered_map<AnfNodePtr, size_t> offload_state_index_;
+  // the addresses of the offloaded moments, which sync with the host memory of the manager
+  std::vector<std::shared_ptr<GPUDeviceAddress>> offload_moment_addresses_;
+  // key: gradient kernel, value: the Adam kernels whose gradients are copied right after it runs
+  std::unordered_map<AnfNodePtr, std::vector<AnfNodePtr>> offload_grad_users_;
+  // key: Adam kernel, value: the event recorded after its gradient is copied on the communication stream
+  std::unordered_map<AnfNodePtr, void *> offload_grad_copied_;
+
   bool enable_relation_cache_{false};
 
   std::unordered_map<AnfNodePtr, std::vector<DeviceAddressPtr>> prev_node_mut_output_addr_cache_;
@@ -77,7 +77,7 @@ class IrExporter {
 
 class IrExportBuilder {
  public:
-  IrExportBuilder() = default;
+  explicit IrExportBuilder(bool export_param_data = true) : export_param_data_(export_param_data) {}
   ~IrExportBuilder() { google::protobuf::ShutdownProtobufLibrary(); }
   std::string GetProtoString(const FuncGraphPtr &func_graph);
   void BuildModelInfo();
@@ -127,6 +127,8 @@ class IrExportBuilder {
   std::map<AnfNodePtr, size_t> node_index_map_;
   size_t node_index_{0};
   size_t shape_index_{0};
+  // the weights are exported without their data when the caller binds them to live tensors after loading
+  bool export_param_data_{true};
 };
 
 using IrExporterPtr = std::shared_ptr<IrExporter>;
@@ -192,7 +194,7 @@ void IrExportBuilder::BuildParameters(const FuncGraphPtr &func_graph, mind_ir::G
       parameter_proto->set_name(param_name);
       SetParamToTensorProto(param, parameter_proto);
       auto tensor = std::dynamic_pointer_cast<tensor::Tensor>(param->default_param());
-      if (tensor) {
+      if (tensor && export_param_data_) {
         parameter_proto->set_raw_data(tensor->data_c(), tensor->data().nbytes());
       }
     } else {
@@ -690,8 +692,8 @@ void IrExportBuilder::SetSequenceToAttributeProto(const ValueSequeuePtr &value,
   }
 }
 
-std::string GetBinaryProtoString(const FuncGraphPtr &func_graph) {
-  auto builder = std::make_shared<IrExportBuilder>();
+std::string GetBinaryProtoString(const FuncGraphPtr &func_graph, bool export_param_data) {
+  auto builder = std::make_shared<IrExportBuilder>(export_param_data);
   if (builder == nullptr) {
     MS_LOG(ERROR) << "Create ir exporter failed!";
     return "";
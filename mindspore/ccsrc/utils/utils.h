@@ -245,6 +245,10 @@ constexpr auto kBasicLSTMCellCStateGradOpName = "BasicLSTMCellCStateGrad";
 constexpr auto kBasicLSTMCellCStateGradV2OpName = "BasicLSTMCellCStateGradV2";
 constexpr auto kMatMulV2OpName = "MatMulV2";
 constexpr auto kBroadcastToOpName = "BroadcastTo";
+constexpr auto kReluOpName = "ReLU";
+constexpr auto kFusedMatMulBiasAddName = "FusedMatMulBiasAdd";
+constexpr auto kFusedConv2DBiasAddName = "FusedConv2DBiasAdd";
+constexpr auto kFusedElemwiseName = "FusedElemwise";
 
 // Hcom Op Type
 constexpr auto kHcomOpTypeAllReduce = "HcomAllReduce";
@@ -343,6 +347,10 @@ constexpr auto kAttrPynativeNextOpName = "next_op";
 constexpr auto kAttrPynativeNextIndex = "next_index";
 constexpr auto kAttrCompileInfo = "compile_info";
 constexpr auto kAttrFusionType = "fusion_type";
+constexpr auto kAttrActivation = "activation";
+constexpr auto kAttrFusedOps = "fused_ops";
+constexpr auto kAttrFusedOpInputs = "fused_op_inputs";
+constexpr auto kAttrRecompute = "recompute";
 
 // attr value
 constexpr auto kValueTargetSwitch = "target_switch";
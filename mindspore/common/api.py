@@ -317,6 +317,18 @@ class _PynativeExecutor:
     def sync(self):
         self._executor.sync()
 
+    def start_op_trace(self):
+        self._executor.start_op_trace()
+
+    def stop_op_trace(self):
+        return self._executor.stop_op_trace()
+
+    def warm_up_op_graph_cache(self):
+        self._executor.warm_up_op_graph_cache()
+
+    def op_graph_cache_info(self):
+        return self._executor.op_graph_cache_info()
+
     def set_grad_flag(self, flag):
         self._executor.set_grad_flag(flag)
 
@@ -88,7 +88,7 @@ class Tensor(Tensor_):
         self._virtual_flag = False
 
     def __repr__(self):
-        Tensor_.data_sync(self, False)
+        Tensor_.data_sync(self, True)
         return Tensor_.__repr__(self)
 
     def __add__(self, other):
@@ -36,6 +36,7 @@ __all__ = ['GRAPH_MODE', 'PYNATIVE_MODE', 'set_context', 'get_context', 'set_aut
 GRAPH_MODE = 0
 PYNATIVE_MODE = 1
 _DEVICE_APP_MEMORY_SIZE = 31 # The max memory size of graph plus variable.
+_MAX_INTER_OP_PARALLEL_NUM = 64
 _re_pattern = r'[1-9][0-9]*(\.)?[0-9]*GB|0\.[0-9]*GB'
 _k_context = None
 
@@ -193,6 +194,11 @@ class _Context:
     def set_save_graphs_path(self, save_graphs_path):
         self.set_param(ms_ctx_param.save_graphs_path, _make_directory(save_graphs_path))
 
+    def set_compile_cache_path(self, compile_cache_path):
+        if compile_cache_path:
+            compile_cache_path = _make_directory(compile_cache_path)
+        self.set_param(ms_ctx_param.compile_cache_path, compile_cache_path)
+
     def set_device_target(self, target):
         valid_targets = ["CPU", "GPU", "Ascend", "Davinci"]
         if not target in valid_targets:
@@ -213,6 +219,17 @@ class _Context:
             raise ValueError(f"Max call depth must be greater than 0, but got {max_call_depth}")
         self.set_param(ms_ctx_param.max_call_depth, max_call_depth)
 
+    def set_cpu_inter_op_parallel_num(self, cpu_inter_op_parallel_num):
+        if cpu_inter_op_parallel_num <= 0 or cpu_inter_op_parallel_num > _MAX_INTER_OP_PARALLEL_NUM:
+            raise ValueError(f"Cpu inter op parallel num must be in [1, {_MAX_INTER_OP_PARALLEL_NUM}], "
+                             f"but got {cpu_inter_op_parallel_num}")
+        self.set_param(ms_ctx_param.cpu_inter_op_parallel_num, cpu_inter_op_parallel_num)
+
+    def set_op_graph_cache_capacity(self, op_graph_cache_capacity):
+        if op_graph_cache_capacity <= 0:
+            raise ValueError(f"Op graph cache capacity must be greater than 0, but got {op_graph_cache_capacity}")
+        self.set_param(ms_ctx_param.op_graph_cache_capacity, op_graph_cache_capacity)
+
     def set_profiling_options(self, option):
         options = ["training_trace", "task_trace",
                    "task_trace:training_trace", "training_trace:task_trace", "op_trace"]
@@ -242,6 +259,12 @@ class _Context:
             raise ValueError("Context param max_device_memory should be in correct format! Such as \"3.5GB\"")
         self.set_param(ms_ctx_param.max_device_memory, max_device_memory_value)
 
+    def set_recompute_memory_budget(self, recompute_memory_budget):
+        if recompute_memory_budget != "0GB" and not Validator.check_str_by_regular(recompute_memory_budget,
+                                                                                   _re_pattern):
+            raise ValueError("Context param recompute_memory_budget should be in correct format! Such as \"2GB\"")
+        self.set_param(ms_ctx_param.recompute_memory_budget, float(recompute_memory_budget[:-2]))
+
     def set_print_file_path(self, file_path):
         """Add timestamp suffix to file name. Sets print file path."""
         print_file_path = os.path.realpath(file_path)
@@ -261,12 +284,16 @@ class _Context:
         'mode': set_mode,
         'backend_policy': set_backend_policy,
         'save_graphs_path': set_save_graphs_path,
+        'compile_cache_path': set_compile_cache_path,
         'device_target': set_device_target,
         'device_id': set_device_id,
         'max_call_depth': set_max_call_depth,
+        'cpu_inter_op_parallel_num': set_cpu_inter_op_parallel_num,
+        'op_graph_cache_capacity': set_op_graph_cache_capacity,
         'profiling_options': set_profiling_options,
         'variable_memory_max_size': set_variable_memory_max_size,
         'max_device_memory': set_max_device_memory,
+        'recompute_memory_budget': set_recompute_memory_budget,
         'print_file_path': set_print_file_path
     }
 
@@ -321,7 +348,7 @@ def _context():
 @args_type_check(device_num=int, global_rank=int, gradients_mean=bool, gradient_fp32_sync=bool, parallel_mode=str,
                  auto_parallel_search_mode=str, parameter_broadcast=bool, strategy_ckpt_load_file=str,
                  strategy_ckpt_save_file=str, full_batch=bool, enable_parallel_optimizer=bool,
-                 all_reduce_fusion_config=list, pipeline_stages=int)
+                 all_reduce_fusion_config=list, pipeline_stages=int, all_reduce_fusion_profile_steps=int)
 def set_auto_parallel_context(**kwargs):
     r"""
     Set auto parallel context, which is valid only for Ascend and GPU target.
@@ -338,17 +365,17 @@ def set_auto_parallel_context(**kwargs):
 
     Some configurations are parallel mode specific, see the below table for details:
 
-    ===========================  ===========================
-    Common                       AUTO_PARALLEL
-    ===========================  ===========================
-    device_num                   gradient_fp32_sync
-    global_rank                  loss_repeated_mean
-    gradients_mean               auto_parallel_search_mode
-    parallel_mode                strategy_ckpt_load_file
-    all_reduce_fusion_config     strategy_ckpt_save_file
-    enable_parallel_optimizer    full_batch
-               \                 pipeline_stages
-    ===========================  ===========================
+    ===============================  ===========================
+    Common                           AUTO_PARALLEL
+    ===============================  ===========================
+    device_num                       gradient_fp32_sync
+    global_rank                      loss_repeated_mean
+    gradients_mean                   auto_parallel_search_mode
+    parallel_mode                    strategy_ckpt_load_file
+    all_reduce_fusion_config         strategy_ckpt_save_file
+    enable_parallel_optimizer        full_batch
+    all_reduce_fusion_profile_steps  pipeline_stages
+    ===============================  ===========================
 
     Args:
         device_num (int): Available device number, the value must be in [1, 4096]. Default: 1.
@@ -388,6 +415,11 @@ def set_auto_parallel_context(**kwargs):
                        Default: False.
         all_reduce_fusion_config (list): Set allreduce fusion strategy by parameters indices. Only support ReduceOp.SUM
                        and HCCL_WORLD_GROUP/NCCL_WORLD_GROUP. No Default, if it is not set, the fusion is closed.
+        all_reduce_fusion_profile_steps (int): The number of the first steps recording the time each gradient is
+                       produced in backward, and the time of the allreduce. The fused allreduce of gradients is split
+                       to overlap with the remaining backward computation as much as possible, and the split indices
+                       are used when the network is compiled again. Only GPU records the steps. 0 means the fusion is
+                       not profiled. Default: 0.
         pipeline_stages (int): Set the stage information for pipeline parallel. This indicates how
                         the devices are distributed alone the pipeline. The total devices will be divided into
                         'pipeline_stags' stages. This currently could only be used when
@@ -409,6 +441,7 @@ def set_auto_parallel_context(**kwargs):
         >>> context.set_auto_parallel_context(full_batch=True)
         >>> context.set_auto_parallel_context(enable_parallel_optimizer=False)
         >>> context.set_auto_parallel_context(all_reduce_fusion_config=[8, 160])
+        >>> context.set_auto_parallel_context(all_reduce_fusion_profile_steps=5)
         >>> context.set_auto_parallel_context(pipeline_stages=2)
     """
     _set_auto_parallel_context(**kwargs)
@@ -445,6 +478,7 @@ def reset_auto_parallel_context():
     - full_batch: False.
     - enable_parallel_optimizer: False.
     - pipeline_stages: 1.
+    - all_reduce_fusion_profile_steps: 0, and the split indices profiled before are cleared.
     """
     _reset_auto_parallel_context()
 
@@ -461,7 +495,10 @@ def _check_target_specific_cfgs(device, arg_key):
         'profiling_options': ['Ascend'],
         'print_file_path': ['Ascend'],
         'variable_memory_max_size': ['Ascend'],
-        'max_device_memory': ['GPU']
+        'max_device_memory': ['GPU'],
+        'enable_optimizer_offload': ['GPU'],
+        'cpu_inter_op_parallel_num': ['CPU'],
+        'enable_cpu_fusion': ['CPU']
     }
     # configs not in map device_cfgs are supposed to be suitable for all devices
     if not arg_key in device_cfgs:
@@ -479,7 +516,11 @@ def _check_target_specific_cfgs(device, arg_key):
                  save_dump_path=str, enable_reduce_precision=bool, variable_memory_max_size=str,
                  enable_profiling=bool, profiling_options=str, enable_auto_mixed_precision=bool,
                  enable_graph_kernel=bool, check_bprop=bool, max_device_memory=str, print_file_path=str,
-                 enable_sparse=bool, max_call_depth=int)
+                 enable_sparse=bool, max_call_depth=int, cpu_inter_op_parallel_num=int,
+                 compile_cache_path=str, enable_pynative_async=bool, op_graph_cache_capacity=int,
+                 enable_parallel_infer=bool, enable_incremental_compile=bool, enable_ir_arena=bool,
+                 enable_cpu_fusion=bool, recompute_memory_budget=str,
+                 enable_optimizer_offload=bool)
 def set_context(**kwargs):
     """
     Sets context for running environment.
@@ -501,19 +542,26 @@ def set_context(**kwargs):
 
     Some configurations are device specific, see the bellow table for details:
 
-    ===========================  ===========================  =================
-    Common(CPU/GPU/Ascend)       Ascend                       GPU
-    ===========================  ===========================  =================
-    check_bprop                  enable_auto_mixed_precision  max_device_memory
-    device_id                    enable_dump                  enable_graph_kernel
-    device_target                save_dump_path
-    enable_sparse                enable_graph_kernel
-    max_call_depth               enable_reduce_precision
-    mode                         enable_profiling
-    reserve_class_name_in_scope  profiling_options
-    save_graphs                  variable_memory_max_size
-    save_graphs_path             print_file_path
-    ===========================  ===========================  =================
+    ===========================  ===========================  ========================  =========================
+    Common(CPU/GPU/Ascend)       Ascend                       GPU                       CPU
+    ===========================  ===========================  ========================  =========================
+    check_bprop                  enable_auto_mixed_precision  max_device_memory         cpu_inter_op_parallel_num
+    compile_cache_path           enable_dump                  enable_graph_kernel
+    device_id                    save_dump_path                                         enable_cpu_fusion
+    device_target                enable_graph_kernel          enable_optimizer_offload
+    enable_incremental_compile   enable_reduce_precision
+    enable_ir_arena              enable_profiling
+    enable_parallel_infer        profiling_options
+    enable_pynative_async        variable_memory_max_size
+    enable_sparse                print_file_path
+    max_call_depth
+    mode
+    op_graph_cache_capacity
+    recompute_memory_budget
+    reserve_class_name_in_scope
+    save_graphs
+    save_graphs_path
+    ===========================  ===========================  ========================  =========================
 
     Args:
         mode (int): Running in GRAPH_MODE(0) or PYNATIVE_MODE(1). Default: PYNATIVE_MODE(1).
@@ -522,6 +570,10 @@ def set_context(**kwargs):
                     while device_num_per_host should be no more than 4096. Default: 0.
         save_graphs (bool): Whether to save graphs. Default: False.
         save_graphs_path (str): Path to save graphs. Default: "."
+        compile_cache_path (str): Directory where the graphs compiled in GRAPH_MODE are cached, a later run compiling
+            the same network with the same inputs, context and version loads the graph from it instead of compiling
+            it again. The graphs with control flow and the distributed modes other than data parallel are not
+            cached. Empty string disables the cache. Default: "".
         enable_auto_mixed_precision (bool): Whether to enable auto mixed precision. Default: False.
         enable_graph_kernel (bool): Whether to enable composition of basic primitives. These primitives would be
             compiled into a fused kernel automatically. Default: False.
@@ -554,7 +606,34 @@ def set_context(**kwargs):
             a file by default, and turns off printing to the screen. If the file already exists, add a timestamp
             suffix to the file. Default: ''.
         enable_sparse (bool): Whether to enable sparsity feature. Default: False.
+        enable_pynative_async (bool): Whether to dispatch the operators of PYNATIVE_MODE to the executor thread
+            without waiting for them. Their outputs are returned with the inferred shape and type at once, and the
+            data is synchronized when it is read on host, such as `asnumpy`, printing or converting to bool.
+            The operators are still run one by one while recording the grad graph. Default: False.
+        enable_parallel_infer (bool): Whether to infer the independent operators of a graph with C++ infer functions
+            on several threads while compiling in GRAPH_MODE. Default: False.
+        enable_incremental_compile (bool): Whether to reuse the parsed and resolved graph of a network when it is
+            compiled again in GRAPH_MODE with inputs of other shapes or types, only type inference, specialization,
+            the later passes and the kernel build are run again. The attributes of the network used while parsing
+            are supposed to be unchanged between the compilations. Default: False.
+        enable_ir_arena (bool): Whether to allocate the nodes created while compiling in GRAPH_MODE from chunks of
+            memory instead of one by one. A chunk is released when all the nodes in it are released. Default: False.
         max_call_depth(int): Specify the maximum depth of function call. Default: 1000.
+        cpu_inter_op_parallel_num(int): Number of threads launching independent kernels of a graph at the same time
+            on CPU, 1 launches them one by one in execution order. Default: 1.
+        enable_cpu_fusion(bool): Whether to fuse the operators of the graphs run on CPU, e.g. MatMul with the BiasAdd
+            and ReLU after it, the chains of elementwise operators and the Adam updates. Default: True.
+        op_graph_cache_capacity(int): Maximum number of the graphs built for the operators of PYNATIVE_MODE kept by
+            the session, the least recently used one is released when a new one is built. Default: 1024.
+        recompute_memory_budget(str): The memory for the forward activations kept until the backward pass in
+            GRAPH_MODE. The format is "xxGB". If the activations are estimated to be larger, the cheap operators
+            keeping the largest ones, such as the activation functions, are computed again in the backward pass
+            instead, as the operators marked by `Cell.recompute` or `Primitive.recompute` are. "0GB" means no budget.
+            Default: "0GB".
+        enable_optimizer_offload(bool): Whether to keep the moments of Adam and the float32 master weights in the host
+            memory and run Adam on CPU. The gradients are copied to the host while the backward pass goes on, and the
+            updated weights are copied back at the end of the step. Only Adam on GPU is offloaded, and the moments on
+            the device are no longer updated. Default: False.
 
     Raises:
         ValueError: If input key is not an attribute in context.
@@ -576,6 +655,16 @@ def set_context(**kwargs):
         >>> context.set_context(max_device_memory="3.5GB")
         >>> context.set_context(print_file_path="print.pb")
         >>> context.set_context(max_call_depth=80)
+        >>> context.set_context(cpu_inter_op_parallel_num=4)
+        >>> context.set_context(enable_pynative_async=True)
+        >>> context.set_context(op_graph_cache_capacity=256)
+        >>> context.set_context(mode=context.GRAPH_MODE, compile_cache_path="./compile_cache")
+        >>> context.set_context(mode=context.GRAPH_MODE, enable_parallel_infer=True)
+        >>> context.set_context(mode=context.GRAPH_MODE, enable_incremental_compile=True)
+        >>> context.set_context(mode=context.GRAPH_MODE, enable_ir_arena=True)
+        >>> context.set_context(device_target="CPU", enable_cpu_fusion=False)
+        >>> context.set_context(mode=context.GRAPH_MODE, recompute_memory_budget="2GB")
+        >>> context.set_context(device_target="GPU", enable_optimizer_offload=True)
     """
     ctx = _context()
     # set device target first
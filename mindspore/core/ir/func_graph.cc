@@ -24,6 +24,7 @@
 
 #include "utils/trace_base.h"
 #include "ir/manager.h"
+#include "ir/ir_arena.h"
 #include "utils/flags.h"
 #include "utils/ordered_set.h"
 #include "utils/convert_utils_base.h"
@@ -69,7 +70,7 @@ AnfNodePtr FuncGraph::output() const {
 
 ParameterPtr FuncGraph::add_parameter() {
   FuncGraphPtr this_func_graph = shared_from_base<FuncGraph>();
-  ParameterPtr p = std::make_shared<Parameter>(this_func_graph);
+  ParameterPtr p = MakeIrNode<Parameter>(this_func_graph);
   add_parameter(p);
   return p;
 }
@@ -84,7 +85,7 @@ void FuncGraph::add_parameter(const ParameterPtr &p) {
 
 ParameterPtr FuncGraph::AddWeightParameter(const std::string &name) {
   FuncGraphPtr this_graph = shared_from_base<FuncGraph>();
-  ParameterPtr p = std::make_shared<Parameter>(this_graph);
+  ParameterPtr p = MakeIrNode<Parameter>(this_graph);
   p->set_name(name);
   p->debug_info()->set_name(name);
 
@@ -119,7 +120,7 @@ ValuePtr FuncGraph::get_attr(const std::string &key) {
 }
 
 CNodePtr FuncGraph::NewCNode(const std::vector<AnfNodePtr> &inputs) {
-  CNodePtr cnode = std::make_shared<CNode>(inputs, shared_from_base<FuncGraph>());
+  CNodePtr cnode = MakeIrNode<CNode>(inputs, shared_from_base<FuncGraph>());
   if (has_flag(GRAPH_FLAG_HAS_EFFECT)) {
     order_.push_back(cnode);
     MS_LOG(INFO) << "Graph: " << ToString() << ", push back " << cnode->DebugString() << " in order.";
@@ -635,7 +636,7 @@ void FuncGraph::CheckOrder() {
   }
 }
 CNodePtr FuncGraph::NewCNode(const PrimitivePtr &primitive, const std::vector<AnfNodePtr> &inputs) {
-  auto primitive_node = std::make_shared<ValueNode>(primitive);
+  auto primitive_node = MakeIrNode<ValueNode>(primitive);
   std::vector<AnfNodePtr> input_node_list = {primitive_node};
   std::copy(inputs.begin(), inputs.end(), std::back_inserter(input_node_list));
   return NewCNode(input_node_list);
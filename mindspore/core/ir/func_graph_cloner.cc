@@ -19,6 +19,7 @@
 #include <algorithm>
 
 #include "ir/manager.h"
+#include "ir/ir_arena.h"
 #include "ir/param_info.h"
 #include "base/core_ops.h"
 #include "utils/convert_utils_base.h"
@@ -67,7 +68,7 @@ void Cloner::CloneParameter(const AnfNodePtr &node, const FuncGraphPtr &target,
   MS_EXCEPTION_IF_NULL(node);
   MS_EXCEPTION_IF_NULL(target);
   TraceGuard trace_guard(node->debug_info(), relation_);
-  auto new_param = (is_add) ? target->add_parameter() : std::make_shared<Parameter>(target);
+  auto new_param = (is_add) ? target->add_parameter() : MakeIrNode<Parameter>(target);
   auto old_param = node->cast<ParameterPtr>();
   new_param->set_abstract(old_param->abstract());
   new_param->set_name(old_param->name());
@@ -84,7 +85,7 @@ void Cloner::CloneCNode(const AnfNodePtr &node, const FuncGraphPtr &target) {
   MS_EXCEPTION_IF_NULL(node);
   MS_EXCEPTION_IF_NULL(target);
   TraceGuard trace_guard(node->debug_info(), relation_);
-  CNodePtr new_node = std::make_shared<CNode>(AnfNodePtrList{}, target);
+  CNodePtr new_node = MakeIrNode<CNode>(AnfNodePtrList{}, target);
   auto old_node = node->cast<CNodePtr>();
   new_node->set_abstract(old_node->abstract());
   new_node->set_forward(old_node->forward().first, old_node->forward().second);
@@ -272,7 +273,7 @@ void Cloner::CloneParameter(const ParameterPtr &param, const AnfNodePtr &node) {
 
 ParameterPtr Cloner::AddParameter(const FuncGraphPtr &func_graph, const AnfNodePtr &node, bool is_add) {
   TraceGuard guard(std::make_shared<TraceCopy>(node->debug_info()));
-  ParameterPtr param = std::make_shared<Parameter>(func_graph);
+  ParameterPtr param = MakeIrNode<Parameter>(func_graph);
   CloneParameter(param, node);
   if (is_add) {
     func_graph->add_parameter(param);
@@ -511,7 +512,11 @@ void Cloner::CloneNodes() {
     } else {
       SetFuncGraphInfo(func_graph, &target_func_graph);
       CloneParameters(func_graph, target_func_graph);
-      CloneAllNodes(func_graph, target_func_graph);
+      if (clone_nodes_on_demand_ && func_graph->get_return() != nullptr) {
+        CloneNode(func_graph->get_return(), target_func_graph);
+      } else {
+        CloneAllNodes(func_graph, target_func_graph);
+      }
       CloneFuncGraphValueNodes(func_graph, target_func_graph);
       CloneFuncGraphDefaultValues(func_graph, target_func_graph);
     }
@@ -618,6 +623,8 @@ ClonerPtr SpecializerClone(const FuncGraphPtr &func_graph, const TraceInfoPtr &r
   FuncGraphPtrList func_graphs = {func_graph};
   ClonerPtr cloner =
     std::make_shared<Cloner>(func_graphs, false, false, false, std::make_shared<TraceCopy>(), relation);
+  // the specializer sets the inputs of every node it reaches, the nodes replaced by constants are never cloned
+  cloner->set_clone_nodes_on_demand(true);
 #ifdef ENABLE_PROFILE
   double time = GetTime();
 #endif
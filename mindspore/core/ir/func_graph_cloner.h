@@ -66,6 +66,10 @@ class Cloner {
   void set_scope(const ScopePtr &scope) { scope_ = scope; }
   const ScopePtr scope() const { return scope_; }
 
+  // Only clone the parameters and the return of the graphs when running, the other nodes are cloned by
+  // CloneDisconnected when they are used and their inputs are set by the caller
+  void set_clone_nodes_on_demand(bool on_demand) { clone_nodes_on_demand_ = on_demand; }
+
   std::unordered_map<AnfNodePtr, AnfNodePtr> repl_node_;
   std::unordered_map<FuncGraphPtr, FuncGraphPtr> repl_func_graph_;
 
@@ -104,6 +108,7 @@ class Cloner {
   bool clone_all_valuenodes_;
   bool clone_all_child_graphs_;
   bool clone_all_used_graphs_;
+  bool clone_nodes_on_demand_{false};
   TraceInfoPtr relation_;
   TraceInfoPtr target_relation_;
   FuncGraphManagerPtr manager_;
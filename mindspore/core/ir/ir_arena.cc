@@ -0,0 +1,117 @@
+/**
+ * Copyright 2020 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "ir/ir_arena.h"
+
+#include <atomic>
+#include <new>
+
+namespace mindspore {
+namespace {
+constexpr size_t kChunkSize = 64 * 1024;
+
+size_t AlignUp(size_t size) { return (size + kIrArenaAlignment - 1) / kIrArenaAlignment * kIrArenaAlignment; }
+
+thread_local IrArena *current_arena = nullptr;
+std::atomic<size_t> allocation_num{0};
+std::atomic<size_t> chunk_num{0};
+std::atomic<size_t> large_allocation_num{0};
+std::atomic<size_t> allocated_bytes{0};
+}  // namespace
+
+struct IrArena::Chunk {
+  // the nodes placed in the chunk, plus one while the arena places nodes in it
+  std::atomic<size_t> live{1};
+};
+
+namespace {
+// put before each allocation to find its chunk, nullptr for the large ones
+struct AllocationHeader {
+  void *chunk;
+};
+
+const size_t kChunkHeaderSize = AlignUp(sizeof(std::atomic<size_t>));
+const size_t kAllocationHeaderSize = AlignUp(sizeof(AllocationHeader));
+}  // namespace
+
+IrArena::~IrArena() { RetireChunk(); }
+
+void *IrArena::Allocate(size_t size) {
+  size_t total_size = kAllocationHeaderSize + AlignUp(size);
+  allocated_bytes += total_size;
+  char *base = nullptr;
+  void *chunk = nullptr;
+  if (total_size > kChunkSize - kChunkHeaderSize) {
+    ++large_allocation_num;
+    base = static_cast<char *>(::operator new(total_size));
+  } else {
+    if (chunk_ == nullptr || offset_ + total_size > kChunkSize) {
+      RetireChunk();
+      chunk_ = new (::operator new(kChunkSize)) Chunk();
+      offset_ = kChunkHeaderSize;
+      ++chunk_num;
+    }
+    ++allocation_num;
+    (void)chunk_->live.fetch_add(1, std::memory_order_relaxed);
+    base = reinterpret_cast<char *>(chunk_) + offset_;
+    offset_ += total_size;
+    chunk = chunk_;
+  }
+  new (base) AllocationHeader{chunk};
+  return base + kAllocationHeaderSize;
+}
+
+void IrArena::Deallocate(void *ptr) {
+  if (ptr == nullptr) {
+    return;
+  }
+  auto base = static_cast<char *>(ptr) - kAllocationHeaderSize;
+  auto chunk = static_cast<Chunk *>(reinterpret_cast<AllocationHeader *>(base)->chunk);
+  if (chunk == nullptr) {
+    ::operator delete(base);
+    return;
+  }
+  ReleaseChunk(chunk);
+}
+
+void IrArena::RetireChunk() {
+  if (chunk_ == nullptr) {
+    return;
+  }
+  ReleaseChunk(chunk_);
+  chunk_ = nullptr;
+}
+
+void IrArena::ReleaseChunk(Chunk *chunk) {
+  if (chunk->live.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+    chunk->~Chunk();
+    ::operator delete(chunk);
+  }
+}
+
+IrArena *IrArena::current() { return current_arena; }
+
+void IrArena::set_current(IrArena *arena) { current_arena = arena; }
+
+IrArenaStatistics IrArena::statistics() {
+  IrArenaStatistics stats;
+  stats.allocation_num = allocation_num.load();
+  stats.chunk_num = chunk_num.load();
+  stats.large_allocation_num = large_allocation_num.load();
+  stats.allocated_bytes = allocated_bytes.load();
+  return stats;
+}
+}  // namespace mindspore
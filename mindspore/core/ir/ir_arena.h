@@ -0,0 +1,123 @@
+/**
+ * Copyright 2020 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef MINDSPORE_CORE_IR_IR_ARENA_H_
+#define MINDSPORE_CORE_IR_IR_ARENA_H_
+
+#include <cstddef>
+#include <memory>
+#include <utility>
+
+namespace mindspore {
+constexpr size_t kIrArenaAlignment = 16;
+
+struct IrArenaStatistics {
+  // the nodes placed in the chunks
+  size_t allocation_num{0};
+  // the chunks, one heap allocation each
+  size_t chunk_num{0};
+  // the objects too large for a chunk, allocated from the heap one by one
+  size_t large_allocation_num{0};
+  size_t allocated_bytes{0};
+};
+
+// IrArena places the ir nodes created on a thread, while the arena is the current one of the thread, into chunks
+// allocated in bulk. The nodes may outlive the arena: a chunk is released when the arena has moved to another chunk
+// and all the nodes placed in it are destroyed.
+class IrArena {
+ public:
+  IrArena() = default;
+  ~IrArena();
+  IrArena(const IrArena &) = delete;
+  IrArena &operator=(const IrArena &) = delete;
+
+  // called on the thread owning the arena only
+  void *Allocate(size_t size);
+  // may be called on any thread
+  static void Deallocate(void *ptr);
+
+  // the arena of the current thread, nullptr when the nodes are allocated from the heap
+  static IrArena *current();
+  static void set_current(IrArena *arena);
+  // accumulated over all the arenas of the process
+  static IrArenaStatistics statistics();
+
+ private:
+  struct Chunk;
+  void RetireChunk();
+  static void ReleaseChunk(Chunk *chunk);
+
+  Chunk *chunk_{nullptr};
+  size_t offset_{0};
+};
+
+using IrArenaPtr = std::shared_ptr<IrArena>;
+
+// IrArenaScope makes the arena the current one of the thread until it exits, nullptr allocates from the heap
+class IrArenaScope {
+ public:
+  explicit IrArenaScope(IrArena *arena) : previous_(IrArena::current()) { IrArena::set_current(arena); }
+  ~IrArenaScope() { IrArena::set_current(previous_); }
+  IrArenaScope(const IrArenaScope &) = delete;
+  IrArenaScope &operator=(const IrArenaScope &) = delete;
+
+ private:
+  IrArena *previous_;
+};
+
+template <typename T>
+class IrArenaAllocator {
+ public:
+  using value_type = T;
+
+  explicit IrArenaAllocator(IrArena *arena) : arena_(arena) {}
+  template <typename U>
+  IrArenaAllocator(const IrArenaAllocator<U> &other) : arena_(other.arena()) {}  // NOLINT
+
+  T *allocate(size_t n) {
+    static_assert(alignof(T) <= kIrArenaAlignment, "The ir arena can not align the type.");
+    return static_cast<T *>(arena_->Allocate(n * sizeof(T)));
+  }
+  void deallocate(T *ptr, size_t) { IrArena::Deallocate(ptr); }
+
+  IrArena *arena() const { return arena_; }
+
+ private:
+  IrArena *arena_;
+};
+
+template <typename T, typename U>
+bool operator==(const IrArenaAllocator<T> &lhs, const IrArenaAllocator<U> &rhs) {
+  return lhs.arena() == rhs.arena();
+}
+
+template <typename T, typename U>
+bool operator!=(const IrArenaAllocator<T> &lhs, const IrArenaAllocator<U> &rhs) {
+  return !(lhs == rhs);
+}
+
+// make a node from the arena of the current thread, or from the heap if there is none
+template <typename T, typename... Args>
+std::shared_ptr<T> MakeIrNode(Args &&... args) {
+  auto arena = IrArena::current();
+  if (arena == nullptr) {
+    return std::make_shared<T>(std::forward<Args>(args)...);
+  }
+  return std::allocate_shared<T>(IrArenaAllocator<T>(arena), std::forward<Args>(args)...);
+}
+}  // namespace mindspore
+
+#endif  // MINDSPORE_CORE_IR_IR_ARENA_H_
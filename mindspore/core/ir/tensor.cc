@@ -447,7 +447,11 @@ Tensor::Tensor(const Tensor &tensor)
       event_(tensor.event_),
       sync_status_(tensor.sync_status_),
       device_sync_(tensor.device_sync_),
-      padding_type_(tensor.padding_type()) {}
+      padding_type_(tensor.padding_type()) {
+  if (tensor.future_ != nullptr && tensor.future_->AddTensor(this)) {
+    future_ = tensor.future_;
+  }
+}
 
 Tensor::Tensor(const Tensor &tensor, TypeId data_type)
     : MetaTensor(data_type, tensor.shape_),
@@ -491,6 +495,8 @@ Tensor::Tensor(double input, const TypePtr &data_type)
       data_(MakeTensorData(data_type_, {}, input)),
       id_(MakeId()) {}
 
+Tensor::~Tensor() { ReleaseFuture(); }
+
 bool Tensor::operator==(const Tensor &tensor) const {
   return (&tensor == this || (MetaTensor::operator==(tensor) && data_ == tensor.data_));
 }
@@ -509,10 +515,76 @@ Tensor &Tensor::AssignValue(const Tensor &tensor) {
     event_ = tensor.event_;
     sync_status_ = tensor.sync_status_;
     padding_type_ = tensor.padding_type_;
+    ReleaseFuture();
+    if (tensor.future_ != nullptr && tensor.future_->AddTensor(this)) {
+      future_ = tensor.future_;
+    }
   }
   return *this;
 }
 
+void Tensor::SetFuture() {
+  ReleaseFuture();
+  future_ = std::make_shared<TensorFuture>();
+  (void)future_->AddTensor(this);
+}
+
+void Tensor::SetComputedValue(const Tensor &tensor) {
+  if (this == &tensor) {
+    return;
+  }
+  if (future_ != nullptr) {
+    future_->SetValue(tensor);
+    return;
+  }
+  TakeComputedValue(tensor);
+}
+
+void Tensor::TakeComputedValue(const Tensor &tensor) {
+  // the type and the shape are the inferred ones already, they may be read while the op is running
+  set_device_info(tensor.device_info());
+  data_ = tensor.data_;
+  device_sync_ = tensor.device_sync_;
+  sync_status_ = tensor.sync_status_;
+  padding_type_ = tensor.padding_type_;
+}
+
+void Tensor::ReleaseFuture() const {
+  if (future_ != nullptr) {
+    future_->RemoveTensor(const_cast<Tensor *>(this));
+    future_ = nullptr;
+  }
+}
+
+bool TensorFuture::AddTensor(Tensor *tensor) {
+  MS_EXCEPTION_IF_NULL(tensor);
+  std::lock_guard<std::mutex> lock(mutex_);
+  if (value_ != nullptr) {
+    tensor->TakeComputedValue(*value_);
+    return false;
+  }
+  tensors_.push_back(tensor);
+  return true;
+}
+
+void TensorFuture::RemoveTensor(Tensor *tensor) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  auto iter = std::find(tensors_.begin(), tensors_.end(), tensor);
+  if (iter != tensors_.end()) {
+    (void)tensors_.erase(iter);
+  }
+}
+
+void TensorFuture::SetValue(const Tensor &value) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  value_ = std::make_shared<Tensor>(value);
+  for (auto tensor : tensors_) {
+    tensor->TakeComputedValue(*value_);
+  }
+  // the tensors may be changed after the op is done, they take the value only once
+  tensors_.clear();
+}
+
 abstract::AbstractBasePtr Tensor::ToAbstract() {
   auto tens = shared_from_base<Tensor>();
   auto dtype = tens->Dtype();
@@ -103,6 +103,23 @@ struct WaitEvent {
   bool need_wait() const { return need_wait_; }
 };
 
+class Tensor;
+// The output of an asynchronous op, shared by the tensor created for it and the copies made of that tensor before the
+// op is done, such as the python tensors wrapping it. All of them take the value computed by the op.
+class TensorFuture {
+ public:
+  // the tensor takes the value at once and is not added if the value is computed already
+  bool AddTensor(Tensor *tensor);
+  void RemoveTensor(Tensor *tensor);
+  void SetValue(const Tensor &value);
+
+ private:
+  std::mutex mutex_;
+  std::vector<Tensor *> tensors_;
+  std::shared_ptr<Tensor> value_{nullptr};
+};
+using TensorFuturePtr = std::shared_ptr<TensorFuture>;
+
 // Tensor entity class
 class Tensor : public MetaTensor {
  public:
@@ -172,7 +189,7 @@ class Tensor : public MetaTensor {
   // param data_type [TypeId] data type
   explicit Tensor(double input, const TypePtr &data_type = nullptr);
 
-  ~Tensor() override = default;
+  ~Tensor() override;
 
   MS_DECLARE_PARENT(Tensor, MetaTensor);
 
@@ -191,6 +208,13 @@ class Tensor : public MetaTensor {
   // assgin value to this tensor
   Tensor &AssignValue(const Tensor &tensor);
 
+  // the tensor is the output of an asynchronous op, which is computed later
+  void SetFuture();
+
+  // take the data and the device address of the tensor computed for this one by an asynchronous op, with the copies
+  // made of this one, the id and the wait event of this tensor are kept
+  void SetComputedValue(const Tensor &tensor);
+
   bool operator==(const Value &other) const override {
     if (other.isa<Tensor>()) {
       auto &other_ = static_cast<const Tensor &>(other);
@@ -294,6 +318,7 @@ class Tensor : public MetaTensor {
       event_->Wait();
     }
     event_ = nullptr;
+    ReleaseFuture();
   }
 
   void set_sync_status(TensorSyncStatus sync_status) { sync_status_ = sync_status; }
@@ -310,10 +335,15 @@ class Tensor : public MetaTensor {
   void SetIsGraphOutput() { graph_output_ = true; }
 
  private:
+  friend class TensorFuture;
+  void TakeComputedValue(const Tensor &tensor);
+  void ReleaseFuture() const;
+
   bool init_flag_{false};
   TensorDataPtr data_{nullptr};
   std::string id_{""};
   mutable std::shared_ptr<WaitEvent> event_{nullptr};
+  mutable TensorFuturePtr future_{nullptr};
   mutable TensorSyncStatus sync_status_{kNeedSyncHostToDevice};
   bool graph_output_{false};
   DeviceSyncPtr device_sync_{nullptr};
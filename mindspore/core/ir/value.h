@@ -27,6 +27,7 @@
 
 #include "base/base.h"
 #include "ir/anf.h"
+#include "ir/ir_arena.h"
 #include "ir/dtype.h"
 #include "ir/scalar.h"
 #include "ir/dtype/ref.h"
@@ -283,7 +284,7 @@ std::vector<U> GetValue(const ValuePtr &value) {
   return rets;
 }
 
-inline ValueNodePtr NewValueNode(const ValuePtr &t) { return std::make_shared<ValueNode>(t); }
+inline ValueNodePtr NewValueNode(const ValuePtr &t) { return MakeIrNode<ValueNode>(t); }
 
 template <typename T, typename _ = typename std::enable_if<!std::is_base_of<Value, T>::value>::type>
 inline ValueNodePtr NewValueNode(const std::shared_ptr<T> &x) {
@@ -256,12 +256,15 @@ bool MSANFModelParser::BuildParameterForFuncGraph(const ParameterPtr &node,
   MS_EXCEPTION_IF_NULL(tensor_abstract);
   node->set_abstract(tensor_abstract);
 
-  std::string initial_data = parameter_proto.raw_data();
-  auto *tensor_data_buf = reinterpret_cast<uint8_t *>(tensor_info->data_c());
-  MS_EXCEPTION_IF_NULL(tensor_data_buf);
-  auto ret = memcpy_s(tensor_data_buf, tensor_info->data().nbytes(), initial_data.data(), initial_data.size());
-  if (ret != 0) {
-    MS_LOG(EXCEPTION) << "memcpy_s error for build parameter, errorno " << ret;
+  const std::string &initial_data = parameter_proto.raw_data();
+  // a weight exported without data is bound to its tensor by the caller, its data is not allocated here
+  if (!initial_data.empty()) {
+    auto *tensor_data_buf = reinterpret_cast<uint8_t *>(tensor_info->data_c());
+    MS_EXCEPTION_IF_NULL(tensor_data_buf);
+    auto ret = memcpy_s(tensor_data_buf, tensor_info->data().nbytes(), initial_data.data(), initial_data.size());
+    if (ret != 0) {
+      MS_LOG(EXCEPTION) << "memcpy_s error for build parameter, errorno " << ret;
+    }
   }
 
   node->set_default_param(tensor_info);
@@ -34,6 +34,7 @@ std::map<std::string, MsBackendPolicy> MsContext::policy_map_ = {{"ge", kMsBacke
 MsContext::MsContext(const std::string &policy, const std::string &target) {
   set_param<bool>(MS_CTX_SAVE_GRAPHS_FLAG, false);
   set_param<std::string>(MS_CTX_SAVE_GRAPHS_PATH, ".");
+  set_param<std::string>(MS_CTX_COMPILE_CACHE_PATH, "");
   set_param<bool>(MS_CTX_ENABLE_DUMP, false);
   set_param<std::string>(MS_CTX_SAVE_DUMP_PATH, ".");
   set_param<uint32_t>(MS_CTX_TSD_REF, 0);
@@ -49,6 +50,8 @@ MsContext::MsContext(const std::string &policy, const std::string &target) {
     set_param<uint32_t>(MS_CTX_DEVICE_ID, 0);
   }
   set_param<uint32_t>(MS_CTX_MAX_CALL_DEPTH, MAX_CALL_DEPTH_DEFAULT);
+  set_param<uint32_t>(MS_CTX_CPU_INTER_OP_PARALLEL_NUM, 1);
+  set_param<uint32_t>(MS_CTX_OP_GRAPH_CACHE_CAPACITY, OP_GRAPH_CACHE_CAPACITY_DEFAULT);
   set_param<std::string>(MS_CTX_DEVICE_TARGET, target);
   set_param<int>(MS_CTX_EXECUTION_MODE, kPynativeMode);
   set_param<bool>(MS_CTX_ENABLE_TASK_SINK, true);
@@ -60,6 +63,12 @@ MsContext::MsContext(const std::string &policy, const std::string &target) {
   set_param<bool>(MS_CTX_ENABLE_AUTO_MIXED_PRECISION, false);
   set_param<bool>(MS_CTX_ENABLE_PYNATIVE_INFER, false);
   set_param<bool>(MS_CTX_ENABLE_PYNATIVE_HOOK, false);
+  set_param<bool>(MS_CTX_ENABLE_PYNATIVE_ASYNC, false);
+  set_param<bool>(MS_CTX_ENABLE_PARALLEL_INFER, false);
+  set_param<bool>(MS_CTX_ENABLE_INCREMENTAL_COMPILE, false);
+  set_param<bool>(MS_CTX_ENABLE_IR_ARENA, false);
+  set_param<bool>(MS_CTX_ENABLE_CPU_FUSION, true);
+  set_param<bool>(MS_CTX_ENABLE_OPTIMIZER_OFFLOAD, false);
   set_param<bool>(MS_CTX_ENABLE_DYNAMIC_MEM_POOL, true);
   set_param<std::string>(MS_CTX_GRAPH_MEMORY_MAX_SIZE, "0");
   set_param<std::string>(MS_CTX_VARIABLE_MEMORY_MAX_SIZE, "0");
@@ -68,6 +77,7 @@ MsContext::MsContext(const std::string &policy, const std::string &target) {
   set_param<std::string>(MS_CTX_PROFILING_OPTIONS, "training_trace");
   set_param<bool>(MS_CTX_CHECK_BPROP_FLAG, false);
   set_param<float>(MS_CTX_MAX_DEVICE_MEMORY, kDefaultMaxDeviceMemory);
+  set_param<float>(MS_CTX_RECOMPUTE_MEMORY_BUDGET, 0);
   set_param<std::string>(MS_CTX_PRINT_FILE_PATH, "");
   set_param<bool>(MS_CTX_ENABLE_GRAPH_KERNEL, false);
   set_param<bool>(MS_CTX_ENABLE_SPARSE, false);
@@ -44,6 +44,7 @@ const char kDavinciInferenceDevice[] = "AscendInference";
 const char kDavinciDevice[] = "Davinci";
 const char KNpuLog[] = "_npu_log";
 const unsigned int MAX_CALL_DEPTH_DEFAULT = 1000;
+const unsigned int OP_GRAPH_CACHE_CAPACITY_DEFAULT = 1024;
 
 const std::set<std::string> kTargetSet = {kCPUDevice, kGPUDevice, kAscendDevice, kDavinciDevice};
 // The default max available device memory is 1024GB.
@@ -55,13 +56,19 @@ enum MsCtxParam : unsigned {
   MS_CTX_TYPE_BOOL_BEGIN,
   MS_CTX_ENABLE_AUTO_MIXED_PRECISION = MS_CTX_TYPE_BOOL_BEGIN,
   MS_CTX_CHECK_BPROP_FLAG,
+  MS_CTX_ENABLE_CPU_FUSION,
   MS_CTX_ENABLE_DUMP,
   MS_CTX_ENABLE_DYNAMIC_MEM_POOL,
   MS_CTX_ENABLE_GPU_SUMMARY,
   MS_CTX_ENABLE_GRAPH_KERNEL,
   MS_CTX_ENABLE_HCCL,
+  MS_CTX_ENABLE_INCREMENTAL_COMPILE,
+  MS_CTX_ENABLE_IR_ARENA,
   MS_CTX_ENABLE_LOOP_SINK,
   MS_CTX_ENABLE_MEM_REUSE,
+  MS_CTX_ENABLE_OPTIMIZER_OFFLOAD,
+  MS_CTX_ENABLE_PARALLEL_INFER,
+  MS_CTX_ENABLE_PYNATIVE_ASYNC,
   MS_CTX_ENABLE_PYNATIVE_HOOK,
   MS_CTX_ENABLE_PYNATIVE_INFER,
   MS_CTX_ENABLE_REDUCE_PRECISION,
@@ -85,17 +92,21 @@ enum MsCtxParam : unsigned {
   MS_CTX_DEVICE_ID = MS_CTX_TYPE_UINT32_BEGIN,
   MS_CTX_GE_REF,
   MS_CTX_MAX_CALL_DEPTH,
+  MS_CTX_CPU_INTER_OP_PARALLEL_NUM,
+  MS_CTX_OP_GRAPH_CACHE_CAPACITY,
   MS_CTX_TSD_REF,
   MS_CTX_TYPE_UINT32_END,
 
   // paramater of type float
   MS_CTX_TYPE_FLOAT_BEGIN = MS_CTX_TYPE_UINT32_END,
   MS_CTX_MAX_DEVICE_MEMORY = MS_CTX_TYPE_FLOAT_BEGIN,
+  MS_CTX_RECOMPUTE_MEMORY_BUDGET,
   MS_CTX_TYPE_FLOAT_END,
 
   // paramater of type string
   MS_CTX_TYPE_STRING_BEGIN = MS_CTX_TYPE_FLOAT_END,
   MS_CTX_DEVICE_TARGET = MS_CTX_TYPE_STRING_BEGIN,
+  MS_CTX_COMPILE_CACHE_PATH,
   MS_CTX_GRAPH_MEMORY_MAX_SIZE,
   MS_CTX_PRINT_FILE_PATH,
   MS_CTX_PROFILING_OPTIONS,
@@ -0,0 +1,62 @@
+/**
+ * Copyright 2020 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef MINDSPORE_LITE_INCLUDE_LITE_RUNTIME_H
+#define MINDSPORE_LITE_INCLUDE_LITE_RUNTIME_H
+
+#include "include/lite_session.h"
+
+namespace mindspore {
+namespace session {
+/// \brief LiteRuntime defined the resources shared by sessions which serve several models or several replicas of a
+/// model at the same time: one thread pool sized to a global thread budget, one allocator and the read-only weights of
+/// the models.
+class MS_API LiteRuntime {
+ public:
+  /// \brief Static method to create a LiteRuntime pointer.
+  ///
+  /// \param[in] context Define the global thread budget (thread_num_), the cpu bind mode and the allocator shared by
+  /// all sessions of the runtime.
+  ///
+  /// \return Pointer of MindSpore Lite LiteRuntime.
+  static LiteRuntime *CreateRuntime(const lite::Context *context);
+
+  /// \brief Destructor of MindSpore Lite LiteRuntime. Sessions created from the runtime must be deleted before it.
+  virtual ~LiteRuntime() = default;
+
+  /// \brief Create a session running on the thread pool and allocator of the runtime, and compile model into it.
+  ///
+  /// \note Weights are not copied out of the model buffer, so that every session of a model reads the same weights.
+  /// The model must not be freed before all sessions compiled from it are deleted. Sessions of one runtime can run
+  /// graphs from different threads concurrently. A running graph takes thread_num threads of the budget, the calling
+  /// thread included, graphs execute at once while their threads fit in thread_budget() and the others wait in
+  /// arrival order.
+  ///
+  /// \param[in] model Define the model to be compiled.
+  /// \param[in] thread_num Define the number of threads one operator of the session may use, it is clamped to the
+  /// thread budget.
+  ///
+  /// \return Pointer of MindSpore Lite LiteSession, nullptr if creating or compiling failed.
+  virtual LiteSession *CreateSession(lite::Model *model, int thread_num) = 0;
+
+  /// \brief Get the global thread budget of the runtime.
+  ///
+  /// \return Number of threads in the shared thread pool, including the calling thread.
+  virtual int thread_budget() const = 0;
+};
+}  // namespace session
+}  // namespace mindspore
+#endif  // MINDSPORE_LITE_INCLUDE_LITE_RUNTIME_H
@@ -24,6 +24,7 @@
 #include "include/ms_tensor.h"
 #include "include/model.h"
 #include "include/context.h"
+#include "include/errorcode.h"
 
 namespace mindspore {
 namespace session {
@@ -118,6 +119,25 @@ class MS_API LiteSession {
   ///
   /// \return STATUS as an error code of resize inputs, STATUS is defined in errorcode.h.
   virtual int Resize(const std::vector<tensor::MSTensor *> &inputs, const std::vector<std::vector<int>> &dims) = 0;
+
+  /// \brief Enable or disable operator-level profiling of RunGraph.
+  ///
+  /// \note Enabling profiling clears the records collected before.
+  ///
+  /// \param[in] enable Define whether to record start/end time, thread, input shapes and memory of each kernel.
+  ///
+  /// \return STATUS as an error code of enabling profiling, STATUS is defined in errorcode.h.
+  virtual int EnableProfiling(bool enable) { return lite::RET_NOT_SUPPORT; }
+
+  /// \brief Export the operator-level profiling records collected since profiling was enabled.
+  ///
+  /// \param[in] trace_file Define the path of the Chrome trace json file, skipped if empty.
+  /// \param[in] summary_file Define the path of the per-operator csv summary file, skipped if empty.
+  ///
+  /// \return STATUS as an error code of exporting profiling, STATUS is defined in errorcode.h.
+  virtual int ExportProfiling(const std::string &trace_file, const std::string &summary_file) const {
+    return lite::RET_NOT_SUPPORT;
+  }
 };
 }  // namespace session
 }  // namespace mindspore
@@ -52,7 +52,7 @@ int InnerContext::Init() {
 }
 
 InnerContext::~InnerContext() {
-  if (this->thread_pool_ != nullptr) {
+  if (this->thread_pool_ != nullptr && !this->thread_pool_shared_) {
     DestroyThreadPool(this->thread_pool_);
     free(this->thread_pool_);
     this->thread_pool_ = nullptr;
@@ -25,6 +25,8 @@ namespace mindspore::lite {
 struct InnerContext : public Context {
  public:
   struct ThreadPool *thread_pool_ = nullptr;
+  // the thread pool is borrowed from a LiteRuntime and must not be destroyed with the context
+  bool thread_pool_shared_ = false;
 
  public:
   InnerContext() = default;
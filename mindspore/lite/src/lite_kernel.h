@@ -126,6 +126,8 @@ class LiteKernel {
 
   std::string type_str() const { return schema::EnumNamePrimitiveType(this->Type()); }
 
+  OpParameter *op_parameter() const { return this->op_parameter_; }
+
   void set_in_tensors(const std::vector<lite::Tensor *> &in_tensors) { this->in_tensors_ = in_tensors; }
 
   void set_out_tensors(const std::vector<lite::Tensor *> &out_tensors) { this->out_tensors_ = out_tensors; }
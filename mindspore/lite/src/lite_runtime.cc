@@ -0,0 +1,129 @@
+/**
+ * Copyright 2020 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "src/lite_runtime.h"
+#include <algorithm>
+#include "include/errorcode.h"
+#include "src/common/log_adapter.h"
+#include "src/lite_session.h"
+
+namespace mindspore::lite {
+namespace {
+constexpr int kSharedAllocatorShiftFactor = 6;
+}  // namespace
+
+LiteRuntime::~LiteRuntime() {
+  if (session_num_ != 0) {
+    MS_LOG(ERROR) << session_num_ << " sessions are still alive while destroying the runtime";
+  }
+  delete context_;
+  context_ = nullptr;
+}
+
+int LiteRuntime::Init(const Context *context) {
+  if (context == nullptr) {
+    MS_LOG(ERROR) << "context is nullptr";
+    return RET_NULL_PTR;
+  }
+  context_ = new (std::nothrow) InnerContext(context);
+  if (context_ == nullptr) {
+    MS_LOG(ERROR) << "New Context failed";
+    return RET_MEMORY_FAILED;
+  }
+  auto ret = context_->Init();
+  if (ret != RET_OK) {
+    MS_LOG(ERROR) << "Init Context failed";
+    return ret;
+  }
+  // the allocator is shared by sessions running on different threads
+  context_->allocator->SetContext({kSharedAllocatorShiftFactor, true});
+  auto cpu_device_info = context_->GetCpuInfo();
+  if (cpu_device_info.cpu_bind_mode_ != NO_BIND && context_->thread_pool_ != nullptr) {
+    BindThreads(context_->thread_pool_, true, cpu_device_info.cpu_bind_mode_);
+  }
+  return RET_OK;
+}
+
+session::LiteSession *LiteRuntime::CreateSession(Model *model, int thread_num) {
+  if (model == nullptr) {
+    MS_LOG(ERROR) << "The input model is nullptr.";
+    return nullptr;
+  }
+  Context session_context;
+  session_context.thread_num_ = thread_num;
+  session_context.allocator = context_->allocator;
+  session_context.device_list_ = context_->device_list_;
+  auto session = new (std::nothrow) LiteSession();
+  if (session == nullptr) {
+    MS_LOG(ERROR) << "create sesssion failed";
+    return nullptr;
+  }
+  auto ret = session->Init(&session_context, this);
+  if (ret != RET_OK) {
+    MS_LOG(ERROR) << "init sesssion failed";
+    delete session;
+    return nullptr;
+  }
+  ret = session->CompileGraph(model);
+  if (ret != RET_OK) {
+    MS_LOG(ERROR) << "Compile model failed";
+    delete session;
+    return nullptr;
+  }
+  return session;
+}
+
+void LiteRuntime::AcquireRunSlot(int thread_num) {
+  // the calling thread executes tasks of the graph as well, so it is one of the thread_num threads of the run
+  thread_num = std::min(std::max(thread_num, 1), context_->thread_num_);
+  std::unique_lock<std::mutex> lock(slot_mutex_);
+  auto ticket = next_ticket_++;
+  waiting_tickets_.push_back(ticket);
+  slot_cond_.wait(lock, [this, ticket, thread_num] {
+    return running_threads_ + thread_num <= context_->thread_num_ && waiting_tickets_.front() == ticket;
+  });
+  waiting_tickets_.pop_front();
+  running_threads_ += thread_num;
+  // the next waiter may take a slot as well if enough threads are still free
+  slot_cond_.notify_all();
+}
+
+void LiteRuntime::ReleaseRunSlot(int thread_num) {
+  thread_num = std::min(std::max(thread_num, 1), context_->thread_num_);
+  {
+    std::lock_guard<std::mutex> lock(slot_mutex_);
+    running_threads_ -= thread_num;
+  }
+  slot_cond_.notify_all();
+}
+}  // namespace mindspore::lite
+
+namespace mindspore {
+session::LiteRuntime *session::LiteRuntime::CreateRuntime(const lite::Context *context) {
+  auto runtime = new (std::nothrow) lite::LiteRuntime();
+  if (runtime == nullptr) {
+    MS_LOG(ERROR) << "create runtime failed";
+    return nullptr;
+  }
+  auto ret = runtime->Init(context);
+  if (ret != lite::RET_OK) {
+    MS_LOG(ERROR) << "init runtime failed";
+    delete runtime;
+    return nullptr;
+  }
+  return runtime;
+}
+}  // namespace mindspore
@@ -0,0 +1,61 @@
+/**
+ * Copyright 2020 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef MINDSPORE_LITE_SRC_LITE_RUNTIME_H_
+#define MINDSPORE_LITE_SRC_LITE_RUNTIME_H_
+
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include "include/lite_runtime.h"
+#include "src/inner_context.h"
+
+namespace mindspore::lite {
+class LiteRuntime : public session::LiteRuntime {
+ public:
+  LiteRuntime() = default;
+  ~LiteRuntime() override;
+
+  int Init(const Context *context);
+
+  session::LiteSession *CreateSession(Model *model, int thread_num) override;
+
+  int thread_budget() const override { return context_ == nullptr ? 0 : context_->thread_num_; }
+
+  // the thread pool and allocator borrowed by the sessions, the context keeps the ownership
+  const InnerContext *context() const { return context_; }
+
+  void AttachSession() { session_num_++; }
+  void DetachSession() { session_num_--; }
+
+  // a session takes thread_num threads of the budget, its calling thread included, for the whole RunGraph. runs are
+  // admitted in arrival order while the threads taken by the running graphs fit in the budget
+  void AcquireRunSlot(int thread_num);
+  void ReleaseRunSlot(int thread_num);
+
+ private:
+  InnerContext *context_ = nullptr;
+  std::atomic<int> session_num_{0};
+  std::mutex slot_mutex_;
+  std::condition_variable slot_cond_;
+  std::deque<uint64_t> waiting_tickets_;
+  uint64_t next_ticket_ = 0;
+  int running_threads_ = 0;
+};
+}  // namespace mindspore::lite
+
+#endif  // MINDSPORE_LITE_SRC_LITE_RUNTIME_H_
@@ -15,8 +15,10 @@
  */
 
 #include "src/lite_session.h"
+#include <algorithm>
 #include <vector>
 #include <utility>
+#include "src/lite_runtime.h"
 #include "src/runtime/runtime_api.h"
 #include "include/errorcode.h"
 #include "src/common/log_adapter.h"
@@ -87,7 +89,7 @@ int LiteSession::ConvertTensorsData(const lite::Model *model, size_t tensor_inde
   if ((src_category == Tensor::Category::CONST_TENSOR || src_category == Tensor::Category::CONST_SCALAR) &&
       src_tensor->data() != nullptr && src_tensor->data()->size() > 0) {
     MS_ASSERT(dst_tensor->Size() == src_tensor->data()->size());
-    if (WeightTensorNeedCopy(model, tensor_index)) {
+    if (runtime_ == nullptr && WeightTensorNeedCopy(model, tensor_index)) {
       auto dst_data = dst_tensor->MutableData();
       if (dst_data == nullptr) {
         MS_LOG(ERROR) << "Data from tensor is nullptr";
@@ -367,11 +369,21 @@ int LiteSession::RunGraph(const KernelCallBack &before, const KernelCallBack &af
   }
   STATUS ret;
   MS_ASSERT(this->context_);
-  if (before == nullptr && after == nullptr) {
+  if (runtime_ != nullptr) {
+    runtime_->AcquireRunSlot(this->context_->thread_num_);
+  }
+  if (profiler_ != nullptr) {
+    ret = executor_->Run(this->inputs_, this->outputs_, this->kernels_, this->context_->allocator.get(),
+                         profiler_->WrapBefore(before), profiler_->WrapAfter(after));
+    profiler_->EndRun();
+  } else if (before == nullptr && after == nullptr) {
     ret = executor_->Run(this->inputs_, this->outputs_, this->kernels_, this->context_->allocator.get());
   } else {
     ret = executor_->Run(this->inputs_, this->outputs_, this->kernels_, this->context_->allocator.get(), before, after);
   }
+  if (runtime_ != nullptr) {
+    runtime_->ReleaseRunSlot(this->context_->thread_num_);
+  }
   if (ret != RET_OK) {
     MS_LOG(ERROR) << "RunGraph failed : " << ret;
   }
@@ -379,7 +391,9 @@ int LiteSession::RunGraph(const KernelCallBack &before, const KernelCallBack &af
   return ret;
 }
 
-int LiteSession::Init(const Context *context) {
+int LiteSession::Init(const Context *context) { return Init(context, nullptr); }
+
+int LiteSession::Init(const Context *context, LiteRuntime *runtime) {
   bool expected = false;
   if (!is_running_.compare_exchange_strong(expected, true)) {
     MS_LOG(ERROR) << "Not support multi-threading";
@@ -398,6 +412,15 @@ int LiteSession::Init(const Context *context) {
     is_running_.store(false);
     return RET_MEMORY_FAILED;
   }
+  if (runtime != nullptr) {
+    auto runtime_context = runtime->context();
+    this->context_->thread_pool_ = runtime_context->thread_pool_;
+    this->context_->thread_pool_shared_ = true;
+    this->context_->allocator = runtime_context->allocator;
+    this->context_->thread_num_ = std::min(std::max(this->context_->thread_num_, 1), runtime_context->thread_num_);
+    this->runtime_ = runtime;
+    this->runtime_->AttachSession();
+  }
   auto ret = this->context_->Init();
   if (ret != RET_OK) {
     MS_LOG(ERROR) << "Init Context failed";
@@ -441,6 +464,10 @@ void LiteSession::BindThread(bool if_bind) {
   if (!this->context_->IsCpuEnabled()) {
     return;
   }
+  // threads of a shared thread pool are bound once by the runtime
+  if (this->runtime_ != nullptr) {
+    return;
+  }
   auto cpu_device_info = this->context_->GetCpuInfo();
   if (cpu_device_info.cpu_bind_mode_ != NO_BIND) {
     MS_ASSERT(this->context_->thread_pool_ != NULL);
@@ -474,6 +501,12 @@ LiteSession::~LiteSession() {
   delete this->context_;
   delete this->executor_;
   this->executor_ = nullptr;
+  delete this->profiler_;
+  this->profiler_ = nullptr;
+  if (this->runtime_ != nullptr) {
+    this->runtime_->DetachSession();
+    this->runtime_ = nullptr;
+  }
   is_running_.store(false);
 }
 
@@ -573,6 +606,49 @@ int LiteSession::Resize(const std::vector<mindspore::tensor::MSTensor *> &inputs
   is_running_.store(false);
   return RET_OK;
 }
+
+int LiteSession::EnableProfiling(bool enable) {
+  bool expected = false;
+  if (!is_running_.compare_exchange_strong(expected, true)) {
+    MS_LOG(ERROR) << "Not support multi-threading";
+    return RET_ERROR;
+  }
+  delete this->profiler_;
+  this->profiler_ = nullptr;
+  if (enable) {
+    MS_ASSERT(this->context_);
+    this->profiler_ = new (std::nothrow) Profiler(this->context_->allocator.get());
+    if (this->profiler_ == nullptr) {
+      MS_LOG(ERROR) << "New Profiler failed";
+      is_running_.store(false);
+      return RET_MEMORY_FAILED;
+    }
+  }
+  is_running_.store(false);
+  return RET_OK;
+}
+
+int LiteSession::ExportProfiling(const std::string &trace_file, const std::string &summary_file) const {
+  if (this->profiler_ == nullptr) {
+    MS_LOG(ERROR) << "Profiling is not enabled";
+    return RET_ERROR;
+  }
+  if (!trace_file.empty()) {
+    auto ret = this->profiler_->ExportChromeTrace(trace_file);
+    if (ret != RET_OK) {
+      MS_LOG(ERROR) << "Export profiling trace failed: " << trace_file;
+      return ret;
+    }
+  }
+  if (!summary_file.empty()) {
+    auto ret = this->profiler_->ExportCsv(summary_file);
+    if (ret != RET_OK) {
+      MS_LOG(ERROR) << "Export profiling summary failed: " << summary_file;
+      return ret;
+    }
+  }
+  return RET_OK;
+}
 }  // namespace lite
 
 session::LiteSession *session::LiteSession::CreateSession(const lite::Context *context) {
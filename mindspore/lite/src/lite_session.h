@@ -30,12 +30,15 @@
 #include "schema/model_generated.h"
 #include "src/executor.h"
 #include "src/tensor.h"
+#include "src/runtime/profiler.h"
 #if SUPPORT_GPU
 #include "src/runtime/opencl/opencl_runtime.h"
 #endif
 
 namespace mindspore {
 namespace lite {
+class LiteRuntime;
+
 class LiteSession : public session::LiteSession {
  public:
   LiteSession();
@@ -44,6 +47,9 @@ class LiteSession : public session::LiteSession {
 
   virtual int Init(const Context *context);
 
+  // sessions created by a LiteRuntime borrow its thread pool and allocator, and keep weights in the model buffer
+  int Init(const Context *context, LiteRuntime *runtime);
+
   void BindThread(bool if_bind) override;
 
   int CompileGraph(Model *model) override;
@@ -65,6 +71,10 @@ class LiteSession : public session::LiteSession {
   int Resize(const std::vector<mindspore::tensor::MSTensor *> &inputs,
              const std::vector<std::vector<int>> &dims) override;
 
+  int EnableProfiling(bool enable) override;
+
+  int ExportProfiling(const std::string &trace_file, const std::string &summary_file) const override;
+
  protected:
   static void ConvertTensorsQuantParam(const schema::Tensor *src_tensor, lite::Tensor *dst_tensor);
 
@@ -98,6 +108,7 @@ class LiteSession : public session::LiteSession {
 
  protected:
   InnerContext *context_ = nullptr;
+  LiteRuntime *runtime_ = nullptr;
   std::vector<kernel::LiteKernel *> kernels_;
   std::vector<Tensor *> tensors_;
   std::vector<size_t> copyed_tensor_idxes_;
@@ -116,6 +127,7 @@ class LiteSession : public session::LiteSession {
   // graph output tensor name -- output tensor
   std::unordered_map<std::string, mindspore::tensor::MSTensor *> output_tensor_map_;
   Executor *executor_ = nullptr;
+  Profiler *profiler_ = nullptr;
   std::atomic<bool> is_running_ = false;
 #if SUPPORT_GPU
   opencl::OpenCLRuntimeWrapper ocl_runtime_wrap_;
@@ -17,12 +17,14 @@
 #include "include/model.h"
 #include "src/common/log_adapter.h"
 #include "src/model_common.h"
+#include "src/runtime/packed_weight_cache.h"
 
 namespace mindspore::lite {
 Model *Model::Import(const char *model_buf, size_t size) { return ImportFromBuffer(model_buf, size, false); }
 
 void Model::Free() {
   if (this->buf != nullptr) {
+    PackedWeightCache::GetInstance()->UnregisterModelBuffer(this->buf);
     free(this->buf);
     this->buf = nullptr;
   }
@@ -15,6 +15,7 @@
  */
 #include "src/model_common.h"
 #include "src/ops/while.h"
+#include "src/runtime/packed_weight_cache.h"
 
 namespace mindspore::lite {
 int ConvertSubGraph(const schema::SubGraph &sub_graph, Model *model) {
@@ -223,6 +224,13 @@ Model *ImportFromBuffer(const char *model_buf, size_t size, bool take_buf) {
     return nullptr;
   }
 
-  return ModelVerify(*model) ? model : nullptr;
+  if (!ModelVerify(*model)) {
+    return nullptr;
+  }
+#ifndef SUPPORT_TRAIN
+  // weights are updated in place by train sessions, so they must never be shared
+  PackedWeightCache::GetInstance()->RegisterModelBuffer(model->buf, size);
+#endif
+  return model;
 }
 }  // namespace mindspore::lite
@@ -45,13 +45,15 @@ int AdderCPUKernel::InitWeightBias() {
   int pack_weight_size = oc_block_num * oc_block * in_channel * kernel_plane;
 
   auto origin_weight = reinterpret_cast<float *>(filter_tensor->MutableData());
-  packed_weight_ = reinterpret_cast<float *>(malloc(pack_weight_size * sizeof(float)));
+  packed_weight_ = reinterpret_cast<float *>(lite::PackedWeightCache::GetInstance()->Acquire(
+    origin_weight, "adder_col4", pack_weight_size * sizeof(float), [&](void *packed) {
+      RowMajor2Col4Major(origin_weight, reinterpret_cast<float *>(packed), out_channel, in_channel * kernel_plane);
+      return RET_OK;
+    }));
   if (packed_weight_ == nullptr) {
     MS_LOG(ERROR) << "malloc packed weight failed.";
     return RET_ERROR;
   }
-  memset(packed_weight_, 0, pack_weight_size * sizeof(float));
-  RowMajor2Col4Major(origin_weight, packed_weight_, out_channel, in_channel * kernel_plane);
 
   bias_data_ = reinterpret_cast<float *>(malloc(oc_block_num * oc_block * sizeof(float)));
   if (bias_data_ == nullptr) {
@@ -25,7 +25,7 @@ namespace mindspore::kernel {
 Convolution1x1CPUKernel::~Convolution1x1CPUKernel() {
   FreeTmpBuffer();
   if (weight_ptr_ != nullptr) {
-    free(weight_ptr_);
+    lite::PackedWeightCache::GetInstance()->Release(weight_ptr_);
     weight_ptr_ = nullptr;
   }
   if (matmul_param_ != nullptr) {
@@ -84,15 +84,16 @@ int Convolution1x1CPUKernel::InitConv1x1BiasWeight() {
   }
 
   int size = input_channel * UP_ROUND(output_channel, C8NUM) * sizeof(float);
-  int down_size = input_channel * DOWN_DIV(output_channel, C8NUM) * C8NUM * sizeof(float);
-  weight_ptr_ = reinterpret_cast<float *>(malloc(size));
+  auto origin_weight = reinterpret_cast<float *>(filter_tensor->MutableData());
+  weight_ptr_ = reinterpret_cast<float *>(
+    lite::PackedWeightCache::GetInstance()->Acquire(origin_weight, "conv1x1_col8", size, [&](void *packed) {
+      RowMajor2Col8Major(origin_weight, reinterpret_cast<float *>(packed), output_channel, input_channel);
+      return RET_OK;
+    }));
   if (weight_ptr_ == nullptr) {
     MS_LOG(ERROR) << "Conv1x1 Malloc weight_ptr_ error!";
     return RET_ERROR;
   }
-  memset(reinterpret_cast<char *>(weight_ptr_) + down_size, 0, size - down_size);
-  RowMajor2Col8Major(reinterpret_cast<float *>(filter_tensor->MutableData()), weight_ptr_, output_channel,
-                     input_channel);
   return RET_OK;
 }
 
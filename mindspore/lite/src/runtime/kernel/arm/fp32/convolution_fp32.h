@@ -22,6 +22,7 @@
 #include "nnacl/op_base.h"
 #include "src/runtime/kernel/arm/base/convolution_base.h"
 #include "nnacl/fp32/conv_fp32.h"
+#include "src/runtime/packed_weight_cache.h"
 
 namespace mindspore::kernel {
 class ConvolutionCPUKernel : public ConvolutionBaseCPUKernel {
@@ -32,7 +33,7 @@ class ConvolutionCPUKernel : public ConvolutionBaseCPUKernel {
       : ConvolutionBaseCPUKernel(parameter, inputs, outputs, ctx, primitive) {}
   ~ConvolutionCPUKernel() override {
     if (packed_weight_ != nullptr) {
-      free(packed_weight_);
+      lite::PackedWeightCache::GetInstance()->Release(packed_weight_);
       packed_weight_ = nullptr;
     }
   }
@@ -15,6 +15,7 @@
  */
 
 #include "src/runtime/kernel/arm/fp32/convolution_winograd_fp32.h"
+#include <string>
 #include "nnacl/fp32/conv_fp32.h"
 #include "nnacl/pack.h"
 #include "schema/model_generated.h"
@@ -52,15 +53,7 @@ int ConvolutionWinogradCPUKernel::InitWeightBias() {
   const int oc_block = C8NUM;
   int oc_block_num = UP_DIV(out_channel, C8NUM);
 
-  // set data
   auto trans_matrix_data_size = input_unit_ * input_unit_ * in_channel * oc_block_num * oc_block * sizeof(float);
-  trans_weight_ = reinterpret_cast<float *>(malloc(trans_matrix_data_size));
-  if (trans_weight_ == nullptr) {
-    MS_LOG(ERROR) << "malloc matrix_buffer failed.";
-    return RET_MEMORY_FAILED;
-  }
-  memset(trans_weight_, 0, trans_matrix_data_size);
-
   float matrix_g[64];
   float matrix_gt[64];
   float matrix_a[64];
@@ -78,10 +71,16 @@ int ConvolutionWinogradCPUKernel::InitWeightBias() {
     return ret;
   }
   auto weight_data = reinterpret_cast<float *>(filter_tensor->MutableData());
-  ret = WinogradFilterTransform(weight_data, matrix_g, matrix_gt, oc_block);
-  if (ret != RET_OK) {
+  // the transformed filter depends on the tile units besides the origin weight
+  auto tag = "winograd_" + std::to_string(input_unit_) + "_" + std::to_string(output_unit_);
+  trans_weight_ = reinterpret_cast<float *>(
+    lite::PackedWeightCache::GetInstance()->Acquire(weight_data, tag, trans_matrix_data_size, [&](void *packed) {
+      trans_weight_ = reinterpret_cast<float *>(packed);
+      return WinogradFilterTransform(weight_data, matrix_g, matrix_gt, oc_block);
+    }));
+  if (trans_weight_ == nullptr) {
     MS_LOG(ERROR) << "winograd filter transfrom failed.";
-    return ret;
+    return RET_ERROR;
   }
 
   // init bias
@@ -22,6 +22,7 @@
 #include "nnacl/winograd_transform.h"
 #include "nnacl/minimal_filtering_generator.h"
 #include "src/runtime/kernel/arm/base/convolution_base.h"
+#include "src/runtime/packed_weight_cache.h"
 
 namespace mindspore::kernel {
 class ConvolutionWinogradCPUKernel : public ConvolutionBaseCPUKernel {
@@ -34,7 +35,7 @@ class ConvolutionWinogradCPUKernel : public ConvolutionBaseCPUKernel {
         trans_weight_(nullptr) {}
   ~ConvolutionWinogradCPUKernel() override {
     if (trans_weight_ != nullptr) {
-      free(trans_weight_);
+      lite::PackedWeightCache::GetInstance()->Release(trans_weight_);
       trans_weight_ = nullptr;
     }
   };
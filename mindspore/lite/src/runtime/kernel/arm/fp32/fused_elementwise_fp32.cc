@@ -0,0 +1,509 @@
+/**
+ * Copyright 2020 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "src/runtime/kernel/arm/fp32/fused_elementwise_fp32.h"
+#include <map>
+#include <utility>
+#include "include/errorcode.h"
+#include "schema/model_generated.h"
+#include "src/runtime/runtime_api.h"
+#include "nnacl/arithmetic_common.h"
+#include "nnacl/power.h"
+#include "nnacl/fp32/activation_fp32.h"
+#include "nnacl/fp32/arithmetic_fp32.h"
+#include "nnacl/fp32/arithmetic_self_fp32.h"
+
+using mindspore::kernel::KERNEL_ARCH::kCPU;
+using mindspore::lite::RET_ERROR;
+using mindspore::lite::RET_NULL_PTR;
+using mindspore::lite::RET_OK;
+
+namespace mindspore::kernel {
+namespace {
+constexpr int kFusedTile = 512;
+constexpr int kFusedScratchNum = 2;
+
+bool IsFusibleActivation(int type) {
+  return type == schema::ActivationType_RELU || type == schema::ActivationType_RELU6 ||
+         type == schema::ActivationType_LEAKY_RELU || type == schema::ActivationType_SIGMOID ||
+         type == schema::ActivationType_TANH || type == schema::ActivationType_HSWISH ||
+         type == schema::ActivationType_SWISH || type == schema::ActivationType_HSIGMOID ||
+         type == schema::ActivationType_HARD_TANH;
+}
+
+FusedBinaryFunc GetBinaryFunc(schema::PrimitiveType type, int activation_type) {
+  switch (type) {
+    case schema::PrimitiveType_Add:
+      return activation_type == schema::ActivationType_RELU
+               ? ElementAddRelu
+               : (activation_type == schema::ActivationType_RELU6 ? ElementAddRelu6 : ElementAdd);
+    case schema::PrimitiveType_Sub:
+      return activation_type == schema::ActivationType_RELU
+               ? ElementSubRelu
+               : (activation_type == schema::ActivationType_RELU6 ? ElementSubRelu6 : ElementSub);
+    case schema::PrimitiveType_Mul:
+      return activation_type == schema::ActivationType_RELU
+               ? ElementMulRelu
+               : (activation_type == schema::ActivationType_RELU6 ? ElementMulRelu6 : ElementMul);
+    case schema::PrimitiveType_Div:
+    case schema::PrimitiveType_RealDiv:
+      return activation_type == schema::ActivationType_RELU
+               ? ElementDivRelu
+               : (activation_type == schema::ActivationType_RELU6 ? ElementDivRelu6 : ElementDiv);
+    case schema::PrimitiveType_Maximum:
+      return ElementMaximum;
+    case schema::PrimitiveType_Minimum:
+      return ElementMinimum;
+    default:
+      return nullptr;
+  }
+}
+
+FusedUnaryFunc GetUnaryFunc(schema::PrimitiveType type) {
+  switch (type) {
+    case schema::PrimitiveType_Abs:
+      return ElementAbs;
+    case schema::PrimitiveType_Cos:
+      return ElementCos;
+    case schema::PrimitiveType_Log:
+      return ElementLog;
+    case schema::PrimitiveType_Square:
+      return ElementSquare;
+    case schema::PrimitiveType_Sqrt:
+      return ElementSqrt;
+    case schema::PrimitiveType_Rsqrt:
+      return ElementRsqrt;
+    case schema::PrimitiveType_Sin:
+      return ElementSin;
+    case schema::PrimitiveType_Round:
+      return ElementRound;
+    case schema::PrimitiveType_Floor:
+      return ElementFloor;
+    case schema::PrimitiveType_Ceil:
+      return ElementCeil;
+    case schema::PrimitiveType_Neg:
+      return ElementNegative;
+    default:
+      return nullptr;
+  }
+}
+
+// a tensor of shape [1, ..., 1, C] broadcast along the last axis of the output
+bool IsRowBroadcast(const std::vector<int> &shape, const std::vector<int> &out_shape) {
+  if (shape.empty() || out_shape.empty() || shape.size() > out_shape.size() || shape.back() != out_shape.back()) {
+    return false;
+  }
+  for (size_t i = 0; i + 1 < shape.size(); ++i) {
+    if (shape[i] != 1) {
+      return false;
+    }
+  }
+  return true;
+}
+
+int ExecInstr(const FusedInstr &instr, const float *const *inputs, float *output, int len) {
+  if (instr.binary != nullptr) {
+    return instr.binary(inputs[0], inputs[1], output, len);
+  }
+  if (instr.unary != nullptr) {
+    return instr.unary(inputs[0], output, len);
+  }
+  if (instr.type == schema::PrimitiveType_Power) {
+    auto param = reinterpret_cast<const PowerParameter *>(instr.param);
+    if (instr.inputs.size() == 1) {
+      Power(inputs[0], &param->power_, output, len, param->scale_, param->shift_, true);
+    } else {
+      Power(inputs[0], inputs[1], output, len, param->scale_, param->shift_, false);
+    }
+    return RET_OK;
+  }
+  auto param = reinterpret_cast<const ActivationParameter *>(instr.param);
+  switch (param->type_) {
+    case schema::ActivationType_RELU:
+      return Fp32Relu(inputs[0], len, output);
+    case schema::ActivationType_RELU6:
+      return Fp32Relu6(inputs[0], len, output);
+    case schema::ActivationType_LEAKY_RELU:
+      return LRelu(inputs[0], len, output, param->alpha_);
+    case schema::ActivationType_SIGMOID:
+      return Sigmoid(inputs[0], len, output);
+    case schema::ActivationType_TANH:
+      return Tanh(inputs[0], len, output);
+    case schema::ActivationType_SWISH:
+      return Swish(inputs[0], len, output);
+    case schema::ActivationType_HSWISH:
+      return HSwish(inputs[0], len, output);
+    case schema::ActivationType_HSIGMOID:
+      return HSigmoid(inputs[0], len, output);
+    case schema::ActivationType_HARD_TANH:
+      return HardTanh(inputs[0], len, output, param->min_val_, param->max_val_);
+    default:
+      return RET_ERROR;
+  }
+}
+}  // namespace
+
+FusedElementwiseCPUKernel::FusedElementwiseCPUKernel(const std::vector<lite::Tensor *> &inputs,
+                                                     const std::vector<lite::Tensor *> &outputs,
+                                                     std::vector<LiteKernel *> members, const lite::InnerContext *ctx)
+    : LiteKernel(nullptr, inputs, outputs, ctx, nullptr), members_(std::move(members)) {
+  desc_ = {kCPU, kNumberTypeFloat32, schema::PrimitiveType_NONE};
+  thread_count_ = ctx->thread_num_;
+  for (auto *member : members_) {
+    name_ += name_.empty() ? member->name() : "+" + member->name();
+  }
+}
+
+FusedElementwiseCPUKernel::~FusedElementwiseCPUKernel() {
+  for (auto *member : members_) {
+    delete member;
+  }
+  members_.clear();
+}
+
+bool FusedElementwiseCPUKernel::IsFusible(const LiteKernel *kernel) {
+  if (kernel == nullptr || kernel->subgraph_type() != kNotSubGraph || kernel->desc().arch != kCPU ||
+      kernel->desc().data_type != kNumberTypeFloat32 || kernel->op_parameter() == nullptr) {
+    return false;
+  }
+  auto primitive = kernel->GetPrimitive();
+  if (primitive == nullptr || !primitive->infer_flag() || kernel->out_tensors().size() != 1) {
+    return false;
+  }
+  for (auto *tensor : kernel->in_tensors()) {
+    if (tensor->data_type() != kNumberTypeFloat32) {
+      return false;
+    }
+  }
+  if (kernel->out_tensors().front()->data_type() != kNumberTypeFloat32) {
+    return false;
+  }
+  auto type = kernel->Type();
+  auto input_num = kernel->in_tensors().size();
+  if (type == schema::PrimitiveType_Activation) {
+    auto activation_type = reinterpret_cast<ActivationParameter *>(kernel->op_parameter())->type_;
+    return input_num == 1 && IsFusibleActivation(activation_type);
+  }
+  if (type == schema::PrimitiveType_Power) {
+    return input_num == 1 || input_num == 2;
+  }
+  if (GetUnaryFunc(type) != nullptr) {
+    return input_num == 1;
+  }
+  if (GetBinaryFunc(type, schema::ActivationType_NO_ACTIVATION) != nullptr) {
+    if (type == schema::PrimitiveType_Maximum || type == schema::PrimitiveType_Minimum) {
+      return input_num == 2;
+    }
+    auto activation_type = reinterpret_cast<ArithmeticParameter *>(kernel->op_parameter())->activation_type_;
+    return input_num == 2 &&
+           (activation_type == schema::ActivationType_NO_ACTIVATION ||
+            activation_type == schema::ActivationType_RELU || activation_type == schema::ActivationType_RELU6);
+  }
+  return false;
+}
+
+int FusedElementwiseCPUKernel::BuildPlan(const std::vector<LiteKernel *> &members,
+                                         const std::vector<lite::Tensor *> &outputs, FusedPlan *plan) {
+  MS_ASSERT(plan != nullptr);
+  plan->values.clear();
+  plan->instrs.clear();
+  plan->temp_num = 0;
+  if (members.empty()) {
+    return RET_ERROR;
+  }
+  auto out_shape = members.front()->out_tensors().front()->shape();
+  plan->element_num = members.front()->out_tensors().front()->ElementsNum();
+  if (plan->element_num <= 0) {
+    return RET_ERROR;
+  }
+  std::map<lite::Tensor *, int> value_ids;
+  for (auto *member : members) {
+    if (!IsFusible(member) || member->out_tensors().front()->shape() != out_shape) {
+      return RET_ERROR;
+    }
+    FusedInstr instr;
+    instr.type = member->Type();
+    instr.param = member->op_parameter();
+    if (instr.type != schema::PrimitiveType_Activation && instr.type != schema::PrimitiveType_Power) {
+      instr.unary = GetUnaryFunc(instr.type);
+      if (instr.unary == nullptr) {
+        instr.binary =
+          GetBinaryFunc(instr.type, reinterpret_cast<const ArithmeticParameter *>(instr.param)->activation_type_);
+      }
+    }
+    for (auto *input : member->in_tensors()) {
+      auto iter = value_ids.find(input);
+      if (iter != value_ids.end()) {
+        instr.inputs.emplace_back(iter->second);
+        continue;
+      }
+      FusedValue value;
+      value.tensor = input;
+      if (input->shape() == out_shape) {
+        value.kind = kFusedFull;
+      } else if (input->ElementsNum() == 1) {
+        value.kind = kFusedScalar;
+      } else if (IsRowBroadcast(input->shape(), out_shape)) {
+        value.kind = kFusedRow;
+        value.row_size = out_shape.back();
+      } else {
+        return RET_ERROR;
+      }
+      value_ids[input] = plan->values.size();
+      instr.inputs.emplace_back(plan->values.size());
+      plan->values.emplace_back(value);
+    }
+    // the first operand of a unary op or a power decides the output shape, so it must not be broadcast
+    auto first_kind = plan->values.at(instr.inputs.front()).kind;
+    if (instr.binary == nullptr && first_kind != kFusedFull && first_kind != kFusedTemp) {
+      return RET_ERROR;
+    }
+    auto *output = member->out_tensors().front();
+    if (value_ids.find(output) != value_ids.end()) {
+      return RET_ERROR;
+    }
+    FusedValue value;
+    if (lite::IsContain(outputs, output)) {
+      value.kind = kFusedFull;
+      value.tensor = output;
+    } else {
+      value.kind = kFusedTemp;
+    }
+    value_ids[output] = plan->values.size();
+    instr.output = plan->values.size();
+    plan->values.emplace_back(value);
+    plan->instrs.emplace_back(instr);
+  }
+
+  // assign tile slots to temporaries, a slot is recycled once the last reader of its value has run
+  std::vector<int> last_use(plan->values.size(), -1);
+  for (size_t i = 0; i < plan->instrs.size(); ++i) {
+    for (auto input : plan->instrs[i].inputs) {
+      last_use[input] = i;
+    }
+  }
+  std::vector<int> free_slots;
+  for (size_t i = 0; i < plan->instrs.size(); ++i) {
+    auto &output = plan->values[plan->instrs[i].output];
+    if (output.kind == kFusedTemp) {
+      if (free_slots.empty()) {
+        output.temp_index = plan->temp_num++;
+      } else {
+        output.temp_index = free_slots.back();
+        free_slots.pop_back();
+      }
+    }
+    for (auto input : plan->instrs[i].inputs) {
+      auto &value = plan->values[input];
+      if (value.kind == kFusedTemp && last_use[input] == static_cast<int>(i) &&
+          !lite::IsContain(free_slots, value.temp_index)) {
+        free_slots.emplace_back(value.temp_index);
+      }
+    }
+  }
+  return RET_OK;
+}
+
+int FusedElementwiseCPUKernel::Init() {
+  if (members_.empty()) {
+    MS_LOG(ERROR) << "fused kernel has no member";
+    return RET_ERROR;
+  }
+  planned_shapes_.clear();
+  for (auto *input : in_tensors_) {
+    planned_shapes_.emplace_back(input->shape());
+  }
+  fused_ = BuildPlan(members_, out_tensors_, &plan_) == RET_OK;
+  if (!fused_) {
+    MS_LOG(INFO) << "kernel " << name_ << " can not be fused with current shapes, run members one by one";
+  }
+  return RET_OK;
+}
+
+int FusedElementwiseCPUKernel::InferMembers() {
+  for (auto *member : members_) {
+    auto primitive = const_cast<mindspore::lite::PrimitiveC *>(member->GetPrimitive());
+    MS_ASSERT(primitive != nullptr);
+    primitive->set_infer_flag(true);
+    auto ret = primitive->InferShape(member->in_tensors(), member->out_tensors());
+    if (ret != RET_OK) {
+      primitive->set_infer_flag(false);
+      MS_LOG(ERROR) << "InferShape failed, kernel: " << member->name();
+      return ret;
+    }
+    ret = member->ReSize();
+    if (ret != RET_OK) {
+      MS_LOG(ERROR) << "kernel " << member->name() << " resize fail!ret = " << ret;
+      return ret;
+    }
+  }
+  return RET_OK;
+}
+
+int FusedElementwiseCPUKernel::ReSize() {
+  auto ret = InferMembers();
+  if (ret != RET_OK) {
+    return ret;
+  }
+  return Init();
+}
+
+int FusedElementwiseCPUKernel::PreProcess() {
+  bool need_resize = planned_shapes_.size() != in_tensors_.size();
+  for (size_t i = 0; i < in_tensors_.size() && !need_resize; ++i) {
+    need_resize = in_tensors_[i]->shape() != planned_shapes_[i];
+  }
+  for (size_t i = 0; i < members_.size() && !need_resize; ++i) {
+    need_resize = !members_[i]->GetPrimitive()->infer_flag();
+  }
+  if (need_resize) {
+    auto ret = ReSize();
+    if (ret != RET_OK) {
+      MS_LOG(ERROR) << "ReSize fail!ret: " << ret;
+      return ret;
+    }
+  }
+  return LiteKernel::PreProcess();
+}
+
+int FusedElementwiseCPUKernel::Prepare() {
+  for (auto *member : members_) {
+    auto ret = member->Prepare();
+    if (ret != RET_OK) {
+      MS_LOG(ERROR) << "prepare node " << member->name() << " failed";
+      return ret;
+    }
+  }
+  return RET_OK;
+}
+
+int FusedElementwiseCPUKernel::RunMembers() {
+  int ret = RET_OK;
+  for (auto *member : members_) {
+    ret = member->PreProcess();
+    if (ret != RET_OK) {
+      MS_LOG(ERROR) << "PreProcess kernel failed, name: " << member->name();
+      break;
+    }
+    ret = member->Run();
+    if (ret != RET_OK) {
+      MS_LOG(ERROR) << "run kernel failed, name: " << member->name();
+      break;
+    }
+  }
+  for (auto *member : members_) {
+    for (auto *output : member->out_tensors()) {
+      if (!lite::IsContain(out_tensors_, output)) {
+        output->FreeData();
+      }
+    }
+  }
+  return ret;
+}
+
+const float *FusedElementwiseCPUKernel::ValueData(const FusedValue &value, int start, int len, float *temps,
+                                                  float *scratch) const {
+  switch (value.kind) {
+    case kFusedFull:
+      return value.data + start;
+    case kFusedTemp:
+      return temps + value.temp_index * kFusedTile;
+    case kFusedScalar:
+      for (int i = 0; i < len; ++i) {
+        scratch[i] = value.data[0];
+      }
+      return scratch;
+    default: {
+      int offset = start % value.row_size;
+      for (int i = 0; i < len; ++i) {
+        scratch[i] = value.data[offset];
+        if (++offset == value.row_size) {
+          offset = 0;
+        }
+      }
+      return scratch;
+    }
+  }
+}
+
+int FusedElementwiseCPUKernel::DoExecute(int task_id) {
+  int tile_num = UP_DIV(plan_.element_num, kFusedTile);
+  int tile_stride = UP_DIV(tile_num, thread_count_);
+  int begin = task_id * tile_stride * kFusedTile;
+  int end = MSMIN(plan_.element_num, begin + tile_stride * kFusedTile);
+  float *temps = tile_buffer_ + task_id * (plan_.temp_num + kFusedScratchNum) * kFusedTile;
+  float *scratch = temps + plan_.temp_num * kFusedTile;
+  const float *inputs[kFusedScratchNum] = {nullptr, nullptr};
+  for (int start = begin; start < end; start += kFusedTile) {
+    int len = MSMIN(kFusedTile, end - start);
+    for (auto &instr : plan_.instrs) {
+      for (size_t i = 0; i < instr.inputs.size(); ++i) {
+        inputs[i] = ValueData(plan_.values[instr.inputs[i]], start, len, temps, scratch + i * kFusedTile);
+      }
+      auto &output = plan_.values[instr.output];
+      float *output_data = output.kind == kFusedTemp ? temps + output.temp_index * kFusedTile : output.data + start;
+      auto ret = ExecInstr(instr, inputs, output_data, len);
+      if (ret != RET_OK) {
+        MS_LOG(ERROR) << "fused elementwise kernel " << name_ << " failed at "
+                      << schema::EnumNamePrimitiveType(instr.type);
+        return RET_ERROR;
+      }
+    }
+  }
+  return RET_OK;
+}
+
+int FusedElementwiseRun(void *cdata, int task_id) {
+  auto kernel = reinterpret_cast<FusedElementwiseCPUKernel *>(cdata);
+  auto ret = kernel->DoExecute(task_id);
+  if (ret != RET_OK) {
+    MS_LOG(ERROR) << "FusedElementwiseRun error task_id[" << task_id << "] error_code[" << ret << "]";
+    return ret;
+  }
+  return RET_OK;
+}
+
+int FusedElementwiseCPUKernel::Run() {
+  if (!fused_) {
+    return RunMembers();
+  }
+  for (auto &value : plan_.values) {
+    if (value.tensor == nullptr) {
+      continue;
+    }
+    value.data = reinterpret_cast<float *>(value.tensor->MutableData());
+    if (value.data == nullptr) {
+      MS_LOG(ERROR) << "tensor data of fused kernel " << name_ << " is nullptr";
+      return RET_NULL_PTR;
+    }
+  }
+  thread_count_ = MSMIN(context_->thread_num_, UP_DIV(plan_.element_num, kFusedTile));
+  size_t buffer_size = thread_count_ * (plan_.temp_num + kFusedScratchNum) * kFusedTile * sizeof(float);
+  tile_buffer_ = reinterpret_cast<float *>(context_->allocator->Malloc(buffer_size));
+  if (tile_buffer_ == nullptr) {
+    MS_LOG(ERROR) << "malloc tile buffer failed, size: " << buffer_size;
+    return RET_ERROR;
+  }
+  auto ret = ParallelLaunch(context_->thread_pool_, FusedElementwiseRun, this, thread_count_);
+  context_->allocator->Free(tile_buffer_);
+  tile_buffer_ = nullptr;
+  if (ret != RET_OK) {
+    MS_LOG(ERROR) << "FusedElementwiseRun error error_code[" << ret << "]";
+    return RET_ERROR;
+  }
+  return RET_OK;
+}
+}  // namespace mindspore::kernel
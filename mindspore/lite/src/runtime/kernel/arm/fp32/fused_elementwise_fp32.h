@@ -0,0 +1,94 @@
+/**
+ * Copyright 2020 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef MINDSPORE_LITE_SRC_RUNTIME_KERNEL_ARM_FP32_FUSED_ELEMENTWISE_H_
+#define MINDSPORE_LITE_SRC_RUNTIME_KERNEL_ARM_FP32_FUSED_ELEMENTWISE_H_
+
+#include <string>
+#include <vector>
+#include "src/lite_kernel.h"
+
+namespace mindspore::kernel {
+typedef int (*FusedBinaryFunc)(const float *input0, const float *input1, float *output, const int element_size);
+typedef int (*FusedUnaryFunc)(const float *input, float *output, const int element_size);
+
+enum FusedValueKind { kFusedFull = 0, kFusedScalar, kFusedRow, kFusedTemp };
+
+// one operand of the fused program, either a tensor living outside of the region or a tile-sized temporary
+struct FusedValue {
+  FusedValueKind kind = kFusedFull;
+  lite::Tensor *tensor = nullptr;
+  int temp_index = -1;
+  int row_size = 0;
+  float *data = nullptr;
+};
+
+struct FusedInstr {
+  schema::PrimitiveType type = schema::PrimitiveType_NONE;
+  const OpParameter *param = nullptr;
+  FusedBinaryFunc binary = nullptr;
+  FusedUnaryFunc unary = nullptr;
+  std::vector<int> inputs;
+  int output = -1;
+};
+
+struct FusedPlan {
+  std::vector<FusedValue> values;
+  std::vector<FusedInstr> instrs;
+  int temp_num = 0;
+  int element_num = 0;
+};
+
+// FusedElementwiseCPUKernel runs a chain of fp32 elementwise kernels as one tiled loop. Every tile of kFusedTile
+// elements is pushed through the whole chain before moving on, so intermediate results stay in a per-thread scratch
+// buffer instead of being written out as full tensors. The member kernels are owned by the fused kernel and are only
+// executed one by one when the chain can not be planned for the current shapes.
+class FusedElementwiseCPUKernel : public LiteKernel {
+ public:
+  FusedElementwiseCPUKernel(const std::vector<lite::Tensor *> &inputs, const std::vector<lite::Tensor *> &outputs,
+                            std::vector<LiteKernel *> members, const lite::InnerContext *ctx);
+  ~FusedElementwiseCPUKernel() override;
+
+  int Init() override;
+  int Prepare() override;
+  int PreProcess() override;
+  int ReSize() override;
+  int Run() override;
+  int DoExecute(int task_id);
+
+  const std::vector<LiteKernel *> &members() const { return members_; }
+  bool fused() const { return fused_; }
+
+  static bool IsFusible(const LiteKernel *kernel);
+  // builds the fused program of `members`, whose visible results are `outputs`
+  static int BuildPlan(const std::vector<LiteKernel *> &members, const std::vector<lite::Tensor *> &outputs,
+                       FusedPlan *plan);
+
+ private:
+  int InferMembers();
+  int RunMembers();
+  const float *ValueData(const FusedValue &value, int start, int len, float *temps, float *scratch) const;
+
+  std::vector<LiteKernel *> members_;
+  std::vector<std::vector<int>> planned_shapes_;
+  FusedPlan plan_;
+  bool fused_ = false;
+  int thread_count_ = 1;
+  float *tile_buffer_ = nullptr;
+};
+}  // namespace mindspore::kernel
+
+#endif  // MINDSPORE_LITE_SRC_RUNTIME_KERNEL_ARM_FP32_FUSED_ELEMENTWISE_H_
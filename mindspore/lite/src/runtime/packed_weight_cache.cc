@@ -0,0 +1,134 @@
+/**
+ * Copyright 2020 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "src/runtime/packed_weight_cache.h"
+#include <cstdlib>
+#include <cstring>
+#include "src/common/log_adapter.h"
+#include "include/errorcode.h"
+
+namespace mindspore::lite {
+PackedWeightCache *PackedWeightCache::GetInstance() {
+  static PackedWeightCache instance;
+  return &instance;
+}
+
+PackedWeightCache::~PackedWeightCache() {
+  for (auto &iter : entries_) {
+    free(iter.first);
+  }
+  entries_.clear();
+  shared_.clear();
+}
+
+void PackedWeightCache::RegisterModelBuffer(const void *buf, size_t size) {
+  if (buf == nullptr || size == 0) {
+    return;
+  }
+  std::lock_guard<std::mutex> lock(mutex_);
+  model_buffers_[reinterpret_cast<const char *>(buf)] = size;
+}
+
+void PackedWeightCache::UnregisterModelBuffer(const void *buf) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  auto iter = model_buffers_.find(reinterpret_cast<const char *>(buf));
+  if (iter == model_buffers_.end()) {
+    return;
+  }
+  auto begin = iter->first;
+  auto end = iter->first + iter->second;
+  model_buffers_.erase(iter);
+  for (auto shared_iter = shared_.begin(); shared_iter != shared_.end();) {
+    auto origin = reinterpret_cast<const char *>(std::get<0>(shared_iter->first));
+    if (origin >= begin && origin < end) {
+      entries_[shared_iter->second].shared = false;
+      shared_iter = shared_.erase(shared_iter);
+    } else {
+      shared_iter++;
+    }
+  }
+}
+
+bool PackedWeightCache::InModelBuffer(const void *ptr) const {
+  auto addr = reinterpret_cast<const char *>(ptr);
+  auto iter = model_buffers_.upper_bound(addr);
+  if (iter == model_buffers_.begin()) {
+    return false;
+  }
+  iter--;
+  return addr < iter->first + iter->second;
+}
+
+void *PackedWeightCache::Acquire(const void *origin, const std::string &tag, size_t size, const PackFunc &pack) {
+  if (origin == nullptr || size == 0 || pack == nullptr) {
+    MS_LOG(ERROR) << "Invalid weight to pack, tag: " << tag;
+    return nullptr;
+  }
+  std::lock_guard<std::mutex> lock(mutex_);
+  Key key(origin, tag, size);
+  bool shareable = InModelBuffer(origin);
+  if (shareable) {
+    auto iter = shared_.find(key);
+    if (iter != shared_.end()) {
+      entries_[iter->second].ref_count++;
+      hit_count_++;
+      return iter->second;
+    }
+  }
+  miss_count_++;
+  auto packed = malloc(size);
+  if (packed == nullptr) {
+    MS_LOG(ERROR) << "malloc packed weight failed, size: " << size;
+    return nullptr;
+  }
+  memset(packed, 0, size);
+  auto ret = pack(packed);
+  if (ret != RET_OK) {
+    MS_LOG(ERROR) << "pack weight failed, tag: " << tag;
+    free(packed);
+    return nullptr;
+  }
+  Entry entry;
+  entry.key = key;
+  entry.ref_count = 1;
+  entry.shared = shareable;
+  entries_[packed] = entry;
+  if (shareable) {
+    shared_[key] = packed;
+  }
+  return packed;
+}
+
+void PackedWeightCache::Release(void *packed) {
+  if (packed == nullptr) {
+    return;
+  }
+  std::lock_guard<std::mutex> lock(mutex_);
+  auto iter = entries_.find(packed);
+  if (iter == entries_.end()) {
+    MS_LOG(ERROR) << "packed weight is not acquired from PackedWeightCache";
+    return;
+  }
+  if (--iter->second.ref_count > 0) {
+    return;
+  }
+  if (iter->second.shared) {
+    shared_.erase(iter->second.key);
+  }
+  entries_.erase(iter);
+  free(packed);
+}
+}  // namespace mindspore::lite
@@ -0,0 +1,78 @@
+/**
+ * Copyright 2020 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef MINDSPORE_LITE_SRC_RUNTIME_PACKED_WEIGHT_CACHE_H_
+#define MINDSPORE_LITE_SRC_RUNTIME_PACKED_WEIGHT_CACHE_H_
+
+#include <atomic>
+#include <functional>
+#include <map>
+#include <mutex>
+#include <string>
+#include <tuple>
+#include <unordered_map>
+
+namespace mindspore::lite {
+// PackedWeightCache shares the packed copy of const weights between sessions compiled from the same model.
+// Weight tensors of packed ops are not copied by LiteSession and point into the model buffer, so an address inside a
+// registered model buffer identifies a (model, tensor) pair. Weights outside any registered buffer (dequantized,
+// split by group convolution, ...) get a private packed buffer which is never shared.
+class PackedWeightCache {
+ public:
+  // fill the zero-initialized packed buffer from the origin weight
+  using PackFunc = std::function<int(void *packed)>;
+
+  static PackedWeightCache *GetInstance();
+
+  void RegisterModelBuffer(const void *buf, size_t size);
+
+  // packed buffers of the model stay valid for kernels still holding them, but are no longer returned by Acquire
+  void UnregisterModelBuffer(const void *buf);
+
+  // return the packed buffer of `origin` in layout `tag`, packing it with `pack` on cache miss; nullptr on failure.
+  // every successful Acquire must be paired with a Release.
+  void *Acquire(const void *origin, const std::string &tag, size_t size, const PackFunc &pack);
+
+  void Release(void *packed);
+
+  size_t hit_count() const { return hit_count_.load(); }
+  size_t miss_count() const { return miss_count_.load(); }
+
+ private:
+  PackedWeightCache() = default;
+  ~PackedWeightCache();
+
+  using Key = std::tuple<const void *, std::string, size_t>;
+  struct Entry {
+    Key key;
+    size_t ref_count = 0;
+    bool shared = false;
+  };
+
+  bool InModelBuffer(const void *ptr) const;
+
+  std::mutex mutex_;
+  // model buffer start -> model buffer size
+  std::map<const char *, size_t> model_buffers_;
+  std::map<Key, void *> shared_;
+  std::unordered_map<void *, Entry> entries_;
+  // read without mutex_ by the getters
+  std::atomic<size_t> hit_count_{0};
+  std::atomic<size_t> miss_count_{0};
+};
+}  // namespace mindspore::lite
+
+#endif  // MINDSPORE_LITE_SRC_RUNTIME_PACKED_WEIGHT_CACHE_H_
@@ -0,0 +1,222 @@
+/**
+ * Copyright 2020 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "src/runtime/profiler.h"
+#include <algorithm>
+#include <fstream>
+#include <map>
+#include <sstream>
+#include <thread>
+#include "src/common/utils.h"
+#include "src/common/log_adapter.h"
+#include "include/errorcode.h"
+
+namespace mindspore::lite {
+namespace {
+constexpr size_t kMaxProfilingRecords = 1 << 20;
+
+std::string JsonEscape(const std::string &str) {
+  std::string ret;
+  ret.reserve(str.size());
+  for (auto c : str) {
+    if (c == '"' || c == '\\') {
+      ret.push_back('\\');
+    }
+    ret.push_back(c);
+  }
+  return ret;
+}
+
+std::string CsvEscape(const std::string &str) {
+  if (str.find_first_of(",\"\n") == std::string::npos) {
+    return str;
+  }
+  std::string ret = "\"";
+  for (auto c : str) {
+    if (c == '"') {
+      ret.push_back('"');
+    }
+    ret.push_back(c);
+  }
+  ret.push_back('"');
+  return ret;
+}
+
+std::string ShapesToString(const std::vector<std::vector<int>> &shapes) {
+  std::ostringstream oss;
+  for (size_t i = 0; i < shapes.size(); i++) {
+    if (i != 0) {
+      oss << ";";
+    }
+    oss << "[";
+    for (size_t j = 0; j < shapes[i].size(); j++) {
+      if (j != 0) {
+        oss << " ";
+      }
+      oss << shapes[i][j];
+    }
+    oss << "]";
+  }
+  return oss.str();
+}
+}  // namespace
+
+Profiler::Profiler(Allocator *allocator) : allocator_(allocator), origin_us_(GetTimeUs()) {}
+
+void Profiler::Reset() {
+  records_.clear();
+  threads_.clear();
+  peak_arena_bytes_ = 0;
+  run_begin_ = 0;
+  origin_us_ = GetTimeUs();
+}
+
+void Profiler::EndRun() {
+  // GetTotalSize walks all the blocks of the allocator under its lock, so sample it once per run rather than per kernel
+  size_t arena_bytes = allocator_ == nullptr ? 0 : allocator_->GetTotalSize();
+  peak_arena_bytes_ = std::max(peak_arena_bytes_, arena_bytes);
+  for (size_t i = run_begin_; i < records_.size(); i++) {
+    records_[i].arena_bytes = arena_bytes;
+  }
+  run_begin_ = records_.size();
+}
+
+size_t Profiler::ThreadIndex(const std::thread::id &id) {
+  auto iter = std::find(threads_.begin(), threads_.end(), id);
+  if (iter != threads_.end()) {
+    return iter - threads_.begin();
+  }
+  threads_.emplace_back(id);
+  return threads_.size() - 1;
+}
+
+void Profiler::OnKernelBegin(const std::vector<tensor::MSTensor *> &inputs, const CallBackParam &param) {
+  current_.node_name = param.node_name;
+  current_.node_type = param.node_type;
+  current_.input_shapes.clear();
+  for (auto input : inputs) {
+    current_.input_shapes.emplace_back(input == nullptr ? std::vector<int>{} : input->shape());
+  }
+  current_.thread_id = ThreadIndex(std::this_thread::get_id());
+  current_.start_us = GetTimeUs();
+}
+
+void Profiler::OnKernelEnd(const std::vector<tensor::MSTensor *> &outputs) {
+  current_.end_us = GetTimeUs();
+  current_.output_bytes = 0;
+  for (auto output : outputs) {
+    if (output != nullptr) {
+      current_.output_bytes += output->Size();
+    }
+  }
+  if (records_.size() >= kMaxProfilingRecords) {
+    MS_LOG(WARNING) << "Profiling records exceed " << kMaxProfilingRecords << ", drop record of "
+                    << current_.node_name;
+    return;
+  }
+  records_.emplace_back(current_);
+}
+
+KernelCallBack Profiler::WrapBefore(const KernelCallBack &before) {
+  return [this, before](const std::vector<tensor::MSTensor *> &inputs, const std::vector<tensor::MSTensor *> &outputs,
+                        const CallBackParam &param) {
+    bool ret = true;
+    if (before != nullptr) {
+      ret = before(inputs, outputs, param);
+    }
+    OnKernelBegin(inputs, param);
+    return ret;
+  };
+}
+
+KernelCallBack Profiler::WrapAfter(const KernelCallBack &after) {
+  return [this, after](const std::vector<tensor::MSTensor *> &inputs, const std::vector<tensor::MSTensor *> &outputs,
+                       const CallBackParam &param) {
+    OnKernelEnd(outputs);
+    if (after != nullptr) {
+      return after(inputs, outputs, param);
+    }
+    return true;
+  };
+}
+
+int Profiler::ExportChromeTrace(const std::string &path) const {
+  std::ofstream ofs(path);
+  if (!ofs.is_open()) {
+    MS_LOG(ERROR) << "Open profiling trace file failed: " << path;
+    return RET_ERROR;
+  }
+  ofs << "{\"traceEvents\":[";
+  for (size_t i = 0; i < records_.size(); i++) {
+    auto &record = records_[i];
+    if (i != 0) {
+      ofs << ",";
+    }
+    ofs << "\n{\"name\":\"" << JsonEscape(record.node_name) << "\",\"cat\":\"" << JsonEscape(record.node_type)
+        << "\",\"ph\":\"X\",\"pid\":0,\"tid\":" << record.thread_id << ",\"ts\":" << record.start_us - origin_us_
+        << ",\"dur\":" << record.end_us - record.start_us << ",\"args\":{\"input_shapes\":\""
+        << ShapesToString(record.input_shapes) << "\",\"output_bytes\":" << record.output_bytes
+        << ",\"arena_bytes\":" << record.arena_bytes << "}}";
+  }
+  ofs << "\n],\"displayTimeUnit\":\"ms\"}\n";
+  ofs.close();
+  return RET_OK;
+}
+
+int Profiler::ExportCsv(const std::string &path) const {
+  std::ofstream ofs(path);
+  if (!ofs.is_open()) {
+    MS_LOG(ERROR) << "Open profiling summary file failed: " << path;
+    return RET_ERROR;
+  }
+  struct Summary {
+    const KernelProfilingRecord *first = nullptr;
+    size_t calls = 0;
+    uint64_t total_us = 0;
+    uint64_t max_us = 0;
+    size_t peak_arena_bytes = 0;
+  };
+  // keep the execution order of the first run in the summary
+  std::vector<std::string> order;
+  std::map<std::string, Summary> summaries;
+  uint64_t total_us = 0;
+  for (auto &record : records_) {
+    auto &summary = summaries[record.node_name];
+    if (summary.first == nullptr) {
+      summary.first = &record;
+      order.emplace_back(record.node_name);
+    }
+    auto cost = record.end_us - record.start_us;
+    summary.calls++;
+    summary.total_us += cost;
+    summary.max_us = std::max(summary.max_us, cost);
+    summary.peak_arena_bytes = std::max(summary.peak_arena_bytes, record.arena_bytes);
+    total_us += cost;
+  }
+  ofs << "node_name,node_type,calls,total_us,avg_us,max_us,percent,input_shapes,output_bytes,peak_arena_bytes\n";
+  for (auto &name : order) {
+    auto &summary = summaries[name];
+    ofs << CsvEscape(name) << "," << CsvEscape(summary.first->node_type) << "," << summary.calls << ","
+        << summary.total_us << ","
+        << static_cast<double>(summary.total_us) / summary.calls << "," << summary.max_us << ","
+        << (total_us == 0 ? 0.0 : static_cast<double>(summary.total_us) * 100 / total_us) << ","
+        << ShapesToString(summary.first->input_shapes) << "," << summary.first->output_bytes << ","
+        << summary.peak_arena_bytes << "\n";
+  }
+  ofs.close();
+  return RET_OK;
+}
+}  // namespace mindspore::lite
@@ -0,0 +1,75 @@
+/**
+ * Copyright 2020 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef MINDSPORE_LITE_SRC_RUNTIME_PROFILER_H_
+#define MINDSPORE_LITE_SRC_RUNTIME_PROFILER_H_
+
+#include <string>
+#include <thread>
+#include <vector>
+#include "include/ms_tensor.h"
+#include "src/runtime/allocator.h"
+
+namespace mindspore::lite {
+struct KernelProfilingRecord {
+  std::string node_name;
+  std::string node_type;
+  uint64_t start_us = 0;
+  uint64_t end_us = 0;
+  size_t thread_id = 0;
+  std::vector<std::vector<int>> input_shapes;
+  size_t output_bytes = 0;
+  size_t arena_bytes = 0;
+};
+
+// Profiler records one KernelProfilingRecord per kernel execution. It is hooked into the executor through the
+// before/after KernelCallBack chain, so kernels themselves do not need to know about it.
+class Profiler {
+ public:
+  explicit Profiler(Allocator *allocator);
+  ~Profiler() = default;
+
+  void Reset();
+  // sample the arena size of the allocator after a run and attach it to the records of the run
+  void EndRun();
+
+  // wrap user callbacks: the user `before` runs ahead of the profiler and the user `after` runs behind it, so that
+  // the time spent in user callbacks is not attributed to the kernel.
+  KernelCallBack WrapBefore(const KernelCallBack &before);
+  KernelCallBack WrapAfter(const KernelCallBack &after);
+
+  int ExportChromeTrace(const std::string &path) const;
+  int ExportCsv(const std::string &path) const;
+
+  const std::vector<KernelProfilingRecord> &records() const { return records_; }
+  size_t peak_arena_bytes() const { return peak_arena_bytes_; }
+
+ private:
+  void OnKernelBegin(const std::vector<tensor::MSTensor *> &inputs, const CallBackParam &param);
+  void OnKernelEnd(const std::vector<tensor::MSTensor *> &outputs);
+  size_t ThreadIndex(const std::thread::id &id);
+
+  Allocator *allocator_ = nullptr;
+  uint64_t origin_us_ = 0;
+  size_t peak_arena_bytes_ = 0;
+  size_t run_begin_ = 0;
+  KernelProfilingRecord current_;
+  std::vector<std::thread::id> threads_;
+  std::vector<KernelProfilingRecord> records_;
+};
+}  // namespace mindspore::lite
+
+#endif  // MINDSPORE_LITE_SRC_RUNTIME_PROFILER_H_
@@ -46,9 +46,15 @@
 #define MAX_THREAD_NUM (8)
 #define DEFAULT_SPIN_COUNT (30000)
 
+// A task is shared by the launching thread and every worker it was pushed to. Task ids are claimed dynamically, so a
+// worker that is busy with the task of another launcher does not hold this launch back; the last holder frees it.
 typedef struct {
   int (*func)(void *arg, int);
   void *content;
+  int task_num;
+  atomic_int next_task_id;
+  atomic_int finished_num;
+  atomic_int ref_count;
 } Task;
 
 typedef struct Thread {
@@ -78,6 +84,9 @@ typedef struct ThreadPool {
   int thread_num;
   BindMode mode;
   atomic_bool is_alive;
+  // serializes producers, so that sessions sharing one pool can launch concurrently
+  pthread_mutex_t push_lock;
+  int next_thread;
 } ThreadPool;
 
 Thread *GetThread(struct ThreadPool *thread_pool, int thread_id) {
@@ -637,25 +646,18 @@ bool PopTaskFromQueue(Thread *thread, Task **task) {
   return true;
 }
 
-void WaitAllThread(struct ThreadPool *thread_pool) {
-  if (thread_pool == NULL) {
-    LOG_ERROR("get thread pool instane failed");
-    return;
+void RunClaimedTasks(Task *task) {
+  int task_id = atomic_fetch_add_explicit(&task->next_task_id, 1, memory_order_relaxed);
+  while (task_id < task->task_num) {
+    task->func(task->content, task_id);
+    atomic_fetch_add_explicit(&task->finished_num, 1, memory_order_release);
+    task_id = atomic_fetch_add_explicit(&task->next_task_id, 1, memory_order_relaxed);
   }
-  bool k_success_flag = false;
-  while (!k_success_flag) {
-    k_success_flag = true;
-    for (int i = 0; i < thread_pool->thread_num - 1; ++i) {
-      Thread *thread = GetThread(thread_pool, i);
-      if (thread == NULL) {
-        LOG_ERROR("get thread failed, thread_id: %d", i);
-        return;
-      }
-      if (thread->task_size != 0) {
-        k_success_flag = false;
-        break;
-      }
-    }
+}
+
+void ReleaseTask(Task *task) {
+  if (atomic_fetch_sub_explicit(&task->ref_count, 1, memory_order_acq_rel) == 1) {
+    free(task);
   }
 }
 
@@ -668,24 +670,36 @@ int DistributeTask(struct ThreadPool *thread_pool, Task *task, int task_num) {
     LOG_ERROR("invalid task num: %d, thread num: %d", task_num, thread_pool->thread_num);
     return RET_TP_ERROR;
   }
-  bool k_success_flag = false;
-  int size = thread_pool->thread_num < task_num ? thread_pool->thread_num : task_num;
-  for (int i = 0; i < size - 1; ++i) {
-    do {
-      k_success_flag = true;
-      if (!PushTaskToQueue(thread_pool, i, task)) {
-        k_success_flag = false;
-      }
-    } while (!k_success_flag);
-  }
-  // master thread
   if (task->func == NULL) {
     LOG_ERROR("task->func is nullptr");
     return RET_TP_ERROR;
   }
-  task->func(task->content, size - 1);
+  // workers are picked round-robin, so concurrent launchers spread over the whole pool instead of piling up on the
+  // first workers
+  int worker_num = thread_pool->thread_num - 1;
+  int pushed = 0;
+  pthread_mutex_lock(&thread_pool->push_lock);
+  int start = thread_pool->next_thread;
+  thread_pool->next_thread = (start + 1) % worker_num;
+  for (int i = 0; i < worker_num && pushed < task_num - 1; ++i) {
+    atomic_fetch_add_explicit(&task->ref_count, 1, memory_order_relaxed);
+    if (PushTaskToQueue(thread_pool, (start + i) % worker_num, task)) {
+      pushed++;
+    } else {
+      atomic_fetch_sub_explicit(&task->ref_count, 1, memory_order_relaxed);
+    }
+  }
+  pthread_mutex_unlock(&thread_pool->push_lock);
+  // master thread
+  RunClaimedTasks(task);
   // wait
-  WaitAllThread(thread_pool);
+  int spin_count = 0;
+  while (atomic_load_explicit(&task->finished_num, memory_order_acquire) < task->task_num) {
+    if (++spin_count >= DEFAULT_SPIN_COUNT) {
+      sched_yield();
+    }
+  }
+  ReleaseTask(task);
   return RET_TP_OK;
 }
 
@@ -701,10 +715,22 @@ int AddTask(struct ThreadPool *thread_pool, int func(void *, int), void *content
     }
     return RET_TP_OK;
   }
-  Task task;
-  task.func = func;
-  task.content = content;
-  return DistributeTask(thread_pool, &task, task_num);
+  Task *task = (Task *)malloc(sizeof(Task));
+  if (task == NULL) {
+    LOG_ERROR("malloc task failed");
+    return RET_TP_ERROR;
+  }
+  task->func = func;
+  task->content = content;
+  task->task_num = task_num;
+  task->next_task_id = ATOMIC_VAR_INIT(0);
+  task->finished_num = ATOMIC_VAR_INIT(0);
+  task->ref_count = ATOMIC_VAR_INIT(1);
+  int ret = DistributeTask(thread_pool, task, task_num);
+  if (ret != RET_TP_OK) {
+    free(task);
+  }
+  return ret;
 }
 
 int ParallelLaunch(struct ThreadPool *thread_pool, int (*func)(void *, int), void *content, int task_num) {
@@ -720,17 +746,13 @@ void ThreadRun(Thread *thread) {
     return;
   }
   Task *task = NULL;
-  int thread_id = thread->thread_id;
   int spin_count = 0;
   sem_post(&thread->sem_inited);
   while (thread_pool->is_alive) {
     while (thread->activate) {
       if (PopTaskFromQueue(thread, &task)) {
-        if (task->func == NULL) {
-          LOG_ERROR("task->func is nullptr");
-          return;
-        }
-        task->func(task->content, thread_id);
+        RunClaimedTasks(task);
+        ReleaseTask(task);
         atomic_fetch_sub_explicit(&thread->task_size, 1, memory_order_relaxed);
         spin_count = 0;
         sem_trywait(&thread->sem);
@@ -820,6 +842,8 @@ ThreadPool *CreateThreadPool(int thread_num, int mode) {
   thread_pool->is_alive = ATOMIC_VAR_INIT(true);
   thread_pool->mode = mode;
   thread_pool->thread_list = NULL;
+  thread_pool->next_thread = 0;
+  pthread_mutex_init(&thread_pool->push_lock, NULL);
   if (thread_num > 1) {
     thread_pool->thread_list = (ThreadList *)malloc(sizeof(ThreadList));
     if (thread_pool->thread_list == NULL) {
@@ -905,6 +929,7 @@ void DestroyThreadPool(struct ThreadPool *thread_pool) {
   }
   free(thread_pool->thread_list);
   thread_pool->thread_list = NULL;
+  pthread_mutex_destroy(&thread_pool->push_lock);
   LOG_INFO("destroy thread pool success");
 }
 
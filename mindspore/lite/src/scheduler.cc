@@ -15,6 +15,7 @@
  */
 
 #include "src/scheduler.h"
+#include <algorithm>
 #include <map>
 #include <queue>
 #include <string>
@@ -24,6 +25,9 @@
 #include "src/common/utils.h"
 #include "src/kernel_registry.h"
 #include "src/sub_graph_kernel.h"
+#ifndef SUPPORT_TRAIN
+#include "src/runtime/kernel/arm/fp32/fused_elementwise_fp32.h"
+#endif
 #if SUPPORT_GPU
 #include "src/runtime/kernel/opencl/opencl_subgraph.h"
 #include "src/runtime/opencl/opencl_runtime.h"
@@ -48,6 +52,15 @@ int Scheduler::Schedule(const lite::Model *model, std::vector<Tensor *> *tensors
 
   kernel::LiteKernelUtil::InitIOKernels(*kernels);
 
+#ifndef SUPPORT_TRAIN
+  ret = FuseElementwiseKernels(kernels);
+  if (ret != RET_OK) {
+    MS_LOG(ERROR) << "FuseElementwiseKernels failed.";
+    return ret;
+  }
+  kernel::LiteKernelUtil::InitIOKernels(*kernels);
+#endif
+
   ret = ConstructSubGraphs(kernels);
   if (ret != RET_OK) {
     MS_LOG(ERROR) << "ConstructSubGraphs failed.";
@@ -181,6 +194,89 @@ int Scheduler::BuildKernels(const lite::Model *model, const std::vector<Tensor *
   return RET_OK;
 }
 
+#ifndef SUPPORT_TRAIN
+namespace {
+std::vector<Tensor *> FusedRegionInputs(const std::vector<kernel::LiteKernel *> &members) {
+  std::vector<Tensor *> inputs;
+  for (auto *member : members) {
+    for (auto *tensor : member->in_tensors()) {
+      bool inner = std::any_of(members.begin(), members.end(), [tensor](const kernel::LiteKernel *kernel) {
+        return IsContain(kernel->out_tensors(), tensor);
+      });
+      if (!inner && !IsContain(inputs, tensor)) {
+        inputs.emplace_back(tensor);
+      }
+    }
+  }
+  return inputs;
+}
+
+std::vector<Tensor *> FusedRegionOutputs(const std::vector<kernel::LiteKernel *> &members) {
+  std::vector<Tensor *> outputs;
+  for (auto *member : members) {
+    bool used_outside =
+      member->is_model_output() ||
+      std::any_of(member->out_kernels().begin(), member->out_kernels().end(),
+                  [&members](kernel::LiteKernel *out_kernel) { return !IsContain(members, out_kernel); });
+    if (used_outside) {
+      outputs.insert(outputs.end(), member->out_tensors().begin(), member->out_tensors().end());
+    }
+  }
+  return outputs;
+}
+}  // namespace
+
+// Contiguous runs of fp32 elementwise kernels are replaced by one FusedElementwiseCPUKernel. Kernels are kept in
+// topological order, so a contiguous run never has an outside kernel on a path between two of its members.
+int Scheduler::FuseElementwiseKernels(std::vector<kernel::LiteKernel *> *kernels) {
+  MS_ASSERT(kernels != nullptr);
+  std::vector<kernel::LiteKernel *> result;
+  size_t index = 0;
+  while (index < kernels->size()) {
+    std::vector<kernel::LiteKernel *> members;
+    kernel::FusedPlan plan;
+    for (size_t i = index; i < kernels->size(); ++i) {
+      auto *candidate = kernels->at(i);
+      if (!kernel::FusedElementwiseCPUKernel::IsFusible(candidate)) {
+        break;
+      }
+      members.emplace_back(candidate);
+      if (kernel::FusedElementwiseCPUKernel::BuildPlan(members, FusedRegionOutputs(members), &plan) != RET_OK) {
+        members.pop_back();
+        break;
+      }
+    }
+    if (members.size() < 2) {
+      result.emplace_back(kernels->at(index++));
+      continue;
+    }
+    auto *fused_kernel = new (std::nothrow)
+      kernel::FusedElementwiseCPUKernel(FusedRegionInputs(members), FusedRegionOutputs(members), members, context_);
+    if (fused_kernel == nullptr) {
+      MS_LOG(WARNING) << "new fused elementwise kernel failed, keep " << members.size() << " kernels unfused";
+      result.insert(result.end(), members.begin(), members.end());
+      index += members.size();
+      continue;
+    }
+    fused_kernel->set_is_model_output(std::any_of(members.begin(), members.end(), [](const kernel::LiteKernel *k) {
+      return k->is_model_output();
+    }));
+    result.emplace_back(fused_kernel);
+    index += members.size();
+    auto ret = fused_kernel->Init();
+    if (ret != RET_OK) {
+      MS_LOG(ERROR) << "init fused kernel " << fused_kernel->name() << " failed";
+      result.insert(result.end(), kernels->begin() + index, kernels->end());
+      *kernels = result;
+      return ret;
+    }
+    MS_LOG(DEBUG) << "fuse " << members.size() << " elementwise kernels: " << fused_kernel->name();
+  }
+  *kernels = result;
+  return RET_OK;
+}
+#endif
+
 std::vector<kernel::LiteKernel *> Scheduler::FindAllSubGraphKernels(
   kernel::LiteKernel *head_kernel, std::map<const kernel::LiteKernel *, bool> *sinked_kernel_map) {
   MS_ASSERT(head_kernel != nullptr);
@@ -45,6 +45,10 @@ class Scheduler {
 
   int ConstructSubGraphs(std::vector<kernel::LiteKernel *> *kernels);
 
+#ifndef SUPPORT_TRAIN
+  int FuseElementwiseKernels(std::vector<kernel::LiteKernel *> *kernels);
+#endif
+
   kernel::SubGraphKernel *CreateSubGraphKernel(const std::vector<kernel::LiteKernel *> &kernels,
                                                kernel::SubGraphType type);
 
@@ -109,8 +109,16 @@ int SubGraphKernel::ReSize(bool is_interrupt) {
     }
     auto primitive = const_cast<mindspore::lite::PrimitiveC *>(kernel->GetPrimitive());
     if (primitive == nullptr) {
-      MS_LOG(ERROR) << "kernel(" << kernel->name() << ")'s primitive is nullptr!";
-      return RET_ERROR;
+      // kernels built by the scheduler, such as fused elementwise kernels, infer their members in ReSize
+      if (is_interrupt) {
+        continue;
+      }
+      auto ret = kernel->ReSize();
+      if (ret != RET_OK) {
+        MS_LOG(ERROR) << "kernel " << kernel->name() << " resize fail!ret = " << ret;
+        return ret;
+      }
+      continue;
     }
     std::vector<lite::Tensor *> inputs = kernel->in_tensors();
     std::vector<lite::Tensor *> outputs = kernel->out_tensors();
@@ -0,0 +1,140 @@
+/**
+ * Copyright 2020 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <cmath>
+#include <vector>
+#include "common/common_test.h"
+#include "mindspore/lite/src/runtime/kernel/arm/fp32/fused_elementwise_fp32.h"
+#include "mindspore/lite/src/runtime/kernel/arm/fp32/activation_fp32.h"
+#include "mindspore/lite/src/runtime/kernel/arm/fp32/arithmetic_fp32.h"
+#include "src/ops/primitive_c.h"
+
+namespace mindspore {
+using mindspore::kernel::KERNEL_ARCH::kCPU;
+
+class TestFusedElementwiseFp32 : public mindspore::CommonTest {
+ public:
+  TestFusedElementwiseFp32() {}
+};
+
+namespace {
+lite::Tensor *NewTensor(const std::vector<int> &shape, const std::vector<float> &data) {
+  auto tensor = new lite::Tensor(kNumberTypeFloat32, shape, schema::Format_NHWC, lite::Tensor::Category::VAR);
+  if (!data.empty()) {
+    tensor->MallocData();
+    memcpy(tensor->MutableData(), data.data(), data.size() * sizeof(float));
+  }
+  return tensor;
+}
+
+OpParameter *NewArithmeticParam(schema::PrimitiveType type) {
+  auto param = reinterpret_cast<ArithmeticParameter *>(malloc(sizeof(ArithmeticParameter)));
+  memset(param, 0, sizeof(ArithmeticParameter));
+  param->op_parameter_.type_ = type;
+  param->activation_type_ = schema::ActivationType_NO_ACTIVATION;
+  return reinterpret_cast<OpParameter *>(param);
+}
+
+OpParameter *NewActivationParam(int activation_type) {
+  auto param = reinterpret_cast<ActivationParameter *>(malloc(sizeof(ActivationParameter)));
+  memset(param, 0, sizeof(ActivationParameter));
+  param->op_parameter_.type_ = schema::PrimitiveType_Activation;
+  param->type_ = activation_type;
+  return reinterpret_cast<OpParameter *>(param);
+}
+}  // namespace
+
+// y = tanh(x * s) + bias, with s a scalar and bias broadcast along the last axis
+TEST_F(TestFusedElementwiseFp32, MulTanhAdd) {
+  const int rows = 3;
+  const int cols = 700;
+  std::vector<float> x(rows * cols);
+  std::vector<float> bias(cols);
+  for (int i = 0; i < rows * cols; ++i) {
+    x[i] = static_cast<float>(i % 97) / 50.0f - 1.0f;
+  }
+  for (int i = 0; i < cols; ++i) {
+    bias[i] = static_cast<float>(i % 13) / 10.0f;
+  }
+  auto x_tensor = NewTensor({rows, cols}, x);
+  auto s_tensor = NewTensor({1}, {0.5f});
+  auto bias_tensor = NewTensor({cols}, bias);
+  auto mul_out = NewTensor({rows, cols}, {});
+  auto tanh_out = NewTensor({rows, cols}, {});
+  auto y_tensor = NewTensor({rows, cols}, {});
+
+  auto ctx = new lite::InnerContext;
+  ctx->thread_num_ = 2;
+  ASSERT_EQ(lite::RET_OK, ctx->Init());
+  lite::PrimitiveC mul_primitive;
+  lite::PrimitiveC tanh_primitive;
+  lite::PrimitiveC add_primitive;
+  kernel::KernelKey desc = {kCPU, kNumberTypeFloat32, schema::PrimitiveType_NONE};
+
+  auto mul = new kernel::ArithmeticCPUKernel(NewArithmeticParam(schema::PrimitiveType_Mul), {x_tensor, s_tensor},
+                                             {mul_out}, ctx, &mul_primitive);
+  auto tanh = new kernel::ActivationCPUKernel(NewActivationParam(schema::ActivationType_TANH), {mul_out}, {tanh_out},
+                                              ctx, &tanh_primitive);
+  auto add = new kernel::ArithmeticCPUKernel(NewArithmeticParam(schema::PrimitiveType_Add), {tanh_out, bias_tensor},
+                                             {y_tensor}, ctx, &add_primitive);
+  for (auto member : std::vector<kernel::LiteKernel *>{mul, tanh, add}) {
+    member->set_desc(desc);
+    ASSERT_TRUE(kernel::FusedElementwiseCPUKernel::IsFusible(member));
+  }
+
+  auto fused =
+    new kernel::FusedElementwiseCPUKernel({x_tensor, s_tensor, bias_tensor}, {y_tensor}, {mul, tanh, add}, ctx);
+  ASSERT_EQ(lite::RET_OK, fused->Init());
+  ASSERT_TRUE(fused->fused());
+  ASSERT_EQ(lite::RET_OK, fused->PreProcess());
+  ASSERT_EQ(lite::RET_OK, fused->Run());
+  EXPECT_EQ(nullptr, mul_out->data_c());
+  EXPECT_EQ(nullptr, tanh_out->data_c());
+
+  std::vector<float> expect(rows * cols);
+  for (int i = 0; i < rows * cols; ++i) {
+    expect[i] = std::tanh(x[i] * 0.5f) + bias[i % cols];
+  }
+  ASSERT_EQ(0, CompareOutputData(reinterpret_cast<float *>(y_tensor->MutableData()), expect.data(), rows * cols,
+                                 0.0001));
+
+  delete fused;
+  for (auto tensor : {x_tensor, s_tensor, bias_tensor, mul_out, tanh_out, y_tensor}) {
+    delete tensor;
+  }
+  delete ctx;
+}
+
+TEST_F(TestFusedElementwiseFp32, RejectNonRowBroadcast) {
+  auto x_tensor = NewTensor({4, 8}, {});
+  auto col_tensor = NewTensor({4, 1}, {});
+  auto out_tensor = NewTensor({4, 8}, {});
+  auto ctx = new lite::InnerContext;
+  ctx->thread_num_ = 1;
+  ASSERT_EQ(lite::RET_OK, ctx->Init());
+  lite::PrimitiveC primitive;
+  auto add = new kernel::ArithmeticCPUKernel(NewArithmeticParam(schema::PrimitiveType_Add), {x_tensor, col_tensor},
+                                             {out_tensor}, ctx, &primitive);
+  add->set_desc({kCPU, kNumberTypeFloat32, schema::PrimitiveType_NONE});
+  kernel::FusedPlan plan;
+  EXPECT_NE(lite::RET_OK, kernel::FusedElementwiseCPUKernel::BuildPlan({add}, {out_tensor}, &plan));
+
+  delete add;
+  for (auto tensor : {x_tensor, col_tensor, out_tensor}) {
+    delete tensor;
+  }
+  delete ctx;
+}
+}  // namespace mindspore
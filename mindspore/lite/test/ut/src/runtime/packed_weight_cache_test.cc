@@ -0,0 +1,79 @@
+/**
+ * Copyright 2020 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <vector>
+#include "common/common_test.h"
+#include "include/errorcode.h"
+#include "src/runtime/packed_weight_cache.h"
+
+namespace mindspore {
+class PackedWeightCacheTest : public mindspore::CommonTest {
+ public:
+  PackedWeightCacheTest() {}
+};
+
+TEST_F(PackedWeightCacheTest, ShareInModelBuffer) {
+  auto cache = lite::PackedWeightCache::GetInstance();
+  std::vector<float> model_buf(16, 1.0f);
+  std::vector<float> private_weight(4, 2.0f);
+  cache->RegisterModelBuffer(model_buf.data(), model_buf.size() * sizeof(float));
+
+  int pack_times = 0;
+  auto pack = [&](void *packed) {
+    pack_times++;
+    reinterpret_cast<float *>(packed)[0] = 3.0f;
+    return lite::RET_OK;
+  };
+  auto origin = model_buf.data() + 4;
+  auto packed0 = cache->Acquire(origin, "col8", 8 * sizeof(float), pack);
+  auto packed1 = cache->Acquire(origin, "col8", 8 * sizeof(float), pack);
+  ASSERT_NE(packed0, nullptr);
+  ASSERT_EQ(packed0, packed1);
+  ASSERT_EQ(pack_times, 1);
+  ASSERT_EQ(reinterpret_cast<float *>(packed1)[0], 3.0f);
+  ASSERT_EQ(reinterpret_cast<float *>(packed1)[1], 0.0f);
+
+  // another layout of the same weight is packed separately
+  auto packed2 = cache->Acquire(origin, "col4", 8 * sizeof(float), pack);
+  ASSERT_NE(packed2, packed0);
+  ASSERT_EQ(pack_times, 2);
+
+  // weight out of any model buffer is never shared
+  auto private0 = cache->Acquire(private_weight.data(), "col8", 8 * sizeof(float), pack);
+  auto private1 = cache->Acquire(private_weight.data(), "col8", 8 * sizeof(float), pack);
+  ASSERT_NE(private0, private1);
+  ASSERT_EQ(pack_times, 4);
+
+  // unregistered model buffer is not shared any more, but acquired buffers stay valid
+  cache->UnregisterModelBuffer(model_buf.data());
+  auto packed3 = cache->Acquire(origin, "col8", 8 * sizeof(float), pack);
+  ASSERT_NE(packed3, packed0);
+  ASSERT_EQ(reinterpret_cast<float *>(packed0)[0], 3.0f);
+
+  for (auto packed : {packed0, packed1, packed2, packed3, private0, private1}) {
+    cache->Release(packed);
+  }
+}
+
+TEST_F(PackedWeightCacheTest, PackFailed) {
+  auto cache = lite::PackedWeightCache::GetInstance();
+  std::vector<float> model_buf(16, 1.0f);
+  cache->RegisterModelBuffer(model_buf.data(), model_buf.size() * sizeof(float));
+  auto packed = cache->Acquire(model_buf.data(), "col8", 8 * sizeof(float), [](void *) { return lite::RET_ERROR; });
+  ASSERT_EQ(packed, nullptr);
+  cache->UnregisterModelBuffer(model_buf.data());
+}
+}  // namespace mindspore
@@ -0,0 +1,96 @@
+/**
+ * Copyright 2020 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <fstream>
+#include <memory>
+#include <sstream>
+#include <string>
+#include "common/common_test.h"
+#include "include/errorcode.h"
+#include "src/runtime/allocator.h"
+#include "src/runtime/profiler.h"
+#include "src/tensor.h"
+
+namespace mindspore {
+class ProfilerTest : public mindspore::CommonTest {
+ public:
+  ProfilerTest() {}
+};
+
+TEST_F(ProfilerTest, RecordAndExport) {
+  auto allocator = lite::Allocator::Create();
+  lite::Profiler profiler(allocator.get());
+  lite::Tensor input(kNumberTypeFloat32, {1, 4, 4, 3});
+  lite::Tensor output(kNumberTypeFloat32, {1, 2, 2, 3});
+  std::vector<tensor::MSTensor *> inputs = {&input};
+  std::vector<tensor::MSTensor *> outputs = {&output};
+
+  int user_before_calls = 0;
+  KernelCallBack user_before = [&](std::vector<tensor::MSTensor *>, std::vector<tensor::MSTensor *>,
+                                   const CallBackParam &) {
+    user_before_calls++;
+    return true;
+  };
+  auto before = profiler.WrapBefore(user_before);
+  auto after = profiler.WrapAfter(nullptr);
+  for (int i = 0; i < 2; i++) {
+    ASSERT_TRUE(before(inputs, outputs, {"pool", "Pooling"}));
+    ASSERT_TRUE(after(inputs, outputs, {"pool", "Pooling"}));
+  }
+  ASSERT_TRUE(before(outputs, outputs, {"relu", "Activation"}));
+  ASSERT_TRUE(after(outputs, outputs, {"relu", "Activation"}));
+  auto data = allocator->Malloc(1024);
+  profiler.EndRun();
+  allocator->Free(data);
+
+  ASSERT_EQ(user_before_calls, 2);
+  auto &records = profiler.records();
+  ASSERT_EQ(records.size(), 3);
+  ASSERT_EQ(records[0].node_name, "pool");
+  ASSERT_EQ(records[0].input_shapes.size(), 1);
+  ASSERT_EQ(records[0].input_shapes[0], std::vector<int>({1, 4, 4, 3}));
+  ASSERT_EQ(records[0].output_bytes, 12 * sizeof(float));
+  ASSERT_LE(records[0].start_us, records[0].end_us);
+  ASSERT_EQ(records[2].node_type, "Activation");
+  // the arena size is sampled once per run
+  ASSERT_GE(records[0].arena_bytes, 1024);
+  ASSERT_EQ(records[2].arena_bytes, records[0].arena_bytes);
+  ASSERT_EQ(profiler.peak_arena_bytes(), records[0].arena_bytes);
+
+  std::string trace_file = "./profiler_test.json";
+  std::string summary_file = "./profiler_test.csv";
+  ASSERT_EQ(profiler.ExportChromeTrace(trace_file), lite::RET_OK);
+  ASSERT_EQ(profiler.ExportCsv(summary_file), lite::RET_OK);
+
+  std::ifstream trace(trace_file);
+  std::stringstream trace_content;
+  trace_content << trace.rdbuf();
+  ASSERT_NE(trace_content.str().find("\"traceEvents\""), std::string::npos);
+  ASSERT_NE(trace_content.str().find("\"name\":\"relu\""), std::string::npos);
+
+  std::ifstream summary(summary_file);
+  std::string line;
+  std::getline(summary, line);
+  ASSERT_EQ(line.find("node_name,node_type,calls"), 0);
+  std::getline(summary, line);
+  ASSERT_EQ(line.find("pool,Pooling,2,"), 0);
+  std::getline(summary, line);
+  ASSERT_EQ(line.find("relu,Activation,1,"), 0);
+
+  profiler.Reset();
+  ASSERT_TRUE(profiler.records().empty());
+}
+}  // namespace mindspore
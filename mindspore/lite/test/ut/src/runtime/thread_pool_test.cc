@@ -0,0 +1,77 @@
+/**
+ * Copyright 2020 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <atomic>
+#include <thread>
+#include <vector>
+#include "common/common_test.h"
+#include "src/runtime/runtime_api.h"
+
+namespace mindspore {
+class ThreadPoolTest : public mindspore::CommonTest {
+ public:
+  ThreadPoolTest() {}
+};
+
+namespace {
+constexpr int kPoolThreadNum = 4;
+
+struct LaunchRecord {
+  std::atomic<int> hits[kPoolThreadNum];
+};
+
+int RecordTask(void *cdata, int task_id) {
+  reinterpret_cast<LaunchRecord *>(cdata)->hits[task_id]++;
+  return 0;
+}
+}  // namespace
+
+// several sessions launching on one pool at the same time must each see every task id exactly once
+TEST_F(ThreadPoolTest, ConcurrentLaunch) {
+  auto thread_pool = CreateLiteThreadPool(kPoolThreadNum, NO_BIND_MODE);
+  ASSERT_NE(thread_pool, nullptr);
+  const int launcher_num = 6;
+  const int launch_times = 2000;
+  std::atomic<int> wrong_num(0);
+  std::vector<std::thread> launchers;
+  for (int i = 0; i < launcher_num; i++) {
+    launchers.emplace_back([i, thread_pool, &wrong_num]() {
+      for (int j = 0; j < launch_times; j++) {
+        LaunchRecord record;
+        for (auto &hit : record.hits) {
+          hit = 0;
+        }
+        int task_num = 2 + (i + j) % (kPoolThreadNum - 1);
+        if (ParallelLaunch(thread_pool, RecordTask, &record, task_num) != 0) {
+          wrong_num++;
+          continue;
+        }
+        for (int k = 0; k < kPoolThreadNum; k++) {
+          if (record.hits[k] != (k < task_num ? 1 : 0)) {
+            wrong_num++;
+          }
+        }
+      }
+    });
+  }
+  for (auto &launcher : launchers) {
+    launcher.join();
+  }
+  EXPECT_EQ(wrong_num, 0);
+  DestroyThreadPool(thread_pool);
+  free(thread_pool);
+}
+}  // namespace mindspore
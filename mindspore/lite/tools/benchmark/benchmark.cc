@@ -19,8 +19,12 @@
 #include <cinttypes>
 #undef __STDC_FORMAT_MACROS
 #include <algorithm>
+#include <cerrno>
+#include <climits>
+#include <cstdlib>
 #include <utility>
 #include <functional>
+#include <thread>
 #include "include/context.h"
 #include "include/ms_tensor.h"
 #include "include/version.h"
@@ -339,6 +343,14 @@ int Benchmark::MarkPerformance() {
 
   MS_LOG(INFO) << "Running benchmark loops...";
   std::cout << "Running benchmark loops..." << std::endl;
+  if (!flags_->profiling_file_.empty()) {
+    auto status = session_->EnableProfiling(true);
+    if (status != RET_OK) {
+      MS_LOG(ERROR) << "Enable profiling error " << status;
+      std::cerr << "Enable profiling error " << status << std::endl;
+      return status;
+    }
+  }
   uint64_t time_min = 1000000;
   uint64_t time_max = 0;
   uint64_t time_avg = 0;
@@ -362,6 +374,18 @@ int Benchmark::MarkPerformance() {
     session_->BindThread(false);
   }
 
+  if (!flags_->profiling_file_.empty()) {
+    auto trace_file = flags_->profiling_file_ + ".json";
+    auto summary_file = flags_->profiling_file_ + ".csv";
+    auto status = session_->ExportProfiling(trace_file, summary_file);
+    if (status != RET_OK) {
+      MS_LOG(ERROR) << "Export profiling error " << status;
+      std::cerr << "Export profiling error " << status << std::endl;
+      return status;
+    }
+    std::cout << "Profiling dumped to " << trace_file << " and " << summary_file << std::endl;
+  }
+
   if (flags_->time_profiling_) {
     const std::vector<std::string> per_op_name = {"opName", "avg(ms)", "percent", "calledTimes", "opTotalTime"};
     const std::vector<std::string> per_op_type = {"opType", "avg(ms)", "percent", "calledTimes", "opTotalTime"};
@@ -381,6 +405,90 @@ int Benchmark::MarkPerformance() {
   return RET_OK;
 }
 
+int Benchmark::MarkConcurrentThroughput(Model *model, const Context &context) {
+  auto runtime = std::unique_ptr<session::LiteRuntime>(session::LiteRuntime::CreateRuntime(&context));
+  if (runtime == nullptr) {
+    MS_LOG(ERROR) << "CreateRuntime failed";
+    std::cerr << "CreateRuntime failed" << std::endl;
+    return RET_ERROR;
+  }
+  auto model_name = flags_->model_file_.substr(flags_->model_file_.find_last_of(DELIM_SLASH) + 1);
+  for (auto session_num : flags_->concurrent_sessions_) {
+    // the thread budget is split between the sessions, every session keeps at least one thread
+    int thread_num = std::max(1, runtime->thread_budget() / session_num);
+    std::vector<std::unique_ptr<session::LiteSession>> sessions;
+    for (int i = 0; i < session_num; i++) {
+      auto session = std::unique_ptr<session::LiteSession>(runtime->CreateSession(model, thread_num));
+      if (session == nullptr) {
+        MS_LOG(ERROR) << "CreateSession from runtime failed";
+        std::cerr << "CreateSession from runtime failed" << std::endl;
+        return RET_ERROR;
+      }
+      if (!flags_->resize_dims_.empty() && session->Resize(session->GetInputs(), flags_->resize_dims_) != RET_OK) {
+        MS_LOG(ERROR) << "Input tensor resize failed.";
+        std::cerr << "Input tensor resize failed." << std::endl;
+        return RET_ERROR;
+      }
+      auto inputs = session->GetInputs();
+      for (size_t j = 0; j < inputs.size() && j < ms_inputs_.size(); j++) {
+        if (inputs[j]->Size() != ms_inputs_[j]->Size() || inputs[j]->MutableData() == nullptr) {
+          MS_LOG(ERROR) << "Input " << j << " of session " << i << " does not match the benchmark input";
+          std::cerr << "Input " << j << " of session " << i << " does not match the benchmark input" << std::endl;
+          return RET_ERROR;
+        }
+        memcpy(inputs[j]->MutableData(), ms_inputs_[j]->MutableData(), ms_inputs_[j]->Size());
+      }
+      for (int j = 0; j < flags_->warm_up_loop_count_; j++) {
+        auto status = session->RunGraph();
+        if (status != RET_OK) {
+          MS_LOG(ERROR) << "Inference error " << status;
+          std::cerr << "Inference error " << status << std::endl;
+          return status;
+        }
+      }
+      sessions.emplace_back(std::move(session));
+    }
+
+    std::vector<int> results(session_num, RET_OK);
+    std::vector<uint64_t> latency(session_num, 0);
+    std::vector<std::thread> workers;
+    auto start = GetTimeUs();
+    for (int i = 0; i < session_num; i++) {
+      workers.emplace_back([this, i, &sessions, &results, &latency]() {
+        for (int j = 0; j < flags_->loop_count_ && results[i] == RET_OK; j++) {
+          auto begin = GetTimeUs();
+          results[i] = sessions[i]->RunGraph();
+          latency[i] += GetTimeUs() - begin;
+        }
+      });
+    }
+    for (auto &worker : workers) {
+      worker.join();
+    }
+    auto elapsed_us = GetTimeUs() - start;
+    for (int i = 0; i < session_num; i++) {
+      if (results[i] != RET_OK) {
+        MS_LOG(ERROR) << "Inference error " << results[i] << " in session " << i;
+        std::cerr << "Inference error " << results[i] << " in session " << i << std::endl;
+        return results[i];
+      }
+    }
+    uint64_t total_latency = 0;
+    for (auto session_latency : latency) {
+      total_latency += session_latency;
+    }
+    float throughput = session_num * flags_->loop_count_ * 1000000.0f / std::max<uint64_t>(elapsed_us, 1);
+    float avg_latency = total_latency / 1000.0f / (session_num * flags_->loop_count_);
+    MS_LOG(INFO) << "Model = " << model_name << ", ThreadBudget = " << runtime->thread_budget()
+                 << ", Sessions = " << session_num << ", ThreadsPerSession = " << thread_num
+                 << ", Throughput = " << throughput << ", AvgLatency = " << avg_latency;
+    printf("Model = %s, ThreadBudget = %d, Sessions = %d, ThreadsPerSession = %d, Throughput = %f infer/s, "
+           "AvgLatency = %f ms\n",
+           model_name.c_str(), runtime->thread_budget(), session_num, thread_num, throughput, avg_latency);
+  }
+  return RET_OK;
+}
+
 int Benchmark::MarkAccuracy() {
   MS_LOG(INFO) << "MarkAccuracy";
   std::cout << "MarkAccuracy" << std::endl;
@@ -519,7 +627,8 @@ int Benchmark::RunBenchmark() {
       return ret;
     }
   }
-  if (model != nullptr) {
+  // sessions of the concurrent benchmark read their weights from the model buffer
+  if (model != nullptr && flags_->concurrent_sessions_.empty()) {
     model->Free();
   }
   ms_inputs_ = session_->GetInputs();
@@ -548,6 +657,13 @@ int Benchmark::RunBenchmark() {
       std::cout << "Run MarkAccuracy error: " << status << std::endl;
       return status;
     }
+  } else if (!flags_->concurrent_sessions_.empty()) {
+    status = MarkConcurrentThroughput(model.get(), *context);
+    if (status != 0) {
+      MS_LOG(ERROR) << "Run MarkConcurrentThroughput error: " << status;
+      std::cout << "Run MarkConcurrentThroughput error: " << status << std::endl;
+      return status;
+    }
   } else {
     status = MarkPerformance();
     if (status != 0) {
@@ -572,6 +688,23 @@ void BenchmarkFlags::InitInputDataList() {
   delete[] input_list;
 }
 
+int BenchmarkFlags::InitConcurrentSessionList() {
+  auto session_num_strs = StringSplit(this->concurrent_sessions_in_, std::string(DELIM_COMMA));
+  for (const auto &session_num_str : session_num_strs) {
+    char *end = nullptr;
+    errno = 0;
+    auto session_num = strtol(session_num_str.c_str(), &end, 10);
+    if (session_num_str.empty() || end == nullptr || *end != '\0' || errno == ERANGE || session_num < 1 ||
+        session_num > INT_MAX) {
+      MS_LOG(ERROR) << "concurrentSessions: " << session_num_str << " is not a positive integer";
+      std::cerr << "concurrentSessions: " << session_num_str << " is not a positive integer" << std::endl;
+      return RET_ERROR;
+    }
+    this->concurrent_sessions_.emplace_back(static_cast<int>(session_num));
+  }
+  return RET_OK;
+}
+
 void BenchmarkFlags::InitResizeDimsList() {
   std::string content;
   content = this->resize_dims_in_;
@@ -652,6 +785,8 @@ int Benchmark::Init() {
   MS_LOG(INFO) << "NumThreads = " << this->flags_->num_threads_;
   MS_LOG(INFO) << "Fp16Priority = " << this->flags_->enable_fp16_;
   MS_LOG(INFO) << "calibDataPath = " << this->flags_->benchmark_data_file_;
+  MS_LOG(INFO) << "ProfilingFile = " << this->flags_->profiling_file_;
+  MS_LOG(INFO) << "ConcurrentSessions = " << this->flags_->concurrent_sessions_in_;
 
   if (this->flags_->loop_count_ < 1) {
     MS_LOG(ERROR) << "LoopCount:" << this->flags_->loop_count_ << " must be greater than 0";
@@ -695,6 +830,9 @@ int Benchmark::Init() {
   }
   flags_->InitInputDataList();
   flags_->InitResizeDimsList();
+  if (flags_->InitConcurrentSessionList() != RET_OK) {
+    return RET_ERROR;
+  }
   if (!flags_->resize_dims_.empty() && !flags_->input_data_list_.empty() &&
       flags_->resize_dims_.size() != flags_->input_data_list_.size()) {
     MS_LOG(ERROR) << "Size of input resizeDims should be equal to size of input inDataPath";
@@ -34,6 +34,7 @@
 #include "src/common/file_utils.h"
 #include "src/common/utils.h"
 #include "include/lite_session.h"
+#include "include/lite_runtime.h"
 
 namespace mindspore::lite {
 enum MS_API InDataType { kImage = 0, kBinary = 1 };
@@ -68,6 +69,14 @@ class MS_API BenchmarkFlags : public virtual FlagParser {
     AddFlag(&BenchmarkFlags::enable_fp16_, "enableFp16", "Enable float16", false);
     AddFlag(&BenchmarkFlags::warm_up_loop_count_, "warmUpLoopCount", "Run warm up loop", 3);
     AddFlag(&BenchmarkFlags::time_profiling_, "timeProfiling", "Run time profiling", false);
+    AddFlag(&BenchmarkFlags::profiling_file_, "profilingFile",
+            "Dump per-kernel profiling of benchmark loops to <profilingFile>.json (Chrome trace) and "
+            "<profilingFile>.csv (summary)",
+            "");
+    AddFlag(&BenchmarkFlags::concurrent_sessions_in_, "concurrentSessions",
+            "Measure throughput of sessions sharing one runtime whose thread budget is numThreads, "
+            "a comma separated list of session numbers. e.g. 1,4,16",
+            "");
     // MarkAccuracy
     AddFlag(&BenchmarkFlags::benchmark_data_file_, "benchmarkDataFile", "Benchmark data file path", "");
     AddFlag(&BenchmarkFlags::benchmark_data_type_, "benchmarkDataType",
@@ -83,6 +92,8 @@ class MS_API BenchmarkFlags : public virtual FlagParser {
 
   void InitResizeDimsList();
 
+  int InitConcurrentSessionList();
+
  public:
   // common
   std::string model_file_;
@@ -97,6 +108,9 @@ class MS_API BenchmarkFlags : public virtual FlagParser {
   bool enable_fp16_ = false;
   int warm_up_loop_count_ = 3;
   bool time_profiling_ = false;
+  std::string profiling_file_;
+  std::string concurrent_sessions_in_;
+  std::vector<int> concurrent_sessions_;
   // MarkAccuracy
   std::string benchmark_data_file_;
   std::string benchmark_data_type_ = "FLOAT";
@@ -228,6 +242,8 @@ class MS_API Benchmark {
 
   int MarkAccuracy();
 
+  int MarkConcurrentThroughput(Model *model, const Context &context);
+
  private:
   BenchmarkFlags *flags_;
   session::LiteSession *session_{nullptr};
@@ -0,0 +1,547 @@
+/**
+ * Copyright 2020 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "tools/converter/legacy_optimizer/graph/trans_format_propagate_pass.h"
+#include <algorithm>
+#include <map>
+#include "tools/common/node_util.h"
+#include "tools/common/tensor_util.h"
+#include "src/common/log_adapter.h"
+#include "src/common/common.h"
+#include "src/common/utils.h"
+#include "include/errorcode.h"
+
+namespace mindspore {
+namespace lite {
+namespace {
+constexpr int kLayoutDimNum = 4;
+constexpr int kPaddingsNum = 8;
+constexpr int kMaxPropagateRounds = 10;
+// position of every NCHW axis once the tensor is NHWC
+const int kNchwAxisInNhwc[kLayoutDimNum] = {NHWC_N, NHWC_C, NHWC_H, NHWC_W};
+const std::vector<int> kPermNchw2Nhwc = {0, 2, 3, 1};
+const std::vector<int> kPermNhwc2Nchw = {0, 3, 1, 2};
+
+const std::set<schema::PrimitiveType> kPropagatableOps = {
+  schema::PrimitiveType_Activation, schema::PrimitiveType_Abs,     schema::PrimitiveType_Exp,
+  schema::PrimitiveType_Log,        schema::PrimitiveType_Sqrt,    schema::PrimitiveType_Rsqrt,
+  schema::PrimitiveType_Square,     schema::PrimitiveType_Sin,     schema::PrimitiveType_Cos,
+  schema::PrimitiveType_Neg,        schema::PrimitiveType_Floor,   schema::PrimitiveType_Ceil,
+  schema::PrimitiveType_Round,      schema::PrimitiveType_Add,     schema::PrimitiveType_Sub,
+  schema::PrimitiveType_Mul,        schema::PrimitiveType_Div,     schema::PrimitiveType_RealDiv,
+  schema::PrimitiveType_Maximum,    schema::PrimitiveType_Minimum, schema::PrimitiveType_SquaredDifference,
+  schema::PrimitiveType_Eltwise,    schema::PrimitiveType_Power,   schema::PrimitiveType_QuantDTypeCast,
+  schema::PrimitiveType_Concat,     schema::PrimitiveType_Pad,     schema::PrimitiveType_Reduce,
+  schema::PrimitiveType_Mean};
+
+enum LayoutTransKind { kNotLayoutTrans = 0, kTransToNhwc, kTransToNchw };
+
+LayoutTransKind GetLayoutTransKind(const schema::CNodeT &node) {
+  if (node.inputIndex.size() != 1 || node.outputIndex.size() != 1) {
+    return kNotLayoutTrans;
+  }
+  auto type = GetCNodeTType(node);
+  if (type == schema::PrimitiveType_Nchw2Nhwc) {
+    return kTransToNhwc;
+  }
+  if (type == schema::PrimitiveType_Nhwc2Nchw) {
+    return kTransToNchw;
+  }
+  if (type == schema::PrimitiveType_Transpose) {
+    auto attr = node.primitive->value.AsTranspose();
+    if (attr == nullptr || attr->conjugate) {
+      return kNotLayoutTrans;
+    }
+    if (attr->perm == kPermNchw2Nhwc) {
+      return kTransToNhwc;
+    }
+    if (attr->perm == kPermNhwc2Nchw) {
+      return kTransToNchw;
+    }
+  }
+  return kNotLayoutTrans;
+}
+
+size_t CountLayoutTransNodes(const schema::MetaGraphT &graph) {
+  return std::count_if(graph.nodes.begin(), graph.nodes.end(), [](const std::unique_ptr<schema::CNodeT> &node) {
+    auto type = GetCNodeTType(*node);
+    return type == schema::PrimitiveType_Nchw2Nhwc || type == schema::PrimitiveType_Nhwc2Nchw ||
+           type == schema::PrimitiveType_Transpose;
+  });
+}
+
+bool IsValidAxis(int axis) { return axis >= -kLayoutDimNum && axis < kLayoutDimNum; }
+
+int AxisToNhwc(int axis) { return kNchwAxisInNhwc[axis < 0 ? axis + kLayoutDimNum : axis]; }
+
+std::vector<int32_t> DimsToNhwc(const std::vector<int32_t> &dims) {
+  return {dims[NCHW_N], dims[NCHW_H], dims[NCHW_W], dims[NCHW_C]};
+}
+
+bool IsAttrPropagatable(const schema::CNodeT &node) {
+  auto &value = node.primitive->value;
+  switch (value.type) {
+    case schema::PrimitiveType_Concat:
+      return value.AsConcat() != nullptr && IsValidAxis(value.AsConcat()->axis);
+    case schema::PrimitiveType_Pad:
+      // paddings given as an input tensor are not rewritten
+      return node.inputIndex.size() == 1 && value.AsPad() != nullptr &&
+             value.AsPad()->paddings.size() == kPaddingsNum;
+    case schema::PrimitiveType_Reduce: {
+      auto attr = value.AsReduce();
+      return node.inputIndex.size() == 1 && attr != nullptr && !attr->reduceToEnd &&
+             std::all_of(attr->axes.begin(), attr->axes.end(), IsValidAxis);
+    }
+    case schema::PrimitiveType_Mean: {
+      auto attr = value.AsMean();
+      return node.inputIndex.size() == 1 && attr != nullptr &&
+             std::all_of(attr->axis.begin(), attr->axis.end(), IsValidAxis);
+    }
+    default:
+      return true;
+  }
+}
+
+void ChangeAttrToNhwc(schema::CNodeT *node) {
+  MS_ASSERT(node != nullptr);
+  auto &value = node->primitive->value;
+  switch (value.type) {
+    case schema::PrimitiveType_Concat:
+      value.AsConcat()->axis = AxisToNhwc(value.AsConcat()->axis);
+      break;
+    case schema::PrimitiveType_Pad: {
+      auto &paddings = value.AsPad()->paddings;
+      std::vector<int> new_paddings(kPaddingsNum);
+      for (int i = 0; i < kLayoutDimNum; ++i) {
+        new_paddings[2 * kNchwAxisInNhwc[i]] = paddings[2 * i];
+        new_paddings[2 * kNchwAxisInNhwc[i] + 1] = paddings[2 * i + 1];
+      }
+      paddings = new_paddings;
+      break;
+    }
+    case schema::PrimitiveType_Reduce:
+      for (auto &axis : value.AsReduce()->axes) {
+        axis = AxisToNhwc(axis);
+      }
+      break;
+    case schema::PrimitiveType_Mean:
+      for (auto &axis : value.AsMean()->axis) {
+        axis = AxisToNhwc(axis);
+      }
+      break;
+    default:
+      break;
+  }
+}
+
+// const inputs broadcast against NCHW tensors, so they are padded to 4 dims from the front before being transposed
+STATUS ConstTensorToNhwc(schema::TensorT *tensor) {
+  MS_ASSERT(tensor != nullptr);
+  auto shape_size = GetShapeSize(*tensor);
+  if (shape_size <= 1) {
+    return RET_OK;
+  }
+  auto dims = tensor->dims;
+  dims.insert(dims.begin(), kLayoutDimNum - dims.size(), 1);
+  auto batch = dims[NCHW_N];
+  auto channel = dims[NCHW_C];
+  auto height = dims[NCHW_H];
+  auto width = dims[NCHW_W];
+  auto data_size = tensor->data.size() / shape_size;
+  std::vector<uint8_t> new_data(tensor->data.size());
+  for (int n = 0; n < batch; ++n) {
+    for (int c = 0; c < channel; ++c) {
+      for (int h = 0; h < height; ++h) {
+        for (int w = 0; w < width; ++w) {
+          auto src = (((n * channel + c) * height + h) * width + w) * data_size;
+          auto dst = (((n * height + h) * width + w) * channel + c) * data_size;
+          std::copy_n(tensor->data.begin() + src, data_size, new_data.begin() + dst);
+        }
+      }
+    }
+  }
+  tensor->data.swap(new_data);
+  tensor->dims = DimsToNhwc(dims);
+  tensor->format = schema::Format_NHWC;
+  return RET_OK;
+}
+
+void ReplaceInput(schema::CNodeT *node, uint32_t from, uint32_t to) {
+  std::replace(node->inputIndex.begin(), node->inputIndex.end(), from, to);
+}
+}  // namespace
+
+void TransOpPropagatePass::BuildLinks(const schema::MetaGraphT &graph) {
+  tensor_producers_.assign(graph.allTensors.size(), -1);
+  tensor_consumers_.assign(graph.allTensors.size(), {});
+  for (size_t i = 0; i < graph.nodes.size(); ++i) {
+    auto &node = graph.nodes.at(i);
+    for (auto output : node->outputIndex) {
+      tensor_producers_.at(output) = static_cast<int>(i);
+    }
+    for (auto input : node->inputIndex) {
+      auto &consumers = tensor_consumers_.at(input);
+      if (consumers.empty() || consumers.back() != i) {
+        consumers.emplace_back(i);
+      }
+    }
+  }
+  graph_inputs_ = std::set<uint32_t>(graph.inputIndex.begin(), graph.inputIndex.end());
+  graph_outputs_ = std::set<uint32_t>(graph.outputIndex.begin(), graph.outputIndex.end());
+}
+
+bool TransOpPropagatePass::IsPropagatable(const schema::MetaGraphT &graph, size_t node_idx) const {
+  auto &node = graph.nodes.at(node_idx);
+  if (node->primitive == nullptr || kPropagatableOps.find(GetCNodeTType(*node)) == kPropagatableOps.end()) {
+    return false;
+  }
+  if (node->inputIndex.empty() || node->outputIndex.size() != 1 || !IsAttrPropagatable(*node)) {
+    return false;
+  }
+  // every tensor flowing through the op has to be 4-D, only const inputs may broadcast
+  for (auto input : node->inputIndex) {
+    bool is_const = tensor_producers_.at(input) < 0 && graph_inputs_.find(input) == graph_inputs_.end();
+    if (!is_const && graph.allTensors.at(input)->dims.size() != kLayoutDimNum) {
+      return false;
+    }
+  }
+  return graph.allTensors.at(node->outputIndex.front())->dims.size() == kLayoutDimNum;
+}
+
+std::vector<std::vector<size_t>> TransOpPropagatePass::FindRegions(const schema::MetaGraphT &graph) const {
+  std::vector<size_t> parents(graph.nodes.size());
+  std::vector<bool> propagatable(graph.nodes.size());
+  for (size_t i = 0; i < graph.nodes.size(); ++i) {
+    parents[i] = i;
+    propagatable[i] = IsPropagatable(graph, i);
+  }
+  auto find_root = [&parents](size_t i) {
+    while (parents[i] != i) {
+      parents[i] = parents[parents[i]];
+      i = parents[i];
+    }
+    return i;
+  };
+  // ops sharing a non-const tensor, as producer or as consumers, have to agree on its layout
+  for (size_t tensor_idx = 0; tensor_idx < graph.allTensors.size(); ++tensor_idx) {
+    auto producer = tensor_producers_.at(tensor_idx);
+    if (producer < 0 && graph_inputs_.find(tensor_idx) == graph_inputs_.end()) {
+      continue;
+    }
+    int anchor = producer >= 0 && propagatable[producer] ? producer : -1;
+    for (auto consumer : tensor_consumers_.at(tensor_idx)) {
+      if (!propagatable[consumer]) {
+        continue;
+      }
+      if (anchor < 0) {
+        anchor = static_cast<int>(consumer);
+      } else {
+        parents[find_root(consumer)] = find_root(anchor);
+      }
+    }
+  }
+  std::map<size_t, std::vector<size_t>> regions;
+  for (size_t i = 0; i < graph.nodes.size(); ++i) {
+    if (propagatable[i]) {
+      regions[find_root(i)].emplace_back(i);
+    }
+  }
+  std::vector<std::vector<size_t>> ret;
+  for (auto &region : regions) {
+    ret.emplace_back(std::move(region.second));
+  }
+  return ret;
+}
+
+bool TransOpPropagatePass::PlanRegion(const schema::MetaGraphT &graph, const std::vector<size_t> &region,
+                                      RegionPlan *plan) const {
+  MS_ASSERT(plan != nullptr);
+  std::set<size_t> region_set(region.begin(), region.end());
+  auto all_in_region = [this, &region_set](uint32_t tensor_idx) {
+    auto &consumers = tensor_consumers_.at(tensor_idx);
+    return graph_outputs_.find(tensor_idx) == graph_outputs_.end() &&
+           std::all_of(consumers.begin(), consumers.end(), [&](size_t i) { return region_set.count(i) > 0; });
+  };
+  plan->nodes = region;
+  plan->touched_nodes = region_set;
+  std::set<uint32_t> visited_inputs;
+  for (auto node_idx : region) {
+    auto &node = graph.nodes.at(node_idx);
+    for (auto input : node->inputIndex) {
+      if (!visited_inputs.insert(input).second) {
+        continue;
+      }
+      auto producer = tensor_producers_.at(input);
+      if (producer >= 0 && region_set.count(producer) > 0) {
+        continue;
+      }
+      if (producer < 0 && graph_inputs_.find(input) == graph_inputs_.end()) {
+        auto &tensor = graph.allTensors.at(input);
+        auto shape_size = GetShapeSize(*tensor);
+        if (tensor->data.empty() || tensor->dims.size() > kLayoutDimNum || shape_size == 0 ||
+            tensor->data.size() % shape_size != 0 || !all_in_region(input)) {
+          return false;
+        }
+        plan->const_tensors.emplace_back(input);
+        continue;
+      }
+      if (producer >= 0) {
+        plan->touched_nodes.insert(producer);
+        auto &pre_node = graph.nodes.at(producer);
+        if (GetLayoutTransKind(*pre_node) == kTransToNchw) {
+          auto pre_producer = tensor_producers_.at(pre_node->inputIndex.front());
+          if (pre_producer >= 0) {
+            if (region_set.count(pre_producer) > 0) {
+              return false;
+            }
+            plan->touched_nodes.insert(pre_producer);
+          }
+          if (all_in_region(input)) {
+            plan->removed_pre_trans.emplace_back(producer);
+            plan->removed_num++;
+          } else {
+            plan->bypassed_pre_trans.emplace_back(producer);
+          }
+          continue;
+        }
+      }
+      plan->split_inputs.emplace_back(input);
+      plan->inserted_num++;
+    }
+    auto output = node->outputIndex.front();
+    bool need_split = graph_outputs_.find(output) != graph_outputs_.end();
+    for (auto consumer : tensor_consumers_.at(output)) {
+      if (region_set.count(consumer) > 0) {
+        continue;
+      }
+      plan->touched_nodes.insert(consumer);
+      auto &post_node = graph.nodes.at(consumer);
+      if (GetLayoutTransKind(*post_node) != kTransToNhwc) {
+        need_split = true;
+        continue;
+      }
+      auto &post_consumers = tensor_consumers_.at(post_node->outputIndex.front());
+      if (std::any_of(post_consumers.begin(), post_consumers.end(),
+                      [&region_set](size_t i) { return region_set.count(i) > 0; })) {
+        return false;
+      }
+      plan->touched_nodes.insert(post_consumers.begin(), post_consumers.end());
+      plan->removed_post_trans.emplace_back(consumer, output);
+      plan->removed_num++;
+    }
+    if (need_split) {
+      plan->split_outputs.emplace_back(output);
+      plan->inserted_num++;
+    } else {
+      plan->inner_tensors.emplace_back(output);
+    }
+  }
+  return true;
+}
+
+std::unique_ptr<schema::CNodeT> TransOpPropagatePass::NewTransNode(const std::string &name, bool to_nhwc,
+                                                                   uint32_t input, uint32_t output) {
+  auto trans_node = std::make_unique<schema::CNodeT>();
+  trans_node->primitive = std::make_unique<schema::PrimitiveT>();
+  if (to_nhwc) {
+    trans_node->name = "nchw2nhwc_" + name + "_propagate" + std::to_string(id_++);
+    trans_node->primitive->value.type = schema::PrimitiveType_Nchw2Nhwc;
+  } else {
+    trans_node->name = "nhwc2nchw_" + name + "_propagate" + std::to_string(id_++);
+    trans_node->primitive->value.type = schema::PrimitiveType_Nhwc2Nchw;
+  }
+  trans_node->inputIndex = {input};
+  trans_node->outputIndex = {output};
+  return trans_node;
+}
+
+STATUS TransOpPropagatePass::ApplyPlan(schema::MetaGraphT *graph, const RegionPlan &plan) {
+  MS_ASSERT(graph != nullptr);
+  auto replace_in_region = [graph, &plan](uint32_t from, uint32_t to) {
+    for (auto node_idx : plan.nodes) {
+      ReplaceInput(graph->nodes.at(node_idx).get(), from, to);
+    }
+  };
+  auto add_nhwc_tensor = [graph](uint32_t origin) {
+    auto tensor = CopyTensorDefT(graph->allTensors.at(origin));
+    if (tensor == nullptr) {
+      return -1;
+    }
+    tensor->dims = DimsToNhwc(tensor->dims);
+    tensor->format = schema::Format_NHWC;
+    tensor->nodeType = schema::NodeType_Parameter;
+    graph->allTensors.emplace_back(std::move(tensor));
+    return static_cast<int>(graph->allTensors.size() - 1);
+  };
+  auto &region_node = graph->nodes.at(plan.nodes.front());
+  auto quant_type = region_node->quantType;
+  for (auto node_idx : plan.nodes) {
+    ChangeAttrToNhwc(graph->nodes.at(node_idx).get());
+  }
+  for (auto tensor_idx : plan.const_tensors) {
+    auto status = ConstTensorToNhwc(graph->allTensors.at(tensor_idx).get());
+    if (status != RET_OK) {
+      MS_LOG(ERROR) << "Transpose const tensor " << tensor_idx << " to nhwc failed";
+      return status;
+    }
+  }
+  for (auto tensor_idx : plan.inner_tensors) {
+    auto &tensor = graph->allTensors.at(tensor_idx);
+    tensor->dims = DimsToNhwc(tensor->dims);
+    tensor->format = schema::Format_NHWC;
+  }
+  for (auto node_idx : plan.removed_pre_trans) {
+    auto &pre_node = graph->nodes.at(node_idx);
+    replace_in_region(pre_node->outputIndex.front(), pre_node->inputIndex.front());
+    dead_tensors_.insert(pre_node->outputIndex.front());
+    pre_node->inputIndex.clear();
+    pre_node->outputIndex.clear();
+  }
+  for (auto node_idx : plan.bypassed_pre_trans) {
+    auto &pre_node = graph->nodes.at(node_idx);
+    replace_in_region(pre_node->outputIndex.front(), pre_node->inputIndex.front());
+  }
+  for (auto tensor_idx : plan.split_inputs) {
+    auto new_tensor_idx = add_nhwc_tensor(tensor_idx);
+    if (new_tensor_idx < 0) {
+      MS_LOG(ERROR) << "Copy TensorT failed";
+      return RET_NULL_PTR;
+    }
+    replace_in_region(tensor_idx, new_tensor_idx);
+    auto trans_node = NewTransNode(region_node->name + "_pre", true, tensor_idx, new_tensor_idx);
+    trans_node->quantType = quant_type;
+    new_nodes_.emplace_back(std::move(trans_node));
+  }
+  std::map<uint32_t, uint32_t> split_outputs;
+  for (auto tensor_idx : plan.split_outputs) {
+    auto new_tensor_idx = add_nhwc_tensor(tensor_idx);
+    if (new_tensor_idx < 0) {
+      MS_LOG(ERROR) << "Copy TensorT failed";
+      return RET_NULL_PTR;
+    }
+    auto &producer = graph->nodes.at(tensor_producers_.at(tensor_idx));
+    producer->outputIndex = {static_cast<uint32_t>(new_tensor_idx)};
+    replace_in_region(tensor_idx, new_tensor_idx);
+    auto trans_node = NewTransNode(producer->name + "_post", false, new_tensor_idx, tensor_idx);
+    trans_node->quantType = quant_type;
+    new_nodes_.emplace_back(std::move(trans_node));
+    split_outputs[tensor_idx] = new_tensor_idx;
+  }
+  for (auto &post_trans : plan.removed_post_trans) {
+    auto &post_node = graph->nodes.at(post_trans.first);
+    auto source = split_outputs.count(post_trans.second) > 0 ? split_outputs[post_trans.second] : post_trans.second;
+    auto output = post_node->outputIndex.front();
+    for (auto consumer : tensor_consumers_.at(output)) {
+      ReplaceInput(graph->nodes.at(consumer).get(), output, source);
+    }
+    std::replace(graph->outputIndex.begin(), graph->outputIndex.end(), output, source);
+    dead_tensors_.insert(output);
+    post_node->inputIndex.clear();
+    post_node->outputIndex.clear();
+  }
+  return RET_OK;
+}
+
+STATUS TransOpPropagatePass::RemoveDeadNodes(schema::MetaGraphT *graph) {
+  MS_ASSERT(graph != nullptr);
+  for (auto &node : new_nodes_) {
+    graph->nodes.emplace_back(std::move(node));
+  }
+  new_nodes_.clear();
+  graph->nodes.erase(std::remove_if(graph->nodes.begin(), graph->nodes.end(),
+                                    [](const std::unique_ptr<schema::CNodeT> &node) {
+                                      return node->inputIndex.empty() && node->outputIndex.empty();
+                                    }),
+                     graph->nodes.end());
+  if (dead_tensors_.empty()) {
+    return RET_OK;
+  }
+  // compact all tensor indexes in one sweep instead of removing the dead tensors one by one
+  std::vector<int> new_indexes(graph->allTensors.size(), -1);
+  std::vector<std::unique_ptr<schema::TensorT>> tensors;
+  for (size_t i = 0; i < graph->allTensors.size(); ++i) {
+    if (dead_tensors_.find(i) == dead_tensors_.end()) {
+      new_indexes[i] = static_cast<int>(tensors.size());
+      tensors.emplace_back(std::move(graph->allTensors[i]));
+    }
+  }
+  dead_tensors_.clear();
+  auto remap = [&new_indexes](std::vector<uint32_t> *indexes) {
+    for (auto &index : *indexes) {
+      if (new_indexes.at(index) < 0) {
+        MS_LOG(ERROR) << "tensor " << index << " is removed but still used";
+        return RET_ERROR;
+      }
+      index = static_cast<uint32_t>(new_indexes.at(index));
+    }
+    return RET_OK;
+  };
+  for (auto &node : graph->nodes) {
+    if (remap(&node->inputIndex) != RET_OK || remap(&node->outputIndex) != RET_OK) {
+      MS_LOG(ERROR) << "Remap tensor indexes of node " << node->name << " failed";
+      return RET_ERROR;
+    }
+  }
+  if (remap(&graph->inputIndex) != RET_OK || remap(&graph->outputIndex) != RET_OK) {
+    MS_LOG(ERROR) << "Remap graph input or output indexes failed";
+    return RET_ERROR;
+  }
+  graph->allTensors.swap(tensors);
+  return RET_OK;
+}
+
+STATUS TransOpPropagatePass::Run(schema::MetaGraphT *graph) {
+  MS_ASSERT(graph != nullptr);
+  auto origin_trans_num = CountLayoutTransNodes(*graph);
+  int rewritten_regions = 0;
+  for (int round = 0; round < kMaxPropagateRounds; ++round) {
+    BuildLinks(*graph);
+    std::set<size_t> touched_nodes;
+    bool changed = false;
+    for (auto &region : FindRegions(*graph)) {
+      RegionPlan plan;
+      if (!PlanRegion(*graph, region, &plan) || plan.removed_num <= plan.inserted_num) {
+        continue;
+      }
+      // regions sharing a border transpose are left to the next round, which sees the rewritten graph
+      if (std::any_of(plan.touched_nodes.begin(), plan.touched_nodes.end(),
+                      [&touched_nodes](size_t i) { return touched_nodes.count(i) > 0; })) {
+        continue;
+      }
+      touched_nodes.insert(plan.touched_nodes.begin(), plan.touched_nodes.end());
+      auto status = ApplyPlan(graph, plan);
+      if (status != RET_OK) {
+        MS_LOG(ERROR) << "Propagate transposes through " << graph->nodes.at(region.front())->name << " failed";
+        return status;
+      }
+      changed = true;
+      rewritten_regions++;
+    }
+    auto status = RemoveDeadNodes(graph);
+    if (status != RET_OK) {
+      MS_LOG(ERROR) << "RemoveDeadNodes failed";
+      return status;
+    }
+    if (!changed) {
+      break;
+    }
+  }
+  MS_LOG(INFO) << "Layout propagation rewrote " << rewritten_regions
+               << " regions, transpose nodes: " << origin_trans_num << " -> " << CountLayoutTransNodes(*graph);
+  return rewritten_regions == 0 ? RET_NO_CHANGE : RET_OK;
+}
+}  // namespace lite
+}  // namespace mindspore
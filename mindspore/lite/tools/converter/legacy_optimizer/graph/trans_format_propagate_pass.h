@@ -0,0 +1,83 @@
+/**
+ * Copyright 2020 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef MINDSPORE_PREDICT_TRANS_FORMAT_PROPAGATE_PASS_H
+#define MINDSPORE_PREDICT_TRANS_FORMAT_PROPAGATE_PASS_H
+
+#include <memory>
+#include <set>
+#include <string>
+#include <utility>
+#include <vector>
+#include "tools/common/graph_util.h"
+#include "tools/converter/optimizer.h"
+
+namespace mindspore {
+namespace lite {
+// TransOpPropagatePass moves layout transposes across whole regions of layout agnostic ops (elementwise, concat, pad,
+// reduce). A region is a connected group of such ops, it is rewritten to compute in NHWC when that removes more
+// Nhwc2Nchw/Nchw2Nhwc/Transpose nodes on its border than it has to insert, so transposes meeting from both sides of
+// the region cancel out instead of being fused one pair at a time.
+class TransOpPropagatePass : public GraphPass {
+ public:
+  TransOpPropagatePass() = default;
+
+  ~TransOpPropagatePass() override = default;
+
+  STATUS Run(schema::MetaGraphT *graph) override;
+
+ private:
+  struct RegionPlan {
+    std::vector<size_t> nodes;
+    // boundary transposes which disappear, their input tensor replaces their output tensor
+    std::vector<size_t> removed_pre_trans;
+    std::vector<std::pair<size_t, uint32_t>> removed_post_trans;
+    // boundary transposes which are kept for consumers outside of the region, the region reads their input instead
+    std::vector<size_t> bypassed_pre_trans;
+    std::vector<uint32_t> const_tensors;
+    std::vector<uint32_t> inner_tensors;
+    std::vector<uint32_t> split_inputs;
+    std::vector<uint32_t> split_outputs;
+    std::set<size_t> touched_nodes;
+    int removed_num = 0;
+    int inserted_num = 0;
+  };
+
+  void BuildLinks(const schema::MetaGraphT &graph);
+
+  bool IsPropagatable(const schema::MetaGraphT &graph, size_t node_idx) const;
+
+  std::vector<std::vector<size_t>> FindRegions(const schema::MetaGraphT &graph) const;
+
+  bool PlanRegion(const schema::MetaGraphT &graph, const std::vector<size_t> &region, RegionPlan *plan) const;
+
+  STATUS ApplyPlan(schema::MetaGraphT *graph, const RegionPlan &plan);
+
+  std::unique_ptr<schema::CNodeT> NewTransNode(const std::string &name, bool to_nhwc, uint32_t input, uint32_t output);
+
+  STATUS RemoveDeadNodes(schema::MetaGraphT *graph);
+
+  std::vector<int> tensor_producers_;
+  std::vector<std::vector<size_t>> tensor_consumers_;
+  std::set<uint32_t> graph_inputs_;
+  std::set<uint32_t> graph_outputs_;
+  std::set<uint32_t> dead_tensors_;
+  std::vector<std::unique_ptr<schema::CNodeT>> new_nodes_;
+  size_t id_ = 0;
+};
+}  // namespace lite
+}  // namespace mindspore
+#endif  // MINDSPORE_PREDICT_TRANS_FORMAT_PROPAGATE_PASS_H
@@ -125,8 +125,8 @@ kernel::LiteKernel *GetLiteKernel(std::vector<Tensor *> inputs, const std::vecto
   return nullptr;
 }
 
-lite::STATUS ReplaceCNode(const FuncGraphPtr &func_graph, const CNodePtr &any_node, const AnfNodePtr &input_node,
-                          std::vector<Tensor *> output_tensors, size_t replace_index) {
+lite::STATUS ReplaceCNode(const FuncGraphPtr &func_graph, const AnfNodePtr &input_node,
+                          const std::vector<Tensor *> &output_tensors) {
   MS_ASSERT(func_graph != nullptr);
   auto manager = func_graph->manager();
   MS_ASSERT(manager != nullptr);
@@ -178,107 +178,129 @@ void FreeTensors(std::vector<Tensor *> *input_tensor, std::vector<Tensor *> *out
   }
 }
 
-const AnfNodePtr ConstFoldPass::Process(const FuncGraphPtr &func_graph, const AnfNodePtr &node,
-                                        const EquivPtr &) const {
-  if (CheckIfFuncGraphIsNull(func_graph) != lite::RET_OK || CheckIfAnfNodeIsNull(node) != lite::RET_OK ||
-      !node->isa<CNode>()) {
-    return nullptr;
+lite::STATUS ConstFoldPass::FoldNode(const FuncGraphPtr &func_graph, const CNodePtr &input_cnode) const {
+  auto input_tensors = GetCNodeInputTensors(input_cnode);
+  if (input_tensors.empty() || input_tensors.size() != input_cnode->inputs().size() - 1) {
+    FreeTensors(&input_tensors, nullptr);
+    return lite::RET_NO_CHANGE;
   }
-  auto any_node = node->cast<CNodePtr>();
-  if (CheckIfCNodeIsNull(any_node) != lite::RET_OK) {
-    return nullptr;
+  auto output_nums = GetOutputTensorNum(input_cnode);
+  std::vector<Tensor *> output_tensors;
+  for (size_t j = 0; j < output_nums; j++) {
+    output_tensors.push_back(new (std::nothrow) Tensor());
   }
-  bool changed = false;
-  for (size_t i = 1; i < any_node->inputs().size(); i++) {
-    auto input_node = any_node->input(i);
-    if (!input_node->isa<CNode>() || !CheckIsAllInputsParam(input_node)) {
-      continue;
-    }
-    auto input_cnode = input_node->cast<CNodePtr>();
-    auto input_tensors = GetCNodeInputTensors(input_cnode);
-    if (input_tensors.empty() || input_tensors.size() != input_cnode->inputs().size() - 1) {
-      FreeTensors(&input_tensors, nullptr);
-      continue;
-    }
-    changed = true;
-    auto output_nums = GetOutputTensorNum(input_cnode);
-    std::vector<Tensor *> output_tensors;
-    for (size_t j = 0; j < output_nums; j++) {
-      output_tensors.push_back(new (std::nothrow) Tensor());
-    }
-    auto lite_primitive = GetValueNode<std::shared_ptr<PrimitiveC>>(input_cnode->input(0));
-    if (lite_primitive == nullptr) {
-      MS_LOG(ERROR) << "lite_primitive is nullptr";
-      FreeTensors(&input_tensors, &output_tensors);
-      return nullptr;
-    }
-    auto inputQuantParams = lite_primitive->input_quant_params();
-    for (size_t m = 0; m < inputQuantParams.size(); m++) {
-      for (auto inputQuantParam : inputQuantParams[m]) {
-        lite::QuantArg quant_arg{};
-        quant_arg.scale = inputQuantParam.scale;
-        quant_arg.zeroPoint = inputQuantParam.zeroPoint;
-        input_tensors[m]->AddQuantParam(quant_arg);
-      }
-    }
-    auto outputQuantParams = lite_primitive->output_quant_params();
-    for (size_t m = 0; m < outputQuantParams.size(); m++) {
-      for (auto outputQuantParam : outputQuantParams[m]) {
-        lite::QuantArg quant_arg{};
-        quant_arg.scale = outputQuantParam.scale;
-        quant_arg.zeroPoint = outputQuantParam.zeroPoint;
-        output_tensors[m]->AddQuantParam(quant_arg);
-      }
+  auto lite_primitive = GetValueNode<std::shared_ptr<PrimitiveC>>(input_cnode->input(0));
+  if (lite_primitive == nullptr) {
+    MS_LOG(ERROR) << "lite_primitive is nullptr";
+    FreeTensors(&input_tensors, &output_tensors);
+    return lite::RET_ERROR;
+  }
+  auto inputQuantParams = lite_primitive->input_quant_params();
+  for (size_t m = 0; m < inputQuantParams.size(); m++) {
+    for (auto inputQuantParam : inputQuantParams[m]) {
+      lite::QuantArg quant_arg{};
+      quant_arg.scale = inputQuantParam.scale;
+      quant_arg.zeroPoint = inputQuantParam.zeroPoint;
+      input_tensors[m]->AddQuantParam(quant_arg);
     }
-    lite_primitive->InferShape(input_tensors, output_tensors);
-    auto primitive = lite_primitive.get();
-    MS_ASSERT(primitive != nullptr);
-    MS_ASSERT(primitive->Type() != nullptr);
-    auto func_pointer =
-      lite::PopulateRegistry::GetInstance()->GetParameterCreator(schema::PrimitiveType(primitive->Type()));
-    if (func_pointer == nullptr) {
-      MS_LOG(ERROR) << "ParameterCreator function pointer is nullptr, type: "
-                    << schema::EnumNamePrimitiveType((schema::PrimitiveType)primitive->Type());
-      return nullptr;
+  }
+  auto outputQuantParams = lite_primitive->output_quant_params();
+  for (size_t m = 0; m < outputQuantParams.size(); m++) {
+    for (auto outputQuantParam : outputQuantParams[m]) {
+      lite::QuantArg quant_arg{};
+      quant_arg.scale = outputQuantParam.scale;
+      quant_arg.zeroPoint = outputQuantParam.zeroPoint;
+      output_tensors[m]->AddQuantParam(quant_arg);
     }
-    auto parameter = func_pointer(primitive);
+  }
+  lite_primitive->InferShape(input_tensors, output_tensors);
+  auto primitive = lite_primitive.get();
+  MS_ASSERT(primitive != nullptr);
+  MS_ASSERT(primitive->Type() != nullptr);
+  auto func_pointer =
+    lite::PopulateRegistry::GetInstance()->GetParameterCreator(schema::PrimitiveType(primitive->Type()));
+  if (func_pointer == nullptr) {
+    MS_LOG(ERROR) << "ParameterCreator function pointer is nullptr, type: "
+                  << schema::EnumNamePrimitiveType((schema::PrimitiveType)primitive->Type());
+    FreeTensors(&input_tensors, &output_tensors);
+    return lite::RET_ERROR;
+  }
+  auto parameter = func_pointer(primitive);
 
-    if (parameter == nullptr) {
-      MS_LOG(ERROR) << "PopulateParameter return nullptr, type: "
-                    << schema::EnumNamePrimitiveType((schema::PrimitiveType)(lite_primitive->Type()));
-      return nullptr;
-    }
-    auto lite_kernel = GetLiteKernel(input_tensors, output_tensors, parameter, context.get(), lite_primitive.get());
-    if (lite_kernel == nullptr) {
-      MS_LOG(ERROR) << "constant_folding schedule node lite kernel nullptr";
-      FreeTensors(&input_tensors, &output_tensors);
-      return nullptr;
-    }
-    for (auto output_tensor : output_tensors) {
-      auto ret = output_tensor->MallocData();
-      if (RET_OK != ret) {
-        MS_LOG(ERROR) << "MallocData failed";
-        FreeTensors(&input_tensors, &output_tensors);
-        return nullptr;
-      }
-    }
-    auto ret = lite_kernel->Run();
-    if (0 != ret) {
-      FreeTensors(&input_tensors, &output_tensors);
-      MS_LOG(ERROR) << "run kernel failed, name: " << lite_kernel->name();
-      return nullptr;
-    }
-    // replace cnode by new param
-    if (ReplaceCNode(func_graph, any_node, input_node, output_tensors, i) != lite::RET_OK) {
+  if (parameter == nullptr) {
+    MS_LOG(ERROR) << "PopulateParameter return nullptr, type: "
+                  << schema::EnumNamePrimitiveType((schema::PrimitiveType)(lite_primitive->Type()));
+    FreeTensors(&input_tensors, &output_tensors);
+    return lite::RET_ERROR;
+  }
+  auto lite_kernel = GetLiteKernel(input_tensors, output_tensors, parameter, context.get(), lite_primitive.get());
+  if (lite_kernel == nullptr) {
+    MS_LOG(ERROR) << "constant_folding schedule node lite kernel nullptr";
+    FreeTensors(&input_tensors, &output_tensors);
+    return lite::RET_ERROR;
+  }
+  // results only live until they are copied into the new parameter, the pooled allocator of the shared context
+  // hands the same buffers to the next folded node
+  auto allocator = context == nullptr ? nullptr : context->allocator.get();
+  for (auto output_tensor : output_tensors) {
+    auto ret = output_tensor->MallocData(allocator);
+    if (RET_OK != ret) {
+      MS_LOG(ERROR) << "MallocData failed";
       FreeTensors(&input_tensors, &output_tensors);
       delete (lite_kernel);
-      MS_LOG(ERROR) << "constant_folding replace cnode failed";
-      return nullptr;
+      return lite::RET_ERROR;
     }
-    MS_LOG(DEBUG) << "fold node:" << input_node->fullname_with_scope() << " success ";
+  }
+  auto ret = lite_kernel->Run();
+  if (0 != ret) {
+    FreeTensors(&input_tensors, &output_tensors);
+    MS_LOG(ERROR) << "run kernel failed, name: " << lite_kernel->name();
+    delete (lite_kernel);
+    return lite::RET_ERROR;
+  }
+  // replace cnode by new param
+  if (ReplaceCNode(func_graph, input_cnode, output_tensors) != lite::RET_OK) {
     FreeTensors(&input_tensors, &output_tensors);
     delete (lite_kernel);
+    MS_LOG(ERROR) << "constant_folding replace cnode failed";
+    return lite::RET_ERROR;
+  }
+  MS_LOG(DEBUG) << "fold node:" << input_cnode->fullname_with_scope() << " success ";
+  FreeTensors(&input_tensors, &output_tensors);
+  delete (lite_kernel);
+  return lite::RET_OK;
+}
+
+bool ConstFoldPass::Run(const FuncGraphPtr &func_graph) {
+  if (CheckIfFuncGraphIsNull(func_graph) != lite::RET_OK) {
+    return false;
+  }
+  auto manager = func_graph->manager();
+  if (manager == nullptr) {
+    MS_LOG(ERROR) << "manager of func_graph is nullptr";
+    return false;
+  }
+  // subgraphs of control flow are folded as well, with the new parameters added to the top graph
+  auto graphs = manager->func_graphs();
+  size_t folded_num = 0;
+  for (auto &graph : graphs) {
+    // consumers come after their producers, by the time a node is visited every constant input chain in front of it
+    // has already been replaced by a parameter
+    auto node_list = TopoSort(graph->get_return());
+    for (auto &node : node_list) {
+      if (!utils::isa<CNodePtr>(node) || node == graph->get_return() || !CheckIsAllInputsParam(node)) {
+        continue;
+      }
+      auto cnode = node->cast<CNodePtr>();
+      if (CheckIfCNodeIsNull(cnode) != lite::RET_OK) {
+        return false;
+      }
+      if (FoldNode(func_graph, cnode) == lite::RET_OK) {
+        folded_num++;
+      }
+    }
   }
-  return changed ? any_node : nullptr;
+  MS_LOG(INFO) << "constant folding folded " << folded_num << " nodes";
+  return folded_num > 0;
 }
 }  // namespace mindspore::opt
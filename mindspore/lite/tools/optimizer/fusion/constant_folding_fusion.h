@@ -23,18 +23,24 @@
 #include "src/tensor.h"
 #include "src/lite_kernel.h"
 #include "nnacl/op_base.h"
-#include "backend/optimizer/common/optimizer.h"
+#include "backend/optimizer/common/pass.h"
+#include "src/inner_context.h"
 
 namespace mindspore {
 namespace opt {
-class ConstFoldPass : public PatternProcessPass {
+// ConstFoldPass evaluates every node whose inputs are all constant with the lite cpu kernels and replaces it by a
+// parameter holding the result. Nodes are visited once in topological order, so a chain of constant nodes is folded
+// in a single sweep, and all kernels run on the one context given to the pass.
+class ConstFoldPass : public Pass {
  public:
-  explicit ConstFoldPass(std::shared_ptr<lite::InnerContext> context_ptr = nullptr, bool multigraph = true)
-      : PatternProcessPass("constfold_pass", multigraph), context(std::move(context_ptr)) {}
+  explicit ConstFoldPass(std::shared_ptr<lite::InnerContext> context_ptr = nullptr)
+      : Pass("constfold_pass"), context(std::move(context_ptr)) {}
   ~ConstFoldPass() override = default;
-  const AnfNodePtr Process(const FuncGraphPtr &, const AnfNodePtr &, const EquivPtr &) const override;
+  bool Run(const FuncGraphPtr &func_graph) override;
 
  private:
+  lite::STATUS FoldNode(const FuncGraphPtr &func_graph, const CNodePtr &cnode) const;
+
   std::shared_ptr<lite::InnerContext> context;
 };
 }  // namespace opt
@@ -978,6 +978,26 @@ class Cell(Cell_):
         self.add_flags_recursive(**flags)
         return self
 
+    def recompute(self, mode=True):
+        """
+        Set the primitives of the cell and its child cells to be computed again in the backward pass.
+
+        The forward activations inside the cell are not kept until the backward pass, only the inputs of the cell
+        are, and the cell is computed again from them in the backward pass. It saves the memory of the activations
+        at the cost of computing the cell twice.
+
+        Note:
+            It is valid only in GRAPH_MODE. The primitives with random or side effects are not computed again.
+
+        Args:
+            mode (bool): Whether to compute the cell again. Default: True.
+        """
+        for _, cell in self.cells_and_names():
+            for value in cell.__dict__.values():
+                if isinstance(value, Primitive):
+                    value.recompute(mode)
+        return self
+
     def set_grad(self, requires_grad=True):
         """
         Sets the cell flag for gradient.
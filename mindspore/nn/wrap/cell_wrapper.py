@@ -22,6 +22,8 @@ from ...ops import composite as C
 from ...ops import functional as F
 from ...ops import operations as P
 from ...ops.operations.comm_ops import _VirtualDataset
+from ...ops.primitive import constexpr
+from ..layer.container import CellList
 from ..cell import Cell
 from .grad_reducer import DistributedGradReducer
 
@@ -343,6 +345,91 @@ class VirtualDatasetCellTriple(Cell):
         return self._backbone(a_, b_, c_)
 
 
+@constexpr
+def _get_micro_slice(input_shape, micro_size, micro):
+    """Get the begin, end and strides slicing the micro-th micro batch along the first dimension."""
+    if not input_shape or input_shape[0] % micro_size != 0:
+        raise ValueError(f"The batch size of the input shape {input_shape} must be divisible by the "
+                         f"micro_size {micro_size}.")
+    micro_batch_size = input_shape[0] // micro_size
+    begin = (micro * micro_batch_size,) + (0,) * (len(input_shape) - 1)
+    end = ((micro + 1) * micro_batch_size,) + tuple(input_shape[1:])
+    strides = (1,) * len(input_shape)
+    return begin, end, strides
+
+
+class _MicroBatch(Cell):
+    """
+    Slice the micro batch from each input along the first dimension.
+
+    The slices are marked by the `micro` attribute, which tells the pipeline split the micro batch of the nodes.
+    """
+
+    def __init__(self, micro_size, micro):
+        super(_MicroBatch, self).__init__()
+        self.micro_size = micro_size
+        self.micro = micro
+        self.strided_slice = P.StridedSlice().add_prim_attr("micro", micro)
+
+    def construct(self, *inputs):
+        micro_inputs = ()
+        for each_input in inputs:
+            begin, end, strides = _get_micro_slice(F.shape(each_input), self.micro_size, self.micro)
+            micro_inputs += (self.strided_slice(each_input, begin, end, strides),)
+        return micro_inputs
+
+
+class PipelineCell(Cell):
+    r"""
+    Split the inputs into micro batches and sum the outputs of the network on them.
+
+    With pipeline parallel, the stages run on different micro batches at the same time, so that a stage does not
+    wait for the whole batch of the previous stage. The gradients of the parameters are accumulated over the micro
+    batches.
+
+    Note:
+        The batch size of each input must be divisible by `micro_size`.
+
+    Args:
+        network (Cell): The network with loss function, whose output is a scalar loss.
+        micro_size (int): The number of the micro batches.
+
+    Inputs:
+        - **(*inputs)** (Tuple(Tensor)) - Tuple of input tensors with shape :math:`(N, \ldots)`.
+
+    Outputs:
+        Tensor, the sum of the outputs of the micro batches.
+
+    Supported Platforms:
+        ``Ascend`` ``GPU``
+
+    Examples:
+        >>> net = Net()
+        >>> loss_fn = nn.SoftmaxCrossEntropyWithLogits(sparse=True, reduction='mean')
+        >>> net_with_loss = nn.PipelineCell(nn.WithLossCell(net, loss_fn), 4)
+    """
+
+    def __init__(self, network, micro_size):
+        super(PipelineCell, self).__init__(auto_prefix=False)
+        if not isinstance(micro_size, int) or isinstance(micro_size, bool) or micro_size <= 0:
+            raise ValueError(f"The micro_size must be a positive int, but got {micro_size}.")
+        self.network = network
+        self.micro_size = micro_size
+        self.micro_inputs = CellList([_MicroBatch(micro_size, micro) for micro in range(micro_size)])
+        self.add = P.TensorAdd()
+
+    def construct(self, *inputs):
+        ret = None
+        for micro in range(self.micro_size):
+            micro_inputs = self.micro_inputs[micro](*inputs)
+            output = self.network(*micro_inputs)
+            if ret is None:
+                ret = output
+            else:
+                ret = self.add(ret, output)
+        return ret
+
+
 class WithEvalCell(Cell):
     r"""
     Cell that returns loss, output and label for evaluation.
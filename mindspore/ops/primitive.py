@@ -116,6 +116,24 @@ class Primitive(Primitive_):
         self.add_prim_attr("stage", stage)
         return self
 
+    def recompute(self, mode=True):
+        """
+        Set the primitive to be computed again in the backward pass.
+
+        The output of the primitive is not kept from the forward pass until the backward pass uses it, the primitive
+        is computed again from its inputs in the backward pass instead.
+
+        Note:
+            It is valid only in GRAPH_MODE. The primitives with random or side effects are not computed again.
+
+        Args:
+            mode (bool): Whether to compute the primitive again. Default: True.
+        """
+        if not isinstance(mode, bool):
+            raise TypeError(f"The mode of recompute should be bool, but got {type(mode)}.")
+        self.add_prim_attr("recompute", mode)
+        return self
+
     def shard(self, strategy):
         """
         Add strategies to primitive attribute.
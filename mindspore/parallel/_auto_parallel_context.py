@@ -424,6 +424,26 @@ class _AutoParallelContext:
         self.check_context_handle()
         return self._context_handle.get_enable_all_reduce_fusion()
 
+    def set_all_reduce_fusion_profile_steps(self, steps):
+        """
+        Set the steps profiling the backward time to split the fused allreduce of gradients.
+
+        Args:
+            steps (int): The number of the first steps profiled. 0 means the fusion is not profiled.
+
+        Raises:
+            ValueError: If steps is negative.
+        """
+        self.check_context_handle()
+        if steps < 0:
+            raise ValueError("all_reduce_fusion_profile_steps must be non-negative, but got {}".format(steps))
+        self._context_handle.set_all_reduce_fusion_profile_steps(steps)
+
+    def get_all_reduce_fusion_profile_steps(self):
+        """Get the steps profiling the backward time to split the fused allreduce of gradients."""
+        self.check_context_handle()
+        return self._context_handle.get_all_reduce_fusion_profile_steps()
+
     def get_device_num_is_set(self):
         """Get device number is set or not."""
         self.check_context_handle()
@@ -487,7 +507,8 @@ _set_auto_parallel_context_func_map = {
     "strategy_ckpt_save_file": auto_parallel_context().set_strategy_ckpt_save_file,
     "full_batch": auto_parallel_context().set_full_batch,
     "enable_parallel_optimizer": auto_parallel_context().set_enable_parallel_optimizer,
-    "all_reduce_fusion_config": auto_parallel_context().set_all_reduce_fusion_split_indices}
+    "all_reduce_fusion_config": auto_parallel_context().set_all_reduce_fusion_split_indices,
+    "all_reduce_fusion_profile_steps": auto_parallel_context().set_all_reduce_fusion_profile_steps}
 
 
 _get_auto_parallel_context_func_map = {
@@ -504,14 +525,15 @@ _get_auto_parallel_context_func_map = {
     "strategy_ckpt_save_file": auto_parallel_context().get_strategy_ckpt_save_file,
     "full_batch": auto_parallel_context().get_full_batch,
     "enable_parallel_optimizer": auto_parallel_context().get_enable_parallel_optimizer,
-    "all_reduce_fusion_config": auto_parallel_context().get_all_reduce_fusion_split_indices}
+    "all_reduce_fusion_config": auto_parallel_context().get_all_reduce_fusion_split_indices,
+    "all_reduce_fusion_profile_steps": auto_parallel_context().get_all_reduce_fusion_profile_steps}
 
 
 @args_type_check(device_num=int, global_rank=int, gradients_mean=bool, gradient_fp32_sync=bool,
                  loss_repeated_mean=bool, parallel_mode=str, auto_parallel_search_mode=str,
                  parameter_broadcast=bool, strategy_ckpt_load_file=str,
                  strategy_ckpt_save_file=str, full_batch=bool, enable_parallel_optimizer=bool,
-                 all_reduce_fusion_config=list)
+                 all_reduce_fusion_config=list, all_reduce_fusion_profile_steps=int)
 
 def _set_auto_parallel_context(**kwargs):
     """
@@ -555,6 +577,8 @@ def _set_auto_parallel_context(**kwargs):
         full_batch (bool): Whether to load the whole batch on each device. Default: False.
         enable_parallel_optimizer (bool): Enable using optimizer segmentation or not. Default: False.
         all_reduce_fusion_config (list): Set allreduce fusion strategy by parameters indices.
+        all_reduce_fusion_profile_steps (int): The number of the first steps profiling the backward time to split
+                        the fused allreduce of gradients. 0 means the fusion is not profiled. Default: 0.
         pipeline_stages (int): Set the stage information for pipeline parallel. This indicates how
                         the devices are distributed alone the pipeline. The total devices will be divided into
                         'pipeline_stags' stages. This currently could only be used when
@@ -603,5 +627,6 @@ def _reset_auto_parallel_context():
     - enable_parallel_optimizer: False
     - auto_parallel_search_mode: dynamic_programming
     - pipeline_stages: 0
+    - all_reduce_fusion_profile_steps: 0
     """
     auto_parallel_context().reset()
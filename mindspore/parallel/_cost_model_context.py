@@ -114,6 +114,34 @@ class _CostModelContext:
             raise ValueError("Context handle is none in context!!!")
         return self._context_handle.get_costmodel_beta()
 
+    def set_costmodel_calibration_file(self, calibration_file):
+        """
+        Set the calibration file of the cost model, which records the time per byte of the computation costs of each
+        operator type and of the communication costs. Loading it sets the computation scales of the operator types and
+        costmodel_beta.
+
+        Args:
+            calibration_file (str): The path of the file written by `calibrate_cost_model` in
+                mindspore.parallel.cost_model_calibration, an empty string clears the calibration.
+
+        Raises:
+            ValueError: If context handle is none.
+        """
+        if self._context_handle is None:
+            raise ValueError("Context handle is none in context!!!")
+        self._context_handle.set_costmodel_calibration_file(calibration_file)
+
+    def get_costmodel_calibration_file(self):
+        """
+        Get the calibration file of the cost model.
+
+        Raises:
+            ValueError: If context handle is none.
+        """
+        if self._context_handle is None:
+            raise ValueError("Context handle is none in context!!!")
+        return self._context_handle.get_costmodel_calibration_file()
+
     def set_costmodel_gamma(self, gamma):
         """
         Set costmodel gamma.
@@ -501,6 +529,7 @@ set_cost_model_context_func_map = {
     "costmodel_alpha": cost_model_context().set_costmodel_alpha,
     "costmodel_beta": cost_model_context().set_costmodel_beta,
     "costmodel_gamma": cost_model_context().set_costmodel_gamma,
+    "costmodel_calibration_file": cost_model_context().set_costmodel_calibration_file,
     "costmodel_communi_threshold": cost_model_context().set_costmodel_communi_threshold,
     "costmodel_communi_const": cost_model_context().set_costmodel_communi_const,
     "costmodel_communi_bias": cost_model_context().set_costmodel_communi_bias,
@@ -522,6 +551,7 @@ get_cost_model_context_func_map = {
     "costmodel_alpha": cost_model_context().get_costmodel_alpha,
     "costmodel_beta": cost_model_context().get_costmodel_beta,
     "costmodel_gamma": cost_model_context().get_costmodel_gamma,
+    "costmodel_calibration_file": cost_model_context().get_costmodel_calibration_file,
     "costmodel_communi_threshold": cost_model_context().get_costmodel_communi_threshold,
     "costmodel_communi_const": cost_model_context().get_costmodel_communi_const,
     "costmodel_communi_bias": cost_model_context().get_costmodel_communi_bias,
@@ -539,6 +569,7 @@ get_cost_model_context_func_map = {
 
 
 @args_type_check(device_memory_capacity=float, costmodel_alpha=float, costmodel_beta=float, costmodel_gamma=float,
+                 costmodel_calibration_file=str,
                  costmodel_communi_threshold=float, costmodel_communi_const=float, costmodel_communi_bias=float,
                  multi_subgraphs=bool, run_phase=int,
                  costmodel_allreduce_fusion_algorithm=int, costmodel_allreduce_fusion_times=int,
@@ -558,6 +589,10 @@ def set_cost_model_context(**kwargs):
         costmodel_alpha (float): The parameter costmodel_alpha used in strategy-searching algorithm.
         costmodel_beta (float): The parameter costmodel_beta used in strategy-searching algorithm.
         costmodel_gamma (float): The parameter costmodel_gamma used in strategy-searching algorithm.
+        costmodel_calibration_file (str): The file fitted by `calibrate_cost_model` in
+            mindspore.parallel.cost_model_calibration on the devices running the network. It scales the computation
+            costs of each operator type by its measured time per byte, and sets costmodel_beta to the measured time
+            per byte of communication relative to the computation.
         costmodel_communi_threshold (float): A parameter used in adjusting communication calculation for practice.
         costmodel_communi_const (float): A parameter used in adjusting communication calculation for practice.
         costmodel_communi_bias (float): A parameter used in adjusting communication calculation for practice.
@@ -0,0 +1,215 @@
+# Copyright 2020 Huawei Technologies Co., Ltd
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+# http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+# ============================================================================
+"""Calibration of the cost model used in the strategy-searching of auto_parallel"""
+import csv
+import json
+import time
+
+import numpy as np
+
+import mindspore.nn as nn
+from mindspore import Tensor
+from mindspore.ops import operations as P
+from mindspore._checkparam import Validator
+
+__all__ = ["calibrate_cost_model"]
+
+# the collectives whose recorded times are fitted into the communication coefficient
+_COMMUNICATION_OPS = ("communication", "AllReduce", "AllGather", "ReduceScatter", "AllToAll")
+
+# the sizes of the benchmarked tensors, the calibration uses the time per byte of the large ones
+_BENCHMARK_SIZES = (256, 512, 1024, 2048)
+
+
+class _UnaryCell(nn.Cell):
+    def __init__(self, op):
+        super(_UnaryCell, self).__init__()
+        self.op = op
+
+    def construct(self, x):
+        return self.op(x)
+
+
+class _BinaryCell(nn.Cell):
+    def __init__(self, op):
+        super(_BinaryCell, self).__init__()
+        self.op = op
+
+    def construct(self, x, y):
+        return self.op(x, y)
+
+
+def _float_tensor(*shape):
+    return Tensor(np.random.randn(*shape).astype(np.float32))
+
+
+# Each benchmark builds the cell and inputs of the operator for a size, with the bytes of the forward computation cost
+# of the operator in the cost model, e.g. the bytes of both inputs for MatMul, and only the output for Softmax.
+def _matmul_benchmark(size):
+    return _BinaryCell(P.MatMul()), (_float_tensor(size, size), _float_tensor(size, size)), 2 * size * size * 4
+
+
+def _batch_matmul_benchmark(size):
+    batch = 8
+    inputs = (_float_tensor(batch, size // 4, size), _float_tensor(batch, size, size // 4))
+    return _BinaryCell(P.BatchMatMul()), inputs, 2 * batch * size * size // 4 * 4
+
+
+def _unary_benchmark(op):
+    def benchmark(size):
+        return _UnaryCell(op), (_float_tensor(size, size),), size * size * 4
+    return benchmark
+
+
+def _binary_benchmark(op):
+    def benchmark(size):
+        return _BinaryCell(op), (_float_tensor(size, size), _float_tensor(size, size)), 2 * size * size * 4
+    return benchmark
+
+
+_COMPUTATION_BENCHMARKS = {
+    "MatMul": _matmul_benchmark,
+    "BatchMatMul": _batch_matmul_benchmark,
+    "ReLU": _unary_benchmark(P.ReLU()),
+    "Gelu": _unary_benchmark(P.Gelu()),
+    "Tanh": _unary_benchmark(P.Tanh()),
+    "Softmax": _unary_benchmark(P.Softmax()),
+    "TensorAdd": _binary_benchmark(P.TensorAdd()),
+    "Mul": _binary_benchmark(P.Mul()),
+}
+
+
+def _time_cell_us(cell, inputs, repeat):
+    """Average time of running the cell, after the warm up runs which compile the cell."""
+    for _ in range(3):
+        out = cell(*inputs)
+    out.asnumpy()
+    start = time.perf_counter()
+    for _ in range(repeat):
+        out = cell(*inputs)
+    out.asnumpy()
+    return (time.perf_counter() - start) / repeat * 1e6
+
+
+def _benchmark_computation(op_types, repeat):
+    samples = {}
+    for op_type in op_types:
+        if op_type not in _COMPUTATION_BENCHMARKS:
+            raise ValueError("There is no benchmark for the operator {}, the benchmarked operators are {}."
+                             .format(op_type, list(_COMPUTATION_BENCHMARKS)))
+        for size in _BENCHMARK_SIZES:
+            cell, inputs, cost_bytes = _COMPUTATION_BENCHMARKS[op_type](size)
+            samples.setdefault(op_type, []).append((cost_bytes, _time_cell_us(cell, inputs, repeat)))
+    return samples
+
+
+def _benchmark_communication(repeat):
+    """Time AllReduce over the devices, whose communication cost in the cost model is the bytes of the tensor."""
+    from mindspore.communication.management import get_group_size
+    try:
+        device_num = get_group_size()
+    except (RuntimeError, ValueError):
+        return []
+    if device_num <= 1:
+        return []
+    samples = []
+    for size in _BENCHMARK_SIZES:
+        cell = _UnaryCell(P.AllReduce())
+        samples.append((size * size * 4, _time_cell_us(cell, (_float_tensor(size, size),), repeat)))
+    return samples
+
+
+def _load_profile(profile_file):
+    """
+    Read the samples recorded in a csv file, with the columns 'op_type', 'bytes' and 'time_us' in each row. The
+    'bytes' is the cost of the operator in the cost model, and the times of the collectives are the communication.
+    """
+    computation = {}
+    communication = []
+    with open(profile_file, newline='') as f:
+        for row in csv.DictReader(f):
+            sample = (float(row["bytes"]), float(row["time_us"]))
+            if row["op_type"] in _COMMUNICATION_OPS:
+                communication.append(sample)
+            else:
+                computation.setdefault(row["op_type"], []).append(sample)
+    return computation, communication
+
+
+def _fit_time_per_byte(samples):
+    """
+    Fit the time of the samples as 'launch + coefficient * bytes' and return the coefficient, as the cost model has no
+    constant term. The fitting goes through the origin if the samples have a single size or the slope is not positive.
+    """
+    cost_bytes = np.array([sample[0] for sample in samples], dtype=np.float64)
+    times = np.array([sample[1] for sample in samples], dtype=np.float64)
+    if np.unique(cost_bytes).size > 1:
+        slope = np.polyfit(cost_bytes, times, 1)[0]
+        if slope > 0:
+            return float(slope)
+    coefficient = float(np.dot(cost_bytes, times) / np.dot(cost_bytes, cost_bytes))
+    if coefficient <= 0:
+        raise ValueError("The fitted time per byte should be positive, but got {}.".format(coefficient))
+    return coefficient
+
+
+def calibrate_cost_model(calibration_file, profile_file=None, op_types=None, repeat=20):
+    """
+    Fit the time per byte of the operators and of the communication on the devices running the network, and write
+    them into the calibration file for `costmodel_calibration_file` of the cost model context.
+
+    The costs of the operators in the cost model are bytes of the tensors they compute, so the strategy-searching
+    assumes the same time per byte for all operators and a fixed ratio to the communication. The calibrated cost model
+    weights the computation costs of each operator type by its fitted time per byte, and the communication costs by
+    the fitted time per byte of the collectives.
+
+    Note:
+        The operators are benchmarked in the current context, which should be set as in training. The communication
+        is benchmarked only if the communication has been initialized with more than one device.
+
+    Args:
+        calibration_file (str): The path of the written calibration file.
+        profile_file (str): The csv file recording the times of operators instead of benchmarking them, with the
+            columns 'op_type', 'bytes' and 'time_us', where 'bytes' is the cost of the operator in the cost model,
+            and the collectives, e.g. 'AllReduce', are fitted into the communication. Default: None.
+        op_types (list[str]): The benchmarked operator types. Default: None, all the operators having a benchmark,
+            which are MatMul, BatchMatMul, ReLU, Gelu, Tanh, Softmax, TensorAdd and Mul.
+        repeat (int): The number of runs timed for each benchmark. Default: 20.
+
+    Returns:
+        dict, the time per byte in microsecond of the computation of each operator type, and of the communication if
+        it is fitted.
+
+    Examples:
+        >>> calibrate_cost_model("./cost_model_calibration.json")
+        >>> set_cost_model_context(costmodel_calibration_file="./cost_model_calibration.json")
+    """
+    Validator.check_value_type("calibration_file", calibration_file, [str])
+    Validator.check_positive_int(repeat, "repeat")
+    if profile_file is not None:
+        computation_samples, communication_samples = _load_profile(profile_file)
+    else:
+        computation_samples = _benchmark_computation(op_types or list(_COMPUTATION_BENCHMARKS), repeat)
+        communication_samples = _benchmark_communication(repeat)
+    if not computation_samples:
+        raise ValueError("There is no sample of the computation to calibrate the cost model.")
+
+    calibration = {"computation": {op_type: _fit_time_per_byte(samples)
+                                   for op_type, samples in sorted(computation_samples.items())}}
+    if communication_samples:
+        calibration["communication"] = _fit_time_per_byte(communication_samples)
+    with open(calibration_file, "w") as f:
+        json.dump(calibration, f, indent=4)
+    return calibration
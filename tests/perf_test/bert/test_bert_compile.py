@@ -0,0 +1,62 @@
+# Copyright 2020 Huawei Technologies Co., Ltd
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+# http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+# ============================================================================
+
+"""Compile time and peak memory of the frontend compilation of bert training."""
+
+# pylint: disable=missing-docstring
+
+import os
+import resource
+import time
+
+from mindspore.nn.optim import AdamWeightDecay
+from model_zoo.official.nlp.bert.src import BertNetworkWithLoss, BertTrainOneStepCell
+from .test_bert_train import BertLearningRate, get_config, load_test_data
+from ...ops_common import nn, build_construct_graph
+
+
+def peak_rss_mb():
+    # ru_maxrss is in kilobytes on linux
+    return resource.getrusage(resource.RUSAGE_SELF).ru_maxrss / 1024
+
+
+def test_bert_compile_time_and_memory():
+    class ModelBert(nn.Cell):
+        def __init__(self, network, optimizer=None):
+            super(ModelBert, self).__init__()
+            self.optimizer = optimizer
+            self.train_network = BertTrainOneStepCell(network, self.optimizer)
+            self.train_network.set_train()
+
+        def construct(self, arg0, arg1, arg2, arg3, arg4, arg5, arg6):
+            return self.train_network(arg0, arg1, arg2, arg3, arg4, arg5, arg6)
+
+    version = os.getenv('VERSION', 'large')
+    batch_size = int(os.getenv('BATCH_SIZE', '1'))
+    inputs = load_test_data(batch_size)
+
+    config = get_config(version=version)
+    netwithloss = BertNetworkWithLoss(config, True)
+    lr = BertLearningRate(10)
+    optimizer = AdamWeightDecay(netwithloss.trainable_params(), lr)
+    net = ModelBert(netwithloss, optimizer=optimizer)
+    net.set_train()
+
+    rss_before = peak_rss_mb()
+    start = time.perf_counter()
+    build_construct_graph(net, *inputs, execute=False)
+    compile_time = time.perf_counter() - start
+    print("bert {}: compile {:.2f} s, peak rss {:.1f} MB, {:.1f} MB more than before compiling".format(
+        version, compile_time, peak_rss_mb(), peak_rss_mb() - rss_before))
@@ -0,0 +1,110 @@
+# Copyright 2020 Huawei Technologies Co., Ltd
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+# http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+# ============================================================================
+
+"""
+Step time of data parallel training with the gradients allreduced in one fused bucket, and in the segments split by
+the profiled backward time.
+
+The ranks are launched by mpirun on GPU. The split indices profiled on a network are used when the network is compiled
+again, so the profiled network is trained after the profile steps of another instance of it.
+"""
+
+import os
+import re
+import subprocess
+import sys
+import time
+
+import numpy as np
+import pytest
+
+import mindspore.nn as nn
+from mindspore import Tensor
+from mindspore import context
+from mindspore.communication.management import init, get_group_size
+from mindspore.context import ParallelMode
+from mindspore.nn import TrainOneStepCell, WithLossCell
+
+device_num = int(os.environ.get("DEVICE_NUM", "8"))
+profile_steps = 5
+warmup_steps = 3
+run_steps = 20
+batch_size = 32
+hidden = 2048
+layer_num = 12
+
+
+class DenseStack(nn.Cell):
+    """Dense layers of the same size, whose gradients are produced one by one in backward."""
+
+    def __init__(self):
+        super(DenseStack, self).__init__()
+        self.layers = nn.SequentialCell([nn.Dense(hidden, hidden, activation='relu') for _ in range(layer_num)])
+        self.classifier = nn.Dense(hidden, 2)
+
+    def construct(self, x):
+        return self.classifier(self.layers(x))
+
+
+def build_train_net():
+    net = DenseStack()
+    loss = nn.SoftmaxCrossEntropyWithLogits(sparse=True, reduction='mean')
+    opt = nn.Momentum(net.trainable_params(), 0.01, 0.9)
+    train_net = TrainOneStepCell(WithLossCell(net, loss), opt)
+    train_net.set_train()
+    return train_net
+
+
+def train(mode):
+    """Train the network of the rank, print the step time."""
+    context.set_context(mode=context.GRAPH_MODE, device_target="GPU")
+    init("nccl")
+    context.set_auto_parallel_context(parallel_mode=ParallelMode.DATA_PARALLEL, gradients_mean=True,
+                                      device_num=get_group_size())
+    np.random.seed(1)
+    data = Tensor(np.random.randn(batch_size, hidden).astype(np.float32))
+    label = Tensor(np.random.randint(0, 2, batch_size).astype(np.int32))
+    if mode == "profiled":
+        context.set_auto_parallel_context(all_reduce_fusion_profile_steps=profile_steps)
+        profile_net = build_train_net()
+        for _ in range(profile_steps):
+            profile_net(data, label)
+    train_net = build_train_net()
+    for _ in range(warmup_steps):
+        train_net(data, label)
+    start = time.perf_counter()
+    for _ in range(run_steps):
+        out = train_net(data, label)
+    out.asnumpy()
+    print("step_time_ms {:.3f}".format((time.perf_counter() - start) / run_steps * 1e3))
+
+
+def run_ranks(mode):
+    result = subprocess.run(["mpirun", "-n", str(device_num), sys.executable, __file__, mode], stdout=subprocess.PIPE,
+                            universal_newlines=True, check=True)
+    return max(float(step_time) for step_time in re.findall(r"step_time_ms ([\d.]+)", result.stdout))
+
+
+@pytest.mark.skipif(os.environ.get("DEVICE_TARGET", "CPU") != "GPU", reason="the ranks run on GPU")
+def test_allreduce_fusion_profile():
+    """Report the step time of the slowest rank, with one fused bucket and with the profiled split."""
+    fused_time = run_ranks("fused")
+    profiled_time = run_ranks("profiled")
+    print("fused: step_time_ms {:.3f}, profiled: step_time_ms {:.3f}, speedup {:.2f}".format(
+        fused_time, profiled_time, fused_time / profiled_time))
+
+
+if __name__ == "__main__":
+    train(sys.argv[1])
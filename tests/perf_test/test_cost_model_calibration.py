@@ -0,0 +1,149 @@
+# Copyright 2020 Huawei Technologies Co., Ltd
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+# http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+# ============================================================================
+
+"""
+Strategies and step time of auto_parallel with the cost model calibrated on the host.
+
+The operators are benchmarked on the host to write the calibration file, then the reference network is compiled with
+the default and the calibrated cost model, each in its own process, to compare:
+- the strategies of the operators searched by the DP algorithm;
+- the step time, when the communication is initialized, e.g. launched on RANK_SIZE devices.
+"""
+
+import json
+import os
+import subprocess
+import sys
+import tempfile
+import time
+
+import numpy as np
+import pytest
+
+import mindspore.nn as nn
+from mindspore import Tensor
+from mindspore import context
+from mindspore.common.api import _executor
+from mindspore.context import ParallelMode
+from mindspore.nn import TrainOneStepCell, WithLossCell
+from mindspore.ops import operations as P
+from mindspore.parallel import _cost_model_context as cost_model_context
+from mindspore.parallel.cost_model_calibration import calibrate_cost_model
+
+warmup_steps = 3
+run_steps = 20
+batch_size = 256
+hidden = 1024
+layer_num = 4
+
+
+class _MatMulCell(nn.Cell):
+    def __init__(self, in_channels, out_channels):
+        super(_MatMulCell, self).__init__()
+        self.weight = nn.Dense(in_channels, out_channels, has_bias=False).weight
+        self.matmul = P.MatMul(transpose_b=True)
+
+    def construct(self, x):
+        return self.matmul(x, self.weight)
+
+
+class FeedForwardStack(nn.Cell):
+    """Feed forward blocks of a transformer encoder, with a softmax classifier."""
+
+    def __init__(self):
+        super(FeedForwardStack, self).__init__()
+        self.matmuls1 = nn.CellList([_MatMulCell(hidden, hidden * 4) for _ in range(layer_num)])
+        self.matmuls2 = nn.CellList([_MatMulCell(hidden * 4, hidden) for _ in range(layer_num)])
+        self.gelu = P.Gelu()
+        self.add = P.TensorAdd()
+        self.classifier = _MatMulCell(hidden, 16)
+        self.softmax = P.Softmax()
+
+    def construct(self, x):
+        for i in range(layer_num):
+            x = self.add(x, self.matmuls2[i](self.gelu(self.matmuls1[i](x))))
+        return self.softmax(self.classifier(x))
+
+
+def train(device_target, calibration_file):
+    """Search the strategies in the current process, print them and the step time if the network is trained."""
+    context.set_context(mode=context.GRAPH_MODE, device_target=device_target)
+    device_num = int(os.environ.get("RANK_SIZE", "8"))
+    distributed = device_num > 1 and "RANK_ID" in os.environ
+    if distributed:
+        from mindspore.communication.management import init
+        init()
+    context.set_auto_parallel_context(parallel_mode=ParallelMode.AUTO_PARALLEL, device_num=device_num,
+                                      global_rank=int(os.environ.get("RANK_ID", "0")))
+    if calibration_file:
+        cost_model_context.set_cost_model_context(costmodel_calibration_file=calibration_file)
+    np.random.seed(1)
+    net = FeedForwardStack()
+    loss = nn.SoftmaxCrossEntropyWithLogits(sparse=True, reduction='mean')
+    opt = nn.Momentum(net.trainable_params(), 0.01, 0.9)
+    train_net = TrainOneStepCell(WithLossCell(net, loss), opt)
+    train_net.set_auto_parallel()
+    train_net.set_train()
+    data = Tensor(np.random.randn(batch_size, hidden).astype(np.float32))
+    label = Tensor(np.random.randint(0, 16, batch_size).astype(np.int32))
+    if not distributed:
+        _executor.compile(train_net, data, label, phase='train')
+    else:
+        for _ in range(warmup_steps):
+            train_net(data, label)
+        start = time.perf_counter()
+        for _ in range(run_steps):
+            out = train_net(data, label)
+        out.asnumpy()
+        print("step_time_ms {:.3f}".format((time.perf_counter() - start) / run_steps * 1e3))
+    strategies = {name: strategy for (name, strategy) in _executor._get_shard_strategy(train_net).items()
+                  if "MatMul" in name or "Gelu" in name or "Softmax" in name}
+    print("strategies {}".format(json.dumps(strategies, sort_keys=True)))
+
+
+def run_in_process(device_target, calibration_file):
+    result = subprocess.run([sys.executable, __file__, device_target, calibration_file], stdout=subprocess.PIPE,
+                            stderr=subprocess.PIPE, universal_newlines=True, check=True)
+    strategies, step_time = None, None
+    for line in result.stdout.splitlines():
+        if line.startswith("strategies "):
+            strategies = json.loads(line[len("strategies "):])
+        elif line.startswith("step_time_ms "):
+            step_time = float(line[len("step_time_ms "):])
+    return strategies, step_time
+
+
+@pytest.mark.parametrize('device_target', [os.environ.get("DEVICE_TARGET", "CPU")])
+def test_cost_model_calibration(device_target):
+    """Report the coefficients fitted on the host, and the strategies and step time they change."""
+    context.set_context(mode=context.GRAPH_MODE, device_target=device_target)
+    calibration_file = os.path.join(tempfile.mkdtemp(), "cost_model_calibration.json")
+    calibration = calibrate_cost_model(calibration_file, op_types=["MatMul", "Gelu", "Softmax", "TensorAdd"])
+    print("calibration: {}".format(calibration))
+
+    default_strategies, default_step_time = run_in_process(device_target, "")
+    calibrated_strategies, calibrated_step_time = run_in_process(device_target, calibration_file)
+    changed = sorted(name for name in default_strategies
+                     if default_strategies[name] != calibrated_strategies.get(name))
+    print("strategies changed by the calibration: {} of {}".format(len(changed), len(default_strategies)))
+    for name in changed:
+        print("{}: {} -> {}".format(name, default_strategies[name], calibrated_strategies.get(name)))
+    print("step_time_ms: default {}, calibrated {}".format(
+        "n/a" if default_step_time is None else default_step_time,
+        "n/a" if calibrated_step_time is None else calibrated_step_time))
+
+
+if __name__ == "__main__":
+    train(sys.argv[1], sys.argv[2])
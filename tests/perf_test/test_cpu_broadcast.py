@@ -0,0 +1,70 @@
+# Copyright 2020 Huawei Technologies Co., Ltd
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+# http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+# ============================================================================
+
+"""Memory bandwidth reached by the CPU elementwise kernels with broadcast inputs."""
+
+import time
+
+import numpy as np
+import pytest
+
+import mindspore.nn as nn
+from mindspore import Tensor
+from mindspore import context
+from mindspore.ops import operations as P
+
+context.set_context(mode=context.GRAPH_MODE, device_target="CPU")
+
+warmup_steps = 5
+run_steps = 50
+
+
+class BinaryNet(nn.Cell):
+    def __init__(self, op):
+        super(BinaryNet, self).__init__()
+        self.op = op
+
+    def construct(self, x, y):
+        return self.op(x, y)
+
+
+def bandwidth(op, x_shape, y_shape):
+    net = BinaryNet(op)
+    x = Tensor(np.random.randn(*x_shape).astype(np.float32))
+    y = Tensor(np.random.randn(*y_shape).astype(np.float32))
+    out = net(x, y)
+    for _ in range(warmup_steps):
+        net(x, y)
+    start = time.perf_counter()
+    for _ in range(run_steps):
+        net(x, y)
+    step_time = (time.perf_counter() - start) / run_steps
+    out_bytes = out.asnumpy().nbytes
+    moved_bytes = x.asnumpy().nbytes + y.asnumpy().nbytes + out_bytes
+    return step_time, moved_bytes / step_time / 1e9
+
+
+@pytest.mark.parametrize('op_name', ['Sub', 'RealDiv', 'Maximum', 'Equal'])
+@pytest.mark.parametrize('x_shape, y_shape', [
+    ((1024, 1024), (1024, 1024)),
+    ((1024, 1024), (1,)),
+    ((1024, 1024), (1024,)),
+    ((1024, 1024), (1024, 1)),
+    ((16, 1, 64, 1024), (32, 1, 1024)),
+])
+def test_broadcast_bandwidth(op_name, x_shape, y_shape):
+    """Report the step time and the bytes read and written per second of a broadcast op."""
+    step_time, gbps = bandwidth(getattr(P, op_name)(), x_shape, y_shape)
+    print("{} {} and {}: {:.3f} ms, {:.2f} GB/s".format(op_name, x_shape, y_shape, step_time * 1e3, gbps))
@@ -0,0 +1,124 @@
+# Copyright 2020 Huawei Technologies Co., Ltd
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+# http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+# ============================================================================
+
+"""Step time of CPU training with and without the fusion of the CPU session."""
+
+import time
+
+import numpy as np
+import pytest
+
+from lenet import LeNet5
+import mindspore.nn as nn
+from mindspore import Tensor
+from mindspore import context
+from mindspore.nn import TrainOneStepCell, WithLossCell
+from mindspore.ops import operations as P
+
+context.set_context(mode=context.GRAPH_MODE, device_target="CPU")
+
+warmup_steps = 3
+run_steps = 20
+
+
+class ResidualNet(nn.Cell):
+    """Small resnet of convolutions with bias, each followed by a relu."""
+
+    def __init__(self, channel=16, block_num=4, num_class=10):
+        super(ResidualNet, self).__init__()
+        self.stem = nn.Conv2d(3, channel, 3, has_bias=True, pad_mode='same')
+        self.convs1 = nn.CellList([nn.Conv2d(channel, channel, 3, has_bias=True, pad_mode='same')
+                                   for _ in range(block_num)])
+        self.convs2 = nn.CellList([nn.Conv2d(channel, channel, 3, has_bias=True, pad_mode='same')
+                                   for _ in range(block_num)])
+        self.relu = nn.ReLU()
+        self.pool = nn.MaxPool2d(kernel_size=2, stride=2)
+        self.flatten = nn.Flatten()
+        self.fc = nn.Dense(channel * 16 * 16, num_class)
+        self.block_num = block_num
+
+    def construct(self, x):
+        x = self.relu(self.stem(x))
+        for i in range(self.block_num):
+            y = self.relu(self.convs1[i](x))
+            y = self.convs2[i](y)
+            x = self.relu(x + y)
+        x = self.pool(x)
+        return self.fc(self.flatten(x))
+
+
+class EncoderFFN(nn.Cell):
+    """The feed forward layers of a BERT-small sized encoder, with the residual adds and the scaling."""
+
+    def __init__(self, hidden=256, layer_num=4, num_class=2):
+        super(EncoderFFN, self).__init__()
+        self.intermediate = nn.CellList([nn.Dense(hidden, hidden * 4, activation='relu') for _ in range(layer_num)])
+        self.output = nn.CellList([nn.Dense(hidden * 4, hidden) for _ in range(layer_num)])
+        self.classifier = nn.Dense(hidden, num_class)
+        self.mul = P.Mul()
+        self.scale = Tensor(np.array([0.5], np.float32))
+        self.layer_num = layer_num
+
+    def construct(self, x):
+        for i in range(self.layer_num):
+            y = self.output[i](self.intermediate[i](x))
+            x = self.mul(x + y, self.scale)
+        return self.classifier(x)
+
+
+def lenet():
+    net = LeNet5()
+    opt = nn.Momentum(net.trainable_params(), 0.01, 0.9)
+    return net, opt, (32, 1, 32, 32), 10
+
+
+def resnet():
+    net = ResidualNet()
+    opt = nn.Momentum(net.trainable_params(), 0.01, 0.9)
+    return net, opt, (32, 3, 32, 32), 10
+
+
+def bert_small():
+    net = EncoderFFN()
+    opt = nn.AdamWeightDecay(net.trainable_params(), 1e-4, weight_decay=0.01)
+    return net, opt, (128, 256), 2
+
+
+def train_step_time(make_net, enable_fusion):
+    context.set_context(enable_cpu_fusion=enable_fusion)
+    np.random.seed(1)
+    net, opt, data_shape, num_class = make_net()
+    loss = nn.SoftmaxCrossEntropyWithLogits(sparse=True, reduction='mean')
+    train_net = TrainOneStepCell(WithLossCell(net, loss), opt)
+    train_net.set_train()
+    data = Tensor(np.random.randn(*data_shape).astype(np.float32))
+    label = Tensor(np.random.randint(0, num_class, data_shape[0]).astype(np.int32))
+    for _ in range(warmup_steps):
+        train_net(data, label)
+    start = time.perf_counter()
+    for _ in range(run_steps):
+        out = train_net(data, label)
+    out.asnumpy()
+    return (time.perf_counter() - start) / run_steps
+
+
+@pytest.mark.parametrize('make_net', [lenet, resnet, bert_small])
+def test_cpu_fusion_step_time(make_net):
+    """Report the training step time of a network without and with the CPU fusion."""
+    unfused = train_step_time(make_net, False)
+    fused = train_step_time(make_net, True)
+    context.set_context(enable_cpu_fusion=True)
+    print("{}: unfused {:.3f} ms, fused {:.3f} ms, delta {:+.1f}%".format(
+        make_net.__name__, unfused * 1e3, fused * 1e3, (fused - unfused) / unfused * 100))
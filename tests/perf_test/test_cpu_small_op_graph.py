@@ -0,0 +1,69 @@
+# Copyright 2020 Huawei Technologies Co., Ltd
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+# http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+# ============================================================================
+
+"""Step time of graphs made of many small CPU kernels, where the launch overhead dominates."""
+
+import time
+
+import numpy as np
+import pytest
+
+import mindspore.nn as nn
+from mindspore import Tensor
+from mindspore import context
+from mindspore.ops import operations as P
+
+context.set_context(mode=context.GRAPH_MODE, device_target="CPU")
+
+warmup_steps = 10
+run_steps = 1000
+
+
+class SmallOpNet(nn.Cell):
+    """A chain of elementwise ops on a tiny tensor."""
+
+    def __init__(self, depth):
+        super(SmallOpNet, self).__init__()
+        self.depth = depth
+        self.add = P.TensorAdd()
+        self.mul = P.Mul()
+        self.relu = P.ReLU()
+
+    def construct(self, x, y):
+        out = x
+        for _ in range(self.depth):
+            out = self.relu(self.mul(self.add(out, y), y))
+        return out
+
+
+def run_steps_time(net, x, y):
+    for _ in range(warmup_steps):
+        net(x, y)
+    start = time.perf_counter()
+    for _ in range(run_steps):
+        net(x, y)
+    return (time.perf_counter() - start) / run_steps
+
+
+@pytest.mark.parametrize('depth', [1, 8, 32])
+def test_small_op_graph_step_time(depth):
+    """Report the step time and the time per kernel of a small op graph."""
+    net = SmallOpNet(depth)
+    x = Tensor(np.random.randn(2, 4).astype(np.float32))
+    y = Tensor(np.random.randn(2, 4).astype(np.float32))
+    step_time = run_steps_time(net, x, y)
+    kernel_num = depth * 3
+    print("depth {}: {:.2f} us per step, {:.2f} us per kernel".format(depth, step_time * 1e6,
+                                                                     step_time * 1e6 / kernel_num))
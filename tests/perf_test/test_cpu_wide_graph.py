@@ -0,0 +1,87 @@
+# Copyright 2020 Huawei Technologies Co., Ltd
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+# http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+# ============================================================================
+
+"""Speedup of the inter-op parallel executor on a graph of independent towers on CPU."""
+
+import time
+
+import numpy as np
+
+import mindspore.nn as nn
+from mindspore import Tensor
+from mindspore import context
+from mindspore.ops import operations as P
+
+context.set_context(mode=context.GRAPH_MODE, device_target="CPU")
+
+tower_num = 8
+tower_depth = 4
+hidden_size = 256
+batch_size = 64
+warmup_steps = 5
+run_steps = 50
+
+
+class Tower(nn.Cell):
+    """A stack of dense layers."""
+
+    def __init__(self):
+        super(Tower, self).__init__()
+        self.layers = nn.SequentialCell([nn.Dense(hidden_size, hidden_size, activation='relu')
+                                         for _ in range(tower_depth)])
+
+    def construct(self, x):
+        return self.layers(x)
+
+
+class WideNet(nn.Cell):
+    """Independent towers reading the same input, summed at the end."""
+
+    def __init__(self):
+        super(WideNet, self).__init__()
+        self.towers = nn.CellList([Tower() for _ in range(tower_num)])
+        self.add_n = P.AddN()
+
+    def construct(self, x):
+        outs = ()
+        for tower in self.towers:
+            outs = outs + (tower(x),)
+        return self.add_n(outs)
+
+
+def run_steps_time(net, x):
+    for _ in range(warmup_steps):
+        net(x)
+    start = time.perf_counter()
+    for _ in range(run_steps):
+        net(x)
+    return (time.perf_counter() - start) / run_steps
+
+
+def test_wide_graph_speedup():
+    """Compare the step time of sequential and inter-op parallel execution."""
+    x = Tensor(np.random.randn(batch_size, hidden_size).astype(np.float32))
+    net = WideNet()
+    context.set_context(cpu_inter_op_parallel_num=1)
+    sequential_time = run_steps_time(net, x)
+    expect = net(x).asnumpy()
+    context.set_context(cpu_inter_op_parallel_num=4)
+    parallel_time = run_steps_time(net, x)
+    output = net(x).asnumpy()
+    context.set_context(cpu_inter_op_parallel_num=1)
+    assert np.allclose(output, expect)
+    print("sequential {:.3f} ms, parallel {:.3f} ms, speedup {:.2f}".format(sequential_time * 1e3,
+                                                                          parallel_time * 1e3,
+                                                                          sequential_time / parallel_time))
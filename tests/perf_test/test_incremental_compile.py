@@ -0,0 +1,80 @@
+# Copyright 2020 Huawei Technologies Co., Ltd
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+# http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+# ============================================================================
+
+"""Compile time of a training network fed with variable batch sizes and sequence lengths."""
+
+import time
+
+import numpy as np
+import pytest
+
+import mindspore.nn as nn
+from mindspore import Tensor
+from mindspore import context
+from mindspore._c_expression import get_incremental_compile_metrics
+from mindspore.nn.optim import Momentum
+from mindspore.ops import operations as P
+
+context.set_context(mode=context.GRAPH_MODE, device_target="CPU")
+
+hidden_size = 64
+layer_num = 8
+
+
+class SequenceNet(nn.Cell):
+    """A stack of dense layers applied to every position of a sequence."""
+
+    def __init__(self):
+        super(SequenceNet, self).__init__()
+        self.layers = nn.CellList([nn.Dense(hidden_size, hidden_size, activation='relu') for _ in range(layer_num)])
+        self.reshape = P.Reshape()
+        self.shape = P.Shape()
+        self.reduce_mean = P.ReduceMean()
+
+    def construct(self, x):
+        batch, seq_len, hidden = self.shape(x)
+        out = self.reshape(x, (batch * seq_len, hidden))
+        for layer in self.layers:
+            out = layer(out)
+        return self.reduce_mean(out)
+
+
+def total_compile_time(shapes, enable_incremental_compile):
+    context.set_context(enable_incremental_compile=enable_incremental_compile)
+    net = SequenceNet()
+    optimizer = Momentum(net.trainable_params(), learning_rate=0.01, momentum=0.9)
+    train_net = nn.TrainOneStepCell(net, optimizer)
+    train_net.set_train()
+    total_time = 0
+    for shape in shapes:
+        x = Tensor(np.random.randn(*shape).astype(np.float32))
+        start = time.perf_counter()
+        train_net(x)
+        total_time += time.perf_counter() - start
+    return total_time
+
+
+@pytest.mark.parametrize('shapes', [
+    [(batch, 16, hidden_size) for batch in (8, 16, 24, 32)],
+    [(8, seq_len, hidden_size) for seq_len in (16, 32, 48, 64)],
+])
+def test_incremental_compile_time(shapes):
+    """Report the time to compile and run one step for each input shape, with and without incremental compile."""
+    full_time = total_compile_time(shapes, False)
+    incremental_time = total_compile_time(shapes, True)
+    context.set_context(enable_incremental_compile=False)
+    metrics = get_incremental_compile_metrics()
+    print("shapes {}: {:.3f} s full, {:.3f} s incremental, {} hits saving {:.3f} s".format(
+        shapes, full_time, incremental_time, metrics["hit"], metrics["saved_time"]))
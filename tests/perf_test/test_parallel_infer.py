@@ -0,0 +1,77 @@
+# Copyright 2020 Huawei Technologies Co., Ltd
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+# http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+# ============================================================================
+
+"""Compile time of wide multi-branch networks with and without the parallel infer of the static analysis."""
+
+import time
+
+import numpy as np
+import pytest
+
+import mindspore.nn as nn
+from mindspore import Tensor
+from mindspore import context
+from mindspore.ops import functional as F
+
+context.set_context(mode=context.GRAPH_MODE, device_target="CPU")
+
+
+class BranchCell(nn.Cell):
+    """A chain of elementwise ops, the ops of different branches are independent."""
+
+    def __init__(self, depth):
+        super(BranchCell, self).__init__()
+        self.depth = depth
+
+    def construct(self, x, y):
+        out = x
+        for _ in range(self.depth):
+            out = F.tensor_mul(F.tensor_add(out, y), y)
+        return out
+
+
+class MultiBranchNet(nn.Cell):
+    """Many branches inlined into one graph."""
+
+    def __init__(self, width, depth):
+        super(MultiBranchNet, self).__init__()
+        self.branches = nn.CellList([BranchCell(depth) for _ in range(width)])
+
+    def construct(self, x, y):
+        out = x
+        for branch in self.branches:
+            out = F.tensor_add(out, branch(x, y))
+        return out
+
+
+def compile_time(width, depth, enable_parallel_infer):
+    context.set_context(enable_parallel_infer=enable_parallel_infer)
+    net = MultiBranchNet(width, depth)
+    x = Tensor(np.random.randn(2, 4).astype(np.float32))
+    y = Tensor(np.random.randn(2, 4).astype(np.float32))
+    start = time.perf_counter()
+    net.compile(x, y)
+    return time.perf_counter() - start
+
+
+@pytest.mark.parametrize('width', [8, 32])
+def test_parallel_infer_compile_time(width):
+    """Report the compile time of a multi-branch network inferred in order and in parallel."""
+    depth = 16
+    serial_time = compile_time(width, depth, False)
+    parallel_time = compile_time(width, depth, True)
+    context.set_context(enable_parallel_infer=False)
+    print("width {}: {:.3f} s in order, {:.3f} s in parallel, speedup {:.2f}".format(
+        width, serial_time, parallel_time, serial_time / parallel_time))
@@ -0,0 +1,60 @@
+# Copyright 2020 Huawei Technologies Co., Ltd
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+# http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+# ============================================================================
+
+"""Dispatch latency of the operators of PYNATIVE_MODE with and without asynchronous dispatch."""
+
+import time
+
+import numpy as np
+import pytest
+
+from mindspore import Tensor
+from mindspore import context
+from mindspore.ops import operations as P
+
+context.set_context(mode=context.PYNATIVE_MODE, device_target="CPU")
+
+warmup_ops = 100
+run_ops = 2000
+
+
+def run_ops_time(x, y):
+    """Returns the time to dispatch the ops and the time until their result is on host."""
+    add = P.TensorAdd()
+    mul = P.Mul()
+    out = x
+    for _ in range(warmup_ops):
+        out = mul(add(out, y), y)
+    out.asnumpy()
+    start = time.perf_counter()
+    out = x
+    for _ in range(run_ops // 2):
+        out = mul(add(out, y), y)
+    dispatch_time = time.perf_counter() - start
+    out.asnumpy()
+    total_time = time.perf_counter() - start
+    return dispatch_time / run_ops, total_time / run_ops
+
+
+@pytest.mark.parametrize('enable_async', [False, True])
+def test_pynative_op_dispatch_latency(enable_async):
+    """Report the dispatch latency and the end to end time per op."""
+    context.set_context(enable_pynative_async=enable_async)
+    x = Tensor(np.random.randn(16, 16).astype(np.float32))
+    y = Tensor(np.ones((16, 16)).astype(np.float32))
+    dispatch_time, total_time = run_ops_time(x, y)
+    context.set_context(enable_pynative_async=False)
+    print("async {}: {:.2f} us dispatch per op, {:.2f} us per op until synchronized".format(
+        enable_async, dispatch_time * 1e6, total_time * 1e6))
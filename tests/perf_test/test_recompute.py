@@ -0,0 +1,115 @@
+# Copyright 2020 Huawei Technologies Co., Ltd
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+# http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+# ============================================================================
+
+"""
+Memory and throughput of training with the activations recomputed in the backward pass.
+
+Each configuration is trained in its own process, with the info log on, to read:
+- the activations kept for the backward pass, as estimated by the recompute pass;
+- the memory of the graph planned by SOMAS, on the devices using it;
+- the peak resident memory of the process.
+"""
+
+import os
+import re
+import resource
+import subprocess
+import sys
+import time
+
+import numpy as np
+import pytest
+
+import mindspore.nn as nn
+from mindspore import Tensor
+from mindspore import context
+from mindspore.nn import TrainOneStepCell, WithLossCell
+
+warmup_steps = 3
+run_steps = 20
+batch_size = 64
+hidden = 1024
+layer_num = 8
+
+
+class FeedForwardStack(nn.Cell):
+    """Feed forward blocks of a transformer encoder, whose activations are four times wider than the hidden size."""
+
+    def __init__(self, recompute=False):
+        super(FeedForwardStack, self).__init__()
+        self.blocks = nn.CellList()
+        for _ in range(layer_num):
+            block = nn.SequentialCell([nn.Dense(hidden, hidden * 4), nn.GELU(), nn.Dense(hidden * 4, hidden)])
+            if recompute:
+                block.recompute()
+            self.blocks.append(block)
+        self.classifier = nn.Dense(hidden, 2)
+
+    def construct(self, x):
+        for i in range(layer_num):
+            x = x + self.blocks[i](x)
+        return self.classifier(x)
+
+
+def train(device_target, mode):
+    """Train in the current process, print the step time and the peak resident memory."""
+    context.set_context(mode=context.GRAPH_MODE, device_target=device_target)
+    if mode == "budget":
+        context.set_context(recompute_memory_budget="0.01GB")
+    np.random.seed(1)
+    net = FeedForwardStack(recompute=(mode == "cells"))
+    loss = nn.SoftmaxCrossEntropyWithLogits(sparse=True, reduction='mean')
+    opt = nn.Momentum(net.trainable_params(), 0.01, 0.9)
+    train_net = TrainOneStepCell(WithLossCell(net, loss), opt)
+    train_net.set_train()
+    data = Tensor(np.random.randn(batch_size, hidden).astype(np.float32))
+    label = Tensor(np.random.randint(0, 2, batch_size).astype(np.int32))
+    for _ in range(warmup_steps):
+        train_net(data, label)
+    start = time.perf_counter()
+    for _ in range(run_steps):
+        out = train_net(data, label)
+    out.asnumpy()
+    step_time = (time.perf_counter() - start) / run_steps
+    print("step_time_ms {:.3f}".format(step_time * 1e3))
+    print("max_rss_kb {}".format(resource.getrusage(resource.RUSAGE_SELF).ru_maxrss))
+
+
+def run_in_process(device_target, mode):
+    env = dict(os.environ, GLOG_v="1", GLOG_logtostderr="1")
+    result = subprocess.run([sys.executable, __file__, device_target, mode], env=env, stdout=subprocess.PIPE,
+                            stderr=subprocess.PIPE, universal_newlines=True, check=True)
+    step_time = float(re.search(r"step_time_ms ([\d.]+)", result.stdout).group(1))
+    max_rss = int(re.search(r"max_rss_kb (\d+)", result.stdout).group(1))
+    kept = re.findall(r"estimated to (?:be|go from \d+ to) (\d+) bytes", result.stderr)
+    somas = re.findall(r"TotalSomasReuseDynamicSize \[(\d+)\]", result.stderr)
+    return {"step_time_ms": step_time,
+            "samples_per_s": batch_size / step_time * 1e3,
+            "max_rss_mb": max_rss / 1024,
+            "kept_activation_mb": int(kept[-1]) / 2**20 if kept else None,
+            "somas_mb": max(int(size) for size in somas) / 2**20 if somas else None}
+
+
+@pytest.mark.parametrize('device_target', [os.environ.get("DEVICE_TARGET", "CPU")])
+def test_recompute_memory_and_throughput(device_target):
+    """Report the memory and throughput without recomputation, with the blocks recomputed and with a budget."""
+    for mode in ["none", "cells", "budget"]:
+        result = run_in_process(device_target, mode)
+        print("{}: {}".format(mode, ", ".join("{} {}".format(key, "n/a" if value is None else round(value, 2))
+                                               for key, value in result.items())))
+
+
+if __name__ == "__main__":
+    train(sys.argv[1], sys.argv[2])
@@ -0,0 +1,81 @@
+# Copyright 2020 Huawei Technologies Co., Ltd
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+# http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+# ============================================================================
+import os
+import shutil
+import tempfile
+
+import numpy as np
+import pytest
+
+import mindspore.context as context
+import mindspore.nn as nn
+from mindspore import Tensor
+from mindspore._c_expression import get_compile_cache_metrics
+from mindspore.common.parameter import Parameter
+from mindspore.ops import operations as P
+
+context.set_context(mode=context.GRAPH_MODE, device_target='CPU')
+
+WEIGHT_SHAPE = [256, 256]
+
+
+class Net(nn.Cell):
+    def __init__(self, weight_value):
+        super(Net, self).__init__()
+        self.matmul = P.MatMul()
+        self.relu = P.ReLU()
+        self.weight = Parameter(Tensor(np.full(WEIGHT_SHAPE, weight_value, np.float32)), name='weight')
+
+    def construct(self, x):
+        return self.relu(self.matmul(x, self.weight))
+
+
+def cache_size(cache_path):
+    return sum(os.path.getsize(os.path.join(cache_path, name)) for name in os.listdir(cache_path))
+
+
+@pytest.mark.level0
+@pytest.mark.platform_x86_cpu
+@pytest.mark.env_onecard
+def test_compile_cache_hit_and_miss():
+    cache_path = tempfile.mkdtemp()
+    context.set_context(compile_cache_path=cache_path)
+    try:
+        x = Tensor(np.ones([2, 256]).astype(np.float32))
+        base = get_compile_cache_metrics()
+        out1 = Net(0.5)(x)
+        metrics = get_compile_cache_metrics()
+        assert metrics["miss"] == base["miss"] + 1
+        assert metrics["save"] == base["save"] + 1
+        # the weights are bound to the network on load, the cache does not hold their data
+        assert cache_size(cache_path) < np.prod(WEIGHT_SHAPE) * 4
+
+        # another instance of the network hits the cache and runs with its own weight
+        out2 = Net(1.0)(x)
+        metrics = get_compile_cache_metrics()
+        assert metrics["hit"] == base["hit"] + 1
+        assert metrics["miss"] == base["miss"] + 1
+        assert np.allclose(out1.asnumpy(), np.full([2, 256], 128, np.float32))
+        assert np.allclose(out2.asnumpy(), np.full([2, 256], 256, np.float32))
+
+        # new input shapes miss
+        out3 = Net(1.0)(Tensor(np.ones([4, 256]).astype(np.float32)))
+        metrics = get_compile_cache_metrics()
+        assert metrics["hit"] == base["hit"] + 1
+        assert metrics["miss"] == base["miss"] + 2
+        assert np.allclose(out3.asnumpy(), np.full([4, 256], 256, np.float32))
+    finally:
+        context.set_context(compile_cache_path="")
+        shutil.rmtree(cache_path)
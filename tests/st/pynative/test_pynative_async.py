@@ -0,0 +1,79 @@
+# Copyright 2020 Huawei Technologies Co., Ltd
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+# http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+# ============================================================================
+import numpy as np
+import pytest
+
+from mindspore import Tensor
+from mindspore import context
+from mindspore.ops import operations as P
+from mindspore.ops.primitive import _run_op
+
+context.set_context(mode=context.PYNATIVE_MODE, device_target="CPU")
+
+
+def run_ops(x, y):
+    """The same primitives are dispatched again with other const inputs, which are converted to their attrs."""
+    add = P.TensorAdd()
+    reduce_sum = P.ReduceSum(keep_dims=True)
+    transpose = P.Transpose()
+    tile = P.Tile()
+    outputs = []
+    out = x
+    for i in range(50):
+        out = add(out, y)
+        outputs.append(reduce_sum(out, i % 2))
+        outputs.append(transpose(out, (1, 0) if i % 2 else (0, 1)))
+        outputs.append(tile(out, (i % 3 + 1, 1)))
+    return [output.asnumpy() for output in outputs]
+
+
+@pytest.mark.level0
+@pytest.mark.platform_x86_cpu
+@pytest.mark.env_onecard
+def test_pynative_async_same_as_sync():
+    x = Tensor(np.random.randn(4, 4).astype(np.float32))
+    y = Tensor(np.random.randn(4, 4).astype(np.float32))
+    context.set_context(enable_pynative_async=False)
+    expect = run_ops(x, y)
+    context.set_context(enable_pynative_async=True)
+    try:
+        output = run_ops(x, y)
+    finally:
+        context.set_context(enable_pynative_async=False)
+    assert len(output) == len(expect)
+    for out, exp in zip(output, expect):
+        assert out.shape == exp.shape
+        assert np.allclose(out, exp, 1e-5, 1e-5)
+
+
+@pytest.mark.level0
+@pytest.mark.platform_x86_cpu
+@pytest.mark.env_onecard
+def test_pynative_async_run_op_value():
+    """The tensors returned by _run_op wrap the outputs of the async ops, they take the computed values."""
+    x = np.random.randn(4, 4).astype(np.float32)
+    y = np.random.randn(4, 4).astype(np.float32)
+    add = P.TensorAdd()
+    mul = P.Mul()
+    context.set_context(enable_pynative_async=True)
+    try:
+        add_out = _run_op(add, "TensorAdd", (Tensor(x), Tensor(y)))
+        mul_out = _run_op(mul, "Mul", (add_out, Tensor(y)))
+        mul_value = mul_out.asnumpy()
+        add_value = add_out.asnumpy()
+    finally:
+        context.set_context(enable_pynative_async=False)
+    assert np.allclose(add_value, x + y, 1e-5, 1e-5)
+    assert np.allclose(mul_value, (x + y) * y, 1e-5, 1e-5)
@@ -0,0 +1,80 @@
+/**
+ * Copyright 2020 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <atomic>
+#include <stdexcept>
+#include <vector>
+#include "common/common_test.h"
+#include "runtime/device/cpu/cpu_dataflow_executor.h"
+
+namespace mindspore {
+namespace device {
+namespace cpu {
+class CPUDataflowExecutorTest : public UT::Common {
+ public:
+  CPUDataflowExecutorTest() = default;
+
+  static void AddEdge(DataflowGraph *graph, size_t from, size_t to) {
+    graph->successors[from].push_back(to);
+    graph->dep_counts[to]++;
+  }
+
+  static DataflowGraph NewGraph(size_t kernel_num) {
+    DataflowGraph graph;
+    graph.successors.resize(kernel_num);
+    graph.dep_counts.assign(kernel_num, 0);
+    return graph;
+  }
+};
+
+TEST_F(CPUDataflowExecutorTest, run_in_dependency_order) {
+  // two towers of three kernels joined by a last kernel
+  auto graph = NewGraph(7);
+  AddEdge(&graph, 0, 1);
+  AddEdge(&graph, 1, 2);
+  AddEdge(&graph, 3, 4);
+  AddEdge(&graph, 4, 5);
+  AddEdge(&graph, 2, 6);
+  AddEdge(&graph, 5, 6);
+  std::vector<std::atomic<int>> order(7);
+  std::atomic<int> counter{0};
+  CPUDataflowExecutor::GetInstance().Run(graph, 4, [&order, &counter](size_t kernel) { order[kernel] = counter++; });
+  EXPECT_EQ(counter, 7);
+  EXPECT_LT(order[0], order[1]);
+  EXPECT_LT(order[1], order[2]);
+  EXPECT_LT(order[3], order[4]);
+  EXPECT_LT(order[4], order[5]);
+  EXPECT_EQ(order[6], 6);
+}
+
+TEST_F(CPUDataflowExecutorTest, rethrow_launch_error) {
+  auto graph = NewGraph(4);
+  AddEdge(&graph, 0, 1);
+  AddEdge(&graph, 1, 2);
+  AddEdge(&graph, 2, 3);
+  std::atomic<int> launched{0};
+  auto launch = [&launched](size_t kernel) {
+    launched++;
+    if (kernel == 1) {
+      throw std::runtime_error("launch failed");
+    }
+  };
+  EXPECT_THROW(CPUDataflowExecutor::GetInstance().Run(graph, 2, launch), std::runtime_error);
+  // the kernels behind the failed one are not launched
+  EXPECT_EQ(launched, 2);
+}
+}  // namespace cpu
+}  // namespace device
+}  // namespace mindspore
@@ -0,0 +1,121 @@
+/**
+ * Copyright 2020 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <memory>
+#include <vector>
+#include "common/common_test.h"
+#include "backend/kernel_compiler/cpu/cpu_kernel.h"
+#include "backend/session/anf_runtime_algorithm.h"
+#include "runtime/device/cpu/cpu_device_address.h"
+#include "runtime/device/cpu/cpu_simple_mem_plan.h"
+#include "runtime/device/kernel_info.h"
+#include "utils/ms_context.h"
+
+namespace mindspore {
+namespace device {
+namespace cpu {
+namespace {
+constexpr size_t kBlockSize = 1024;
+
+class DummyCPUKernel : public kernel::CPUKernel {
+ public:
+  DummyCPUKernel() = default;
+  ~DummyCPUKernel() override = default;
+  void InitKernel(const CNodePtr &) override {}
+  bool Launch(const std::vector<kernel::AddressPtr> &, const std::vector<kernel::AddressPtr> &,
+              const std::vector<kernel::AddressPtr> &) override {
+    return true;
+  }
+};
+}  // namespace
+
+class CPUSimpleMemPlanTest : public UT::Common {
+ public:
+  CPUSimpleMemPlanTest() = default;
+  void SetUp() override {
+    auto context = MsContext::GetInstance();
+    context->set_param<bool>(MS_CTX_ENABLE_MEM_REUSE, true);
+    context->set_param<uint32_t>(MS_CTX_CPU_INTER_OP_PARALLEL_NUM, 1);
+  }
+  void TearDown() override { MsContext::GetInstance()->set_param<uint32_t>(MS_CTX_CPU_INTER_OP_PARALLEL_NUM, 1); }
+
+  // x -> ReLU -> ReLU -> ReLU -> output, the output of each kernel is read by the next one only
+  static KernelGraphPtr NewChainGraph(uint32_t graph_id, std::vector<DeviceAddressPtr> *addresses) {
+    auto graph = std::make_shared<session::KernelGraph>();
+    graph->set_graph_id(graph_id);
+    auto abs = std::make_shared<abstract::AbstractTensor>(kFloat32, std::vector<int64_t>{kBlockSize / sizeof(float)});
+    auto x = graph->NewParameter();
+    x->set_abstract(abs);
+    AnfNodePtr input = x;
+    std::vector<CNodePtr> execution_order;
+    for (size_t i = 0; i < 3; ++i) {
+      auto relu = graph->NewCNode({NewValueNode(std::make_shared<Primitive>("ReLU")), input});
+      relu->set_abstract(abs);
+      auto kernel_info = std::make_shared<device::KernelInfo>();
+      kernel_info->set_kernel_mod(std::make_shared<DummyCPUKernel>());
+      relu->set_kernel_info(kernel_info);
+      auto address = std::make_shared<CPUDeviceAddress>(nullptr, kBlockSize);
+      AnfAlgo::SetOutputAddr(address, 0, relu.get());
+      addresses->push_back(address);
+      execution_order.push_back(relu);
+      input = relu;
+    }
+    graph->set_output(input);
+    graph->set_execution_order(execution_order);
+    return graph;
+  }
+};
+
+// the first and the last outputs are never alive at the same time, they share memory
+TEST_F(CPUSimpleMemPlanTest, reuse_memory_of_dead_outputs) {
+  CPUSimpleMemPlan mem_plan;
+  std::vector<DeviceAddressPtr> addresses;
+  auto graph = NewChainGraph(1, &addresses);
+  size_t mem_size = mem_plan.MemPlan(graph.get());
+  EXPECT_TRUE(mem_plan.mem_reused(graph->graph_id()));
+  EXPECT_LT(mem_size, 3 * kBlockSize);
+  std::vector<uint8_t> mem(mem_size);
+  mem_plan.MemAssign(graph.get(), mem.data());
+  for (const auto &address : addresses) {
+    ASSERT_NE(address->GetMutablePtr(), nullptr);
+  }
+  EXPECT_NE(addresses[0]->GetMutablePtr(), addresses[1]->GetMutablePtr());
+  EXPECT_NE(addresses[1]->GetMutablePtr(), addresses[2]->GetMutablePtr());
+  EXPECT_EQ(addresses[0]->GetMutablePtr(), addresses[2]->GetMutablePtr());
+}
+
+// a graph planned for the parallel launch does not change the plan of the graph planned before it
+TEST_F(CPUSimpleMemPlanTest, reuse_flag_per_graph) {
+  CPUSimpleMemPlan mem_plan;
+  std::vector<DeviceAddressPtr> reused_addresses;
+  auto reused_graph = NewChainGraph(1, &reused_addresses);
+  size_t reused_size = mem_plan.MemPlan(reused_graph.get());
+  std::vector<uint8_t> reused_mem(reused_size);
+  mem_plan.MemAssign(reused_graph.get(), reused_mem.data());
+
+  MsContext::GetInstance()->set_param<uint32_t>(MS_CTX_CPU_INTER_OP_PARALLEL_NUM, 2);
+  std::vector<DeviceAddressPtr> parallel_addresses;
+  auto parallel_graph = NewChainGraph(2, &parallel_addresses);
+  size_t parallel_size = mem_plan.MemPlan(parallel_graph.get());
+  EXPECT_GE(parallel_size, 3 * kBlockSize);
+  EXPECT_FALSE(mem_plan.mem_reused(parallel_graph->graph_id()));
+  EXPECT_TRUE(mem_plan.mem_reused(reused_graph->graph_id()));
+
+  mem_plan.ClearGraph(reused_graph->graph_id());
+  EXPECT_FALSE(mem_plan.mem_reused(reused_graph->graph_id()));
+}
+}  // namespace cpu
+}  // namespace device
+}  // namespace mindspore
@@ -99,6 +99,29 @@ TEST_F(TestCloner, test_clone_simple) {
   }
 }
 
+TEST_F(TestCloner, test_clone_nodes_on_demand) {
+  std::string py_code = "test_clone_simple";
+
+  FuncGraphPtr g = getPyFun.CallAndParseRet(py_code);
+  ASSERT_TRUE(g != nullptr);
+
+  Cloner cl({g}, false, false, false);
+  cl.set_clone_nodes_on_demand(true);
+  auto g2 = cl[g];
+  ASSERT_TRUE(g2 != g);
+  ASSERT_EQ(g->parameters().size(), g2->parameters().size());
+  ASSERT_TRUE(g2->get_return() != g->get_return());
+
+  // the nodes other than the return are left to clone on their first use
+  auto output = g->output();
+  ASSERT_TRUE(cl[output] == output);
+  auto new_output = cl.CloneDisconnected(output);
+  ASSERT_TRUE(new_output != output);
+  ASSERT_TRUE(new_output->func_graph() == g2);
+  ASSERT_TRUE(new_output->cast<CNodePtr>()->inputs().empty());
+  ASSERT_TRUE(cl[output] == new_output);
+}
+
 TEST_F(TestCloner, test_clone_closure) {
   std::string py_code = "test_clone_closure";
 
@@ -0,0 +1,82 @@
+/**
+ * Copyright 2020 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <memory>
+#include <thread>
+#include <vector>
+
+#include "common/common_test.h"
+
+#include "ir/ir_arena.h"
+
+namespace mindspore {
+class TestIrArena : public UT::Common {
+ public:
+  TestIrArena() {}
+};
+
+struct ArenaNode {
+  explicit ArenaNode(int64_t v) : value(v) {}
+  int64_t value;
+  char payload[200];
+};
+
+TEST_F(TestIrArena, test_make_node_without_arena) {
+  ASSERT_EQ(IrArena::current(), nullptr);
+  auto before = IrArena::statistics();
+  auto node = MakeIrNode<ArenaNode>(1);
+  ASSERT_EQ(node->value, 1);
+  ASSERT_EQ(IrArena::statistics().allocation_num, before.allocation_num);
+}
+
+TEST_F(TestIrArena, test_nodes_outlive_arena) {
+  auto before = IrArena::statistics();
+  std::vector<std::shared_ptr<ArenaNode>> nodes;
+  {
+    auto arena = std::make_shared<IrArena>();
+    IrArenaScope scope(arena.get());
+    for (int64_t i = 0; i < 1000; ++i) {
+      nodes.push_back(MakeIrNode<ArenaNode>(i));
+    }
+    // drop half of the nodes while the arena is alive
+    for (size_t i = 0; i < nodes.size(); i += 2) {
+      nodes[i] = nullptr;
+    }
+  }
+  ASSERT_EQ(IrArena::current(), nullptr);
+  for (size_t i = 1; i < nodes.size(); i += 2) {
+    ASSERT_EQ(nodes[i]->value, static_cast<int64_t>(i));
+  }
+  auto after = IrArena::statistics();
+  ASSERT_EQ(after.allocation_num - before.allocation_num, 1000);
+  // many nodes share a chunk
+  ASSERT_LT(after.chunk_num - before.chunk_num, 10);
+  // the last nodes release the chunks on another thread
+  std::thread release([&nodes]() { nodes.clear(); });
+  release.join();
+}
+
+TEST_F(TestIrArena, test_large_allocation) {
+  struct LargeNode {
+    char payload[128 * 1024];
+  };
+  auto arena = std::make_shared<IrArena>();
+  IrArenaScope scope(arena.get());
+  auto before = IrArena::statistics();
+  auto node = MakeIrNode<LargeNode>();
+  ASSERT_TRUE(node != nullptr);
+  ASSERT_EQ(IrArena::statistics().large_allocation_num - before.large_allocation_num, 1);
+}
+}  // namespace mindspore
@@ -374,5 +374,35 @@ TEST_F(TestTensor, TensorPyCast) {
   ASSERT_EQ(shape, shape3);
 }
 
+// the copies made of the output of an asynchronous op take the computed value, like the python tensors wrapping it
+TEST_F(TestTensor, FutureCopyTest) {
+  std::vector<int64_t> shape{2, 3};
+  auto future = std::make_shared<Tensor>(kNumberTypeFloat32, shape);
+  future->SetFuture();
+  future->SetNeedWait(true);
+  auto copy = std::make_shared<Tensor>(*future);
+  auto copy_of_copy = std::make_shared<Tensor>(*copy);
+  auto released = std::make_shared<Tensor>(*future);
+  released = nullptr;
+
+  std::vector<float> value_data{1, 2, 3, 4, 5, 6};
+  Tensor value(kNumberTypeFloat32, shape, value_data.data(), kNumberTypeFloat32);
+  future->SetComputedValue(value);
+  future->SetNeedWait(false);
+  auto late_copy = std::make_shared<Tensor>(*copy);
+  for (const auto &tensor : {future, copy, copy_of_copy, late_copy}) {
+    ASSERT_FALSE(tensor->NeedWait());
+    tensor->Wait();
+    ASSERT_EQ(tensor->data_ptr(), value.data_ptr());
+    ASSERT_EQ(tensor->id(), future->id());
+  }
+
+  // the copies changed after the op is done keep their own value
+  Tensor other(kNumberTypeFloat32, shape);
+  copy->AssignValue(other);
+  auto copy_of_changed = std::make_shared<Tensor>(*copy);
+  ASSERT_EQ(copy_of_changed->data_ptr(), other.data_ptr());
+}
+
 }  // namespace tensor
 }  // namespace mindspore
@@ -0,0 +1,118 @@
+/**
+ * Copyright 2020 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <vector>
+#include "common/common_test.h"
+#include "backend/kernel_compiler/cpu/broadcast_iterator.h"
+
+namespace mindspore {
+namespace kernel {
+class BroadcastIteratorTest : public UT::Common {
+ public:
+  BroadcastIteratorTest() {}
+
+  // the index of the input element broadcast to the output element pos, computed dim by dim
+  static size_t NaiveIndex(const std::vector<size_t> &input_shape, const std::vector<size_t> &output_shape,
+                           size_t pos) {
+    size_t index = 0;
+    size_t input_stride = 1;
+    for (size_t dim = output_shape.size(); dim > 0; --dim) {
+      size_t coord = pos % output_shape[dim - 1];
+      pos /= output_shape[dim - 1];
+      size_t offset = output_shape.size() - input_shape.size();
+      if (dim - 1 < offset) {
+        continue;
+      }
+      size_t input_dim = input_shape[dim - 1 - offset];
+      index += (input_dim == 1 ? 0 : coord) * input_stride;
+      input_stride *= input_dim;
+    }
+    return index;
+  }
+
+  template <typename T>
+  static void CheckSub(const std::vector<size_t> &lhs_shape, const std::vector<size_t> &rhs_shape,
+                       const std::vector<size_t> &output_shape) {
+    BroadcastIterator iter({lhs_shape, rhs_shape}, output_shape);
+    size_t lhs_num = 1;
+    size_t rhs_num = 1;
+    for (auto dim : lhs_shape) {
+      lhs_num *= dim;
+    }
+    for (auto dim : rhs_shape) {
+      rhs_num *= dim;
+    }
+    std::vector<T> lhs(lhs_num);
+    std::vector<T> rhs(rhs_num);
+    for (size_t i = 0; i < lhs_num; ++i) {
+      lhs[i] = static_cast<T>(i * 3 + 1);
+    }
+    for (size_t i = 0; i < rhs_num; ++i) {
+      rhs[i] = static_cast<T>(i * 7 + 2);
+    }
+    std::vector<T> output(iter.output_num());
+    auto sub = [](const auto &x, const auto &y) { return x - y; };
+    // walk in uneven slices to cross the runs in their middle
+    size_t slice = iter.output_num() / 3 + 1;
+    for (size_t start = 0; start < iter.output_num(); start += slice) {
+      BroadcastBinary(iter, lhs.data(), rhs.data(), output.data(), start,
+                      std::min(start + slice, iter.output_num()), sub);
+    }
+    for (size_t pos = 0; pos < iter.output_num(); ++pos) {
+      T expect = lhs[NaiveIndex(lhs_shape, output_shape, pos)] - rhs[NaiveIndex(rhs_shape, output_shape, pos)];
+      ASSERT_EQ(output[pos], expect);
+    }
+  }
+};
+
+TEST_F(BroadcastIteratorTest, test_same_shape) {
+  BroadcastIterator iter({{2, 3, 4}, {2, 3, 4}}, {2, 3, 4});
+  ASSERT_EQ(iter.output_num(), 24);
+  ASSERT_EQ(iter.run_stride(0), 1);
+  ASSERT_EQ(iter.run_stride(1), 1);
+  size_t run_num = 0;
+  iter.ForEachRun(0, 24, [&run_num](const size_t *, size_t, size_t len) {
+    ASSERT_EQ(len, 24);
+    ++run_num;
+  });
+  ASSERT_EQ(run_num, 1);
+  CheckSub<float>({2, 3, 4}, {2, 3, 4}, {2, 3, 4});
+}
+
+TEST_F(BroadcastIteratorTest, test_scalar) {
+  BroadcastIterator iter({{5, 7}, {}}, {5, 7});
+  ASSERT_EQ(iter.run_stride(0), 1);
+  ASSERT_EQ(iter.run_stride(1), 0);
+  CheckSub<float>({5, 7}, {}, {5, 7});
+  CheckSub<float>({1}, {5, 7}, {5, 7});
+  CheckSub<int>({}, {}, {});
+}
+
+TEST_F(BroadcastIteratorTest, test_row_and_column) {
+  CheckSub<float>({6, 9}, {9}, {6, 9});
+  CheckSub<float>({6, 9}, {6, 1}, {6, 9});
+  CheckSub<int64_t>({6, 1}, {1, 9}, {6, 9});
+  BroadcastIterator column({{6, 9}, {6, 1}}, {6, 9});
+  ASSERT_EQ(column.run_stride(1), 0);
+}
+
+TEST_F(BroadcastIteratorTest, test_general) {
+  CheckSub<float>({2, 1, 4, 5}, {3, 1, 5}, {2, 3, 4, 5});
+  CheckSub<float>({1, 3, 1, 1, 5}, {2, 1, 4, 1, 1}, {2, 3, 4, 1, 5});
+  CheckSub<int>({2, 1, 4, 5}, {3, 1, 1}, {2, 3, 4, 5});
+}
+}  // namespace kernel
+}  // namespace mindspore
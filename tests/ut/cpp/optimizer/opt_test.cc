@@ -177,6 +177,16 @@ TEST_F(TestOptOpt, ConstantVariable) {
   ASSERT_TRUE(CheckOpt(before, after, std::vector<SubstitutionPtr>({Qct_to_P})));
 }
 
+TEST_F(TestOptOpt, MultiPattern) {
+  FuncGraphPtr before = getPyFun.CallAndParseRet("test_multi_pattern", "before_1");
+  FuncGraphPtr after = getPyFun.CallAndParseRet("test_multi_pattern", "after");
+
+  ASSERT_TRUE(nullptr != before);
+  ASSERT_TRUE(nullptr != after);
+  // P(P(15)) only appears after Qct_to_P rewrote the inner node, the outer node is visited again as its user
+  ASSERT_TRUE(CheckOpt(before, after, std::vector<SubstitutionPtr>({idempotent_P, Qct_to_P})));
+}
+
 TEST_F(TestOptOpt, CSE) {
   // test a simple cse testcase test_f1
   FuncGraphPtr test_graph1 = getPyFun.CallAndParseRet("test_cse", "test_f1");
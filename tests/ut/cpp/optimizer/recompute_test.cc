@@ -0,0 +1,122 @@
+/**
+ * Copyright 2020 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <memory>
+#include <vector>
+#include "common/common_test.h"
+
+#include "abstract/abstract_value.h"
+#include "base/core_ops.h"
+#include "frontend/optimizer/recompute.h"
+#include "ir/func_graph.h"
+#include "ir/manager.h"
+#include "utils/flags.h"
+#include "utils/ms_context.h"
+#include "utils/utils.h"
+
+namespace mindspore {
+namespace opt {
+class TestRecompute : public UT::Common {
+ public:
+  TestRecompute() {}
+  void TearDown() override { MsContext::GetInstance()->set_param<float>(MS_CTX_RECOMPUTE_MEMORY_BUDGET, 0); }
+
+  // out = (Exp(ReLU(x)), Mul(Mul(dout, dout), ReLU(x))), the Mul nodes in the gradients scope
+  void BuildGraph(const PrimitivePtr &relu) {
+    graph_ = std::make_shared<FuncGraph>();
+    auto abs = std::make_shared<abstract::AbstractTensor>(kFloat32, std::vector<int64_t>{32, 32});
+    x_ = graph_->add_parameter();
+    x_->set_abstract(abs);
+    auto dout = graph_->add_parameter();
+    dout->set_abstract(abs);
+    relu_ = graph_->NewCNode({NewValueNode(relu), x_});
+    relu_->set_abstract(abs);
+    exp_ = graph_->NewCNode({NewValueNode(std::make_shared<Primitive>("Exp")), relu_});
+    exp_->set_abstract(abs);
+    auto bprop_scope = std::make_shared<Scope>("Gradients/Default/gradExp");
+    grad_ = graph_->NewCNode({NewValueNode(std::make_shared<Primitive>("Mul")), dout, dout});
+    grad_->set_abstract(abs);
+    grad_->set_scope(bprop_scope);
+    bprop_ = graph_->NewCNode({NewValueNode(std::make_shared<Primitive>("Mul")), grad_, relu_});
+    bprop_->set_abstract(abs);
+    bprop_->set_scope(bprop_scope);
+    graph_->set_output(graph_->NewCNode({NewValueNode(prim::kPrimMakeTuple), exp_, bprop_}));
+    manager_ = Manage(graph_);
+  }
+
+  // the backward node uses a duplicated ReLU waiting for its gradients, the forward one is unchanged
+  void CheckRecomputed() {
+    ASSERT_EQ(exp_->input(1), relu_);
+    auto new_relu = bprop_->input(2)->cast<CNodePtr>();
+    ASSERT_TRUE(new_relu != nullptr);
+    ASSERT_NE(new_relu, relu_);
+    ASSERT_EQ(GetCNodePrimitive(new_relu)->name(), "ReLU");
+    auto depend = new_relu->input(1)->cast<CNodePtr>();
+    ASSERT_TRUE(IsPrimitiveCNode(depend, prim::kPrimDepend));
+    ASSERT_EQ(depend->input(1), x_);
+    ASSERT_EQ(depend->input(2), grad_);
+  }
+
+  FuncGraphPtr graph_;
+  FuncGraphManagerPtr manager_;
+  ParameterPtr x_;
+  CNodePtr relu_;
+  CNodePtr exp_;
+  CNodePtr grad_;
+  CNodePtr bprop_;
+};
+
+TEST_F(TestRecompute, test_recompute_marked_node) {
+  auto relu = std::make_shared<Primitive>("ReLU");
+  relu->AddAttr(kAttrRecompute, MakeValue(true));
+  BuildGraph(relu);
+  ASSERT_TRUE(InsertRecomputedNodes(graph_));
+  CheckRecomputed();
+}
+
+TEST_F(TestRecompute, test_recompute_by_budget) {
+  BuildGraph(std::make_shared<Primitive>("ReLU"));
+  ASSERT_FALSE(InsertRecomputedNodes(graph_));
+  ASSERT_EQ(bprop_->input(2), relu_);
+  // the 4KB output of ReLU exceeds the budget
+  MsContext::GetInstance()->set_param<float>(MS_CTX_RECOMPUTE_MEMORY_BUDGET, 1e-9);
+  ASSERT_TRUE(InsertRecomputedNodes(graph_));
+  CheckRecomputed();
+}
+
+TEST_F(TestRecompute, test_random_node_not_recomputed) {
+  auto relu = std::make_shared<Primitive>("ReLU");
+  relu->AddAttr(kAttrRecompute, MakeValue(true));
+  relu->AddAttr(GRAPH_FLAG_RANDOM_EFFECT, MakeValue(true));
+  BuildGraph(relu);
+  ASSERT_FALSE(InsertRecomputedNodes(graph_));
+  ASSERT_EQ(bprop_->input(2), relu_);
+}
+
+// the first backward user of ReLU has no gradient inputs, it keeps the forward ReLU and the next user recomputes it
+TEST_F(TestRecompute, test_first_user_without_gradients) {
+  auto relu = std::make_shared<Primitive>("ReLU");
+  relu->AddAttr(kAttrRecompute, MakeValue(true));
+  BuildGraph(relu);
+  auto zeros = graph_->NewCNode({NewValueNode(std::make_shared<Primitive>("ZerosLike")), relu_});
+  zeros->set_abstract(relu_->abstract());
+  zeros->set_scope(bprop_->scope());
+  manager_->SetEdge(grad_, 2, zeros);
+  ASSERT_TRUE(InsertRecomputedNodes(graph_));
+  ASSERT_EQ(zeros->input(1), relu_);
+  CheckRecomputed();
+}
+}  // namespace opt
+}  // namespace mindspore
@@ -1296,6 +1296,15 @@ TEST_F(TestDPAlgo, test_ConstructThreeSeparateGraphs) {
   ASSERT_EQ(GetStrategy(cost_graph), SUCCESS);
 }
 
+TEST_F(TestDPAlgo, test_GetStrategy_for_components) {
+  ConstructThreeSeparateGraphs();
+  ASSERT_EQ(cost_graph->ConstructIndependentComponents().size(), 4);
+  ASSERT_EQ(GetStrategy(cost_graph), SUCCESS);
+  for (auto &op : cost_graph->GetOperators()) {
+    ASSERT_NE(op->selected_strategy(), nullptr);
+  }
+}
+
 TEST_F(TestDPAlgo, test_ConstructTwoSeparateGraphs) {
   ConstructTwoSeparateGraphs();
   ASSERT_EQ(GetStrategy(cost_graph), SUCCESS);
@@ -303,6 +303,34 @@ TEST_F(TestCostGraph, test_ConstructConnectedComponents) {
   ASSERT_EQ(connected_coms[1]->GetOriginalEdgeBetweenOperators(matmul3, matmul4)[0].get(), edge_m3_m4.get());
 }
 
+TEST_F(TestCostGraph, test_ConstructIndependentComponents) {
+  CostGraph entire_cost_graph;
+  std::string edge_name = "MatMul-MatMul";
+  std::shared_ptr<Edge> edge_m1_m2 = std::make_shared<Edge>(edge_name, matmul1, matmul2, 0, 0, false);
+  matmul1->AddSuccEdge(edge_m1_m2);
+  matmul2->AddPrevEdge(edge_m1_m2);
+  std::shared_ptr<Edge> edge_m3_m2 = std::make_shared<Edge>(edge_name, matmul3, matmul2, 0, 1, false);
+  matmul3->AddSuccEdge(edge_m3_m2);
+  matmul2->AddPrevEdge(edge_m3_m2);
+  std::shared_ptr<Edge> edge_m4_m5 = std::make_shared<Edge>(edge_name, matmul4, matmul5, 0, 0, false);
+  matmul4->AddSuccEdge(edge_m4_m5);
+  matmul5->AddPrevEdge(edge_m4_m5);
+  entire_cost_graph.AddOperator(matmul1);
+  entire_cost_graph.AddOperator(matmul4);
+  entire_cost_graph.AddOperator(matmul3);
+  entire_cost_graph.AddOperator(matmul2);
+  entire_cost_graph.AddOperator(matmul5);
+  auto components = entire_cost_graph.ConstructIndependentComponents();
+  ASSERT_EQ(components.size(), 2);
+  // the components keep the order of the operators in the graph, instead of the order of the traversal
+  std::vector<OperatorInfoPtr> first_ops = {matmul1, matmul3, matmul2};
+  std::vector<OperatorInfoPtr> second_ops = {matmul4, matmul5};
+  ASSERT_EQ(components[0]->GetOperators(), first_ops);
+  ASSERT_EQ(components[1]->GetOperators(), second_ops);
+  ASSERT_EQ(components[0]->GetOriginalEdgeBetweenOperators(matmul3, matmul2)[0], edge_m3_m2);
+  ASSERT_EQ(components[1]->GetOriginalEdgeBetweenOperators(matmul4, matmul5)[0], edge_m4_m5);
+}
+
 TEST_F(TestCostGraph, test_SelectCostListWithMinTrainingTimeMultiple) {
   CostGraph entire_cost_graph;
   entire_cost_graph.SetDeviceMemoryAndCostParameter();
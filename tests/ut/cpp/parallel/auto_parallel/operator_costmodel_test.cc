@@ -14,11 +14,13 @@
  * limitations under the License.
  */
 
+#include <fstream>
 #include <common/common_test.h>
 #include "frontend/parallel/tensor_layout/tensor_layout.h"
 #include "frontend/parallel/tensor_layout/tensor_info.h"
 #include "frontend/parallel/auto_parallel/operator_costmodel.h"
 #include "frontend/parallel/device_manager.h"
+#include "frontend/parallel/costmodel_context.h"
 
 namespace mindspore {
 namespace parallel {
@@ -80,6 +82,99 @@ TEST_F(TestMatMulCost, test_CostGeneration) {
   mmcost_.GetForwardComputationCost(inputs, outputs, 0);
 }
 
+TEST_F(TestMatMulCost, test_CostCache) {
+  TensorLayout input0_layout, input1_layout, output0_layout;
+  Shape input0_shape{200, 300}, input1_shape{300, 500}, output0_shape{200, 500};
+  Shape input0_slice_shape{20, 50}, input1_slice_shape{50, 25}, output0_slice_shape{20, 25};
+  TensorInfo input0(input0_layout, input0_shape, input0_slice_shape),
+    input1(input1_layout, input1_shape, input1_slice_shape),
+    output0(output0_layout, output0_shape, output0_slice_shape);
+  std::vector<TensorInfo> inputs = {input0, input1}, outputs = {output0};
+
+  auto cost1 = std::make_shared<MatMulCost>();
+  auto cost2 = std::make_shared<MatMulCost>();
+  for (auto &cost : {cost1, cost2}) {
+    cost->set_is_parameter({false, true});
+    cost->SetInputAndOutputTypeLength({4, 4}, {4});
+  }
+  auto &cache = OperatorCostCache::GetInstance();
+  cache.Clear();
+  auto value1 = cache.GetCost(cost1, inputs, outputs, 0);
+  ASSERT_DOUBLE_EQ(value1.forward_computation_cost, cost1->GetForwardComputationCost(inputs, outputs, 0));
+  ASSERT_DOUBLE_EQ(value1.communication_cost, cost1->GetCommCost(inputs, outputs, 0));
+  ASSERT_DOUBLE_EQ(value1.forward_communication_cost, cost1->GetForwardCommCost(inputs, outputs, 0));
+  // an operator of the same type and shapes shares the costs
+  auto value2 = cache.GetCost(cost2, inputs, outputs, 0);
+  ASSERT_DOUBLE_EQ(value2.communication_cost, value1.communication_cost);
+  ASSERT_EQ(cache.hit_count(), 1);
+  ASSERT_EQ(cache.miss_count(), 1);
+
+  // the costs differ under another strategy, or when the weight is not a parameter
+  TensorInfo split_input0(input0_layout, input0_shape, Shape{200, 50});
+  (void)cache.GetCost(cost1, {split_input0, input1}, outputs, 0);
+  cost2->set_is_parameter({false, false});
+  auto value3 = cache.GetCost(cost2, inputs, outputs, 0);
+  ASSERT_DOUBLE_EQ(value3.communication_cost, cost2->GetCommCost(inputs, outputs, 0));
+  ASSERT_EQ(cache.miss_count(), 3);
+  ASSERT_EQ(cache.size(), 3);
+  cache.Clear();
+}
+
+TEST_F(TestMatMulCost, test_CalibratedCost) {
+  std::string calibration_file = "./cost_model_calibration_test.json";
+  std::ofstream(calibration_file) << R"({"computation": {"MatMul": 4e-4, "ReLU": 1e-4, "Softmax": 2e-4},)"
+                                  << R"( "communication": 1e-3})";
+  auto cm_context = CostModelContext::GetInstance();
+  cm_context->set_costmodel_alpha(2.0);
+  double uncalibrated_beta = cm_context->costmodel_beta();
+  cm_context->set_costmodel_calibration_file(calibration_file);
+  // the scales are relative to the median coefficient, of Softmax
+  ASSERT_DOUBLE_EQ(cm_context->computation_scale("MatMul"), 2.0);
+  ASSERT_DOUBLE_EQ(cm_context->computation_scale("ReLU"), 0.5);
+  ASSERT_DOUBLE_EQ(cm_context->computation_scale("GatherV2"), 1.0);
+  ASSERT_DOUBLE_EQ(cm_context->costmodel_beta(), 10.0);
+  ASSERT_EQ(cm_context->costmodel_calibration_file(), calibration_file);
+
+  TensorLayout input0_layout, input1_layout, output0_layout;
+  TensorInfo input0(input0_layout, {200, 300}, {20, 50}), input1(input1_layout, {300, 500}, {50, 25}),
+    output0(output0_layout, {200, 500}, {20, 25});
+  std::vector<TensorInfo> inputs = {input0, input1}, outputs = {output0};
+  auto cost = std::make_shared<MatMulCost>();
+  auto calibrated_cost = std::make_shared<MatMulCost>();
+  calibrated_cost->set_computation_scale(cm_context->computation_scale("MatMul"));
+  auto &cache = OperatorCostCache::GetInstance();
+  cache.Clear();
+  auto value = cache.GetCost(cost, inputs, outputs, 0);
+  // the calibrated operator shares the cached costs and scales its computation cost
+  auto calibrated_value = cache.GetCost(calibrated_cost, inputs, outputs, 0);
+  ASSERT_EQ(cache.hit_count(), 1);
+  ASSERT_DOUBLE_EQ(calibrated_value.forward_computation_cost, 2.0 * value.forward_computation_cost);
+  ASSERT_DOUBLE_EQ(calibrated_value.communication_cost, value.communication_cost);
+  cache.Clear();
+
+  // clearing the file restores everything it calibrated
+  cm_context->set_costmodel_calibration_file("");
+  ASSERT_TRUE(cm_context->costmodel_calibration_file().empty());
+  ASSERT_DOUBLE_EQ(cm_context->computation_scale("MatMul"), 1.0);
+  ASSERT_DOUBLE_EQ(cm_context->costmodel_beta(), uncalibrated_beta);
+  // a file without the communication coefficient does not keep the beta of the file loaded before
+  cm_context->set_costmodel_calibration_file(calibration_file);
+  std::ofstream(calibration_file) << R"({"computation": {"MatMul": 4e-4}})";
+  cm_context->set_costmodel_calibration_file(calibration_file);
+  ASSERT_DOUBLE_EQ(cm_context->costmodel_beta(), uncalibrated_beta);
+  // a beta set explicitly is kept
+  cm_context->set_costmodel_beta(3.0);
+  cm_context->set_costmodel_calibration_file("");
+  ASSERT_DOUBLE_EQ(cm_context->costmodel_beta(), 3.0);
+
+  cm_context->ResetCostModel();
+  ASSERT_TRUE(cm_context->costmodel_calibration_file().empty());
+  ASSERT_DOUBLE_EQ(cm_context->computation_scale("MatMul"), 1.0);
+  std::ofstream(calibration_file) << R"({"communication": 1e-3})";
+  EXPECT_THROW(cm_context->set_costmodel_calibration_file(calibration_file), std::runtime_error);
+  (void)remove(calibration_file.c_str());
+}
+
 class TestActivationCost : public UT::Common {
  public:
   TestActivationCost() {}
@@ -0,0 +1,227 @@
+/**
+ * Copyright 2020 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <algorithm>
+#include <unordered_map>
+#include <vector>
+#include "common/common_test.h"
+#include "frontend/parallel/pipeline_transformer/pipeline_scheduler.h"
+#include "frontend/parallel/ops_info/ops_utils.h"
+#include "abstract/abstract_value.h"
+#include "base/core_ops.h"
+#include "ir/graph_utils.h"
+#include "ir/manager.h"
+
+namespace mindspore {
+namespace parallel {
+
+class TestPipelineScheduler : public UT::Common {
+ public:
+  TestPipelineScheduler() {}
+};
+
+// check every forward and backward of the stage runs once, and the backward runs after its forward
+void ScheduleCheck(const std::vector<PipelineOp> &ops, int64_t micro_num, int64_t chunk_num) {
+  ASSERT_EQ(ops.size(), 2 * micro_num * chunk_num);
+  for (int64_t micro = 0; micro < micro_num; ++micro) {
+    for (int64_t chunk = 0; chunk < chunk_num; ++chunk) {
+      auto forward = std::find(ops.begin(), ops.end(), PipelineOp{PIPELINE_FORWARD, micro, chunk});
+      auto backward = std::find(ops.begin(), ops.end(), PipelineOp{PIPELINE_BACKWARD, micro, chunk});
+      ASSERT_TRUE(backward != ops.end());
+      ASSERT_TRUE(forward < backward);
+    }
+  }
+}
+
+TEST_F(TestPipelineScheduler, TestSchedule1F1B) {
+  PipelineScheduler scheduler(4, 8);
+  ASSERT_EQ(scheduler.Init(), Status::SUCCESS);
+  ASSERT_EQ(PipelineScheduler::ToString(scheduler.Schedule(0, PIPELINE_1F1B)),
+            "F0 F1 F2 F3 B0 F4 B1 F5 B2 F6 B3 F7 B4 B5 B6 B7");
+  ASSERT_EQ(PipelineScheduler::ToString(scheduler.Schedule(3, PIPELINE_1F1B)),
+            "F0 B0 F1 B1 F2 B2 F3 B3 F4 B4 F5 B5 F6 B6 F7 B7");
+  ASSERT_EQ(PipelineScheduler::ToString(scheduler.Schedule(1, PIPELINE_GPIPE)),
+            "F0 F1 F2 F3 F4 F5 F6 F7 B0 B1 B2 B3 B4 B5 B6 B7");
+  for (int64_t stage = 0; stage < 4; ++stage) {
+    ScheduleCheck(scheduler.Schedule(stage, PIPELINE_1F1B), 8, 1);
+  }
+
+  // fewer micro batches than stages only warm up
+  PipelineScheduler few_scheduler(4, 2);
+  ASSERT_EQ(PipelineScheduler::ToString(few_scheduler.Schedule(0, PIPELINE_1F1B)), "F0 F1 B0 B1");
+}
+
+// the bubble fraction is (p - 1) / (m + p - 1) for p stages and m micro batches, and the one forward one backward keeps
+// the activations of p - s micro batches on stage s instead of m
+TEST_F(TestPipelineScheduler, TestSimulate1F1B) {
+  PipelineScheduler scheduler(4, 8);
+  PipelineCost cost;
+  PipelineReport report;
+  ASSERT_EQ(scheduler.Simulate(PIPELINE_1F1B, cost, &report), Status::SUCCESS);
+  ASSERT_DOUBLE_EQ(report.total_time, 33.0);
+  ASSERT_NEAR(report.bubble_fraction, 3.0 / 11, 1e-9);
+  ASSERT_EQ(report.stages.size(), 4);
+  for (size_t stage = 0; stage < 4; ++stage) {
+    ASSERT_DOUBLE_EQ(report.stages[stage].busy_time, 24.0);
+    ASSERT_NEAR(report.stages[stage].bubble_fraction, 3.0 / 11, 1e-9);
+    ASSERT_DOUBLE_EQ(report.stages[stage].peak_activation_size, 4.0 - stage);
+  }
+
+  PipelineReport gpipe_report;
+  ASSERT_EQ(scheduler.Simulate(PIPELINE_GPIPE, cost, &gpipe_report), Status::SUCCESS);
+  ASSERT_DOUBLE_EQ(gpipe_report.total_time, report.total_time);
+  for (auto &stage_report : gpipe_report.stages) {
+    ASSERT_DOUBLE_EQ(stage_report.peak_activation_size, 8.0);
+  }
+
+  // more micro batches fill the pipeline
+  PipelineScheduler more_scheduler(4, 32);
+  PipelineReport more_report;
+  ASSERT_EQ(more_scheduler.Simulate(PIPELINE_1F1B, cost, &more_report), Status::SUCCESS);
+  ASSERT_NEAR(more_report.bubble_fraction, 3.0 / 35, 1e-9);
+  ASSERT_DOUBLE_EQ(more_report.stages[0].peak_activation_size, 4.0);
+}
+
+// the interleaved schedule of v chunks shrinks the bubble to (p - 1) / v
+TEST_F(TestPipelineScheduler, TestSimulateInterleaved) {
+  PipelineScheduler scheduler(4, 8, 2);
+  ASSERT_EQ(scheduler.Init(), Status::SUCCESS);
+  for (int64_t stage = 0; stage < 4; ++stage) {
+    ScheduleCheck(scheduler.Schedule(stage, PIPELINE_1F1B), 8, 2);
+  }
+  PipelineCost cost;
+  PipelineReport report;
+  ASSERT_EQ(scheduler.Simulate(PIPELINE_1F1B, cost, &report), Status::SUCCESS);
+  ASSERT_DOUBLE_EQ(report.total_time, 24.0 + 3.0 * 3 / 2);
+  ASSERT_NEAR(report.bubble_fraction, 4.5 / 28.5, 1e-9);
+  ASSERT_LT(report.stages[0].peak_activation_size, 8.0);
+
+  // the micro batches of a chunk run in the groups of the stages
+  PipelineScheduler invalid_scheduler(4, 6, 2);
+  ASSERT_EQ(invalid_scheduler.Init(), Status::FAILED);
+  ASSERT_EQ(invalid_scheduler.Simulate(PIPELINE_1F1B, cost, &report), Status::FAILED);
+}
+
+// the send and receive between the stages delay the warmup and the cooldown
+TEST_F(TestPipelineScheduler, TestSimulateP2P) {
+  PipelineScheduler scheduler(2, 4);
+  PipelineCost cost;
+  cost.p2p_time = 0.5;
+  cost.activation_size = 1024.0;
+  PipelineReport report;
+  ASSERT_EQ(scheduler.Simulate(PIPELINE_1F1B, cost, &report), Status::SUCCESS);
+  // without the sends the 4 micro batches take (4 + 1) * 3, while the backward of stage 0 waits for the sends to and
+  // from stage 1
+  ASSERT_DOUBLE_EQ(report.total_time, 15.0 + 2.0);
+  ASSERT_DOUBLE_EQ(report.stages[0].peak_activation_size, 2048.0);
+  ASSERT_DOUBLE_EQ(report.stages[1].peak_activation_size, 1024.0);
+}
+
+// The graph after automatic differentiation, where the forward of micro batch m is ReLU(x[m]) and the backward is
+// Mul(Mul(dout, ReLU(x[m])), x[m]) in the scope of the gradients. The gradients of the micro batches are summed.
+class MicroBatchGraph {
+ public:
+  explicit MicroBatchGraph(int64_t micro_num) {
+    graph_ = std::make_shared<FuncGraph>();
+    auto abs = std::make_shared<abstract::AbstractTensor>(kFloat32, std::vector<int64_t>{8, 8});
+    auto x = graph_->add_parameter();
+    x->set_abstract(abs);
+    auto dout = graph_->add_parameter();
+    dout->set_abstract(abs);
+    auto bprop_scope = std::make_shared<Scope>("Gradients/Default/network");
+    AnfNodePtr grad_sum = nullptr;
+    for (int64_t micro = 0; micro < micro_num; ++micro) {
+      auto slice_prim = std::make_shared<Primitive>("StridedSlice");
+      slice_prim->AddAttr(MICRO, MakeValue(micro));
+      auto slice = NewCNode(slice_prim, {x}, abs);
+      auto relu = NewCNode(std::make_shared<Primitive>("ReLU"), {slice}, abs);
+      forward_.push_back({slice, relu});
+      auto grad = NewCNode(std::make_shared<Primitive>("Mul"), {dout, relu}, abs, bprop_scope);
+      auto bprop = NewCNode(std::make_shared<Primitive>("Mul"), {grad, slice}, abs, bprop_scope);
+      backward_.push_back({grad, bprop});
+      grad_sum = grad_sum == nullptr ? bprop : NewCNode(prim::kPrimTensorAdd, {grad_sum, bprop}, abs, bprop_scope);
+    }
+    graph_->set_output(grad_sum);
+    manager_ = Manage(graph_);
+  }
+
+  CNodePtr NewCNode(const PrimitivePtr &prim, const std::vector<AnfNodePtr> &inputs, const AbstractBasePtr &abs,
+                    const ScopePtr &scope = nullptr) {
+    std::vector<AnfNodePtr> node_inputs{NewValueNode(prim)};
+    node_inputs.insert(node_inputs.end(), inputs.begin(), inputs.end());
+    auto node = graph_->NewCNode(node_inputs);
+    node->set_abstract(abs);
+    if (scope != nullptr) {
+      node->set_scope(scope);
+    }
+    return node;
+  }
+
+  // any execution order of the graph runs the forward and backward in the order of the schedule
+  void CheckOrder(const std::vector<PipelineOp> &ops) {
+    std::unordered_map<AnfNodePtr, size_t> position;
+    auto order = TopoSort(graph_->get_return());
+    for (size_t i = 0; i < order.size(); ++i) {
+      position[order[i]] = i;
+    }
+    for (size_t i = 1; i < ops.size(); ++i) {
+      auto &prev = ops[i - 1].type == PIPELINE_FORWARD ? forward_[ops[i - 1].micro] : backward_[ops[i - 1].micro];
+      auto &next = ops[i].type == PIPELINE_FORWARD ? forward_[ops[i].micro] : backward_[ops[i].micro];
+      for (auto &prev_node : prev) {
+        for (auto &next_node : next) {
+          ASSERT_TRUE(IsAncestor(prev_node, next_node)) << prev_node->DebugString() << " " << next_node->DebugString();
+          ASSERT_LT(position[prev_node], position[next_node]);
+        }
+      }
+    }
+  }
+
+  bool IsAncestor(const AnfNodePtr &ancestor, const AnfNodePtr &node) {
+    auto nodes = DeepLinkedGraphSearch(node);
+    return std::find(nodes.begin(), nodes.end(), ancestor) != nodes.end();
+  }
+
+  FuncGraphPtr graph_;
+  FuncGraphManagerPtr manager_;
+  std::vector<std::vector<AnfNodePtr>> forward_;
+  std::vector<std::vector<AnfNodePtr>> backward_;
+};
+
+TEST_F(TestPipelineScheduler, TestEnforceSchedule) {
+  PipelineScheduler scheduler(2, 4);
+  for (int64_t stage = 0; stage < 2; ++stage) {
+    MicroBatchGraph micro_graph(4);
+    // the forward of the micro batches are independent before the schedule is enforced
+    ASSERT_FALSE(micro_graph.IsAncestor(micro_graph.forward_[0][1], micro_graph.forward_[1][0]));
+    ASSERT_TRUE(EnforceMicroBatchSchedule(micro_graph.graph_, stage, 2));
+    micro_graph.CheckOrder(scheduler.Schedule(stage, PIPELINE_1F1B));
+  }
+  // the first stage runs the forward of micro batch 1 before the backward of micro batch 0, the last one does not
+  MicroBatchGraph first_stage(4);
+  ASSERT_TRUE(EnforceMicroBatchSchedule(first_stage.graph_, 0, 2));
+  ASSERT_TRUE(first_stage.IsAncestor(first_stage.forward_[1][1], first_stage.backward_[0][0]));
+  MicroBatchGraph last_stage(4);
+  ASSERT_TRUE(EnforceMicroBatchSchedule(last_stage.graph_, 1, 2));
+  ASSERT_TRUE(last_stage.IsAncestor(last_stage.backward_[0][1], last_stage.forward_[1][0]));
+
+  // a graph of one micro batch is not changed
+  MicroBatchGraph single_graph(1);
+  auto node_num = single_graph.graph_->nodes().size();
+  ASSERT_FALSE(EnforceMicroBatchSchedule(single_graph.graph_, 0, 2));
+  ASSERT_EQ(single_graph.graph_->nodes().size(), node_num);
+}
+}  // namespace parallel
+}  // namespace mindspore
@@ -0,0 +1,147 @@
+/**
+ * Copyright 2020 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "common/common_test.h"
+#include "frontend/parallel/tensor_layout/redistribution_planner.h"
+#include "frontend/parallel/device_manager.h"
+#include "util_layout_gen_test.h"
+
+namespace mindspore {
+namespace parallel {
+
+class TestRedistributionPlanner : public UT::Common {
+ public:
+  TestRedistributionPlanner() {}
+
+  void SetUp() {
+    RankList dev_list;
+    for (int32_t i = 0; i < 64; i++) {
+      dev_list.push_back(i);
+    }
+    RankList stage_map;
+    stage_map.push_back(64);
+    int32_t local_dev = 0;
+
+    // create a new g_device_manager
+    g_device_manager = std::make_shared<DeviceManager>();
+    g_device_manager->Init(dev_list, local_dev, stage_map, "hccl");
+    RedistributionPlanner::GetInstance().Clear();
+  }
+
+  virtual void TearDown() { RedistributionPlanner::GetInstance().Clear(); }
+};
+
+TensorLayout MakeLayout(const Shape &dev_mat, const Shape &tensor_map, const Shape &tensor_shape) {
+  Arrangement device_arrangement;
+  device_arrangement.Init(dev_mat);
+  Map map;
+  map.Init(tensor_map);
+  Arrangement shape;
+  shape.Init(tensor_shape);
+  TensorLayout layout;
+  layout.Init(device_arrangement, map, shape);
+  return layout;
+}
+
+// check if in_tensor_map is changed to out_tensor_map by the operators of the plan
+void PlanCheck(Shape in_tensor_map, const Shape &out_tensor_map, const RedistributionPlan &plan) {
+  int64_t collective_num = 0;
+  for (auto &op : plan.operators) {
+    Args args = op.second;
+    if (op.first == SPLIT_BY_AXIS) {
+      ASSERT_EQ(args.size(), 3);
+      in_tensor_map[args[1]] = args[2];
+      continue;
+    }
+    ++collective_num;
+    if (op.first == PERMUTE_BY_AXIS) {
+      ASSERT_EQ(args.size(), 5);
+      in_tensor_map[args[1]] = args[3];
+      in_tensor_map[args[2]] = -1;
+    } else {
+      ASSERT_EQ(args.size(), 3);
+      in_tensor_map[args[0]] = -1;
+    }
+  }
+  ASSERT_EQ(in_tensor_map, out_tensor_map);
+  ASSERT_EQ(collective_num, plan.collective_num);
+}
+
+// the plans of all the pairs of tensor maps reach the target, and cost no more than the greedy ones
+TEST_F(TestRedistributionPlanner, TestGetPlanAll) {
+  Shape dev_mat = {2, 4, 8};
+  Shape tensor_shape = {64, 256, 128};
+  Shapes tensor_map_list;
+  GenerateValidTensorMap(dev_mat, tensor_shape, &tensor_map_list);
+  ASSERT_GT(tensor_map_list.size(), 1);
+  for (auto &in_tensor_map : tensor_map_list) {
+    TensorLayout layout = MakeLayout(dev_mat, in_tensor_map, tensor_shape);
+    for (auto &out_tensor_map : tensor_map_list) {
+      Map out_map;
+      out_map.Init(out_tensor_map);
+      RedistributionPlan plan;
+      ASSERT_EQ(RedistributionPlanner::GetInstance().GetPlan(layout, out_map, &plan), Status::SUCCESS);
+      PlanCheck(in_tensor_map, out_tensor_map, plan);
+    }
+  }
+  ASSERT_EQ(RedistributionPlanner::GetInstance().plan_num(), tensor_map_list.size() * tensor_map_list.size());
+  ASSERT_GT(RedistributionPlanner::GetInstance().improved_plan_num(), 0);
+  ASSERT_GT(RedistributionPlanner::GetInstance().saved_cost(), 0.0);
+}
+
+// the greedy inference permutes the last dimension to the middle one with cat_dim 2, while gathering the last
+// dimension and splitting the middle one costs less
+TEST_F(TestRedistributionPlanner, TestGetPlanImproved) {
+  TensorLayout layout = MakeLayout({2, 4, 8}, {-1, -1, 1}, {64, 256, 128});
+  Map out_map;
+  out_map.Init({-1, 1, -1});
+  RedistributionPlan plan;
+  ASSERT_EQ(RedistributionPlanner::GetInstance().GetPlan(layout, out_map, &plan), Status::SUCCESS);
+  PlanCheck({-1, -1, 1}, {-1, 1, -1}, plan);
+  ASSERT_EQ(plan.collective_num, 1);
+  ASSERT_EQ(plan.operators.size(), 2);
+  ASSERT_EQ(plan.operators[0].first, CONCAT_BY_AXIS);
+  ASSERT_EQ(plan.operators[1].first, SPLIT_BY_AXIS);
+  ASSERT_EQ(RedistributionPlanner::GetInstance().improved_plan_num(), 1);
+}
+
+TEST_F(TestRedistributionPlanner, TestPlanCache) {
+  TensorLayout layout = MakeLayout({2, 4, 8}, {2, -1, 1}, {64, 256, 128});
+  Map out_map;
+  out_map.Init({-1, 2, 0});
+  RedistributionPlan plan1;
+  ASSERT_EQ(RedistributionPlanner::GetInstance().GetPlan(layout, out_map, &plan1), Status::SUCCESS);
+  ASSERT_EQ(RedistributionPlanner::GetInstance().plan_num(), 1);
+  RedistributionPlan plan2;
+  ASSERT_EQ(RedistributionPlanner::GetInstance().GetPlan(layout, out_map, &plan2), Status::SUCCESS);
+  ASSERT_EQ(RedistributionPlanner::GetInstance().plan_num(), 1);
+  ASSERT_EQ(plan1.operators, plan2.operators);
+  ASSERT_EQ(plan1.cost, plan2.cost);
+
+  // the same tensor maps with another tensor shape is another plan
+  TensorLayout other_layout = MakeLayout({2, 4, 8}, {2, -1, 1}, {64, 256, 256});
+  ASSERT_EQ(RedistributionPlanner::GetInstance().GetPlan(other_layout, out_map, &plan2), Status::SUCCESS);
+  ASSERT_EQ(RedistributionPlanner::GetInstance().plan_num(), 2);
+
+  RedistributionPlanner::GetInstance().RecordInsertion(plan1.collective_num, 1024.0);
+  ASSERT_EQ(RedistributionPlanner::GetInstance().inserted_collective_num(), plan1.collective_num);
+  RedistributionPlanner::GetInstance().Clear();
+  ASSERT_EQ(RedistributionPlanner::GetInstance().plan_num(), 0);
+  ASSERT_EQ(RedistributionPlanner::GetInstance().inserted_collective_num(), 0);
+  ASSERT_EQ(RedistributionPlanner::GetInstance().inserted_received_bytes(), 0.0);
+}
+}  // namespace parallel
+}  // namespace mindspore
@@ -0,0 +1,95 @@
+/**
+ * Copyright 2020 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "common/backend_common_test.h"
+#include "common/py_func_graph_fetcher.h"
+#include "backend/optimizer/cpu/bias_add_fusion.h"
+#include "backend/optimizer/cpu/elemwise_fusion.h"
+#include "backend/session/anf_runtime_algorithm.h"
+#include "utils/utils.h"
+
+namespace mindspore {
+namespace opt {
+class TestHWCpuFusion : public BackendCommon {
+ public:
+  TestHWCpuFusion() : get_py_fun_("gtest_input.pre_activate.cpu_fusion_test", true) {}
+  ~TestHWCpuFusion() override = default;
+
+  UT::PyFuncGraphFetcher get_py_fun_;
+};
+
+TEST_F(TestHWCpuFusion, test_matmul_biasadd_relu_fusion) {
+  FuncGraphPtr g = get_py_fun_.CallAndParseRet("test_matmul_biasadd_relu_fusion", "before");
+  EXPECT_NE(g, nullptr);
+  AbstractBasePtrList args_spec_list;
+  args_spec_list.push_back(std::make_shared<abstract::AbstractTensor>(kFloat32, std::vector<int64_t>{2, 3}));
+  args_spec_list.push_back(std::make_shared<abstract::AbstractTensor>(kFloat32, std::vector<int64_t>{3, 4}));
+  args_spec_list.push_back(std::make_shared<abstract::AbstractTensor>(kFloat32, std::vector<int64_t>{4}));
+  auto kg = GetKernelGraph(g, args_spec_list);
+
+  auto optimizer = std::make_shared<opt::GraphOptimizer>();
+  auto pm = std::make_shared<opt::PassManager>();
+  pm->AddPass(std::make_shared<opt::CpuMatMulBiasAddFusion>());
+  pm->AddPass(std::make_shared<opt::CpuReluPostOpFusion>());
+  optimizer->AddPassManager(pm);
+  FuncGraphPtr new_graph = optimizer->Optimize(kg);
+
+  FuncGraphPtr g_after = get_py_fun_.CallAndParseRet("test_matmul_biasadd_relu_fusion", "after");
+  EXPECT_TRUE(CheckEqualGraph(g_after, new_graph));
+  auto fused = new_graph->output()->cast<CNodePtr>()->input(1)->cast<CNodePtr>();
+  ASSERT_NE(fused, nullptr);
+  EXPECT_EQ(AnfAlgo::GetNodeAttr<std::string>(fused, kAttrActivation), kReluOpName);
+}
+
+TEST_F(TestHWCpuFusion, test_elemwise_fusion) {
+  FuncGraphPtr g = get_py_fun_.CallAndParseRet("test_elemwise_fusion", "before");
+  EXPECT_NE(g, nullptr);
+  std::vector<int64_t> shp{2, 32};
+  auto x_abstract = std::make_shared<abstract::AbstractTensor>(kFloat32, shp);
+  AbstractBasePtrList args_spec_list{x_abstract, x_abstract, x_abstract};
+  auto kg = GetKernelGraph(g, args_spec_list);
+
+  auto optimizer = std::make_shared<opt::GraphOptimizer>();
+  auto pm = std::make_shared<opt::PassManager>();
+  pm->AddPass(std::make_shared<opt::CpuElemwiseFusion>());
+  optimizer->AddPassManager(pm);
+  FuncGraphPtr new_graph = optimizer->Optimize(kg);
+
+  // relu(sub(sqrt(add(mul, input2)), mul)) is one fused op, mul stays as it has two users
+  std::vector<CNodePtr> fused_nodes;
+  size_t mul_num = 0;
+  for (const auto &node : TopoSort(new_graph->get_return())) {
+    if (!node->isa<CNode>() || !AnfAlgo::IsRealKernel(node)) {
+      continue;
+    }
+    auto name = AnfAlgo::GetCNodeName(node);
+    if (name == kFusedElemwiseName) {
+      fused_nodes.push_back(node->cast<CNodePtr>());
+    } else if (name == kMulOpName) {
+      ++mul_num;
+    }
+  }
+  ASSERT_EQ(fused_nodes.size(), 1);
+  EXPECT_EQ(mul_num, 1);
+  auto fused = fused_nodes[0];
+  std::vector<std::string> expect_ops = {kTensorAddOpName, kSqrtOpName, kSubOpName, kReluOpName};
+  EXPECT_EQ(AnfAlgo::GetNodeAttr<std::vector<std::string>>(fused, kAttrFusedOps), expect_ops);
+  // inputs: mul, input2
+  std::vector<int64_t> expect_inputs = {0, 1, -1, 0, -2, 0, -3, 0};
+  EXPECT_EQ(AnfAlgo::GetNodeAttr<std::vector<int64_t>>(fused, kAttrFusedOpInputs), expect_inputs);
+  EXPECT_EQ(AnfAlgo::GetInputTensorNum(fused), 2);
+}
+}  // namespace opt
+}  // namespace mindspore
@@ -0,0 +1,272 @@
+/**
+ * Copyright 2020 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <chrono>
+#include <cmath>
+#include <cstring>
+#include <random>
+#include <vector>
+#include "common/common_test.h"
+#include "backend/optimizer/mem_reuse/optimizer_offload_manager.h"
+#include "runtime/device/convert_tensor_utils.h"
+
+namespace mindspore {
+namespace device {
+namespace memswap {
+namespace {
+constexpr float kLr = 0.01;
+constexpr float kBeta1 = 0.9;
+constexpr float kBeta2 = 0.999;
+constexpr float kEpsilon = 1e-8;
+
+// the Adam of a parameter without the host states, as the device runs it
+struct ReferenceAdam {
+  std::vector<float> weight;
+  std::vector<float> m;
+  std::vector<float> v;
+
+  void Update(const std::vector<float> &grad, const std::vector<float> &hyper_params, bool use_nesterov) {
+    float beta1_power = hyper_params[0];
+    float beta2_power = hyper_params[1];
+    float beta1 = hyper_params[3];
+    float beta2 = hyper_params[4];
+    float epsilon = hyper_params[5];
+    float lr = hyper_params[2] * std::sqrt(1 - beta2_power) / (1 - beta1_power);
+    for (size_t i = 0; i < weight.size(); ++i) {
+      m[i] = beta1 * m[i] + (1 - beta1) * grad[i];
+      v[i] = beta2 * v[i] + (1 - beta2) * grad[i] * grad[i];
+      float update = use_nesterov ? m[i] * beta1 + (1 - beta1) * grad[i] : m[i];
+      weight[i] -= lr * update / (std::sqrt(v[i]) + epsilon);
+    }
+  }
+};
+
+std::vector<float> RandomData(size_t elem_num, std::mt19937 *engine) {
+  std::normal_distribution<float> distribution(0, 1);
+  std::vector<float> data(elem_num);
+  for (auto &value : data) {
+    value = distribution(*engine);
+  }
+  return data;
+}
+
+// the data of weight_type on the device
+std::vector<float> DeviceData(std::vector<float> data, TypeId weight_type) {
+  if (weight_type == kNumberTypeFloat16) {
+    std::vector<float16> half_data(data.size());
+    FloatToHalf(half_data.data(), data.data(), data.size());
+    HalfToFloat(data.data(), half_data.data(), data.size());
+  }
+  return data;
+}
+
+std::vector<float> HyperParams(size_t step, TypeId weight_type) {
+  return DeviceData({std::pow(kBeta1, step), std::pow(kBeta2, step), kLr, kBeta1, kBeta2, kEpsilon}, weight_type);
+}
+
+// the runtime copies the gradient and the hyper params of the step from the device before the update
+void CopyGradient(const OffloadParameterPtr &parameter, const std::vector<float> &grad, size_t step) {
+  auto hyper_params = HyperParams(step, parameter->weight_type_);
+  if (parameter->weight_type_ == kNumberTypeFloat16) {
+    FloatToHalf(parameter->grad_.addr, grad.data(), grad.size());
+    FloatToHalf(parameter->hyper_params_.addr, hyper_params.data(), hyper_params.size());
+  } else {
+    (void)memcpy(parameter->grad_.addr, grad.data(), grad.size() * sizeof(float));
+    (void)memcpy(parameter->hyper_params_.addr, hyper_params.data(), hyper_params.size() * sizeof(float));
+  }
+}
+}  // namespace
+
+class TestOptimizerOffloadManager : public UT::Common {
+ public:
+  TestOptimizerOffloadManager() {}
+
+  // run steps of the host Adam on the parameters, with the gradients pushed in the reverse order as backward, the odd
+  // parameters never use nesterov so the parameters of a manager may differ in it
+  void RunSteps(const std::vector<size_t> &sizes, TypeId weight_type, bool use_nesterov, size_t step_num) {
+    std::mt19937 engine(0);
+    OptimizerOffloadManager manager(nullptr);
+    std::vector<ReferenceAdam> references;
+    std::vector<std::vector<uint8_t>> device_weights;
+    for (size_t i = 0; i < sizes.size(); ++i) {
+      ReferenceAdam reference;
+      reference.weight = DeviceData(RandomData(sizes[i], &engine), weight_type);
+      reference.m.assign(sizes[i], 0);
+      reference.v.assign(sizes[i], 0);
+      std::vector<uint8_t> device_weight(sizes[i] * sizeof(float));
+      (void)memcpy(device_weight.data(), reference.weight.data(), device_weight.size());
+      if (weight_type == kNumberTypeFloat16) {
+        device_weight.resize(sizes[i] * sizeof(float16));
+        FloatToHalf(device_weight.data(), reference.weight.data(), sizes[i]);
+      }
+      device_weights.push_back(device_weight);
+      references.push_back(reference);
+    }
+    for (size_t i = 0; i < sizes.size(); ++i) {
+      ASSERT_EQ(manager.AddParameter("weight" + std::to_string(i), device_weights[i].data(), device_weights[i].data(),
+                                     sizes[i], weight_type, use_nesterov && i % 2 == 0),
+                i);
+    }
+
+    for (size_t step = 1; step <= step_num; ++step) {
+      for (size_t i = sizes.size(); i > 0; --i) {
+        auto grad = DeviceData(RandomData(sizes[i - 1], &engine), weight_type);
+        auto parameter = manager.parameter(i - 1);
+        manager.PushUpdate(i - 1, [parameter, grad, step]() {
+          CopyGradient(parameter, grad, step);
+          return true;
+        });
+        references[i - 1].Update(grad, HyperParams(step, weight_type), use_nesterov && (i - 1) % 2 == 0);
+      }
+      auto upload = [](void *device_weight, const void *host_weight, size_t size) {
+        (void)memcpy(device_weight, host_weight, size);
+        return true;
+      };
+      ASSERT_TRUE(manager.WaitStep(upload));
+    }
+
+    for (size_t i = 0; i < sizes.size(); ++i) {
+      auto parameter = manager.parameter(i);
+      auto master_weight = reinterpret_cast<float *>(parameter->master_weight_.addr);
+      auto m = reinterpret_cast<float *>(parameter->m_.addr);
+      auto v = reinterpret_cast<float *>(parameter->v_.addr);
+      std::vector<float> device_weight(sizes[i]);
+      if (weight_type == kNumberTypeFloat16) {
+        HalfToFloat(device_weight.data(), device_weights[i].data(), sizes[i]);
+      } else {
+        (void)memcpy(device_weight.data(), device_weights[i].data(), sizes[i] * sizeof(float));
+      }
+      for (size_t j = 0; j < sizes[i]; ++j) {
+        ASSERT_NEAR(master_weight[j], references[i].weight[j], 1e-5);
+        ASSERT_NEAR(m[j], references[i].m[j], 1e-5);
+        ASSERT_NEAR(v[j], references[i].v[j], 1e-5);
+        // the fp16 weight on device is rounded from the fp32 master weight
+        ASSERT_NEAR(device_weight[j], master_weight[j], std::abs(master_weight[j]) * 1e-3 + 1e-6);
+      }
+    }
+  }
+};
+
+TEST_F(TestOptimizerOffloadManager, TestAdamFloat32) {
+  RunSteps({1, 7, 1000, 4099}, kNumberTypeFloat32, false, 3);
+  RunSteps({33, 1024}, kNumberTypeFloat32, true, 3);
+}
+
+// the fp16 weight and gradient on device keep the fp32 master weight on host
+TEST_F(TestOptimizerOffloadManager, TestAdamFloat16MasterWeight) {
+  RunSteps({5, 2048}, kNumberTypeFloat16, false, 3);
+}
+
+// the failed copy of a gradient fails the step, while the other updates go on
+TEST_F(TestOptimizerOffloadManager, TestUpdateFailed) {
+  OptimizerOffloadManager manager(nullptr);
+  std::vector<float> weight(16, 1.0);
+  auto index = manager.AddParameter("weight", weight.data(), weight.data(), weight.size(), kNumberTypeFloat32);
+  std::vector<float> grad(16, 1.0);
+  auto parameter = manager.parameter(index);
+  manager.PushUpdate(index, []() { return false; });
+  ASSERT_FALSE(manager.WaitStep(nullptr));
+  manager.PushUpdate(index, [parameter, grad]() {
+    CopyGradient(parameter, grad, 1);
+    return true;
+  });
+  ASSERT_TRUE(manager.WaitStep(nullptr));
+  ASSERT_NEAR(reinterpret_cast<float *>(parameter->master_weight_.addr)[0], 1.0 - kLr, 1e-5);
+  // the weight is only uploaded by the upload function
+  ASSERT_EQ(weight[0], 1.0);
+
+  std::vector<float16> half_weight(4);
+  ASSERT_ANY_THROW(manager.AddParameter("int", half_weight.data(), half_weight.data(), 4, kNumberTypeInt32));
+}
+
+// the device reads and writes the states of weight_type, the rewritten elements are reloaded to the fp32 states
+TEST_F(TestOptimizerOffloadManager, TestReloadStates) {
+  OptimizerOffloadManager manager(nullptr);
+  std::vector<float> weight(4, 1.0);
+  auto fp32_index = manager.AddParameter("fp32", weight.data(), weight.data(), weight.size(), kNumberTypeFloat32);
+  auto fp32_parameter = manager.parameter(fp32_index);
+  ASSERT_EQ(fp32_parameter->weight_.addr, fp32_parameter->master_weight_.addr);
+  ASSERT_EQ(fp32_parameter->device_m_.addr, fp32_parameter->m_.addr);
+  ASSERT_EQ(fp32_parameter->device_v_.addr, fp32_parameter->v_.addr);
+
+  std::vector<float16> half_weight(4, float16(1.0));
+  auto index = manager.AddParameter("fp16", half_weight.data(), half_weight.data(), 4, kNumberTypeFloat16);
+  auto parameter = manager.parameter(index);
+  auto master_weight = reinterpret_cast<float *>(parameter->master_weight_.addr);
+  auto m = reinterpret_cast<float *>(parameter->m_.addr);
+  auto device_weight = reinterpret_cast<float16 *>(parameter->weight_.addr);
+  auto device_m = reinterpret_cast<float16 *>(parameter->device_m_.addr);
+  std::vector<float> grad(4, 0.3);
+  manager.PushUpdate(index, [parameter, grad]() {
+    CopyGradient(parameter, grad, 1);
+    return true;
+  });
+  ASSERT_TRUE(manager.WaitStep(nullptr));
+  std::vector<float> updated_weight(master_weight, master_weight + 4);
+  std::vector<float> updated_m(m, m + 4);
+  for (size_t i = 0; i < 4; ++i) {
+    ASSERT_EQ(half_to_float(device_weight[i]), half_to_float(float16(updated_weight[i])));
+    ASSERT_EQ(half_to_float(device_m[i]), half_to_float(float16(updated_m[i])));
+  }
+
+  // the checkpoint loads the first elements
+  device_weight[0] = float16(2.0);
+  device_m[0] = float16(0.5);
+  manager.ReloadStates(index);
+  ASSERT_EQ(master_weight[0], 2.0);
+  ASSERT_EQ(m[0], 0.5);
+  for (size_t i = 1; i < 4; ++i) {
+    ASSERT_EQ(master_weight[i], updated_weight[i]);
+    ASSERT_EQ(m[i], updated_m[i]);
+  }
+}
+
+// the updates run on the worker while the caller goes on, as the backward of the device
+TEST_F(TestOptimizerOffloadManager, TestUpdateThroughput) {
+  constexpr size_t kParameterNum = 8;
+  constexpr size_t kElemNum = 1 << 20;
+  constexpr size_t kStepNum = 5;
+  OptimizerOffloadManager manager(nullptr);
+  std::vector<std::vector<float>> weights(kParameterNum, std::vector<float>(kElemNum, 1.0));
+  std::vector<float> grad(kElemNum, 0.5);
+  for (size_t i = 0; i < kParameterNum; ++i) {
+    (void)manager.AddParameter("weight" + std::to_string(i), weights[i].data(), weights[i].data(), kElemNum,
+                               kNumberTypeFloat32);
+  }
+  double push_time = 0;
+  auto begin = std::chrono::steady_clock::now();
+  for (size_t step = 1; step <= kStepNum; ++step) {
+    auto push_begin = std::chrono::steady_clock::now();
+    for (size_t i = 0; i < kParameterNum; ++i) {
+      auto parameter = manager.parameter(i);
+      manager.PushUpdate(i, [parameter, &grad, step]() {
+        CopyGradient(parameter, grad, step);
+        return true;
+      });
+    }
+    push_time += std::chrono::duration<double>(std::chrono::steady_clock::now() - push_begin).count();
+    ASSERT_TRUE(manager.WaitStep(nullptr));
+  }
+  double total_time = std::chrono::duration<double>(std::chrono::steady_clock::now() - begin).count();
+  double throughput = kParameterNum * kElemNum * kStepNum / total_time;
+  MS_LOG(INFO) << "Host Adam updates " << throughput / 1e6 << "M elements per second, pushing the updates takes "
+               << push_time / total_time * 100 << "% of the time";
+  ASSERT_LT(push_time, total_time);
+  ASSERT_GT(throughput, 0);
+}
+}  // namespace memswap
+}  // namespace device
+}  // namespace mindspore
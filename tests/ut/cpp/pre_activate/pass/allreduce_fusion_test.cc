@@ -21,10 +21,12 @@
 #include "debug/anf_ir_dump.h"
 #include "backend/session/anf_runtime_algorithm.h"
 #include "backend/optimizer/pass/communication_op_fusion.h"
+#include "backend/optimizer/pass/communication_op_profile.h"
 #include "backend/optimizer/common/optimizer.h"
 #include "runtime/device/kernel_info.h"
 #include "backend/optimizer/common/pass_manager.h"
 #include "backend/kernel_compiler/kernel_build_info.h"
+#include "frontend/parallel/context.h"
 #include "utils/utils.h"
 #include "utils/ms_context.h"
 
@@ -218,5 +220,66 @@ TEST_F(TestHWAllReduceFusion, test_fusion_sorted) {
   EXPECT_NE(g_after, nullptr);
   EXPECT_TRUE(CheckEqualGraph(new_graph, g_after));
 }
+
+// the split indices profiled on another network of the group are not used, while the ones of the network are
+TEST_F(TestHWAllReduceFusion, test_fusion_profiled_split_indices) {
+  getPyFun_.SetDoResolve(true);
+  FuncGraphPtr g = getPyFun_.CallAndParseRet("test_all_reduce_fusion_all", "before");
+  EXPECT_NE(g, nullptr);
+  std::vector<int64_t> shp_x{1, 64, 112, 112};
+  auto x_abstract = std::make_shared<abstract::AbstractTensor>(kFloat32, shp_x);
+  AbstractBasePtrList args_spec_list{x_abstract, x_abstract, x_abstract, x_abstract, x_abstract};
+  auto func_graph = GetKernelGraph(g, args_spec_list);
+  EXPECT_NE(func_graph, nullptr);
+  // set kernel build info
+  kernel::KernelBuildInfo::KernelBuildInfoBuilder builder;
+  builder.SetInputsFormat({"NC1HWC0"});
+  builder.SetOutputsFormat({"NC1HWC0"});
+  builder.SetInputsDeviceType({kFloat32->type_id()});
+  builder.SetOutputsDeviceType({kFloat32->type_id()});
+  builder.SetFusionType(kernel::FusionType::ELEMWISE);
+  builder.SetProcessor(kernel::Processor::AICORE);
+  builder.SetKernelType(KernelType::AKG_KERNEL);
+  std::string group;
+  auto node_list = TopoSort(func_graph->get_return());
+  for (auto &node : node_list) {
+    if (node == nullptr) {
+      continue;
+    }
+    if ((node->isa<CNode>() && AnfAlgo::GetCNodeName(node) == kAllReduceOpName) || node->isa<Parameter>()) {
+      node->set_kernel_info(std::make_shared<device::KernelInfo>());
+      AnfAlgo::SetSelectKernelBuildInfo(builder.Build(), node.get());
+    }
+    if (node->isa<CNode>() && AnfAlgo::GetCNodeName(node) == kAllReduceOpName) {
+      auto primitive = AnfAlgo::GetCNodePrimitive(node);
+      // the group key of the fusion is group + op + fusion
+      group = GetValue<std::string>(primitive->GetAttr(kAttrGroup));
+      group += GetValue<std::string>(primitive->GetAttr(kAttrOp));
+      group += std::to_string(GetValue<int64_t>(primitive->GetAttr(kAttrFusion)));
+    }
+  }
+  float grad_bytes = 64 * 112 * 112 * sizeof(float);
+  auto parallel_context = parallel::ParallelContext::GetInstance();
+  parallel_context->SetAllReduceFusionSplitIndices(
+    {1, 2, 3, 4, 5, 6}, CommunicationOpProfile::NetworkGroupKey(group, std::vector<float>(7, grad_bytes)));
+  parallel_context->SetAllReduceFusionSplitIndices(
+    {2}, CommunicationOpProfile::NetworkGroupKey(group, std::vector<float>(5, grad_bytes)));
+  // do all reduce fusion
+  auto optimizer = std::make_shared<opt::GraphOptimizer>();
+  auto pm = std::make_shared<opt::PassManager>();
+  pm->AddPass(std::make_shared<opt::AllReduceFusion>());
+  optimizer->AddPassManager(pm);
+  FuncGraphPtr new_graph = optimizer->Optimize(func_graph);
+  parallel_context->Reset();
+  EXPECT_NE(new_graph, nullptr);
+  // check result
+  size_t all_reduce_num = 0;
+  for (auto &node : TopoSort(new_graph->get_return())) {
+    if (node != nullptr && node->isa<CNode>() && AnfAlgo::GetCNodeName(node) == kAllReduceOpName) {
+      ++all_reduce_num;
+    }
+  }
+  EXPECT_EQ(all_reduce_num, 2);
+}
 }  // namespace opt
 }  // namespace mindspore
@@ -0,0 +1,213 @@
+/**
+ * Copyright 2020 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <pthread.h>
+#include <sys/mman.h>
+#include <sys/wait.h>
+#include <unistd.h>
+#include <algorithm>
+#include <vector>
+#include "common/common_test.h"
+#include "backend/optimizer/pass/communication_op_profile.h"
+#include "frontend/parallel/context.h"
+
+namespace mindspore {
+namespace opt {
+namespace {
+constexpr char kGroup[] = "nccl_world_groupsum1";
+constexpr size_t kRankNum = 4;
+constexpr size_t kLayerNum = 8;
+constexpr size_t kMaxSplitNum = kLayerNum - 1;
+constexpr float kGradBytes = 256 * 1024;
+// the ranks waiting for a failed one are killed after the seconds
+constexpr unsigned int kRankTimeout = 60;
+// the latency and time per byte of the allreduce, and the backward time of each layer on the ranks, in us
+constexpr double kAllReduceLatency = 200;
+constexpr double kAllReduceTimePerByte = 1500.0 / kGradBytes;
+constexpr double kLayerTime[kRankNum] = {10, 1100, 2100, 3100};
+
+// the memory shared by the processes of the ranks, as the buffer of the collective
+struct SharedMemory {
+  pthread_barrier_t barrier;
+  float profile[kRankNum][kLayerNum + 2];
+  uint32_t split_num[kRankNum];
+  uint32_t split_indices[kRankNum][kMaxSplitNum];
+  uint32_t local_segment_num[kRankNum];
+};
+
+// average the profile of the ranks as the GPU runtime does by the allreduce of the world group
+void ReduceProfile(SharedMemory *shared, size_t rank, std::vector<float> *profile) {
+  std::copy(profile->begin(), profile->end(), shared->profile[rank]);
+  (void)pthread_barrier_wait(&shared->barrier);
+  for (size_t i = 0; i < profile->size(); ++i) {
+    float sum = 0;
+    for (size_t other = 0; other < kRankNum; ++other) {
+      sum += shared->profile[other][i];
+    }
+    (*profile)[i] = sum / kRankNum;
+  }
+  (void)pthread_barrier_wait(&shared->barrier);
+}
+
+// The gradients of the rank are produced from the last layer in backward, where the layers of the ranks take different
+// times. The rank profiles a step of the gradients fused into one allreduce, then reads the profiled split indices.
+int RunRank(SharedMemory *shared, size_t rank) {
+  auto &profile = CommunicationOpProfile::GetInstance();
+  profile.SetProfileReducer([shared, rank](std::vector<float> *ranks_profile) {
+    ReduceProfile(shared, rank, ranks_profile);
+  });
+  std::vector<float> grad_size(kLayerNum, kGradBytes);
+  std::vector<float> grad_time(kLayerNum);
+  profile.RegisterGroup(kGroup, grad_size, {kLayerNum - 1}, 1);
+  for (size_t layer = kLayerNum; layer > 0; --layer) {
+    grad_time[layer - 1] = static_cast<float>((kLayerNum - layer + 1) * kLayerTime[rank]);
+    profile.RecordGradReady(kGroup, layer - 1, grad_time[layer - 1]);
+  }
+  for (double bytes : {kGradBytes, kGradBytes * kLayerNum}) {
+    profile.RecordCommunication(bytes, kAllReduceLatency + kAllReduceTimePerByte * bytes);
+  }
+  profile.EndStep();
+  if (profile.recording()) {
+    return 1;
+  }
+  auto split_indices = profile.split_indices(kGroup);
+  if (split_indices.size() > kMaxSplitNum) {
+    return 1;
+  }
+  shared->split_num[rank] = split_indices.size();
+  std::copy(split_indices.begin(), split_indices.end(), shared->split_indices[rank]);
+  shared->local_segment_num[rank] =
+    SplitByBackwardTime(grad_time, grad_size, kAllReduceLatency, kAllReduceTimePerByte).size();
+  return 0;
+}
+}  // namespace
+
+class TestCommunicationOpProfile : public UT::Common {
+ public:
+  TestCommunicationOpProfile() {}
+  void SetUp() { CommunicationOpProfile::GetInstance().Clear(); }
+  void TearDown() {
+    CommunicationOpProfile::GetInstance().Clear();
+    parallel::ParallelContext::GetInstance()->Reset();
+  }
+};
+
+// all the gradients are ready together, so they are fused into one segment to pay the latency once
+TEST_F(TestCommunicationOpProfile, test_split_ready_together) {
+  std::vector<float> grad_time(6, 100);
+  std::vector<float> grad_size(6, 1000);
+  auto segment_index = SplitByBackwardTime(grad_time, grad_size, 10, 0.01);
+  ASSERT_EQ(segment_index, std::vector<size_t>({5}));
+  ASSERT_DOUBLE_EQ(SimulateSegments(grad_time, grad_size, segment_index, 10, 0.01), 170);
+}
+
+// the gradients are ready in the reverse order with the gaps longer than the allreduce, so each one is a segment
+TEST_F(TestCommunicationOpProfile, test_split_overlap) {
+  std::vector<float> grad_time = {500, 400, 300, 200, 100};
+  std::vector<float> grad_size(5, 1000);
+  auto segment_index = SplitByBackwardTime(grad_time, grad_size, 10, 0.05);
+  ASSERT_EQ(segment_index, std::vector<size_t>({0, 1, 2, 3, 4}));
+  ASSERT_DOUBLE_EQ(SimulateSegments(grad_time, grad_size, segment_index, 10, 0.05), 560);
+  ASSERT_DOUBLE_EQ(SimulateSegments(grad_time, grad_size, {4}, 10, 0.05), 760);
+}
+
+// the split is never worse than one segment, each op a segment, or the equal split
+TEST_F(TestCommunicationOpProfile, test_split_optimal) {
+  std::vector<float> grad_time = {900, 880, 700, 420, 410, 400, 150, 20};
+  std::vector<float> grad_size = {4000, 100, 2000, 8000, 100, 100, 3000, 500};
+  for (double latency : {1.0, 50.0, 400.0}) {
+    auto segment_index = SplitByBackwardTime(grad_time, grad_size, latency, 0.02);
+    double finish = SimulateSegments(grad_time, grad_size, segment_index, latency, 0.02);
+    for (auto other : std::vector<std::vector<size_t>>{{7}, {0, 1, 2, 3, 4, 5, 6, 7}, {3, 7}, {1, 3, 5, 7}}) {
+      ASSERT_LE(finish, SimulateSegments(grad_time, grad_size, other, latency, 0.02) + 1e-6);
+    }
+  }
+}
+
+TEST_F(TestCommunicationOpProfile, test_profile_split_indices) {
+  auto &profile = CommunicationOpProfile::GetInstance();
+  profile.RegisterGroup(kGroup, std::vector<float>(4, 1000), {3}, 2);
+  ASSERT_TRUE(profile.recording());
+  for (size_t step = 0; step < 2; ++step) {
+    for (size_t i = 0; i < 4; ++i) {
+      profile.RecordGradReady(kGroup, i, 400 - 100 * i + step * 10);
+    }
+    profile.RecordCommunication(4000, 100);
+    profile.RecordCommunication(1000, 40);
+    profile.EndStep();
+  }
+  ASSERT_FALSE(profile.recording());
+  ASSERT_EQ(profile.grad_time(kGroup), std::vector<float>({405, 305, 205, 105}));
+  double latency = 0;
+  double time_per_byte = 0;
+  profile.FitCommunicationCost(&latency, &time_per_byte);
+  ASSERT_NEAR(latency, 20, 1e-6);
+  ASSERT_NEAR(time_per_byte, 0.02, 1e-9);
+  ASSERT_EQ(profile.split_indices(kGroup), std::vector<uint32_t>({1, 2}));
+  ASSERT_EQ(parallel::ParallelContext::GetInstance()->GetAllReduceFusionSplitIndices(kGroup),
+            std::vector<uint32_t>({1, 2}));
+}
+
+// The ranks in processes profile different backward times, and choose the same segments by the averaged profile, or
+// the collectives of them mismatch.
+TEST_F(TestCommunicationOpProfile, test_profile_multi_process) {
+  auto shared = static_cast<SharedMemory *>(
+    mmap(nullptr, sizeof(SharedMemory), PROT_READ | PROT_WRITE, MAP_SHARED | MAP_ANONYMOUS, -1, 0));
+  ASSERT_NE(shared, MAP_FAILED);
+  pthread_barrierattr_t attr;
+  ASSERT_EQ(pthread_barrierattr_init(&attr), 0);
+  ASSERT_EQ(pthread_barrierattr_setpshared(&attr, PTHREAD_PROCESS_SHARED), 0);
+  ASSERT_EQ(pthread_barrier_init(&shared->barrier, &attr, kRankNum), 0);
+
+  std::vector<pid_t> pids;
+  for (size_t rank = 0; rank < kRankNum; ++rank) {
+    pid_t pid = fork();
+    ASSERT_GE(pid, 0);
+    if (pid == 0) {
+      (void)alarm(kRankTimeout);
+      _exit(RunRank(shared, rank));
+    }
+    pids.push_back(pid);
+  }
+  for (auto pid : pids) {
+    int status = 0;
+    ASSERT_EQ(waitpid(pid, &status, 0), pid);
+    ASSERT_TRUE(WIFEXITED(status));
+    ASSERT_EQ(WEXITSTATUS(status), 0);
+  }
+  // the first rank alone fuses all the gradients, while the last one splits them
+  ASSERT_EQ(shared->local_segment_num[0], 1);
+  ASSERT_EQ(shared->local_segment_num[kRankNum - 1], kLayerNum);
+  ASSERT_GT(shared->split_num[0], 0);
+  for (size_t rank = 1; rank < kRankNum; ++rank) {
+    ASSERT_EQ(shared->split_num[rank], shared->split_num[0]);
+    for (size_t i = 0; i < shared->split_num[0]; ++i) {
+      ASSERT_EQ(shared->split_indices[rank][i], shared->split_indices[0][i]);
+    }
+  }
+  (void)pthread_barrier_destroy(&shared->barrier);
+  (void)munmap(shared, sizeof(SharedMemory));
+}
+
+// the profile of a group is scoped to the network by its communication ops
+TEST_F(TestCommunicationOpProfile, test_network_group_key) {
+  auto key = CommunicationOpProfile::NetworkGroupKey(kGroup, std::vector<float>(4, 1000));
+  ASSERT_EQ(key, CommunicationOpProfile::NetworkGroupKey(kGroup, std::vector<float>(4, 1000)));
+  ASSERT_NE(key, CommunicationOpProfile::NetworkGroupKey(kGroup, std::vector<float>(5, 1000)));
+  ASSERT_NE(key, CommunicationOpProfile::NetworkGroupKey(kGroup, std::vector<float>(4, 2000)));
+  ASSERT_NE(key, CommunicationOpProfile::NetworkGroupKey("nccl_world_groupmax1", std::vector<float>(4, 1000)));
+}
+}  // namespace opt
+}  // namespace mindspore
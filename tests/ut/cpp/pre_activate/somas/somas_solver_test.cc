@@ -0,0 +1,108 @@
+/**
+ * Copyright 2020 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <memory>
+#include <unordered_map>
+#include <vector>
+#include "common/common_test.h"
+
+#include "backend/optimizer/somas/somas_solver_pre.h"
+
+namespace mindspore {
+namespace somas {
+class TestSomasSolver : public UT::Common {
+ public:
+  TestSomasSolver() {}
+
+  void AddTensor(size_t index, size_t size) {
+    tensors_[index] = std::make_shared<SomasSolverTensorDesc>(index, size, 0, false);
+  }
+
+  void AddConflict(size_t index1, size_t index2) {
+    (*conflicts_)[index1].SetBitTrue(index2);
+    (*conflicts_)[index2].SetBitTrue(index1);
+  }
+
+  bool Overlap(size_t index1, size_t index2) {
+    auto t1 = tensors_[index1];
+    auto t2 = tensors_[index2];
+    return t1->offset_ < t2->offset_ + t2->size_ && t2->offset_ < t1->offset_ + t1->size_;
+  }
+
+  std::unordered_map<size_t, SomasSolverTensorDescPtr> tensors_;
+  ConflictMatrixPtr conflicts_;
+};
+
+TEST_F(TestSomasSolver, test_dynamic_bit_set) {
+  DynamicBitSet bits(130);
+  ASSERT_EQ(bits.CountOnesNum(), 0);
+  bits.SetBitTrue(0);
+  bits.SetBitTrue(64);
+  bits.SetBitTrue(129);
+  ASSERT_TRUE(bits.IsBitTrue(64));
+  ASSERT_FALSE(bits.IsBitTrue(65));
+  ASSERT_EQ(bits.CountOnesNum(), 3);
+  bits.SetBitFalse(64);
+  ASSERT_FALSE(bits.IsBitTrue(64));
+
+  // the bits past the size are not counted
+  DynamicBitSet ones(130, true);
+  ASSERT_EQ(ones.CountOnesNum(), 130);
+  ASSERT_EQ(ones.MemorySize(), 3 * sizeof(uint64_t));
+
+  DynamicBitSet other(130);
+  other.SetBitTrue(1);
+  other.SetBitTrue(129);
+  bits.Union(other);
+  ASSERT_TRUE(bits.IsBitTrue(1));
+  ASSERT_EQ(bits.CountOnesNum(), 3);
+}
+
+// a chain of tensors conflicting with their neighbours only, every other tensor shares the same memory
+TEST_F(TestSomasSolver, test_solve_chain) {
+  const size_t tensor_num = 6;
+  const size_t size = 1024;
+  conflicts_ = std::make_shared<ConflictMatrix>(tensor_num, DynamicBitSet(tensor_num));
+  for (size_t i = 0; i < tensor_num; ++i) {
+    AddTensor(i, size);
+    if (i > 0) {
+      AddConflict(i - 1, i);
+    }
+  }
+  SomasSolverPre solver;
+  ASSERT_EQ(solver.Solving(0, &tensors_, conflicts_, {}, true), SUCCESS);
+  ASSERT_EQ(solver.GetMaxOffset(), 2 * size);
+  for (size_t i = 1; i < tensor_num; ++i) {
+    ASSERT_FALSE(Overlap(i - 1, i));
+  }
+}
+
+TEST_F(TestSomasSolver, test_solve_contiguous) {
+  const size_t tensor_num = 4;
+  conflicts_ = std::make_shared<ConflictMatrix>(tensor_num, DynamicBitSet(tensor_num, true));
+  AddTensor(0, 512);
+  AddTensor(1, 1024);
+  AddTensor(2, 512);
+  AddTensor(3, 2048);
+  SomasSolverPre solver;
+  ASSERT_EQ(solver.Solving(0, &tensors_, conflicts_, {{0, 1, 2}}, true), SUCCESS);
+  ASSERT_EQ(solver.GetMaxOffset(), 4096);
+  ASSERT_EQ(tensors_[1]->offset_, tensors_[0]->offset_ + 512);
+  ASSERT_EQ(tensors_[2]->offset_, tensors_[1]->offset_ + 1024);
+  ASSERT_FALSE(Overlap(0, 3));
+  ASSERT_FALSE(Overlap(2, 3));
+}
+}  // namespace somas
+}  // namespace mindspore
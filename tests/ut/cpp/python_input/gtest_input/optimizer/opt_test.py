@@ -124,6 +124,24 @@ def test_constant_variable(tag):
     return fns[tag]
 
 
+def test_multi_pattern(tag):
+    """ test_multi_pattern """
+    P = Primitive('P')
+    Q = Primitive('Q')
+
+    fns = FnDict()
+
+    @fns
+    def before_1(x):
+        return P(Q(15)) + P(P(x))
+
+    @fns
+    def after(x):
+        return P(15) + P(x)
+
+    return fns[tag]
+
+
 def cost(x):
     """ cost """
     return x * 10
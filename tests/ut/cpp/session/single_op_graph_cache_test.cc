@@ -0,0 +1,101 @@
+/**
+ * Copyright 2020 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <vector>
+#include "common/common_test.h"
+#include "backend/session/single_op_graph_cache.h"
+
+namespace mindspore {
+namespace session {
+class SingleOpGraphCacheTest : public UT::Common {
+ public:
+  SingleOpGraphCacheTest() = default;
+  void SetUp() override {}
+  void TearDown() override {}
+};
+
+TEST_F(SingleOpGraphCacheTest, GetAndInsert) {
+  SingleOpGraphCache cache(2);
+  auto graph = std::make_shared<KernelGraph>();
+  EXPECT_EQ(cache.Get("add"), nullptr);
+  cache.Insert("add", graph);
+  EXPECT_EQ(cache.Get("add"), graph);
+  EXPECT_EQ(cache.Peek("add"), graph);
+  EXPECT_EQ(cache.size(), 1);
+  EXPECT_EQ(cache.hit_num(), 1);
+  EXPECT_EQ(cache.miss_num(), 1);
+  EXPECT_EQ(cache.eviction_num(), 0);
+}
+
+TEST_F(SingleOpGraphCacheTest, EvictLeastRecentlyUsed) {
+  SingleOpGraphCache cache(2);
+  auto add_graph = std::make_shared<KernelGraph>();
+  auto mul_graph = std::make_shared<KernelGraph>();
+  auto sub_graph = std::make_shared<KernelGraph>();
+  cache.Insert("add", add_graph);
+  cache.Insert("mul", mul_graph);
+  // add becomes the most recently used one, peeking mul does not change the order
+  EXPECT_EQ(cache.Get("add"), add_graph);
+  EXPECT_EQ(cache.Peek("mul"), mul_graph);
+  cache.Insert("sub", sub_graph);
+  EXPECT_EQ(cache.size(), 2);
+  EXPECT_EQ(cache.eviction_num(), 1);
+  EXPECT_EQ(cache.Peek("mul"), nullptr);
+  EXPECT_EQ(cache.Peek("add"), add_graph);
+  EXPECT_EQ(cache.Peek("sub"), sub_graph);
+}
+
+TEST_F(SingleOpGraphCacheTest, ShrinkCapacity) {
+  SingleOpGraphCache cache(3);
+  cache.Insert("add", std::make_shared<KernelGraph>());
+  cache.Insert("mul", std::make_shared<KernelGraph>());
+  cache.Insert("sub", std::make_shared<KernelGraph>());
+  cache.set_capacity(1);
+  EXPECT_EQ(cache.size(), 1);
+  EXPECT_EQ(cache.eviction_num(), 2);
+  EXPECT_NE(cache.Peek("sub"), nullptr);
+  // the cache keeps one graph at least
+  cache.set_capacity(0);
+  EXPECT_EQ(cache.capacity(), 1);
+  cache.Clear();
+  EXPECT_EQ(cache.size(), 0);
+  EXPECT_EQ(cache.Peek("sub"), nullptr);
+}
+
+TEST_F(SingleOpGraphCacheTest, ReleaseDroppedGraphs) {
+  SingleOpGraphCache cache(1);
+  std::vector<KernelGraphPtr> released;
+  cache.set_release_callback([&released](const KernelGraphPtr &graph) { released.push_back(graph); });
+  auto add_graph = std::make_shared<KernelGraph>();
+  auto mul_graph = std::make_shared<KernelGraph>();
+  auto sub_graph = std::make_shared<KernelGraph>();
+  cache.Insert("add", add_graph);
+  // inserting the cached graph again releases nothing
+  cache.Insert("add", add_graph);
+  EXPECT_TRUE(released.empty());
+  cache.Insert("mul", mul_graph);
+  ASSERT_EQ(released.size(), 1);
+  EXPECT_EQ(released[0], add_graph);
+  // the replaced graph is released too
+  cache.Insert("mul", sub_graph);
+  ASSERT_EQ(released.size(), 2);
+  EXPECT_EQ(released[1], mul_graph);
+  cache.Clear();
+  ASSERT_EQ(released.size(), 3);
+  EXPECT_EQ(released[2], sub_graph);
+}
+}  // namespace session
+}  // namespace mindspore
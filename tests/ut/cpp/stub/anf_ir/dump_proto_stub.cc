@@ -23,5 +23,5 @@ std::string GetFuncGraphProtoString(const FuncGraphPtr &func_graph) { return "";
 
 std::string GetOnnxProtoString(const FuncGraphPtr &func_graph) { return ""; }
 
-std::string GetBinaryProtoString(const FuncGraphPtr &func_graph) { return ""; }
+std::string GetBinaryProtoString(const FuncGraphPtr &func_graph, bool export_param_data) { return ""; }
 }  // namespace mindspore
@@ -0,0 +1,136 @@
+# Copyright 2020 Huawei Technologies Co., Ltd
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+# http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+
+import json
+import re
+import numpy as np
+import pytest
+
+import mindspore as ms
+import mindspore.nn as nn
+from mindspore import Tensor
+from mindspore import context
+from mindspore.common.api import _executor
+from mindspore.ops import composite as C
+from mindspore.ops import operations as P
+from mindspore.parallel import _cost_model_context as cost_model_context
+from mindspore.parallel._utils import _reset_op_id as reset_op_id
+from mindspore.parallel.cost_model_calibration import calibrate_cost_model
+from tests.ut.python.ops.test_math_ops import VirtualLoss
+
+
+grad_all = C.GradOperation(get_all=True)
+
+
+class NetWithLoss(nn.Cell):
+    def __init__(self, network):
+        super(NetWithLoss, self).__init__()
+        self.loss = VirtualLoss()
+        self.network = network
+
+    def construct(self, x, y, b):
+        predict = self.network(x, y, b)
+        return self.loss(predict)
+
+
+class GradWrap(nn.Cell):
+    def __init__(self, network):
+        super(GradWrap, self).__init__()
+        self.network = network
+
+    def construct(self, x, y, b):
+        return grad_all(self.network)(x, y, b)
+
+
+class Net(nn.Cell):
+    def __init__(self):
+        super().__init__()
+        self.matmul1 = P.MatMul()
+        self.relu = P.ReLU()
+        self.matmul2 = P.MatMul()
+
+    def construct(self, x, y, b):
+        out = self.relu(self.matmul1(x, y))
+        return self.matmul2(out, b)
+
+
+def write_profile(profile_file):
+    # MatMul takes 2us per KB and 10us to launch, ReLU 0.5us per KB and AllReduce 8us per KB
+    with open(profile_file, "w") as f:
+        f.write("op_type,bytes,time_us\n")
+        for kilobytes in [64, 128, 256]:
+            f.write("MatMul,{},{}\n".format(kilobytes * 1024, 10 + 2 * kilobytes))
+            f.write("ReLU,{},{}\n".format(kilobytes * 1024, 10 + 0.5 * kilobytes))
+            f.write("AllReduce,{},{}\n".format(kilobytes * 1024, 30 + 8 * kilobytes))
+
+
+def test_calibrate_from_profile(tmp_path):
+    profile_file = str(tmp_path / "profile.csv")
+    calibration_file = str(tmp_path / "calibration.json")
+    write_profile(profile_file)
+    calibration = calibrate_cost_model(calibration_file, profile_file=profile_file)
+    with open(calibration_file) as f:
+        assert json.load(f) == calibration
+    assert np.isclose(calibration["computation"]["MatMul"], 2 / 1024)
+    assert np.isclose(calibration["computation"]["ReLU"], 0.5 / 1024)
+    assert np.isclose(calibration["communication"], 8 / 1024)
+
+
+def test_set_calibration_file(tmp_path):
+    calibration_file = str(tmp_path / "calibration.json")
+    with open(calibration_file, "w") as f:
+        json.dump({"computation": {"MatMul": 4e-4, "ReLU": 1e-4, "Softmax": 2e-4}, "communication": 1e-3}, f)
+    uncalibrated_beta = cost_model_context.get_cost_model_context("costmodel_beta")
+    cost_model_context.set_cost_model_context(costmodel_calibration_file=calibration_file)
+    assert cost_model_context.get_cost_model_context("costmodel_calibration_file") == calibration_file
+    # the communication per byte relative to the median computation per byte, of Softmax
+    assert np.isclose(cost_model_context.get_cost_model_context("costmodel_beta"), 5.0)
+    # clearing the file restores the beta it set
+    cost_model_context.set_cost_model_context(costmodel_calibration_file="")
+    assert cost_model_context.get_cost_model_context("costmodel_calibration_file") == ""
+    assert cost_model_context.get_cost_model_context("costmodel_beta") == uncalibrated_beta
+    cost_model_context.set_cost_model_context(costmodel_calibration_file=calibration_file)
+    cost_model_context.reset_cost_model_context()
+    assert cost_model_context.get_cost_model_context("costmodel_calibration_file") == ""
+    assert cost_model_context.get_cost_model_context("costmodel_beta") == 400.0
+
+    with open(calibration_file, "w") as f:
+        json.dump({"computation": {"MatMul": -1.0}}, f)
+    with pytest.raises(RuntimeError):
+        cost_model_context.set_cost_model_context(costmodel_calibration_file=calibration_file)
+
+
+def test_calibrated_strategy(tmp_path):
+    profile_file = str(tmp_path / "profile.csv")
+    calibration_file = str(tmp_path / "calibration.json")
+    write_profile(profile_file)
+    calibrate_cost_model(calibration_file, profile_file=profile_file)
+    context.set_auto_parallel_context(device_num=8, global_rank=0)
+    cost_model_context.set_cost_model_context(costmodel_calibration_file=calibration_file)
+
+    x = Tensor(np.ones([128, 32]), dtype=ms.float32)
+    y = Tensor(np.ones([32, 64]), dtype=ms.float32)
+    b = Tensor(np.ones([64, 64]), dtype=ms.float32)
+    net = GradWrap(NetWithLoss(Net()))
+    context.set_auto_parallel_context(parallel_mode="auto_parallel")
+    net.set_auto_parallel()
+    reset_op_id()
+    _executor.compile(net, x, y, b, phase='train')
+    strategies = _executor._get_shard_strategy(net)
+    matmul_strategies = [v for (k, v) in strategies.items() if re.search('MatMul-op', k) is not None]
+    assert len(matmul_strategies) == 2
+    for strategy in matmul_strategies:
+        assert np.prod(strategy[0]) * strategy[1][1] == 8
+    cost_model_context.reset_cost_model_context()
+    context.reset_auto_parallel_context()
@@ -125,6 +125,80 @@ def test_print_file_path():
         context.set_context(print_file_path="./")
 
 
+def test_compile_cache_path():
+    """test_compile_cache_path"""
+    with pytest.raises(TypeError):
+        context.set_context(compile_cache_path=1)
+    context.set_context(compile_cache_path="mindspore_compile_cache")
+    assert os.path.exists("mindspore_compile_cache")
+    assert context.get_context("compile_cache_path").find("mindspore_compile_cache") > 0
+    context.set_context(compile_cache_path="")
+    assert context.get_context("compile_cache_path") == ""
+
+
+def test_enable_pynative_async():
+    """test_enable_pynative_async"""
+    with pytest.raises(TypeError):
+        context.set_context(enable_pynative_async=1)
+    context.set_context(enable_pynative_async=True)
+    assert context.get_context("enable_pynative_async")
+    context.set_context(enable_pynative_async=False)
+    assert not context.get_context("enable_pynative_async")
+
+
+def test_enable_parallel_infer():
+    """test_enable_parallel_infer"""
+    with pytest.raises(TypeError):
+        context.set_context(enable_parallel_infer=1)
+    context.set_context(enable_parallel_infer=True)
+    assert context.get_context("enable_parallel_infer")
+    context.set_context(enable_parallel_infer=False)
+    assert not context.get_context("enable_parallel_infer")
+
+
+def test_enable_incremental_compile():
+    """test_enable_incremental_compile"""
+    with pytest.raises(TypeError):
+        context.set_context(enable_incremental_compile=1)
+    context.set_context(enable_incremental_compile=True)
+    assert context.get_context("enable_incremental_compile")
+    context.set_context(enable_incremental_compile=False)
+    assert not context.get_context("enable_incremental_compile")
+
+
+def test_enable_ir_arena():
+    """test_enable_ir_arena"""
+    with pytest.raises(TypeError):
+        context.set_context(enable_ir_arena=1)
+    context.set_context(enable_ir_arena=True)
+    assert context.get_context("enable_ir_arena")
+    context.set_context(enable_ir_arena=False)
+    assert not context.get_context("enable_ir_arena")
+
+
+def test_recompute_memory_budget():
+    """test_recompute_memory_budget"""
+    with pytest.raises(TypeError):
+        context.set_context(recompute_memory_budget=2)
+    with pytest.raises(ValueError):
+        context.set_context(recompute_memory_budget="2G")
+    context.set_context(recompute_memory_budget="2.5GB")
+    assert context.get_context("recompute_memory_budget") == 2.5
+    context.set_context(recompute_memory_budget="0GB")
+    assert context.get_context("recompute_memory_budget") == 0
+
+
+def test_op_graph_cache_capacity():
+    """test_op_graph_cache_capacity"""
+    with pytest.raises(TypeError):
+        context.set_context(op_graph_cache_capacity=1.0)
+    with pytest.raises(ValueError):
+        context.set_context(op_graph_cache_capacity=0)
+    context.set_context(op_graph_cache_capacity=16)
+    assert context.get_context("op_graph_cache_capacity") == 16
+    context.set_context(op_graph_cache_capacity=1024)
+
+
 def test_set_context():
     """ test_set_context """
     context.set_context(mode=context.GRAPH_MODE, device_target="Ascend",
@@ -145,7 +219,7 @@ def test_set_context():
 
 
 def teardown_module():
-    dirs = ['mindspore_ir_path']
+    dirs = ['mindspore_ir_path', 'mindspore_compile_cache']
     for item in dirs:
         item_name = './' + item
         if not os.path.exists(item_name):